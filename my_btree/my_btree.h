@@ -0,0 +1,2161 @@
+#ifndef MY_BTREE_H
+#define MY_BTREE_H
+
+// 这个头文件包含一棵 B 树 btree，以及基于它的四个有序容器
+// btree_map / btree_multimap / btree_set / btree_multiset
+//
+// 红黑树每个节点只放一个元素，另有三个指针和一个颜色位；顺序遍历和范围查询每前进一个元素
+// 就要追一次指针，节点分散在堆上，缓存命中率低。B 树的节点约 TargetNodeSize（默认 256）字节，
+// 连续存放多个有序的元素：
+//   * 叶节点只有元素数组，内部节点在元素数组后面再放 count + 1 个子节点指针
+//   * 节点内查找：算术类型的键顺序比较（分支可预测，顺序访存），其他类型二分查找
+//   * 树高约为 log_{B/2}(n)，B 为每个节点的元素数，int 键时 B = 60
+//
+// 接口与 map / multimap / set / multiset 保持一致，只需替换 typedef 即可在两种实现之间切换
+//
+// 注意：与红黑树不同，插入和删除会在节点之间移动元素，
+// 之后所有迭代器、指针和引用都可能失效（删除返回的迭代器除外）
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../my_memory_resource/my_memory_resource.h"
+
+namespace mystl
+{
+
+/**
+ * @brief B 树的值特性：区分 set 的元素与 map 的键值对
+ */
+template <class T, bool IsMap>
+struct btree_value_traits_imp
+{
+    typedef T key_type;
+    typedef T mapped_type;
+    typedef T value_type;
+
+    static const key_type& get_key(const value_type& value) { return value; }
+
+    /**
+     * @brief 把 src 的元素移动构造到 dst 上
+     */
+    template <class Alloc>
+    static void move_construct(Alloc& alloc, value_type* dst, value_type* src)
+    {
+        std::allocator_traits<Alloc>::construct(alloc, dst, std::move(*src));
+    }
+};
+
+template <class T>
+struct btree_value_traits_imp<T, true>
+{
+    typedef typename std::remove_cv<typename T::first_type>::type key_type;
+    typedef typename T::second_type                               mapped_type;
+    typedef T                                                     value_type;
+
+    static const key_type& get_key(const value_type& value) { return value.first; }
+
+    /**
+     * @brief 键被声明为 const，与节点句柄的 key() 相同，借助 const_cast 移动键，源元素随即被销毁
+     */
+    template <class Alloc>
+    static void move_construct(Alloc& alloc, value_type* dst, value_type* src)
+    {
+        std::allocator_traits<Alloc>::construct(alloc, dst, std::piecewise_construct,
+            std::forward_as_tuple(std::move(const_cast<key_type&>(src->first))),
+            std::forward_as_tuple(std::move(src->second)));
+    }
+};
+
+template <class T>
+struct btree_value_traits
+{
+    template <class U>
+    static auto test(U*) -> decltype(std::declval<U>().first, std::declval<U>().second, std::true_type());
+    template <class U>
+    static std::false_type test(...);
+
+    static constexpr bool is_map = decltype(test<T>(nullptr))::value;
+
+    typedef btree_value_traits_imp<T, is_map>   imp;
+    typedef typename imp::key_type              key_type;
+    typedef typename imp::mapped_type           mapped_type;
+    typedef typename imp::value_type            value_type;
+
+    static const key_type& get_key(const value_type& value) { return imp::get_key(value); }
+
+    template <class Alloc>
+    static void move_construct(Alloc& alloc, value_type* dst, value_type* src)
+    {
+        imp::move_construct(alloc, dst, src);
+    }
+};
+
+/**
+ * @brief 每个节点的元素个数：节点头部之外的空间能放下多少个元素，至少为 3
+ * @tparam T 元素类型
+ * @tparam TargetNodeSize 叶节点的目标字节数
+ */
+template <class T, size_t TargetNodeSize>
+struct btree_node_values
+{
+    static constexpr size_t header = 2 * sizeof(void*);
+    static constexpr size_t fit = TargetNodeSize > header + sizeof(T)
+                                ? (TargetNodeSize - header) / sizeof(T) : 0;
+    static constexpr size_t value = fit < 3 ? 3 : (fit > 1024 ? 1024 : fit);
+};
+
+/**
+ * @brief B 树叶节点，也是内部节点的公共部分
+ *
+ * 元素保存在未初始化的存储中，只有 [0, count) 内的元素已经构造
+ */
+template <class T, size_t N>
+struct btree_node
+{
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_type;
+
+    btree_node*   parent;    // 父节点，根节点为 nullptr
+    std::uint16_t position;  // 在父节点子节点数组中的下标
+    std::uint16_t count;     // 元素个数
+    bool          leaf;      // 是否为叶节点
+    storage_type  slots[N];  // 元素
+
+    T*       value(size_t i) noexcept       { return reinterpret_cast<T*>(slots + i); }
+    const T* value(size_t i) const noexcept { return reinterpret_cast<const T*>(slots + i); }
+
+    /**
+     * @brief 第 i 个子节点，只能在内部节点上调用
+     */
+    btree_node*& child(size_t i) noexcept;
+};
+
+/**
+ * @brief B 树内部节点：第 i 个子树中的元素都不大于 value(i)，不小于 value(i - 1)
+ */
+template <class T, size_t N>
+struct btree_internal_node : public btree_node<T, N>
+{
+    btree_node<T, N>* children[N + 1];
+};
+
+template <class T, size_t N>
+inline btree_node<T, N>*& btree_node<T, N>::child(size_t i) noexcept
+{
+    return static_cast<btree_internal_node<T, N>*>(this)->children[i];
+}
+
+template <class T, size_t N> struct btree_iterator;
+template <class T, size_t N> struct btree_const_iterator;
+
+/**
+ * @brief B 树迭代器基类：节点加节点内的下标
+ *
+ * end() 为最右叶节点的 (count) 位置；空树的 end() 为 (nullptr, 0)
+ */
+template <class T, size_t N>
+struct btree_iterator_base
+{
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T                               value_type;
+    typedef ptrdiff_t                       difference_type;
+    typedef btree_node<T, N>*               node_ptr;
+
+    node_ptr node;      // 所在节点
+    int      position;  // 节点内的下标
+
+    btree_iterator_base() noexcept : node(nullptr), position(0) {}
+    btree_iterator_base(node_ptr n, int pos) noexcept : node(n), position(pos) {}
+
+    /**
+     * @brief 前进到中序的下一个元素；叶节点内只是下标加一
+     */
+    void inc() noexcept
+    {
+        if (node->leaf && ++position < node->count)
+            return;
+        inc_slow();
+    }
+
+    /**
+     * @brief 后退到中序的前一个元素
+     */
+    void dec() noexcept
+    {
+        if (node->leaf && --position >= 0)
+            return;
+        dec_slow();
+    }
+
+    bool operator==(const btree_iterator_base& rhs) const noexcept
+    { return node == rhs.node && position == rhs.position; }
+
+    bool operator!=(const btree_iterator_base& rhs) const noexcept
+    { return !(*this == rhs); }
+
+private:
+    void inc_slow() noexcept
+    {
+        if (node->leaf)
+        {
+            // 叶节点走完，向上找到第一个还有后续元素的祖先；找不到时停在 end()
+            node_ptr n = node;
+            int pos = position;
+            while (pos == n->count && n->parent != nullptr)
+            {
+                pos = n->position;
+                n = n->parent;
+            }
+            if (pos != n->count)
+            {
+                node = n;
+                position = pos;
+            }
+        }
+        else
+        {
+            // 内部节点的下一个元素是右侧子树的最左元素
+            node = node->child(position + 1);
+            while (!node->leaf)
+                node = node->child(0);
+            position = 0;
+        }
+    }
+
+    void dec_slow() noexcept
+    {
+        if (node->leaf)
+        {
+            node_ptr n = node;
+            int pos = position;
+            while (pos < 0 && n->parent != nullptr)
+            {
+                pos = n->position - 1;
+                n = n->parent;
+            }
+            if (pos >= 0)
+            {
+                node = n;
+                position = pos;
+            }
+        }
+        else
+        {
+            // 内部节点的前一个元素是左侧子树的最右元素
+            node = node->child(position);
+            while (!node->leaf)
+                node = node->child(node->count);
+            position = node->count - 1;
+        }
+    }
+};
+
+/**
+ * @brief B 树迭代器
+ */
+template <class T, size_t N>
+struct btree_iterator : public btree_iterator_base<T, N>
+{
+    typedef btree_iterator_base<T, N> base;
+    typedef typename base::node_ptr   node_ptr;
+    typedef T*                        pointer;
+    typedef T&                        reference;
+
+    using base::node;
+    using base::position;
+
+    btree_iterator() noexcept = default;
+    btree_iterator(node_ptr n, int pos) noexcept : base(n, pos) {}
+
+    reference operator*()  const noexcept { return *node->value(position); }
+    pointer   operator->() const noexcept { return node->value(position); }
+
+    btree_iterator& operator++() noexcept
+    {
+        this->inc();
+        return *this;
+    }
+
+    btree_iterator operator++(int) noexcept
+    {
+        btree_iterator tmp = *this;
+        this->inc();
+        return tmp;
+    }
+
+    btree_iterator& operator--() noexcept
+    {
+        this->dec();
+        return *this;
+    }
+
+    btree_iterator operator--(int) noexcept
+    {
+        btree_iterator tmp = *this;
+        this->dec();
+        return tmp;
+    }
+};
+
+/**
+ * @brief B 树常量迭代器
+ */
+template <class T, size_t N>
+struct btree_const_iterator : public btree_iterator_base<T, N>
+{
+    typedef btree_iterator_base<T, N> base;
+    typedef typename base::node_ptr   node_ptr;
+    typedef const T*                  pointer;
+    typedef const T&                  reference;
+
+    using base::node;
+    using base::position;
+
+    btree_const_iterator() noexcept = default;
+    btree_const_iterator(node_ptr n, int pos) noexcept : base(n, pos) {}
+    btree_const_iterator(const btree_iterator<T, N>& rhs) noexcept : base(rhs.node, rhs.position) {}
+
+    reference operator*()  const noexcept { return *node->value(position); }
+    pointer   operator->() const noexcept { return node->value(position); }
+
+    btree_const_iterator& operator++() noexcept
+    {
+        this->inc();
+        return *this;
+    }
+
+    btree_const_iterator operator++(int) noexcept
+    {
+        btree_const_iterator tmp = *this;
+        this->inc();
+        return tmp;
+    }
+
+    btree_const_iterator& operator--() noexcept
+    {
+        this->dec();
+        return *this;
+    }
+
+    btree_const_iterator operator--(int) noexcept
+    {
+        btree_const_iterator tmp = *this;
+        this->dec();
+        return tmp;
+    }
+};
+
+/**
+ * @brief B 树模板类
+ *
+ * 所有叶节点深度相同；除根节点外，删除后元素个数低于 N / 2 的节点向兄弟借一个元素，
+ * 或与兄弟合并。插入时叶节点满了就分裂，中间的元素上移到父节点；
+ * 在节点末尾（顺序插入）或开头（逆序插入）分裂时，满的一侧保持满的，节点利用率接近 100%
+ *
+ * @tparam T 元素类型，map 为 std::pair<const Key, Value>
+ * @tparam Compare 键值比较函数
+ * @tparam Alloc 分配器类型，元素与节点都由它 rebind 得到的分配器分配
+ * @tparam TargetNodeSize 叶节点的目标字节数
+ */
+template <class T, class Compare, class Alloc = std::allocator<T>, size_t TargetNodeSize = 256>
+class btree
+{
+public:
+    // B 树的型别定义
+    typedef btree_value_traits<T>                       value_traits;
+    typedef typename value_traits::key_type             key_type;
+    typedef typename value_traits::mapped_type          mapped_type;
+    typedef typename value_traits::value_type           value_type;
+    typedef Compare                                     key_compare;
+    typedef Alloc                                       allocator_type;
+
+    typedef value_type*                                 pointer;
+    typedef const value_type*                           const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+
+    // 每个节点最多容纳的元素个数
+    static constexpr size_type node_values = btree_node_values<T, TargetNodeSize>::value;
+
+    typedef mystl::btree_iterator<T, node_values>       iterator;
+    typedef mystl::btree_const_iterator<T, node_values> const_iterator;
+    typedef std::reverse_iterator<iterator>             reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+private:
+    typedef btree_node<T, node_values>                  leaf_node;
+    typedef btree_internal_node<T, node_values>         internal_node;
+    typedef leaf_node*                                  node_ptr;
+
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T>             data_allocator;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<leaf_node>     leaf_allocator;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<internal_node> internal_allocator;
+    typedef std::allocator_traits<data_allocator>       data_alloc_traits;
+    typedef std::allocator_traits<leaf_allocator>       leaf_alloc_traits;
+    typedef std::allocator_traits<internal_allocator>   internal_alloc_traits;
+
+    // 非根节点删除后应保持的最少元素个数
+    static constexpr size_type min_values = node_values / 2;
+
+    // 算术类型的键在节点内顺序查找，其余二分查找
+    static constexpr bool linear_search = std::is_arithmetic<key_type>::value;
+
+    node_ptr       root_;       // 根节点，空树为 nullptr
+    node_ptr       leftmost_;   // 最左叶节点，begin() 所在
+    node_ptr       rightmost_;  // 最右叶节点，end() 所在
+    size_type      size_;       // 元素个数
+    key_compare    comp_;       // 键值比较函数
+    data_allocator alloc_;      // 元素分配器，节点的分配器由它 rebind 得到
+
+public:
+    // 构造、复制、移动、析构函数
+
+    btree() : btree(Compare()) {}
+
+    explicit btree(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+          comp_(comp), alloc_(alloc)
+    {
+    }
+
+    btree(const btree& rhs)
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), comp_(rhs.comp_),
+          alloc_(data_alloc_traits::select_on_container_copy_construction(rhs.alloc_))
+    {
+        copy_from(rhs);
+    }
+
+    btree(const btree& rhs, const allocator_type& alloc)
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+          comp_(rhs.comp_), alloc_(alloc)
+    {
+        copy_from(rhs);
+    }
+
+    btree(btree&& rhs) noexcept
+        : root_(rhs.root_), leftmost_(rhs.leftmost_), rightmost_(rhs.rightmost_), size_(rhs.size_),
+          comp_(rhs.comp_), alloc_(rhs.alloc_)
+    {
+        rhs.reset();
+    }
+
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * 分配器相等时直接接管 rhs 的节点，否则逐个移动元素
+     */
+    btree(btree&& rhs, const allocator_type& alloc)
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0),
+          comp_(rhs.comp_), alloc_(alloc)
+    {
+        if (alloc_ == rhs.alloc_)
+        {
+            swap_data(rhs);
+        }
+        else
+        {
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                insert_at(end(), std::move(*it));
+            rhs.clear();
+        }
+    }
+
+    btree& operator=(const btree& rhs)
+    {
+        if (this != &rhs)
+        {
+            // tmp 使用赋值后应当持有的分配器，整体交换后由 tmp 释放原有节点
+            const bool pocca = data_alloc_traits::propagate_on_container_copy_assignment::value;
+            btree tmp(rhs, allocator_type(pocca ? rhs.alloc_ : alloc_));
+            swap_data(tmp);
+            std::swap(alloc_, tmp.alloc_);
+        }
+        return *this;
+    }
+
+    btree& operator=(btree&& rhs)
+        noexcept(data_alloc_traits::propagate_on_container_move_assignment::value)
+    {
+        if (this != &rhs)
+        {
+            const bool pocma = data_alloc_traits::propagate_on_container_move_assignment::value;
+            btree tmp(std::move(rhs), allocator_type(pocma ? rhs.alloc_ : alloc_));
+            swap_data(tmp);
+            std::swap(alloc_, tmp.alloc_);
+        }
+        return *this;
+    }
+
+    ~btree() { clear(); }
+
+    // 迭代器相关操作
+
+    iterator       begin()         noexcept { return iterator(leftmost_, 0); }
+    const_iterator begin()   const noexcept { return const_iterator(leftmost_, 0); }
+    iterator       end()           noexcept { return iterator(rightmost_, end_position()); }
+    const_iterator end()     const noexcept { return const_iterator(rightmost_, end_position()); }
+
+    reverse_iterator       rbegin()       noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()         noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 容量相关操作
+
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type max_size() const noexcept { return data_alloc_traits::max_size(alloc_); }
+
+    /**
+     * @brief 树高，空树为 0
+     */
+    size_type height() const noexcept
+    {
+        size_type h = 0;
+        for (node_ptr n = root_; n != nullptr; n = n->leaf ? nullptr : n->child(0))
+            ++h;
+        return h;
+    }
+
+    // 插入相关操作
+
+    /**
+     * @brief 就地构造元素，不允许重复键值
+     *
+     * 需要先构造出元素才能得到键，若键已存在则丢弃该临时元素
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique(Args&& ...args)
+    {
+        value_type tmp(std::forward<Args>(args)...);
+        return emplace_unique_key(value_traits::get_key(tmp), std::move(tmp));
+    }
+
+    /**
+     * @brief 就地构造元素，允许重复键值，新元素排在相等元素之后
+     */
+    template <class ...Args>
+    iterator emplace_multi(Args&& ...args)
+    {
+        value_type tmp(std::forward<Args>(args)...);
+        return insert_at(search_leaf<true>(value_traits::get_key(tmp)), std::move(tmp));
+    }
+
+    /**
+     * @brief 先以键查找，只有键不存在时才用 args 构造元素
+     * @param key 键
+     * @param args 构造 value_type 的参数
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique_key(const key_type& key, Args&& ...args)
+    {
+        iterator pos = search_leaf<false>(key);
+        iterator lb = internal_last(pos);
+        if (lb != end() && !comp_(key, value_traits::get_key(*lb)))
+            return std::make_pair(lb, false);
+        return std::make_pair(insert_at(pos, std::forward<Args>(args)...), true);
+    }
+
+    std::pair<iterator, bool> insert_unique(const value_type& value)
+    { return emplace_unique_key(value_traits::get_key(value), value); }
+
+    std::pair<iterator, bool> insert_unique(value_type&& value)
+    { return emplace_unique_key(value_traits::get_key(value), std::move(value)); }
+
+    iterator insert_multi(const value_type& value)
+    { return insert_at(search_leaf<true>(value_traits::get_key(value)), value); }
+
+    iterator insert_multi(value_type&& value)
+    { return insert_at(search_leaf<true>(value_traits::get_key(value)), std::move(value)); }
+
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last)
+    {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+
+    template <class InputIter>
+    void insert_multi(InputIter first, InputIter last)
+    {
+        for (; first != last; ++first)
+            insert_multi(*first);
+    }
+
+    // 删除相关操作
+
+    /**
+     * @brief 删除迭代器所指的元素
+     * @return 指向被删除元素的下一个元素的迭代器
+     */
+    iterator  erase(const_iterator position);
+
+    /**
+     * @brief 删除 [first, last) 内的元素
+     *
+     * 删除会在节点之间移动元素，last 随之失效，因此先数出个数再逐个删除
+     * @return 指向 last 所指元素的迭代器
+     */
+    iterator  erase(const_iterator first, const_iterator last);
+
+    size_type erase_unique(const key_type& key);
+    size_type erase_multi(const key_type& key);
+
+    /**
+     * @brief 清空 B 树，释放所有节点
+     */
+    void      clear() noexcept;
+
+    void      swap(btree& rhs) noexcept;
+
+    // 查找相关操作
+
+    iterator       find(const key_type& key)       { return find_aux(key); }
+    const_iterator find(const key_type& key) const { return const_cast<btree*>(this)->find_aux(key); }
+
+    /**
+     * @brief 第一个不小于 key 的元素
+     */
+    iterator       lower_bound(const key_type& key)
+    { return internal_last(search_leaf<false>(key)); }
+
+    const_iterator lower_bound(const key_type& key) const
+    { return const_cast<btree*>(this)->lower_bound(key); }
+
+    /**
+     * @brief 第一个大于 key 的元素
+     */
+    iterator       upper_bound(const key_type& key)
+    { return internal_last(search_leaf<true>(key)); }
+
+    const_iterator upper_bound(const key_type& key) const
+    { return const_cast<btree*>(this)->upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range_unique(const key_type& key)
+    {
+        iterator it = find(key);
+        if (it == end())
+            return std::make_pair(it, it);
+        iterator next = it;
+        return std::make_pair(it, ++next);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+    { return const_cast<btree*>(this)->equal_range_unique(key); }
+
+    std::pair<iterator, iterator> equal_range_multi(const key_type& key)
+    { return std::make_pair(lower_bound(key), upper_bound(key)); }
+
+    std::pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const
+    { return const_cast<btree*>(this)->equal_range_multi(key); }
+
+    size_type count_unique(const key_type& key) const
+    { return find(key) != end() ? 1 : 0; }
+
+    size_type count_multi(const key_type& key) const
+    {
+        auto p = equal_range_multi(key);
+        return static_cast<size_type>(std::distance(p.first, p.second));
+    }
+
+    key_compare key_comp() const { return comp_; }
+
+private:
+    int end_position() const noexcept
+    { return rightmost_ != nullptr ? rightmost_->count : 0; }
+
+    /**
+     * @brief 节点内第一个不小于（Upper 为 true 时为大于）key 的元素下标
+     */
+    template <bool Upper>
+    int search_in_node(node_ptr n, const key_type& key) const
+    {
+        return search_in_node<Upper>(n, key, std::integral_constant<bool, linear_search>());
+    }
+
+    template <bool Upper>
+    int search_in_node(node_ptr n, const key_type& key, std::true_type) const
+    {
+        int i = 0;
+        const int count = n->count;
+        if (Upper)
+        {
+            while (i < count && !comp_(key, value_traits::get_key(*n->value(i))))
+                ++i;
+        }
+        else
+        {
+            while (i < count && comp_(value_traits::get_key(*n->value(i)), key))
+                ++i;
+        }
+        return i;
+    }
+
+    template <bool Upper>
+    int search_in_node(node_ptr n, const key_type& key, std::false_type) const
+    {
+        int lo = 0;
+        int hi = n->count;
+        while (lo < hi)
+        {
+            const int mid = (lo + hi) / 2;
+            const key_type& k = value_traits::get_key(*n->value(mid));
+            if (Upper ? !comp_(key, k) : comp_(k, key))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    /**
+     * @brief 从根节点向下查找，返回叶节点上的插入位置；空树返回 end()
+     */
+    template <bool Upper>
+    iterator search_leaf(const key_type& key) const
+    {
+        node_ptr n = root_;
+        if (n == nullptr)
+            return iterator(nullptr, 0);
+        for (;;)
+        {
+            const int pos = search_in_node<Upper>(n, key);
+            if (n->leaf)
+                return iterator(n, pos);
+            n = n->child(pos);
+        }
+    }
+
+    /**
+     * @brief 把叶节点末尾之后的位置换成中序的下一个元素，没有时返回 end()
+     */
+    iterator internal_last(iterator it) noexcept
+    {
+        if (it.node == nullptr)
+            return it;
+        while (it.position == it.node->count)
+        {
+            if (it.node->parent == nullptr)
+                return end();
+            it.position = it.node->position;
+            it.node = it.node->parent;
+        }
+        return it;
+    }
+
+    iterator find_aux(const key_type& key)
+    {
+        iterator it = lower_bound(key);
+        if (it != end() && !comp_(key, value_traits::get_key(*it)))
+            return it;
+        return end();
+    }
+
+    template <class ...Args>
+    iterator insert_at(iterator pos, Args&& ...args);
+
+    // 节点的分配与释放
+    node_ptr new_leaf();
+    node_ptr new_internal();
+    void     free_node(node_ptr n) noexcept;
+    void     destroy_subtree(node_ptr n) noexcept;
+
+    /**
+     * @brief 把 src 的元素移动到未构造的 dst 上，并销毁 src
+     */
+    void transfer(value_type* dst, value_type* src)
+    {
+        value_traits::move_construct(alloc_, dst, src);
+        data_alloc_traits::destroy(alloc_, src);
+    }
+
+    void set_child(node_ptr parent, size_t i, node_ptr child) noexcept
+    {
+        parent->child(i) = child;
+        child->parent = parent;
+        child->position = static_cast<std::uint16_t>(i);
+    }
+
+    void split(node_ptr n, int insert_pos, iterator* track);
+    void fix_underflow(node_ptr n, iterator* track);
+    void rotate_from_left(node_ptr left, node_ptr n, iterator* track);
+    void rotate_from_right(node_ptr n, node_ptr right);
+    void merge_nodes(node_ptr left, node_ptr right, iterator* track);
+
+    node_ptr clone(node_ptr src, node_ptr parent);
+    void     copy_from(const btree& rhs);
+    void     reset() noexcept;
+    void     swap_data(btree& rhs) noexcept;
+};
+
+/*****************************************************************************************/
+// B 树的实现
+
+/**
+ * @brief 在叶节点位置 pos 处构造新元素，叶节点已满时先分裂
+ *
+ * 新元素先在节点外构造：args 可能引用树中的元素，分裂和移动元素后引用会失效。
+ * 构造或分配节点抛出异常时容器中的元素不变
+ * @param pos 叶节点上的插入位置，空树时为 end()
+ * @return 指向新元素的迭代器
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+template <class ...Args>
+typename btree<T, Compare, Alloc, TargetNodeSize>::iterator
+btree<T, Compare, Alloc, TargetNodeSize>::insert_at(iterator pos, Args&& ...args)
+{
+    typename leaf_node::storage_type buf;
+    value_type* tmp = reinterpret_cast<value_type*>(&buf);
+    data_alloc_traits::construct(alloc_, tmp, std::forward<Args>(args)...);
+    try
+    {
+        if (root_ == nullptr)
+        {
+            root_ = leftmost_ = rightmost_ = new_leaf();
+            pos = iterator(root_, 0);
+        }
+        else if (pos.node->count == node_values)
+        {
+            split(pos.node, pos.position, &pos);
+        }
+    }
+    catch (...)
+    {
+        data_alloc_traits::destroy(alloc_, tmp);
+        throw;
+    }
+    node_ptr n = pos.node;
+    const int i = pos.position;
+    for (int j = n->count; j > i; --j)
+        transfer(n->value(j), n->value(j - 1));
+    transfer(n->value(i), tmp);
+    ++n->count;
+    ++size_;
+    return pos;
+}
+
+/**
+ * @brief 分裂满的节点 n，中间的元素上移到父节点；父节点也满时先分裂父节点
+ *
+ * 即将插入的位置在节点末尾时左侧保留 N - 1 个元素，在开头时左侧为空，
+ * 使顺序、逆序插入后的节点都是满的。所有节点在修改树之前分配，分配失败时树不变
+ * @param n 要分裂的节点
+ * @param insert_pos 分裂后将要插入元素（或子节点上移的元素）的位置
+ * @param track 叶节点上的插入位置，分裂后跟随元素调整；分裂内部节点时为 nullptr
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::split(node_ptr n, int insert_pos, iterator* track)
+{
+    node_ptr sib = n->leaf ? new_leaf() : new_internal();
+    try
+    {
+        if (n->parent == nullptr)
+        {
+            node_ptr r = new_internal();
+            set_child(r, 0, n);
+            root_ = r;
+        }
+        else if (n->parent->count == node_values)
+        {
+            split(n->parent, n->position, nullptr);
+        }
+    }
+    catch (...)
+    {
+        free_node(sib);
+        throw;
+    }
+
+    int mid = static_cast<int>(node_values / 2);
+    if (insert_pos == static_cast<int>(node_values))
+        mid = static_cast<int>(node_values) - 1;
+    else if (insert_pos == 0)
+        mid = 0;
+
+    node_ptr p = n->parent;
+    const int k = n->position;
+
+    // 右半部分移到新节点
+    const int total = n->count;
+    for (int j = mid + 1; j < total; ++j)
+        transfer(sib->value(j - mid - 1), n->value(j));
+    if (!n->leaf)
+    {
+        for (int j = mid + 1; j <= total; ++j)
+            set_child(sib, j - mid - 1, n->child(j));
+    }
+    sib->count = static_cast<std::uint16_t>(total - mid - 1);
+
+    // 父节点在 k 处腾出位置，放入中间的元素和新节点
+    for (int j = p->count; j > k; --j)
+    {
+        transfer(p->value(j), p->value(j - 1));
+        set_child(p, j + 1, p->child(j));
+    }
+    transfer(p->value(k), n->value(mid));
+    set_child(p, k + 1, sib);
+    ++p->count;
+    n->count = static_cast<std::uint16_t>(mid);
+
+    if (rightmost_ == n)
+        rightmost_ = sib;
+    if (track != nullptr && track->position > mid)
+    {
+        track->node = sib;
+        track->position -= mid + 1;
+    }
+}
+
+/**
+ * @brief 删除迭代器所指的元素
+ *
+ * 内部节点上的元素先用前驱（左侧子树的最右元素，位于叶节点）替换，转化为叶节点上的删除；
+ * 叶节点元素过少时向兄弟借一个元素或与兄弟合并，必要时逐层向上调整
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::iterator
+btree<T, Compare, Alloc, TargetNodeSize>::erase(const_iterator position)
+{
+    iterator pos(position.node, position.position);
+    const bool internal_delete = !pos.node->leaf;
+    if (internal_delete)
+    {
+        iterator pred = pos;
+        --pred;
+        data_alloc_traits::destroy(alloc_, pos.node->value(pos.position));
+        transfer(pos.node->value(pos.position), pred.node->value(pred.position));
+        pos = pred;  // 前驱是叶节点的最后一个元素，已经移走
+    }
+    else
+    {
+        data_alloc_traits::destroy(alloc_, pos.node->value(pos.position));
+        for (int j = pos.position + 1; j < pos.node->count; ++j)
+            transfer(pos.node->value(j - 1), pos.node->value(j));
+    }
+    node_ptr n = pos.node;
+    --n->count;
+    --size_;
+
+    if (n == root_)
+    {
+        if (n->count == 0)
+        {
+            free_node(n);
+            reset();
+            return end();
+        }
+    }
+    else if (n->count < min_values)
+    {
+        fix_underflow(n, &pos);
+    }
+
+    // pos 现在位于原元素的后继之前；内部节点删除时后继之前是替换上去的前驱
+    pos = internal_last(pos);
+    if (internal_delete)
+        ++pos;
+    return pos;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::iterator
+btree<T, Compare, Alloc, TargetNodeSize>::erase(const_iterator first, const_iterator last)
+{
+    if (first == begin() && last == end())
+    {
+        clear();
+        return end();
+    }
+    size_type n = static_cast<size_type>(std::distance(first, last));
+    iterator it(first.node, first.position);
+    for (; n > 0; --n)
+        it = erase(it);
+    return it;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::size_type
+btree<T, Compare, Alloc, TargetNodeSize>::erase_unique(const key_type& key)
+{
+    iterator it = find(key);
+    if (it == end())
+        return 0;
+    erase(it);
+    return 1;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::size_type
+btree<T, Compare, Alloc, TargetNodeSize>::erase_multi(const key_type& key)
+{
+    iterator first = lower_bound(key);
+    size_type n = 0;
+    for (const_iterator it = first; it != end() && !comp_(key, value_traits::get_key(*it)); ++it)
+        ++n;
+    for (size_type i = 0; i < n; ++i)
+        first = erase(first);
+    return n;
+}
+
+/**
+ * @brief 节点 n 的元素少于 min_values 时，从 n 开始逐层向上调整
+ *
+ * 兄弟有多余的元素时借一个（经父节点旋转），调整到此为止；
+ * 否则与兄弟合并，父节点少了一个元素，继续检查父节点。根节点没有元素时由唯一的子节点替代
+ * @param track 删除位置，只可能在最初的叶节点上
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::fix_underflow(node_ptr n, iterator* track)
+{
+    while (n != root_ && n->count < min_values)
+    {
+        node_ptr p = n->parent;
+        const int k = n->position;
+        node_ptr left = k > 0 ? p->child(k - 1) : nullptr;
+        node_ptr right = k < p->count ? p->child(k + 1) : nullptr;
+        if (left != nullptr && left->count > min_values)
+        {
+            rotate_from_left(left, n, track);
+            break;
+        }
+        if (right != nullptr && right->count > min_values)
+        {
+            rotate_from_right(n, right);
+            break;
+        }
+        if (left != nullptr)
+            merge_nodes(left, n, track);
+        else
+            merge_nodes(n, right, track);
+        n = p;
+    }
+    if (root_->count == 0 && !root_->leaf)
+    {
+        node_ptr old = root_;
+        root_ = old->child(0);
+        root_->parent = nullptr;
+        root_->position = 0;
+        free_node(old);
+    }
+}
+
+/**
+ * @brief 左兄弟的最后一个元素上移到父节点，父节点的分隔元素下移到 n 的开头
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::rotate_from_left(node_ptr left, node_ptr n,
+                                                                 iterator* track)
+{
+    node_ptr p = n->parent;
+    const int k = n->position;
+    for (int j = n->count; j > 0; --j)
+        transfer(n->value(j), n->value(j - 1));
+    transfer(n->value(0), p->value(k - 1));
+    transfer(p->value(k - 1), left->value(left->count - 1));
+    if (!n->leaf)
+    {
+        for (int j = n->count + 1; j > 0; --j)
+            set_child(n, j, n->child(j - 1));
+        set_child(n, 0, left->child(left->count));
+    }
+    ++n->count;
+    --left->count;
+    if (track != nullptr && track->node == n)
+        ++track->position;
+}
+
+/**
+ * @brief 右兄弟的第一个元素上移到父节点，父节点的分隔元素下移到 n 的末尾
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::rotate_from_right(node_ptr n, node_ptr right)
+{
+    node_ptr p = n->parent;
+    const int k = n->position;
+    transfer(n->value(n->count), p->value(k));
+    transfer(p->value(k), right->value(0));
+    for (int j = 1; j < right->count; ++j)
+        transfer(right->value(j - 1), right->value(j));
+    if (!n->leaf)
+    {
+        set_child(n, n->count + 1, right->child(0));
+        for (int j = 0; j < right->count; ++j)
+            set_child(right, j, right->child(j + 1));
+    }
+    ++n->count;
+    --right->count;
+}
+
+/**
+ * @brief 把 right 和父节点中的分隔元素并入 left，释放 right
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::merge_nodes(node_ptr left, node_ptr right,
+                                                            iterator* track)
+{
+    node_ptr p = left->parent;
+    const int k = left->position;
+    const int lc = left->count;
+    transfer(left->value(lc), p->value(k));
+    for (int j = 0; j < right->count; ++j)
+        transfer(left->value(lc + 1 + j), right->value(j));
+    if (!left->leaf)
+    {
+        for (int j = 0; j <= right->count; ++j)
+            set_child(left, lc + 1 + j, right->child(j));
+    }
+    left->count = static_cast<std::uint16_t>(lc + 1 + right->count);
+
+    // 父节点删除分隔元素和指向 right 的指针
+    for (int j = k + 1; j < p->count; ++j)
+    {
+        transfer(p->value(j - 1), p->value(j));
+        set_child(p, j, p->child(j + 1));
+    }
+    --p->count;
+
+    if (rightmost_ == right)
+        rightmost_ = left;
+    if (track != nullptr && track->node == right)
+    {
+        track->node = left;
+        track->position += lc + 1;
+    }
+    right->count = 0;
+    free_node(right);
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::node_ptr
+btree<T, Compare, Alloc, TargetNodeSize>::new_leaf()
+{
+    leaf_allocator a(alloc_);
+    node_ptr n = leaf_alloc_traits::allocate(a, 1);
+    ::new (static_cast<void*>(n)) leaf_node;
+    n->parent = nullptr;
+    n->position = 0;
+    n->count = 0;
+    n->leaf = true;
+    return n;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::node_ptr
+btree<T, Compare, Alloc, TargetNodeSize>::new_internal()
+{
+    internal_allocator a(alloc_);
+    internal_node* n = internal_alloc_traits::allocate(a, 1);
+    ::new (static_cast<void*>(n)) internal_node;
+    n->parent = nullptr;
+    n->position = 0;
+    n->count = 0;
+    n->leaf = false;
+    std::fill(n->children, n->children + node_values + 1, nullptr);
+    return n;
+}
+
+/**
+ * @brief 归还节点的内存，节点中的元素必须已经销毁或移走
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::free_node(node_ptr n) noexcept
+{
+    if (n->leaf)
+    {
+        leaf_allocator a(alloc_);
+        leaf_alloc_traits::deallocate(a, n, 1);
+    }
+    else
+    {
+        internal_allocator a(alloc_);
+        internal_alloc_traits::deallocate(a, static_cast<internal_node*>(n), 1);
+    }
+}
+
+/**
+ * @brief 销毁以 n 为根的子树中的元素并释放节点；内部节点的空子节点指针跳过
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::destroy_subtree(node_ptr n) noexcept
+{
+    if (!n->leaf)
+    {
+        for (int j = 0; j <= n->count; ++j)
+        {
+            if (n->child(j) != nullptr)
+                destroy_subtree(n->child(j));
+        }
+    }
+    for (int j = 0; j < n->count; ++j)
+        data_alloc_traits::destroy(alloc_, n->value(j));
+    free_node(n);
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::clear() noexcept
+{
+    if (root_ != nullptr)
+    {
+        destroy_subtree(root_);
+        reset();
+    }
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::swap(btree& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        swap_data(rhs);
+        // 分配器不传播时两棵树的分配器必须相等
+        if (data_alloc_traits::propagate_on_container_swap::value)
+            std::swap(alloc_, rhs.alloc_);
+    }
+}
+
+/**
+ * @brief 按 src 的结构复制子树，O(n)，不做比较
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+typename btree<T, Compare, Alloc, TargetNodeSize>::node_ptr
+btree<T, Compare, Alloc, TargetNodeSize>::clone(node_ptr src, node_ptr parent)
+{
+    node_ptr n = src->leaf ? new_leaf() : new_internal();
+    n->parent = parent;
+    n->position = src->position;
+    try
+    {
+        for (int j = 0; j < src->count; ++j)
+        {
+            data_alloc_traits::construct(alloc_, n->value(j), *src->value(j));
+            ++n->count;
+        }
+        if (!src->leaf)
+        {
+            for (int j = 0; j <= src->count; ++j)
+                n->child(j) = clone(src->child(j), n);
+        }
+    }
+    catch (...)
+    {
+        destroy_subtree(n);
+        throw;
+    }
+    return n;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::copy_from(const btree& rhs)
+{
+    if (rhs.root_ == nullptr)
+        return;
+    root_ = clone(rhs.root_, nullptr);
+    leftmost_ = rightmost_ = root_;
+    while (!leftmost_->leaf)
+        leftmost_ = leftmost_->child(0);
+    while (!rightmost_->leaf)
+        rightmost_ = rightmost_->child(rightmost_->count);
+    size_ = rhs.size_;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::reset() noexcept
+{
+    root_ = leftmost_ = rightmost_ = nullptr;
+    size_ = 0;
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+void btree<T, Compare, Alloc, TargetNodeSize>::swap_data(btree& rhs) noexcept
+{
+    std::swap(root_, rhs.root_);
+    std::swap(leftmost_, rhs.leftmost_);
+    std::swap(rightmost_, rhs.rightmost_);
+    std::swap(size_, rhs.size_);
+    std::swap(comp_, rhs.comp_);
+}
+
+/**
+ * @brief 按顺序逐个比较两棵树的元素
+ */
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+bool operator==(const btree<T, Compare, Alloc, TargetNodeSize>& lhs,
+                const btree<T, Compare, Alloc, TargetNodeSize>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Compare, class Alloc, size_t TargetNodeSize>
+bool operator<(const btree<T, Compare, Alloc, TargetNodeSize>& lhs,
+               const btree<T, Compare, Alloc, TargetNodeSize>& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+/*****************************************************************************************/
+// 基于 B 树的容器
+
+/**
+ * @class btree_map
+ * @brief 基于 B 树的映射，键值不允许重复
+ *
+ * @tparam Key 键值类型
+ * @tparam T 实值类型
+ * @tparam Compare 键值比较方式，缺省使用 std::less
+ * @tparam Alloc 分配器类型，缺省使用 std::allocator
+ * @tparam TargetNodeSize 叶节点的目标字节数
+ */
+template <class Key, class T, class Compare = std::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, size_t TargetNodeSize = 256>
+class btree_map
+{
+public:
+    typedef Key                      key_type;
+    typedef T                        mapped_type;
+    typedef std::pair<const Key, T>  value_type;
+    typedef Compare                  key_compare;
+
+    /**
+     * @brief 按键比较两个元素
+     */
+    class value_compare
+    {
+        friend class btree_map;
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const
+        { return comp(lhs.first, rhs.first); }
+    protected:
+        explicit value_compare(Compare c) : comp(c) {}
+        Compare comp;
+    };
+
+private:
+    // 使用 B 树作为底层机制
+    typedef btree<value_type, key_compare, Alloc, TargetNodeSize> base_type;
+    base_type tree_;
+
+public:
+    // 使用 B 树的类型定义
+    typedef typename base_type::allocator_type         allocator_type;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::pointer                pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::reference              reference;
+    typedef typename base_type::const_reference        const_reference;
+
+    typedef typename base_type::iterator               iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+
+    btree_map() : tree_() {}
+
+    explicit btree_map(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+
+    explicit btree_map(const allocator_type& alloc) : tree_(Compare(), alloc) {}
+
+    template <class InputIterator>
+    btree_map(InputIterator first, InputIterator last,
+              const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_unique(first, last);
+    }
+
+    btree_map(std::initializer_list<value_type> ilist,
+              const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    btree_map(const btree_map& rhs) : tree_(rhs.tree_) {}
+    btree_map(btree_map&& rhs) noexcept : tree_(std::move(rhs.tree_)) {}
+    btree_map(const btree_map& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
+    btree_map(btree_map&& rhs, const allocator_type& alloc) : tree_(std::move(rhs.tree_), alloc) {}
+
+    btree_map& operator=(const btree_map& rhs)
+    {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+
+    btree_map& operator=(btree_map&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        tree_ = std::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_map& operator=(std::initializer_list<value_type> ilist)
+    {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+    // 迭代器相关
+
+    iterator               begin()         noexcept { return tree_.begin(); }
+    const_iterator         begin()   const noexcept { return tree_.begin(); }
+    iterator               end()           noexcept { return tree_.end(); }
+    const_iterator         end()     const noexcept { return tree_.end(); }
+    reverse_iterator       rbegin()        noexcept { return tree_.rbegin(); }
+    const_reverse_iterator rbegin()  const noexcept { return tree_.rbegin(); }
+    reverse_iterator       rend()          noexcept { return tree_.rend(); }
+    const_reverse_iterator rend()    const noexcept { return tree_.rend(); }
+    const_iterator         cbegin()  const noexcept { return tree_.cbegin(); }
+    const_iterator         cend()    const noexcept { return tree_.cend(); }
+    const_reverse_iterator crbegin() const noexcept { return tree_.crbegin(); }
+    const_reverse_iterator crend()   const noexcept { return tree_.crend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return tree_.empty(); }
+    size_type size()     const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 访问元素相关
+
+    mapped_type& at(const key_type& key)
+    {
+        iterator it = tree_.find(key);
+        if (it == end())
+            throw std::out_of_range("btree_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const
+    {
+        const_iterator it = tree_.find(key);
+        if (it == end())
+            throw std::out_of_range("btree_map<Key, T> no such element exists");
+        return it->second;
+    }
+
+    mapped_type& operator[](const key_type& key)
+    { return try_emplace(key).first->second; }
+
+    mapped_type& operator[](key_type&& key)
+    { return try_emplace(std::move(key)).first->second; }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args)
+    { return tree_.emplace_unique(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return tree_.emplace_unique(std::forward<Args>(args)...).first; }
+
+    /**
+     * @brief 键不存在时才用 args 构造实值；键已存在时不构造任何对象
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key(key, std::piecewise_construct,
+                                        std::forward_as_tuple(key),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key(key, std::piecewise_construct,
+                                        std::forward_as_tuple(std::move(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+    {
+        auto result = try_emplace(key, std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+    {
+        auto result = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    { return tree_.insert_unique(value); }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    { return tree_.insert_unique(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return tree_.insert_unique(value).first; }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return tree_.insert_unique(std::move(value)).first; }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { tree_.insert_unique(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator position)                   { return tree_.erase(position); }
+    iterator  erase(iterator position)                         { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key)                       { return tree_.erase_unique(key); }
+
+    void clear() noexcept { tree_.clear(); }
+
+    void swap(btree_map& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    // 查找相关
+
+    iterator       find(const key_type& key)              { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+    size_type      count(const key_type& key)       const { return tree_.count_unique(key); }
+    iterator       lower_bound(const key_type& key)       { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator       upper_bound(const key_type& key)       { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key)
+    { return tree_.equal_range_unique(key); }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+    { return tree_.equal_range_unique(key); }
+
+    /**
+     * @brief 树高，用于观察节点大小的影响
+     */
+    size_type height() const noexcept { return tree_.height(); }
+
+public:
+    friend bool operator==(const btree_map& lhs, const btree_map& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_map& lhs, const btree_map& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+/**
+ * @class btree_multimap
+ * @brief 基于 B 树的映射，键值允许重复，相等的键按插入顺序排列
+ */
+template <class Key, class T, class Compare = std::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, size_t TargetNodeSize = 256>
+class btree_multimap
+{
+public:
+    typedef Key                      key_type;
+    typedef T                        mapped_type;
+    typedef std::pair<const Key, T>  value_type;
+    typedef Compare                  key_compare;
+
+    class value_compare
+    {
+        friend class btree_multimap;
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const
+        { return comp(lhs.first, rhs.first); }
+    protected:
+        explicit value_compare(Compare c) : comp(c) {}
+        Compare comp;
+    };
+
+private:
+    typedef btree<value_type, key_compare, Alloc, TargetNodeSize> base_type;
+    base_type tree_;
+
+public:
+    typedef typename base_type::allocator_type         allocator_type;
+    typedef typename base_type::size_type              size_type;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::pointer                pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::reference              reference;
+    typedef typename base_type::const_reference        const_reference;
+
+    typedef typename base_type::iterator               iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+
+    btree_multimap() : tree_() {}
+
+    explicit btree_multimap(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+
+    explicit btree_multimap(const allocator_type& alloc) : tree_(Compare(), alloc) {}
+
+    template <class InputIterator>
+    btree_multimap(InputIterator first, InputIterator last,
+                   const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_multi(first, last);
+    }
+
+    btree_multimap(std::initializer_list<value_type> ilist,
+                   const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_multi(ilist.begin(), ilist.end());
+    }
+
+    btree_multimap(const btree_multimap& rhs) : tree_(rhs.tree_) {}
+    btree_multimap(btree_multimap&& rhs) noexcept : tree_(std::move(rhs.tree_)) {}
+    btree_multimap(const btree_multimap& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
+    btree_multimap(btree_multimap&& rhs, const allocator_type& alloc) : tree_(std::move(rhs.tree_), alloc) {}
+
+    btree_multimap& operator=(const btree_multimap& rhs)
+    {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+
+    btree_multimap& operator=(btree_multimap&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        tree_ = std::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_multimap& operator=(std::initializer_list<value_type> ilist)
+    {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+    // 迭代器相关
+
+    iterator               begin()         noexcept { return tree_.begin(); }
+    const_iterator         begin()   const noexcept { return tree_.begin(); }
+    iterator               end()           noexcept { return tree_.end(); }
+    const_iterator         end()     const noexcept { return tree_.end(); }
+    reverse_iterator       rbegin()        noexcept { return tree_.rbegin(); }
+    const_reverse_iterator rbegin()  const noexcept { return tree_.rbegin(); }
+    reverse_iterator       rend()          noexcept { return tree_.rend(); }
+    const_reverse_iterator rend()    const noexcept { return tree_.rend(); }
+    const_iterator         cbegin()  const noexcept { return tree_.cbegin(); }
+    const_iterator         cend()    const noexcept { return tree_.cend(); }
+    const_reverse_iterator crbegin() const noexcept { return tree_.crbegin(); }
+    const_reverse_iterator crend()   const noexcept { return tree_.crend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return tree_.empty(); }
+    size_type size()     const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args)
+    { return tree_.emplace_multi(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return tree_.emplace_multi(std::forward<Args>(args)...); }
+
+    iterator insert(const value_type& value)
+    { return tree_.insert_multi(value); }
+
+    iterator insert(value_type&& value)
+    { return tree_.insert_multi(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return tree_.insert_multi(value); }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return tree_.insert_multi(std::move(value)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { tree_.insert_multi(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator position)                   { return tree_.erase(position); }
+    iterator  erase(iterator position)                         { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key)                       { return tree_.erase_multi(key); }
+
+    void clear() noexcept { tree_.clear(); }
+
+    void swap(btree_multimap& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    // 查找相关
+
+    iterator       find(const key_type& key)              { return tree_.find(key); }
+    const_iterator find(const key_type& key)        const { return tree_.find(key); }
+    size_type      count(const key_type& key)       const { return tree_.count_multi(key); }
+    iterator       lower_bound(const key_type& key)       { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator       upper_bound(const key_type& key)       { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key)
+    { return tree_.equal_range_multi(key); }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+    { return tree_.equal_range_multi(key); }
+
+    size_type height() const noexcept { return tree_.height(); }
+
+public:
+    friend bool operator==(const btree_multimap& lhs, const btree_multimap& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_multimap& lhs, const btree_multimap& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+/**
+ * @class btree_set
+ * @brief 基于 B 树的集合，键值不允许重复
+ *
+ * @tparam Key 键值类型
+ * @tparam Compare 键值比较方式，缺省使用 std::less
+ * @tparam Alloc 分配器类型，缺省使用 std::allocator
+ * @tparam TargetNodeSize 叶节点的目标字节数
+ */
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>,
+          size_t TargetNodeSize = 256>
+class btree_set
+{
+public:
+    typedef Key     key_type;
+    typedef Key     value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef btree<value_type, key_compare, Alloc, TargetNodeSize> base_type;
+    base_type tree_;
+
+public:
+    typedef typename base_type::allocator_type               allocator_type;
+    typedef typename base_type::size_type                    size_type;
+    typedef typename base_type::difference_type              difference_type;
+    typedef typename base_type::const_pointer                pointer;
+    typedef typename base_type::const_pointer                const_pointer;
+    typedef typename base_type::const_reference              reference;
+    typedef typename base_type::const_reference              const_reference;
+
+    typedef typename base_type::const_iterator               iterator;
+    typedef typename base_type::const_iterator               const_iterator;
+    typedef typename base_type::const_reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator       const_reverse_iterator;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+
+    btree_set() : tree_() {}
+
+    explicit btree_set(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+
+    explicit btree_set(const allocator_type& alloc) : tree_(Compare(), alloc) {}
+
+    template <class InputIterator>
+    btree_set(InputIterator first, InputIterator last,
+              const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_unique(first, last);
+    }
+
+    btree_set(std::initializer_list<value_type> ilist,
+              const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    btree_set(const btree_set& rhs) : tree_(rhs.tree_) {}
+    btree_set(btree_set&& rhs) noexcept : tree_(std::move(rhs.tree_)) {}
+    btree_set(const btree_set& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
+    btree_set(btree_set&& rhs, const allocator_type& alloc) : tree_(std::move(rhs.tree_), alloc) {}
+
+    btree_set& operator=(const btree_set& rhs)
+    {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+
+    btree_set& operator=(btree_set&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        tree_ = std::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_set& operator=(std::initializer_list<value_type> ilist)
+    {
+        tree_.clear();
+        tree_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return tree_.key_comp(); }
+
+    // 迭代器相关
+
+    iterator               begin()   const noexcept { return tree_.begin(); }
+    iterator               end()     const noexcept { return tree_.end(); }
+    reverse_iterator       rbegin()  const noexcept { return tree_.rbegin(); }
+    reverse_iterator       rend()    const noexcept { return tree_.rend(); }
+    const_iterator         cbegin()  const noexcept { return tree_.cbegin(); }
+    const_iterator         cend()    const noexcept { return tree_.cend(); }
+    const_reverse_iterator crbegin() const noexcept { return tree_.crbegin(); }
+    const_reverse_iterator crend()   const noexcept { return tree_.crend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return tree_.empty(); }
+    size_type size()     const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args)
+    { return tree_.emplace_unique(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return tree_.emplace_unique(std::forward<Args>(args)...).first; }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    { return tree_.insert_unique(value); }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    { return tree_.insert_unique(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return tree_.insert_unique(value).first; }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return tree_.insert_unique(std::move(value)).first; }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { tree_.insert_unique(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { tree_.insert_unique(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator position)                   { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key)                       { return tree_.erase_unique(key); }
+
+    void clear() noexcept { tree_.clear(); }
+
+    void swap(btree_set& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    // 查找相关
+
+    iterator  find(const key_type& key)        const { return tree_.find(key); }
+    size_type count(const key_type& key)       const { return tree_.count_unique(key); }
+    iterator  lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator  upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const
+    { return tree_.equal_range_unique(key); }
+
+    size_type height() const noexcept { return tree_.height(); }
+
+public:
+    friend bool operator==(const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_set& lhs, const btree_set& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+/**
+ * @class btree_multiset
+ * @brief 基于 B 树的集合，键值允许重复
+ */
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>,
+          size_t TargetNodeSize = 256>
+class btree_multiset
+{
+public:
+    typedef Key     key_type;
+    typedef Key     value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef btree<value_type, key_compare, Alloc, TargetNodeSize> base_type;
+    base_type tree_;
+
+public:
+    typedef typename base_type::allocator_type               allocator_type;
+    typedef typename base_type::size_type                    size_type;
+    typedef typename base_type::difference_type              difference_type;
+    typedef typename base_type::const_pointer                pointer;
+    typedef typename base_type::const_pointer                const_pointer;
+    typedef typename base_type::const_reference              reference;
+    typedef typename base_type::const_reference              const_reference;
+
+    typedef typename base_type::const_iterator               iterator;
+    typedef typename base_type::const_iterator               const_iterator;
+    typedef typename base_type::const_reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator       const_reverse_iterator;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+
+    btree_multiset() : tree_() {}
+
+    explicit btree_multiset(const Compare& comp, const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc) {}
+
+    explicit btree_multiset(const allocator_type& alloc) : tree_(Compare(), alloc) {}
+
+    template <class InputIterator>
+    btree_multiset(InputIterator first, InputIterator last,
+                   const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_multi(first, last);
+    }
+
+    btree_multiset(std::initializer_list<value_type> ilist,
+                   const Compare& comp = Compare(), const allocator_type& alloc = allocator_type())
+        : tree_(comp, alloc)
+    {
+        tree_.insert_multi(ilist.begin(), ilist.end());
+    }
+
+    btree_multiset(const btree_multiset& rhs) : tree_(rhs.tree_) {}
+    btree_multiset(btree_multiset&& rhs) noexcept : tree_(std::move(rhs.tree_)) {}
+    btree_multiset(const btree_multiset& rhs, const allocator_type& alloc) : tree_(rhs.tree_, alloc) {}
+    btree_multiset(btree_multiset&& rhs, const allocator_type& alloc) : tree_(std::move(rhs.tree_), alloc) {}
+
+    btree_multiset& operator=(const btree_multiset& rhs)
+    {
+        tree_ = rhs.tree_;
+        return *this;
+    }
+
+    btree_multiset& operator=(btree_multiset&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        tree_ = std::move(rhs.tree_);
+        return *this;
+    }
+
+    btree_multiset& operator=(std::initializer_list<value_type> ilist)
+    {
+        tree_.clear();
+        tree_.insert_multi(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return tree_.key_comp(); }
+
+    // 迭代器相关
+
+    iterator               begin()   const noexcept { return tree_.begin(); }
+    iterator               end()     const noexcept { return tree_.end(); }
+    reverse_iterator       rbegin()  const noexcept { return tree_.rbegin(); }
+    reverse_iterator       rend()    const noexcept { return tree_.rend(); }
+    const_iterator         cbegin()  const noexcept { return tree_.cbegin(); }
+    const_iterator         cend()    const noexcept { return tree_.cend(); }
+    const_reverse_iterator crbegin() const noexcept { return tree_.crbegin(); }
+    const_reverse_iterator crend()   const noexcept { return tree_.crend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return tree_.empty(); }
+    size_type size()     const noexcept { return tree_.size(); }
+    size_type max_size() const noexcept { return tree_.max_size(); }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    iterator emplace(Args&& ...args)
+    { return tree_.emplace_multi(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return tree_.emplace_multi(std::forward<Args>(args)...); }
+
+    iterator insert(const value_type& value)
+    { return tree_.insert_multi(value); }
+
+    iterator insert(value_type&& value)
+    { return tree_.insert_multi(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return tree_.insert_multi(value); }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return tree_.insert_multi(std::move(value)); }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { tree_.insert_multi(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { tree_.insert_multi(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator position)                   { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key)                       { return tree_.erase_multi(key); }
+
+    void clear() noexcept { tree_.clear(); }
+
+    void swap(btree_multiset& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    // 查找相关
+
+    iterator  find(const key_type& key)        const { return tree_.find(key); }
+    size_type count(const key_type& key)       const { return tree_.count_multi(key); }
+    iterator  lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator  upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const
+    { return tree_.equal_range_multi(key); }
+
+    size_type height() const noexcept { return tree_.height(); }
+
+public:
+    friend bool operator==(const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator< (const btree_multiset& lhs, const btree_multiset& rhs) { return lhs.tree_ <  rhs.tree_; }
+};
+
+// 其余比较运算符与 swap
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator!=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) { return !(lhs == rhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator>(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) { return rhs < lhs; }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator<=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) { return !(rhs < lhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator>=(const btree_map<Key, T, Compare, Alloc, N>& lhs, const btree_map<Key, T, Compare, Alloc, N>& rhs) { return !(lhs < rhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+void swap(btree_map<Key, T, Compare, Alloc, N>& lhs, btree_map<Key, T, Compare, Alloc, N>& rhs) noexcept { lhs.swap(rhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator!=(const btree_multimap<Key, T, Compare, Alloc, N>& lhs, const btree_multimap<Key, T, Compare, Alloc, N>& rhs) { return !(lhs == rhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator>(const btree_multimap<Key, T, Compare, Alloc, N>& lhs, const btree_multimap<Key, T, Compare, Alloc, N>& rhs) { return rhs < lhs; }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator<=(const btree_multimap<Key, T, Compare, Alloc, N>& lhs, const btree_multimap<Key, T, Compare, Alloc, N>& rhs) { return !(rhs < lhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+bool operator>=(const btree_multimap<Key, T, Compare, Alloc, N>& lhs, const btree_multimap<Key, T, Compare, Alloc, N>& rhs) { return !(lhs < rhs); }
+
+template <class Key, class T, class Compare, class Alloc, size_t N>
+void swap(btree_multimap<Key, T, Compare, Alloc, N>& lhs, btree_multimap<Key, T, Compare, Alloc, N>& rhs) noexcept { lhs.swap(rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator!=(const btree_set<Key, Compare, Alloc, N>& lhs, const btree_set<Key, Compare, Alloc, N>& rhs) { return !(lhs == rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator>(const btree_set<Key, Compare, Alloc, N>& lhs, const btree_set<Key, Compare, Alloc, N>& rhs) { return rhs < lhs; }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator<=(const btree_set<Key, Compare, Alloc, N>& lhs, const btree_set<Key, Compare, Alloc, N>& rhs) { return !(rhs < lhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator>=(const btree_set<Key, Compare, Alloc, N>& lhs, const btree_set<Key, Compare, Alloc, N>& rhs) { return !(lhs < rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+void swap(btree_set<Key, Compare, Alloc, N>& lhs, btree_set<Key, Compare, Alloc, N>& rhs) noexcept { lhs.swap(rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator!=(const btree_multiset<Key, Compare, Alloc, N>& lhs, const btree_multiset<Key, Compare, Alloc, N>& rhs) { return !(lhs == rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator>(const btree_multiset<Key, Compare, Alloc, N>& lhs, const btree_multiset<Key, Compare, Alloc, N>& rhs) { return rhs < lhs; }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator<=(const btree_multiset<Key, Compare, Alloc, N>& lhs, const btree_multiset<Key, Compare, Alloc, N>& rhs) { return !(rhs < lhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+bool operator>=(const btree_multiset<Key, Compare, Alloc, N>& lhs, const btree_multiset<Key, Compare, Alloc, N>& rhs) { return !(lhs < rhs); }
+
+template <class Key, class Compare, class Alloc, size_t N>
+void swap(btree_multiset<Key, Compare, Alloc, N>& lhs, btree_multiset<Key, Compare, Alloc, N>& rhs) noexcept { lhs.swap(rhs); }
+
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 B 树容器
+ */
+template <class Key, class T, class Compare = std::less<Key>>
+using btree_map = mystl::btree_map<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <class Key, class T, class Compare = std::less<Key>>
+using btree_multimap =
+    mystl::btree_multimap<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <class Key, class Compare = std::less<Key>>
+using btree_set = mystl::btree_set<Key, Compare, polymorphic_allocator<Key>>;
+
+template <class Key, class Compare = std::less<Key>>
+using btree_multiset = mystl::btree_multiset<Key, Compare, polymorphic_allocator<Key>>;
+
+} // namespace pmr
+
+} // namespace mystl
+
+#endif // MY_BTREE_H
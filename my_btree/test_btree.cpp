@@ -0,0 +1,342 @@
+// test_btree.cpp
+// 测试 btree_map / btree_multimap / btree_set / btree_multiset 的功能
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <random>
+#include <cassert>
+#include <utility>
+#include <functional>
+
+#include "my_btree.h"
+
+/**
+ * @brief 比较两个有序容器的内容，正向与反向遍历都要一致
+ */
+template <class Container, class Reference>
+void check_same(const Container& c, const Reference& ref) {
+    assert(c.size() == ref.size());
+    assert(c.empty() == ref.empty());
+    auto it = c.begin();
+    for (auto rit = ref.begin(); rit != ref.end(); ++rit, ++it) {
+        assert(it != c.end());
+        assert(*it == *rit);
+    }
+    assert(it == c.end());
+    auto rit2 = c.rbegin();
+    for (auto rit = ref.rbegin(); rit != ref.rend(); ++rit, ++rit2) {
+        assert(*rit2 == *rit);
+    }
+    assert(rit2 == c.rend());
+}
+
+/**
+ * @brief 测试 btree_map 的基本功能
+ */
+void test_btree_map_basic() {
+    std::cout << "===== 测试 btree_map 基本功能 =====" << std::endl;
+
+    mystl::btree_map<int, std::string> map1;
+    assert(map1.empty());
+    assert(map1.begin() == map1.end());
+    assert(map1.find(1) == map1.end());
+    assert(map1.lower_bound(1) == map1.end());
+    assert(map1.height() == 0);
+
+    auto ret1 = map1.insert(std::make_pair(1, std::string("一")));
+    assert(ret1.second);
+    assert(ret1.first->first == 1 && ret1.first->second == "一");
+
+    // 重复插入
+    auto ret2 = map1.insert(std::make_pair(1, std::string("一一")));
+    assert(!ret2.second);
+    assert(map1.size() == 1);
+    assert(map1.at(1) == "一");
+
+    map1[3] = "三";
+    map1[2] = "二";
+    map1[2] = "二二";
+    assert(map1.size() == 3);
+    assert(map1[2] == "二二");
+    assert(map1.count(3) == 1 && map1.count(4) == 0);
+
+    auto ret3 = map1.emplace(4, "四");
+    assert(ret3.second && map1.at(4) == "四");
+    auto ret4 = map1.try_emplace(4, "肆");
+    assert(!ret4.second && ret4.first->second == "四");
+    auto ret5 = map1.insert_or_assign(4, std::string("肆"));
+    assert(!ret5.second && map1.at(4) == "肆");
+
+    bool thrown = false;
+    try {
+        map1.at(100);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 有序遍历
+    int expect = 1;
+    for (const auto& kv : map1) {
+        assert(kv.first == expect++);
+    }
+
+    auto range = map1.equal_range(2);
+    assert(range.first->first == 2 && range.second->first == 3);
+    assert(map1.lower_bound(0)->first == 1);
+    assert(map1.upper_bound(4) == map1.end());
+
+    // 删除
+    assert(map1.erase(1) == 1);
+    assert(map1.erase(1) == 0);
+    auto next = map1.erase(map1.find(2));
+    assert(next->first == 3);
+    assert(map1.size() == 2);
+
+    map1.clear();
+    assert(map1.empty() && map1.begin() == map1.end());
+
+    std::cout << "btree_map 基本功能测试通过!" << std::endl;
+}
+
+/**
+ * @brief 与 std::map 对照的随机插入、删除、查找，覆盖节点分裂、借用、合并
+ */
+void test_btree_map_random() {
+    std::cout << "===== 测试 btree_map 随机操作 =====" << std::endl;
+
+    std::mt19937 rng(12345);
+    mystl::btree_map<int, int> bt;
+    std::map<int, int> ref;
+
+    for (int round = 0; round < 200000; ++round) {
+        const int key = static_cast<int>(rng() % 5000);
+        switch (rng() % 4) {
+        case 0:
+        case 1: {
+            auto r1 = bt.insert(std::make_pair(key, round));
+            auto r2 = ref.insert(std::make_pair(key, round));
+            assert(r1.second == r2.second);
+            assert(r1.first->first == key && r1.first->second == r2.first->second);
+            break;
+        }
+        case 2: {
+            assert(bt.erase(key) == ref.erase(key));
+            break;
+        }
+        default: {
+            auto it1 = bt.lower_bound(key);
+            auto it2 = ref.lower_bound(key);
+            if (it2 == ref.end()) {
+                assert(it1 == bt.end());
+            } else {
+                assert(it1 != bt.end() && it1->first == it2->first);
+                // 删除返回的迭代器指向下一个元素
+                it1 = bt.erase(it1);
+                it2 = ref.erase(it2);
+                assert((it1 == bt.end()) == (it2 == ref.end()));
+                if (it2 != ref.end()) {
+                    assert(it1->first == it2->first);
+                }
+            }
+            break;
+        }
+        }
+        assert(bt.size() == ref.size());
+        if (round % 20000 == 0) {
+            check_same(bt, ref);
+        }
+    }
+    check_same(bt, ref);
+
+    // 顺序、逆序插入
+    mystl::btree_map<int, int> asc, desc;
+    for (int i = 0; i < 100000; ++i) {
+        asc[i] = i;
+        desc[100000 - i] = i;
+    }
+    assert(asc.size() == 100000 && desc.size() == 100000);
+    int expect = 0;
+    for (const auto& kv : asc) {
+        assert(kv.first == expect++);
+    }
+    assert(desc.begin()->first == 1 && desc.rbegin()->first == 100000);
+
+    // 区间删除
+    auto first = asc.lower_bound(1000);
+    auto last = asc.lower_bound(90000);
+    auto it = asc.erase(first, last);
+    assert(it->first == 90000);
+    assert(asc.size() == 100000 - 89000);
+    assert(asc.find(999) != asc.end() && asc.find(1000) == asc.end());
+    asc.erase(asc.begin(), asc.end());
+    assert(asc.empty());
+
+    // 边遍历边删除
+    for (auto i = desc.begin(); i != desc.end();) {
+        if (i->first % 3 == 0) {
+            i = desc.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    for (const auto& kv : desc) {
+        assert(kv.first % 3 != 0);
+    }
+    // 逆序删除到空
+    while (!desc.empty()) {
+        auto last_it = desc.end();
+        --last_it;
+        desc.erase(last_it);
+    }
+    assert(desc.begin() == desc.end());
+
+    std::cout << "btree_map 随机操作测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 btree_multimap 与 btree_multiset：相等的键按插入顺序排列
+ */
+void test_btree_multi() {
+    std::cout << "===== 测试 btree_multimap / btree_multiset =====" << std::endl;
+
+    std::mt19937 rng(2024);
+    mystl::btree_multimap<int, int> bt;
+    std::multimap<int, int> ref;
+    for (int i = 0; i < 50000; ++i) {
+        const int key = static_cast<int>(rng() % 300);
+        bt.insert(std::make_pair(key, i));
+        ref.insert(std::make_pair(key, i));
+    }
+    check_same(bt, ref);
+    for (int key = 0; key < 300; key += 7) {
+        assert(bt.count(key) == ref.count(key));
+        auto r1 = bt.equal_range(key);
+        auto r2 = ref.equal_range(key);
+        for (; r2.first != r2.second; ++r1.first, ++r2.first) {
+            assert(*r1.first == *r2.first);
+        }
+        assert(r1.first == r1.second);
+        assert(bt.erase(key) == ref.erase(key));
+    }
+    check_same(bt, ref);
+
+    mystl::btree_multiset<std::string> ms{"b", "a", "b", "c", "b"};
+    assert(ms.size() == 5 && ms.count("b") == 3);
+    assert(*ms.begin() == "a" && *ms.rbegin() == "c");
+    // 插入容器自身的元素
+    ms.insert(*ms.begin());
+    assert(ms.count("a") == 2);
+    assert(ms.erase("b") == 3);
+    assert(ms.size() == 3);
+
+    std::cout << "btree_multimap / btree_multiset 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 btree_set，节点较小时树更高，分裂与合并更频繁
+ */
+void test_btree_set() {
+    std::cout << "===== 测试 btree_set =====" << std::endl;
+
+    typedef mystl::btree_set<int, std::greater<int>, std::allocator<int>, 64> small_set;
+    std::mt19937 rng(7);
+    small_set bt;
+    std::set<int, std::greater<int>> ref;
+    for (int i = 0; i < 100000; ++i) {
+        const int v = static_cast<int>(rng() % 20000);
+        if (rng() % 3 == 0) {
+            assert(bt.erase(v) == ref.erase(v));
+        } else {
+            assert(bt.insert(v).second == ref.insert(v).second);
+        }
+    }
+    check_same(bt, ref);
+    assert(bt.height() > 3);
+
+    for (int v = 0; v < 20000; v += 13) {
+        auto it1 = bt.upper_bound(v);
+        auto it2 = ref.upper_bound(v);
+        assert((it1 == bt.end()) == (it2 == ref.end()));
+        if (it2 != ref.end()) {
+            assert(*it1 == *it2);
+        }
+    }
+
+    std::vector<int> data;
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(i * 2);
+    }
+    mystl::btree_set<int> set2(data.begin(), data.end());
+    assert(set2.size() == 1000);
+    assert(set2.find(500) != set2.end() && set2.find(501) == set2.end());
+    assert(*set2.lower_bound(501) == 502);
+
+    std::cout << "btree_set 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试复制、移动、交换、比较与 pmr 别名
+ */
+void test_btree_copy_move() {
+    std::cout << "===== 测试 btree 复制与移动 =====" << std::endl;
+
+    mystl::btree_map<int, std::string> a;
+    for (int i = 0; i < 5000; ++i) {
+        a[i] = std::to_string(i);
+    }
+    mystl::btree_map<int, std::string> b(a);
+    assert(a == b);
+    b[5000] = "5000";
+    assert(a != b && a < b);
+
+    mystl::btree_map<int, std::string> c(std::move(b));
+    assert(b.empty() && c.size() == 5001);
+    b = c;
+    assert(b == c);
+    c = std::move(a);
+    assert(c.size() == 5000 && a.empty());
+    a.swap(b);
+    assert(a.size() == 5001 && b.empty());
+    mystl::swap(a, c);
+    assert(a.size() == 5000 && c.size() == 5001);
+    assert(c.at(4999) == "4999" && c.rbegin()->second == "5000");
+
+    mystl::btree_set<int> s1{3, 1, 2};
+    mystl::btree_set<int> s2;
+    s2 = {1, 2, 3};
+    assert(s1 == s2);
+
+    // pmr 别名：节点与字符串都来自同一内存资源
+    mystl::pmr::monotonic_buffer_resource arena;
+    mystl::pmr::btree_map<int, int> pm(&arena);
+    for (int i = 0; i < 10000; ++i) {
+        pm[i] = i;
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        pm.erase(i);
+    }
+    assert(pm.size() == 5000 && pm.begin()->first == 1);
+
+    // 分配器不同时移动构造逐个移动元素
+    mystl::pmr::monotonic_buffer_resource other;
+    mystl::pmr::btree_map<int, int> pm2(std::move(pm), mystl::pmr::polymorphic_allocator<int>(&other));
+    assert(pm2.size() == 5000 && pm.empty());
+    assert(pm2.get_allocator().resource() == &other);
+
+    std::cout << "btree 复制与移动测试通过!" << std::endl;
+}
+
+int main() {
+    test_btree_map_basic();
+    test_btree_map_random();
+    test_btree_multi();
+    test_btree_set();
+    test_btree_copy_move();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
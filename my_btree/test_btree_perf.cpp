@@ -0,0 +1,138 @@
+// test_btree_perf.cpp
+// 对比 B 树与红黑树：随机 / 顺序插入、查找、全量遍历、范围扫描、删除
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <cstdlib>
+
+#include "my_btree.h"
+#include "../my_rb_tree/my_rb_tree.h"
+
+/**
+ * 计时辅助函数，返回 f 的执行时间（毫秒）
+ */
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * 打印一行结果：红黑树与 B 树的耗时及加速比
+ */
+void report(const char* name, double rb_ms, double bt_ms) {
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << rb_ms << " ms" << std::setw(10) << bt_ms << " ms"
+              << std::setw(8) << std::setprecision(2) << rb_ms / bt_ms << "x" << std::endl;
+}
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+typedef mystl::rb_tree<int, std::less<int>> rb_set;
+typedef mystl::btree_set<int>               bt_set;
+
+/**
+ * 在 n 个随机整数上对比各项操作
+ */
+void run(size_t n) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+    std::vector<int> keys(n);
+    for (auto& k : keys) {
+        k = dist(gen);
+    }
+    std::vector<int> probes(keys);
+    std::shuffle(probes.begin(), probes.end(), gen);
+
+    std::cout << "\n数据量: " << n << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "操作" << std::right
+              << std::setw(13) << "rb_tree" << std::setw(13) << "btree" << std::setw(9) << "加速" << std::endl;
+
+    rb_set rb;
+    bt_set bt;
+    double rb_ms = time_ms([&] { for (int k : keys) rb.insert_unique(k); });
+    double bt_ms = time_ms([&] { for (int k : keys) bt.insert(k); });
+    report("随机插入", rb_ms, bt_ms);
+
+    rb_ms = time_ms([&] {
+        long long s = 0;
+        for (int k : probes) s += rb.find(k) != rb.end();
+        g_sink += s;
+    });
+    bt_ms = time_ms([&] {
+        long long s = 0;
+        for (int k : probes) s += bt.find(k) != bt.end();
+        g_sink += s;
+    });
+    report("随机查找", rb_ms, bt_ms);
+
+    rb_ms = time_ms([&] {
+        long long s = 0;
+        for (int r = 0; r < 10; ++r)
+            for (auto it = rb.begin(); it != rb.end(); ++it) s += *it;
+        g_sink += s;
+    });
+    bt_ms = time_ms([&] {
+        long long s = 0;
+        for (int r = 0; r < 10; ++r)
+            for (auto it = bt.begin(); it != bt.end(); ++it) s += *it;
+        g_sink += s;
+    });
+    report("全量遍历 x10", rb_ms, bt_ms);
+
+    // 每次从随机位置开始向后扫描 100 个元素
+    const size_t scans = n / 10;
+    rb_ms = time_ms([&] {
+        long long s = 0;
+        for (size_t i = 0; i < scans; ++i) {
+            auto it = rb.lower_bound(probes[i]);
+            for (int j = 0; j < 100 && it != rb.end(); ++j, ++it) s += *it;
+        }
+        g_sink += s;
+    });
+    bt_ms = time_ms([&] {
+        long long s = 0;
+        for (size_t i = 0; i < scans; ++i) {
+            auto it = bt.lower_bound(probes[i]);
+            for (int j = 0; j < 100 && it != bt.end(); ++j, ++it) s += *it;
+        }
+        g_sink += s;
+    });
+    report("lower_bound + 扫描100", rb_ms, bt_ms);
+
+    rb_ms = time_ms([&] { for (int k : probes) rb.erase_unique(k); });
+    bt_ms = time_ms([&] { for (int k : probes) bt.erase(k); });
+    report("随机删除", rb_ms, bt_ms);
+
+    rb_set rb_seq;
+    bt_set bt_seq;
+    rb_ms = time_ms([&] { for (size_t i = 0; i < n; ++i) rb_seq.insert_unique(static_cast<int>(i)); });
+    bt_ms = time_ms([&] { for (size_t i = 0; i < n; ++i) bt_seq.insert(static_cast<int>(i)); });
+    report("顺序插入", rb_ms, bt_ms);
+    std::cout << "  B 树高度: " << bt_seq.height() << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "===== B 树与红黑树性能对比 =====" << std::endl;
+    const size_t node_values = mystl::btree<int, std::less<int>>::node_values;
+    std::cout << "btree_set<int> 每个节点 " << node_values
+              << " 个元素，叶节点 " << sizeof(mystl::btree_node<int, node_values>)
+              << " 字节；红黑树每个元素一个节点" << std::endl;
+
+    if (argc > 1) {
+        run(std::strtoul(argv[1], nullptr, 10));
+    } else {
+        run(100000);
+        run(1000000);
+    }
+    return 0;
+}
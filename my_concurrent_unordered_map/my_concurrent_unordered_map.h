@@ -0,0 +1,598 @@
+#ifndef MY_CONCURRENT_UNORDERED_MAP_H
+#define MY_CONCURRENT_UNORDERED_MAP_H
+
+// 这个头文件包含一个模板类 concurrent_unordered_map，可以被多个线程同时访问的无序映射
+//
+// 元素按键的哈希值分散到若干个分片（shard）中，每个分片是一个 unordered_map 加一把互斥锁：
+//   * 访问不同分片的线程互不阻塞，只有落在同一分片上的操作才会串行
+//   * 重哈希只发生在单个分片内部，持有的也只是这个分片的锁，其他分片照常读写
+//
+// 与 unordered_map 不同，这里不提供迭代器：迭代器离开锁之后随时可能失效。
+// 读取使用 find 拷贝出实值，或者使用 visit 在持有锁的情况下访问元素；
+// 遍历使用 for_each / for_each_shard，逐个分片加锁后访问
+//
+// 除 for_each_shard 的回调内部以外，所有成员函数都可以被多个线程同时调用（构造、析构和 swap 除外）
+//
+// 分配器：各分片通过 make_shard_allocator 得到自己的分配器，不同分片的分配发生在不同的锁下
+//   * std::allocator 等无状态分配器直接拷贝
+//   * pool_allocator 的内存池不是线程安全的，每个分片使用一个新的内存池
+//   * 其他有状态分配器直接拷贝，各分片共享同一份状态，这份状态必须允许多个线程同时分配，
+//     例如 pmr::polymorphic_allocator 应使用 pmr::synchronized_pool_resource 这类线程安全的 memory_resource
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include "../my_unordered_map/my_unordered_map.h"
+#include "../my_node_pool/my_node_pool.h"
+
+namespace mystl
+{
+
+/**
+ * @brief 为 concurrent_unordered_map 的一个分片生成分配器
+ *
+ * 默认直接拷贝 alloc，各分片共享它的状态，要求这份状态本身是线程安全的
+ */
+template <class Alloc>
+Alloc make_shard_allocator(const Alloc& alloc)
+{
+    return alloc;
+}
+
+/**
+ * @brief pool_allocator 的拷贝共享同一个非线程安全的内存池，每个分片改用一个新的内存池，
+ * 由分片的锁保护
+ */
+template <class T>
+pool_allocator<T> make_shard_allocator(const pool_allocator<T>&)
+{
+    return pool_allocator<T>();
+}
+
+/**
+ * @class concurrent_unordered_map
+ * @brief 分片加锁的并发无序映射，键值不允许重复
+ *
+ * @tparam Key 键类型
+ * @tparam T 值类型
+ * @tparam Hash 哈希函数类型，默认使用 std::hash
+ * @tparam KeyEqual 键比较函数类型，默认使用 std::equal_to
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，各分片使用 make_shard_allocator 得到的分配器；
+ *               pool_allocator 以外的有状态分配器的各个副本必须可以被多个线程同时使用
+ * @tparam BucketPolicy 各分片的桶策略，默认使用素数个桶（ht_prime_policy）
+ */
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, class BucketPolicy = ht_prime_policy>
+class concurrent_unordered_map
+{
+public:
+    // 每个分片内部的容器类型，for_each_shard 的回调以它为参数
+    typedef unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy> shard_map;
+
+    typedef typename shard_map::allocator_type  allocator_type;
+    typedef typename shard_map::key_type        key_type;
+    typedef typename shard_map::mapped_type     mapped_type;
+    typedef typename shard_map::value_type      value_type;
+    typedef typename shard_map::hasher          hasher;
+    typedef typename shard_map::key_equal       key_equal;
+    typedef typename shard_map::size_type       size_type;
+
+private:
+    static constexpr size_type cache_line_size = 64;
+
+    /**
+     * @brief 一个分片：互斥锁和它保护的 unordered_map
+     *
+     * 按缓存行对齐，分片的锁和表头不会与相邻分片或其他内存落在同一条缓存行上，
+     * 否则一个线程加锁会让另一个线程缓存中无关的数据失效（伪共享）
+     */
+    struct alignas(cache_line_size) shard
+    {
+        mutable std::mutex mutex;
+        shard_map          map;
+
+        shard(size_type bucket_count, const Hash& hash, const KeyEqual& equal, const allocator_type& alloc)
+            : map(bucket_count, hash, equal, make_shard_allocator(alloc))
+        {
+        }
+    };
+
+    typedef std::unique_lock<std::mutex> lock_type;
+
+    // C++11 的 operator new 不保证超过 alignof(std::max_align_t) 的对齐，
+    // 分片数组放在手动对齐的原始内存 raw_ 中
+    void*     raw_;
+    shard*    shards_;
+    size_type shard_count_;
+    unsigned  shard_bits_;  // 分片数为 2^shard_bits_
+    hasher    hash_;
+
+public:
+    // 构造、析构函数
+
+    /**
+     * @brief 默认构造函数，分片数为 default_shard_count()
+     */
+    concurrent_unordered_map()
+        : concurrent_unordered_map(default_shard_count())
+    {
+    }
+
+    /**
+     * @brief 指定分片数的构造函数
+     *
+     * @param shard_count 分片数，向上取整为 2 的幂；为 0 时使用 default_shard_count()
+     * @param bucket_count 整个容器的初始桶数，平均分给各个分片
+     * @param hash 哈希函数
+     * @param equal 键比较函数
+     * @param alloc 分配器
+     */
+    explicit concurrent_unordered_map(size_type shard_count,
+                                      size_type bucket_count = 0,
+                                      const Hash& hash = Hash(),
+                                      const KeyEqual& equal = KeyEqual(),
+                                      const allocator_type& alloc = allocator_type())
+        : raw_(nullptr), shards_(nullptr), shard_count_(0), shard_bits_(0), hash_(hash)
+    {
+        if (shard_count == 0)
+            shard_count = default_shard_count();
+        while ((static_cast<size_type>(1) << shard_bits_) < shard_count)
+            ++shard_bits_;
+        shard_count = static_cast<size_type>(1) << shard_bits_;
+
+        raw_ = ::operator new(shard_count * sizeof(shard) + cache_line_size - 1);
+        const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(raw_);
+        shards_ = reinterpret_cast<shard*>((addr + cache_line_size - 1) & ~(cache_line_size - 1));
+        try
+        {
+            for (; shard_count_ < shard_count; ++shard_count_)
+                ::new (static_cast<void*>(shards_ + shard_count_))
+                    shard(bucket_count / shard_count, hash, equal, alloc);
+        }
+        catch (...)
+        {
+            destroy_shards();
+            throw;
+        }
+    }
+
+    concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+    concurrent_unordered_map& operator=(const concurrent_unordered_map&) = delete;
+
+    ~concurrent_unordered_map()
+    {
+        destroy_shards();
+    }
+
+    /**
+     * @brief 默认的分片数：硬件线程数的 4 倍向上取整为 2 的幂，至少 16
+     *
+     * 分片数远大于线程数时，两个线程同时落在同一分片上的概率很小
+     */
+    static size_type default_shard_count()
+    {
+        const size_type wanted = 4 * static_cast<size_type>(std::thread::hardware_concurrency());
+        size_type count = 16;
+        while (count < wanted)
+            count <<= 1;
+        return count;
+    }
+
+    // 容量相关
+
+    /**
+     * @brief 分片数
+     */
+    size_type shard_count() const noexcept { return shard_count_; }
+
+    /**
+     * @brief 元素个数
+     *
+     * 逐个分片加锁后累加，其他线程同时修改时只是某一时刻附近的近似值
+     */
+    size_type size() const
+    {
+        size_type n = 0;
+        for (size_type i = 0; i < shard_count_; ++i)
+        {
+            lock_type lock(shards_[i].mutex);
+            n += shards_[i].map.size();
+        }
+        return n;
+    }
+
+    /**
+     * @brief 判断容器是否为空，与 size 一样只是近似值
+     */
+    bool empty() const { return size() == 0; }
+
+    // 插入
+
+    /**
+     * @brief 插入元素，键已存在时不插入
+     *
+     * @param value 要插入的元素
+     * @return bool 是否插入成功
+     */
+    bool insert(const value_type& value)
+    {
+        const size_type code = hash_(value.first);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        return s.map.emplace_hashed(code, value.first, value).second;
+    }
+
+    bool insert(value_type&& value)
+    {
+        const size_type code = hash_(value.first);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        return s.map.emplace_hashed(code, value.first, std::move(value)).second;
+    }
+
+    /**
+     * @brief 原位构造元素后插入，键已存在时不插入
+     *
+     * 元素在加锁之前构造（需要先得到键才能确定分片），构造的开销不计入锁的持有时间
+     *
+     * @tparam Args 参数类型包
+     * @param args 元素的构造参数
+     * @return bool 是否插入成功
+     */
+    template <class... Args>
+    bool emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时才用 args 原位构造实值
+     *
+     * @tparam Args 参数类型包
+     * @param key 键
+     * @param args 实值的构造参数
+     * @return bool 是否插入成功
+     */
+    template <class... Args>
+    bool try_emplace(const key_type& key, Args&&... args)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        return try_emplace_hashed(s.map, code, key, std::forward<Args>(args)...).second;
+    }
+
+    /**
+     * @brief 键不存在时插入，存在时把 obj 赋值给已有的实值
+     *
+     * @tparam M 实值类型
+     * @param key 键
+     * @param obj 实值
+     * @return bool true 表示插入，false 表示进行了赋值
+     */
+    template <class M>
+    bool insert_or_assign(const key_type& key, M&& obj)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        // 键已存在时 try_emplace_hashed 不会移动 obj
+        auto result = try_emplace_hashed(s.map, code, key, std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result.second;
+    }
+
+    /**
+     * @brief 键不存在时用 args 构造实值插入，存在时在持有锁的情况下调用 f(已有元素)
+     *
+     * 查找、插入和修改在同一次加锁中完成，适合计数、累加这类"不存在则插入、存在则更新"的操作
+     *
+     * @tparam F 可调用对象类型，参数为 value_type&
+     * @tparam Args 参数类型包
+     * @param key 键
+     * @param f 键已存在时调用的函数
+     * @param args 实值的构造参数
+     * @return bool true 表示插入，false 表示调用了 f
+     */
+    template <class F, class... Args>
+    bool emplace_or_visit(const key_type& key, F f, Args&&... args)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        auto result = try_emplace_hashed(s.map, code, key, std::forward<Args>(args)...);
+        if (!result.second)
+            f(*result.first);
+        return result.second;
+    }
+
+    // 查找与访问
+
+    /**
+     * @brief 查找键为 key 的元素，找到时把实值拷贝到 value
+     *
+     * @param key 键
+     * @param value 接收实值，未找到时不修改
+     * @return bool 是否找到
+     */
+    bool find(const key_type& key, mapped_type& value) const
+    {
+        const size_type code = hash_(key);
+        const shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        auto it = s.map.find(key, code);
+        if (it == s.map.end())
+            return false;
+        value = it->second;
+        return true;
+    }
+
+    /**
+     * @brief 判断是否存在键为 key 的元素
+     */
+    bool contains(const key_type& key) const
+    {
+        const size_type code = hash_(key);
+        const shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        return s.map.find(key, code) != s.map.end();
+    }
+
+    /**
+     * @brief 键为 key 的元素个数（0 或 1）
+     */
+    size_type count(const key_type& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief 在持有分片锁的情况下对键为 key 的元素调用 f
+     *
+     * f 可以读取、修改元素的实值，但不能再访问本容器，否则可能死锁；
+     * f 执行期间同一分片上的其他操作都会等待，应尽量简短
+     *
+     * @tparam F 可调用对象类型，参数为 value_type&
+     * @param key 键
+     * @param f 访问元素的函数
+     * @return bool 是否找到并调用了 f
+     */
+    template <class F>
+    bool visit(const key_type& key, F f)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        auto it = s.map.find(key, code);
+        if (it == s.map.end())
+            return false;
+        f(*it);
+        return true;
+    }
+
+    /**
+     * @brief visit 的只读版本，f 的参数为 const value_type&
+     */
+    template <class F>
+    bool visit(const key_type& key, F f) const
+    {
+        const size_type code = hash_(key);
+        const shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        auto it = s.map.find(key, code);
+        if (it == s.map.end())
+            return false;
+        f(*it);
+        return true;
+    }
+
+    /**
+     * @brief 逐个分片加锁，对分片内的 unordered_map 调用 f
+     *
+     * 同一时刻只持有一个分片的锁，因此看到的不是整个容器在某一时刻的快照。
+     * f 可以遍历分片、修改实值或删除元素，但不能插入新键：新键可能属于其他分片
+     *
+     * @tparam F 可调用对象类型，参数为 shard_map&
+     * @param f 访问分片的函数
+     */
+    template <class F>
+    void for_each_shard(F f)
+    {
+        for (size_type i = 0; i < shard_count_; ++i)
+        {
+            lock_type lock(shards_[i].mutex);
+            f(shards_[i].map);
+        }
+    }
+
+    /**
+     * @brief for_each_shard 的只读版本，f 的参数为 const shard_map&
+     */
+    template <class F>
+    void for_each_shard(F f) const
+    {
+        for (size_type i = 0; i < shard_count_; ++i)
+        {
+            lock_type lock(shards_[i].mutex);
+            f(static_cast<const shard_map&>(shards_[i].map));
+        }
+    }
+
+    /**
+     * @brief 对每个元素调用 f，逐个分片加锁
+     *
+     * @tparam F 可调用对象类型，参数为 value_type&
+     * @param f 访问元素的函数
+     */
+    template <class F>
+    void for_each(F f)
+    {
+        for_each_shard([&f](shard_map& m) {
+            for (auto& value : m)
+                f(value);
+        });
+    }
+
+    template <class F>
+    void for_each(F f) const
+    {
+        for_each_shard([&f](const shard_map& m) {
+            for (const auto& value : m)
+                f(value);
+        });
+    }
+
+    // 删除
+
+    /**
+     * @brief 删除键为 key 的元素
+     *
+     * @param key 键
+     * @return size_type 删除的元素个数（0 或 1）
+     */
+    size_type erase(const key_type& key)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        return s.map.erase(key, code);
+    }
+
+    /**
+     * @brief 键为 key 的元素满足 pred 时删除它，判断和删除在同一次加锁中完成
+     *
+     * @tparam Pred 谓词类型，参数为 const value_type&
+     * @param key 键
+     * @param pred 谓词
+     * @return bool 是否删除了元素
+     */
+    template <class Pred>
+    bool erase_if(const key_type& key, Pred pred)
+    {
+        const size_type code = hash_(key);
+        shard& s = shard_for(code);
+        lock_type lock(s.mutex);
+        auto it = s.map.find(key, code);
+        if (it == s.map.end() || !pred(static_cast<const value_type&>(*it)))
+            return false;
+        // 按迭代器删除要重新计算未缓存节点的哈希值，这里复用 code
+        s.map.erase(key, code);
+        return true;
+    }
+
+    /**
+     * @brief 清空容器，逐个分片加锁清空
+     */
+    void clear()
+    {
+        for_each_shard([](shard_map& m) { m.clear(); });
+    }
+
+    // 桶与重哈希
+
+    /**
+     * @brief 为 count 个元素预留空间，平均分给各个分片
+     */
+    void reserve(size_type count)
+    {
+        const size_type per_shard = (count + shard_count_ - 1) / shard_count_;
+        for_each_shard([per_shard](shard_map& m) { m.reserve(per_shard); });
+    }
+
+    /**
+     * @brief 设置各分片的最大负载因子
+     */
+    void max_load_factor(float ml)
+    {
+        for_each_shard([ml](shard_map& m) { m.max_load_factor(ml); });
+    }
+
+    /**
+     * @brief 获取哈希函数
+     */
+    hasher hash_function() const { return hash_; }
+
+    /**
+     * @brief 交换两个容器的内容，调用时两个容器都不能被其他线程访问
+     */
+    void swap(concurrent_unordered_map& rhs) noexcept
+    {
+        std::swap(raw_, rhs.raw_);
+        std::swap(shards_, rhs.shards_);
+        std::swap(shard_count_, rhs.shard_count_);
+        std::swap(shard_bits_, rhs.shard_bits_);
+        std::swap(hash_, rhs.hash_);
+    }
+
+private:
+    /**
+     * @brief 析构已构造的分片并释放分片数组
+     */
+    void destroy_shards() noexcept
+    {
+        while (shard_count_ > 0)
+            shards_[--shard_count_].~shard();
+        ::operator delete(raw_);
+        raw_ = nullptr;
+        shards_ = nullptr;
+    }
+
+    /**
+     * @brief 根据键的哈希值选择分片
+     *
+     * 分片内的 hashtable 用哈希值对桶数取模选桶，这里用乘法散列后的高位选分片，
+     * 两者使用哈希值的不同部分，同一分片内的键在桶之间仍然分布均匀。
+     * std::hash<int> 这类恒等哈希的低位规律很强，乘法散列也能把它们均匀分到各个分片。
+     * 哈希值随后传给分片的 find / erase / emplace_hashed，每个操作只计算一次哈希值
+     */
+    size_type shard_index(size_type code) const
+    {
+        if (shard_bits_ == 0)
+            return 0;
+        const uint64_t h = static_cast<uint64_t>(code) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(h >> (64 - shard_bits_));
+    }
+
+    shard& shard_for(size_type code)
+    {
+        return shards_[shard_index(code)];
+    }
+
+    const shard& shard_for(size_type code) const
+    {
+        return shards_[shard_index(code)];
+    }
+
+    /**
+     * @brief 使用已经算好的哈希值在分片中执行 try_emplace
+     */
+    template <class... Args>
+    static std::pair<typename shard_map::iterator, bool>
+    try_emplace_hashed(shard_map& map, size_type code, const key_type& key, Args&&... args)
+    {
+        return map.emplace_hashed(code, key, std::piecewise_construct,
+                                  std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+};
+
+/**
+ * @brief 交换两个 concurrent_unordered_map
+ */
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(concurrent_unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          concurrent_unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif // MY_CONCURRENT_UNORDERED_MAP_H
@@ -0,0 +1,329 @@
+// test_concurrent_unordered_map.cpp
+// 测试分片加锁的 concurrent_unordered_map：单线程语义与 unordered_map 一致，多线程同时读写结果正确
+
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <set>
+
+#include "my_concurrent_unordered_map.h"
+
+/**
+ * @brief 单线程下的基本操作
+ */
+void test_basic_operations() {
+    std::cout << "===== 测试基本操作 =====" << std::endl;
+
+    mystl::concurrent_unordered_map<int, std::string> m(5);
+    assert(m.shard_count() == 8);   // 向上取整为 2 的幂
+    assert(m.empty() && m.size() == 0);
+
+    assert(m.insert(std::make_pair(1, std::string("one"))));
+    assert(!m.insert(std::make_pair(1, std::string("uno"))));
+    assert(m.emplace(2, "two"));
+    assert(m.try_emplace(3, 5, 'x'));
+    assert(!m.try_emplace(3, "ignored"));
+    assert(m.size() == 3 && m.count(3) == 1 && m.count(4) == 0);
+
+    std::string value;
+    assert(m.find(1, value) && value == "one");
+    assert(m.find(3, value) && value == "xxxxx");
+    value = "unchanged";
+    assert(!m.find(4, value) && value == "unchanged");
+
+    assert(!m.insert_or_assign(1, "ONE"));
+    assert(m.insert_or_assign(4, "four"));
+    assert(m.find(1, value) && value == "ONE");
+
+    // visit 原地修改
+    assert(m.visit(2, [](std::pair<const int, std::string>& v) { v.second += "!"; }));
+    assert(!m.visit(9, [](std::pair<const int, std::string>&) { assert(false); }));
+    const auto& cm = m;
+    assert(cm.visit(2, [](const std::pair<const int, std::string>& v) { assert(v.second == "two!"); }));
+
+    // 存在时调用 f，不存在时插入
+    assert(!m.emplace_or_visit(2, [](std::pair<const int, std::string>& v) { v.second = "TWO"; }, "unused"));
+    assert(m.emplace_or_visit(5, [](std::pair<const int, std::string>&) { assert(false); }, "five"));
+    assert(m.find(2, value) && value == "TWO");
+    assert(m.find(5, value) && value == "five");
+
+    assert(m.erase(4) == 1 && m.erase(4) == 0);
+    assert(!m.erase_if(5, [](const std::pair<const int, std::string>& v) { return v.second == "six"; }));
+    assert(m.erase_if(5, [](const std::pair<const int, std::string>& v) { return v.second == "five"; }));
+    assert(m.size() == 3 && !m.contains(5));
+
+    m.clear();
+    assert(m.empty());
+
+    std::cout << "基本操作测试通过!" << std::endl;
+}
+
+/**
+ * @brief 统计调用次数的哈希函数
+ */
+struct counting_hash {
+    static int calls;
+    size_t operator()(int key) const {
+        ++calls;
+        return std::hash<int>()(key);
+    }
+};
+int counting_hash::calls = 0;
+
+/**
+ * @brief 选择分片用的哈希值直接交给分片，每个操作只计算一次哈希值
+ */
+void test_hash_once() {
+    std::cout << "===== 测试每个操作只计算一次哈希值 =====" << std::endl;
+
+    // 桶数足够，不会重哈希
+    mystl::concurrent_unordered_map<int, int, counting_hash> m(4, 1024);
+    int value = 0;
+    counting_hash::calls = 0;
+    assert(m.insert(std::make_pair(1, 1)) && counting_hash::calls == 1);
+    assert(!m.insert(std::make_pair(1, 2)) && counting_hash::calls == 2);
+    assert(m.emplace(2, 2) && counting_hash::calls == 3);
+    assert(m.try_emplace(3, 3) && counting_hash::calls == 4);
+    assert(!m.insert_or_assign(3, 30) && counting_hash::calls == 5);
+    assert(m.emplace_or_visit(4, [](std::pair<const int, int>&) {}, 4) && counting_hash::calls == 6);
+    assert(m.find(3, value) && value == 30 && counting_hash::calls == 7);
+    assert(m.contains(4) && counting_hash::calls == 8);
+    assert(m.visit(1, [](std::pair<const int, int>& v) { v.second = 10; }) && counting_hash::calls == 9);
+    assert(m.erase_if(1, [](const std::pair<const int, int>& v) { return v.second == 10; })
+           && counting_hash::calls == 10);
+    assert(m.erase(2) == 1 && counting_hash::calls == 11);
+    assert(m.size() == 2);
+
+    std::cout << "哈希值计算次数测试通过!" << std::endl;
+}
+
+/**
+ * @brief 遍历与分片：每个元素恰好出现在一个分片中，各分片独立重哈希
+ */
+void test_shards_and_iteration() {
+    std::cout << "===== 测试分片与遍历 =====" << std::endl;
+
+    typedef mystl::concurrent_unordered_map<int, int> map_type;
+    map_type m(16);
+    const int n = 10000;
+    m.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        m.emplace(i, i * 2);
+    }
+    assert(m.size() == static_cast<size_t>(n));
+
+    // 恒等哈希的连续整数也均匀分到各个分片
+    size_t total = 0, smallest = n, largest = 0;
+    m.for_each_shard([&](const map_type::shard_map& shard) {
+        total += shard.size();
+        smallest = std::min(smallest, shard.size());
+        largest = std::max(largest, shard.size());
+        assert(shard.load_factor() <= shard.max_load_factor());
+    });
+    assert(total == static_cast<size_t>(n));
+    assert(smallest > n / 16 / 2 && largest < n / 16 * 2);
+
+    long long sum = 0;
+    m.for_each([&](const std::pair<const int, int>& v) {
+        assert(v.second == v.first * 2);
+        sum += v.first;
+    });
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+
+    // for_each 可以修改实值，for_each_shard 可以删除元素
+    m.for_each([](std::pair<const int, int>& v) { v.second = -v.second; });
+    m.for_each_shard([](map_type::shard_map& shard) {
+        for (auto it = shard.begin(); it != shard.end();) {
+            if (it->first % 2 == 0) shard.erase(it++);
+            else ++it;
+        }
+    });
+    assert(m.size() == static_cast<size_t>(n / 2));
+    int value = 0;
+    assert(m.find(7, value) && value == -14);
+    assert(!m.contains(8));
+
+    // 默认分片数至少 16，只有一个分片时退化为一把锁保护的 unordered_map
+    assert(map_type().shard_count() >= 16);
+    map_type single(1);
+    assert(single.shard_count() == 1);
+    single.emplace(42, 1);
+    assert(single.contains(42) && single.size() == 1);
+
+    map_type other(4);
+    other.emplace(1, 1);
+    swap(single, other);
+    assert(single.shard_count() == 4 && single.contains(1) && !single.contains(42));
+    assert(other.shard_count() == 1 && other.contains(42));
+
+    std::cout << "分片与遍历测试通过!" << std::endl;
+}
+
+/**
+ * @brief 多个线程同时插入、查找、更新和删除
+ */
+void test_concurrent_access() {
+    std::cout << "===== 测试多线程并发访问 =====" << std::endl;
+
+    const int thread_count = 8;
+    const int per_thread = 20000;
+
+    // 各线程插入互不相交的键，同时查找其他线程的键
+    mystl::concurrent_unordered_map<int, int> m(8);
+    std::atomic<int> hits(0);
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&m, &hits, t]() {
+                for (int i = 0; i < per_thread; ++i) {
+                    const int key = i * thread_count + t;
+                    assert(m.emplace(key, key + 1));
+                    int value = 0;
+                    const int other = i * thread_count + (t + 1) % thread_count;
+                    if (m.find(other, value)) {
+                        assert(value == other + 1);
+                        hits.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    assert(m.size() == static_cast<size_t>(thread_count * per_thread));
+    for (int key = 0; key < thread_count * per_thread; ++key) {
+        int value = 0;
+        assert(m.find(key, value) && value == key + 1);
+    }
+
+    // 所有线程对同一组键计数：emplace_or_visit 的查找、插入、累加在一次加锁中完成，不会丢失更新
+    const int key_count = 100;
+    mystl::concurrent_unordered_map<int, long> counters;
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&counters]() {
+                for (int i = 0; i < per_thread; ++i) {
+                    counters.emplace_or_visit(i % key_count,
+                                              [](std::pair<const int, long>& v) { ++v.second; }, 1L);
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    assert(counters.size() == static_cast<size_t>(key_count));
+    long total = 0;
+    counters.for_each([&total](const std::pair<const int, long>& v) {
+        assert(v.second == static_cast<long>(thread_count) * per_thread / key_count);
+        total += v.second;
+    });
+    assert(total == static_cast<long>(thread_count) * per_thread);
+
+    // 线程 t 处理模 thread_count 余 t 的键：偶数号线程删除偶数键，奇数号线程同时 visit 奇数键
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&m, t]() {
+                for (int key = t; key < thread_count * per_thread; key += thread_count) {
+                    if (key % 2 == 0) {
+                        assert(m.erase(key) == 1);
+                    } else {
+                        assert(m.visit(key, [](std::pair<const int, int>& v) { v.second = 0; }));
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+    }
+    assert(m.size() == static_cast<size_t>(thread_count * per_thread / 2));
+    m.for_each([](const std::pair<const int, int>& v) { assert(v.first % 2 == 1 && v.second == 0); });
+
+    std::cout << "多线程并发访问测试通过! (" << hits.load() << " 次查找命中其他线程刚插入的键)" << std::endl;
+}
+
+/**
+ * @brief 多个线程同时向使用有状态分配器的容器插入、删除
+ *
+ * pool_allocator 的内存池不是线程安全的，每个分片各用一个内存池，由分片的锁保护；
+ * polymorphic_allocator 的各分片共享同一个线程安全的 synchronized_pool_resource
+ */
+template <class Map>
+void run_concurrent_inserts(Map& m) {
+    const int thread_count = 8;
+    const int per_thread = 20000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&m, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                const int key = i * thread_count + t;
+                assert(m.emplace(key, key + 1));
+                if (i % 4 == 0) {
+                    assert(m.erase(key) == 1);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    assert(m.size() == static_cast<size_t>(thread_count * per_thread / 4 * 3));
+    m.for_each([](const std::pair<const int, int>& v) {
+        assert(v.second == v.first + 1 && (v.first / thread_count) % 4 != 0);
+    });
+}
+
+void test_concurrent_stateful_allocator() {
+    std::cout << "===== 测试多线程下的有状态分配器 =====" << std::endl;
+
+    {
+        typedef mystl::pool_allocator<std::pair<const int, int>> alloc_type;
+        alloc_type alloc;
+        mystl::concurrent_unordered_map<int, int, std::hash<int>, std::equal_to<int>, alloc_type>
+            m(8, 0, std::hash<int>(), std::equal_to<int>(), alloc);
+
+        // 每个分片拥有自己的内存池，与传入的分配器也不共享
+        std::set<mystl::node_pool_resource*> pools;
+        m.for_each_shard([&pools](decltype(m)::shard_map& s) {
+            pools.insert(s.get_allocator().resource());
+        });
+        assert(pools.size() == m.shard_count());
+        assert(pools.count(alloc.resource()) == 0);
+
+        run_concurrent_inserts(m);
+    }
+
+    {
+        mystl::pmr::synchronized_pool_resource pool;
+        typedef mystl::pmr::polymorphic_allocator<std::pair<const int, int>> alloc_type;
+        mystl::concurrent_unordered_map<int, int, std::hash<int>, std::equal_to<int>, alloc_type>
+            m(8, 0, std::hash<int>(), std::equal_to<int>(), alloc_type(&pool));
+        m.for_each_shard([&pool](decltype(m)::shard_map& s) {
+            assert(s.get_allocator().resource() == &pool);
+        });
+
+        run_concurrent_inserts(m);
+    }
+
+    std::cout << "有状态分配器测试通过!" << std::endl;
+}
+
+int main() {
+    test_basic_operations();
+    test_hash_once();
+    test_shards_and_iteration();
+    test_concurrent_access();
+    test_concurrent_stateful_allocator();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
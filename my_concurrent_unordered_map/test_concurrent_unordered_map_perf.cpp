@@ -0,0 +1,146 @@
+// test_concurrent_unordered_map_perf.cpp
+// 1 ~ 64 个线程同时读写时的吞吐量：一把全局锁保护的 unordered_map 与分片加锁的 concurrent_unordered_map
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#include "my_concurrent_unordered_map.h"
+
+// 键空间大小，预先插入其中一半
+static const int kKeySpace = 1 << 20;
+
+/**
+ * @brief 第 i 个键：把连续的序号打散到整个 int 范围
+ *
+ * std::hash<int> 是恒等函数，连续的小整数在单个大表中恰好每桶一个，分片后反而会有冲突，
+ * 打散后两者的冲突情况相同，更接近实际的键
+ */
+inline int key_at(int i) {
+    return static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+}
+
+/**
+ * @brief 一把互斥锁保护的 unordered_map，即原来的用法
+ */
+class locked_unordered_map {
+public:
+    bool find(int key, int& value) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    bool insert(int key, int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.emplace(key, value).second;
+    }
+
+    size_t erase(int key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.erase(key);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    mystl::unordered_map<int, int> map_;
+};
+
+/**
+ * @brief 统一 concurrent_unordered_map 的接口
+ */
+class sharded_unordered_map {
+public:
+    bool find(int key, int& value) const { return map_.find(key, value); }
+    bool insert(int key, int value) { return map_.emplace(key, value); }
+    size_t erase(int key) { return map_.erase(key); }
+
+private:
+    mystl::concurrent_unordered_map<int, int> map_;
+};
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+/**
+ * @brief 用 threads 个线程共执行 total_ops 次操作，返回每秒百万次操作数
+ *
+ * 每次操作随机选一个键：read_percent% 的概率查找，其余插入、删除各占一半
+ */
+template <class Map>
+double run(Map& m, int threads, int total_ops, int read_percent) {
+    const int per_thread = total_ops / threads;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&m, per_thread, read_percent, t]() {
+            uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            long long found = 0;
+            for (int i = 0; i < per_thread; ++i) {
+                // xorshift 伪随机数，避免线程间共享随机数生成器
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                const int key = key_at(static_cast<int>(state % kKeySpace));
+                const int op = static_cast<int>((state >> 32) % 100);
+                int value = 0;
+                if (op < read_percent) {
+                    found += m.find(key, value);
+                } else if ((op - read_percent) % 2 == 0) {
+                    found += m.insert(key, key);
+                } else {
+                    found += static_cast<long long>(m.erase(key));
+                }
+            }
+            g_sink += found;
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return per_thread * static_cast<double>(threads) / seconds / 1e6;
+}
+
+template <class Map>
+void prefill(Map& m) {
+    for (int i = 0; i < kKeySpace; i += 2) {
+        m.insert(key_at(i), i);
+    }
+}
+
+void run_workload(const char* name, int read_percent, int total_ops, int max_threads) {
+    std::cout << "\n" << name << "（查找 " << read_percent << "%，插入、删除各 "
+              << (100 - read_percent) / 2 << "%），单位: 百万次操作/秒" << std::endl;
+    std::cout << "  线程数      全局锁      分片锁" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        locked_unordered_map locked;
+        sharded_unordered_map sharded;
+        prefill(locked);
+        prefill(sharded);
+        const double a = run(locked, threads, total_ops, read_percent);
+        const double b = run(sharded, threads, total_ops, read_percent);
+        std::cout << "  " << std::setw(6) << threads << std::setw(12) << a << std::setw(12) << b << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+    const int total_ops = 4000000;
+
+    std::cout << "===== concurrent_unordered_map 吞吐量 =====" << std::endl;
+    std::cout << "硬件线程数: " << std::thread::hardware_concurrency()
+              << "，分片数: " << mystl::concurrent_unordered_map<int, int>::default_shard_count() << std::endl;
+    run_workload("读多写少", 90, total_ops, max_threads);
+    run_workload("读写各半", 50, total_ops, max_threads);
+    return 0;
+}
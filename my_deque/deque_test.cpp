@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
+#include <cassert>
+#include <type_traits>
 #include "my_deque.h"
+#include "../my_test_support/tagged_allocator.h"
 
 /**
  * @brief 一个简单的测试函数，测试deque容器的基本功能
@@ -90,9 +93,61 @@ void test_deque() {
     std::cout << std::endl;
 }
 
+/**
+ * @brief 测试有状态分配器在拷贝、移动和交换时的传播
+ */
+void test_allocator_propagation() {
+    std::cout << "\n===== 测试有状态分配器的传播 =====" << std::endl;
+    {
+        typedef tagged_allocator<int, false> alloc;  // 不传播
+        typedef mystl::deque<int, alloc> container;
+        container a(alloc(1));
+        for (int i = 0; i < 100; ++i) a.push_back(i);
+        container b(alloc(2));
+        b.push_back(-1);
+
+        container c(a);  // 拷贝构造沿用 select_on_container_copy_construction 的结果
+        assert(c.get_allocator().id == 1 && c.size() == 100);
+        container d(a, alloc(3));
+        assert(d.get_allocator().id == 3 && d == a);
+
+        b = a;  // 不传播：保留自己的分配器
+        assert(b.get_allocator().id == 2 && b.size() == 100 && b.back() == 99);
+        b = std::move(c);  // 分配器不相等：逐个移动元素
+        assert(b.get_allocator().id == 2 && b.size() == 100);
+        container e(std::move(d), alloc(4));  // 分配器不相等：逐个移动元素
+        assert(e.get_allocator().id == 4 && e.size() == 100 && e.front() == 0);
+        container f(std::move(a), alloc(1));  // 分配器相等：直接接管
+        assert(f.get_allocator().id == 1 && f.size() == 100);
+    }
+    assert(all_released<false>());
+    {
+        typedef tagged_allocator<int, true> alloc;  // 传播
+        typedef mystl::deque<int, alloc> container;
+        container a(alloc(1));
+        a.push_back(1);
+        container b(alloc(2));
+        b.push_back(2);
+        b.push_back(3);
+        b = a;
+        assert(b.get_allocator().id == 1 && b.size() == 1 && b.front() == 1);
+        container c(alloc(3));
+        c.push_back(4);
+        c = std::move(b);
+        assert(c.get_allocator().id == 1 && c.size() == 1);
+        container d(alloc(4));
+        d.push_back(5);
+        d.swap(a);
+        assert(d.get_allocator().id == 1 && a.get_allocator().id == 4 && a.front() == 5);
+    }
+    assert(all_released<true>());
+    std::cout << "有状态分配器测试通过" << std::endl;
+}
+
 int main() {
     std::cout << "Testing my_deque implementation..." << std::endl;
     test_deque();
+    test_allocator_propagation();
     std::cout << "All tests completed." << std::endl;
     return 0;
 } 
\ No newline at end of file
@@ -24,6 +24,7 @@
 #include <type_traits>
 #include <memory>
 #include <iterator>
+#include "../my_memory_resource/my_memory_resource.h"
 
 // 预定义deque的map初始大小
 #ifndef DEQUE_MAP_INIT_SIZE
@@ -34,29 +35,29 @@ namespace mystl {
 
 // 前置声明
 template <class T, class Ref, class Ptr> class deque_iterator;
-template <class T> class deque;
+template <class T, class Alloc = std::allocator<T>> class deque;
 
 // 声明外部运算符函数
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs);
+template <class T, class Alloc>
+bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs);
 
-template <class T>
-void swap(deque<T>& lhs, deque<T>& rhs) noexcept;
+template <class T, class Alloc>
+void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) noexcept;
 
 /**
  * @brief 计算deque缓冲区大小的结构体
@@ -254,8 +255,9 @@ public:
  * @brief deque 容器类模板
  * 
  * @tparam T 元素类型
+ * @tparam Alloc 分配器类型，缓冲区和 map 都由它 rebind 得到的分配器分配
  */
-template <class T>
+template <class T, class Alloc>
 class deque {
 public:
     // deque的型别定义
@@ -266,7 +268,7 @@ public:
     using const_reference = const T&;
     using size_type = size_t;
     using difference_type = ptrdiff_t;
-    using allocator_type = std::allocator<T>;
+    using allocator_type = Alloc;
     
     using iterator = deque_iterator<T, T&, T*>;
     using const_iterator = deque_iterator<T, const T&, const T*>;
@@ -280,8 +282,10 @@ public:
     static constexpr size_type buffer_size = deque_buf_size<T>::value;
     
     // 内存分配器
-    using data_allocator_type = std::allocator<T>;
-    using map_allocator_type = std::allocator<T*>;
+    using data_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using map_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<T*>;
+    using data_alloc_traits = std::allocator_traits<data_allocator_type>;
+    using map_alloc_traits = std::allocator_traits<map_allocator_type>;
 
 private:
     // deque的内部数据成员
@@ -383,6 +387,32 @@ private:
      */
     void fill_insert(iterator pos, size_type n, const value_type& value);
 
+    /**
+     * @brief 析构所有元素并释放全部缓冲区和map
+     */
+    void release_storage() noexcept;
+
+    // 通过分配器构造元素的辅助函数，构造过程中抛出异常时已构造的元素会被析构
+    /**
+     * @brief 把 [first, last) 复制构造到 result 开始的未初始化空间
+     * @return 最后一个构造的元素之后的位置
+     */
+    template <class InputIter, class ForwardIter>
+    ForwardIter uninitialized_copy_a(InputIter first, InputIter last, ForwardIter result);
+
+    /**
+     * @brief 在 [first, last) 的未初始化空间中构造 value 的副本
+     */
+    template <class ForwardIter>
+    void uninitialized_fill_a(ForwardIter first, ForwardIter last, const value_type& value);
+
+    /**
+     * @brief 在 first 开始的未初始化空间中构造 n 个 value 的副本
+     * @return 最后一个构造的元素之后的位置
+     */
+    template <class ForwardIter>
+    ForwardIter uninitialized_fill_n_a(ForwardIter first, size_type n, const value_type& value);
+
 public:
     // 构造、析构函数
     
@@ -393,11 +423,22 @@ public:
         fill_init(0, value_type()); 
     }
     
+    /**
+     * @brief 使用指定分配器构造空的deque
+     * @param alloc 分配器
+     */
+    explicit deque(const allocator_type& alloc)
+        : data_allocator(alloc), map_allocator(alloc) {
+        fill_init(0, value_type());
+    }
+    
     /**
      * @brief 构造指定大小的deque
      * @param n 元素数量
+     * @param alloc 分配器
      */
-    explicit deque(size_type n) { 
+    explicit deque(size_type n, const allocator_type& alloc = allocator_type())
+        : data_allocator(alloc), map_allocator(alloc) { 
         fill_init(n, value_type()); 
     }
     
@@ -405,8 +446,10 @@ public:
      * @brief 构造指定大小并填充相同值的deque
      * @param n 元素数量
      * @param value 填充值
+     * @param alloc 分配器
      */
-    deque(size_type n, const value_type& value) { 
+    deque(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : data_allocator(alloc), map_allocator(alloc) { 
         fill_init(n, value); 
     }
     
@@ -414,28 +457,44 @@ public:
      * @brief 从输入迭代器构造deque
      * @param first 范围起始迭代器
      * @param last 范围结束迭代器
+     * @param alloc 分配器
      */
     template <class InputIter, typename = typename 
         std::enable_if<std::is_convertible<
             typename std::iterator_traits<InputIter>::iterator_category, 
             std::input_iterator_tag>::value>::type>
-    deque(InputIter first, InputIter last) {
+    deque(InputIter first, InputIter last, const allocator_type& alloc = allocator_type())
+        : data_allocator(alloc), map_allocator(alloc) {
         copy_init(first, last, typename std::iterator_traits<InputIter>::iterator_category());
     }
     
     /**
      * @brief 从初始化列表构造deque
      * @param ilist 初始化列表
+     * @param alloc 分配器
      */
-    deque(std::initializer_list<value_type> ilist) {
+    deque(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : data_allocator(alloc), map_allocator(alloc) {
         copy_init(ilist.begin(), ilist.end(), std::forward_iterator_tag());
     }
     
     /**
-     * @brief 拷贝构造函数
+     * @brief 拷贝构造函数，分配器由 select_on_container_copy_construction 决定
      * @param rhs 拷贝源
      */
-    deque(const deque& rhs) {
+    deque(const deque& rhs)
+        : data_allocator(data_alloc_traits::select_on_container_copy_construction(rhs.data_allocator)),
+          map_allocator(data_allocator) {
+        copy_init(rhs.begin(), rhs.end(), std::forward_iterator_tag());
+    }
+    
+    /**
+     * @brief 带分配器的拷贝构造函数
+     * @param rhs 拷贝源
+     * @param alloc 分配器
+     */
+    deque(const deque& rhs, const allocator_type& alloc)
+        : data_allocator(alloc), map_allocator(alloc) {
         copy_init(rhs.begin(), rhs.end(), std::forward_iterator_tag());
     }
     
@@ -447,23 +506,47 @@ public:
         : begin_(std::move(rhs.begin_)),
           end_(std::move(rhs.end_)),
           map_(rhs.map_),
-          map_size_(rhs.map_size_) {
+          map_size_(rhs.map_size_),
+          data_allocator(std::move(rhs.data_allocator)),
+          map_allocator(std::move(rhs.map_allocator)) {
         rhs.map_ = nullptr;
         rhs.map_size_ = 0;
     }
     
+    /**
+     * @brief 带分配器的移动构造函数
+     * 
+     * 分配器与 rhs 相等时直接接管 rhs 的缓冲区，否则逐个移动元素
+     * @param rhs 移动源
+     * @param alloc 分配器
+     */
+    deque(deque&& rhs, const allocator_type& alloc)
+        : data_allocator(alloc), map_allocator(alloc) {
+        if (data_allocator == rhs.data_allocator) {
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            map_ = rhs.map_;
+            map_size_ = rhs.map_size_;
+            rhs.map_ = nullptr;
+            rhs.map_size_ = 0;
+        } else {
+            copy_init(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()),
+                      std::forward_iterator_tag());
+        }
+    }
+    
     /**
      * @brief 析构函数
      */
     ~deque() {
-        if (map_ != nullptr) {
-            clear();
-            data_allocator.deallocate(*begin_.node, buffer_size);
-            *begin_.node = nullptr;
-            map_allocator.deallocate(map_, map_size_);
-            map_ = nullptr;
-        }
+        release_storage();
     }
+    
+    /**
+     * @brief 获取分配器
+     * @return 分配器对象
+     */
+    allocator_type get_allocator() const { return allocator_type(data_allocator); }
 
     // 赋值操作
     
@@ -474,6 +557,19 @@ public:
      */
     deque& operator=(const deque& rhs) {
         if (this != &rhs) {
+            if (data_alloc_traits::propagate_on_container_copy_assignment::value &&
+                data_allocator != rhs.data_allocator) {
+                // 旧缓冲区必须由旧分配器释放，换成 rhs 的分配器后重新构造
+                release_storage();
+                data_allocator = rhs.data_allocator;
+                map_allocator = rhs.map_allocator;
+                copy_init(rhs.begin(), rhs.end(), std::forward_iterator_tag());
+                return *this;
+            }
+            if (data_alloc_traits::propagate_on_container_copy_assignment::value) {
+                data_allocator = rhs.data_allocator;
+                map_allocator = rhs.map_allocator;
+            }
             const auto len = size();
             if (len >= rhs.size()) {
                 // 如果当前容器大小大于等于rhs，只需要复制rhs的内容，并删除多余元素
@@ -498,8 +594,26 @@ public:
      * @param rhs 移动源
      * @return 返回自身引用
      */
-    deque& operator=(deque&& rhs) noexcept {
-        clear();
+    deque& operator=(deque&& rhs)
+        noexcept(data_alloc_traits::propagate_on_container_move_assignment::value) {
+        if (this == &rhs) {
+            return *this;
+        }
+        if (!data_alloc_traits::propagate_on_container_move_assignment::value &&
+            data_allocator != rhs.data_allocator) {
+            // 分配器不传播且不相等，不能接管rhs的缓冲区，只能逐个移动元素
+            clear();
+            for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+                emplace_back(std::move(*it));
+            }
+            rhs.clear();
+            return *this;
+        }
+        release_storage();
+        if (data_alloc_traits::propagate_on_container_move_assignment::value) {
+            data_allocator = std::move(rhs.data_allocator);
+            map_allocator = std::move(rhs.map_allocator);
+        }
         begin_ = std::move(rhs.begin_);
         end_ = std::move(rhs.end_);
         map_ = rhs.map_;
@@ -515,7 +629,7 @@ public:
      * @return 返回自身引用
      */
     deque& operator=(std::initializer_list<value_type> ilist) {
-        deque tmp(ilist);
+        deque tmp(ilist, get_allocator());
         swap(tmp);
         return *this;
     }
@@ -841,7 +955,7 @@ public:
                 // 复制元素到前面的缓冲区
                 iterator cur = begin_;
                 for (; first != last; ++first, ++cur) {
-                    data_allocator.construct(cur.cur, *first);
+                    data_alloc_traits::construct(data_allocator, cur.cur, *first);
                 }
             }
             catch (...) {
@@ -870,8 +984,8 @@ public:
 /**
  * @brief 调整容器大小，并用指定值填充新增元素
  */
-template <class T>
-void deque<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::resize(size_type new_size, const value_type& value) {
     const auto len = size();
     if (new_size < len) {
         // 缩小容器，删除多余元素
@@ -885,31 +999,35 @@ void deque<T>::resize(size_type new_size, const value_type& value) {
 /**
  * @brief 减少容器占用的内存，不改变元素个数
  */
-template <class T>
-void deque<T>::shrink_to_fit() noexcept {
-    // 至少会留下头部缓冲区
+template <class T, class Alloc>
+void deque<T, Alloc>::shrink_to_fit() noexcept {
+    // 至少会留下头部缓冲区，map 中未分配缓冲区的位置为空指针，不能交给分配器
     // 释放前面未使用的缓冲区
     for (auto cur = map_; cur < begin_.node; ++cur) {
-        data_allocator.deallocate(*cur, buffer_size);
-        *cur = nullptr;
+        if (*cur != nullptr) {
+            data_alloc_traits::deallocate(data_allocator, *cur, buffer_size);
+            *cur = nullptr;
+        }
     }
     
     // 释放后面未使用的缓冲区
     for (auto cur = end_.node + 1; cur < map_ + map_size_; ++cur) {
-        data_allocator.deallocate(*cur, buffer_size);
-        *cur = nullptr;
+        if (*cur != nullptr) {
+            data_alloc_traits::deallocate(data_allocator, *cur, buffer_size);
+            *cur = nullptr;
+        }
     }
 }
 
 /**
  * @brief 创建map数组
  */
-template <class T>
-typename deque<T>::map_pointer
-deque<T>::create_map(size_type size) {
+template <class T, class Alloc>
+typename deque<T, Alloc>::map_pointer
+deque<T, Alloc>::create_map(size_type size) {
     map_pointer mp = nullptr;
     // 分配足够大小的内存
-    mp = map_allocator.allocate(size);
+    mp = map_alloc_traits::allocate(map_allocator, size);
     // 初始化所有指针为nullptr
     for (size_type i = 0; i < size; ++i) {
         *(mp + i) = nullptr;
@@ -920,20 +1038,20 @@ deque<T>::create_map(size_type size) {
 /**
  * @brief 创建缓冲区
  */
-template <class T>
-void deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc>
+void deque<T, Alloc>::create_buffer(map_pointer nstart, map_pointer nfinish) {
     map_pointer cur;
     try {
         // 为每个map节点分配一个缓冲区
         for (cur = nstart; cur <= nfinish; ++cur) {
-            *cur = data_allocator.allocate(buffer_size);
+            *cur = data_alloc_traits::allocate(data_allocator, buffer_size);
         }
     }
     catch (...) {
         // 异常处理，释放已分配的缓冲区
         while (cur != nstart) {
             --cur;
-            data_allocator.deallocate(*cur, buffer_size);
+            data_alloc_traits::deallocate(data_allocator, *cur, buffer_size);
             *cur = nullptr;
         }
         throw; // 重新抛出异常
@@ -943,11 +1061,11 @@ void deque<T>::create_buffer(map_pointer nstart, map_pointer nfinish) {
 /**
  * @brief 销毁缓冲区
  */
-template <class T>
-void deque<T>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
+template <class T, class Alloc>
+void deque<T, Alloc>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
     // 释放所有缓冲区
     for (map_pointer n = nstart; n <= nfinish; ++n) {
-        data_allocator.deallocate(*n, buffer_size);
+        data_alloc_traits::deallocate(data_allocator, *n, buffer_size);
         *n = nullptr;
     }
 }
@@ -955,8 +1073,8 @@ void deque<T>::destroy_buffer(map_pointer nstart, map_pointer nfinish) {
 /**
  * @brief 初始化map
  */
-template <class T>
-void deque<T>::map_init(size_type nElem) {
+template <class T, class Alloc>
+void deque<T, Alloc>::map_init(size_type nElem) {
     // 计算需要的缓冲区数量
     // 至少需要一个缓冲区(nElem / buffer_size + 1)
     const size_type nNode = nElem / buffer_size + 1;
@@ -986,7 +1104,7 @@ void deque<T>::map_init(size_type nElem) {
     }
     catch (...) {
         // 异常处理，清理已分配的资源
-        map_allocator.deallocate(map_, map_size_);
+        map_alloc_traits::deallocate(map_allocator, map_, map_size_);
         map_ = nullptr;
         map_size_ = 0;
         throw;
@@ -1003,27 +1121,27 @@ void deque<T>::map_init(size_type nElem) {
 /**
  * @brief 以指定值填充初始化
  */
-template <class T>
-void deque<T>::fill_init(size_type n, const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::fill_init(size_type n, const value_type& value) {
     // 初始化map
     map_init(n);
     
     if (n != 0) {
         // 填充缓冲区
         for (auto cur = begin_.node; cur < end_.node; ++cur) {
-            std::uninitialized_fill(*cur, *cur + buffer_size, value);
+            uninitialized_fill_a(*cur, *cur + buffer_size, value);
         }
         // 对最后一个缓冲区单独处理
-        std::uninitialized_fill(end_.first, end_.cur, value);
+        uninitialized_fill_a(end_.first, end_.cur, value);
     }
 }
 
 /**
  * @brief 从输入迭代器复制初始化(输入迭代器版本)
  */
-template <class T>
+template <class T, class Alloc>
 template <class InputIter>
-void deque<T>::copy_init(InputIter first, InputIter last, std::input_iterator_tag) {
+void deque<T, Alloc>::copy_init(InputIter first, InputIter last, std::input_iterator_tag) {
     // 计算元素个数
     const size_type n = std::distance(first, last);
     // 初始化map
@@ -1038,9 +1156,9 @@ void deque<T>::copy_init(InputIter first, InputIter last, std::input_iterator_ta
 /**
  * @brief 从前向迭代器复制初始化(前向迭代器版本)
  */
-template <class T>
+template <class T, class Alloc>
 template <class ForwardIter>
-void deque<T>::copy_init(ForwardIter first, ForwardIter last, std::forward_iterator_tag) {
+void deque<T, Alloc>::copy_init(ForwardIter first, ForwardIter last, std::forward_iterator_tag) {
     // 计算元素个数
     const size_type n = std::distance(first, last);
     // 初始化map
@@ -1050,30 +1168,30 @@ void deque<T>::copy_init(ForwardIter first, ForwardIter last, std::forward_itera
     for (auto cur = begin_.node; cur < end_.node; ++cur) {
         auto next = first;
         std::advance(next, buffer_size);
-        std::uninitialized_copy(first, next, *cur);
+        uninitialized_copy_a(first, next, *cur);
         first = next;
     }
     
     // 对最后一个缓冲区单独处理
-    std::uninitialized_copy(first, last, end_.first);
+    uninitialized_copy_a(first, last, end_.first);
 }
 
 /**
  * @brief 在容器头部添加元素
  */
-template <class T>
-void deque<T>::push_front(const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::push_front(const value_type& value) {
     if (begin_.cur != begin_.first) {
         // 缓冲区前部有剩余空间
         // 在当前位置之前构造元素
-        data_allocator.construct(begin_.cur - 1, value);
+        data_alloc_traits::construct(data_allocator, begin_.cur - 1, value);
         --begin_.cur;
     } else {
         // 需要在前面分配新的缓冲区
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator.construct(begin_.cur, value);
+            data_alloc_traits::construct(data_allocator, begin_.cur, value);
         } catch (...) {
             ++begin_;
             throw;
@@ -1084,17 +1202,17 @@ void deque<T>::push_front(const value_type& value) {
 /**
  * @brief 在容器尾部添加元素
  */
-template <class T>
-void deque<T>::push_back(const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::push_back(const value_type& value) {
     if (end_.cur != end_.last - 1) {
         // 缓冲区尾部有剩余空间
         // 在当前位置构造元素
-        data_allocator.construct(end_.cur, value);
+        data_alloc_traits::construct(data_allocator, end_.cur, value);
         ++end_.cur;
     } else {
         // 需要在后面分配新的缓冲区
         require_capacity(1, false);
-        data_allocator.construct(end_.cur, value);
+        data_alloc_traits::construct(data_allocator, end_.cur, value);
         ++end_;
     }
 }
@@ -1102,19 +1220,19 @@ void deque<T>::push_back(const value_type& value) {
 /**
  * @brief 在容器头部原地构造元素
  */
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-void deque<T>::emplace_front(Args&&... args) {
+void deque<T, Alloc>::emplace_front(Args&&... args) {
     if (begin_.cur != begin_.first) {
         // 缓冲区前部有剩余空间
-        data_allocator.construct(begin_.cur - 1, std::forward<Args>(args)...);
+        data_alloc_traits::construct(data_allocator, begin_.cur - 1, std::forward<Args>(args)...);
         --begin_.cur;
     } else {
         // 需要在前面分配新的缓冲区
         require_capacity(1, true);
         try {
             --begin_;
-            data_allocator.construct(begin_.cur, std::forward<Args>(args)...);
+            data_alloc_traits::construct(data_allocator, begin_.cur, std::forward<Args>(args)...);
         } catch (...) {
             ++begin_;
             throw;
@@ -1125,17 +1243,17 @@ void deque<T>::emplace_front(Args&&... args) {
 /**
  * @brief 在容器尾部原地构造元素
  */
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-void deque<T>::emplace_back(Args&&... args) {
+void deque<T, Alloc>::emplace_back(Args&&... args) {
     if (end_.cur != end_.last - 1) {
         // 缓冲区尾部有剩余空间
-        data_allocator.construct(end_.cur, std::forward<Args>(args)...);
+        data_alloc_traits::construct(data_allocator, end_.cur, std::forward<Args>(args)...);
         ++end_.cur;
     } else {
         // 需要在后面分配新的缓冲区
         require_capacity(1, false);
-        data_allocator.construct(end_.cur, std::forward<Args>(args)...);
+        data_alloc_traits::construct(data_allocator, end_.cur, std::forward<Args>(args)...);
         ++end_;
     }
 }
@@ -1143,8 +1261,8 @@ void deque<T>::emplace_back(Args&&... args) {
 /**
  * @brief 从容器头部删除元素
  */
-template <class T>
-void deque<T>::pop_front() {
+template <class T, class Alloc>
+void deque<T, Alloc>::pop_front() {
     if (empty()) {
         return;
     }
@@ -1152,11 +1270,11 @@ void deque<T>::pop_front() {
     if (begin_.cur != begin_.last - 1) {
         // 不是缓冲区最后一个元素
         // 销毁当前元素
-        data_allocator.destroy(begin_.cur);
+        data_alloc_traits::destroy(data_allocator, begin_.cur);
         ++begin_.cur;
     } else {
         // 销毁当前元素
-        data_allocator.destroy(begin_.cur);
+        data_alloc_traits::destroy(data_allocator, begin_.cur);
         ++begin_; // 移动到下一个缓冲区
         // 释放空缓冲区
         destroy_buffer(begin_.node - 1, begin_.node - 1);
@@ -1166,8 +1284,8 @@ void deque<T>::pop_front() {
 /**
  * @brief 从容器尾部删除元素
  */
-template <class T>
-void deque<T>::pop_back() {
+template <class T, class Alloc>
+void deque<T, Alloc>::pop_back() {
     if (empty()) {
         return;
     }
@@ -1176,12 +1294,12 @@ void deque<T>::pop_back() {
         // 不是缓冲区第一个元素
         // 销毁当前元素
         --end_.cur;
-        data_allocator.destroy(end_.cur);
+        data_alloc_traits::destroy(data_allocator, end_.cur);
     } else {
         // 移动到前一个缓冲区
         --end_;
         // 销毁当前元素
-        data_allocator.destroy(end_.cur);
+        data_alloc_traits::destroy(data_allocator, end_.cur);
         // 释放空缓冲区
         destroy_buffer(end_.node + 1, end_.node + 1);
     }
@@ -1190,30 +1308,30 @@ void deque<T>::pop_back() {
 /**
  * @brief 清空容器
  */
-template <class T>
-void deque<T>::clear() {
+template <class T, class Alloc>
+void deque<T, Alloc>::clear() {
     // 保留头部缓冲区
     
     // 销毁中间缓冲区的所有元素
     for (map_pointer cur = begin_.node + 1; cur < end_.node; ++cur) {
         for (pointer p = *cur; p < *cur + buffer_size; ++p) {
-            data_allocator.destroy(p);
+            data_alloc_traits::destroy(data_allocator, p);
         }
     }
     
     if (begin_.node != end_.node) { // 有多个缓冲区
         // 销毁第一个缓冲区中的元素
         for (pointer p = begin_.cur; p < begin_.last; ++p) {
-            data_allocator.destroy(p);
+            data_alloc_traits::destroy(data_allocator, p);
         }
         // 销毁最后一个缓冲区中的元素
         for (pointer p = end_.first; p < end_.cur; ++p) {
-            data_allocator.destroy(p);
+            data_alloc_traits::destroy(data_allocator, p);
         }
     } else { // 只有一个缓冲区
         // 销毁当前缓冲区中的所有元素
         for (pointer p = begin_.cur; p < end_.cur; ++p) {
-            data_allocator.destroy(p);
+            data_alloc_traits::destroy(data_allocator, p);
         }
     }
     
@@ -1227,8 +1345,8 @@ void deque<T>::clear() {
 /**
  * @brief 确保容器有足够的容量
  */
-template <class T>
-void deque<T>::require_capacity(size_type n, bool front) {
+template <class T, class Alloc>
+void deque<T, Alloc>::require_capacity(size_type n, bool front) {
     if (front && (static_cast<size_type>(begin_.cur - begin_.first) < n)) {
         // 前端空间不足
         // 计算需要额外分配的缓冲区数量
@@ -1264,8 +1382,8 @@ void deque<T>::require_capacity(size_type n, bool front) {
 /**
  * @brief 在头部重新分配map
  */
-template <class T>
-void deque<T>::reallocate_map_at_front(size_type need_buffer) {
+template <class T, class Alloc>
+void deque<T, Alloc>::reallocate_map_at_front(size_type need_buffer) {
     // 分配一个更大的map
     // 新大小至少是原来的两倍或者足够放置新缓冲区
     const size_type new_map_size = std::max(map_size_ << 1,
@@ -1294,7 +1412,7 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer) {
     end_ = iterator(*(end - 1) + (end_.cur - end_.first), end - 1);
     
     // 释放旧map
-    map_allocator.deallocate(map_, map_size_);
+    map_alloc_traits::deallocate(map_allocator, map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
 }
@@ -1302,8 +1420,8 @@ void deque<T>::reallocate_map_at_front(size_type need_buffer) {
 /**
  * @brief 在尾部重新分配map
  */
-template <class T>
-void deque<T>::reallocate_map_at_back(size_type need_buffer) {
+template <class T, class Alloc>
+void deque<T, Alloc>::reallocate_map_at_back(size_type need_buffer) {
     // 分配一个更大的map
     // 新大小至少是原来的两倍或者足够放置新缓冲区
     const size_type new_map_size = std::max(map_size_ << 1,
@@ -1332,29 +1450,110 @@ void deque<T>::reallocate_map_at_back(size_type need_buffer) {
     end_ = iterator(*(mid - 1) + (end_.cur - end_.first), mid - 1);
     
     // 释放旧map
-    map_allocator.deallocate(map_, map_size_);
+    map_alloc_traits::deallocate(map_allocator, map_, map_size_);
     map_ = new_map;
     map_size_ = new_map_size;
 }
 
+/**
+ * @brief 析构所有元素并释放全部缓冲区和map
+ */
+template <class T, class Alloc>
+void deque<T, Alloc>::release_storage() noexcept {
+    if (map_ != nullptr) {
+        clear();
+        data_alloc_traits::deallocate(data_allocator, *begin_.node, buffer_size);
+        *begin_.node = nullptr;
+        map_alloc_traits::deallocate(map_allocator, map_, map_size_);
+        map_ = nullptr;
+        map_size_ = 0;
+    }
+}
+
+/**
+ * @brief 通过分配器复制构造一段元素
+ */
+template <class T, class Alloc>
+template <class InputIter, class ForwardIter>
+ForwardIter deque<T, Alloc>::uninitialized_copy_a(InputIter first, InputIter last, ForwardIter result) {
+    auto cur = result;
+    try {
+        for (; first != last; ++first, ++cur) {
+            data_alloc_traits::construct(data_allocator, std::addressof(*cur), *first);
+        }
+    }
+    catch (...) {
+        for (; result != cur; ++result) {
+            data_alloc_traits::destroy(data_allocator, std::addressof(*result));
+        }
+        throw;
+    }
+    return cur;
+}
+
+/**
+ * @brief 通过分配器在一段未初始化空间中构造相同的元素
+ */
+template <class T, class Alloc>
+template <class ForwardIter>
+void deque<T, Alloc>::uninitialized_fill_a(ForwardIter first, ForwardIter last, const value_type& value) {
+    auto cur = first;
+    try {
+        for (; cur != last; ++cur) {
+            data_alloc_traits::construct(data_allocator, std::addressof(*cur), value);
+        }
+    }
+    catch (...) {
+        for (; first != cur; ++first) {
+            data_alloc_traits::destroy(data_allocator, std::addressof(*first));
+        }
+        throw;
+    }
+}
+
+/**
+ * @brief 通过分配器构造n个相同的元素
+ */
+template <class T, class Alloc>
+template <class ForwardIter>
+ForwardIter deque<T, Alloc>::uninitialized_fill_n_a(ForwardIter first, size_type n, const value_type& value) {
+    auto cur = first;
+    try {
+        for (; n > 0; --n, ++cur) {
+            data_alloc_traits::construct(data_allocator, std::addressof(*cur), value);
+        }
+    }
+    catch (...) {
+        for (; first != cur; ++first) {
+            data_alloc_traits::destroy(data_allocator, std::addressof(*first));
+        }
+        throw;
+    }
+    return cur;
+}
+
 /**
  * @brief 交换两个容器的内容
  */
-template <class T>
-void deque<T>::swap(deque& rhs) noexcept {
+template <class T, class Alloc>
+void deque<T, Alloc>::swap(deque& rhs) noexcept {
     if (this != &rhs) {
         std::swap(begin_, rhs.begin_);
         std::swap(end_, rhs.end_);
         std::swap(map_, rhs.map_);
         std::swap(map_size_, rhs.map_size_);
+        if (data_alloc_traits::propagate_on_container_swap::value) {
+            std::swap(data_allocator, rhs.data_allocator);
+            std::swap(map_allocator, rhs.map_allocator);
+        }
     }
 }
 
 /**
  * @brief 重载比较操作符==
  */
-template <class T>
-bool operator==(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return lhs.size() == rhs.size() && 
            std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
@@ -1362,8 +1561,8 @@ bool operator==(const deque<T>& lhs, const deque<T>& rhs) {
 /**
  * @brief 重载比较操作符<
  */
-template <class T>
-bool operator<(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return std::lexicographical_compare(
         lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -1371,49 +1570,49 @@ bool operator<(const deque<T>& lhs, const deque<T>& rhs) {
 /**
  * @brief 重载比较操作符!=
  */
-template <class T>
-bool operator!=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
 /**
  * @brief 重载比较操作符>
  */
-template <class T>
-bool operator>(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
 /**
  * @brief 重载比较操作符<=
  */
-template <class T>
-bool operator<=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
 /**
  * @brief 重载比较操作符>=
  */
-template <class T>
-bool operator>=(const deque<T>& lhs, const deque<T>& rhs) {
+template <class T, class Alloc>
+bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 /**
  * @brief 重载全局swap函数
  */
-template <class T>
-void swap(deque<T>& lhs, deque<T>& rhs) noexcept {
+template <class T, class Alloc>
+void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
 /**
  * @brief 在指定位置插入元素
  */
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator pos, const value_type& value) {
+template <class T, class Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert(iterator pos, const value_type& value) {
     if (pos.cur == begin_.cur) {
         // 在头部插入
         push_front(value);
@@ -1435,9 +1634,9 @@ deque<T>::insert(iterator pos, const value_type& value) {
 /**
  * @brief 在指定位置插入元素(移动版本)
  */
-template <class T>
-typename deque<T>::iterator
-deque<T>::insert(iterator pos, value_type&& value) {
+template <class T, class Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert(iterator pos, value_type&& value) {
     if (pos.cur == begin_.cur) {
         // 在头部插入
         emplace_front(std::move(value));
@@ -1459,20 +1658,20 @@ deque<T>::insert(iterator pos, value_type&& value) {
 /**
  * @brief 在指定位置插入n个元素
  */
-template <class T>
-void deque<T>::insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::insert(iterator pos, size_type n, const value_type& value) {
     if (pos.cur == begin_.cur) {
         // 在头部插入
         require_capacity(n, true);
         auto new_begin = begin_ - n;
-        std::uninitialized_fill_n(new_begin, n, value);
+        uninitialized_fill_n_a(new_begin, n, value);
         begin_ = new_begin;
     }
     else if (pos.cur == end_.cur) {
         // 在尾部插入
         require_capacity(n, false);
         auto new_end = end_ + n;
-        std::uninitialized_fill_n(end_, n, value);
+        uninitialized_fill_n_a(end_, n, value);
         end_ = new_end;
     }
     else {
@@ -1484,10 +1683,10 @@ void deque<T>::insert(iterator pos, size_type n, const value_type& value) {
 /**
  * @brief 在指定位置插入元素的辅助函数
  */
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename deque<T>::iterator
-deque<T>::insert_aux(iterator pos, Args&&... args) {
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert_aux(iterator pos, Args&&... args) {
     const size_type elems_before = pos - begin_;
     value_type value_copy(std::forward<Args>(args)...);
     
@@ -1526,10 +1725,10 @@ deque<T>::insert_aux(iterator pos, Args&&... args) {
 /**
  * @brief 在指定位置原地构造元素
  */
-template <class T>
+template <class T, class Alloc>
 template <class... Args>
-typename deque<T>::iterator
-deque<T>::emplace(iterator pos, Args&&... args) {
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::emplace(iterator pos, Args&&... args) {
     if (pos.cur == begin_.cur) {
         // 在头部插入
         emplace_front(std::forward<Args>(args)...);
@@ -1551,8 +1750,8 @@ deque<T>::emplace(iterator pos, Args&&... args) {
 /**
  * @brief 在指定位置填充插入元素
  */
-template <class T>
-void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc>
+void deque<T, Alloc>::fill_insert(iterator pos, size_type n, const value_type& value) {
     const size_type elems_before = pos - begin_;
     const size_type len = size();
     auto value_copy = value;
@@ -1570,7 +1769,7 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
             if (elems_before >= n) {
                 // 前端元素足够移动到前面新分配的空间
                 auto begin_n = begin_ + n;
-                std::uninitialized_copy(begin_, begin_n, new_begin);
+                uninitialized_copy_a(begin_, begin_n, new_begin);
                 begin_ = new_begin;
                 std::copy(begin_n, pos, old_begin);
                 std::fill(pos - n, pos, value_copy);
@@ -1578,8 +1777,8 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
             else {
                 // 前端元素不足，分两段处理
                 // 先将前端元素移动到新空间，剩余空间用value填充
-                auto mid = std::uninitialized_copy(begin_, pos, new_begin);
-                std::uninitialized_fill(mid, begin_, value_copy);
+                auto mid = uninitialized_copy_a(begin_, pos, new_begin);
+                uninitialized_fill_a(mid, begin_, value_copy);
                 begin_ = new_begin;
                 std::fill(old_begin, pos, value_copy);
             }
@@ -1605,7 +1804,7 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
             if (elems_after > n) {
                 // 后端元素足够移动到后面新分配的空间
                 auto end_n = end_ - n;
-                std::uninitialized_copy(end_n, end_, end_);
+                uninitialized_copy_a(end_n, end_, end_);
                 end_ = new_end;
                 std::copy_backward(pos, end_n, old_end);
                 std::fill(pos, pos + n, value_copy);
@@ -1613,8 +1812,8 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
             else {
                 // 后端元素不足，分两段处理
                 // 先用value填充新空间一部分，再将后端元素移动到剩余空间
-                std::uninitialized_fill(end_, pos + n, value_copy);
-                std::uninitialized_copy(pos, end_, pos + n);
+                uninitialized_fill_a(end_, pos + n, value_copy);
+                uninitialized_copy_a(pos, end_, pos + n);
                 end_ = new_end;
                 std::fill(pos, old_end, value_copy);
             }
@@ -1631,9 +1830,9 @@ void deque<T>::fill_insert(iterator pos, size_type n, const value_type& value) {
 /**
  * @brief 删除指定位置的元素
  */
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator pos) {
+template <class T, class Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::erase(iterator pos) {
     auto next = pos;
     ++next;
     const size_type elems_before = pos - begin_;
@@ -1655,9 +1854,9 @@ deque<T>::erase(iterator pos) {
 /**
  * @brief 删除范围内的元素
  */
-template <class T>
-typename deque<T>::iterator
-deque<T>::erase(iterator first, iterator last) {
+template <class T, class Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::erase(iterator first, iterator last) {
     if (first == begin_ && last == end_) {
         // 清空整个容器
         clear();
@@ -1676,7 +1875,7 @@ deque<T>::erase(iterator first, iterator last) {
             auto new_begin = begin_ + len;
             // 销毁多余元素
             for (auto cur = begin_.cur; cur != new_begin.cur; ++cur) {
-                data_allocator.destroy(cur);
+                data_alloc_traits::destroy(data_allocator, cur);
             }
             begin_ = new_begin;
         }
@@ -1688,7 +1887,7 @@ deque<T>::erase(iterator first, iterator last) {
             auto new_end = end_ - len;
             // 销毁多余元素
             for (auto cur = new_end.cur; cur != end_.cur; ++cur) {
-                data_allocator.destroy(cur);
+                data_alloc_traits::destroy(data_allocator, cur);
             }
             end_ = new_end;
         }
@@ -1697,6 +1896,16 @@ deque<T>::erase(iterator first, iterator last) {
     }
 }
 
+namespace pmr {
+
+/**
+ * @brief 使用 polymorphic_allocator 的 deque
+ */
+template <class T>
+using deque = mystl::deque<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MY_DEQUE_H 
\ No newline at end of file
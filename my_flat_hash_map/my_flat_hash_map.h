@@ -0,0 +1,1508 @@
+#ifndef MY_FLAT_HASH_MAP_H
+#define MY_FLAT_HASH_MAP_H
+
+// 这个头文件包含一个开放寻址的哈希表 flat_hashtable，以及基于它的两个容器
+// flat_hash_map 和 flat_hash_set
+//
+// 与开链法的 hashtable 不同，flat_hashtable 采用 Swiss table 的布局：
+//   * 元素直接存放在一块连续的槽位数组中，没有单独的节点
+//   * 每个槽位对应一个控制字节，记录槽位状态（空 / 已删除 / 已占用）以及哈希值的低 7 位
+//   * 查找时一次比较一组（16 个）控制字节，只有控制字节匹配的槽位才会调用 KeyEqual
+//
+// 接口与 unordered_map / unordered_set 保持一致（桶接口除外），
+// 因此只需替换 typedef 即可在两种实现之间切换
+//
+// 注意：插入可能引起重哈希，重哈希后所有迭代器、指针和引用都会失效
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MYSTL_FLAT_HASH_SSE2 1
+#endif
+
+#include "../my_hashtable/my_hashtable.h"
+#include "../my_memory_resource/my_memory_resource.h"
+
+namespace mystl
+{
+
+/**
+ * @brief 控制字节类型
+ *
+ * 0b10000000 : 空槽位
+ * 0b11111110 : 已删除（墓碑）
+ * 0b0xxxxxxx : 已占用，低 7 位为哈希值的 H2 部分
+ */
+typedef int8_t fh_ctrl_t;
+
+static constexpr fh_ctrl_t fh_ctrl_empty   = -128;  // 空槽位
+static constexpr fh_ctrl_t fh_ctrl_deleted = -2;    // 已删除的槽位
+static constexpr size_t    fh_group_width  = 16;    // 每组控制字节的数量
+
+/**
+ * @brief 判断控制字节是否表示已占用的槽位
+ */
+inline bool fh_is_full(fh_ctrl_t c) { return c >= 0; }
+
+/**
+ * @brief 返回掩码中最低位 1 的位置
+ * @param mask 非零掩码
+ */
+inline size_t fh_lowest_bit(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctz(mask));
+#else
+    size_t n = 0;
+    for (; (mask & 1u) == 0; mask >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+/**
+ * @brief 返回 16 位掩码的前导零个数
+ * @param mask 16 位掩码，可以为零
+ */
+inline size_t fh_leading_zeros16(uint32_t mask)
+{
+    size_t n = 0;
+    for (uint32_t bit = 1u << 15; bit != 0 && (mask & bit) == 0; bit >>= 1)
+        ++n;
+    return n;
+}
+
+/**
+ * @brief 对用户哈希值再做一次混合
+ *
+ * std::hash<int> 等哈希函数是恒等映射，低位和高位都不够随机，
+ * 而 flat_hashtable 同时使用高位（H1，决定探测起点）和低 7 位（H2，存入控制字节）
+ */
+inline size_t fh_mix(size_t h)
+{
+#if SIZE_MAX > 0xFFFFFFFFu
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+#else
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+#endif
+    return h;
+}
+
+inline size_t    fh_h1(size_t h) { return h >> 7; }
+inline fh_ctrl_t fh_h2(size_t h) { return static_cast<fh_ctrl_t>(h & 0x7f); }
+
+/**
+ * @brief 一组控制字节
+ *
+ * 支持 SSE2 时用一条比较指令同时匹配 16 个控制字节，否则逐字节比较
+ */
+struct fh_group
+{
+#ifdef MYSTL_FLAT_HASH_SSE2
+    __m128i ctrl;
+
+    explicit fh_group(const fh_ctrl_t* pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    /**
+     * @brief 返回控制字节等于 h2 的槽位掩码
+     */
+    uint32_t match(fh_ctrl_t h2) const
+    {
+        return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    /**
+     * @brief 返回空槽位或已删除槽位的掩码（两者的最高位都是 1）
+     */
+    uint32_t match_empty_or_deleted() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+    }
+#else
+    fh_ctrl_t ctrl[fh_group_width];
+
+    explicit fh_group(const fh_ctrl_t* pos)
+    {
+        std::memcpy(ctrl, pos, fh_group_width);
+    }
+
+    uint32_t match(fh_ctrl_t h2) const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < fh_group_width; ++i)
+        {
+            if (ctrl[i] == h2)
+                mask |= 1u << i;
+        }
+        return mask;
+    }
+
+    uint32_t match_empty_or_deleted() const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < fh_group_width; ++i)
+        {
+            if (ctrl[i] < 0)
+                mask |= 1u << i;
+        }
+        return mask;
+    }
+#endif
+
+    /**
+     * @brief 返回空槽位的掩码
+     */
+    uint32_t match_empty() const { return match(fh_ctrl_empty); }
+};
+
+// 前向声明
+template <class T, class Hash, class KeyEqual, class Alloc>
+class flat_hashtable;
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct fh_iterator;
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct fh_const_iterator;
+
+/**
+ * @brief 开放寻址哈希表迭代器基类
+ *
+ * 保存容器指针和槽位下标，下标等于容量时表示 end()
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct fh_iterator_base : public mystl::iterator<forward_iterator_tag, T>
+{
+    typedef mystl::flat_hashtable<T, Hash, KeyEqual, Alloc>    table_type;
+    typedef fh_iterator_base<T, Hash, KeyEqual, Alloc>         base;
+    typedef mystl::fh_iterator<T, Hash, KeyEqual, Alloc>       iterator;
+    typedef mystl::fh_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
+    typedef table_type*                                        contain_ptr;
+    typedef size_t                                             size_type;
+    typedef ptrdiff_t                                          difference_type;
+
+    contain_ptr ht;     // 所属容器
+    size_type   index;  // 当前槽位下标
+
+    fh_iterator_base() : ht(nullptr), index(0) {}
+    fh_iterator_base(contain_ptr t, size_type i) : ht(t), index(i) {}
+
+    /**
+     * @brief 移动到下一个已占用的槽位
+     */
+    void incr()
+    {
+        const size_type cap = ht->capacity_;
+        while (++index < cap && !fh_is_full(ht->ctrl_[index])) {}
+    }
+
+    bool operator==(const base& rhs) const { return index == rhs.index; }
+    bool operator!=(const base& rhs) const { return index != rhs.index; }
+};
+
+/**
+ * @brief 开放寻址哈希表迭代器
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct fh_iterator : public fh_iterator_base<T, Hash, KeyEqual, Alloc>
+{
+    typedef fh_iterator_base<T, Hash, KeyEqual, Alloc> base;
+    typedef typename base::contain_ptr                 contain_ptr;
+    typedef typename base::size_type                   size_type;
+    typedef typename base::iterator                    iterator;
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+    typedef value_type& reference;
+
+    using base::ht;
+    using base::index;
+
+    fh_iterator() = default;
+    fh_iterator(contain_ptr t, size_type i) : base(t, i) {}
+
+    reference operator*()  const { return ht->slots_[index]; }
+    pointer   operator->() const { return &(operator*()); }
+
+    iterator& operator++()
+    {
+        this->incr();
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp = *this;
+        this->incr();
+        return tmp;
+    }
+};
+
+/**
+ * @brief 开放寻址哈希表常量迭代器
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+struct fh_const_iterator : public fh_iterator_base<T, Hash, KeyEqual, Alloc>
+{
+    typedef fh_iterator_base<T, Hash, KeyEqual, Alloc> base;
+    typedef typename base::contain_ptr                 contain_ptr;
+    typedef typename base::size_type                   size_type;
+    typedef typename base::iterator                    iterator;
+    typedef typename base::const_iterator              const_iterator;
+
+    typedef T                 value_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    using base::ht;
+    using base::index;
+
+    fh_const_iterator() = default;
+    fh_const_iterator(contain_ptr t, size_type i) : base(t, i) {}
+    fh_const_iterator(const iterator& rhs) : base(rhs.ht, rhs.index) {}
+
+    reference operator*()  const { return ht->slots_[index]; }
+    pointer   operator->() const { return &(operator*()); }
+
+    const_iterator& operator++()
+    {
+        this->incr();
+        return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+        const_iterator tmp = *this;
+        this->incr();
+        return tmp;
+    }
+};
+
+/**
+ * @brief 开放寻址哈希表模板类
+ *
+ * 容量总是 0 或 2 的幂（至少 16）。控制字节数组长度为 容量 + 16，
+ * 末尾 16 个字节是开头 16 个字节的副本，这样从任意槽位开始读取一组控制字节都不会越界
+ * 探测以组为单位进行二次探测，最大负载因子固定为 7/8
+ *
+ * @tparam T 值类型
+ * @tparam Hash 哈希函数类型
+ * @tparam KeyEqual 键值相等判断函数类型
+ * @tparam Alloc 分配器类型，控制字节数组和槽位数组都由它 rebind 得到的分配器分配
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+class flat_hashtable
+{
+    friend struct mystl::fh_iterator_base<T, Hash, KeyEqual, Alloc>;
+    friend struct mystl::fh_iterator<T, Hash, KeyEqual, Alloc>;
+    friend struct mystl::fh_const_iterator<T, Hash, KeyEqual, Alloc>;
+
+public:
+    // 哈希表的型别定义
+    typedef ht_value_traits<T>                          value_traits;
+    typedef typename value_traits::key_type             key_type;
+    typedef typename value_traits::mapped_type          mapped_type;
+    typedef typename value_traits::value_type           value_type;
+    typedef Hash                                        hasher;
+    typedef KeyEqual                                    key_equal;
+
+    typedef Alloc                                       allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T>         data_allocator;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<fh_ctrl_t> ctrl_allocator;
+    typedef std::allocator_traits<data_allocator>       data_alloc_traits;
+    typedef std::allocator_traits<ctrl_allocator>       ctrl_alloc_traits;
+
+    typedef value_type*                                 pointer;
+    typedef const value_type*                           const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef size_t                                      size_type;
+    typedef ptrdiff_t                                   difference_type;
+
+    typedef mystl::fh_iterator<T, Hash, KeyEqual, Alloc>       iterator;
+    typedef mystl::fh_const_iterator<T, Hash, KeyEqual, Alloc> const_iterator;
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+private:
+    fh_ctrl_t*  ctrl_;         // 控制字节数组，长度为 capacity_ + fh_group_width
+    value_type* slots_;        // 槽位数组
+    size_type   capacity_;     // 槽位数量，0 或 2 的幂
+    size_type   size_;         // 元素数量
+    size_type   growth_left_;  // 不扩容的情况下还能占用的空槽位数量
+    hasher      hash_;         // 哈希函数
+    key_equal   equal_;        // 判断键值相等的函数
+    data_allocator alloc_;     // 槽位分配器，控制字节的分配器由它 rebind 得到
+
+public:
+    // 构造、复制、移动、析构函数
+
+    explicit flat_hashtable(size_type count = 0,
+                            const Hash& hash = Hash(),
+                            const KeyEqual& equal = KeyEqual(),
+                            const allocator_type& alloc = allocator_type())
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash_(hash), equal_(equal), alloc_(alloc)
+    {
+        if (count != 0)
+            reserve(count);
+    }
+
+    flat_hashtable(const flat_hashtable& rhs)
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash_(rhs.hash_), equal_(rhs.equal_),
+          alloc_(data_alloc_traits::select_on_container_copy_construction(rhs.alloc_))
+    {
+        copy_init(rhs);
+    }
+
+    flat_hashtable(const flat_hashtable& rhs, const allocator_type& alloc)
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash_(rhs.hash_), equal_(rhs.equal_), alloc_(alloc)
+    {
+        copy_init(rhs);
+    }
+
+    flat_hashtable(flat_hashtable&& rhs) noexcept
+        : ctrl_(rhs.ctrl_), slots_(rhs.slots_), capacity_(rhs.capacity_),
+          size_(rhs.size_), growth_left_(rhs.growth_left_),
+          hash_(rhs.hash_), equal_(rhs.equal_), alloc_(rhs.alloc_)
+    {
+        rhs.ctrl_ = nullptr;
+        rhs.slots_ = nullptr;
+        rhs.capacity_ = 0;
+        rhs.size_ = 0;
+        rhs.growth_left_ = 0;
+    }
+
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * 分配器相等时直接接管 rhs 的槽位数组，否则逐个移动元素
+     */
+    flat_hashtable(flat_hashtable&& rhs, const allocator_type& alloc)
+        : ctrl_(nullptr), slots_(nullptr), capacity_(0), size_(0), growth_left_(0),
+          hash_(rhs.hash_), equal_(rhs.equal_), alloc_(alloc)
+    {
+        if (alloc_ == rhs.alloc_)
+        {
+            swap_data(rhs);
+        }
+        else
+        {
+            reserve(rhs.size_);
+            for (size_type i = 0; i < rhs.capacity_; ++i)
+            {
+                if (fh_is_full(rhs.ctrl_[i]))
+                    insert_unique(std::move(rhs.slots_[i]));
+            }
+            rhs.clear();
+        }
+    }
+
+    flat_hashtable& operator=(const flat_hashtable& rhs)
+    {
+        if (this != &rhs)
+        {
+            // tmp 使用赋值后应当持有的分配器，整体交换后由 tmp 释放原有数组
+            const bool pocca = data_alloc_traits::propagate_on_container_copy_assignment::value;
+            flat_hashtable tmp(rhs, allocator_type(pocca ? rhs.alloc_ : alloc_));
+            swap_data(tmp);
+            std::swap(alloc_, tmp.alloc_);
+        }
+        return *this;
+    }
+
+    flat_hashtable& operator=(flat_hashtable&& rhs)
+        noexcept(data_alloc_traits::propagate_on_container_move_assignment::value)
+    {
+        const bool pocma = data_alloc_traits::propagate_on_container_move_assignment::value;
+        flat_hashtable tmp(std::move(rhs), allocator_type(pocma ? rhs.alloc_ : alloc_));
+        swap_data(tmp);
+        std::swap(alloc_, tmp.alloc_);
+        return *this;
+    }
+
+    ~flat_hashtable()
+    {
+        destroy_slots();
+        deallocate(ctrl_, slots_, capacity_);
+    }
+
+    // 迭代器相关操作
+
+    iterator begin() noexcept
+    {
+        iterator it(this, static_cast<size_type>(-1));
+        it.incr();
+        return it;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        const_iterator it(const_cast<flat_hashtable*>(this), static_cast<size_type>(-1));
+        it.incr();
+        return it;
+    }
+
+    iterator       end()          noexcept { return iterator(this, capacity_); }
+    const_iterator end()    const noexcept { return M_cit(capacity_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend()   const noexcept { return end(); }
+
+    // 容量相关操作
+
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type max_size() const noexcept { return data_alloc_traits::max_size(alloc_); }
+
+    // 修改容器相关操作
+
+    /**
+     * @brief 就地构造元素，不允许重复键值
+     *
+     * 需要先构造出元素才能得到键，若键已存在则丢弃该临时元素
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique(Args&& ...args)
+    {
+        value_type tmp(std::forward<Args>(args)...);
+        return insert_unique(std::move(tmp));
+    }
+
+    /**
+     * @brief 先以键查找，只有键不存在时才用 args 构造元素
+     * @param key 键
+     * @param args 构造 value_type 的参数
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique_key(const key_type& key, Args&& ...args);
+
+    std::pair<iterator, bool> insert_unique(const value_type& value)
+    { return emplace_unique_key(value_traits::get_key(value), value); }
+
+    std::pair<iterator, bool> insert_unique(value_type&& value)
+    { return emplace_unique_key(value_traits::get_key(value), std::move(value)); }
+
+    template <class InputIter>
+    void insert_unique(InputIter first, InputIter last)
+    {
+        for (; first != last; ++first)
+            insert_unique(*first);
+    }
+
+    /**
+     * @brief 删除迭代器所指的元素
+     * @return 指向下一个元素的迭代器
+     */
+    iterator  erase(const_iterator position);
+
+    /**
+     * @brief 删除 [first, last) 内的元素
+     */
+    iterator  erase(const_iterator first, const_iterator last);
+
+    /**
+     * @brief 删除键值为 key 的元素
+     * @return 删除的元素数量（0 或 1）
+     */
+    size_type erase_unique(const key_type& key);
+
+    /**
+     * @brief 清空容器，保留已分配的槽位
+     */
+    void      clear();
+
+    void      swap(flat_hashtable& rhs) noexcept;
+
+    // 查找相关操作
+
+    iterator find(const key_type& key)
+    { return iterator(this, find_index(key)); }
+
+    const_iterator find(const key_type& key) const
+    { return M_cit(find_index(key)); }
+
+    size_type count(const key_type& key) const
+    { return find_index(key) != capacity_ ? 1 : 0; }
+
+    std::pair<iterator, iterator> equal_range_unique(const key_type& key)
+    {
+        iterator it = find(key);
+        if (it == end())
+            return std::make_pair(it, it);
+        iterator next = it;
+        return std::make_pair(it, ++next);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+    {
+        const_iterator it = find(key);
+        if (it == end())
+            return std::make_pair(it, it);
+        const_iterator next = it;
+        return std::make_pair(it, ++next);
+    }
+
+    // hash policy
+
+    size_type bucket_count() const noexcept { return capacity_; }
+
+    float load_factor() const noexcept
+    { return capacity_ != 0 ? (float)size_ / capacity_ : 0.0f; }
+
+    float max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+    /**
+     * @brief 重新分配槽位数组，新容量至少为 count 且足以容纳现有元素
+     */
+    void rehash(size_type count);
+
+    /**
+     * @brief 保证容纳 count 个元素时不发生重哈希
+     */
+    void reserve(size_type count);
+
+    hasher    hash_function() const { return hash_; }
+    key_equal key_eq()        const { return equal_; }
+
+private:
+    const_iterator M_cit(size_type index) const noexcept
+    { return const_iterator(const_cast<flat_hashtable*>(this), index); }
+
+    size_t hash_of(const key_type& key) const
+    { return fh_mix(hash_(key)); }
+
+    /**
+     * @brief 容量为 cap 时最多能放入的元素数量
+     */
+    static size_type growth_limit(size_type cap)
+    { return cap - cap / 8; }
+
+    /**
+     * @brief 求能容纳 count 个元素的最小容量
+     */
+    static size_type capacity_for(size_type count);
+
+    size_type find_index(const key_type& key) const;
+    size_type find_first_non_full(size_t hash) const;
+    size_type prepare_insert(size_t hash);
+    void      set_ctrl(size_type i, fh_ctrl_t c);
+
+    void copy_init(const flat_hashtable& rhs);
+    void resize(size_type new_capacity);
+    void destroy_slots();
+    void swap_data(flat_hashtable& rhs) noexcept;
+
+    void allocate(size_type cap, fh_ctrl_t*& ctrl, value_type*& slots);
+    void deallocate(fh_ctrl_t* ctrl, value_type* slots, size_type cap);
+};
+
+/*****************************************************************************************/
+// 开放寻址哈希表的实现
+
+/**
+ * @brief 先以键查找，只有键不存在时才构造元素
+ * 强异常安全保证：构造元素失败时容器不变（可能已经扩容）
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+template <class ...Args>
+std::pair<typename flat_hashtable<T, Hash, KeyEqual, Alloc>::iterator, bool>
+flat_hashtable<T, Hash, KeyEqual, Alloc>::emplace_unique_key(const key_type& key, Args&& ...args)
+{
+    const size_type found = find_index(key);
+    if (found != capacity_)
+        return std::make_pair(iterator(this, found), false);
+    const size_t h = hash_of(key);
+    const size_type i = prepare_insert(h);
+    data_alloc_traits::construct(alloc_, slots_ + i, std::forward<Args>(args)...);
+    if (ctrl_[i] == fh_ctrl_empty)
+        --growth_left_;
+    set_ctrl(i, fh_h2(h));
+    ++size_;
+    return std::make_pair(iterator(this, i), true);
+}
+
+/**
+ * @brief 删除迭代器所指的元素
+ *
+ * 如果该槽位前后相邻的已占用槽位不足一组，说明没有任何探测序列跨过它，
+ * 可以直接标记为空；否则只能标记为已删除，以免截断其他元素的探测序列
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::iterator
+flat_hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator position)
+{
+    const size_type i = position.index;
+    data_alloc_traits::destroy(alloc_, slots_ + i);
+    --size_;
+
+    const size_type mask = capacity_ - 1;
+    const size_type before = (i - fh_group_width) & mask;
+    const uint32_t empty_after = fh_group(ctrl_ + i).match_empty();
+    const uint32_t empty_before = fh_group(ctrl_ + before).match_empty();
+    const bool was_never_full = empty_before && empty_after &&
+        fh_lowest_bit(empty_after) + fh_leading_zeros16(empty_before) < fh_group_width;
+    if (was_never_full)
+    {
+        set_ctrl(i, fh_ctrl_empty);
+        ++growth_left_;
+    }
+    else
+    {
+        set_ctrl(i, fh_ctrl_deleted);
+    }
+
+    iterator next(this, i);
+    next.incr();
+    return next;
+}
+
+/**
+ * @brief 删除 [first, last) 内的元素
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::iterator
+flat_hashtable<T, Hash, KeyEqual, Alloc>::erase(const_iterator first, const_iterator last)
+{
+    if (first == cbegin() && last == cend())
+    {
+        clear();
+        return end();
+    }
+    while (first != last)
+        first = erase(first);
+    return iterator(this, last.index);
+}
+
+/**
+ * @brief 删除键值为 key 的元素
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::size_type
+flat_hashtable<T, Hash, KeyEqual, Alloc>::erase_unique(const key_type& key)
+{
+    const size_type i = find_index(key);
+    if (i == capacity_)
+        return 0;
+    erase(M_cit(i));
+    return 1;
+}
+
+/**
+ * @brief 清空容器
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::clear()
+{
+    if (capacity_ == 0)
+        return;
+    destroy_slots();
+    std::memset(ctrl_, fh_ctrl_empty, capacity_ + fh_group_width);
+    size_ = 0;
+    growth_left_ = growth_limit(capacity_);
+}
+
+/**
+ * @brief 交换两个 flat_hashtable
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::swap(flat_hashtable& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        swap_data(rhs);
+        // 分配器不传播时两个容器的分配器必须相等
+        if (data_alloc_traits::propagate_on_container_swap::value)
+            std::swap(alloc_, rhs.alloc_);
+    }
+}
+
+/**
+ * @brief 交换除分配器以外的全部数据成员
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::swap_data(flat_hashtable& rhs) noexcept
+{
+    std::swap(ctrl_, rhs.ctrl_);
+    std::swap(slots_, rhs.slots_);
+    std::swap(capacity_, rhs.capacity_);
+    std::swap(size_, rhs.size_);
+    std::swap(growth_left_, rhs.growth_left_);
+    std::swap(hash_, rhs.hash_);
+    std::swap(equal_, rhs.equal_);
+}
+
+/**
+ * @brief 重新分配槽位数组
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::rehash(size_type count)
+{
+    if (size_ == 0 && count == 0)
+    { // 空容器且不要求容量时释放所有内存
+        deallocate(ctrl_, slots_, capacity_);
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = 0;
+        growth_left_ = 0;
+        return;
+    }
+    size_type cap = capacity_for(size_);
+    while (cap < count)
+        cap <<= 1;
+    if (cap != capacity_)
+        resize(cap);
+}
+
+/**
+ * @brief 保证容纳 count 个元素时不发生重哈希
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::reserve(size_type count)
+{
+    if (count > size_ + growth_left_)
+        resize(std::max(capacity_, capacity_for(count)));
+}
+
+/**
+ * @brief 求能容纳 count 个元素的最小容量（2 的幂，至少为一组）
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::size_type
+flat_hashtable<T, Hash, KeyEqual, Alloc>::capacity_for(size_type count)
+{
+    size_type cap = fh_group_width;
+    while (growth_limit(cap) < count)
+    {
+        if (cap > static_cast<size_type>(-1) / 2)
+            throw std::length_error("flat_hashtable: too many elements");
+        cap <<= 1;
+    }
+    return cap;
+}
+
+/**
+ * @brief 查找键值为 key 的槽位
+ * @return 槽位下标，找不到时返回 capacity_
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::size_type
+flat_hashtable<T, Hash, KeyEqual, Alloc>::find_index(const key_type& key) const
+{
+    if (size_ == 0)
+        return capacity_;
+    const size_t h = hash_of(key);
+    const fh_ctrl_t h2 = fh_h2(h);
+    const size_type mask = capacity_ - 1;
+    size_type pos = fh_h1(h) & mask;
+    size_type step = 0;
+    while (true)
+    {
+        fh_group g(ctrl_ + pos);
+        for (uint32_t m = g.match(h2); m != 0; m &= m - 1)
+        {
+            const size_type i = (pos + fh_lowest_bit(m)) & mask;
+            if (equal_(value_traits::get_key(slots_[i]), key))
+                return i;
+        }
+        if (g.match_empty() != 0)
+            return capacity_;
+        // 负载因子不超过 7/8，总能遇到空槽位，循环必然结束
+        step += fh_group_width;
+        pos = (pos + step) & mask;
+    }
+}
+
+/**
+ * @brief 沿探测序列找到第一个空槽位或已删除槽位
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::size_type
+flat_hashtable<T, Hash, KeyEqual, Alloc>::find_first_non_full(size_t hash) const
+{
+    const size_type mask = capacity_ - 1;
+    size_type pos = fh_h1(hash) & mask;
+    size_type step = 0;
+    while (true)
+    {
+        const uint32_t m = fh_group(ctrl_ + pos).match_empty_or_deleted();
+        if (m != 0)
+            return (pos + fh_lowest_bit(m)) & mask;
+        step += fh_group_width;
+        pos = (pos + step) & mask;
+    }
+}
+
+/**
+ * @brief 为哈希值 hash 的新元素找到一个槽位，必要时扩容
+ *
+ * 复用已删除槽位不消耗 growth_left_；空槽位用完时，
+ * 若墓碑较多则原地重建，否则容量加倍
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+typename flat_hashtable<T, Hash, KeyEqual, Alloc>::size_type
+flat_hashtable<T, Hash, KeyEqual, Alloc>::prepare_insert(size_t hash)
+{
+    if (capacity_ == 0)
+        resize(fh_group_width);
+    size_type target = find_first_non_full(hash);
+    if (growth_left_ == 0 && ctrl_[target] != fh_ctrl_deleted)
+    {
+        if (size_ * 2 <= growth_limit(capacity_))
+            resize(capacity_);
+        else
+            resize(capacity_ * 2);
+        target = find_first_non_full(hash);
+    }
+    return target;
+}
+
+/**
+ * @brief 设置控制字节，同时维护末尾的副本
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::set_ctrl(size_type i, fh_ctrl_t c)
+{
+    ctrl_[i] = c;
+    if (i < fh_group_width)
+        ctrl_[capacity_ + i] = c;
+}
+
+/**
+ * @brief 从另一个 flat_hashtable 复制初始化
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::copy_init(const flat_hashtable& rhs)
+{
+    if (rhs.size_ == 0)
+        return;
+    resize(capacity_for(rhs.size_));
+    try
+    {
+        for (size_type i = 0; i < rhs.capacity_; ++i)
+        {
+            if (!fh_is_full(rhs.ctrl_[i]))
+                continue;
+            const size_t h = hash_of(value_traits::get_key(rhs.slots_[i]));
+            const size_type t = find_first_non_full(h);
+            data_alloc_traits::construct(alloc_, slots_ + t, rhs.slots_[i]);
+            set_ctrl(t, fh_h2(h));
+            ++size_;
+            --growth_left_;
+        }
+    }
+    catch (...)
+    {
+        destroy_slots();
+        deallocate(ctrl_, slots_, capacity_);
+        ctrl_ = nullptr;
+        slots_ = nullptr;
+        capacity_ = size_ = growth_left_ = 0;
+        throw;
+    }
+}
+
+/**
+ * @brief 把所有元素搬到容量为 new_capacity 的新槽位数组中
+ * 元素移动构造不抛出异常时使用移动，否则使用拷贝，失败时原表保持不变
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::resize(size_type new_capacity)
+{
+    fh_ctrl_t*  old_ctrl = ctrl_;
+    value_type* old_slots = slots_;
+    const size_type old_capacity = capacity_;
+
+    allocate(new_capacity, ctrl_, slots_);
+    capacity_ = new_capacity;
+    try
+    {
+        for (size_type i = 0; i < old_capacity; ++i)
+        {
+            if (!fh_is_full(old_ctrl[i]))
+                continue;
+            const size_t h = hash_of(value_traits::get_key(old_slots[i]));
+            const size_type t = find_first_non_full(h);
+            data_alloc_traits::construct(alloc_, slots_ + t, std::move_if_noexcept(old_slots[i]));
+            set_ctrl(t, fh_h2(h));
+        }
+    }
+    catch (...)
+    {
+        destroy_slots();
+        deallocate(ctrl_, slots_, capacity_);
+        ctrl_ = old_ctrl;
+        slots_ = old_slots;
+        capacity_ = old_capacity;
+        throw;
+    }
+    growth_left_ = growth_limit(capacity_) - size_;
+
+    for (size_type i = 0; i < old_capacity; ++i)
+    {
+        if (fh_is_full(old_ctrl[i]))
+            data_alloc_traits::destroy(alloc_, old_slots + i);
+    }
+    deallocate(old_ctrl, old_slots, old_capacity);
+}
+
+/**
+ * @brief 析构所有元素，不修改控制字节
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::destroy_slots()
+{
+    if (std::is_trivially_destructible<value_type>::value)
+        return;
+    for (size_type i = 0; i < capacity_; ++i)
+    {
+        if (fh_is_full(ctrl_[i]))
+            data_alloc_traits::destroy(alloc_, slots_ + i);
+    }
+}
+
+/**
+ * @brief 分配控制字节数组和槽位数组，控制字节全部置为空
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::
+allocate(size_type cap, fh_ctrl_t*& ctrl, value_type*& slots)
+{
+    ctrl_allocator ctrl_alloc(alloc_);
+    ctrl = ctrl_alloc_traits::allocate(ctrl_alloc, cap + fh_group_width);
+    try
+    {
+        slots = data_alloc_traits::allocate(alloc_, cap);
+    }
+    catch (...)
+    {
+        ctrl_alloc_traits::deallocate(ctrl_alloc, ctrl, cap + fh_group_width);
+        throw;
+    }
+    std::memset(ctrl, fh_ctrl_empty, cap + fh_group_width);
+}
+
+/**
+ * @brief 释放控制字节数组和槽位数组
+ */
+template <class T, class Hash, class KeyEqual, class Alloc>
+void flat_hashtable<T, Hash, KeyEqual, Alloc>::
+deallocate(fh_ctrl_t* ctrl, value_type* slots, size_type cap)
+{
+    if (ctrl == nullptr)
+        return;
+    ctrl_allocator ctrl_alloc(alloc_);
+    ctrl_alloc_traits::deallocate(ctrl_alloc, ctrl, cap + fh_group_width);
+    data_alloc_traits::deallocate(alloc_, slots, cap);
+}
+
+template <class T, class Hash, class KeyEqual, class Alloc>
+void swap(flat_hashtable<T, Hash, KeyEqual, Alloc>& lhs,
+          flat_hashtable<T, Hash, KeyEqual, Alloc>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/*****************************************************************************************/
+// flat_hash_map / flat_hash_set
+
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+class flat_hash_map;
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<Key>>
+class flat_hash_set;
+
+/**
+ * @class flat_hash_map
+ * @brief 基于开放寻址哈希表的键值对容器，键值不允许重复
+ *
+ * @tparam Key 键类型
+ * @tparam T 值类型
+ * @tparam Hash 哈希函数类型，默认使用 std::hash
+ * @tparam KeyEqual 键比较函数类型，默认使用 std::equal_to
+ * @tparam Alloc 分配器类型，默认使用 std::allocator
+ */
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+class flat_hash_map
+{
+private:
+    // 使用 flat_hashtable 作为底层实现
+    typedef flat_hashtable<std::pair<const Key, T>, Hash, KeyEqual, Alloc> base_type;
+    base_type ht_;
+
+public:
+    // 使用 flat_hashtable 的类型定义
+    typedef typename base_type::allocator_type       allocator_type;
+    typedef typename base_type::key_type             key_type;
+    typedef typename base_type::mapped_type          mapped_type;
+    typedef typename base_type::value_type           value_type;
+    typedef typename base_type::hasher               hasher;
+    typedef typename base_type::key_equal            key_equal;
+
+    typedef typename base_type::size_type            size_type;
+    typedef typename base_type::difference_type      difference_type;
+    typedef typename base_type::pointer              pointer;
+    typedef typename base_type::const_pointer        const_pointer;
+    typedef typename base_type::reference            reference;
+    typedef typename base_type::const_reference      const_reference;
+
+    typedef typename base_type::iterator             iterator;
+    typedef typename base_type::const_iterator       const_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动、析构函数
+
+    /**
+     * @brief 默认构造函数，不分配内存
+     */
+    flat_hash_map() : ht_() {}
+
+    explicit flat_hash_map(const allocator_type& alloc) : ht_(0, Hash(), KeyEqual(), alloc) {}
+
+    /**
+     * @brief 构造函数，预留 bucket_count 个元素的空间
+     */
+    explicit flat_hash_map(size_type bucket_count,
+                           const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
+    {
+    }
+
+    template <class InputIterator>
+    flat_hash_map(InputIterator first, InputIterator last,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
+    {
+        ht_.insert_unique(first, last);
+    }
+
+    flat_hash_map(std::initializer_list<value_type> ilist,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
+    {
+        ht_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_map(const flat_hash_map& rhs) : ht_(rhs.ht_) {}
+    flat_hash_map(flat_hash_map&& rhs) noexcept : ht_(std::move(rhs.ht_)) {}
+    flat_hash_map(const flat_hash_map& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
+    flat_hash_map(flat_hash_map&& rhs, const allocator_type& alloc) : ht_(std::move(rhs.ht_), alloc) {}
+
+    flat_hash_map& operator=(const flat_hash_map& rhs)
+    {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        ht_ = std::move(rhs.ht_);
+        return *this;
+    }
+
+    flat_hash_map& operator=(std::initializer_list<value_type> ilist)
+    {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        ht_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hash_map() = default;
+
+    // 迭代器相关
+
+    iterator       begin()        noexcept { return ht_.begin(); }
+    const_iterator begin()  const noexcept { return ht_.begin(); }
+    iterator       end()          noexcept { return ht_.end(); }
+    const_iterator end()    const noexcept { return ht_.end(); }
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend()   const noexcept { return ht_.cend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return ht_.empty(); }
+    size_type size()     const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器操作
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args)
+    { return ht_.emplace_unique(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return ht_.emplace_unique(std::forward<Args>(args)...).first; }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    { return ht_.insert_unique(value); }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    { return ht_.insert_unique(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return ht_.insert_unique(value).first; }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return ht_.insert_unique(std::move(value)).first; }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { ht_.insert_unique(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { ht_.insert_unique(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator it)                        { return ht_.erase(it); }
+    iterator  erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+    size_type erase(const key_type& key)                      { return ht_.erase_unique(key); }
+
+    void clear() { ht_.clear(); }
+
+    void swap(flat_hash_map& other) noexcept { ht_.swap(other.ht_); }
+
+    // 查找相关
+
+    mapped_type& at(const key_type& key)
+    {
+        iterator it = ht_.find(key);
+        if (it == end())
+            throw std::out_of_range("flat_hash_map::at: key not found");
+        return it->second;
+    }
+
+    const mapped_type& at(const key_type& key) const
+    {
+        const_iterator it = ht_.find(key);
+        if (it == end())
+            throw std::out_of_range("flat_hash_map::at: key not found");
+        return it->second;
+    }
+
+    /**
+     * @brief 访问或插入元素，键已存在时不构造任何临时对象
+     */
+    mapped_type& operator[](const key_type& key)
+    {
+        return ht_.emplace_unique_key(key, std::piecewise_construct,
+                                      std::forward_as_tuple(key),
+                                      std::forward_as_tuple()).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key)
+    {
+        return ht_.emplace_unique_key(key, std::piecewise_construct,
+                                      std::forward_as_tuple(std::move(key)),
+                                      std::forward_as_tuple()).first->second;
+    }
+
+    size_type      count(const key_type& key) const { return ht_.count(key); }
+    iterator       find(const key_type& key)        { return ht_.find(key); }
+    const_iterator find(const key_type& key)  const { return ht_.find(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key)
+    { return ht_.equal_range_unique(key); }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+    { return ht_.equal_range_unique(key); }
+
+    // 哈希策略
+
+    size_type bucket_count()    const noexcept { return ht_.bucket_count(); }
+    float     load_factor()     const noexcept { return ht_.load_factor(); }
+    float     max_load_factor() const noexcept { return ht_.max_load_factor(); }
+
+    void rehash(size_type count)  { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher    hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq()        const { return ht_.key_eq(); }
+};
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (auto it = lhs.begin(); it != lhs.end(); ++it)
+    {
+        auto found = rhs.find(it->first);
+        if (found == rhs.end() || !(found->second == it->second))
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @class flat_hash_set
+ * @brief 基于开放寻址哈希表的集合，键值不允许重复
+ *
+ * @tparam Key 键值类型
+ * @tparam Hash 哈希函数，缺省使用 std::hash
+ * @tparam KeyEqual 键值比较方式，缺省使用 std::equal_to
+ * @tparam Alloc 分配器类型，缺省使用 std::allocator
+ */
+template <class Key, class Hash, class KeyEqual, class Alloc>
+class flat_hash_set
+{
+private:
+    // 使用 flat_hashtable 作为底层机制
+    typedef flat_hashtable<Key, Hash, KeyEqual, Alloc> base_type;
+    base_type ht_;
+
+public:
+    // 使用 flat_hashtable 的类型定义
+    typedef typename base_type::allocator_type       allocator_type;
+    typedef typename base_type::key_type             key_type;
+    typedef typename base_type::value_type           value_type;
+    typedef typename base_type::hasher               hasher;
+    typedef typename base_type::key_equal            key_equal;
+
+    typedef typename base_type::size_type            size_type;
+    typedef typename base_type::difference_type      difference_type;
+    typedef typename base_type::pointer              pointer;
+    typedef typename base_type::const_pointer        const_pointer;
+    typedef typename base_type::reference            reference;
+    typedef typename base_type::const_reference      const_reference;
+
+    typedef typename base_type::const_iterator       iterator;
+    typedef typename base_type::const_iterator       const_iterator;
+
+    allocator_type get_allocator() const { return ht_.get_allocator(); }
+
+public:
+    // 构造、复制、移动函数
+
+    flat_hash_set() : ht_() {}
+
+    explicit flat_hash_set(const allocator_type& alloc) : ht_(0, Hash(), KeyEqual(), alloc) {}
+
+    explicit flat_hash_set(size_type bucket_count,
+                           const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
+    {
+    }
+
+    template <class InputIterator>
+    flat_hash_set(InputIterator first, InputIterator last,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
+    {
+        ht_.insert_unique(first, last);
+    }
+
+    flat_hash_set(std::initializer_list<value_type> ilist,
+                  const size_type bucket_count = 0,
+                  const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
+    {
+        ht_.insert_unique(ilist.begin(), ilist.end());
+    }
+
+    flat_hash_set(const flat_hash_set& rhs) : ht_(rhs.ht_) {}
+    flat_hash_set(flat_hash_set&& rhs) noexcept : ht_(std::move(rhs.ht_)) {}
+    flat_hash_set(const flat_hash_set& rhs, const allocator_type& alloc) : ht_(rhs.ht_, alloc) {}
+    flat_hash_set(flat_hash_set&& rhs, const allocator_type& alloc) : ht_(std::move(rhs.ht_), alloc) {}
+
+    flat_hash_set& operator=(const flat_hash_set& rhs)
+    {
+        ht_ = rhs.ht_;
+        return *this;
+    }
+
+    flat_hash_set& operator=(flat_hash_set&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
+    {
+        ht_ = std::move(rhs.ht_);
+        return *this;
+    }
+
+    flat_hash_set& operator=(std::initializer_list<value_type> ilist)
+    {
+        ht_.clear();
+        ht_.reserve(ilist.size());
+        ht_.insert_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hash_set() = default;
+
+    // 迭代器相关
+
+    iterator       begin()        noexcept { return ht_.begin(); }
+    const_iterator begin()  const noexcept { return ht_.begin(); }
+    iterator       end()          noexcept { return ht_.end(); }
+    const_iterator end()    const noexcept { return ht_.end(); }
+    const_iterator cbegin() const noexcept { return ht_.cbegin(); }
+    const_iterator cend()   const noexcept { return ht_.cend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return ht_.empty(); }
+    size_type size()     const noexcept { return ht_.size(); }
+    size_type max_size() const noexcept { return ht_.max_size(); }
+
+    // 修改容器操作
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args)
+    { return ht_.emplace_unique(std::forward<Args>(args)...); }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args)
+    { return ht_.emplace_unique(std::forward<Args>(args)...).first; }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    { return ht_.insert_unique(value); }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    { return ht_.insert_unique(std::move(value)); }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value)
+    { return ht_.insert_unique(value).first; }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value)
+    { return ht_.insert_unique(std::move(value)).first; }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    { ht_.insert_unique(first, last); }
+
+    void insert(std::initializer_list<value_type> ilist)
+    { ht_.insert_unique(ilist.begin(), ilist.end()); }
+
+    iterator  erase(const_iterator it)                        { return ht_.erase(it); }
+    iterator  erase(const_iterator first, const_iterator last) { return ht_.erase(first, last); }
+    size_type erase(const key_type& key)                      { return ht_.erase_unique(key); }
+
+    void clear() { ht_.clear(); }
+
+    void swap(flat_hash_set& other) noexcept { ht_.swap(other.ht_); }
+
+    // 查找相关
+
+    size_type      count(const key_type& key) const { return ht_.count(key); }
+    iterator       find(const key_type& key)        { return ht_.find(key); }
+    const_iterator find(const key_type& key)  const { return ht_.find(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key)
+    { return ht_.equal_range_unique(key); }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+    { return ht_.equal_range_unique(key); }
+
+    // 哈希策略
+
+    size_type bucket_count()    const noexcept { return ht_.bucket_count(); }
+    float     load_factor()     const noexcept { return ht_.load_factor(); }
+    float     max_load_factor() const noexcept { return ht_.max_load_factor(); }
+
+    void rehash(size_type count)  { ht_.rehash(count); }
+    void reserve(size_type count) { ht_.reserve(count); }
+
+    hasher    hash_function() const { return ht_.hash_function(); }
+    key_equal key_eq()        const { return ht_.key_eq(); }
+};
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+bool operator==(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (auto it = lhs.begin(); it != lhs.end(); ++it)
+    {
+        if (rhs.find(*it) == rhs.end())
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+void swap(flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+          flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 flat_hash_map / flat_hash_set
+ */
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using flat_hash_map =
+    mystl::flat_hash_map<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using flat_hash_set = mystl::flat_hash_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+} // namespace pmr
+
+} // namespace mystl
+
+#endif // MY_FLAT_HASH_MAP_H
@@ -0,0 +1,212 @@
+// test_flat_hash_map.cpp
+// 测试 flat_hash_map 和 flat_hash_set 容器的功能
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cassert>
+#include <utility>
+#include <unordered_map>
+
+#include "my_flat_hash_map.h"
+
+/**
+ * @brief 测试 flat_hash_map 的基本功能
+ */
+void test_flat_hash_map_basic() {
+    std::cout << "===== 测试 flat_hash_map 基本功能 =====" << std::endl;
+
+    // 默认构造不分配内存
+    mystl::flat_hash_map<int, std::string> map1;
+    assert(map1.empty());
+    assert(map1.bucket_count() == 0);
+    assert(map1.find(1) == map1.end());
+    assert(map1.begin() == map1.end());
+
+    auto ret1 = map1.insert(std::make_pair(1, std::string("一")));
+    assert(ret1.second);
+    assert(ret1.first->first == 1);
+    assert(ret1.first->second == "一");
+
+    // 重复插入
+    auto ret2 = map1.insert(std::make_pair(1, std::string("一一")));
+    assert(!ret2.second);
+    assert(map1.size() == 1);
+    assert(map1.at(1) == "一");
+
+    map1[2] = "二";
+    map1[3] = "三";
+    assert(map1.size() == 3);
+    map1[2] = "二二";
+    assert(map1[2] == "二二");
+    assert(map1.count(3) == 1);
+    assert(map1.count(4) == 0);
+
+    auto ret3 = map1.emplace(4, "四");
+    assert(ret3.second);
+    assert(map1.at(4) == "四");
+
+    bool thrown = false;
+    try {
+        map1.at(100);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 删除
+    assert(map1.erase(1) == 1);
+    assert(map1.erase(1) == 0);
+    assert(map1.size() == 3);
+    map1.erase(map1.find(2));
+    assert(map1.size() == 2);
+    assert(map1.find(2) == map1.end());
+
+    // 拷贝、移动与比较
+    mystl::flat_hash_map<int, std::string> map2(map1);
+    assert(map2 == map1);
+    map2[5] = "五";
+    assert(map2 != map1);
+    mystl::flat_hash_map<int, std::string> map3(std::move(map2));
+    assert(map3.size() == 3);
+    assert(map2.empty());
+
+    map1.clear();
+    assert(map1.empty());
+    assert(map1.begin() == map1.end());
+
+    std::cout << "flat_hash_map 基本功能测试通过!" << std::endl;
+}
+
+/**
+ * @brief 与 std::unordered_map 对比随机插入、删除与查找的结果
+ */
+void test_flat_hash_map_random() {
+    std::cout << "\n===== 测试 flat_hash_map 随机操作 =====" << std::endl;
+
+    mystl::flat_hash_map<int, int> fm;
+    std::unordered_map<int, int> ref;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key_dist(0, 5000);
+    std::uniform_int_distribution<int> op_dist(0, 9);
+
+    for (int i = 0; i < 200000; ++i) {
+        const int key = key_dist(gen);
+        const int op = op_dist(gen);
+        if (op < 5) {
+            auto r1 = fm.insert(std::make_pair(key, i));
+            auto r2 = ref.insert(std::make_pair(key, i));
+            assert(r1.second == r2.second);
+            assert(r1.first->second == r2.first->second);
+        } else if (op < 8) {
+            assert(fm.erase(key) == ref.erase(key));
+        } else {
+            auto it = fm.find(key);
+            auto rit = ref.find(key);
+            assert((it == fm.end()) == (rit == ref.end()));
+            if (it != fm.end()) {
+                assert(it->second == rit->second);
+            }
+        }
+        assert(fm.size() == ref.size());
+    }
+
+    // 遍历到的元素个数与 size 一致，且每个元素都能在参照容器中找到
+    size_t n = 0;
+    for (auto it = fm.begin(); it != fm.end(); ++it, ++n) {
+        assert(ref.at(it->first) == it->second);
+    }
+    assert(n == fm.size());
+    assert(fm.load_factor() <= fm.max_load_factor());
+
+    std::cout << "元素数量: " << fm.size() << "，容量: " << fm.bucket_count() << std::endl;
+    std::cout << "flat_hash_map 随机操作测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 string 键、reserve 和 rehash
+ */
+void test_flat_hash_map_string_key() {
+    std::cout << "\n===== 测试 flat_hash_map 字符串键 =====" << std::endl;
+
+    mystl::flat_hash_map<std::string, int> fm;
+    fm.reserve(1000);
+    const auto cap = fm.bucket_count();
+    for (int i = 0; i < 1000; ++i) {
+        fm["key-" + std::to_string(i)] = i;
+    }
+    assert(fm.bucket_count() == cap);  // reserve 之后不再扩容
+    for (int i = 0; i < 1000; ++i) {
+        assert(fm.at("key-" + std::to_string(i)) == i);
+    }
+
+    // 删除一半后再插入，复用墓碑槽位
+    for (int i = 0; i < 1000; i += 2) {
+        assert(fm.erase("key-" + std::to_string(i)) == 1);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        fm.emplace("new-" + std::to_string(i), -i);
+    }
+    assert(fm.size() == 1000);
+
+    fm.rehash(fm.bucket_count() * 4);
+    for (int i = 1; i < 1000; i += 2) {
+        assert(fm.at("key-" + std::to_string(i)) == i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        assert(fm.at("new-" + std::to_string(i)) == -i);
+    }
+
+    std::cout << "flat_hash_map 字符串键测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 flat_hash_set 的基本功能
+ */
+void test_flat_hash_set_basic() {
+    std::cout << "\n===== 测试 flat_hash_set 基本功能 =====" << std::endl;
+
+    mystl::flat_hash_set<int> set1 = {5, 3, 1, 3, 5};
+    assert(set1.size() == 3);
+    assert(set1.count(3) == 1);
+    assert(set1.count(4) == 0);
+
+    auto ret = set1.insert(4);
+    assert(ret.second);
+    assert(*ret.first == 4);
+    assert(!set1.insert(4).second);
+
+    std::vector<int> data;
+    for (int i = 0; i < 10000; ++i) {
+        data.push_back(i * 7);
+    }
+    mystl::flat_hash_set<int> set2(data.begin(), data.end());
+    assert(set2.size() == data.size());
+    for (int v : data) {
+        assert(set2.find(v) != set2.end());
+    }
+    assert(set2.find(1) == set2.end());
+
+    // 边遍历边删除
+    for (auto it = set2.begin(); it != set2.end();) {
+        if (*it % 2 == 0) {
+            it = set2.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    assert(set2.size() == data.size() / 2);
+
+    std::cout << "flat_hash_set 基本功能测试通过!" << std::endl;
+}
+
+int main() {
+    test_flat_hash_map_basic();
+    test_flat_hash_map_random();
+    test_flat_hash_map_string_key();
+    test_flat_hash_set_basic();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
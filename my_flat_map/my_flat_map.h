@@ -0,0 +1,1022 @@
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+// 这个头文件包含基于有序 vector 的 flat_map 和 flat_set
+//
+// 配置表、符号表这类映射往往一次构建、之后只读。红黑树每个元素一个节点，
+// int -> int 的映射每个元素要占 40 字节以上，查找时沿着指针跳转，几乎每一层都是一次缓存缺失。
+// flat_map 把键和值分别放在两个 mystl::vector 中，按键有序排列：
+//   * 内存紧凑，没有任何指针开销；查找在连续的键数组上二分，不会把值读进缓存
+//   * 批量构造和 insert(first, last) 先排序新元素，再与已有元素归并一次，O(n + m log m)
+//   * 单个元素的插入、删除需要移动后续元素，O(n)，适合读多写少的场景
+// 插入和删除之后所有迭代器、指针和引用都可能失效
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../my_vector/my_vector.h"
+
+namespace mystl {
+
+/**
+ * @brief 表示输入已经按键严格递增排列（没有重复键）的标签
+ *
+ * 传给构造函数或 insert 时跳过排序与去重
+ */
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+
+constexpr sorted_unique_t sorted_unique{};
+
+/**
+ * @brief flat_map 的迭代器：同时指向键数组和值数组中的同一位置
+ *
+ * 解引用得到 std::pair<const Key&, T&>，是一个引用的代理对象，而不是容器中真实存在的 pair
+ * @tparam KeyIter 键数组的常量迭代器
+ * @tparam ValueIter 值数组的迭代器（const_iterator 时为只读）
+ */
+template <class KeyIter, class ValueIter>
+class flat_map_iterator {
+public:
+    typedef typename std::iterator_traits<KeyIter>::value_type   key_type;
+    typedef typename std::iterator_traits<ValueIter>::value_type mapped_type;
+    typedef typename std::iterator_traits<ValueIter>::reference  mapped_reference;
+
+    typedef std::random_access_iterator_tag                      iterator_category;
+    typedef std::pair<key_type, mapped_type>                     value_type;
+    typedef std::pair<const key_type&, mapped_reference>         reference;
+    typedef ptrdiff_t                                            difference_type;
+
+    /**
+     * @brief operator-> 返回的代理：持有一个 reference，使 it->first / it->second 可用
+     */
+    struct pointer {
+        reference ref;
+        const reference* operator->() const noexcept { return &ref; }
+    };
+
+    KeyIter   key_it;    // 键数组中的位置
+    ValueIter value_it;  // 值数组中的位置
+
+    flat_map_iterator() : key_it(), value_it() {}
+    flat_map_iterator(KeyIter k, ValueIter v) : key_it(k), value_it(v) {}
+
+    /**
+     * @brief 由普通迭代器转换为常量迭代器
+     */
+    template <class V, class = typename std::enable_if<std::is_convertible<V, ValueIter>::value>::type>
+    flat_map_iterator(const flat_map_iterator<KeyIter, V>& rhs) : key_it(rhs.key_it), value_it(rhs.value_it) {}
+
+    reference operator*() const { return reference(*key_it, *value_it); }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    flat_map_iterator& operator++() { ++key_it; ++value_it; return *this; }
+    flat_map_iterator& operator--() { --key_it; --value_it; return *this; }
+    flat_map_iterator operator++(int) { flat_map_iterator tmp = *this; ++*this; return tmp; }
+    flat_map_iterator operator--(int) { flat_map_iterator tmp = *this; --*this; return tmp; }
+
+    flat_map_iterator& operator+=(difference_type n) { key_it += n; value_it += n; return *this; }
+    flat_map_iterator& operator-=(difference_type n) { key_it -= n; value_it -= n; return *this; }
+    flat_map_iterator operator+(difference_type n) const { return flat_map_iterator(key_it + n, value_it + n); }
+    flat_map_iterator operator-(difference_type n) const { return flat_map_iterator(key_it - n, value_it - n); }
+    friend flat_map_iterator operator+(difference_type n, const flat_map_iterator& it) { return it + n; }
+
+    template <class V>
+    difference_type operator-(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it - rhs.key_it; }
+
+    // 两个数组始终同步移动，只比较键的位置即可
+    template <class V>
+    bool operator==(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it == rhs.key_it; }
+    template <class V>
+    bool operator!=(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it != rhs.key_it; }
+    template <class V>
+    bool operator<(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it < rhs.key_it; }
+    template <class V>
+    bool operator>(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it > rhs.key_it; }
+    template <class V>
+    bool operator<=(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it <= rhs.key_it; }
+    template <class V>
+    bool operator>=(const flat_map_iterator<KeyIter, V>& rhs) const { return key_it >= rhs.key_it; }
+};
+
+/**
+ * @class flat_map
+ * @brief 基于两个有序 vector 的映射，键值不允许重复
+ *
+ * @tparam Key 键值类型
+ * @tparam T 实值类型
+ * @tparam Compare 键值比较方式，缺省使用 std::less
+ * @tparam KeyContainer 存放键的顺序容器，缺省使用 mystl::vector<Key>
+ * @tparam MappedContainer 存放值的顺序容器，缺省使用 mystl::vector<T>
+ */
+template <class Key, class T, class Compare = std::less<Key>,
+          class KeyContainer = mystl::vector<Key>, class MappedContainer = mystl::vector<T>>
+class flat_map {
+public:
+    // flat_map 的类型定义
+    typedef Key                                     key_type;
+    typedef T                                       mapped_type;
+    typedef std::pair<key_type, mapped_type>        value_type;
+    typedef Compare                                 key_compare;
+    typedef std::pair<const Key&, T&>               reference;
+    typedef std::pair<const Key&, const T&>         const_reference;
+    typedef size_t                                  size_type;
+    typedef ptrdiff_t                               difference_type;
+    typedef KeyContainer                            key_container_type;
+    typedef MappedContainer                         mapped_container_type;
+
+    typedef flat_map_iterator<typename KeyContainer::const_iterator,
+                              typename MappedContainer::iterator>       iterator;
+    typedef flat_map_iterator<typename KeyContainer::const_iterator,
+                              typename MappedContainer::const_iterator> const_iterator;
+    typedef std::reverse_iterator<iterator>         reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>   const_reverse_iterator;
+
+    /**
+     * @brief 按键比较两个元素
+     */
+    class value_compare {
+        friend class flat_map;
+    public:
+        bool operator()(const_reference lhs, const_reference rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    protected:
+        explicit value_compare(key_compare c) : comp(c) {}
+        key_compare comp;
+    };
+
+    /**
+     * @brief extract() 返回的底层容器
+     */
+    struct containers {
+        key_container_type    keys;
+        mapped_container_type values;
+    };
+
+private:
+    key_container_type    keys_;    // 有序的键
+    mapped_container_type values_;  // 与键一一对应的值
+    key_compare           comp_;    // 键值比较函数
+
+public:
+    // 构造、复制、移动函数
+
+    flat_map() : keys_(), values_(), comp_() {}
+
+    explicit flat_map(const key_compare& comp) : keys_(), values_(), comp_(comp) {}
+
+    /**
+     * @brief 使用分配器构造，两个底层容器都由该分配器构造（例如 pmr 的内存资源）
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<key_container_type, Alloc>::value &&
+        std::uses_allocator<mapped_container_type, Alloc>::value>::type>
+    explicit flat_map(const Alloc& alloc, const key_compare& comp = key_compare())
+        : keys_(alloc), values_(alloc), comp_(comp) {}
+
+    /**
+     * @brief 以两个容器构造，按键排序并去掉重复的键（保留第一个）
+     * @throw std::invalid_argument 两个容器的大小不同
+     */
+    flat_map(key_container_type keys, mapped_container_type values,
+             const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {
+        check_sizes();
+        sort_and_unique();
+    }
+
+    /**
+     * @brief 以已经按键严格递增排列的两个容器构造，直接接管，不排序，O(1)
+     */
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values,
+             const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {
+        check_sizes();
+    }
+
+    template <class InputIterator>
+    flat_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        : keys_(), values_(), comp_(comp) {
+        insert(first, last);
+    }
+
+    template <class InputIterator>
+    flat_map(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare())
+        : keys_(), values_(), comp_(comp) {
+        insert(sorted_unique, first, last);
+    }
+
+    flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : keys_(), values_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    flat_map(sorted_unique_t, std::initializer_list<value_type> ilist,
+             const key_compare& comp = key_compare())
+        : keys_(), values_(), comp_(comp) {
+        insert(sorted_unique, ilist.begin(), ilist.end());
+    }
+
+    flat_map(const flat_map&) = default;
+    flat_map& operator=(const flat_map&) = default;
+
+    flat_map(flat_map&& rhs)
+        noexcept(std::is_nothrow_move_constructible<key_container_type>::value &&
+                 std::is_nothrow_move_constructible<mapped_container_type>::value &&
+                 std::is_nothrow_copy_constructible<key_compare>::value)
+        : keys_(std::move(rhs.keys_)), values_(std::move(rhs.values_)), comp_(rhs.comp_) {
+        rhs.clear();
+    }
+
+    flat_map& operator=(flat_map&& rhs)
+        noexcept(std::is_nothrow_move_assignable<key_container_type>::value &&
+                 std::is_nothrow_move_assignable<mapped_container_type>::value &&
+                 std::is_nothrow_copy_assignable<key_compare>::value) {
+        if (this != &rhs) {
+            keys_ = std::move(rhs.keys_);
+            values_ = std::move(rhs.values_);
+            comp_ = rhs.comp_;
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return comp_; }
+    value_compare value_comp() const { return value_compare(comp_); }
+
+    const key_container_type&    keys()   const noexcept { return keys_; }
+    const mapped_container_type& values() const noexcept { return values_; }
+
+    /**
+     * @brief 取出底层容器，flat_map 变为空
+     */
+    containers extract() {
+        containers c{std::move(keys_), std::move(values_)};
+        clear();
+        return c;
+    }
+
+    /**
+     * @brief 以已经按键严格递增排列的两个容器替换底层容器
+     */
+    void replace(key_container_type&& keys, mapped_container_type&& values) {
+        keys_ = std::move(keys);
+        values_ = std::move(values);
+        check_sizes();
+    }
+
+    // 迭代器相关
+
+    iterator               begin()         noexcept { return iterator(keys_.cbegin(), values_.begin()); }
+    const_iterator         begin()   const noexcept { return const_iterator(keys_.cbegin(), values_.cbegin()); }
+    iterator               end()           noexcept { return iterator(keys_.cend(), values_.end()); }
+    const_iterator         end()     const noexcept { return const_iterator(keys_.cend(), values_.cend()); }
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return keys_.empty(); }
+    size_type size()     const noexcept { return keys_.size(); }
+    size_type max_size() const noexcept { return std::min<size_type>(keys_.max_size(), values_.max_size()); }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    // 访问元素相关
+
+    mapped_type& at(const key_type& key) {
+        const size_type i = find_index(key);
+        if (i == size())
+            throw std::out_of_range("flat_map<Key, T> no such element exists");
+        return values_[i];
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        const size_type i = find_index(key);
+        if (i == size())
+            throw std::out_of_range("flat_map<Key, T> no such element exists");
+        return values_[i];
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args) {
+        value_type value(std::forward<Args>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    /**
+     * @brief 键不存在时才用 args 构造实值
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args) {
+        return try_emplace_aux(key, std::forward<Args>(args)...);
+    }
+
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args) {
+        return try_emplace_aux(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto result = try_emplace(key, std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto result = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value) {
+        return insert(std::move(value)).first;
+    }
+
+    /**
+     * @brief 批量插入：新元素先追加到底层容器末尾，排序后与原有元素归并一次，O(n + m log m)
+     *
+     * 逐个插入每次都要移动插入点之后的元素，m 个元素为 O(n * m)。
+     * 键重复时保留先出现的元素（原有元素优先）
+     */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        const size_type old_size = size();
+        append(first, last);
+        merge_appended(old_size, false);
+    }
+
+    /**
+     * @brief 批量插入已经按键严格递增排列的元素，省去排序，O(n + m)
+     */
+    template <class InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        const size_type old_size = size();
+        append(first, last);
+        merge_appended(old_size, true);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) {
+        insert(sorted_unique, ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator position) {
+        const difference_type i = position - cbegin();
+        keys_.erase(keys_.cbegin() + i);
+        values_.erase(values_.cbegin() + i);
+        return begin() + i;
+    }
+
+    iterator erase(iterator position) {
+        return erase(const_iterator(position));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const difference_type i = first - cbegin();
+        const difference_type j = last - cbegin();
+        keys_.erase(keys_.cbegin() + i, keys_.cbegin() + j);
+        values_.erase(values_.cbegin() + i, values_.cbegin() + j);
+        return begin() + i;
+    }
+
+    size_type erase(const key_type& key) {
+        const size_type i = find_index(key);
+        if (i == size())
+            return 0;
+        erase(cbegin() + i);
+        return 1;
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+
+    void swap(flat_map& rhs) noexcept {
+        using std::swap;
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        swap(comp_, rhs.comp_);
+    }
+
+    // 查找相关
+
+    iterator       find(const key_type& key)              { return begin() + find_index(key); }
+    const_iterator find(const key_type& key)        const { return begin() + find_index(key); }
+    size_type      count(const key_type& key)       const { return find_index(key) != size() ? 1 : 0; }
+    iterator       lower_bound(const key_type& key)       { return begin() + lower_index(key); }
+    const_iterator lower_bound(const key_type& key) const { return begin() + lower_index(key); }
+    iterator       upper_bound(const key_type& key)       { return begin() + upper_index(key); }
+    const_iterator upper_bound(const key_type& key) const { return begin() + upper_index(key); }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        const size_type i = lower_index(key);
+        const size_type j = (i != size() && !comp_(key, keys_[i])) ? i + 1 : i;
+        return std::make_pair(begin() + i, begin() + j);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return const_cast<flat_map*>(this)->equal_range(key);
+    }
+
+public:
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) {
+        return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+    }
+
+    friend bool operator<(const flat_map& lhs, const flat_map& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    size_type lower_index(const key_type& key) const {
+        return static_cast<size_type>(
+            std::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+
+    size_type upper_index(const key_type& key) const {
+        return static_cast<size_type>(
+            std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+
+    /**
+     * @brief 键所在的下标，不存在时返回 size()
+     */
+    size_type find_index(const key_type& key) const {
+        const size_type i = lower_index(key);
+        return (i != size() && !comp_(key, keys_[i])) ? i : size();
+    }
+
+    void check_sizes() const {
+        if (keys_.size() != values_.size())
+            throw std::invalid_argument("flat_map<Key, T> keys and values differ in size");
+    }
+
+    template <class K, class ...Args>
+    std::pair<iterator, bool> try_emplace_aux(K&& key, Args&& ...args);
+
+    template <class InputIterator>
+    void append(InputIterator first, InputIterator last);
+
+    void merge_appended(size_type old_size, bool sorted);
+    void sort_and_unique();
+};
+
+/*****************************************************************************************/
+// flat_map 的实现
+
+/**
+ * @brief 键不存在时在有序位置插入键和值；插入值失败时撤销已经插入的键
+ */
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+template <class K, class ...Args>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::try_emplace_aux(K&& key, Args&& ...args) {
+    const size_type i = lower_index(key);
+    if (i != size() && !comp_(key, keys_[i]))
+        return std::make_pair(begin() + i, false);
+    keys_.emplace(keys_.cbegin() + i, std::forward<K>(key));
+    try {
+        values_.emplace(values_.cbegin() + i, std::forward<Args>(args)...);
+    } catch (...) {
+        keys_.erase(keys_.cbegin() + i);
+        throw;
+    }
+    return std::make_pair(begin() + i, true);
+}
+
+/**
+ * @brief 把 [first, last) 的键和值分别追加到两个底层容器的末尾
+ */
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+template <class InputIterator>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::append(InputIterator first, InputIterator last) {
+    const size_type old_size = size();
+    try {
+        for (; first != last; ++first) {
+            keys_.emplace_back((*first).first);
+            try {
+                values_.emplace_back((*first).second);
+            } catch (...) {
+                keys_.pop_back();
+                throw;
+            }
+        }
+    } catch (...) {
+        keys_.erase(keys_.cbegin() + old_size, keys_.cend());
+        values_.erase(values_.cbegin() + old_size, values_.cend());
+        throw;
+    }
+}
+
+/**
+ * @brief 把追加在 old_size 之后的元素并入前面的有序部分
+ *
+ * 1. 对追加的部分按键稳定排序（sorted 为 true 时跳过），重复的键只保留第一个
+ * 2. 去掉原有部分中已经存在的键
+ * 3. 两个有序部分归并到新的容器中，各元素只移动一次
+ *
+ * 元素的移动构造可能抛出异常时改为复制（std::move_if_noexcept），归并到新容器的过程中抛出异常，
+ * 原有部分不受影响，去掉追加的部分后容器恢复原状，再把异常抛给调用者。
+ * 只有不可复制且移动会抛出异常的元素例外，这时原有元素可能已被移走
+ * @param old_size 原有的有序部分的大小
+ * @param sorted 追加的部分是否已经按键严格递增
+ */
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::merge_appended(size_type old_size, bool sorted) {
+    const size_type total = size();
+    if (total == old_size)
+        return;
+
+    key_container_type    new_keys(keys_.get_allocator());
+    mapped_container_type new_values(values_.get_allocator());
+    try {
+        // 对追加部分的下标排序，再按排列移动键和值
+        mystl::vector<size_type> order;
+        order.reserve(total - old_size);
+        for (size_type i = old_size; i < total; ++i)
+            order.push_back(i);
+        if (!sorted) {
+            const key_container_type& keys = keys_;
+            const key_compare& comp = comp_;
+            std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return comp(keys[a], keys[b]);
+            });
+            // 稳定排序后相等的键中先出现的排在前面，保留它
+            order.erase(std::unique(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return !comp(keys[a], keys[b]);
+            }), order.end());
+        }
+
+        new_keys.reserve(old_size + order.size());
+        new_values.reserve(old_size + order.size());
+
+        size_type i = 0;
+        auto it = order.begin();
+        while (i < old_size || it != order.end()) {
+            // 取原有部分的条件：新元素用完，或原有的键不大于新键；相等时原有元素优先，新元素丢弃
+            size_type src;
+            if (it == order.end() || (i < old_size && !comp_(keys_[*it], keys_[i]))) {
+                if (it != order.end() && !comp_(keys_[i], keys_[*it]))
+                    ++it;
+                src = i++;
+            } else {
+                src = *it++;
+            }
+            new_keys.emplace_back(std::move_if_noexcept(keys_[src]));
+            new_values.emplace_back(std::move_if_noexcept(values_[src]));
+        }
+    } catch (...) {
+        keys_.erase(keys_.cbegin() + old_size, keys_.cend());
+        values_.erase(values_.cbegin() + old_size, values_.cend());
+        throw;
+    }
+    keys_.swap(new_keys);
+    values_.swap(new_values);
+}
+
+/**
+ * @brief 构造时对整个容器排序去重
+ */
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::sort_and_unique() {
+    const size_type n = size();
+    if (n < 2)
+        return;
+    // 已经有序时不再移动元素
+    bool sorted = true;
+    for (size_type i = 1; i < n && sorted; ++i)
+        sorted = comp_(keys_[i - 1], keys_[i]);
+    if (!sorted)
+        merge_appended(0, false);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator!=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator>(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+               const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator<=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+bool operator>=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+                const flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void swap(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+          flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+/**
+ * @class flat_set
+ * @brief 基于有序 vector 的集合，键值不允许重复
+ *
+ * @tparam Key 键值类型
+ * @tparam Compare 键值比较方式，缺省使用 std::less
+ * @tparam KeyContainer 存放键的顺序容器，缺省使用 mystl::vector<Key>
+ */
+template <class Key, class Compare = std::less<Key>, class KeyContainer = mystl::vector<Key>>
+class flat_set {
+public:
+    // flat_set 的类型定义
+    typedef Key                                          key_type;
+    typedef Key                                          value_type;
+    typedef Compare                                      key_compare;
+    typedef Compare                                      value_compare;
+    typedef const Key&                                   reference;
+    typedef const Key&                                   const_reference;
+    typedef size_t                                       size_type;
+    typedef ptrdiff_t                                    difference_type;
+    typedef KeyContainer                                 container_type;
+
+    // 元素就是键，只提供常量迭代器
+    typedef typename KeyContainer::const_iterator        iterator;
+    typedef typename KeyContainer::const_iterator        const_iterator;
+    typedef std::reverse_iterator<const_iterator>        reverse_iterator;
+    typedef std::reverse_iterator<const_iterator>        const_reverse_iterator;
+
+private:
+    container_type keys_;  // 有序的键
+    key_compare    comp_;  // 键值比较函数
+
+public:
+    // 构造、复制、移动函数
+
+    flat_set() : keys_(), comp_() {}
+
+    explicit flat_set(const key_compare& comp) : keys_(), comp_(comp) {}
+
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<container_type, Alloc>::value>::type>
+    explicit flat_set(const Alloc& alloc, const key_compare& comp = key_compare())
+        : keys_(alloc), comp_(comp) {}
+
+    /**
+     * @brief 以容器构造，排序并去掉重复的键
+     */
+    explicit flat_set(container_type keys, const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), comp_(comp) {
+        merge_appended(0, false);
+    }
+
+    /**
+     * @brief 以已经严格递增排列的容器构造，直接接管，O(1)
+     */
+    flat_set(sorted_unique_t, container_type keys, const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), comp_(comp) {}
+
+    template <class InputIterator>
+    flat_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        : keys_(), comp_(comp) {
+        insert(first, last);
+    }
+
+    template <class InputIterator>
+    flat_set(sorted_unique_t, InputIterator first, InputIterator last,
+             const key_compare& comp = key_compare())
+        : keys_(first, last), comp_(comp) {}
+
+    flat_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : keys_(), comp_(comp) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    flat_set(sorted_unique_t, std::initializer_list<value_type> ilist,
+             const key_compare& comp = key_compare())
+        : keys_(ilist.begin(), ilist.end()), comp_(comp) {}
+
+    flat_set(const flat_set&) = default;
+    flat_set& operator=(const flat_set&) = default;
+
+    flat_set(flat_set&& rhs)
+        noexcept(std::is_nothrow_move_constructible<container_type>::value &&
+                 std::is_nothrow_copy_constructible<key_compare>::value)
+        : keys_(std::move(rhs.keys_)), comp_(rhs.comp_) {
+        rhs.clear();
+    }
+
+    flat_set& operator=(flat_set&& rhs)
+        noexcept(std::is_nothrow_move_assignable<container_type>::value &&
+                 std::is_nothrow_copy_assignable<key_compare>::value) {
+        if (this != &rhs) {
+            keys_ = std::move(rhs.keys_);
+            comp_ = rhs.comp_;
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    flat_set& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    // 相关接口
+
+    key_compare   key_comp()   const { return comp_; }
+    value_compare value_comp() const { return comp_; }
+
+    /**
+     * @brief 取出底层容器，flat_set 变为空
+     */
+    container_type extract() {
+        container_type c(std::move(keys_));
+        keys_.clear();
+        return c;
+    }
+
+    /**
+     * @brief 以已经严格递增排列的容器替换底层容器
+     */
+    void replace(container_type&& keys) {
+        keys_ = std::move(keys);
+    }
+
+    // 迭代器相关
+
+    iterator               begin()   const noexcept { return keys_.cbegin(); }
+    iterator               end()     const noexcept { return keys_.cend(); }
+    reverse_iterator       rbegin()  const noexcept { return reverse_iterator(end()); }
+    reverse_iterator       rend()    const noexcept { return reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    // 容量相关
+
+    bool      empty()    const noexcept { return keys_.empty(); }
+    size_type size()     const noexcept { return keys_.size(); }
+    size_type max_size() const noexcept { return keys_.max_size(); }
+    void      reserve(size_type n)      { keys_.reserve(n); }
+    void      shrink_to_fit()           { keys_.shrink_to_fit(); }
+
+    // 插入删除相关
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace(Args&& ...args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args&& ...args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_aux(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_aux(std::move(value));
+    }
+
+    iterator insert(const_iterator /*hint*/, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator /*hint*/, value_type&& value) {
+        return insert(std::move(value)).first;
+    }
+
+    /**
+     * @brief 批量插入：追加到末尾，排序后与原有元素原地归并一次，O(n + m log m)
+     *
+     * 键重复时保留先出现的元素（原有元素优先）
+     */
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        const size_type old_size = size();
+        keys_.insert(keys_.cend(), first, last);
+        merge_appended(old_size, false);
+    }
+
+    /**
+     * @brief 批量插入已经严格递增排列的元素，省去排序，O(n + m)
+     */
+    template <class InputIterator>
+    void insert(sorted_unique_t, InputIterator first, InputIterator last) {
+        const size_type old_size = size();
+        keys_.insert(keys_.cend(), first, last);
+        merge_appended(old_size, true);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) {
+        insert(sorted_unique, ilist.begin(), ilist.end());
+    }
+
+    iterator erase(const_iterator position) {
+        return keys_.erase(position);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return keys_.erase(first, last);
+    }
+
+    size_type erase(const key_type& key) {
+        const_iterator it = find(key);
+        if (it == end())
+            return 0;
+        keys_.erase(it);
+        return 1;
+    }
+
+    void clear() noexcept { keys_.clear(); }
+
+    void swap(flat_set& rhs) noexcept {
+        using std::swap;
+        keys_.swap(rhs.keys_);
+        swap(comp_, rhs.comp_);
+    }
+
+    // 查找相关
+
+    const_iterator find(const key_type& key) const {
+        const_iterator it = lower_bound(key);
+        return (it != end() && !comp_(key, *it)) ? it : end();
+    }
+
+    size_type count(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    const_iterator lower_bound(const key_type& key) const {
+        return std::lower_bound(begin(), end(), key, comp_);
+    }
+
+    const_iterator upper_bound(const key_type& key) const {
+        return std::upper_bound(begin(), end(), key, comp_);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        const_iterator first = lower_bound(key);
+        const_iterator last = (first != end() && !comp_(key, *first)) ? first + 1 : first;
+        return std::make_pair(first, last);
+    }
+
+public:
+    friend bool operator==(const flat_set& lhs, const flat_set& rhs) {
+        return lhs.keys_ == rhs.keys_;
+    }
+
+    friend bool operator<(const flat_set& lhs, const flat_set& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    template <class V>
+    std::pair<iterator, bool> insert_aux(V&& value) {
+        const_iterator it = lower_bound(value);
+        if (it != end() && !comp_(value, *it))
+            return std::make_pair(it, false);
+        return std::make_pair(keys_.insert(it, std::forward<V>(value)), true);
+    }
+
+    /**
+     * @brief 把追加在 old_size 之后的元素并入前面的有序部分
+     *
+     * 追加部分稳定排序后原地归并（std::inplace_merge 保持稳定，原有元素排在相等的新元素之前），
+     * 再用 std::unique 去重，相等的元素中保留第一个
+     */
+    void merge_appended(size_type old_size, bool sorted) {
+        if (size() == old_size)
+            return;
+        auto first = keys_.begin();
+        auto middle = first + old_size;
+        if (!sorted)
+            std::stable_sort(middle, keys_.end(), comp_);
+        std::inplace_merge(first, middle, keys_.end(), comp_);
+        const key_compare& comp = comp_;
+        keys_.erase(std::unique(keys_.begin(), keys_.end(), [&](const Key& a, const Key& b) {
+            return !comp(a, b);
+        }), keys_.end());
+    }
+};
+
+template <class Key, class Compare, class KeyContainer>
+bool operator!=(const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class KeyContainer>
+bool operator>(const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs) {
+    return rhs < lhs;
+}
+
+template <class Key, class Compare, class KeyContainer>
+bool operator<=(const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class Key, class Compare, class KeyContainer>
+bool operator>=(const flat_set<Key, Compare, KeyContainer>& lhs, const flat_set<Key, Compare, KeyContainer>& rhs) {
+    return !(lhs < rhs);
+}
+
+template <class Key, class Compare, class KeyContainer>
+void swap(flat_set<Key, Compare, KeyContainer>& lhs, flat_set<Key, Compare, KeyContainer>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+/**
+ * @brief 底层容器使用 polymorphic_allocator 的 flat_map / flat_set
+ */
+template <class Key, class T, class Compare = std::less<Key>>
+using flat_map = mystl::flat_map<Key, T, Compare, pmr::vector<Key>, pmr::vector<T>>;
+
+template <class Key, class Compare = std::less<Key>>
+using flat_set = mystl::flat_set<Key, Compare, pmr::vector<Key>>;
+
+} // namespace pmr
+
+} // namespace mystl
+
+#endif // MY_FLAT_MAP_H
@@ -0,0 +1,336 @@
+// test_flat_map.cpp
+// 测试 flat_map 和 flat_set 容器的功能
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <random>
+#include <cassert>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "my_flat_map.h"
+
+/**
+ * @brief 比较 flat_map 与 std::map 的内容
+ */
+template <class FlatMap, class Reference>
+void check_same(const FlatMap& fm, const Reference& ref) {
+    assert(fm.size() == ref.size());
+    auto it = fm.begin();
+    for (const auto& kv : ref) {
+        assert(it->first == kv.first);
+        assert(it->second == kv.second);
+        ++it;
+    }
+    assert(it == fm.end());
+}
+
+/**
+ * @brief 测试 flat_map 的基本功能
+ */
+void test_flat_map_basic() {
+    std::cout << "===== 测试 flat_map 基本功能 =====" << std::endl;
+
+    mystl::flat_map<int, std::string> map1;
+    assert(map1.empty());
+    assert(map1.begin() == map1.end());
+    assert(map1.find(1) == map1.end());
+
+    auto ret1 = map1.insert(std::make_pair(2, std::string("二")));
+    assert(ret1.second && ret1.first->first == 2 && ret1.first->second == "二");
+    auto ret2 = map1.insert(std::make_pair(2, std::string("贰")));
+    assert(!ret2.second && map1.at(2) == "二");
+
+    map1[3] = "三";
+    map1[1] = "一";
+    map1[1] = "壹";
+    assert(map1.size() == 3);
+    assert(map1[1] == "壹");
+    assert(map1.count(3) == 1 && map1.count(4) == 0);
+
+    auto ret3 = map1.emplace(4, "四");
+    assert(ret3.second && map1.at(4) == "四");
+    assert(!map1.try_emplace(4, "肆").second);
+    assert(!map1.insert_or_assign(4, std::string("肆")).second);
+    assert(map1.at(4) == "肆");
+
+    bool thrown = false;
+    try {
+        map1.at(100);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 键有序，键和值分别连续存放
+    int expect = 1;
+    for (auto kv : map1) {
+        assert(kv.first == expect++);
+    }
+    assert(map1.keys().size() == 4 && map1.keys()[0] == 1 && map1.values()[3] == "肆");
+
+    // 通过迭代器修改值
+    auto it = map1.find(2);
+    it->second = "贰";
+    (*it).second += "!";
+    assert(map1.at(2) == "贰!");
+
+    auto range = map1.equal_range(2);
+    assert(range.first->first == 2 && range.second->first == 3);
+    assert(map1.lower_bound(0)->first == 1);
+    assert(map1.upper_bound(4) == map1.end());
+    assert(map1.end() - map1.begin() == 4);
+    assert((*map1.rbegin()).first == 4);
+
+    // 删除
+    assert(map1.erase(1) == 1);
+    assert(map1.erase(1) == 0);
+    auto next = map1.erase(map1.find(2));
+    assert(next->first == 3);
+    assert(map1.size() == 2);
+
+    map1.clear();
+    assert(map1.empty());
+
+    std::cout << "flat_map 基本功能测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试批量构造与批量插入：结果与 std::map 逐个插入一致，重复键保留先出现的元素
+ */
+void test_flat_map_bulk() {
+    std::cout << "===== 测试 flat_map 批量构造与插入 =====" << std::endl;
+
+    std::mt19937 rng(99);
+    std::map<int, int> ref;
+    mystl::flat_map<int, int> fm;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        for (int i = 0; i < 2000; ++i) {
+            batch.push_back(std::make_pair(static_cast<int>(rng() % 30000), round * 10000 + i));
+        }
+        fm.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        check_same(fm, ref);
+
+        // 穿插单个插入和删除
+        const int key = static_cast<int>(rng() % 30000);
+        assert(fm.insert(std::make_pair(key, -1)).second == ref.insert(std::make_pair(key, -1)).second);
+        assert(fm.erase(key + 1) == ref.erase(key + 1));
+    }
+    check_same(fm, ref);
+
+    // 从无序的键、值容器构造
+    mystl::vector<int> keys;
+    mystl::vector<std::string> values;
+    const int raw[] = {5, 3, 9, 3, 1, 5};
+    for (int k : raw) {
+        keys.push_back(k);
+        values.push_back(std::to_string(k) + "v" + std::to_string(values.size()));
+    }
+    mystl::flat_map<int, std::string> fm2(std::move(keys), std::move(values));
+    assert(fm2.size() == 4);
+    assert(fm2.at(3) == "3v1" && fm2.at(5) == "5v0");
+
+    // 有序输入直接接管容器
+    mystl::vector<int> sk{1, 2, 3};
+    mystl::vector<int> sv{10, 20, 30};
+    mystl::flat_map<int, int> fm3(mystl::sorted_unique, std::move(sk), std::move(sv));
+    assert(fm3.size() == 3 && fm3.at(2) == 20);
+    fm3.insert(mystl::sorted_unique, {{0, 0}, {2, 99}, {4, 40}});
+    assert(fm3.size() == 5 && fm3.at(2) == 20 && fm3.begin()->first == 0);
+
+    bool thrown = false;
+    try {
+        mystl::flat_map<int, int> bad(mystl::vector<int>{1, 2}, mystl::vector<int>{1});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 取出与替换底层容器
+    auto c = fm3.extract();
+    assert(fm3.empty() && c.keys.size() == 5 && c.values[4] == 40);
+    fm3.replace(std::move(c.keys), std::move(c.values));
+    assert(fm3.size() == 5 && fm3.at(4) == 40);
+
+    std::cout << "flat_map 批量构造与插入测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试复制、移动、比较与 pmr 别名
+ */
+void test_flat_map_copy_move() {
+    std::cout << "===== 测试 flat_map 复制与移动 =====" << std::endl;
+
+    mystl::flat_map<std::string, int> a{{"b", 2}, {"a", 1}, {"c", 3}};
+    mystl::flat_map<std::string, int> b(a);
+    assert(a == b);
+    b["d"] = 4;
+    assert(a != b && a < b);
+    mystl::flat_map<std::string, int> c(std::move(b));
+    assert(b.empty() && c.size() == 4);
+    a.swap(c);
+    assert(a.size() == 4 && c.size() == 3);
+    mystl::swap(a, c);
+    assert(a.size() == 3);
+    a = {{"x", 1}};
+    assert(a.size() == 1 && a.at("x") == 1);
+
+    mystl::pmr::monotonic_buffer_resource arena;
+    mystl::pmr::polymorphic_allocator<int> alloc(&arena);
+    mystl::pmr::flat_map<int, int> pm(alloc);
+    for (int i = 100; i > 0; --i) {
+        pm[i] = i * i;
+    }
+    assert(pm.size() == 100 && pm.begin()->first == 1 && pm.at(10) == 100);
+    assert(pm.keys().get_allocator().resource() == &arena);
+    assert(pm.values().get_allocator().resource() == &arena);
+
+    std::cout << "flat_map 复制与移动测试通过!" << std::endl;
+}
+
+/**
+ * @brief 移动构造未声明 noexcept、复制或移动 copies_left 次后抛出异常的值类型
+ */
+struct throwing_value {
+    static int copies;       // 累计复制次数
+    static int copies_left;  // 还允许复制的次数，小于 0 时不限
+    int v;
+
+    throwing_value(int x = 0) : v(x) {}
+    throwing_value(const throwing_value& rhs) : v(rhs.v) { count(); }
+    throwing_value(throwing_value&& rhs) : v(rhs.v) {
+        count();
+        rhs.v = -1;
+    }
+    throwing_value& operator=(const throwing_value&) = default;
+    throwing_value& operator=(throwing_value&&) = default;
+
+    // 复制和移动都计数，可能抛出异常
+    static void count() {
+        if (copies_left == 0)
+            throw std::runtime_error("throwing_value copy");
+        if (copies_left > 0)
+            --copies_left;
+        ++copies;
+    }
+};
+int throwing_value::copies = 0;
+int throwing_value::copies_left = -1;
+
+/**
+ * @brief 测试批量插入的异常安全与移动操作的 noexcept
+ */
+void test_flat_map_exception_safety() {
+    std::cout << "===== 测试 flat_map 异常安全 =====" << std::endl;
+
+    static_assert(std::is_nothrow_move_constructible<mystl::flat_map<int, std::string>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<mystl::flat_map<int, std::string>>::value, "");
+    static_assert(std::is_nothrow_move_constructible<mystl::flat_set<std::string>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<mystl::flat_set<std::string>>::value, "");
+
+    mystl::flat_map<int, throwing_value> origin;
+    for (int i = 0; i < 20; i += 2) {
+        origin.emplace(i, i);
+    }
+    std::vector<std::pair<int, throwing_value>> batch;
+    for (int i = 19; i > 0; i -= 4) {
+        batch.emplace_back(i, i);
+    }
+
+    // 统计一次批量插入的复制和移动次数，再让其中每一次分别抛出异常
+    auto expected = origin;
+    throwing_value::copies = 0;
+    expected.insert(batch.begin(), batch.end());
+    const int total = throwing_value::copies;
+    assert(total > 0 && expected.size() == origin.size() + batch.size());
+
+    for (int k = 0; k < total; ++k) {
+        auto m = origin;
+        throwing_value::copies_left = k;
+        bool thrown = false;
+        try {
+            m.insert(batch.begin(), batch.end());
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        throwing_value::copies_left = -1;
+        assert(thrown);
+        // 容器恢复原状，元素没有被移走
+        assert(m.size() == origin.size());
+        auto it = origin.begin();
+        for (const auto& kv : m) {
+            assert(kv.first == it->first && kv.second.v == it->second.v);
+            ++it;
+        }
+    }
+
+    std::cout << "flat_map 异常安全测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 flat_set
+ */
+void test_flat_set() {
+    std::cout << "===== 测试 flat_set =====" << std::endl;
+
+    mystl::flat_set<int> s1{5, 1, 3, 3, 9};
+    assert(s1.size() == 4);
+    assert(*s1.begin() == 1 && *s1.rbegin() == 9);
+    assert(s1.insert(4).second && !s1.insert(4).second);
+    assert(*s1.lower_bound(2) == 3 && *s1.upper_bound(4) == 5);
+    assert(s1.count(9) == 1 && s1.find(2) == s1.end());
+    assert(s1.erase(9) == 1 && s1.erase(9) == 0);
+    auto er = s1.equal_range(3);
+    assert(er.second - er.first == 1);
+
+    // 与 std::set 对照的批量插入
+    std::mt19937 rng(5);
+    std::set<int, std::greater<int>> ref;
+    mystl::flat_set<int, std::greater<int>> fs;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<int> batch;
+        for (int i = 0; i < 3000; ++i) {
+            batch.push_back(static_cast<int>(rng() % 50000));
+        }
+        fs.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        assert(fs.size() == ref.size());
+    }
+    auto it = fs.begin();
+    for (int v : ref) {
+        assert(*it++ == v);
+    }
+
+    mystl::flat_set<std::string> s2(mystl::sorted_unique, {"a", "b", "c"});
+    s2.insert(mystl::sorted_unique, {"b", "d"});
+    assert(s2.size() == 4 && *s2.rbegin() == "d");
+
+    auto keys = s2.extract();
+    assert(s2.empty() && keys.size() == 4);
+
+    mystl::pmr::monotonic_buffer_resource arena;
+    mystl::pmr::polymorphic_allocator<int> alloc(&arena);
+    mystl::pmr::flat_set<int> ps(alloc);
+    ps.insert({3, 1, 2});
+    assert(ps.size() == 3 && *ps.begin() == 1);
+
+    std::cout << "flat_set 测试通过!" << std::endl;
+}
+
+int main() {
+    test_flat_map_basic();
+    test_flat_map_bulk();
+    test_flat_map_copy_move();
+    test_flat_map_exception_safety();
+    test_flat_set();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,104 @@
+// test_flat_map_perf.cpp
+// 一次构建、多次查找的场景：对比 flat_map 与基于红黑树的 my::map
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <cstdlib>
+
+#include "my_flat_map.h"
+#include "../my_map/my_map.h"
+
+/**
+ * 计时辅助函数，返回 f 的执行时间（毫秒）
+ */
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+void run(size_t n) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 1 << 30);
+    std::vector<std::pair<int, int>> items(n);
+    for (size_t i = 0; i < n; ++i) {
+        items[i] = std::make_pair(dist(gen), static_cast<int>(i));
+    }
+    std::vector<int> probes(n);
+    for (size_t i = 0; i < n; ++i) {
+        probes[i] = items[gen() % n].first;
+    }
+
+    std::cout << "\n数据量: " << n << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    my::map<int, int> tree;
+    const double tree_build = time_ms([&] {
+        for (const auto& kv : items) tree.insert(kv);
+    });
+    mystl::flat_map<int, int> batched;
+    const double flat_build = time_ms([&] { batched.insert(items.begin(), items.end()); });
+    std::cout << "  构建    my::map 逐个插入: " << std::setw(8) << tree_build << " ms"
+              << "    flat_map 批量插入: " << std::setw(8) << flat_build << " ms" << std::endl;
+
+    // 逐个插入每次都要移动插入点之后的元素，数据量大时只测一部分
+    const size_t single = std::min<size_t>(n, 50000);
+    mystl::flat_map<int, int> one_by_one;
+    const double single_ms = time_ms([&] {
+        for (size_t i = 0; i < single; ++i) one_by_one.insert(items[i]);
+    });
+    std::cout << "  flat_map 逐个插入前 " << single << " 个: " << single_ms << " ms" << std::endl;
+
+    const double tree_find = time_ms([&] {
+        long long s = 0;
+        for (int k : probes) s += tree.find(k)->second;
+        g_sink += s;
+    });
+    const double flat_find = time_ms([&] {
+        long long s = 0;
+        for (int k : probes) s += batched.find(k)->second;
+        g_sink += s;
+    });
+    std::cout << "  查找    my::map: " << std::setw(8) << tree_find << " ms"
+              << "    flat_map: " << std::setw(8) << flat_find << " ms" << std::endl;
+
+    const double tree_scan = time_ms([&] {
+        long long s = 0;
+        for (int r = 0; r < 10; ++r)
+            for (auto it = tree.begin(); it != tree.end(); ++it) s += it->second;
+        g_sink += s;
+    });
+    const double flat_scan = time_ms([&] {
+        long long s = 0;
+        for (int r = 0; r < 10; ++r)
+            for (int v : batched.values()) s += v;
+        g_sink += s;
+    });
+    std::cout << "  遍历x10 my::map: " << std::setw(8) << tree_scan << " ms"
+              << "    flat_map: " << std::setw(8) << flat_scan << " ms" << std::endl;
+
+    // 红黑树节点：颜色 + 三个指针 + 元素，未计入 malloc 的块头
+    const size_t node_bytes = sizeof(void*) * 4 + sizeof(std::pair<const int, int>);
+    std::cout << "  内存    my::map 约 " << tree.size() * node_bytes / 1024 << " KB"
+              << "    flat_map " << batched.size() * (sizeof(int) * 2) / 1024 << " KB" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "===== flat_map 与 my::map 性能对比 =====" << std::endl;
+    if (argc > 1) {
+        run(std::strtoul(argv[1], nullptr, 10));
+    } else {
+        run(100000);
+        run(1000000);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef MY_FUNCTIONAL_H
+#define MY_FUNCTIONAL_H
+
+// 这个头文件包含关联容器异构查找（heterogeneous lookup）使用的透明函数对象
+// is_transparent       : 判断比较函数 / 哈希函数是否声明了 is_transparent
+// transparent_less     : 与 C++14 的 std::less<> 相同，可以比较任意两种可比较的类型
+// transparent_greater  : 与 C++14 的 std::greater<> 相同
+// transparent_equal_to : 与 C++14 的 std::equal_to<> 相同
+
+// 注释：
+//
+// 1. 容器的 find / count / lower_bound / upper_bound / equal_range / erase(key) 默认只接受 key_type，
+//    用 const char* 查找 map<string, V> 时要先构造一个临时 string，长字符串每次查找都要分配一次内存
+// 2. 有序容器的 Compare 声明了 is_transparent 时，这些函数额外接受任何能与 key_type 比较的类型；
+//    无序容器要求 Hash 和 KeyEqual 都声明 is_transparent，且 Hash 对相等的两种键给出相同的哈希值
+// 3. 项目以 C++11 编译，没有 std::less<>，因此在这里提供等价的函数对象
+
+#include <type_traits>
+#include <utility>
+
+namespace mystl
+{
+
+template <class T>
+struct transparent_void
+{
+    typedef void type;
+};
+
+/**
+ * @brief 函数对象 F 是否声明了 is_transparent 类型
+ */
+template <class F, class = void>
+struct is_transparent : public std::false_type {};
+
+template <class F>
+struct is_transparent<F, typename transparent_void<typename F::is_transparent>::type>
+    : public std::true_type {};
+
+/**
+ * @brief 透明的小于比较，两个参数可以是不同的类型
+ */
+struct transparent_less
+{
+    typedef void is_transparent;
+
+    template <class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const { return lhs < rhs; }
+};
+
+/**
+ * @brief 透明的大于比较
+ */
+struct transparent_greater
+{
+    typedef void is_transparent;
+
+    template <class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const { return rhs < lhs; }
+};
+
+/**
+ * @brief 透明的相等比较
+ */
+struct transparent_equal_to
+{
+    typedef void is_transparent;
+
+    template <class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const { return lhs == rhs; }
+};
+
+} // namespace mystl
+
+#endif // MY_FUNCTIONAL_H
@@ -0,0 +1,260 @@
+// test_functional.cpp
+// 测试透明函数对象，以及各关联容器用 const char* 做异构查找时不构造临时的键
+
+#include <iostream>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <functional>
+
+#include "my_functional.h"
+#include "../my_string/my_string.h"
+#include "../my_map/my_map.h"
+#include "../my_set/my_set.h"
+#include "../my_unordered_map/my_unordered_map.h"
+#include "../my_unordered_set/unordered_set.h"
+
+// 字符串分配内存的次数
+static size_t g_allocations = 0;
+
+/**
+ * @brief 统计分配次数的分配器，用来确认查找过程中没有构造临时字符串
+ */
+template <class T>
+struct counting_allocator {
+    typedef T value_type;
+
+    counting_allocator() noexcept {}
+    template <class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        ++g_allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <class U>
+    struct rebind { typedef counting_allocator<U> other; };
+};
+
+template <class T, class U>
+bool operator==(const counting_allocator<T>&, const counting_allocator<U>&) { return true; }
+
+template <class T, class U>
+bool operator!=(const counting_allocator<T>&, const counting_allocator<U>&) { return false; }
+
+// 超过短字符串缓冲区的长度，构造时一定分配内存
+typedef mystl::basic_string<char, mystl::char_traits<char>, counting_allocator<char>> counted_string;
+
+static const char* const kNames[] = {
+    "alpha-long-key-0000", "bravo-long-key-1111", "charlie-long-key-22",
+    "delta-long-key-3333", "echo-long-key-44444", "foxtrot-long-key-55",
+};
+static const int kCount = sizeof(kNames) / sizeof(kNames[0]);
+
+/**
+ * @brief 测试 is_transparent 与透明函数对象本身
+ */
+void test_transparent_functors() {
+    std::cout << "===== 测试透明函数对象 =====" << std::endl;
+
+    static_assert(mystl::is_transparent<mystl::transparent_less>::value, "transparent_less");
+    static_assert(mystl::is_transparent<mystl::transparent_equal_to>::value, "transparent_equal_to");
+    static_assert(mystl::is_transparent<mystl::string_hash>::value, "string_hash");
+    static_assert(!mystl::is_transparent<std::less<int>>::value, "std::less<int>");
+    static_assert(!mystl::is_transparent<std::hash<mystl::string>>::value, "std::hash");
+
+    mystl::transparent_less less;
+    mystl::transparent_greater greater;
+    mystl::transparent_equal_to equal;
+    assert(less(1, 2.5) && !less(3, 2));
+    assert(greater(3L, 2) && !greater(1, 1));
+    assert(equal(2, 2.0) && !equal(2, 3));
+
+    const mystl::string s("abc");
+    assert(less(s, "abd") && less("abb", s) && !less(s, "abc"));
+    assert(equal(s, "abc") && equal("abc", s) && !equal(s, "ab"));
+
+    // 哈希值与键的表示方式无关
+    mystl::string_hash h;
+    assert(h(s) == h("abc"));
+    assert(h(s) == std::hash<mystl::string>()(s));
+    assert(h(mystl::pmr::string("abc")) == h("abc"));
+    assert(h("abc") != h("abd"));
+
+    std::cout << "透明函数对象测试通过!" << std::endl;
+}
+
+/**
+ * @brief 有序容器：map / multimap / set / multiset
+ */
+void test_ordered_lookup() {
+    std::cout << "===== 测试有序容器的异构查找 =====" << std::endl;
+
+    my::map<counted_string, int, mystl::transparent_less> m;
+    my::multimap<counted_string, int, mystl::transparent_less> mm;
+    mystl::set<counted_string, mystl::transparent_less> s;
+    mystl::multiset<counted_string, mystl::transparent_less, std::allocator<counted_string>, true> ms;
+    for (int i = 0; i < kCount; ++i) {
+        m.emplace(kNames[i], i);
+        mm.emplace(kNames[i], i);
+        mm.emplace(kNames[i], i + 100);
+        s.emplace(kNames[i]);
+        ms.emplace(kNames[i]);
+        ms.emplace(kNames[i]);
+    }
+
+    const size_t before = g_allocations;
+    for (int i = 0; i < kCount; ++i) {
+        const char* key = kNames[i];
+        assert(m.find(key)->second == i);
+        assert(m.count(key) == 1 && mm.count(key) == 2);
+        assert(m.lower_bound(key) == m.find(key));
+        assert(m.equal_range(key).first == m.find(key));
+        assert(mm.equal_range(key).first->second == i);
+        assert(s.find(key) != s.end() && s.count(key) == 1);
+        assert(ms.count(key) == 2 && ms.rank(key) == static_cast<size_t>(2 * i));
+    }
+    assert(m.find("zulu-not-present-key") == m.end());
+    assert(m.lower_bound("a") == m.begin());
+    assert(m.upper_bound("zzz") == m.end());
+    assert(s.upper_bound("charlie-long-key-22") == s.find("delta-long-key-3333"));
+    const my::map<counted_string, int, mystl::transparent_less>& cm = m;
+    assert(cm.find("echo-long-key-44444")->second == 4);
+
+    // 删除同样不构造临时键
+    assert(m.erase("bravo-long-key-1111") == 1 && m.erase("bravo-long-key-1111") == 0);
+    assert(mm.erase("bravo-long-key-1111") == 2);
+    assert(s.erase("delta-long-key-3333") == 1);
+    assert(ms.erase("delta-long-key-3333") == 2);
+    assert(g_allocations == before);
+
+    assert(m.size() == static_cast<size_t>(kCount - 1));
+    assert(ms.size() == static_cast<size_t>(2 * kCount - 2));
+
+    // 按位置删除仍然调用迭代器版本
+    m.erase(m.begin());
+    assert(m.size() == static_cast<size_t>(kCount - 2));
+
+    std::cout << "有序容器异构查找测试通过!" << std::endl;
+}
+
+/**
+ * @brief 无序容器：unordered_map / unordered_multimap / unordered_set / unordered_multiset
+ */
+void test_unordered_lookup() {
+    std::cout << "===== 测试无序容器的异构查找 =====" << std::endl;
+
+    typedef mystl::string_hash H;
+    typedef mystl::transparent_equal_to E;
+    mystl::unordered_map<counted_string, int, H, E> m;
+    mystl::unordered_multimap<counted_string, int, H, E> mm;
+    mystl::unordered_set<counted_string, H, E> s;
+    mystl::unordered_multiset<counted_string, H, E> ms;
+    for (int i = 0; i < kCount; ++i) {
+        m.emplace(kNames[i], i);
+        mm.emplace(kNames[i], i);
+        mm.emplace(kNames[i], i);
+        s.emplace(kNames[i]);
+        ms.emplace(kNames[i]);
+        ms.emplace(kNames[i]);
+    }
+
+    const size_t before = g_allocations;
+    for (int i = 0; i < kCount; ++i) {
+        const char* key = kNames[i];
+        assert(m.find(key)->second == i);
+        assert(m.count(key) == 1 && mm.count(key) == 2);
+        auto r = mm.equal_range(key);
+        assert(std::distance(r.first, r.second) == 2);
+        assert(m.equal_range(key).first == m.find(key));
+        assert(s.find(key) != s.end() && ms.count(key) == 2);
+    }
+    assert(m.find("zulu-not-present-key") == m.end());
+    assert(s.count("") == 0);
+
+    assert(m.erase("charlie-long-key-22") == 1 && m.erase("charlie-long-key-22") == 0);
+    assert(mm.erase("charlie-long-key-22") == 2);
+    assert(s.erase("echo-long-key-44444") == 1);
+    assert(ms.erase("echo-long-key-44444") == 2);
+    assert(g_allocations == before);
+
+    assert(m.size() == static_cast<size_t>(kCount - 1));
+    assert(mm.size() == static_cast<size_t>(2 * kCount - 2));
+    assert(s.size() == static_cast<size_t>(kCount - 1));
+
+    // 非透明的默认参数仍只接受 key_type：字符串字面量先转换成 mystl::string
+    mystl::unordered_map<mystl::string, int> plain;
+    plain["hello"] = 1;
+    assert(plain.count("hello") == 1 && plain.find("world") == plain.end());
+
+    std::cout << "无序容器异构查找测试通过!" << std::endl;
+}
+
+/**
+ * @brief 异构 try_emplace / insert_or_assign：键已存在时既不构造临时键，也不分配节点
+ *
+ * 节点同样由 counting_allocator 分配，g_allocations 不变说明整个插入过程没有分配内存
+ */
+void test_heterogeneous_insert() {
+    std::cout << "===== 测试异构 try_emplace / insert_or_assign =====" << std::endl;
+
+    typedef counting_allocator<std::pair<const counted_string, int>> node_alloc;
+    my::map<counted_string, int, mystl::transparent_less, node_alloc> m;
+    mystl::unordered_map<counted_string, int, mystl::string_hash, mystl::transparent_equal_to, node_alloc> um;
+
+    // 键不存在：用 const char* 构造 key_type 并插入
+    size_t before = g_allocations;
+    for (int i = 0; i < kCount; ++i) {
+        assert(m.try_emplace(kNames[i], i).second);
+        assert(um.try_emplace(kNames[i], i).second);
+    }
+    assert(g_allocations > before);
+    assert(m.size() == static_cast<size_t>(kCount) && um.size() == static_cast<size_t>(kCount));
+
+    // 键已存在：不分配，实值不变；insert_or_assign 只赋值
+    before = g_allocations;
+    for (int i = 0; i < kCount; ++i) {
+        const char* key = kNames[i];
+        auto r = m.try_emplace(key, -1);
+        assert(!r.second && r.first->second == i);
+        auto ur = um.try_emplace(key, -1);
+        assert(!ur.second && ur.first->second == i);
+        assert(!m.insert_or_assign(key, i + 10).second && r.first->second == i + 10);
+        assert(!um.insert_or_assign(key, i + 10).second && ur.first->second == i + 10);
+
+        // 带提示的版本
+        auto hint = m.find(key);
+        assert(m.try_emplace(hint, key, -1) == hint && hint->second == i + 10);
+        assert(m.insert_or_assign(hint, key, i + 20) == hint && hint->second == i + 20);
+        auto uhint = um.find(key);
+        assert(um.try_emplace(uhint, key, -1) == uhint && uhint->second == i + 10);
+        assert(um.insert_or_assign(uhint, key, i + 20) == uhint && uhint->second == i + 20);
+    }
+    assert(g_allocations == before);
+
+    // 带提示插入新键
+    auto it = m.try_emplace(m.end(), "zulu-long-key-99999", 99);
+    assert(it->second == 99 && std::next(it) == m.end());
+    auto uit = um.insert_or_assign(um.begin(), "zulu-long-key-99999", 99);
+    assert(uit->second == 99 && um.size() == static_cast<size_t>(kCount + 1));
+
+    // 能转换为迭代器的第一个参数仍是提示
+    assert(m.try_emplace(m.begin(), kNames[0], 0)->first == kNames[0]);
+
+    std::cout << "异构 try_emplace / insert_or_assign 测试通过!" << std::endl;
+}
+
+int main() {
+    test_transparent_functors();
+    test_ordered_lookup();
+    test_unordered_lookup();
+    test_heterogeneous_insert();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
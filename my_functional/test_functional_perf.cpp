@@ -0,0 +1,82 @@
+// test_functional_perf.cpp
+// 用 const char* 查找以长字符串为键的容器：默认比较器每次查找都要构造临时的 mystl::string，
+// 透明比较器直接比较
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "my_functional.h"
+#include "../my_string/my_string.h"
+#include "../my_map/my_map.h"
+#include "../my_unordered_map/my_unordered_map.h"
+
+/**
+ * 计时辅助函数，返回 f 的执行时间（毫秒）
+ */
+template <class F>
+double time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+template <class Map>
+double lookup_ms(const Map& m, const std::vector<const char*>& probes) {
+    return time_ms([&] {
+        long long s = 0;
+        for (const char* k : probes) s += m.find(k)->second;
+        g_sink += s;
+    });
+}
+
+void run(size_t n) {
+    // 键长 32，超过短字符串缓冲区，构造临时字符串需要分配内存
+    std::vector<std::vector<char>> keys(n, std::vector<char>(33));
+    for (size_t i = 0; i < n; ++i) {
+        std::snprintf(keys[i].data(), keys[i].size(), "user-session-key-%015zu", i * 2654435761u % 1000000007u);
+    }
+    std::mt19937 gen(11);
+    std::vector<const char*> probes(n);
+    for (size_t i = 0; i < n; ++i) {
+        probes[i] = keys[gen() % n].data();
+    }
+
+    my::map<mystl::string, int> tree;
+    my::map<mystl::string, int, mystl::transparent_less> tree_t;
+    mystl::unordered_map<mystl::string, int> hash;
+    mystl::unordered_map<mystl::string, int, mystl::string_hash, mystl::transparent_equal_to> hash_t;
+    for (size_t i = 0; i < n; ++i) {
+        const int v = static_cast<int>(i);
+        tree.emplace(keys[i].data(), v);
+        tree_t.emplace(keys[i].data(), v);
+        hash.emplace(keys[i].data(), v);
+        hash_t.emplace(keys[i].data(), v);
+    }
+
+    std::cout << "\n数据量: " << n << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  my::map         构造临时键: " << std::setw(8) << lookup_ms(tree, probes) << " ms"
+              << "    透明比较: " << std::setw(8) << lookup_ms(tree_t, probes) << " ms" << std::endl;
+    std::cout << "  unordered_map   构造临时键: " << std::setw(8) << lookup_ms(hash, probes) << " ms"
+              << "    透明哈希: " << std::setw(8) << lookup_ms(hash_t, probes) << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "===== const char* 查找 mystl::string 键的性能对比 =====" << std::endl;
+    if (argc > 1) {
+        run(std::strtoul(argv[1], nullptr, 10));
+    } else {
+        run(100000);
+        run(1000000);
+    }
+    return 0;
+}
@@ -14,44 +14,18 @@
 #include <iterator>  // 添加iterator头文件，提供迭代器标签
 
 #include "../my_vector/my_vector.h"
+#include "../my_node_pool/my_node_pool.h"
+#include "../my_functional/my_functional.h"
 
-namespace mystl
-{
+// 预取一个地址所在的缓存行，不支持的编译器上什么也不做
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define MYSTL_PREFETCH(addr) ((void)0)
+#endif
 
-/**
- * @brief 哈希表节点类
- * 
- * @tparam T 节点存储的数据类型
- */
-template <class T>
-struct hashtable_node
+namespace mystl
 {
-    hashtable_node* next;   // 指向下一个节点
-    T               value;  // 存储实值
-
-    hashtable_node() = default;
-    
-    /**
-     * @brief 构造函数，传入值
-     * @param n 节点存储的值
-     */
-    hashtable_node(const T& n) : next(nullptr), value(n) {}
-
-    /**
-     * @brief 拷贝构造函数
-     * @param node 源节点
-     */
-    hashtable_node(const hashtable_node& node) : next(node.next), value(node.value) {}
-    
-    /**
-     * @brief 移动构造函数
-     * @param node 源节点
-     */
-    hashtable_node(hashtable_node&& node) : next(node.next), value(std::move(node.value))
-    {
-        node.next = nullptr;
-    }
-};
 
 /**
  * @brief value traits 实现类 - 基本类型情况
@@ -181,14 +155,118 @@ struct ht_value_traits
     }
 };
 
+/**
+ * @brief 是否在哈希表节点中缓存键的哈希值
+ * 
+ * 标量键（整数、指针、枚举等）的哈希和比较都很便宜，不缓存；其余键（如字符串）默认缓存，
+ * 重哈希和迭代器跨桶时不再调用哈希函数，遍历链表时先比较哈希值再调用 KeyEqual。
+ * 可以为自定义键类型特化此模板来打开或关闭缓存
+ * 
+ * @tparam Key 键类型
+ */
+template <class Key>
+struct ht_cache_hash_code
+    : public std::integral_constant<bool, !std::is_scalar<Key>::value> {};
+
+/**
+ * @brief 节点中缓存的哈希值，不缓存时为空基类，不占用节点空间
+ */
+template <bool Cache>
+struct ht_node_hash_code
+{
+    size_t hash_code;  // 键的完整哈希值（映射到桶之前）
+};
+
+template <>
+struct ht_node_hash_code<false> {};
+
+/**
+ * @brief 哈希表节点类
+ * 
+ * @tparam T 节点存储的数据类型
+ */
+template <class T>
+struct hashtable_node
+    : public ht_node_hash_code<ht_cache_hash_code<typename ht_value_traits<T>::key_type>::value>
+{
+    typedef ht_node_hash_code<
+        ht_cache_hash_code<typename ht_value_traits<T>::key_type>::value> hash_code_base;
+
+    hashtable_node* next;   // 指向下一个节点
+    T               value;  // 存储实值
+
+    hashtable_node() = default;
+    
+    /**
+     * @brief 构造函数，传入值
+     * @param n 节点存储的值
+     */
+    hashtable_node(const T& n) : hash_code_base(), next(nullptr), value(n) {}
+
+    /**
+     * @brief 拷贝构造函数
+     * @param node 源节点
+     */
+    hashtable_node(const hashtable_node& node)
+        : hash_code_base(node), next(node.next), value(node.value) {}
+    
+    /**
+     * @brief 移动构造函数
+     * @param node 源节点
+     */
+    hashtable_node(hashtable_node&& node)
+        : hash_code_base(node), next(node.next), value(std::move(node.value))
+    {
+        node.next = nullptr;
+    }
+};
+
+/**
+ * @brief 判断 pair 类型的首成员去掉 cv 限定后是否为 Key
+ */
+template <class Key, class P>
+struct ht_pair_first_is : public std::false_type {};
+
+template <class Key, class T1, class T2>
+struct ht_pair_first_is<Key, std::pair<T1, T2>>
+    : public std::is_same<Key, typename std::remove_cv<T1>::type> {};
+
+/**
+ * @brief 判断能否在不构造元素的情况下从 emplace 参数中取得键值
+ * 
+ * 满足时可以先查找、后分配节点，重复键值的插入不会发生任何分配：
+ * - 只有一个参数，且是完整的元素（set）或首成员为键的 pair（map）
+ * - map 有两个参数，且第一个参数就是键
+ * 
+ * @tparam Traits 值特性类
+ * @tparam Args emplace 的参数类型包
+ */
+template <class Traits, class ...Args>
+struct ht_key_extractable : public std::false_type {};
+
+template <class Traits, class A>
+struct ht_key_extractable<Traits, A>
+    : public std::integral_constant<bool, Traits::is_map
+        ? ht_pair_first_is<typename Traits::key_type, typename std::decay<A>::type>::value
+        : std::is_same<typename Traits::key_type, typename std::decay<A>::type>::value> {};
+
+template <class Traits, class A, class B>
+struct ht_key_extractable<Traits, A, B>
+    : public std::integral_constant<bool, Traits::is_map &&
+        std::is_same<typename Traits::key_type, typename std::decay<A>::type>::value> {};
+
+
 // 前向声明
-template <class T, class HashFun, class KeyEqual>
+struct ht_prime_policy;
+
+template <class T, class HashFun, class KeyEqual, class BucketPolicy = ht_prime_policy,
+          class Alloc = std::allocator<T>>
 class hashtable;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class BucketPolicy, class Alloc>
 struct ht_iterator;
 
-template <class T, class HashFun, class KeyEqual>
+template <class T, class HashFun, class KeyEqual, class BucketPolicy, class Alloc>
 struct ht_const_iterator;
 
 template <class T>
@@ -226,21 +304,23 @@ struct iterator
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型
  * @tparam KeyEqual 键相等比较函数类型
+ * @tparam BucketPolicy 桶策略
+ * @tparam Alloc 分配器类型
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 struct ht_iterator_base : public iterator<forward_iterator_tag, T>
 {
-    typedef mystl::hashtable<T, Hash, KeyEqual>         hashtable;
-    typedef ht_iterator_base<T, Hash, KeyEqual>         base;
-    typedef mystl::ht_iterator<T, Hash, KeyEqual>       iterator;
-    typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
-    typedef hashtable_node<T>*                          node_ptr;
-    typedef hashtable*                                  contain_ptr;
-    typedef const node_ptr                              const_node_ptr;
-    typedef const contain_ptr                           const_contain_ptr;
-
-    typedef size_t                                      size_type;
-    typedef ptrdiff_t                                   difference_type;
+    typedef mystl::hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>         hashtable;
+    typedef ht_iterator_base<T, Hash, KeyEqual, BucketPolicy, Alloc>         base;
+    typedef mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc>       iterator;
+    typedef mystl::ht_const_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc> const_iterator;
+    typedef hashtable_node<T>*                                        node_ptr;
+    typedef hashtable*                                                contain_ptr;
+    typedef const node_ptr                                            const_node_ptr;
+    typedef const contain_ptr                                         const_contain_ptr;
+
+    typedef size_t                                                    size_type;
+    typedef ptrdiff_t                                                 difference_type;
 
     node_ptr    node;  // 迭代器当前所指节点
     contain_ptr ht;    // 保持与容器的连结
@@ -268,11 +348,13 @@ struct ht_iterator_base : public iterator<forward_iterator_tag, T>
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型
  * @tparam KeyEqual 键相等比较函数类型
+ * @tparam BucketPolicy 桶策略
+ * @tparam Alloc 分配器类型
  */
-template <class T, class Hash, class KeyEqual>
-struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual, BucketPolicy, Alloc>
 {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, BucketPolicy, Alloc> base;
     typedef typename base::hashtable            hashtable;
     typedef typename base::iterator             iterator;
     typedef typename base::const_iterator       const_iterator;
@@ -373,7 +455,7 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
         node = node->next;
         if (node == nullptr)
         { // 如果下一个位置为空，跳到下一个 bucket 的起始处
-            auto index = ht->hash(value_traits::get_key(old->value));
+            auto index = ht->node_bucket(old);
             while (!node && ++index < ht->bucket_size_)
                 node = ht->buckets_[index];
         }
@@ -398,11 +480,13 @@ struct ht_iterator : public ht_iterator_base<T, Hash, KeyEqual>
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型
  * @tparam KeyEqual 键相等比较函数类型
+ * @tparam BucketPolicy 桶策略
+ * @tparam Alloc 分配器类型
  */
-template <class T, class Hash, class KeyEqual>
-struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual, BucketPolicy, Alloc>
 {
-    typedef ht_iterator_base<T, Hash, KeyEqual> base;
+    typedef ht_iterator_base<T, Hash, KeyEqual, BucketPolicy, Alloc> base;
     typedef typename base::hashtable            hashtable;
     typedef typename base::iterator             iterator;
     typedef typename base::const_iterator       const_iterator;
@@ -503,7 +587,7 @@ struct ht_const_iterator : public ht_iterator_base<T, Hash, KeyEqual>
         node = node->next;
         if (node == nullptr)
         { // 如果下一个位置为空，跳到下一个 bucket 的起始处
-            auto index = ht->hash(value_traits::get_key(old->value));
+            auto index = ht->node_bucket(old);
             while (!node && ++index < ht->bucket_size_)
             {
                 node = ht->buckets_[index];
@@ -782,18 +866,90 @@ inline size_t ht_next_prime(size_t n)
     return pos == last ? *(last - 1) : *pos;
 }
 
+/**
+ * @brief 桶策略：素数个桶，取模定位
+ * 默认策略，对哈希函数的质量要求低，但每次定位桶都需要一次整数除法
+ */
+struct ht_prime_policy
+{
+    /**
+     * @brief 返回不小于 n 的桶数量
+     */
+    static size_t next_size(size_t n) { return ht_next_prime(n); }
+
+    /**
+     * @brief 把哈希值映射到 [0, n) 的桶索引
+     */
+    static size_t bucket_index(size_t hash, size_t n) { return hash % n; }
+
+    /**
+     * @brief 最大桶数量
+     */
+    static size_t max_bucket_count() { return ht_prime_list[PRIME_NUM - 1]; }
+};
+
+/**
+ * @brief 桶策略：2 的幂个桶，掩码定位
+ * 用一次乘法和移位代替取模。为了避免 std::hash<int> 这类恒等哈希在低位上聚集，
+ * 先用斐波那契乘法（乘以 2^w / φ）把高位混入低位，再与掩码相与
+ */
+struct ht_power2_policy
+{
+    /**
+     * @brief 返回不小于 n 的 2 的幂，最小为 8
+     */
+    static size_t next_size(size_t n)
+    {
+        size_t size = 8;
+        while (size < n && size < max_bucket_count())
+            size <<= 1;
+        return size;
+    }
+
+    /**
+     * @brief 混合哈希值后用掩码取低位，n 必须是 2 的幂
+     */
+    static size_t bucket_index(size_t hash, size_t n) { return mix(hash) & (n - 1); }
+
+    /**
+     * @brief 最大桶数量
+     */
+    static size_t max_bucket_count() { return static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1); }
+
+    /**
+     * @brief 斐波那契 / multiply-shift 混合
+     */
+    static size_t mix(size_t h)
+    {
+#ifdef SYSTEM_64
+        h ^= h >> 32;
+        h *= 11400714819323198485ull;
+        return h ^ (h >> 32);
+#else
+        h ^= h >> 16;
+        h *= 2654435769u;
+        return h ^ (h >> 16);
+#endif
+    }
+};
+
 /**
  * @brief 哈希表模板类
  * 
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型
  * @tparam KeyEqual 键值相等判断函数类型
+ * @tparam BucketPolicy 桶策略，决定桶数量的取值和键到桶的映射方式，
+ *         默认为 ht_prime_policy，可选 ht_power2_policy
+ * @tparam Alloc 分配器类型，节点通过 rebind 后的分配器分配，
+ *         可以使用 pool_allocator 从内存池中分配节点
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 class hashtable
+    : private mystl::alloc_holder<typename std::allocator_traits<Alloc>::template rebind_alloc<hashtable_node<T>>>
 {
-    friend struct mystl::ht_iterator<T, Hash, KeyEqual>;
-    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual>;
+    friend struct mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc>;
+    friend struct mystl::ht_const_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc>;
 
 public:
     // 哈希表的型别定义
@@ -806,38 +962,54 @@ public:
 
     typedef hashtable_node<T>                           node_type;
     typedef node_type*                                  node_ptr;
-    typedef mystl::vector<node_ptr>                     bucket_type;
-
-    typedef std::allocator<T>                                allocator_type;
-    typedef std::allocator<T>                                data_allocator;
-    typedef std::allocator<node_type>                        node_allocator;
 
-    typedef typename allocator_type::pointer            pointer;
-    typedef typename allocator_type::const_pointer      const_pointer;
-    typedef typename allocator_type::reference          reference;
-    typedef typename allocator_type::const_reference    const_reference;
-    typedef typename allocator_type::size_type          size_type;
-    typedef typename allocator_type::difference_type    difference_type;
-
-    typedef mystl::ht_iterator<T, Hash, KeyEqual>       iterator;
-    typedef mystl::ht_const_iterator<T, Hash, KeyEqual> const_iterator;
+    // 节点由 Alloc rebind 得到的分配器分配，桶数组的分配器由 node_aux_allocator 选择
+    typedef Alloc                                       allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<node_type> node_allocator;
+    typedef std::allocator_traits<node_allocator>       node_alloc_traits;
+    typedef mystl::node_aux_allocator<node_allocator, node_ptr> bucket_alloc_select;
+    typedef typename bucket_alloc_select::type          bucket_allocator;
+    typedef mystl::vector<node_ptr, bucket_allocator>   bucket_type;
+
+    typedef typename std::allocator_traits<Alloc>::pointer         pointer;
+    typedef typename std::allocator_traits<Alloc>::const_pointer   const_pointer;
+    typedef value_type&                                 reference;
+    typedef const value_type&                           const_reference;
+    typedef typename std::allocator_traits<Alloc>::size_type       size_type;
+    typedef typename std::allocator_traits<Alloc>::difference_type difference_type;
+
+    typedef mystl::ht_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc>       iterator;
+    typedef mystl::ht_const_iterator<T, Hash, KeyEqual, BucketPolicy, Alloc> const_iterator;
     typedef mystl::ht_local_iterator<T>                 local_iterator;
     typedef mystl::ht_const_local_iterator<T>           const_local_iterator;
 
+    // 节点句柄：extract 摘下的节点，insert 时放回
+    typedef mystl::node_handle<node_type, Alloc, value_traits> node_handle_type;
+    typedef node_insert_return<iterator, node_handle_type>    insert_return_type;
+
     /**
      * @brief 获取分配器
      * @return 分配器对象
      */
-    allocator_type get_allocator() const { return allocator_type(); }
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
+
+    // Hash 与 KeyEqual 都声明了 is_transparent 时启用异构查找的重载，
+    // K 为任何能与 key_type 比较相等、且哈希值与相等的 key_type 一致的类型
+    template <class H, class E>
+    using enable_if_transparent = typename std::enable_if<
+        mystl::is_transparent<H>::value && mystl::is_transparent<E>::value>::type;
 
 private:
-    // 用以下六个参数来表现哈希表
-    bucket_type buckets_;     // 桶数组，每个桶是一个链表头指针
-    size_type   bucket_size_; // 桶数量
-    size_type   size_;        // 元素数量
-    float       mlf_;         // 最大负载因子
-    hasher      hash_;        // 哈希函数
-    key_equal   equal_;       // 判断键值相等的函数
+    typedef mystl::alloc_holder<node_allocator> alloc_base;  // 节点分配器
+    using alloc_base::get_alloc;
+
+    // 用以下六个参数和基类中的节点分配器来表现哈希表
+    bucket_type    buckets_;     // 桶数组，每个桶是一个链表头指针
+    size_type      bucket_size_; // 桶数量
+    size_type      size_;        // 元素数量
+    float          mlf_;         // 最大负载因子
+    hasher         hash_;        // 哈希函数
+    key_equal      equal_;       // 判断键值相等的函数
 
 private:
     /**
@@ -846,7 +1018,8 @@ private:
      * @param key2 第二个键
      * @return 是否相等
      */
-    bool is_equal(const key_type& key1, const key_type& key2)
+    template <class K>
+    bool is_equal(const key_type& key1, const K& key2)
     {
         return equal_(key1, key2);
     }
@@ -854,14 +1027,78 @@ private:
     /**
      * @brief 判断两个键是否相等（const版本）
      * @param key1 第一个键
-     * @param key2 第二个键
+     * @param key2 第二个键，异构查找时可以不是 key_type
      * @return 是否相等
      */
-    bool is_equal(const key_type& key1, const key_type& key2) const
+    template <class K>
+    bool is_equal(const key_type& key1, const K& key2) const
     {
         return equal_(key1, key2);
     }
 
+    // 缓存的哈希值，cache_tag 为 true_type 时节点中保存了键的哈希值
+    typedef std::integral_constant<bool, ht_cache_hash_code<key_type>::value> cache_tag;
+
+    size_type node_code(node_ptr np, std::true_type) const { return np->hash_code; }
+    size_type node_code(node_ptr np, std::false_type) const
+    { return hash_(value_traits::get_key(np->value)); }
+
+    /**
+     * @brief 节点中键的哈希值，有缓存时直接读取
+     */
+    size_type node_code(node_ptr np) const { return node_code(np, cache_tag()); }
+
+    /**
+     * @brief 节点当前所在的桶
+     */
+    size_type node_bucket(node_ptr np) const
+    { return BucketPolicy::bucket_index(node_code(np), bucket_size_); }
+
+    /**
+     * @brief 哈希值 code 所在的桶，桶号写入 n，返回链表的第一个节点
+     * 被移动后的表没有桶，不能取模，直接返回 nullptr，查找和删除都按"未找到"处理
+     */
+    node_ptr bucket_head(size_type code, size_type& n) const
+    {
+        if (bucket_size_ == 0)
+            return nullptr;
+        n = BucketPolicy::bucket_index(code, bucket_size_);
+        return buckets_[n];
+    }
+
+    void store_code(node_ptr np, size_type code, std::true_type) { np->hash_code = code; }
+    void store_code(node_ptr, size_type, std::false_type) {}
+
+    /**
+     * @brief 把键的哈希值记录到节点中，不缓存时什么也不做
+     */
+    void store_code(node_ptr np, size_type code) { store_code(np, code, cache_tag()); }
+
+    void copy_code(node_ptr dst, node_ptr src, std::true_type) { dst->hash_code = src->hash_code; }
+    void copy_code(node_ptr, node_ptr, std::false_type) {}
+
+    bool code_equal(node_ptr np, size_type code, std::true_type) const
+    { return np->hash_code == code; }
+    bool code_equal(node_ptr, size_type, std::false_type) const { return true; }
+
+    /**
+     * @brief 判断节点的键是否等于 key，有缓存时先比较哈希值
+     * @param np 节点
+     * @param code key 的哈希值
+     * @param key 键
+     */
+    template <class K>
+    bool node_matches(node_ptr np, size_type code, const K& key) const
+    {
+        return code_equal(np, code, cache_tag()) &&
+               is_equal(value_traits::get_key(np->value), key);
+    }
+
+    bool same_run(node_ptr a, node_ptr b, std::true_type) const
+    { return a->hash_code == b->hash_code; }
+    bool same_run(node_ptr a, node_ptr b, std::false_type) const
+    { return is_equal(value_traits::get_key(a->value), value_traits::get_key(b->value)); }
+
     /**
      * @brief 获取常量迭代器
      * @param node 节点指针
@@ -908,11 +1145,14 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键值相等判断函数
+     * @param alloc 分配器
      */
     explicit hashtable(size_type bucket_count,
                      const Hash& hash = Hash(),
-                     const KeyEqual& equal = KeyEqual())
-        : size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
+                     const KeyEqual& equal = KeyEqual(),
+                     const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc), buckets_(bucket_alloc_select::make(get_alloc())),
+          size_(0), mlf_(1.0f), hash_(hash), equal_(equal)
     {
         init(bucket_count);
     }
@@ -924,6 +1164,7 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键值相等判断函数
+     * @param alloc 分配器
      */
     template <class Iter, typename std::enable_if<
         std::is_convertible<typename std::iterator_traits<Iter>::iterator_category, 
@@ -931,8 +1172,10 @@ public:
     hashtable(Iter first, Iter last,
               size_type bucket_count,
               const Hash& hash = Hash(),
-              const KeyEqual& equal = KeyEqual())
-        : size_(std::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
+              const KeyEqual& equal = KeyEqual(),
+              const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc), buckets_(bucket_alloc_select::make(get_alloc())),
+          size_(std::distance(first, last)), mlf_(1.0f), hash_(hash), equal_(equal)
     {
         init(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))));
     }
@@ -942,7 +1185,20 @@ public:
      * @param rhs 源哈希表
      */
     hashtable(const hashtable& rhs)
-        : hash_(rhs.hash_), equal_(rhs.equal_)
+        : alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())),
+          buckets_(bucket_alloc_select::make(get_alloc())), hash_(rhs.hash_), equal_(rhs.equal_)
+    {
+        copy_init(rhs);
+    }
+
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * @param rhs 源哈希表
+     * @param alloc 分配器
+     */
+    hashtable(const hashtable& rhs, const allocator_type& alloc)
+        : alloc_base(alloc), buckets_(bucket_alloc_select::make(get_alloc())),
+          hash_(rhs.hash_), equal_(rhs.equal_)
     {
         copy_init(rhs);
     }
@@ -952,18 +1208,39 @@ public:
      * @param rhs 源哈希表
      */
     hashtable(hashtable&& rhs) noexcept
-        : bucket_size_(rhs.bucket_size_), 
+        : alloc_base(rhs.get_alloc()),
+        buckets_(std::move(rhs.buckets_)),
+        bucket_size_(rhs.bucket_size_), 
         size_(rhs.size_),
         mlf_(rhs.mlf_),
         hash_(rhs.hash_),
         equal_(rhs.equal_)
     {
-        buckets_ = std::move(rhs.buckets_);
         rhs.bucket_size_ = 0;
         rhs.size_ = 0;
         rhs.mlf_ = 0.0f;
     }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * 分配器相等时直接接管 rhs 的桶数组，否则按原有桶结构逐个移动元素
+     * @param rhs 源哈希表
+     * @param alloc 分配器
+     */
+    hashtable(hashtable&& rhs, const allocator_type& alloc)
+        : alloc_base(alloc), buckets_(bucket_alloc_select::make(get_alloc())),
+          bucket_size_(0), size_(0), mlf_(rhs.mlf_), hash_(rhs.hash_), equal_(rhs.equal_)
+    {
+        if (get_alloc() == rhs.get_alloc())
+        {
+            swap_data(rhs);
+        }
+        else
+        {
+            move_init(rhs);
+        }
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源哈希表
@@ -976,7 +1253,8 @@ public:
      * @param rhs 源哈希表
      * @return 哈希表引用
      */
-    hashtable& operator=(hashtable&& rhs) noexcept;
+    hashtable& operator=(hashtable&& rhs)
+        noexcept(node_alloc_traits::propagate_on_container_move_assignment::value);
 
     /**
      * @brief 析构函数
@@ -1065,27 +1343,79 @@ public:
      * @return 插入结果对，包含迭代器和是否插入成功的标志
      */
     template <class ...Args>
-    std::pair<iterator, bool> emplace_unique(Args&& ...args);
+    std::pair<iterator, bool> emplace_unique(Args&& ...args)
+    {
+        return emplace_unique_aux(ht_key_extractable<value_traits, Args...>(),
+                                  std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 先按键查找，键值不存在时才分配节点并用 args 就地构造元素
+     * 键值已存在时不会分配内存，也不会触发重哈希。
+     * K 不是 key_type 时要求 Hash 与 KeyEqual 都是透明的，由调用者保证
+     * @param key 用于查找的键，必须与 args 构造出的元素的键相等
+     * @param args 构造参数
+     * @return 插入结果对，包含迭代器和是否插入成功的标志
+     */
+    template <class K, class ...Args>
+    std::pair<iterator, bool> emplace_unique_key(const K& key, Args&& ...args)
+    { return emplace_unique_hashed(hash_(key), key, std::forward<Args>(args)...); }
+
+    /**
+     * @brief 使用预先计算的哈希值的 emplace_unique_key
+     * 
+     * 调用者已经算过哈希值时（如按哈希值选择分片的并发容器）不再重复计算
+     * @param code key 的哈希值，必须等于 hash_function()(key)
+     * @param key 用于查找的键，必须与 args 构造出的元素的键相等
+     * @param args 构造参数
+     * @return 插入结果对，包含迭代器和是否插入成功的标志
+     */
+    template <class K, class ...Args>
+    std::pair<iterator, bool> emplace_unique_hashed(size_type code, const K& key, Args&& ...args);
+
+    /**
+     * @brief 使用提示位置的 emplace_unique_key
+     * 
+     * 提示位置的键等于 key 时直接返回提示位置，不计算哈希值也不分配节点
+     * @param hint 提示位置
+     * @param key 用于查找的键，必须与 args 构造出的元素的键相等
+     * @param args 构造参数
+     * @return 指向新元素或已存在的相等元素的迭代器
+     */
+    template <class K, class ...Args>
+    iterator emplace_unique_key_use_hint(const_iterator hint, const K& key, Args&& ...args)
+    {
+        if (hint_matches(hint.node, key))
+            return iterator(hint.node, this);
+        return emplace_unique_key(key, std::forward<Args>(args)...).first;
+    }
 
     /**
      * @brief 使用提示位置就地构造元素，允许重复键值
+     * 
+     * 提示位置的键与新元素相等时，新节点直接链接在提示节点之后，不计算哈希值，也不遍历桶链表；
+     * 批量插入大量重复键时，把上一次返回的迭代器作为提示即可。提示不匹配时与 emplace_multi 相同
      * @param hint 提示位置
      * @param args 构造参数
      * @return 指向新元素的迭代器
      */
     template <class ...Args>
-    iterator emplace_multi_use_hint(const_iterator /*hint*/, Args&& ...args)
-    { return emplace_multi(std::forward<Args>(args)...); }
+    iterator emplace_multi_use_hint(const_iterator hint, Args&& ...args);
 
     /**
      * @brief 使用提示位置就地构造元素，不允许重复键值
+     * 
+     * 能从参数直接取得键时先与提示位置比较，相等则直接返回提示位置，不计算哈希值也不分配节点
      * @param hint 提示位置
      * @param args 构造参数
-     * @return 指向新元素的迭代器
+     * @return 指向新元素或已存在的相等元素的迭代器
      */
     template <class ...Args>
-    iterator emplace_unique_use_hint(const_iterator /*hint*/, Args&& ...args)
-    { return emplace_unique(std::forward<Args>(args)...).first; }
+    iterator emplace_unique_use_hint(const_iterator hint, Args&& ...args)
+    {
+        return emplace_unique_hint_aux(ht_key_extractable<value_traits, Args...>(), hint,
+                                       std::forward<Args>(args)...);
+    }
 
     // insert
 
@@ -1128,10 +1458,7 @@ public:
      * @return 插入结果对，包含迭代器和是否插入成功的标志
      */
     std::pair<iterator, bool> insert_unique(const value_type& value)
-    {
-        rehash_if_need(1);
-        return insert_unique_noresize(value);
-    }
+    { return emplace_unique_key(value_traits::get_key(value), value); }
 
     /**
      * @brief 插入元素，不允许重复键值（移动版本）
@@ -1147,8 +1474,8 @@ public:
      * @param value 要插入的值
      * @return 指向新元素的迭代器
      */
-    iterator insert_multi_use_hint(const_iterator /*hint*/, const value_type& value)
-    { return insert_multi(value); }
+    iterator insert_multi_use_hint(const_iterator hint, const value_type& value)
+    { return emplace_multi_use_hint(hint, value); }
 
     /**
      * @brief 使用提示位置插入元素，允许重复键值（移动版本）
@@ -1156,8 +1483,8 @@ public:
      * @param value 要插入的值
      * @return 指向新元素的迭代器
      */
-    iterator insert_multi_use_hint(const_iterator /*hint*/, value_type&& value)
-    { return emplace_multi(std::move(value)); }
+    iterator insert_multi_use_hint(const_iterator hint, value_type&& value)
+    { return emplace_multi_use_hint(hint, std::move(value)); }
 
     /**
      * @brief 使用提示位置插入元素，不允许重复键值
@@ -1165,8 +1492,12 @@ public:
      * @param value 要插入的值
      * @return 指向新元素的迭代器
      */
-    iterator insert_unique_use_hint(const_iterator /*hint*/, const value_type& value)
-    { return insert_unique(value).first; }
+    iterator insert_unique_use_hint(const_iterator hint, const value_type& value)
+    {
+        if (hint_matches(hint.node, value_traits::get_key(value)))
+            return iterator(hint.node, this);
+        return insert_unique(value).first;
+    }
 
     /**
      * @brief 使用提示位置插入元素，不允许重复键值（移动版本）
@@ -1174,8 +1505,12 @@ public:
      * @param value 要插入的值
      * @return 指向新元素的迭代器
      */
-    iterator insert_unique_use_hint(const_iterator /*hint*/, value_type&& value)
-    { return emplace_unique(std::move(value)).first; }
+    iterator insert_unique_use_hint(const_iterator hint, value_type&& value)
+    {
+        if (hint_matches(hint.node, value_traits::get_key(value)))
+            return iterator(hint.node, this);
+        return emplace_unique(std::move(value)).first;
+    }
 
     /**
      * @brief 从迭代器范围插入元素，允许重复键值
@@ -1215,20 +1550,95 @@ public:
      * @param key 要删除的键
      * @return 删除的元素数量
      */
-    size_type erase_multi(const key_type& key);
+    size_type erase_multi(const key_type& key)
+    { return erase_multi_aux(key); }
+
+    /**
+     * @brief erase_multi 的异构版本，Hash 与 KeyEqual 都透明时可用
+     */
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    size_type erase_multi(const K& key)
+    { return erase_multi_aux(key); }
 
     /**
      * @brief 删除指定键的元素，不允许重复键值
      * @param key 要删除的键
      * @return 删除的元素数量
      */
-    size_type erase_unique(const key_type& key);
+    size_type erase_unique(const key_type& key)
+    { return erase_unique_aux(key, hash_(key)); }
+
+    /**
+     * @brief 使用预先计算的哈希值删除指定键的元素
+     * @param key 要删除的键
+     * @param code key 的哈希值，必须等于 hash_function()(key)
+     * @return 删除的元素数量
+     */
+    size_type erase_unique(const key_type& key, size_type code)
+    { return erase_unique_aux(key, code); }
+
+    /**
+     * @brief erase_unique 的异构版本，Hash 与 KeyEqual 都透明时可用
+     */
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    size_type erase_unique(const K& key)
+    { return erase_unique_aux(key, hash_(key)); }
 
     /**
      * @brief 清空哈希表
      */
     void      clear();
 
+    // extract / 插入节点句柄
+
+    /**
+     * @brief 把 position 所指的节点从桶中摘下，放入节点句柄，节点不释放
+     * @param position 元素位置
+     * @return 持有该节点的句柄
+     */
+    node_handle_type extract(const_iterator position);
+
+    /**
+     * @brief 摘下一个键等于 key 的节点，不存在时返回空句柄
+     * @param key 要查找的键
+     */
+    node_handle_type extract(const key_type& key);
+
+    /**
+     * @brief 插入句柄中的节点，不允许重复键值
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素，缓存的哈希值重新计算；
+     * 不相等时把元素移动到新节点中
+     * @param nh 节点句柄，插入成功后变为空
+     * @return 插入位置、是否插入，键已存在时节点留在返回值的 node 中
+     */
+    insert_return_type insert_unique(node_handle_type&& nh);
+
+    /**
+     * @brief 插入句柄中的节点，允许重复键值
+     * @param nh 节点句柄，插入后变为空
+     * @return 指向插入的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert_multi(node_handle_type&& nh);
+
+    /**
+     * @brief 带提示的版本，键与提示位置相等时直接返回提示位置；键已存在时节点留在 nh 中
+     */
+    iterator insert_unique_use_hint(const_iterator hint, node_handle_type&& nh)
+    {
+        if (!nh.empty() && hint_matches(hint.node, value_traits::get_key(nh.value())))
+            return iterator(hint.node, this);
+        auto result = insert_unique(std::move(nh));
+        if (!result.inserted)
+            nh = std::move(result.node);
+        return result.position;
+    }
+
+    /**
+     * @brief 带提示的版本，键与提示位置相等时节点直接链接在提示节点之后
+     */
+    iterator insert_multi_use_hint(const_iterator hint, node_handle_type&& nh);
+
     /**
      * @brief 交换两个哈希表
      * @param rhs 要交换的哈希表
@@ -1242,49 +1652,137 @@ public:
      * @param key 要查找的键
      * @return 键出现的次数
      */
-    size_type count(const key_type& key) const;
+    size_type count(const key_type& key) const
+    { return count_aux(key); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    size_type count(const K& key) const
+    { return count_aux(key); }
 
     /**
      * @brief 查找键对应的元素
      * @param key 要查找的键
      * @return 指向找到元素的迭代器，如果没找到则返回end()
      */
-    iterator find(const key_type& key);
+    iterator find(const key_type& key)
+    { return iterator(find_node(key), this); }
 
     /**
      * @brief 查找键对应的元素（const版本）
      * @param key 要查找的键
      * @return 指向找到元素的常量迭代器，如果没找到则返回end()
      */
-    const_iterator find(const key_type& key) const;
+    const_iterator find(const key_type& key) const
+    { return M_cit(find_node(key)); }
 
     /**
-     * @brief 查找键对应的元素范围，允许重复键值
+     * @brief 使用预先计算的哈希值查找键对应的元素
      * @param key 要查找的键
-     * @return 元素范围对，如果没找到则返回{end(),end()}
+     * @param code key 的哈希值，必须等于 hash_function()(key)
+     * @return 指向找到元素的迭代器，如果没找到则返回end()
      */
-    std::pair<iterator, iterator> equal_range_multi(const key_type& key);
+    iterator find(const key_type& key, size_type code)
+    { return iterator(find_node(key, code), this); }
+
+    const_iterator find(const key_type& key, size_type code) const
+    { return M_cit(find_node(key, code)); }
 
     /**
-     * @brief 查找键对应的元素范围，允许重复键值（const版本）
-     * @param key 要查找的键
-     * @return 元素范围对，如果没找到则返回{end(),end()}
+     * @brief find 的异构版本：Hash 与 KeyEqual 都透明时，可以用任何能与 key_type 比较的类型查找
+     * 
+     * 例如 unordered_map<string, V, string_hash, transparent_equal_to> 用 const char* 查找时
+     * 不构造临时的 string
      */
-    std::pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const;
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    iterator find(const K& key)
+    { return iterator(find_node(key), this); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    const_iterator find(const K& key) const
+    { return M_cit(find_node(key)); }
 
     /**
-     * @brief 查找键对应的元素范围，不允许重复键值
-     * @param key 要查找的键
-     * @return 元素范围对，如果没找到则返回{end(),end()}
+     * @brief 批量查找：对 [first, last) 中的每个键依次向 out 写入 find 的结果
+     * 
+     * 每次查找要先读桶数组、再读第一个节点，两次访存在大表中几乎都是缓存缺失，逐个 find 时
+     * 这些缺失串行发生。批量查找把键分成每组 find_batch_group 个：先计算整组的哈希值并预取桶，
+     * 再读取桶头并预取第一个节点，最后才逐个比较，同一组内的访存延迟相互重叠
+     * @param first 键序列的起始位置，需要是前向迭代器，同一个键会被读取两次
+     * @param last 键序列的结束位置
+     * @param out 输出迭代器，依次接收每个键的查找结果，未找到时为 end()
+     * @return 写入结果之后的输出迭代器
      */
-    std::pair<iterator, iterator> equal_range_unique(const key_type& key);
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+    {
+        find_batch_aux(first, last, [&](node_ptr np) { *out++ = iterator(np, this); });
+        return out;
+    }
+
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    {
+        find_batch_aux(first, last, [&](node_ptr np) { *out++ = M_cit(np); });
+        return out;
+    }
+
+    /**
+     * @brief 批量判断键是否存在，对每个键向 out 写入一个 bool
+     */
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    {
+        find_batch_aux(first, last, [&](node_ptr np) { *out++ = (np != nullptr); });
+        return out;
+    }
+
+    /**
+     * @brief 查找键对应的元素范围，允许重复键值
+     * @param key 要查找的键
+     * @return 元素范围对，如果没找到则返回{end(),end()}
+     */
+    std::pair<iterator, iterator> equal_range_multi(const key_type& key)
+    { return M_range(equal_range_multi_nodes(key)); }
+
+    /**
+     * @brief 查找键对应的元素范围，允许重复键值（const版本）
+     * @param key 要查找的键
+     * @return 元素范围对，如果没找到则返回{end(),end()}
+     */
+    std::pair<const_iterator, const_iterator> equal_range_multi(const key_type& key) const
+    { return M_crange(equal_range_multi_nodes(key)); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    std::pair<iterator, iterator> equal_range_multi(const K& key)
+    { return M_range(equal_range_multi_nodes(key)); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    std::pair<const_iterator, const_iterator> equal_range_multi(const K& key) const
+    { return M_crange(equal_range_multi_nodes(key)); }
+
+    /**
+     * @brief 查找键对应的元素范围，不允许重复键值
+     * @param key 要查找的键
+     * @return 元素范围对，如果没找到则返回{end(),end()}
+     */
+    std::pair<iterator, iterator> equal_range_unique(const key_type& key)
+    { return M_range(equal_range_unique_nodes(key)); }
 
     /**
      * @brief 查找键对应的元素范围，不允许重复键值（const版本）
      * @param key 要查找的键
      * @return 元素范围对，如果没找到则返回{end(),end()}
      */
-    std::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const;
+    std::pair<const_iterator, const_iterator> equal_range_unique(const key_type& key) const
+    { return M_crange(equal_range_unique_nodes(key)); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    std::pair<iterator, iterator> equal_range_unique(const K& key)
+    { return M_range(equal_range_unique_nodes(key)); }
+
+    template <class K, class H = Hash, class = enable_if_transparent<H, KeyEqual>>
+    std::pair<const_iterator, const_iterator> equal_range_unique(const K& key) const
+    { return M_crange(equal_range_unique_nodes(key)); }
 
     // bucket interface
 
@@ -1360,7 +1858,7 @@ public:
      * @return 最大桶数量
      */
     size_type max_bucket_count() const noexcept
-    { return ht_prime_list[PRIME_NUM - 1]; }
+    { return BucketPolicy::max_bucket_count(); }
 
     /**
      * @brief 获取指定桶中的元素数量
@@ -1430,6 +1928,54 @@ public:
     key_equal key_eq() const { return equal_; }
 
 private:
+    // 查找的实现，K 为 key_type 或透明哈希函数支持的异构类型
+
+    /**
+     * @brief 查找键等于 key 的第一个节点，不存在时返回 nullptr
+     */
+    template <class K>
+    node_ptr find_node(const K& key) const
+    { return find_node(key, hash_(key)); }
+
+    /**
+     * @brief 按给定的哈希值 code 查找键等于 key 的第一个节点
+     */
+    template <class K>
+    node_ptr find_node(const K& key, size_type code) const;
+
+    template <class K>
+    size_type count_aux(const K& key) const;
+
+    /**
+     * @brief 键等于 key 的区间 [first, last)，nullptr 表示 end()
+     */
+    template <class K>
+    std::pair<node_ptr, node_ptr> equal_range_multi_nodes(const K& key) const;
+
+    template <class K>
+    std::pair<node_ptr, node_ptr> equal_range_unique_nodes(const K& key) const;
+
+    template <class K>
+    size_type erase_multi_aux(const K& key);
+
+    template <class K>
+    size_type erase_unique_aux(const K& key, size_type code);
+
+    // 批量查找每组的键数，组内的预取足以覆盖访存延迟，同时不会在用到之前被挤出缓存
+    static const size_type find_batch_group = 32;
+
+    /**
+     * @brief 批量查找的实现，按键的顺序对每个结果节点调用 sink，未找到时为 nullptr
+     */
+    template <class ForwardIter, class Sink>
+    void find_batch_aux(ForwardIter first, ForwardIter last, Sink sink) const;
+
+    std::pair<iterator, iterator> M_range(std::pair<node_ptr, node_ptr> p)
+    { return std::make_pair(iterator(p.first, this), iterator(p.second, this)); }
+
+    std::pair<const_iterator, const_iterator> M_crange(std::pair<node_ptr, node_ptr> p) const
+    { return std::make_pair(M_cit(p.first), M_cit(p.second)); }
+
     // 哈希表成员函数
 
     // init
@@ -1445,6 +1991,18 @@ private:
      */
     void copy_init(const hashtable& ht);
 
+    /**
+     * @brief 分配器不相等时移动构造的退路：按原有桶结构逐个移动元素，随后清空 ht
+     * @param ht 源哈希表
+     */
+    void move_init(hashtable& ht);
+
+    /**
+     * @brief 交换除分配器以外的全部数据成员
+     * @param rhs 另一个哈希表
+     */
+    void swap_data(hashtable& rhs) noexcept;
+
     // node
     /**
      * @brief 创建节点
@@ -1460,6 +2018,81 @@ private:
      */
     void destroy_node(node_ptr n);
 
+    /**
+     * @brief 取出句柄中的节点用于插入，分配器不相等时改为把元素移动到新节点
+     * @param nh 节点句柄
+     * @return 可以插入本表的节点
+     */
+    node_ptr take_node(node_handle_type& nh);
+
+    /**
+     * @brief 把节点从所在的桶中摘下，不释放
+     * @param p 要摘下的节点
+     * @return 节点是否在表中
+     */
+    bool unlink_node(node_ptr p);
+
+    /**
+     * @brief 只析构所有元素，元素可平凡析构时什么也不做
+     */
+    void destroy_values(std::true_type) {}
+    void destroy_values(std::false_type);
+
+    // emplace
+    /**
+     * @brief 可以直接取得键值时，走先查找后分配的路径
+     */
+    template <class A>
+    std::pair<iterator, bool> emplace_unique_aux(std::true_type, A&& a)
+    { return emplace_unique_key(value_traits::get_key(a), std::forward<A>(a)); }
+
+    template <class A, class B>
+    std::pair<iterator, bool> emplace_unique_aux(std::true_type, A&& a, B&& b)
+    { return emplace_unique_key(a, std::forward<A>(a), std::forward<B>(b)); }
+
+    /**
+     * @brief 无法直接取得键值时，先构造节点再查找
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique_aux(std::false_type, Args&& ...args);
+
+    // 带提示的插入
+    /**
+     * @brief 提示节点的键是否等于 key，提示为 end() 时返回 false
+     */
+    template <class K>
+    bool hint_matches(node_ptr hint, const K& key) const
+    { return hint != nullptr && is_equal(value_traits::get_key(hint->value), key); }
+
+    /**
+     * @brief 提示节点的键与 np 的键相等时，把 np 链接在提示节点之后并返回 true
+     * 
+     * 键相等的节点一定在同一个桶中且彼此相邻，链接在提示节点之后仍保持这一点；
+     * 相等的键哈希值也相等，缓存的哈希值直接从提示节点复制
+     */
+    bool link_after_hint(node_ptr hint, node_ptr np)
+    {
+        if (!hint_matches(hint, value_traits::get_key(np->value)))
+            return false;
+        copy_code(np, hint, cache_tag());
+        np->next = hint->next;
+        hint->next = np;
+        ++size_;
+        return true;
+    }
+
+    template <class A>
+    iterator emplace_unique_hint_aux(std::true_type, const_iterator hint, A&& a)
+    { return emplace_unique_key_use_hint(hint, value_traits::get_key(a), std::forward<A>(a)); }
+
+    template <class A, class B>
+    iterator emplace_unique_hint_aux(std::true_type, const_iterator hint, A&& a, B&& b)
+    { return emplace_unique_key_use_hint(hint, a, std::forward<A>(a), std::forward<B>(b)); }
+
+    template <class ...Args>
+    iterator emplace_unique_hint_aux(std::false_type, const_iterator, Args&& ...args)
+    { return emplace_unique_aux(std::false_type(), std::forward<Args>(args)...).first; }
+
     // hash
     /**
      * @brief 获取下一个桶数量
@@ -1498,6 +2131,19 @@ private:
     template <class InputIter>
     void copy_insert_multi(InputIter first, InputIter last, input_iterator_tag);
 
+    /**
+     * @brief 区间插入的一步：以上一个插入的节点为提示，输入中连续的相等键值不再计算哈希值
+     * @return 新插入的节点
+     */
+    template <class V>
+    node_ptr insert_multi_after(node_ptr prev, V&& value)
+    {
+        node_ptr np = create_node(std::forward<V>(value));
+        if (!link_after_hint(prev, np))
+            insert_node_multi(np);
+        return np;
+    }
+
     /**
      * @brief 从前向迭代器范围插入元素，允许重复键值
      * @param first 起始迭代器
@@ -1581,14 +2227,17 @@ private:
 /**
  * @brief 拷贝赋值运算符
  */
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>& 
-hashtable<T, Hash, KeyEqual>::operator=(const hashtable& rhs)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>& 
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::operator=(const hashtable& rhs)
 {
     if (this != &rhs)
     {
-        hashtable tmp(rhs);
-        swap(tmp);
+        // tmp 使用赋值后应当持有的分配器，与本表整体交换后由 tmp 归还原有节点
+        const bool pocca = node_alloc_traits::propagate_on_container_copy_assignment::value;
+        hashtable tmp(rhs, allocator_type(pocca ? rhs.get_alloc() : get_alloc()));
+        swap_data(tmp);
+        std::swap(get_alloc(), tmp.get_alloc());
     }
     return *this;
 }
@@ -1596,12 +2245,16 @@ hashtable<T, Hash, KeyEqual>::operator=(const hashtable& rhs)
 /**
  * @brief 移动赋值运算符
  */
-template <class T, class Hash, class KeyEqual>
-hashtable<T, Hash, KeyEqual>& 
-hashtable<T, Hash, KeyEqual>::operator=(hashtable&& rhs) noexcept
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>& 
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::operator=(hashtable&& rhs)
+    noexcept(node_alloc_traits::propagate_on_container_move_assignment::value)
 {
-    hashtable tmp(std::move(rhs));
-    swap(tmp);
+    // 分配器传播时接管 rhs 的节点，否则使用本表的分配器，分配器不相等时逐个移动元素
+    const bool pocma = node_alloc_traits::propagate_on_container_move_assignment::value;
+    hashtable tmp(std::move(rhs), allocator_type(pocma ? rhs.get_alloc() : get_alloc()));
+    swap_data(tmp);
+    std::swap(get_alloc(), tmp.get_alloc());
     return *this;
 }
 
@@ -1609,10 +2262,34 @@ hashtable<T, Hash, KeyEqual>::operator=(hashtable&& rhs) noexcept
  * @brief 就地构造元素，允许重复键值
  * 强异常安全保证
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class ...Args>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::emplace_multi(Args&& ...args)
+{
+    auto np = create_node(std::forward<Args>(args)...);
+    try
+    {
+        if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+            rehash(size_ + 1);
+    }
+    catch (...)
+    {
+        destroy_node(np);
+        throw;
+    }
+    return insert_node_multi(np);
+}
+
+/**
+ * @brief 使用提示位置就地构造元素，允许重复键值
+ * 重哈希只重新链接节点，提示节点仍然有效。强异常安全保证
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class ...Args>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::emplace_multi(Args&& ...args)
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+emplace_multi_use_hint(const_iterator hint, Args&& ...args)
 {
     auto np = create_node(std::forward<Args>(args)...);
     try
@@ -1625,17 +2302,19 @@ hashtable<T, Hash, KeyEqual>::emplace_multi(Args&& ...args)
         destroy_node(np);
         throw;
     }
+    if (link_after_hint(hint.node, np))
+        return iterator(np, this);
     return insert_node_multi(np);
 }
 
 /**
- * @brief 就地构造元素，不允许重复键值
+ * @brief 构造节点后再查找，键值不允许重复
  * 强异常安全保证
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class ...Args>
-std::pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool> 
-hashtable<T, Hash, KeyEqual>::emplace_unique(Args&& ...args)
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator, bool> 
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::emplace_unique_aux(std::false_type, Args&& ...args)
 {
     auto np = create_node(std::forward<Args>(args)...);
     try
@@ -1648,25 +2327,65 @@ hashtable<T, Hash, KeyEqual>::emplace_unique(Args&& ...args)
         destroy_node(np);
         throw;
     }
-    return insert_node_unique(np);
+    auto result = insert_node_unique(np);
+    if (!result.second)
+        destroy_node(np);
+    return result;
+}
+
+/**
+ * @brief 先查找后分配的就地构造，键值不允许重复
+ * 哈希值由调用者给出，重哈希后直接用它重新定位桶。
+ * 强异常安全保证：重哈希不改变容器内容，节点构造失败时没有副作用
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K, class ...Args>
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+emplace_unique_hashed(size_type code, const K& key, Args&& ...args)
+{
+    // 被移动后的表没有桶，先建好桶再定位
+    if (bucket_size_ == 0)
+        rehash(size_ + 1);
+    size_type n = BucketPolicy::bucket_index(code, bucket_size_);
+    for (node_ptr cur = buckets_[n]; cur; cur = cur->next)
+    {
+        if (node_matches(cur, code, key))
+            return std::make_pair(iterator(cur, this), false);
+    }
+    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+    {
+        rehash(size_ + 1);
+        n = BucketPolicy::bucket_index(code, bucket_size_);
+    }
+    // args 可能引用 key，构造节点之后不能再使用 key
+    node_ptr np = create_node(std::forward<Args>(args)...);
+    store_code(np, code);
+    np->next = buckets_[n];
+    buckets_[n] = np;
+    ++size_;
+    return std::make_pair(iterator(np, this), true);
 }
 
 /**
  * @brief 在不需要重建表格的情况下插入新节点，键值不允许重复
  */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::insert_unique_noresize(const value_type& value)
 {
-    const auto n = hash(value_traits::get_key(value));
+    const auto& key = value_traits::get_key(value);
+    const size_type code = hash_(key);
+    const auto n = BucketPolicy::bucket_index(code, bucket_size_);
     auto first = buckets_[n];
     for (auto cur = first; cur; cur = cur->next)
     {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
+        if (node_matches(cur, code, key))
             return std::make_pair(iterator(cur, this), false);
     }
     // 让新节点成为链表的第一个节点
     auto tmp = create_node(value);  
+    store_code(tmp, code);
     tmp->next = first;
     buckets_[n] = tmp;
     ++size_;
@@ -1676,17 +2395,20 @@ hashtable<T, Hash, KeyEqual>::insert_unique_noresize(const value_type& value)
 /**
  * @brief 在不需要重建表格的情况下插入新节点，键值允许重复
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::insert_multi_noresize(const value_type& value)
 {
-    const auto n = hash(value_traits::get_key(value));
+    const auto& key = value_traits::get_key(value);
+    const size_type code = hash_(key);
+    const auto n = BucketPolicy::bucket_index(code, bucket_size_);
     auto first = buckets_[n];
-    auto tmp = create_node(value);
     for (auto cur = first; cur; cur = cur->next)
     {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(value)))
+        if (node_matches(cur, code, key))
         { // 如果链表中存在相同键值的节点就马上插入，然后返回
+            auto tmp = create_node(value);
+            store_code(tmp, code);
             tmp->next = cur->next;
             cur->next = tmp;
             ++size_;
@@ -1694,6 +2416,8 @@ hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value)
         }
     }
     // 否则插入在链表头部
+    auto tmp = create_node(value);
+    store_code(tmp, code);
     tmp->next = first;
     buckets_[n] = tmp;
     ++size_;
@@ -1703,8 +2427,8 @@ hashtable<T, Hash, KeyEqual>::insert_multi_noresize(const value_type& value)
 /**
  * @brief 初始化哈希表
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::init(size_type n)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::init(size_type n)
 {
     const auto bucket_nums = next_size(n);
     try
@@ -1724,12 +2448,15 @@ void hashtable<T, Hash, KeyEqual>::init(size_type n)
 /**
  * @brief 从另一个哈希表复制初始化
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::copy_init(const hashtable& ht)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::copy_init(const hashtable& ht)
 {
-    bucket_size_ = 0;
     buckets_.reserve(ht.bucket_size_);
     buckets_.assign(ht.bucket_size_, nullptr);
+    // 先设置桶数量和元素数量，复制中途抛出异常时 clear() 能释放已复制的节点
+    bucket_size_ = ht.bucket_size_;
+    mlf_ = ht.mlf_;
+    size_ = ht.size_;
     try
     {
         for (size_type i = 0; i < ht.bucket_size_; ++i)
@@ -1738,47 +2465,77 @@ void hashtable<T, Hash, KeyEqual>::copy_init(const hashtable& ht)
             if (cur)
             { // 如果某桶存在链表
                 auto copy = create_node(cur->value);
+                copy_code(copy, cur, cache_tag());
                 buckets_[i] = copy;
                 for (auto next = cur->next; next; cur = next, next = cur->next)
                 {  //复制链表
                     copy->next = create_node(next->value);
                     copy = copy->next;
+                    copy_code(copy, next, cache_tag());
                 }
                 copy->next = nullptr;
             }
         }
-        bucket_size_ = ht.bucket_size_;
-        mlf_ = ht.mlf_;
-        size_ = ht.size_;
     }
     catch (...)
     {
         clear();
+        throw;
     }
 }
 
+/**
+ * @brief 从另一个哈希表移动初始化，节点由本表的分配器重新分配
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::move_init(hashtable& ht)
+{
+    buckets_.assign(ht.bucket_size_, nullptr);
+    bucket_size_ = ht.bucket_size_;
+    try
+    {
+        for (size_type i = 0; i < ht.bucket_size_; ++i)
+        {
+            node_ptr* tail = &buckets_[i];
+            for (node_ptr cur = ht.buckets_[i]; cur; cur = cur->next)
+            {
+                auto node = create_node(std::move(cur->value));
+                copy_code(node, cur, cache_tag());
+                *tail = node;
+                tail = &node->next;
+                ++size_;
+            }
+            *tail = nullptr;
+        }
+    }
+    catch (...)
+    {
+        clear();
+        throw;
+    }
+    ht.clear();
+}
+
 /**
  * @brief 创建节点对象
  * @param args 传递给构造函数的参数
  * @return 节点指针
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class ...Args>
-typename hashtable<T, Hash, KeyEqual>::node_ptr
-hashtable<T, Hash, KeyEqual>::create_node(Args&& ...args)
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::create_node(Args&& ...args)
 {
-    node_allocator alloc;
-    node_ptr tmp = alloc.allocate(1);
+    node_ptr tmp = node_alloc_traits::allocate(get_alloc(), 1);
     try
     {
-        data_allocator d_alloc;
-        d_alloc.construct(std::addressof(tmp->value), std::forward<Args>(args)...);
+        node_alloc_traits::construct(get_alloc(), std::addressof(tmp->value),
+                                     std::forward<Args>(args)...);
         tmp->next = nullptr;
     }
     catch (...)
     {
-        node_allocator n_alloc;
-        n_alloc.deallocate(tmp, 1);
+        node_alloc_traits::deallocate(get_alloc(), tmp, 1);
         throw;
     }
     return tmp;
@@ -1788,50 +2545,66 @@ hashtable<T, Hash, KeyEqual>::create_node(Args&& ...args)
  * @brief 销毁节点对象
  * @param node 节点指针
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::destroy_node(node_ptr node)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::destroy_node(node_ptr node)
+{
+    node_alloc_traits::destroy(get_alloc(), std::addressof(node->value));
+    node_alloc_traits::deallocate(get_alloc(), node, 1);
+}
+
+/**
+ * @brief 取出句柄中的节点，分配器不相等时把元素移动到新节点
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::take_node(node_handle_type& nh)
 {
-    data_allocator d_alloc;
-    d_alloc.destroy(std::addressof(node->value));
-    node_allocator n_alloc;
-    n_alloc.deallocate(node, 1);
+    if (node_handle_access::allocator(nh) == get_alloc())
+    {
+        node_ptr p = node_handle_access::release(nh);
+        p->next = nullptr;
+        return p;
+    }
+    node_ptr p = create_node(std::move(nh.value()));
+    nh = node_handle_type();
+    return p;
 }
 
 /**
  * @brief 获取下一个桶数量
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::next_size(size_type n) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::next_size(size_type n) const
 {
-    return ht_next_prime(n);
+    return BucketPolicy::next_size(n);
 }
 
 /**
  * @brief 计算键的哈希值并映射到指定范围
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::hash(const key_type& key, size_type n) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::hash(const key_type& key, size_type n) const
 {
-    return hash_(key) % n;
+    return BucketPolicy::bucket_index(hash_(key), n);
 }
 
 /**
  * @brief 计算键的哈希值并映射到当前桶范围
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::hash(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::hash(const key_type& key) const
 {
-    return hash_(key) % bucket_size_;
+    return BucketPolicy::bucket_index(hash_(key), bucket_size_);
 }
 
 /**
  * @brief 如有必要则重新哈希表
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::rehash_if_need(size_type n)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::rehash_if_need(size_type n)
 {
     if (static_cast<float>(size_ + n) > (float)bucket_size_ * max_load_factor())
         rehash(size_ + n);
@@ -1840,36 +2613,38 @@ void hashtable<T, Hash, KeyEqual>::rehash_if_need(size_type n)
 /**
  * @brief 从输入迭代器范围插入元素，允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 copy_insert_multi(InputIter first, InputIter last, input_iterator_tag)
 {
     rehash_if_need(std::distance(first, last));
+    node_ptr prev = nullptr;
     for (; first != last; ++first)
-        insert_multi_noresize(*first);
+        prev = insert_multi_after(prev, *first);
 }
 
 /**
  * @brief 从前向迭代器范围插入元素，允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 copy_insert_multi(ForwardIter first, ForwardIter last, forward_iterator_tag)
 {
     size_type n = std::distance(first, last);
     rehash_if_need(n);
+    node_ptr prev = nullptr;
     for (; n > 0; --n, ++first)
-        insert_multi_noresize(*first);
+        prev = insert_multi_after(prev, *first);
 }
 
 /**
  * @brief 从输入迭代器范围插入元素，不允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class InputIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 copy_insert_unique(InputIter first, InputIter last, input_iterator_tag)
 {
     rehash_if_need(std::distance(first, last));
@@ -1880,9 +2655,9 @@ copy_insert_unique(InputIter first, InputIter last, input_iterator_tag)
 /**
  * @brief 从前向迭代器范围插入元素，不允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
 template <class ForwardIter>
-void hashtable<T, Hash, KeyEqual>::
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 copy_insert_unique(ForwardIter first, ForwardIter last, forward_iterator_tag)
 {
     size_type n = std::distance(first, last);
@@ -1894,11 +2669,14 @@ copy_insert_unique(ForwardIter first, ForwardIter last, forward_iterator_tag)
 /**
  * @brief 插入一个节点，允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::insert_node_multi(node_ptr np)
 {
-    const auto n = hash(value_traits::get_key(np->value));
+    const auto& key = value_traits::get_key(np->value);
+    const size_type code = hash_(key);
+    store_code(np, code);
+    const auto n = BucketPolicy::bucket_index(code, bucket_size_);
     auto cur = buckets_[n];
     if (cur == nullptr)
     {
@@ -1908,7 +2686,7 @@ hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np)
     }
     for (; cur; cur = cur->next)
     {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
+        if (node_matches(cur, code, key))
         {
             np->next = cur->next;
             cur->next = np;
@@ -1925,11 +2703,14 @@ hashtable<T, Hash, KeyEqual>::insert_node_multi(node_ptr np)
 /**
  * @brief 插入一个节点，不允许重复键值
  */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::iterator, bool>
-hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator, bool>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::insert_node_unique(node_ptr np)
 {
-    const auto n = hash(value_traits::get_key(np->value));
+    const auto& key = value_traits::get_key(np->value);
+    const size_type code = hash_(key);
+    store_code(np, code);
+    const auto n = BucketPolicy::bucket_index(code, bucket_size_);
     auto cur = buckets_[n];
     if (cur == nullptr)
     {
@@ -1939,7 +2720,7 @@ hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
     }
     for (; cur; cur = cur->next)
     {
-        if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(np->value)))
+        if (node_matches(cur, code, key))
         {
             return std::make_pair(iterator(cur, this), false);
         }
@@ -1953,57 +2734,169 @@ hashtable<T, Hash, KeyEqual>::insert_node_unique(node_ptr np)
 /**
  * @brief 删除迭代器所指的节点
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 erase(const_iterator position)
 {
     auto p = position.node;
-    if (p)
-    {
-        const auto n = hash(value_traits::get_key(p->value));
-        auto cur = buckets_[n];
-        if (cur == p)
-        { // p 位于链表头部
-            buckets_[n] = cur->next;
-            destroy_node(cur);
+    if (p && unlink_node(p))
+        destroy_node(p);
+}
+
+/**
+ * @brief 把节点从所在的桶中摘下
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+bool hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+unlink_node(node_ptr p)
+{
+    const auto n = node_bucket(p);
+    auto cur = buckets_[n];
+    if (cur == p)
+    { // p 位于链表头部
+        buckets_[n] = cur->next;
+        --size_;
+        return true;
+    }
+    auto next = cur ? cur->next : nullptr;
+    while (next)
+    {
+        if (next == p)
+        {
+            cur->next = next->next;
             --size_;
+            return true;
         }
-        else
+        cur = next;
+        next = cur->next;
+    }
+    return false;
+}
+
+/**
+ * @brief 摘下迭代器所指的节点
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_handle_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+extract(const_iterator position)
+{
+    auto p = position.node;
+    if (p == nullptr || !unlink_node(p))
+        return node_handle_type();
+    p->next = nullptr;
+    return node_handle_access::make<node_handle_type>(p, get_alloc());
+}
+
+/**
+ * @brief 摘下一个键等于 key 的节点
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_handle_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+extract(const key_type& key)
+{
+    const size_type code = hash_(key);
+    size_type n = 0;
+    node_ptr prev = nullptr;
+    for (node_ptr cur = bucket_head(code, n); cur; prev = cur, cur = cur->next)
+    {
+        if (node_matches(cur, code, key))
         {
-            auto next = cur->next;
-            while (next)
-            {
-                if (next == p)
-                {
-                    cur->next = next->next;
-                    destroy_node(next);
-                    --size_;
-                    break;
-                }
-                else
-                {
-                    cur = next;
-                    next = cur->next;
-                }
-            }
+            if (prev)
+                prev->next = cur->next;
+            else
+                buckets_[n] = cur->next;
+            cur->next = nullptr;
+            --size_;
+            return node_handle_access::make<node_handle_type>(cur, get_alloc());
         }
     }
+    return node_handle_type();
+}
+
+/**
+ * @brief 插入句柄中的节点，键值不允许重复
+ * 与 emplace_unique_key 相同，哈希值只计算一次；键已存在时不取出节点
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::insert_return_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+insert_unique(node_handle_type&& nh)
+{
+    if (nh.empty())
+        return insert_return_type{end(), false, node_handle_type()};
+    const key_type& key = value_traits::get_key(nh.value());
+    const size_type code = hash_(key);
+    // 被移动后的表没有桶，先建好桶再定位
+    if (bucket_size_ == 0)
+        rehash(size_ + 1);
+    size_type n = BucketPolicy::bucket_index(code, bucket_size_);
+    for (node_ptr cur = buckets_[n]; cur; cur = cur->next)
+    {
+        if (node_matches(cur, code, key))
+            return insert_return_type{iterator(cur, this), false, std::move(nh)};
+    }
+    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+    {
+        rehash(size_ + 1);
+        n = BucketPolicy::bucket_index(code, bucket_size_);
+    }
+    node_ptr np = take_node(nh);
+    store_code(np, code);
+    np->next = buckets_[n];
+    buckets_[n] = np;
+    ++size_;
+    return insert_return_type{iterator(np, this), true, node_handle_type()};
+}
+
+/**
+ * @brief 插入句柄中的节点，键值允许重复
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+insert_multi(node_handle_type&& nh)
+{
+    if (nh.empty())
+        return end();
+    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+        rehash(size_ + 1);
+    return insert_node_multi(take_node(nh));
+}
+
+/**
+ * @brief 使用提示位置插入句柄中的节点，键值允许重复
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::iterator
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+insert_multi_use_hint(const_iterator hint, node_handle_type&& nh)
+{
+    if (nh.empty())
+        return end();
+    if ((float)(size_ + 1) > (float)bucket_size_ * max_load_factor())
+        rehash(size_ + 1);
+    node_ptr np = take_node(nh);
+    if (link_after_hint(hint.node, np))
+        return iterator(np, this);
+    return insert_node_multi(np);
 }
 
 /**
  * @brief 删除[first, last)内的节点
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 erase(const_iterator first, const_iterator last)
 {
     if (first.node == last.node)
         return;
     auto first_bucket = first.node 
-        ? hash(value_traits::get_key(first.node->value)) 
+        ? node_bucket(first.node) 
         : bucket_size_;
     auto last_bucket = last.node 
-        ? hash(value_traits::get_key(last.node->value))
+        ? node_bucket(last.node)
         : bucket_size_;
     if (first_bucket == last_bucket)
     { // 如果在同一个桶
@@ -2025,18 +2918,23 @@ erase(const_iterator first, const_iterator last)
 }
 
 /**
- * @brief 删除键值为key的节点
+ * @brief 删除键值为key的所有节点
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-erase_multi(const key_type& key)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+erase_multi_aux(const K& key)
 {
-    auto p = equal_range_multi(key);
-    if (p.first.node != nullptr)
+    auto p = equal_range_multi_nodes(key);
+    if (p.first != nullptr)
     {
-        erase(p.first, p.second);
-        return std::distance(p.first, p.second);
+        const_iterator first = M_cit(p.first);
+        const_iterator last = M_cit(p.second);
+        // 必须在删除之前计数，删除后区间内的节点已被释放
+        const size_type n = std::distance(first, last);
+        erase(first, last);
+        return n;
     }
     return 0;
 }
@@ -2044,16 +2942,17 @@ erase_multi(const key_type& key)
 /**
  * @brief 删除键值为key的节点
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-erase_unique(const key_type& key)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+erase_unique_aux(const K& key, size_type code)
 {
-    const auto n = hash(key);
-    auto first = buckets_[n];
+    size_type n = 0;
+    auto first = bucket_head(code, n);
     if (first)
     {
-        if (is_equal(value_traits::get_key(first->value), key))
+        if (node_matches(first, code, key))
         {
             buckets_[n] = first->next;
             destroy_node(first);
@@ -2065,7 +2964,7 @@ erase_unique(const key_type& key)
             auto next = first->next;
             while (next)
             {
-                if (is_equal(value_traits::get_key(next->value), key))
+                if (node_matches(next, code, key))
                 {
                     first->next = next->next;
                     destroy_node(next);
@@ -2083,195 +2982,203 @@ erase_unique(const key_type& key)
 /**
  * @brief 清空哈希表
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 clear()
 {
     if (size_ != 0)
     {
-        for (size_type i = 0; i < bucket_size_; ++i)
+        if (node_alloc_can_release(get_alloc()))
+        {
+            // 分配器可以整块释放节点内存：只析构元素，不逐个归还节点
+            destroy_values(std::is_trivially_destructible<value_type>());
+            std::fill(buckets_.begin(), buckets_.end(), nullptr);
+            node_alloc_release(get_alloc());
+        }
+        else
         {
-            node_ptr cur = buckets_[i];
-            while (cur != nullptr)
+            for (size_type i = 0; i < bucket_size_; ++i)
             {
-                node_ptr next = cur->next;
-                destroy_node(cur);
-                cur = next;
+                node_ptr cur = buckets_[i];
+                while (cur != nullptr)
+                {
+                    node_ptr next = cur->next;
+                    destroy_node(cur);
+                    cur = next;
+                }
+                buckets_[i] = nullptr;
             }
-            buckets_[i] = nullptr;
         }
         size_ = 0;
     }
 }
 
 /**
- * @brief 查找键值为key的节点，返回其迭代器
+ * @brief 只析构所有元素，不归还节点内存
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::iterator
-hashtable<T, Hash, KeyEqual>::
-find(const key_type& key)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+destroy_values(std::false_type)
 {
-    const auto n = hash(key);
-    node_ptr first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-    return iterator(first, this);
+    for (size_type i = 0; i < bucket_size_; ++i)
+    {
+        for (node_ptr cur = buckets_[i]; cur != nullptr; cur = cur->next)
+        {
+            node_alloc_traits::destroy(get_alloc(), std::addressof(cur->value));
+        }
+    }
 }
 
 /**
- * @brief 查找键值为key的节点，返回其迭代器
+ * @brief 查找键值为key的节点
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::const_iterator
-hashtable<T, Hash, KeyEqual>::
-find(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+find_node(const K& key, size_type code) const
 {
-    const auto n = hash(key);
-    node_ptr first = buckets_[n];
-    for (; first && !is_equal(value_traits::get_key(first->value), key); first = first->next) {}
-    return M_cit(first);
+    size_type n = 0;
+    node_ptr first = bucket_head(code, n);
+    for (; first && !node_matches(first, code, key); first = first->next) {}
+    return first;
 }
 
 /**
- * @brief 查找键值为key出现的次数
+ * @brief 批量查找：分三遍处理每组键
+ * 1. 计算哈希值和桶号，预取桶数组中的槽位
+ * 2. 读取桶头节点（此时槽位已在缓存中），预取节点
+ * 3. 沿链表比较，第一个节点已在缓存中
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
-count(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class ForwardIter, class Sink>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+find_batch_aux(ForwardIter first, ForwardIter last, Sink sink) const
 {
-    const auto n = hash(key);
-    size_type result = 0;
-    for (node_ptr cur = buckets_[n]; cur; cur = cur->next)
+    if (bucket_size_ == 0)  // 被移动后的表没有桶
     {
-        if (is_equal(value_traits::get_key(cur->value), key))
-            ++result;
+        for (; first != last; ++first)
+            sink(node_ptr(nullptr));
+        return;
     }
-    return result;
-}
-
-/**
- * @brief 查找与键值key相等的区间，返回一个pair，指向相等区间的首尾
- */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-         typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_multi(const key_type& key)
-{
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next)
+    ForwardIter keys[find_batch_group];
+    size_type   codes[find_batch_group];
+    size_type   index[find_batch_group];
+    node_ptr    heads[find_batch_group];
+    while (first != last)
     {
-        if (is_equal(value_traits::get_key(first->value), key))
-        { // 如果出现相等的键值
-            for (node_ptr second = first->next; second; second = second->next)
-            {
-                if (!is_equal(value_traits::get_key(second->value), key))
-                    return std::make_pair(iterator(first, this), iterator(second, this));
-            }
-            for (auto m = n + 1; m < bucket_size_; ++m)
-            { // 整个链表都相等，查找下一个链表出现的位置
-                if (buckets_[m])
-                    return std::make_pair(iterator(first, this), iterator(buckets_[m], this));
-            }
-            return std::make_pair(iterator(first, this), end());
+        size_type m = 0;
+        for (; m < find_batch_group && first != last; ++m, ++first)
+        {
+            keys[m] = first;
+            codes[m] = hash_(*first);
+            index[m] = BucketPolicy::bucket_index(codes[m], bucket_size_);
+            MYSTL_PREFETCH(buckets_.data() + index[m]);
+        }
+        for (size_type i = 0; i < m; ++i)
+        {
+            heads[i] = buckets_[index[i]];
+            if (heads[i] != nullptr)
+                MYSTL_PREFETCH(heads[i]);
+        }
+        for (size_type i = 0; i < m; ++i)
+        {
+            node_ptr cur = heads[i];
+            for (; cur && !node_matches(cur, codes[i], *keys[i]); cur = cur->next) {}
+            sink(cur);
         }
     }
-    return std::make_pair(end(), end());
 }
 
 /**
- * @brief 查找与键值key相等的区间，返回一个pair，指向相等区间的首尾
+ * @brief 查找键值为key出现的次数
  */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-         typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_multi(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+count_aux(const K& key) const
 {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next)
+    const size_type code = hash_(key);
+    size_type n = 0;
+    size_type result = 0;
+    for (node_ptr cur = bucket_head(code, n); cur; cur = cur->next)
     {
-        if (is_equal(value_traits::get_key(first->value), key))
-        {
-            for (node_ptr second = first->next; second; second = second->next)
-            {
-                if (!is_equal(value_traits::get_key(second->value), key))
-                    return std::make_pair(M_cit(first), M_cit(second));
-            }
-            for (auto m = n + 1; m < bucket_size_; ++m)
-            { // 整个链表都相等，查找下一个链表出现的位置
-                if (buckets_[m])
-                    return std::make_pair(M_cit(first), M_cit(buckets_[m]));
-            }
-            return std::make_pair(M_cit(first), cend());
-        }
+        if (node_matches(cur, code, key))
+            ++result;
     }
-    return std::make_pair(cend(), cend());
+    return result;
 }
 
 /**
- * @brief 查找与键值key相等的区间，返回一个pair，指向相等区间的首尾
+ * @brief 查找与键值key相等的区间，返回指向相等区间首尾的节点
  */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::iterator,
-         typename hashtable<T, Hash, KeyEqual>::iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_unique(const key_type& key)
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr,
+         typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+equal_range_multi_nodes(const K& key) const
 {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next)
+    const size_type code = hash_(key);
+    size_type n = 0;
+    for (node_ptr first = bucket_head(code, n); first; first = first->next)
     {
-        if (is_equal(value_traits::get_key(first->value), key))
-        {
-            if (first->next)
-                return std::make_pair(iterator(first, this), iterator(first->next, this));
+        if (node_matches(first, code, key))
+        { // 如果出现相等的键值
+            for (node_ptr second = first->next; second; second = second->next)
+            {
+                if (!node_matches(second, code, key))
+                    return std::make_pair(first, second);
+            }
             for (auto m = n + 1; m < bucket_size_; ++m)
             { // 整个链表都相等，查找下一个链表出现的位置
                 if (buckets_[m])
-                    return std::make_pair(iterator(first, this), iterator(buckets_[m], this));
+                    return std::make_pair(first, buckets_[m]);
             }
-            return std::make_pair(iterator(first, this), end());
+            return std::make_pair(first, node_ptr(nullptr));
         }
     }
-    return std::make_pair(end(), end());
+    return std::make_pair(node_ptr(nullptr), node_ptr(nullptr));
 }
 
 /**
- * @brief 查找与键值key相等的区间，返回一个pair，指向相等区间的首尾
+ * @brief 查找与键值key相等的区间，键值不重复，区间最多含一个节点
  */
-template <class T, class Hash, class KeyEqual>
-std::pair<typename hashtable<T, Hash, KeyEqual>::const_iterator,
-         typename hashtable<T, Hash, KeyEqual>::const_iterator>
-hashtable<T, Hash, KeyEqual>::
-equal_range_unique(const key_type& key) const
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+template <class K>
+std::pair<typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr,
+         typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::node_ptr>
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+equal_range_unique_nodes(const K& key) const
 {
-    const auto n = hash(key);
-    for (node_ptr first = buckets_[n]; first; first = first->next)
+    const size_type code = hash_(key);
+    size_type n = 0;
+    for (node_ptr first = bucket_head(code, n); first; first = first->next)
     {
-        if (is_equal(value_traits::get_key(first->value), key))
+        if (node_matches(first, code, key))
         {
             if (first->next)
-                return std::make_pair(M_cit(first), M_cit(first->next));
+                return std::make_pair(first, first->next);
             for (auto m = n + 1; m < bucket_size_; ++m)
             { // 整个链表都相等，查找下一个链表出现的位置
                 if (buckets_[m])
-                    return std::make_pair(M_cit(first), M_cit(buckets_[m]));
+                    return std::make_pair(first, buckets_[m]);
             }
-            return std::make_pair(M_cit(first), cend());
+            return std::make_pair(first, node_ptr(nullptr));
         }
     }
-    return std::make_pair(cend(), cend());
+    return std::make_pair(node_ptr(nullptr), node_ptr(nullptr));
 }
 
 /**
  * @brief 重新对元素进行一遍哈希，插入到新的位置
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 rehash(size_type count)
 {
-    auto n = ht_next_prime(count);
+    auto n = next_size(count);
     if (n > bucket_size_)
     {
         replace_bucket(n);
@@ -2288,38 +3195,38 @@ rehash(size_type count)
 
 /**
  * @brief 替换桶
+ * 直接把原有节点摘下并重新链接到新桶中，不分配新节点，也不拷贝元素
+ * 同一链表中键值相等的节点总是相邻的，因此以"相等键值段"为单位整体搬移，
+ * 每段只计算一次哈希值，并保持段内原有顺序。节点缓存了哈希值时不调用哈希函数，
+ * 分段也只比较哈希值：哈希值相同的相邻节点必然落入同一个新桶，整段搬移同样保持相对顺序
+ * 在哈希函数不抛出异常的前提下，唯一可能失败的操作是分配新桶数组，此时原表保持不变
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 replace_bucket(size_type bucket_count)
 {
-    bucket_type bucket(bucket_count);
+    bucket_type bucket(bucket_count, buckets_.get_allocator());
     if (size_ != 0)
     {
         for (size_type i = 0; i < bucket_size_; ++i)
         {
-            for (auto first = buckets_[i]; first; first = first->next)
+            node_ptr first = buckets_[i];
+            while (first)
             {
-                auto tmp = create_node(first->value);
-                const auto n = hash(value_traits::get_key(first->value), bucket_count);
-                auto f = bucket[n];
-                bool is_inserted = false;
-                for (auto cur = f; cur; cur = cur->next)
+                // 找出以 first 开头的相等键值段 [first, last]
+                node_ptr last = first;
+                while (last->next && same_run(first, last->next, cache_tag()))
                 {
-                    if (is_equal(value_traits::get_key(cur->value), value_traits::get_key(first->value)))
-                    {
-                        tmp->next = cur->next;
-                        cur->next = tmp;
-                        is_inserted = true;
-                        break;
-                    }
-                }
-                if (!is_inserted)
-                {
-                    tmp->next = f;
-                    bucket[n] = tmp;
+                    last = last->next;
                 }
+                node_ptr next = last->next;
+                // 整段插入新桶链表的头部
+                const auto n = BucketPolicy::bucket_index(node_code(first), bucket_count);
+                last->next = bucket[n];
+                bucket[n] = first;
+                first = next;
             }
+            buckets_[i] = nullptr;
         }
     }
     buckets_.swap(bucket);
@@ -2329,9 +3236,9 @@ replace_bucket(size_type bucket_count)
 /**
  * @brief 在某个桶节点的个数
  */
-template <class T, class Hash, class KeyEqual>
-typename hashtable<T, Hash, KeyEqual>::size_type
-hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+typename hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::size_type
+hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 bucket_size(size_type n) const noexcept
 {
     size_type result = 0;
@@ -2345,8 +3252,8 @@ bucket_size(size_type n) const noexcept
 /**
  * @brief 删除指定桶中 [first, last) 的节点
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 erase_bucket(size_type n, node_ptr first, node_ptr last)
 {
     auto cur = buckets_[n];
@@ -2371,8 +3278,8 @@ erase_bucket(size_type n, node_ptr first, node_ptr last)
 /**
  * @brief 删除指定桶中 [buckets_[n], last) 的节点
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 erase_bucket(size_type n, node_ptr last)
 {
     auto cur = buckets_[n];
@@ -2389,27 +3296,41 @@ erase_bucket(size_type n, node_ptr last)
 /**
  * @brief 交换两个hashtable
  */
-template <class T, class Hash, class KeyEqual>
-void hashtable<T, Hash, KeyEqual>::
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
 swap(hashtable& rhs) noexcept
 {
     if (this != &rhs)
     {
-        buckets_.swap(rhs.buckets_);
-        std::swap(bucket_size_, rhs.bucket_size_);
-        std::swap(size_, rhs.size_);
-        std::swap(mlf_, rhs.mlf_);
-        std::swap(hash_, rhs.hash_);
-        std::swap(equal_, rhs.equal_);
+        swap_data(rhs);
+        // 分配器不传播时两个哈希表的分配器必须相等
+        if (node_alloc_traits::propagate_on_container_swap::value)
+            std::swap(get_alloc(), rhs.get_alloc());
     }
 }
 
+/**
+ * @brief 交换除分配器以外的全部数据成员
+ * 桶数组的分配器随 vector::swap 按 propagate_on_container_swap 交换
+ */
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>::
+swap_data(hashtable& rhs) noexcept
+{
+    buckets_.swap(rhs.buckets_);
+    std::swap(bucket_size_, rhs.bucket_size_);
+    std::swap(size_, rhs.size_);
+    std::swap(mlf_, rhs.mlf_);
+    std::swap(hash_, rhs.hash_);
+    std::swap(equal_, rhs.equal_);
+}
+
 /**
  * @brief 全局swap
  */
-template <class T, class Hash, class KeyEqual>
-void swap(hashtable<T, Hash, KeyEqual>& lhs,
-          hashtable<T, Hash, KeyEqual>& rhs) noexcept
+template <class T, class Hash, class KeyEqual, class BucketPolicy, class Alloc>
+void swap(hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>& lhs,
+          hashtable<T, Hash, KeyEqual, BucketPolicy, Alloc>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
 #include <functional>
+#include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include "my_hashtable.h"
 
@@ -134,11 +137,235 @@ void test_hashtable_rehash()
     std::cout << "重哈希后负载因子: " << ht.load_factor() << std::endl;
 }
 
+/**
+ * @brief 测试重哈希时节点被重新链接而不是重新分配
+ */
+void test_hashtable_rehash_relink()
+{
+    std::cout << "\n===== 测试重哈希节点重链接 =====" << std::endl;
+
+    mystl::hashtable<int, std::hash<int>, std::equal_to<int>> ht(5);
+    for (int i = 0; i < 50; ++i) {
+        for (int j = 0; j < 3; ++j) {  // 每个键插入三次
+            ht.insert_multi(i);
+        }
+    }
+
+    // 记录重哈希前所有元素的地址
+    std::vector<const int*> before;
+    for (auto it = ht.begin(); it != ht.end(); ++it) {
+        before.push_back(&*it);
+    }
+    std::sort(before.begin(), before.end());
+
+    const auto old_buckets = ht.bucket_count();
+    ht.rehash(old_buckets * 4);
+    assert(ht.bucket_count() > old_buckets);
+    assert(ht.size() == 150);
+
+    // 重哈希后元素地址不变，说明没有重新分配节点
+    std::vector<const int*> after;
+    for (auto it = ht.begin(); it != ht.end(); ++it) {
+        after.push_back(&*it);
+    }
+    std::sort(after.begin(), after.end());
+    assert(before == after);
+
+    // 相等的键仍然相邻
+    for (int i = 0; i < 50; ++i) {
+        assert(ht.count(i) == 3);
+        auto range = ht.equal_range_multi(i);
+        assert(std::distance(range.first, range.second) == 3);
+        for (auto it = range.first; it != range.second; ++it) {
+            assert(*it == i);
+        }
+    }
+
+    std::cout << "重哈希后大小: " << ht.size()
+              << "，桶数量: " << ht.bucket_count() << std::endl;
+    std::cout << "重哈希节点重链接测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 2 的幂桶策略
+ */
+void test_hashtable_power2_policy()
+{
+    std::cout << "\n===== 测试 2 的幂桶策略 =====" << std::endl;
+
+    typedef mystl::hashtable<int, std::hash<int>, std::equal_to<int>,
+                             mystl::ht_power2_policy> table_type;
+    auto is_power2 = [](size_t n) { return n != 0 && (n & (n - 1)) == 0; };
+
+    table_type ht(100);
+    assert(is_power2(ht.bucket_count()));
+    assert(ht.bucket_count() >= 100);
+
+    // 步长为 2 的幂的键在恒等哈希下只落在少数低位桶上，混合后应分散开
+    for (int i = 0; i < 1000; ++i) {
+        ht.insert_unique(i * 1024);
+    }
+    assert(ht.size() == 1000);
+    assert(is_power2(ht.bucket_count()));
+    size_t max_chain = 0;
+    for (size_t i = 0; i < ht.bucket_count(); ++i) {
+        max_chain = std::max(max_chain, ht.bucket_size(i));
+    }
+    assert(max_chain < 16);
+
+    for (int i = 0; i < 1000; ++i) {
+        assert(ht.count(i * 1024) == 1);
+        assert(ht.bucket(i * 1024) < ht.bucket_count());
+    }
+    assert(ht.find(1) == ht.end());
+
+    for (int i = 0; i < 1000; i += 2) {
+        assert(ht.erase_unique(i * 1024) == 1);
+    }
+    ht.rehash(5000);
+    assert(is_power2(ht.bucket_count()));
+    assert(ht.bucket_count() >= 5000);
+    for (int i = 0; i < 1000; ++i) {
+        assert(ht.count(i * 1024) == static_cast<size_t>(i % 2));
+    }
+
+    std::cout << "最长链表: " << max_chain
+              << "，桶数量: " << ht.bucket_count() << std::endl;
+    std::cout << "2 的幂桶策略测试通过!" << std::endl;
+}
+
+/**
+ * @brief 统计调用次数的字符串哈希函数
+ */
+struct counting_string_hash
+{
+    static size_t calls;
+    size_t operator()(const std::string& s) const
+    {
+        ++calls;
+        return std::hash<std::string>()(s);
+    }
+};
+size_t counting_string_hash::calls = 0;
+
+/**
+ * @brief 测试节点中缓存的哈希值
+ */
+void test_hashtable_cached_hash()
+{
+    std::cout << "\n===== 测试节点哈希值缓存 =====" << std::endl;
+
+    // 标量键不缓存，节点大小不变
+    static_assert(!mystl::ht_cache_hash_code<int>::value, "int 键不应缓存哈希值");
+    static_assert(mystl::ht_cache_hash_code<std::string>::value, "string 键应缓存哈希值");
+    static_assert(sizeof(mystl::hashtable_node<int>) == 2 * sizeof(void*),
+                  "int 节点不应增加额外空间");
+
+    typedef mystl::hashtable<std::string, counting_string_hash,
+                             std::equal_to<std::string>> table_type;
+    table_type ht(10);
+    for (int i = 0; i < 2000; ++i) {
+        ht.insert_multi("key-" + std::to_string(i % 1000));
+    }
+
+    // 重哈希与遍历都不再调用哈希函数
+    counting_string_hash::calls = 0;
+    ht.rehash(ht.bucket_count() * 8);
+    size_t n = 0;
+    for (auto it = ht.begin(); it != ht.end(); ++it) {
+        ++n;
+    }
+    assert(n == 2000);
+    assert(counting_string_hash::calls == 0);
+
+    // 按位置删除也不调用哈希函数
+    auto range = ht.equal_range_multi("key-7");
+    counting_string_hash::calls = 0;
+    ht.erase(range.first, range.second);
+    assert(counting_string_hash::calls == 0);
+    assert(ht.count("key-7") == 0);
+
+    // 拷贝保留缓存的哈希值
+    table_type copy(ht);
+    counting_string_hash::calls = 0;
+    copy.rehash(copy.bucket_count() * 2);
+    assert(counting_string_hash::calls == 0);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string key = "key-" + std::to_string(i);
+        assert(copy.count(key) == (i == 7 ? 0u : 2u));
+        assert(ht.count(key) == copy.count(key));
+    }
+    assert(copy.erase_multi("key-8") == 2);
+    assert(copy.size() == 1996);
+
+    std::cout << "节点哈希值缓存测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试节点句柄：摘下、改键、在表之间转移
+ */
+void test_hashtable_node_handle()
+{
+    std::cout << "\n===== 测试节点句柄 =====" << std::endl;
+
+    typedef mystl::hashtable<std::pair<const int, std::string>, std::hash<int>,
+                             std::equal_to<int>> table_type;
+    table_type a(16), b(16);
+    for (int i = 0; i < 100; ++i) {
+        a.insert_unique(std::make_pair(i, std::to_string(i)));
+    }
+
+    // 改键：节点地址不变，元素不复制
+    auto nh = a.extract(7);
+    assert(nh && a.size() == 99 && a.count(7) == 0);
+    const std::string* addr = &nh.mapped();
+    nh.key() = 1007;
+    auto r = a.insert_unique(std::move(nh));
+    assert(r.inserted && nh.empty() && r.position->first == 1007);
+    assert(&r.position->second == addr && r.position->second == "7");
+
+    // 不存在的键返回空句柄，插入空句柄什么也不做
+    assert(a.extract(7).empty());
+    assert(!a.insert_unique(table_type::node_handle_type()).inserted);
+
+    // 键已存在时节点留在返回值中
+    b.insert_unique(std::make_pair(1, std::string("b")));
+    r = b.insert_unique(a.extract(a.find(1)));
+    assert(!r.inserted && r.node && r.node.mapped() == "1" && r.position->second == "b");
+    r = a.insert_unique(std::move(r.node));
+    assert(r.inserted && a.size() == 100);
+
+    // 全部转移到 b，b 会随之重哈希
+    while (!a.empty()) {
+        b.insert_multi(a.extract(a.begin()));
+    }
+    assert(b.size() == 101 && b.count(1) == 2 && b.find(1007)->second == "7");
+    for (int i = 0; i < 100; ++i) {
+        if (i != 7) {
+            assert(b.count(i) >= 1);
+        }
+    }
+
+    // 分配器不相等时移动元素到新节点
+    typedef mystl::hashtable<std::string, std::hash<std::string>, std::equal_to<std::string>,
+                             mystl::ht_prime_policy, mystl::pool_allocator<std::string>> pool_table;
+    pool_table p(16), q(16);
+    p.insert_unique(std::string("moved"));
+    auto pr = q.insert_unique(p.extract(std::string("moved")));
+    assert(pr.inserted && p.empty() && *q.find(std::string("moved")) == "moved");
+
+    std::cout << "节点句柄测试通过!" << std::endl;
+}
+
 int main()
 {
     test_hashtable_basic();
     test_hashtable_pairs();
     test_hashtable_rehash();
+    test_hashtable_rehash_relink();
+    test_hashtable_power2_policy();
+    test_hashtable_cached_hash();
+    test_hashtable_node_handle();
     
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "my_hashtable.h"
+#include "../my_unordered_map/my_unordered_map.h"
+
+/**
+ * 计时器类，用于测量一段代码的执行时间
+ */
+class Timer {
+private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
+
+public:
+    Timer() : start_time(std::chrono::high_resolution_clock::now()) {}
+
+    /**
+     * 返回从构造到现在经过的纳秒数
+     */
+    double elapsed_ns() const {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+    }
+};
+
+/**
+ * 生成随机数据
+ */
+std::vector<int> generate_random_data(size_t size, int min_val = 0, int max_val = 1000000000) {
+    std::vector<int> data(size);
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> distrib(min_val, max_val);
+    for (auto& val : data) {
+        val = distrib(gen);
+    }
+    return data;
+}
+
+/**
+ * 逐个拷贝元素到新表中，模拟旧版 replace_bucket "每个元素重新分配一个节点" 的做法
+ */
+template <class HT>
+double copy_rehash_ns(const HT& ht, size_t bucket_count) {
+    Timer timer;
+    HT fresh(bucket_count);
+    for (auto it = ht.begin(); it != ht.end(); ++it) {
+        fresh.insert_multi_noresize(*it);
+    }
+    return timer.elapsed_ns();
+}
+
+/**
+ * 测试重哈希每个元素的开销：节点重链接 vs 逐个拷贝
+ */
+template <class T, class Hash>
+void run_rehash_case(const std::string& name, const std::vector<T>& data) {
+    typedef mystl::hashtable<T, Hash, std::equal_to<T>> table_type;
+
+    table_type ht(data.size());
+    for (const auto& val : data) {
+        ht.insert_multi_noresize(val);
+    }
+    const size_t target = ht.bucket_count() * 2;
+
+    const double copy_ns = copy_rehash_ns(ht, target);
+
+    Timer timer;
+    ht.rehash(target);
+    const double relink_ns = timer.elapsed_ns();
+
+    std::cout << "  " << name << " 元素数: " << ht.size()
+              << "  逐个拷贝: " << copy_ns / ht.size() << " ns/元素"
+              << "  节点重链接: " << relink_ns / ht.size() << " ns/元素" << std::endl;
+}
+
+void test_rehash_performance() {
+    std::cout << "\n=== 测试重哈希性能 ===" << std::endl;
+
+    const std::vector<size_t> sizes = {100000, 1000000};
+    for (auto size : sizes) {
+        std::cout << "\n数据量: " << size << std::endl;
+
+        auto ints = generate_random_data(size);
+        run_rehash_case<int, std::hash<int>>("int(random)", ints);
+
+        // 大量重复键，检验相等键值段整体搬移
+        auto dups = generate_random_data(size, 0, static_cast<int>(size / 16));
+        run_rehash_case<int, std::hash<int>>("int(重复键)", dups);
+
+        std::vector<std::string> strs;
+        strs.reserve(size);
+        for (auto v : ints) {
+            strs.push_back("session-key-" + std::to_string(v));
+        }
+        run_rehash_case<std::string, std::hash<std::string>>("string", strs);
+    }
+}
+
+/**
+ * 测试查找开销：素数取模 vs 2 的幂掩码
+ */
+template <class Policy>
+double lookup_ns(const std::vector<int>& data) {
+    mystl::hashtable<int, std::hash<int>, std::equal_to<int>, Policy> ht(data.size());
+    for (auto v : data) {
+        ht.insert_unique_noresize(v);
+    }
+    size_t found = 0;
+    Timer timer;
+    for (int round = 0; round < 5; ++round) {
+        for (auto v : data) {
+            found += ht.count(v);
+        }
+    }
+    const double ns = timer.elapsed_ns();
+    if (found == 0) {
+        std::cout << "";  // 防止循环被优化掉
+    }
+    return ns / (data.size() * 5);
+}
+
+void test_bucket_policy_performance() {
+    std::cout << "\n=== 测试桶策略查找性能 ===" << std::endl;
+
+    const std::vector<size_t> sizes = {100000, 1000000};
+    for (auto size : sizes) {
+        auto data = generate_random_data(size);
+        std::cout << "  数据量: " << size
+                  << "  素数取模: " << lookup_ns<mystl::ht_prime_policy>(data) << " ns/次"
+                  << "  2的幂掩码: " << lookup_ns<mystl::ht_power2_policy>(data) << " ns/次"
+                  << std::endl;
+    }
+}
+
+/**
+ * 测试 unordered_multimap 批量载入大量重复键：不带提示、以上一次的结果为提示、区间插入
+ * 预先 reserve，只比较插入路径本身，不含重哈希
+ */
+template <class Key>
+void run_hint_case(const std::string& name, const std::vector<std::pair<Key, int>>& items) {
+    typedef mystl::unordered_multimap<Key, int> map_type;
+
+    double plain_ns = 0.0;
+    {
+        map_type m;
+        m.reserve(items.size());
+        Timer timer;
+        for (const auto& kv : items) {
+            m.insert(kv);
+        }
+        plain_ns = timer.elapsed_ns();
+    }
+    double hint_ns = 0.0;
+    {
+        map_type m;
+        m.reserve(items.size());
+        Timer timer;
+        auto hint = m.end();
+        for (const auto& kv : items) {
+            hint = m.insert(hint, kv);
+        }
+        hint_ns = timer.elapsed_ns();
+    }
+    double range_ns = 0.0;
+    {
+        map_type m;
+        m.reserve(items.size());
+        Timer timer;
+        m.insert(items.begin(), items.end());
+        range_ns = timer.elapsed_ns();
+    }
+    std::cout << "  " << name << " 元素数: " << items.size()
+              << "  不带提示: " << plain_ns / items.size() << " ns/元素"
+              << "  带提示: " << hint_ns / items.size() << " ns/元素"
+              << "  区间插入: " << range_ns / items.size() << " ns/元素" << std::endl;
+}
+
+void test_hint_insert_performance() {
+    std::cout << "\n=== 测试带提示插入性能（unordered_multimap，每个键连续重复 64 次）===" << std::endl;
+
+    const std::vector<size_t> sizes = {100000, 1000000};
+    for (auto size : sizes) {
+        std::cout << "\n数据量: " << size << std::endl;
+        auto keys = generate_random_data(size / 64);
+
+        std::vector<std::pair<int, int>> ints;
+        std::vector<std::pair<std::string, int>> strs;
+        for (size_t i = 0; i < size; ++i) {
+            const int k = keys[i / 64];
+            ints.push_back(std::make_pair(k, static_cast<int>(i)));
+            strs.push_back(std::make_pair("user-session-key-" + std::to_string(k), static_cast<int>(i)));
+        }
+        run_hint_case("int   ", ints);
+        run_hint_case("string", strs);
+    }
+}
+
+/**
+ * 模拟哈希连接的探测阶段：用大量键逐个 find 与 find_batch 查找一张大表，一半命中
+ */
+void test_find_batch_performance() {
+    std::cout << "\n=== 测试批量查找性能（unordered_map<int, int>，一半命中）===" << std::endl;
+
+    const std::vector<size_t> sizes = {100000, 1000000, 4000000};
+    for (auto size : sizes) {
+        auto keys = generate_random_data(size);
+        mystl::unordered_map<int, int> table;
+        table.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            table.emplace(keys[i], static_cast<int>(i));
+        }
+        // 偶数位置为表中的键，奇数位置大多不在表中；探测顺序随机
+        std::vector<int> probes(size);
+        std::mt19937 gen(777);
+        for (size_t i = 0; i < size; ++i) {
+            probes[i] = (i % 2 == 0) ? keys[gen() % size] : static_cast<int>(gen()) | 1;
+        }
+
+        long long sum = 0;
+        Timer single_timer;
+        for (int k : probes) {
+            auto it = table.find(k);
+            if (it != table.end()) sum += it->second;
+        }
+        const double single_ns = single_timer.elapsed_ns();
+
+        // 每次探测一段键，结果放在小缓冲区中立即消费
+        const size_t chunk = 256;
+        mystl::unordered_map<int, int>::iterator found[chunk];
+        Timer batch_timer;
+        for (size_t i = 0; i < size; i += chunk) {
+            const size_t n = std::min(chunk, size - i);
+            table.find_batch(probes.begin() + i, probes.begin() + i + n, found);
+            for (size_t j = 0; j < n; ++j) {
+                if (found[j] != table.end()) sum -= found[j]->second;
+            }
+        }
+        const double batch_ns = batch_timer.elapsed_ns();
+
+        std::cout << "  表大小: " << size
+                  << "  逐个 find: " << single_ns / size << " ns/次"
+                  << "  find_batch: " << batch_ns / size << " ns/次"
+                  << (sum == 0 ? "" : "  结果不一致!") << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "===== 哈希表性能测试 =====" << std::endl;
+
+    test_rehash_performance();
+    test_bucket_policy_performance();
+    test_hint_insert_performance();
+    test_find_batch_performance();
+
+    std::cout << "\n性能测试完成！" << std::endl;
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <chrono>
 #include "my_list.h"
+#include "../my_test_support/tagged_allocator.h"
 
 /**
  * @brief 测试计时器类
@@ -663,6 +664,60 @@ void test_exception_safety() {
     }
 }
 
+/**
+ * @brief 测试有状态分配器在拷贝、移动和交换时的传播
+ */
+void test_allocator_propagation() {
+    std::cout << "\n===== 测试有状态分配器的传播 =====" << std::endl;
+    {
+        typedef tagged_allocator<int, false> alloc;  // 不传播
+        typedef mystl::list<int, alloc> container;
+        container a(alloc(1));
+        for (int i = 0; i < 100; ++i) a.push_back(i);
+        container b(alloc(2));
+        b.push_back(-1);
+
+        container c(a);  // 拷贝构造沿用 select_on_container_copy_construction 的结果
+        assert(c.get_allocator().id == 1 && c.size() == 100);
+        container d(a, alloc(3));
+        assert(d.get_allocator().id == 3 && d == a);
+
+        b = a;  // 不传播：保留自己的分配器
+        assert(b.get_allocator().id == 2 && b.size() == 100 && b.back() == 99);
+        b = std::move(c);  // 分配器不相等：逐个移动元素
+        assert(b.get_allocator().id == 2 && b.size() == 100);
+        container e(std::move(d), alloc(4));  // 分配器不相等：逐个移动元素
+        assert(e.get_allocator().id == 4 && e.size() == 100 && e.front() == 0);
+        container f(std::move(a), alloc(1));  // 分配器相等：直接接管
+        assert(f.get_allocator().id == 1 && f.size() == 100);
+    }
+    assert(all_released<false>());
+    {
+        typedef tagged_allocator<int, true> alloc;  // 传播
+        typedef mystl::list<int, alloc> container;
+        container a(alloc(1));
+        a.push_back(1);
+        container b(alloc(2));
+        b.push_back(2);
+        b.push_back(3);
+        b = a;
+        assert(b.get_allocator().id == 1 && b.size() == 1 && b.front() == 1);
+        container c(alloc(3));
+        c.push_back(4);
+        c = std::move(b);
+        assert(c.get_allocator().id == 1 && c.size() == 1);
+        container d(alloc(4));
+        d.push_back(5);
+        d.swap(a);
+        assert(d.get_allocator().id == 1 && a.get_allocator().id == 4 && a.front() == 5);
+    }
+    assert(all_released<true>());
+
+    // 空分配器保存在基类中，不占空间
+    static_assert(sizeof(mystl::list<int>) == sizeof(void*) + sizeof(size_t), "std::allocator 不应增大 list");
+    std::cout << "有状态分配器测试通过" << std::endl;
+}
+
 int main() {
     std::cout << "===== 测试 mystl::list 实现 =====" << std::endl;
     
@@ -682,6 +737,7 @@ int main() {
     
     // 运行异常安全测试
     RUN_TEST(test_exception_safety);
+    RUN_TEST(test_allocator_propagation);
     
     std::cout << "\n所有测试通过！" << std::endl;
     
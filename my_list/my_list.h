@@ -17,6 +17,9 @@
 #include <type_traits>
 #include <utility>
 
+#include "../my_node_pool/my_node_pool.h"
+#include "../my_memory_resource/my_memory_resource.h"
+
 namespace mystl {
 
 /**
@@ -342,25 +345,30 @@ public:
  * @brief 双向链表容器类定义
  * 
  * @tparam T 元素类型
+ * @tparam Alloc 分配器类型，节点通过 rebind 后的分配器分配，
+ *         可以使用 pool_allocator 从内存池中分配节点
  */
-template <typename T>
-class list {
+template <typename T, class Alloc = std::allocator<T>>
+class list
+    : private mystl::alloc_holder<typename std::allocator_traits<Alloc>::template rebind_alloc<list_node<T>>> {
 public:
     /**
      * @brief list容器相关类型定义
      */
-    using allocator_type = std::allocator<T>;
-    using data_allocator = std::allocator<T>;
+    using allocator_type = Alloc;
+    // 节点由 Alloc rebind 得到的分配器分配；哨兵节点仍由 std::allocator 分配，
+    // 这样分配器整块释放节点内存时不会影响哨兵节点
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<list_node<T>>;
+    using node_alloc_traits = std::allocator_traits<node_allocator>;
     using base_allocator = std::allocator<list_node_base<T>>;
-    using node_allocator = std::allocator<list_node<T>>;
     
     using value_type = T;
-    using pointer = typename allocator_type::pointer;
-    using const_pointer = typename allocator_type::const_pointer;
-    using reference = typename allocator_type::reference;
-    using const_reference = typename allocator_type::const_reference;
-    using size_type = typename allocator_type::size_type;
-    using difference_type = typename allocator_type::difference_type;
+    using pointer = typename std::allocator_traits<Alloc>::pointer;
+    using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = typename std::allocator_traits<Alloc>::size_type;
+    using difference_type = typename std::allocator_traits<Alloc>::difference_type;
     
     using iterator = list_iterator<T>;
     using const_iterator = list_const_iterator<T>;
@@ -374,31 +382,38 @@ public:
      * @brief 获取分配器
      * @return 分配器对象
      */
-    allocator_type get_allocator() { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(get_alloc()); }
 
 private:
-    base_ptr node_;  // 末尾哨兵节点，表示链表的结束位置
-    size_type size_; // 链表大小
+    using alloc_base = mystl::alloc_holder<node_allocator>;  // 节点分配器
+    using alloc_base::get_alloc;
+
+    base_ptr       node_;       // 末尾哨兵节点，表示链表的结束位置
+    size_type      size_;       // 链表大小
     
 public:
     // 以下是list类的接口声明，后面会给出具体实现
     
     // 构造函数、析构函数和赋值运算符
     list();
-    explicit list(size_type n);
-    list(size_type n, const T& value);
+    explicit list(const allocator_type& alloc);
+    explicit list(size_type n, const allocator_type& alloc = allocator_type());
+    list(size_type n, const T& value, const allocator_type& alloc = allocator_type());
     
     template <class InputIter, typename = typename std::enable_if<
         std::is_convertible<typename std::iterator_traits<InputIter>::iterator_category, 
         std::input_iterator_tag>::value>::type>
-    list(InputIter first, InputIter last);
+    list(InputIter first, InputIter last, const allocator_type& alloc = allocator_type());
     
-    list(std::initializer_list<T> ilist);
+    list(std::initializer_list<T> ilist, const allocator_type& alloc = allocator_type());
     list(const list& rhs);
+    list(const list& rhs, const allocator_type& alloc);
     list(list&& rhs) noexcept;
+    list(list&& rhs, const allocator_type& alloc);
     
     list& operator=(const list& rhs);
-    list& operator=(list&& rhs) noexcept;
+    list& operator=(list&& rhs) 
+        noexcept(node_alloc_traits::propagate_on_container_move_assignment::value);
     list& operator=(std::initializer_list<T> ilist);
     
     ~list();
@@ -515,6 +530,13 @@ private:
     node_ptr create_node(Args&&... args);
     void destroy_node(node_ptr p);
     
+    // 只析构元素，不归还节点内存，元素可平凡析构时什么也不做
+    void destroy_values(std::true_type) {}
+    void destroy_values(std::false_type);
+    
+    // 分配器不相等时 splice 的退路：逐个移动元素后从 other 中删除
+    void move_from(const_iterator pos, list& other, const_iterator first, const_iterator last);
+    
     // 初始化
     void init();
     void fill_init(size_type n, const value_type& value);
@@ -544,27 +566,27 @@ private:
 };
 
 // 非成员函数
-template <typename T>
-bool operator==(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
-template <typename T>
-bool operator<(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
-template <typename T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
-template <typename T>
-bool operator>(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
-template <typename T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
-template <typename T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs);
+template <typename T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
 
 // 重载mystl的swap
-template <typename T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept;
+template <typename T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept;
 
 // 以下是list类的具体实现
 
@@ -573,18 +595,18 @@ void swap(list<T>& lhs, list<T>& rhs) noexcept;
  * @param args 构造节点值的参数
  * @return 创建的节点指针
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class... Args>
-typename list<T>::node_ptr list<T>::create_node(Args&&... args) {
-    node_ptr p = node_allocator().allocate(1);
+typename list<T, Alloc>::node_ptr list<T, Alloc>::create_node(Args&&... args) {
+    node_ptr p = node_alloc_traits::allocate(get_alloc(), 1);
     try {
         // 在节点上构造值
-        data_allocator().construct(std::addressof(p->value), std::forward<Args>(args)...);
+        node_alloc_traits::construct(get_alloc(), std::addressof(p->value), std::forward<Args>(args)...);
         p->prev = nullptr;
         p->next = nullptr;
     }
     catch (...) {
-        node_allocator().deallocate(p, 1);
+        node_alloc_traits::deallocate(get_alloc(), p, 1);
         throw;
     }
     return p;
@@ -594,17 +616,17 @@ typename list<T>::node_ptr list<T>::create_node(Args&&... args) {
  * @brief 销毁节点的辅助函数
  * @param p 要销毁的节点指针
  */
-template <typename T>
-void list<T>::destroy_node(node_ptr p) {
-    data_allocator().destroy(std::addressof(p->value));
-    node_allocator().deallocate(p, 1);
+template <typename T, class Alloc>
+void list<T, Alloc>::destroy_node(node_ptr p) {
+    node_alloc_traits::destroy(get_alloc(), std::addressof(p->value));
+    node_alloc_traits::deallocate(get_alloc(), p, 1);
 }
 
 /**
  * @brief 初始化链表哨兵节点
  */
-template <typename T>
-void list<T>::init() {
+template <typename T, class Alloc>
+void list<T, Alloc>::init() {
     node_ = base_allocator().allocate(1);
     node_->unlink();  // 初始化哨兵节点的前后指针为自身
     size_ = 0;
@@ -615,9 +637,9 @@ void list<T>::init() {
  * @param first 起始迭代器
  * @param last 结束迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter>
-void list<T>::copy_init(InputIter first, InputIter last) {
+void list<T, Alloc>::copy_init(InputIter first, InputIter last) {
     init();
     try {
         for (; first != last; ++first) {
@@ -637,8 +659,8 @@ void list<T>::copy_init(InputIter first, InputIter last) {
  * @param n 元素个数
  * @param value 元素值
  */
-template <typename T>
-void list<T>::fill_init(size_type n, const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::fill_init(size_type n, const value_type& value) {
     init();
     try {
         for (size_type i = 0; i < n; ++i) {
@@ -657,8 +679,9 @@ void list<T>::fill_init(size_type n, const value_type& value) {
  * @brief 用初始化列表构造链表
  * @param ilist 初始化列表
  */
-template <typename T>
-list<T>::list(std::initializer_list<T> ilist) {
+template <typename T, class Alloc>
+list<T, Alloc>::list(std::initializer_list<T> ilist, const allocator_type& alloc)
+    : alloc_base(alloc) {
     init();
     try {
         for (auto& item : ilist) {
@@ -676,17 +699,29 @@ list<T>::list(std::initializer_list<T> ilist) {
 /**
  * @brief 默认构造函数
  */
-template <typename T>
-list<T>::list() {
+template <typename T, class Alloc>
+list<T, Alloc>::list() {
+    init();
+}
+
+/**
+ * @brief 使用指定分配器构造空链表
+ * @param alloc 分配器
+ */
+template <typename T, class Alloc>
+list<T, Alloc>::list(const allocator_type& alloc)
+    : alloc_base(alloc) {
     init();
 }
 
 /**
  * @brief 指定大小的构造函数，使用默认值填充
  * @param n 元素个数
+ * @param alloc 分配器
  */
-template <typename T>
-list<T>::list(size_type n) {
+template <typename T, class Alloc>
+list<T, Alloc>::list(size_type n, const allocator_type& alloc)
+    : alloc_base(alloc) {
     fill_init(n, value_type());
 }
 
@@ -694,9 +729,11 @@ list<T>::list(size_type n) {
  * @brief 指定大小和值的构造函数
  * @param n 元素个数
  * @param value 填充值
+ * @param alloc 分配器
  */
-template <typename T>
-list<T>::list(size_type n, const T& value) {
+template <typename T, class Alloc>
+list<T, Alloc>::list(size_type n, const T& value, const allocator_type& alloc)
+    : alloc_base(alloc) {
     fill_init(n, value);
 }
 
@@ -704,10 +741,12 @@ list<T>::list(size_type n, const T& value) {
  * @brief 使用迭代器范围的构造函数
  * @param first 起始迭代器
  * @param last 结束迭代器
+ * @param alloc 分配器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter, typename>
-list<T>::list(InputIter first, InputIter last) {
+list<T, Alloc>::list(InputIter first, InputIter last, const allocator_type& alloc)
+    : alloc_base(alloc) {
     copy_init(first, last);
 }
 
@@ -715,8 +754,20 @@ list<T>::list(InputIter first, InputIter last) {
  * @brief 拷贝构造函数
  * @param rhs 源list
  */
-template <typename T>
-list<T>::list(const list& rhs) {
+template <typename T, class Alloc>
+list<T, Alloc>::list(const list& rhs)
+    : alloc_base(node_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+    copy_init(rhs.cbegin(), rhs.cend());
+}
+
+/**
+ * @brief 使用指定分配器的拷贝构造函数
+ * @param rhs 源list
+ * @param alloc 分配器
+ */
+template <typename T, class Alloc>
+list<T, Alloc>::list(const list& rhs, const allocator_type& alloc)
+    : alloc_base(alloc) {
     copy_init(rhs.cbegin(), rhs.cend());
 }
 
@@ -724,17 +775,30 @@ list<T>::list(const list& rhs) {
  * @brief 移动构造函数
  * @param rhs 源list（右值引用）
  */
-template <typename T>
-list<T>::list(list&& rhs) noexcept : node_(rhs.node_), size_(rhs.size_) {
+template <typename T, class Alloc>
+list<T, Alloc>::list(list&& rhs) noexcept
+    : alloc_base(rhs.get_alloc()), node_(rhs.node_), size_(rhs.size_) {
     // 初始化一个空的哨兵节点给rhs，而不是设为nullptr
     rhs.init();
 }
 
+/**
+ * @brief 使用指定分配器的移动构造函数，分配器不相等时逐个移动元素
+ * @param rhs 源list（右值引用）
+ * @param alloc 分配器
+ */
+template <typename T, class Alloc>
+list<T, Alloc>::list(list&& rhs, const allocator_type& alloc)
+    : alloc_base(alloc) {
+    init();
+    splice(end(), rhs);
+}
+
 /**
  * @brief 析构函数
  */
-template <typename T>
-list<T>::~list() {
+template <typename T, class Alloc>
+list<T, Alloc>::~list() {
     clear();
     base_allocator().deallocate(node_, 1);
     node_ = nullptr;
@@ -746,8 +810,8 @@ list<T>::~list() {
  * @param node 要连接的节点
  * @return 指向新连接节点的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::link_iter_node(const_iterator pos, base_ptr node) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::link_iter_node(const_iterator pos, base_ptr node) {
     if (pos == node_->next) {
         link_nodes_at_front(node, node);
     }
@@ -766,8 +830,8 @@ typename list<T>::iterator list<T>::link_iter_node(const_iterator pos, base_ptr
  * @param first 要连接范围的开始节点
  * @param last 要连接范围的结束节点
  */
-template <typename T>
-void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
+template <typename T, class Alloc>
+void list<T, Alloc>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
     pos->prev->next = first;
     first->prev = pos->prev;
     pos->prev = last;
@@ -779,8 +843,8 @@ void list<T>::link_nodes(base_ptr pos, base_ptr first, base_ptr last) {
  * @param first 要连接范围的开始节点
  * @param last 要连接范围的结束节点
  */
-template <typename T>
-void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
+template <typename T, class Alloc>
+void list<T, Alloc>::link_nodes_at_front(base_ptr first, base_ptr last) {
     first->prev = node_;
     last->next = node_->next;
     last->next->prev = last;
@@ -792,8 +856,8 @@ void list<T>::link_nodes_at_front(base_ptr first, base_ptr last) {
  * @param first 要连接范围的开始节点
  * @param last 要连接范围的结束节点
  */
-template <typename T>
-void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
+template <typename T, class Alloc>
+void list<T, Alloc>::link_nodes_at_back(base_ptr first, base_ptr last) {
     last->next = node_;
     first->prev = node_->prev;
     first->prev->next = first;
@@ -805,8 +869,8 @@ void list<T>::link_nodes_at_back(base_ptr first, base_ptr last) {
  * @param first 要断开范围的开始节点
  * @param last 要断开范围的结束节点
  */
-template <typename T>
-void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
+template <typename T, class Alloc>
+void list<T, Alloc>::unlink_nodes(base_ptr first, base_ptr last) {
     first->prev->next = last->next;
     last->next->prev = first->prev;
 }
@@ -816,9 +880,16 @@ void list<T>::unlink_nodes(base_ptr first, base_ptr last) {
  * @param rhs 源链表
  * @return 当前链表的引用
  */
-template <typename T>
-list<T>& list<T>::operator=(const list& rhs) {
+template <typename T, class Alloc>
+list<T, Alloc>& list<T, Alloc>::operator=(const list& rhs) {
     if (this != &rhs) {
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value) {
+            // 节点必须由分配它的分配器归还，换分配器之前先释放全部节点
+            if (get_alloc() != rhs.get_alloc()) {
+                clear();
+            }
+            get_alloc() = rhs.get_alloc();
+        }
         assign(rhs.begin(), rhs.end());
     }
     return *this;
@@ -829,9 +900,13 @@ list<T>& list<T>::operator=(const list& rhs) {
  * @param rhs 源链表（右值引用）
  * @return 当前链表的引用
  */
-template <typename T>
-list<T>& list<T>::operator=(list&& rhs) noexcept {
+template <typename T, class Alloc>
+list<T, Alloc>& list<T, Alloc>::operator=(list&& rhs)
+    noexcept(node_alloc_traits::propagate_on_container_move_assignment::value) {
     clear();
+    if (node_alloc_traits::propagate_on_container_move_assignment::value) {
+        get_alloc() = rhs.get_alloc();
+    }
     splice(end(), rhs);
     return *this;
 }
@@ -841,9 +916,9 @@ list<T>& list<T>::operator=(list&& rhs) noexcept {
  * @param ilist 初始化列表
  * @return 当前链表的引用
  */
-template <typename T>
-list<T>& list<T>::operator=(std::initializer_list<T> ilist) {
-    list tmp(ilist.begin(), ilist.end());
+template <typename T, class Alloc>
+list<T, Alloc>& list<T, Alloc>::operator=(std::initializer_list<T> ilist) {
+    list tmp(ilist.begin(), ilist.end(), get_allocator());
     swap(tmp);
     return *this;
 }
@@ -852,8 +927,8 @@ list<T>& list<T>::operator=(std::initializer_list<T> ilist) {
  * @brief 指向链表第一个元素的迭代器
  * @return 开始迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::begin() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::begin() noexcept {
     return node_->next;
 }
 
@@ -861,8 +936,8 @@ typename list<T>::iterator list<T>::begin() noexcept {
  * @brief 指向链表第一个元素的常量迭代器
  * @return 常量开始迭代器
  */
-template <typename T>
-typename list<T>::const_iterator list<T>::begin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::begin() const noexcept {
     return node_->next;
 }
 
@@ -870,8 +945,8 @@ typename list<T>::const_iterator list<T>::begin() const noexcept {
  * @brief 指向链表尾部的迭代器（超出末尾）
  * @return 结束迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::end() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::end() noexcept {
     return node_;
 }
 
@@ -879,8 +954,8 @@ typename list<T>::iterator list<T>::end() noexcept {
  * @brief 指向链表尾部的常量迭代器（超出末尾）
  * @return 常量结束迭代器
  */
-template <typename T>
-typename list<T>::const_iterator list<T>::end() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::end() const noexcept {
     return node_;
 }
 
@@ -888,8 +963,8 @@ typename list<T>::const_iterator list<T>::end() const noexcept {
  * @brief 反向迭代器的起始位置（对应容器的最后一个元素）
  * @return 反向开始迭代器
  */
-template <typename T>
-typename list<T>::reverse_iterator list<T>::rbegin() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rbegin() noexcept {
     return reverse_iterator(end());
 }
 
@@ -897,8 +972,8 @@ typename list<T>::reverse_iterator list<T>::rbegin() noexcept {
  * @brief 常量反向迭代器的起始位置
  * @return 常量反向开始迭代器
  */
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::rbegin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::rbegin() const noexcept {
     return const_reverse_iterator(end());
 }
 
@@ -906,8 +981,8 @@ typename list<T>::const_reverse_iterator list<T>::rbegin() const noexcept {
  * @brief 反向迭代器的结束位置（对应容器的第一个元素之前）
  * @return 反向结束迭代器
  */
-template <typename T>
-typename list<T>::reverse_iterator list<T>::rend() noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::reverse_iterator list<T, Alloc>::rend() noexcept {
     return reverse_iterator(begin());
 }
 
@@ -915,8 +990,8 @@ typename list<T>::reverse_iterator list<T>::rend() noexcept {
  * @brief 常量反向迭代器的结束位置
  * @return 常量反向结束迭代器
  */
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::rend() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::rend() const noexcept {
     return const_reverse_iterator(begin());
 }
 
@@ -924,8 +999,8 @@ typename list<T>::const_reverse_iterator list<T>::rend() const noexcept {
  * @brief 返回常量开始迭代器
  * @return 常量开始迭代器
  */
-template <typename T>
-typename list<T>::const_iterator list<T>::cbegin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cbegin() const noexcept {
     return begin();
 }
 
@@ -933,8 +1008,8 @@ typename list<T>::const_iterator list<T>::cbegin() const noexcept {
  * @brief 返回常量结束迭代器
  * @return 常量结束迭代器
  */
-template <typename T>
-typename list<T>::const_iterator list<T>::cend() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_iterator list<T, Alloc>::cend() const noexcept {
     return end();
 }
 
@@ -942,8 +1017,8 @@ typename list<T>::const_iterator list<T>::cend() const noexcept {
  * @brief 返回常量反向开始迭代器
  * @return 常量反向开始迭代器
  */
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::crbegin() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::crbegin() const noexcept {
     return rbegin();
 }
 
@@ -951,8 +1026,8 @@ typename list<T>::const_reverse_iterator list<T>::crbegin() const noexcept {
  * @brief 返回常量反向结束迭代器
  * @return 常量反向结束迭代器
  */
-template <typename T>
-typename list<T>::const_reverse_iterator list<T>::crend() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reverse_iterator list<T, Alloc>::crend() const noexcept {
     return rend();
 }
 
@@ -960,8 +1035,8 @@ typename list<T>::const_reverse_iterator list<T>::crend() const noexcept {
  * @brief 判断容器是否为空
  * @return 如果容器为空返回true，否则返回false
  */
-template <typename T>
-bool list<T>::empty() const noexcept {
+template <typename T, class Alloc>
+bool list<T, Alloc>::empty() const noexcept {
     return node_->next == node_;
 }
 
@@ -969,8 +1044,8 @@ bool list<T>::empty() const noexcept {
  * @brief 返回容器中的元素数量
  * @return 元素数量
  */
-template <typename T>
-typename list<T>::size_type list<T>::size() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::size() const noexcept {
     return size_;
 }
 
@@ -978,8 +1053,8 @@ typename list<T>::size_type list<T>::size() const noexcept {
  * @brief 返回容器能容纳的最大元素数量
  * @return 最大元素数量
  */
-template <typename T>
-typename list<T>::size_type list<T>::max_size() const noexcept {
+template <typename T, class Alloc>
+typename list<T, Alloc>::size_type list<T, Alloc>::max_size() const noexcept {
     return static_cast<size_type>(-1);
 }
 
@@ -988,8 +1063,8 @@ typename list<T>::size_type list<T>::max_size() const noexcept {
  * @return 第一个元素的引用
  * @throw 如果容器为空，行为未定义
  */
-template <typename T>
-typename list<T>::reference list<T>::front() {
+template <typename T, class Alloc>
+typename list<T, Alloc>::reference list<T, Alloc>::front() {
     return *begin();
 }
 
@@ -998,8 +1073,8 @@ typename list<T>::reference list<T>::front() {
  * @return 第一个元素的常量引用
  * @throw 如果容器为空，行为未定义
  */
-template <typename T>
-typename list<T>::const_reference list<T>::front() const {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reference list<T, Alloc>::front() const {
     return *begin();
 }
 
@@ -1008,8 +1083,8 @@ typename list<T>::const_reference list<T>::front() const {
  * @return 最后一个元素的引用
  * @throw 如果容器为空，行为未定义
  */
-template <typename T>
-typename list<T>::reference list<T>::back() {
+template <typename T, class Alloc>
+typename list<T, Alloc>::reference list<T, Alloc>::back() {
     return *(--end());
 }
 
@@ -1018,8 +1093,8 @@ typename list<T>::reference list<T>::back() {
  * @return 最后一个元素的常量引用
  * @throw 如果容器为空，行为未定义
  */
-template <typename T>
-typename list<T>::const_reference list<T>::back() const {
+template <typename T, class Alloc>
+typename list<T, Alloc>::const_reference list<T, Alloc>::back() const {
     return *(--end());
 }
 
@@ -1028,8 +1103,8 @@ typename list<T>::const_reference list<T>::back() const {
  * @param n 元素个数
  * @param value 填充值
  */
-template <typename T>
-void list<T>::fill_assign(size_type n, const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::fill_assign(size_type n, const value_type& value) {
     auto i = begin();
     auto e = end();
     for (; n > 0 && i != e; --n, ++i) {
@@ -1050,9 +1125,9 @@ void list<T>::fill_assign(size_type n, const value_type& value) {
  * @param first 起始迭代器
  * @param last 结束迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter>
-void list<T>::copy_assign(InputIter first, InputIter last) {
+void list<T, Alloc>::copy_assign(InputIter first, InputIter last) {
     auto i = begin();
     auto e = end();
     for (; first != last && i != e; ++first, ++i) {
@@ -1073,8 +1148,8 @@ void list<T>::copy_assign(InputIter first, InputIter last) {
  * @param n 元素个数
  * @param value 填充值
  */
-template <typename T>
-void list<T>::assign(size_type n, const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::assign(size_type n, const value_type& value) {
     fill_assign(n, value);
 }
 
@@ -1083,9 +1158,9 @@ void list<T>::assign(size_type n, const value_type& value) {
  * @param first 起始迭代器
  * @param last 结束迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter, typename>
-void list<T>::assign(InputIter first, InputIter last) {
+void list<T, Alloc>::assign(InputIter first, InputIter last) {
     copy_assign(first, last);
 }
 
@@ -1093,8 +1168,8 @@ void list<T>::assign(InputIter first, InputIter last) {
  * @brief 用初始化列表为容器赋值
  * @param ilist 初始化列表
  */
-template <typename T>
-void list<T>::assign(std::initializer_list<T> ilist) {
+template <typename T, class Alloc>
+void list<T, Alloc>::assign(std::initializer_list<T> ilist) {
     copy_assign(ilist.begin(), ilist.end());
 }
 
@@ -1102,11 +1177,11 @@ void list<T>::assign(std::initializer_list<T> ilist) {
  * @brief 在容器起始位置构造元素
  * @param args 构造参数
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class... Args>
-void list<T>::emplace_front(Args&&... args) {
+void list<T, Alloc>::emplace_front(Args&&... args) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::emplace_front - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::emplace_front - 链表大小超出最大限制");
     }
     auto link_node = create_node(std::forward<Args>(args)...);
     link_nodes_at_front(link_node->as_base(), link_node->as_base());
@@ -1117,11 +1192,11 @@ void list<T>::emplace_front(Args&&... args) {
  * @brief 在容器末尾构造元素
  * @param args 构造参数
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class... Args>
-void list<T>::emplace_back(Args&&... args) {
+void list<T, Alloc>::emplace_back(Args&&... args) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::emplace_back - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::emplace_back - 链表大小超出最大限制");
     }
     auto link_node = create_node(std::forward<Args>(args)...);
     link_nodes_at_back(link_node->as_base(), link_node->as_base());
@@ -1134,11 +1209,11 @@ void list<T>::emplace_back(Args&&... args) {
  * @param args 构造参数
  * @return 指向新插入元素的迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class... Args>
-typename list<T>::iterator list<T>::emplace(const_iterator pos, Args&&... args) {
+typename list<T, Alloc>::iterator list<T, Alloc>::emplace(const_iterator pos, Args&&... args) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::emplace - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::emplace - 链表大小超出最大限制");
     }
     auto link_node = create_node(std::forward<Args>(args)...);
     link_nodes(pos.node_, link_node->as_base(), link_node->as_base());
@@ -1152,10 +1227,10 @@ typename list<T>::iterator list<T>::emplace(const_iterator pos, Args&&... args)
  * @param value 插入值
  * @return 指向新插入元素的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, const value_type& value) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, const value_type& value) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::insert - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::insert - 链表大小超出最大限制");
     }
     auto link_node = create_node(value);
     ++size_;
@@ -1168,8 +1243,8 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, const value_type&
  * @param value 插入值（右值引用）
  * @return 指向新插入元素的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, value_type&& value) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, value_type&& value) {
     return emplace(pos, std::move(value));
 }
 
@@ -1180,10 +1255,10 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, value_type&& valu
  * @param value 插入值
  * @return 指向第一个新插入元素的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, size_type n, const value_type& value) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, size_type n, const value_type& value) {
     if (size_ >= max_size() - n) {
-        throw std::length_error("list<T>::insert - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::insert - 链表大小超出最大限制");
     }
     return fill_insert(pos, n, value);
 }
@@ -1195,8 +1270,8 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, size_type n, cons
  * @param value 插入值
  * @return 指向第一个新插入元素的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::fill_insert(const_iterator pos, size_type n, const value_type& value) {
     iterator r(pos.node_);
     if (n != 0) {
         const auto add_size = n;
@@ -1237,12 +1312,12 @@ typename list<T>::iterator list<T>::fill_insert(const_iterator pos, size_type n,
  * @param last 结束迭代器
  * @return 指向第一个新插入元素的迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter, typename>
-typename list<T>::iterator list<T>::insert(const_iterator pos, InputIter first, InputIter last) {
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, InputIter first, InputIter last) {
     size_type n = std::distance(first, last);
     if (size_ >= max_size() - n) {
-        throw std::length_error("list<T>::insert - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::insert - 链表大小超出最大限制");
     }
     return copy_insert(pos, first, last);
 }
@@ -1253,8 +1328,8 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, InputIter first,
  * @param ilist 初始化列表
  * @return 指向第一个新插入元素的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::insert(const_iterator pos, std::initializer_list<T> ilist) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, std::initializer_list<T> ilist) {
     return insert(pos, ilist.begin(), ilist.end());
 }
 
@@ -1262,10 +1337,10 @@ typename list<T>::iterator list<T>::insert(const_iterator pos, std::initializer_
  * @brief 在容器起始位置添加一个元素
  * @param value 插入值
  */
-template <typename T>
-void list<T>::push_front(const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_front(const value_type& value) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::push_front - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::push_front - 链表大小超出最大限制");
     }
     auto link_node = create_node(value);
     link_nodes_at_front(link_node->as_base(), link_node->as_base());
@@ -1276,8 +1351,8 @@ void list<T>::push_front(const value_type& value) {
  * @brief 在容器起始位置添加一个元素（移动语义）
  * @param value 插入值（右值引用）
  */
-template <typename T>
-void list<T>::push_front(value_type&& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_front(value_type&& value) {
     emplace_front(std::move(value));
 }
 
@@ -1285,10 +1360,10 @@ void list<T>::push_front(value_type&& value) {
  * @brief 在容器末尾添加一个元素
  * @param value 插入值
  */
-template <typename T>
-void list<T>::push_back(const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_back(const value_type& value) {
     if (size_ >= max_size()) {
-        throw std::length_error("list<T>::push_back - 链表大小超出最大限制");
+        throw std::length_error("list<T, Alloc>::push_back - 链表大小超出最大限制");
     }
     auto link_node = create_node(value);
     link_nodes_at_back(link_node->as_base(), link_node->as_base());
@@ -1299,16 +1374,16 @@ void list<T>::push_back(const value_type& value) {
  * @brief 在容器末尾添加一个元素（移动语义）
  * @param value 插入值（右值引用）
  */
-template <typename T>
-void list<T>::push_back(value_type&& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::push_back(value_type&& value) {
     emplace_back(std::move(value));
 }
 
 /**
  * @brief 移除容器第一个元素
  */
-template <typename T>
-void list<T>::pop_front() {
+template <typename T, class Alloc>
+void list<T, Alloc>::pop_front() {
     auto n = node_->next;
     unlink_nodes(n, n);
     destroy_node(n->as_node());
@@ -1318,8 +1393,8 @@ void list<T>::pop_front() {
 /**
  * @brief 移除容器最后一个元素
  */
-template <typename T>
-void list<T>::pop_back() {
+template <typename T, class Alloc>
+void list<T, Alloc>::pop_back() {
     auto n = node_->prev;
     unlink_nodes(n, n);
     destroy_node(n->as_node());
@@ -1331,8 +1406,8 @@ void list<T>::pop_back() {
  * @param pos 删除位置
  * @return 指向被删除元素后一个位置的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::erase(const_iterator pos) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos) {
     auto n = pos.node_;
     auto next = n->next;
     unlink_nodes(n, n);
@@ -1347,8 +1422,8 @@ typename list<T>::iterator list<T>::erase(const_iterator pos) {
  * @param last 范围结束
  * @return 指向最后一个被删除元素后一个位置的迭代器
  */
-template <typename T>
-typename list<T>::iterator list<T>::erase(const_iterator first, const_iterator last) {
+template <typename T, class Alloc>
+typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator first, const_iterator last) {
     if (first != last) {
         unlink_nodes(first.node_, last.node_->prev);
         while (first != last) {
@@ -1364,24 +1439,57 @@ typename list<T>::iterator list<T>::erase(const_iterator first, const_iterator l
 /**
  * @brief 清空容器
  */
-template <typename T>
-void list<T>::clear() {
+template <typename T, class Alloc>
+void list<T, Alloc>::clear() {
     if (size_ != 0) {
-        auto cur = node_->next;
-        for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
-            destroy_node(cur->as_node());
+        if (node_alloc_can_release(get_alloc())) {
+            // 分配器可以整块释放节点内存：只析构元素，不逐个归还节点
+            destroy_values(std::is_trivially_destructible<value_type>());
+            node_alloc_release(get_alloc());
+        }
+        else {
+            auto cur = node_->next;
+            for (base_ptr next = cur->next; cur != node_; cur = next, next = cur->next) {
+                destroy_node(cur->as_node());
+            }
         }
         node_->unlink();
         size_ = 0;
     }
 }
 
+/**
+ * @brief 只析构所有元素，不归还节点内存
+ */
+template <typename T, class Alloc>
+void list<T, Alloc>::destroy_values(std::false_type) {
+    for (auto cur = node_->next; cur != node_; cur = cur->next) {
+        node_alloc_traits::destroy(get_alloc(), std::addressof(cur->as_node()->value));
+    }
+}
+
+/**
+ * @brief 把other中[first, last)的元素移动到pos之前，用于两个链表的分配器不相等的情形
+ * @param pos 插入位置
+ * @param other 元素来源链表
+ * @param first 范围起始
+ * @param last 范围结束
+ */
+template <typename T, class Alloc>
+void list<T, Alloc>::move_from(const_iterator pos, list& other, const_iterator first, const_iterator last) {
+    // 节点不能在两个分配器之间转移，只能在本链表中重新构造
+    for (auto it = first; it != last; ++it) {
+        emplace(pos, std::move(it.node_->as_node()->value));
+    }
+    other.erase(first, last);
+}
+
 /**
  * @brief 修改容器大小
  * @param new_size 新容器大小
  */
-template <typename T>
-void list<T>::resize(size_type new_size) {
+template <typename T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size) {
     resize(new_size, value_type());
 }
 
@@ -1390,8 +1498,8 @@ void list<T>::resize(size_type new_size) {
  * @param new_size 新容器大小
  * @param value 填充值
  */
-template <typename T>
-void list<T>::resize(size_type new_size, const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::resize(size_type new_size, const value_type& value) {
     auto i = begin();
     size_type len = 0;
     while (i != end() && len < new_size) {
@@ -1412,10 +1520,14 @@ void list<T>::resize(size_type new_size, const value_type& value) {
  * @brief 与另一个list交换内容
  * @param rhs 另一个list
  */
-template <typename T>
-void list<T>::swap(list& rhs) noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::swap(list& rhs) noexcept {
     std::swap(node_, rhs.node_);
     std::swap(size_, rhs.size_);
+    // 分配器不传播时两个链表的分配器必须相等
+    if (node_alloc_traits::propagate_on_container_swap::value) {
+        std::swap(get_alloc(), rhs.get_alloc());
+    }
 }
 
 /**
@@ -1425,9 +1537,9 @@ void list<T>::swap(list& rhs) noexcept {
  * @param last 结束迭代器
  * @return 指向第一个新插入元素的迭代器
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class InputIter>
-typename list<T>::iterator list<T>::copy_insert(const_iterator pos, InputIter first, InputIter last) {
+typename list<T, Alloc>::iterator list<T, Alloc>::copy_insert(const_iterator pos, InputIter first, InputIter last) {
     iterator r(pos.node_);
     if (first != last) {
         auto node = create_node(*first);
@@ -1464,9 +1576,12 @@ typename list<T>::iterator list<T>::copy_insert(const_iterator pos, InputIter fi
  * @param pos 接合位置
  * @param other 被接合的链表
  */
-template <typename T>
-void list<T>::splice(const_iterator pos, list& other) {
-    if (this != &other && !other.empty()) {
+template <typename T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& other) {
+    if (this != &other && !other.empty() && get_alloc() != other.get_alloc()) {
+        move_from(pos, other, other.cbegin(), other.cend());
+    }
+    else if (this != &other && !other.empty()) {
         size_ += other.size_;
         auto first = other.node_->next;
         auto last = other.node_->prev;
@@ -1482,9 +1597,12 @@ void list<T>::splice(const_iterator pos, list& other) {
  * @param other 被接合的链表
  * @param it 被移动的元素
  */
-template <typename T>
-void list<T>::splice(const_iterator pos, list& other, const_iterator it) {
-    if (pos.node_ != it.node_ && pos.node_ != std::next(it).node_) {
+template <typename T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& other, const_iterator it) {
+    if (this != &other && get_alloc() != other.get_alloc()) {
+        move_from(pos, other, it, std::next(it));
+    }
+    else if (pos.node_ != it.node_ && pos.node_ != std::next(it).node_) {
         auto node = it.node_;
         unlink_nodes(node, node);
         if (this != &other) {
@@ -1502,9 +1620,12 @@ void list<T>::splice(const_iterator pos, list& other, const_iterator it) {
  * @param first 范围起始
  * @param last 范围结束
  */
-template <typename T>
-void list<T>::splice(const_iterator pos, list& other, const_iterator first, const_iterator last) {
-    if (first != last && this != &other) {
+template <typename T, class Alloc>
+void list<T, Alloc>::splice(const_iterator pos, list& other, const_iterator first, const_iterator last) {
+    if (first != last && this != &other && get_alloc() != other.get_alloc()) {
+        move_from(pos, other, first, last);
+    }
+    else if (first != last && this != &other) {
         size_type n = std::distance(first, last);
         other.size_ -= n;
         size_ += n;
@@ -1529,8 +1650,8 @@ void list<T>::splice(const_iterator pos, list& other, const_iterator first, cons
  * @brief 移除链表中所有与value相等的元素
  * @param value 目标值
  */
-template <typename T>
-void list<T>::remove(const value_type& value) {
+template <typename T, class Alloc>
+void list<T, Alloc>::remove(const value_type& value) {
     remove_if([&](const value_type& v) { return v == value; });
 }
 
@@ -1538,9 +1659,9 @@ void list<T>::remove(const value_type& value) {
  * @brief 移除链表中所有满足谓词条件的元素
  * @param pred 一元谓词
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class UnaryPredicate>
-void list<T>::remove_if(UnaryPredicate pred) {
+void list<T, Alloc>::remove_if(UnaryPredicate pred) {
     auto first = begin();
     auto last = end();
     for (auto next = first; first != last; first = next) {
@@ -1554,8 +1675,8 @@ void list<T>::remove_if(UnaryPredicate pred) {
 /**
  * @brief 删除链表中连续重复的元素，只保留一个
  */
-template <typename T>
-void list<T>::unique() {
+template <typename T, class Alloc>
+void list<T, Alloc>::unique() {
     unique(std::equal_to<T>());
 }
 
@@ -1563,9 +1684,9 @@ void list<T>::unique() {
  * @brief 删除链表中按照谓词判断为重复的元素
  * @param binary_pred 二元谓词
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class BinaryPredicate>
-void list<T>::unique(BinaryPredicate binary_pred) {
+void list<T, Alloc>::unique(BinaryPredicate binary_pred) {
     if (size_ <= 1) return;
     auto first = begin();
     auto last = end();
@@ -1587,8 +1708,8 @@ void list<T>::unique(BinaryPredicate binary_pred) {
 /**
  * @brief 将链表按升序排序（使用operator<）
  */
-template <typename T>
-void list<T>::sort() {
+template <typename T, class Alloc>
+void list<T, Alloc>::sort() {
     sort(std::less<T>());
 }
 
@@ -1596,15 +1717,21 @@ void list<T>::sort() {
  * @brief 将链表按照指定的比较函数排序（归并排序）
  * @param compare 比较函数
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class Compare>
-void list<T>::sort(Compare compare) {
+void list<T, Alloc>::sort(Compare compare) {
     if (size_ <= 1) return;
     
     // 使用归并排序
     list carry;
     list counter[64];  // 存储2^i长度的有序链表
     int fill = 0;      // 当前使用的计数器索引
+
+    // 临时链表与当前链表共用分配器，保证 splice 和 merge 只重新链接节点
+    carry.get_alloc() = get_alloc();
+    for (auto& c : counter) {
+        c.get_alloc() = get_alloc();
+    }
     
     while (!empty()) {
         // 取出链表第一个元素
@@ -1634,8 +1761,8 @@ void list<T>::sort(Compare compare) {
  * @brief 合并两个有序链表
  * @param x 另一个链表
  */
-template <typename T>
-void list<T>::merge(list& x) {
+template <typename T, class Alloc>
+void list<T, Alloc>::merge(list& x) {
     merge(x, std::less<T>());
 }
 
@@ -1644,9 +1771,9 @@ void list<T>::merge(list& x) {
  * @param x 另一个链表
  * @param comp 比较函数
  */
-template <typename T>
+template <typename T, class Alloc>
 template <class Compare>
-void list<T>::merge(list& x, Compare comp) {
+void list<T, Alloc>::merge(list& x, Compare comp) {
     if (this != &x) {
         auto first1 = begin();
         auto last1 = end();
@@ -1676,8 +1803,8 @@ void list<T>::merge(list& x, Compare comp) {
 /**
  * @brief 反转链表
  */
-template <typename T>
-void list<T>::reverse() noexcept {
+template <typename T, class Alloc>
+void list<T, Alloc>::reverse() noexcept {
     if (size_ <= 1) return;
     
     // 从头到尾逐一交换节点的前后指针
@@ -1696,8 +1823,8 @@ void list<T>::reverse() noexcept {
 /**
  * @brief 重载==操作符
  */
-template <typename T>
-bool operator==(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
@@ -1707,51 +1834,61 @@ bool operator==(const list<T>& lhs, const list<T>& rhs) {
 /**
  * @brief 重载!=操作符
  */
-template <typename T>
-bool operator!=(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator!=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs == rhs);
 }
 
 /**
  * @brief 重载<操作符
  */
-template <typename T>
-bool operator<(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator<(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
 /**
  * @brief 重载>操作符
  */
-template <typename T>
-bool operator>(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator>(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return rhs < lhs;
 }
 
 /**
  * @brief 重载<=操作符
  */
-template <typename T>
-bool operator<=(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator<=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(rhs < lhs);
 }
 
 /**
  * @brief 重载>=操作符
  */
-template <typename T>
-bool operator>=(const list<T>& lhs, const list<T>& rhs) {
+template <typename T, class Alloc>
+bool operator>=(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs) {
     return !(lhs < rhs);
 }
 
 /**
  * @brief 重载标准库swap函数
  */
-template <typename T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept {
+template <typename T, class Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+namespace pmr {
+
+/**
+ * @brief 使用 polymorphic_allocator 的 list
+ */
+template <class T>
+using list = mystl::list<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MY_LIST_H 
\ No newline at end of file
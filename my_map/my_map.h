@@ -12,10 +12,15 @@
 //   * emplace
 //   * emplace_hint
 //   * insert
+//   * try_emplace
+//   * insert_or_assign
 
 #include "../my_rb_tree/my_rb_tree.h"
+#include "../my_memory_resource/my_memory_resource.h"
+#include "../my_functional/my_functional.h"
 #include <initializer_list>
 #include <functional>
+#include <tuple>
 #include <utility>
 #include <stdexcept>
 
@@ -55,8 +60,11 @@ T&& forward(typename std::remove_reference<T>::type&& t) noexcept {
  * @tparam Key 键值类型
  * @tparam T 实值类型
  * @tparam Compare 键值比较方式，默认使用 my::less
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam OrderStatistics 为 true 时底层红黑树维护子树大小，提供 O(log n) 的 nth、rank 和 distance
  */
-template <class Key, class T, class Compare = my::less<Key>>
+template <class Key, class T, class Compare = my::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, bool OrderStatistics = false>
 class map
 {
 public:
@@ -73,7 +81,7 @@ public:
      */
     class value_compare : public std::binary_function<value_type, value_type, bool>
     {
-        friend class map<Key, T, Compare>;
+        friend class map<Key, T, Compare, Alloc, OrderStatistics>;
     private:
         Compare comp;
         value_compare(Compare c) : comp(c) {}
@@ -91,14 +99,15 @@ private:
     /**
      * @brief 以红黑树作为底层机制
      */
-    typedef mystl::rb_tree<value_type, key_compare>  base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc, OrderStatistics>  base_type;
     base_type tree_;  // 红黑树成员变量
 
 public:
     /**
      * @brief 使用红黑树的型别定义
      */
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
+    typedef typename base_type::insert_return_type     insert_return_type;
     typedef typename base_type::pointer                pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::reference              reference;
@@ -120,6 +129,15 @@ public:
      */
     map() = default;
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * @param alloc 分配器
+     */
+    explicit map(const allocator_type& alloc)
+        : tree_(alloc)
+    {
+    }
+
     /**
      * @brief 范围构造函数
      * @tparam InputIterator 输入迭代器类型
@@ -127,8 +145,8 @@ public:
      * @param last 范围结束
      */
     template <class InputIterator>
-    map(InputIterator first, InputIterator last)
-        : tree_()
+    map(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        : tree_(alloc)
     {
         tree_.insert_unique(first, last);
     }
@@ -137,8 +155,8 @@ public:
      * @brief 初始化列表构造函数
      * @param ilist 初始化列表
      */
-    map(std::initializer_list<value_type> ilist)
-        : tree_()
+    map(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : tree_(alloc)
     {
         tree_.insert_unique(ilist.begin(), ilist.end());
     }
@@ -152,6 +170,16 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * @param rhs 被拷贝对象
+     * @param alloc 分配器
+     */
+    map(const map& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc)
+    {
+    }
+
     /**
      * @brief 移动构造函数
      * @param rhs 被移动对象
@@ -161,6 +189,16 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * @param rhs 被移动对象
+     * @param alloc 分配器
+     */
+    map(map&& rhs, const allocator_type& alloc)
+        : tree_(my::move(rhs.tree_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 被拷贝对象
@@ -177,7 +215,7 @@ public:
      * @param rhs 被移动对象
      * @return map& 返回自身引用
      */
-    map& operator=(map&& rhs)
+    map& operator=(map&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         tree_ = my::move(rhs.tree_);
         return *this;
@@ -474,6 +512,181 @@ public:
         tree_.insert_unique(first, last);
     }
 
+    /**
+     * @brief 用一段按键有序的元素替换容器的内容
+     * 
+     * 输入有序时直接构建平衡的红黑树，O(n)，相邻的重复键只保留第一个；
+     * 输入实际无序时退回逐个插入，结果仍然正确。从空容器插入一个范围时也会走同样的路径
+     * @tparam InputIterator 输入迭代器类型
+     * @param first 范围起始
+     * @param last 范围结束
+     */
+    template <class InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last)
+    {
+        tree_.assign_sorted_unique(first, last);
+    }
+
+    /**
+     * @brief 键值不存在时才用 args 原位构造实值
+     * @tparam Args 参数类型包
+     * @param key 键
+     * @param args 实值的构造参数
+     * @return std::pair<iterator,bool> 包含指向元素的迭代器和是否插入成功的布尔值的对
+     * @note 先查找插入位置，键值已存在时既不分配节点也不移动 key 和 args
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key(key, std::piecewise_construct,
+                                        std::forward_as_tuple(key),
+                                        std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键值不存在时才用 args 原位构造实值（移动键版本）
+     * @tparam Args 参数类型包
+     * @param key 键（右值引用），只有插入成功时才会被移动
+     * @param args 实值的构造参数
+     * @return std::pair<iterator,bool> 包含指向元素的迭代器和是否插入成功的布尔值的对
+     */
+    template <class ...Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key(key, std::piecewise_construct,
+                                        std::forward_as_tuple(my::move(key)),
+                                        std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 在指定位置附近执行 try_emplace
+     * @param hint 指定的位置
+     * @param key 键
+     * @param args 实值的构造参数
+     * @return iterator 指向键为 key 的元素的迭代器
+     */
+    template <class ...Args>
+    iterator try_emplace(iterator hint, const key_type& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                                 std::forward_as_tuple(key),
+                                                 std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    template <class ...Args>
+    iterator try_emplace(iterator hint, key_type&& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                                 std::forward_as_tuple(my::move(key)),
+                                                 std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 异构 try_emplace：Compare 声明了 is_transparent 时用 key 直接查找，
+     *        只有插入时才用 key 构造 key_type
+     * 
+     * 例如 map<mystl::string, V, mystl::transparent_less> 用 const char* 插入已存在的键时不构造临时字符串。
+     * 能转换为迭代器的参数仍调用带提示的版本
+     */
+    template <class K, class ...Args, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<K&&, iterator>::value &&
+                                              !std::is_convertible<K&&, const_iterator>::value>::type>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key(key, std::piecewise_construct,
+                                        std::forward_as_tuple(my::forward<K>(key)),
+                                        std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    template <class K, class ...Args, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator try_emplace(iterator hint, K&& key, Args&& ...args)
+    {
+        return tree_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                                 std::forward_as_tuple(my::forward<K>(key)),
+                                                 std::forward_as_tuple(my::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键值不存在时插入，存在时把 obj 赋值给已有的实值
+     * @tparam M 实值类型
+     * @param key 键
+     * @param obj 实值
+     * @return std::pair<iterator,bool> second 为 false 表示进行了赋值
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+    {
+        auto result = try_emplace(key, my::forward<M>(obj));
+        if (!result.second)
+            result.first->second = my::forward<M>(obj);
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+    {
+        auto result = try_emplace(my::move(key), my::forward<M>(obj));
+        if (!result.second)
+            result.first->second = my::forward<M>(obj);
+        return result;
+    }
+
+    /**
+     * @brief 异构 insert_or_assign，条件与异构 try_emplace 相同
+     */
+    template <class K, class M, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<K&&, iterator>::value &&
+                                              !std::is_convertible<K&&, const_iterator>::value>::type>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj)
+    {
+        auto result = try_emplace(my::forward<K>(key), my::forward<M>(obj));
+        if (!result.second)
+            result.first->second = my::forward<M>(obj);
+        return result;
+    }
+
+    /**
+     * @brief 在指定位置附近执行 insert_or_assign
+     * @param hint 指定的位置
+     * @param key 键
+     * @param obj 实值
+     * @return iterator 指向键为 key 的元素的迭代器
+     * @note 与 try_emplace 使用相同的提示路径，元素个数没有增加说明键已存在，改为赋值
+     */
+    template <class M>
+    iterator insert_or_assign(iterator hint, const key_type& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, key, my::forward<M>(obj));
+        if (size() == n)
+            it->second = my::forward<M>(obj);
+        return it;
+    }
+
+    template <class M>
+    iterator insert_or_assign(iterator hint, key_type&& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, my::move(key), my::forward<M>(obj));
+        if (size() == n)
+            it->second = my::forward<M>(obj);
+        return it;
+    }
+
+    template <class K, class M, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator insert_or_assign(iterator hint, K&& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, my::forward<K>(key), my::forward<M>(obj));
+        if (size() == n)
+            it->second = my::forward<M>(obj);
+        return it;
+    }
+
     /**
      * @brief 删除指定位置的元素
      * @param position 指定的位置
@@ -511,6 +724,49 @@ public:
         tree_.clear();
     }
 
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * @param position 指定的位置
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(iterator position)
+    {
+        return tree_.extract(position);
+    }
+
+    /**
+     * @brief 摘下一个键为 key 的元素，不存在时返回空的节点句柄
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    {
+        return tree_.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄中的元素，键已存在时节点留在返回值的 node 中
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素；可以先修改 nh.key() 再放回，完成改键
+     * @param nh 节点句柄，插入成功后变为空
+     * @return insert_return_type 插入位置、是否插入以及未插入的节点
+     */
+    insert_return_type insert(node_type&& nh)
+    {
+        return tree_.insert_unique(my::move(nh));
+    }
+
+    /**
+     * @brief 在指定位置附近插入节点句柄中的元素
+     * @param hint 指定的位置
+     * @param nh 节点句柄
+     * @return iterator 指向键相同的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(iterator hint, node_type&& nh)
+    {
+        return tree_.insert_unique(hint, my::move(nh));
+    }
+
     /**
      * @brief map相关操作，主要是查找
      */
@@ -605,6 +861,188 @@ public:
         return tree_.equal_range_unique(key);
     }
 
+    /**
+     * @brief 异构查找：Compare 声明了 is_transparent（如 mystl::transparent_less）时，
+     *        以下函数接受任何能与 key_type 比较的类型，不构造临时的 key_type
+     * 
+     * 例如 map<mystl::string, V, mystl::transparent_less> 可以直接用 const char* 查找
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator find(const K& key)
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator find(const K& key) const
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type count(const K& key) const
+    {
+        return tree_.count_unique(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator lower_bound(const K& key)
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator lower_bound(const K& key) const
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator upper_bound(const K& key)
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator upper_bound(const K& key) const
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return tree_.equal_range_unique(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return tree_.equal_range_unique(key);
+    }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    {
+        return tree_.erase_unique(key);
+    }
+
+    /**
+     * @brief 顺序统计操作，nth和rank要求OrderStatistics为true，均为O(log n)
+     */
+
+    /**
+     * @brief 获取按键排序后的第k个元素（从0开始）
+     * @param k 序号
+     * @return iterator 指向第k个元素的迭代器，k >= size()时返回end()
+     */
+    iterator nth(size_type k)
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取按键排序后的第k个元素（常量版本）
+     * @param k 序号
+     * @return const_iterator 指向第k个元素的常量迭代器，k >= size()时返回end()
+     */
+    const_iterator nth(size_type k) const
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取键小于指定键的元素个数，即lower_bound(key)的序号
+     * @param key 指定的键
+     * @return size_type 键小于key的元素个数
+     */
+    size_type rank(const key_type& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type rank(const K& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    /**
+     * @brief 获取两个迭代器之间的元素个数，OrderStatistics为true时不逐个遍历
+     * @param first 范围起点
+     * @param last 范围终点
+     * @return difference_type [first, last)中的元素个数
+     */
+    difference_type distance(const_iterator first, const_iterator last) const
+    {
+        return tree_.distance(first, last);
+    }
+
+    /**
+     * @brief 把 source 中键不在本容器中的元素移入本容器，其余元素留在 source 中
+     * 
+     * 分配器相等时直接转移节点，不分配也不复制元素：以本容器的根节点拆分 source，
+     * 两侧递归合并后再拼接，O(m log(n/m + 1))，m、n分别为较小和较大的容器的大小
+     * @param source 要合并的map
+     */
+    void merge(map& source)
+    {
+        tree_.merge_unique(source.tree_);
+    }
+
+    void merge(map&& source)
+    {
+        tree_.merge_unique(source.tree_);
+    }
+
+    /**
+     * @brief 并集：合并 other 的元素，键已存在的元素被丢弃，other 变为空
+     * @param other 要合并的map
+     */
+    void set_union(map&& other)
+    {
+        tree_.merge_unique(other.tree_);
+        other.clear();
+    }
+
+    /**
+     * @brief 交集：只保留键在 other 中出现的键值对
+     * 
+     * 沿 other 的结构三路拆分本容器，O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个map，不会被修改
+     */
+    void set_intersection(const map& other)
+    {
+        tree_.intersect(other.tree_);
+    }
+
+    /**
+     * @brief 差集：删除键在 other 中出现的键值对
+     * 
+     * O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个map，不会被修改
+     */
+    void set_difference(const map& other)
+    {
+        tree_.subtract(other.tree_);
+    }
+
     /**
      * @brief 交换两个map的内容
      * @param rhs 要交换的另一个map
@@ -639,8 +1077,8 @@ public:
  * @param rhs 右侧map
  * @return bool 如果相等返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator==(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs == rhs;
 }
@@ -654,8 +1092,8 @@ bool operator==(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs
  * @param rhs 右侧map
  * @return bool 如果lhs小于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs < rhs;
 }
@@ -669,8 +1107,8 @@ bool operator<(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
  * @param rhs 右侧map
  * @return bool 如果不相等返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator!=(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -684,8 +1122,8 @@ bool operator!=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs
  * @param rhs 右侧map
  * @return bool 如果lhs大于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return rhs < lhs;
 }
@@ -699,8 +1137,8 @@ bool operator>(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
  * @param rhs 右侧map
  * @return bool 如果lhs小于等于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<=(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(rhs < lhs);
 }
@@ -714,8 +1152,8 @@ bool operator<=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs
  * @param rhs 右侧map
  * @return bool 如果lhs大于等于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>=(const map<Key, T, Compare, Alloc, OrderStatistics>& lhs, const map<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs < rhs);
 }
@@ -728,8 +1166,8 @@ bool operator>=(const map<Key, T, Compare>& lhs, const map<Key, T, Compare>& rhs
  * @param lhs 左侧map
  * @param rhs 右侧map
  */
-template <class Key, class T, class Compare>
-void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+void swap(map<Key, T, Compare, Alloc, OrderStatistics>& lhs, map<Key, T, Compare, Alloc, OrderStatistics>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -741,8 +1179,11 @@ void swap(map<Key, T, Compare>& lhs, map<Key, T, Compare>& rhs) noexcept
  * @tparam Key 键值类型
  * @tparam T 实值类型
  * @tparam Compare 键值比较方式，默认使用 my::less
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam OrderStatistics 为 true 时底层红黑树维护子树大小，提供 O(log n) 的 nth、rank 和 distance
  */
-template <class Key, class T, class Compare = my::less<Key>>
+template <class Key, class T, class Compare = my::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, bool OrderStatistics = false>
 class multimap
 {
 public:
@@ -759,7 +1200,7 @@ public:
      */
     class value_compare : public std::binary_function<value_type, value_type, bool>
     {
-        friend class multimap<Key, T, Compare>;
+        friend class multimap<Key, T, Compare, Alloc, OrderStatistics>;
     private:
         Compare comp;
         value_compare(Compare c) : comp(c) {}
@@ -777,14 +1218,14 @@ private:
     /**
      * @brief 以红黑树作为底层机制
      */
-    typedef mystl::rb_tree<value_type, key_compare>  base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc, OrderStatistics>  base_type;
     base_type tree_;  // 红黑树成员变量
 
 public:
     /**
      * @brief 使用红黑树的型别定义
      */
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::pointer                pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::reference              reference;
@@ -807,6 +1248,15 @@ public:
      */
     multimap() = default;
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * @param alloc 分配器
+     */
+    explicit multimap(const allocator_type& alloc)
+        : tree_(alloc)
+    {
+    }
+
     /**
      * @brief 范围构造函数
      * @tparam InputIterator 输入迭代器类型
@@ -814,8 +1264,8 @@ public:
      * @param last 范围结束
      */
     template <class InputIterator>
-    multimap(InputIterator first, InputIterator last)
-        : tree_()
+    multimap(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        : tree_(alloc)
     {
         tree_.insert_multi(first, last);
     }
@@ -824,8 +1274,8 @@ public:
      * @brief 初始化列表构造函数
      * @param ilist 初始化列表
      */
-    multimap(std::initializer_list<value_type> ilist)
-        : tree_()
+    multimap(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : tree_(alloc)
     {
         tree_.insert_multi(ilist.begin(), ilist.end());
     }
@@ -838,6 +1288,16 @@ public:
         : tree_(rhs.tree_)
     {
     }
+
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * @param rhs 被拷贝对象
+     * @param alloc 分配器
+     */
+    multimap(const multimap& rhs, const allocator_type& alloc)
+        : tree_(rhs.tree_, alloc)
+    {
+    }
     
     /**
      * @brief 移动构造函数
@@ -848,6 +1308,16 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * @param rhs 被移动对象
+     * @param alloc 分配器
+     */
+    multimap(multimap&& rhs, const allocator_type& alloc)
+        : tree_(my::move(rhs.tree_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 被拷贝对象
@@ -864,7 +1334,7 @@ public:
      * @param rhs 被移动对象
      * @return multimap& 返回自身引用
      */
-    multimap& operator=(multimap&& rhs)
+    multimap& operator=(multimap&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         tree_ = my::move(rhs.tree_);
         return *this;
@@ -1097,6 +1567,21 @@ public:
         tree_.insert_multi(first, last);
     }
 
+    /**
+     * @brief 用一段按键有序的元素替换容器的内容
+     * 
+     * 输入有序时直接构建平衡的红黑树，O(n)，相等的元素保持输入顺序；
+     * 输入实际无序时退回逐个插入，结果仍然正确。从空容器插入一个范围时也会走同样的路径
+     * @tparam InputIterator 输入迭代器类型
+     * @param first 范围起始
+     * @param last 范围结束
+     */
+    template <class InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last)
+    {
+        tree_.assign_sorted_multi(first, last);
+    }
+
     /**
      * @brief 删除指定位置的元素
      * @param position 指定的位置
@@ -1134,6 +1619,49 @@ public:
         tree_.clear();
     }
 
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * @param position 指定的位置
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(iterator position)
+    {
+        return tree_.extract(position);
+    }
+
+    /**
+     * @brief 摘下一个键为 key 的元素，不存在时返回空的节点句柄
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    {
+        return tree_.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄中的元素
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素
+     * @param nh 节点句柄，插入后变为空
+     * @return iterator 指向新元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(node_type&& nh)
+    {
+        return tree_.insert_multi(my::move(nh));
+    }
+
+    /**
+     * @brief 在指定位置附近插入节点句柄中的元素
+     * @param hint 指定的位置
+     * @param nh 节点句柄
+     * @return iterator 指向新元素的迭代器
+     */
+    iterator insert(iterator hint, node_type&& nh)
+    {
+        return tree_.insert_multi(hint, my::move(nh));
+    }
+
     /**
      * @brief multimap 相关操作
      */
@@ -1228,6 +1756,190 @@ public:
         return tree_.equal_range_multi(key);
     }
 
+    /**
+     * @brief 异构查找：Compare 声明了 is_transparent（如 mystl::transparent_less）时，
+     *        以下函数接受任何能与 key_type 比较的类型，不构造临时的 key_type
+     * 
+     * 例如 map<mystl::string, V, mystl::transparent_less> 可以直接用 const char* 查找
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator find(const K& key)
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator find(const K& key) const
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type count(const K& key) const
+    {
+        return tree_.count_multi(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator lower_bound(const K& key)
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator lower_bound(const K& key) const
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator upper_bound(const K& key)
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator upper_bound(const K& key) const
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return tree_.equal_range_multi(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return tree_.equal_range_multi(key);
+    }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    {
+        return tree_.erase_multi(key);
+    }
+
+    /**
+     * @brief 顺序统计操作，nth和rank要求OrderStatistics为true，均为O(log n)
+     */
+
+    /**
+     * @brief 获取按键排序后的第k个元素（从0开始）
+     * @param k 序号
+     * @return iterator 指向第k个元素的迭代器，k >= size()时返回end()
+     */
+    iterator nth(size_type k)
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取按键排序后的第k个元素（常量版本）
+     * @param k 序号
+     * @return const_iterator 指向第k个元素的常量迭代器，k >= size()时返回end()
+     */
+    const_iterator nth(size_type k) const
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取键小于指定键的元素个数，即lower_bound(key)的序号
+     * @param key 指定的键
+     * @return size_type 键小于key的元素个数
+     */
+    size_type rank(const key_type& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type rank(const K& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    /**
+     * @brief 获取两个迭代器之间的元素个数，OrderStatistics为true时不逐个遍历
+     * @param first 范围起点
+     * @param last 范围终点
+     * @return difference_type [first, last)中的元素个数
+     */
+    difference_type distance(const_iterator first, const_iterator last) const
+    {
+        return tree_.distance(first, last);
+    }
+
+    /**
+     * @brief 把 source 的所有元素移入本容器，source 变为空
+     * 
+     * 分配器相等时直接转移节点，不分配也不复制元素，O(m log(n/m + 1))；
+     * 键相等时 source 的元素排在本容器的元素之后
+     * @param source 要合并的multimap
+     */
+    void merge(multimap& source)
+    {
+        tree_.merge_multi(source.tree_);
+    }
+
+    void merge(multimap&& source)
+    {
+        tree_.merge_multi(source.tree_);
+    }
+
+    /**
+     * @brief 并集：合并 other 的所有元素，other 变为空
+     * @param other 要合并的multimap
+     */
+    void set_union(multimap&& other)
+    {
+        tree_.merge_multi(other.tree_);
+        other.clear();
+    }
+
+    /**
+     * @brief 交集：只保留键在 other 中出现的键值对
+     * 按键过滤：与 other 中某个键相等的元素全部保留，不按重复次数配对
+     * 
+     * 沿 other 的结构三路拆分本容器，O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个multimap，不会被修改
+     */
+    void set_intersection(const multimap& other)
+    {
+        tree_.intersect(other.tree_);
+    }
+
+    /**
+     * @brief 差集：删除键在 other 中出现的键值对
+     * 按键过滤：与 other 中某个键相等的元素全部删除，不按重复次数配对
+     * 
+     * O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个multimap，不会被修改
+     */
+    void set_difference(const multimap& other)
+    {
+        tree_.subtract(other.tree_);
+    }
+
     /**
      * @brief 交换两个multimap的内容
      * @param rhs 要交换的另一个multimap
@@ -1262,8 +1974,8 @@ public:
  * @param rhs 右侧multimap
  * @return bool 如果相等返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator==(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs == rhs;
 }
@@ -1277,8 +1989,8 @@ bool operator==(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Com
  * @param rhs 右侧multimap
  * @return bool 如果lhs小于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs < rhs;
 }
@@ -1292,8 +2004,8 @@ bool operator<(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Comp
  * @param rhs 右侧multimap
  * @return bool 如果不相等返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator!=(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -1307,8 +2019,8 @@ bool operator!=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Com
  * @param rhs 右侧multimap
  * @return bool 如果lhs大于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return rhs < lhs;
 }
@@ -1322,8 +2034,8 @@ bool operator>(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Comp
  * @param rhs 右侧multimap
  * @return bool 如果lhs小于等于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<=(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(rhs < lhs);
 }
@@ -1337,8 +2049,8 @@ bool operator<=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Com
  * @param rhs 右侧multimap
  * @return bool 如果lhs大于等于rhs返回true，否则返回false
  */
-template <class Key, class T, class Compare>
-bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Compare>& rhs)
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>=(const multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, const multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs < rhs);
 }
@@ -1351,11 +2063,40 @@ bool operator>=(const multimap<Key, T, Compare>& lhs, const multimap<Key, T, Com
  * @param lhs 左侧multimap
  * @param rhs 右侧multimap
  */
-template <class Key, class T, class Compare>
-void swap(multimap<Key, T, Compare>& lhs, multimap<Key, T, Compare>& rhs) noexcept
+template <class Key, class T, class Compare, class Alloc, bool OrderStatistics>
+void swap(multimap<Key, T, Compare, Alloc, OrderStatistics>& lhs, multimap<Key, T, Compare, Alloc, OrderStatistics>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 维护子树大小的 map / multimap，支持按名次取元素和求排名
+ */
+template <class Key, class T, class Compare = my::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+using ranked_map = map<Key, T, Compare, Alloc, true>;
+
+template <class Key, class T, class Compare = my::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+using ranked_multimap = multimap<Key, T, Compare, Alloc, true>;
+
 } // namespace my
+
+namespace mystl
+{
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 map / multimap
+ */
+template <class Key, class T, class Compare = my::less<Key>>
+using map = my::map<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <class Key, class T, class Compare = my::less<Key>>
+using multimap = my::multimap<Key, T, Compare, polymorphic_allocator<std::pair<const Key, T>>>;
+
+} // namespace pmr
+} // namespace mystl
+
 #endif // !MY_MAP_H_ 
\ No newline at end of file
@@ -214,6 +214,71 @@ void test_multimap() {
     std::cout << "multimap功能测试通过!" << std::endl << std::endl;
 }
 
+// 统计构造次数的实值类型
+struct counted_value {
+    static int constructed;
+    int v;
+    counted_value(int x = 0) : v(x) { ++constructed; }
+    counted_value(const counted_value& rhs) : v(rhs.v) { ++constructed; }
+};
+int counted_value::constructed = 0;
+
+// 测试try_emplace、insert_or_assign以及重复键值不分配节点
+void test_map_try_emplace() {
+    std::cout << "===== 测试try_emplace和insert_or_assign =====" << std::endl;
+
+    my::map<int, counted_value> m;
+    for (int i = 0; i < 100; i += 2) {
+        assert(m.try_emplace(i, i).second);
+    }
+
+    // 键值已存在：不构造任何对象
+    counted_value::constructed = 0;
+    for (int i = 0; i < 100; i += 2) {
+        auto r = m.try_emplace(i, -1);
+        assert(!r.second && r.first->first == i && r.first->second.v == i);
+        auto r2 = m.emplace(std::make_pair(i, 1));
+        assert(!r2.second && r2.first->first == i);
+    }
+    assert(counted_value::constructed == 0);
+
+    // 带提示插入：正确位置的提示与错误位置的提示
+    for (int i = 1; i < 100; i += 2) {
+        auto hint = m.lower_bound(i);
+        auto it = m.try_emplace(hint, i, i);
+        assert(it->first == i);
+        assert(m.try_emplace(m.begin(), i, 0) == it);
+    }
+    assert(m.try_emplace(m.end(), 1000, 1)->first == 1000);
+    assert(m.try_emplace(m.begin(), -1, 1)->first == -1);
+    assert(m.size() == 102);
+    int expect = -1;
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        assert(it->first == expect);
+        expect = expect == 99 ? 1000 : expect + 1;
+    }
+
+    // insert_or_assign
+    my::map<std::string, int> sm;
+    assert(sm.insert_or_assign("one", 1).second);
+    auto r = sm.insert_or_assign("one", 11);
+    assert(!r.second && r.first->second == 11);
+    std::string key = "two";
+    sm.try_emplace(std::move(key), 2);
+    std::string dup = "two";
+    assert(!sm.try_emplace(std::move(dup), 22).second);
+    assert(dup == "two");
+    assert(sm.insert_or_assign(sm.end(), "three", 3)->second == 3);
+    assert(sm.size() == 3);
+    // 带提示的 insert_or_assign：键已存在时赋值，不存在时在提示位置插入
+    auto three = sm.find("three");
+    assert(sm.insert_or_assign(three, "three", 33) == three && three->second == 33);
+    auto four = sm.insert_or_assign(three, std::string("four"), 4);
+    assert(four->second == 4 && std::next(four) == sm.find("one") && sm.size() == 4);
+
+    std::cout << "try_emplace和insert_or_assign测试通过!" << std::endl << std::endl;
+}
+
 // 测试比较操作
 void test_comparison() {
     std::cout << "===== 测试比较操作 =====" << std::endl;
@@ -254,6 +319,186 @@ void test_comparison() {
     std::cout << "比较操作测试通过!" << std::endl << std::endl;
 }
 
+// 测试顺序统计：排行榜按分数取第k名、求分数的排名、百分位
+void test_order_statistics() {
+    std::cout << "===== 测试顺序统计操作 =====" << std::endl;
+
+    my::ranked_map<int, std::string> board;
+    for (int score = 10; score <= 100; score += 10) {
+        board[score] = "player" + std::to_string(score);
+    }
+    assert(board.nth(0)->first == 10);
+    assert(board.nth(4)->first == 50);
+    assert(board.nth(9)->first == 100);
+    assert(board.nth(10) == board.end());
+    assert(board.rank(10) == 0);
+    assert(board.rank(55) == 5);
+    assert(board.rank(1000) == 10);
+    assert(board.distance(board.lower_bound(30), board.upper_bound(70)) == 5);
+    assert(board.distance(board.begin(), board.end()) == 10);
+
+    // 删除后排名随之更新
+    board.erase(30);
+    board.erase(board.nth(0));
+    assert(board.nth(0)->first == 20);
+    assert(board.rank(55) == 3);
+    // 第90百分位
+    assert(board.nth(board.size() * 9 / 10)->first == 100);
+
+    my::ranked_multimap<int, int> mm;
+    for (int i = 0; i < 1000; ++i) {
+        mm.insert({i % 10, i});
+    }
+    assert(mm.count(3) == 100);
+    assert(mm.rank(3) == 300);
+    assert(mm.nth(299)->first == 2);
+    assert(mm.nth(300)->first == 3);
+    assert(mm.distance(mm.lower_bound(3), mm.upper_bound(5)) == 300);
+    mm.erase(3);
+    assert(mm.count(3) == 0);
+    assert(mm.rank(4) == 300);
+
+    std::cout << "顺序统计测试通过!" << std::endl << std::endl;
+}
+
+// 测试从有序快照批量构建
+void test_assign_sorted() {
+    std::cout << "===== 测试assign_sorted =====" << std::endl;
+
+    std::vector<std::pair<int, int>> snapshot;
+    for (int i = 0; i < 1000; ++i) {
+        snapshot.push_back(std::make_pair(i / 2, i));  // 每个键出现两次
+    }
+
+    my::map<int, int> m;
+    m[-1] = -1;
+    m.assign_sorted(snapshot.begin(), snapshot.end());
+    assert(m.size() == 500);
+    assert(m.find(-1) == m.end());
+    assert(m.at(0) == 0);       // 重复键保留第一个
+    assert(m.at(499) == 998);
+    m.insert({1000, 1000});
+    m.erase(250);
+    assert(m.size() == 500);
+
+    my::multimap<int, int> mm(snapshot.begin(), snapshot.end());
+    assert(mm.size() == 1000);
+    assert(mm.count(7) == 2);
+    auto range = mm.equal_range(7);
+    assert(range.first->second == 14 && (++range.first)->second == 15);  // 相等的键保持输入顺序
+
+    // 无序输入同样正确
+    std::vector<std::pair<int, int>> unsorted = {{3, 0}, {1, 1}, {2, 2}, {1, 3}};
+    mm.assign_sorted(unsorted.begin(), unsorted.end());
+    assert(mm.size() == 4 && mm.begin()->first == 1 && mm.begin()->second == 1);
+
+    std::cout << "assign_sorted测试通过!" << std::endl << std::endl;
+}
+
+void test_set_operations() {
+    std::cout << "===== 测试合并与集合运算 =====" << std::endl;
+
+    my::map<int, std::string> a, b;
+    for (int i = 0; i < 1000; ++i) {
+        a[i * 2] = "a";
+    }
+    for (int i = 0; i < 10; ++i) {
+        b[i * 3] = "b";
+    }
+    a.merge(b);
+    assert(a.size() == 1005);
+    assert(b.size() == 5);                        // 键已存在的元素留在 b 中
+    assert(a.at(0) == "a" && a.at(3) == "b");
+    assert(b.begin()->first == 0 && b.rbegin()->first == 24);
+
+    a.set_union(std::move(b));
+    assert(a.size() == 1005 && b.empty());
+
+    my::map<int, std::string> keys;
+    for (int i = 0; i < 30; ++i) {
+        keys[i] = "";
+    }
+    my::map<int, std::string> c = a;
+    c.set_intersection(keys);
+    assert(c.size() == 20 && c.at(3) == "b" && c.rbegin()->first == 28);
+    a.set_difference(keys);
+    assert(a.size() == 985 && a.begin()->first == 30);
+
+    // 键相等时 source 的元素排在后面，实值保持原来的顺序
+    my::multimap<int, int> ma, mb;
+    for (int i = 0; i < 6; ++i) {
+        ma.insert({i / 2, i});
+        mb.insert({i / 3, 10 + i});
+    }
+    ma.merge(std::move(mb));
+    assert(ma.size() == 12 && mb.empty());
+    auto range = ma.equal_range(1);
+    std::vector<int> values;
+    for (; range.first != range.second; ++range.first) {
+        values.push_back(range.first->second);
+    }
+    assert((values == std::vector<int>{2, 3, 13, 14, 15}));
+
+    my::multimap<int, int> filter;
+    filter.insert({1, 0});
+    my::multimap<int, int> mc = ma;
+    mc.set_intersection(filter);
+    assert(mc.size() == 5 && mc.count(1) == 5);
+    ma.set_difference(filter);
+    assert(ma.size() == 7 && ma.count(1) == 0);
+
+    // 顺序统计 map 合并后排名仍然正确
+    my::ranked_map<int, int> ra, rb;
+    for (int i = 0; i < 100; ++i) {
+        ra[i * 2] = i;
+        rb[i * 2 + 1] = i;
+    }
+    ra.merge(rb);
+    assert(ra.size() == 200 && rb.empty());
+    assert(ra.nth(77)->first == 77 && ra.rank(150) == 150);
+
+    std::cout << "合并与集合运算测试通过!" << std::endl << std::endl;
+}
+
+void test_node_handle() {
+    std::cout << "===== 测试节点句柄 =====" << std::endl;
+
+    my::map<int, std::string> m;
+    for (int i = 0; i < 10; ++i) {
+        m[i] = std::to_string(i);
+    }
+
+    // 改键不分配节点，也不复制实值
+    auto nh = m.extract(3);
+    assert(nh && m.size() == 9 && m.count(3) == 0);
+    const std::string* addr = &nh.mapped();
+    nh.key() = 30;
+    auto r = m.insert(std::move(nh));
+    assert(r.inserted && r.node.empty() && r.position->first == 30);
+    assert(&r.position->second == addr && m.rbegin()->first == 30);
+
+    // 键已存在：节点留在返回值中
+    r = m.insert(m.extract(m.begin()));
+    assert(r.inserted && r.position->first == 0);
+    auto dup = m.extract(m.find(1));
+    dup.mapped() = "dup";
+    my::map<int, std::string> other{{1, "other"}};
+    r = other.insert(std::move(dup));
+    assert(!r.inserted && r.node.mapped() == "dup" && r.position->second == "other");
+    assert(m.extract(100).empty());
+
+    // map 与 multimap 的节点类型相同，可以互相转移
+    my::multimap<int, std::string> mm;
+    mm.insert(std::move(r.node));
+    mm.insert(m.extract(2));
+    mm.insert(mm.begin(), other.extract(1));
+    assert(mm.size() == 3 && mm.count(1) == 2 && m.size() == 8 && other.empty());
+    m.insert(m.end(), mm.extract(mm.find(2)));
+    assert(m.at(2) == "2" && mm.size() == 2);
+
+    std::cout << "节点句柄测试通过!" << std::endl << std::endl;
+}
+
 int main() {
     std::cout << "开始测试my::map和my::multimap实现..." << std::endl << std::endl;
     
@@ -261,7 +506,12 @@ int main() {
     test_map_find_erase();
     test_map_iterators();
     test_multimap();
+    test_map_try_emplace();
     test_comparison();
+    test_order_statistics();
+    test_assign_sorted();
+    test_set_operations();
+    test_node_handle();
     
     std::cout << "所有测试通过！my::map和my::multimap实现符合预期！" << std::endl;
     return 0;
@@ -0,0 +1,944 @@
+#ifndef MY_MEMORY_RESOURCE_H
+#define MY_MEMORY_RESOURCE_H
+
+// 这个头文件包含 mystl::pmr 命名空间下的内存资源与多态分配器
+// memory_resource             : 内存资源的抽象基类
+// new_delete_resource         : 使用 operator new / delete 的全局内存资源
+// null_memory_resource        : 任何分配都抛出 std::bad_alloc 的内存资源
+// monotonic_buffer_resource   : 单调增长的缓冲区，deallocate 为空操作，release() 一次性释放
+// unsynchronized_pool_resource: 按 2 的幂分级的内存池，非线程安全
+// synchronized_pool_resource  : 加锁的 unsynchronized_pool_resource，可被多个线程共享
+// polymorphic_allocator       : 通过 memory_resource* 分配内存的标准分配器
+// alloc_holder                : 容器保存分配器的基类，空分配器不占空间
+//
+// 各容器头文件在 mystl::pmr 中定义了使用 polymorphic_allocator 的别名，
+// 例如 mystl::pmr::vector<T>、mystl::pmr::map<K, V>、mystl::pmr::string
+
+// 注释：
+//
+// 1. 接口与 C++17 的 std::pmr 一致，只依赖 C++11
+// 2. polymorphic_allocator 的拷贝赋值没有删除（std 中是删除的），因为容器的移动赋值在运行期判断
+//    propagate_on_container_move_assignment，赋值语句仍需编译；该特征为 false，赋值不会真正发生
+// 3. polymorphic_allocator 构造元素时使用 uses-allocator 构造：元素自身也使用分配器时
+//    （如 pmr::vector<pmr::string>、pmr::map<pmr::string, int>），元素得到同一个内存资源
+// 4. 内存资源必须比使用它的容器活得更久
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+namespace mystl
+{
+
+/**
+ * @brief 容器保存分配器的基类
+ *
+ * 分配器为空类（如 std::allocator）时私有继承分配器，容器再继承本类，
+ * 空基类优化使分配器不占容器的空间；有状态的分配器（如 pmr::polymorphic_allocator）作为成员保存
+ * @tparam Alloc 分配器类型
+ */
+template <class Alloc, bool = std::is_empty<Alloc>::value>
+class alloc_holder : private Alloc
+{
+public:
+    alloc_holder() = default;
+    explicit alloc_holder(const Alloc& alloc) noexcept : Alloc(alloc) {}
+    explicit alloc_holder(Alloc&& alloc) noexcept : Alloc(std::move(alloc)) {}
+
+    Alloc&       get_alloc() noexcept       { return *this; }
+    const Alloc& get_alloc() const noexcept { return *this; }
+};
+
+template <class Alloc>
+class alloc_holder<Alloc, false>
+{
+    Alloc alloc_;  // 有状态的分配器
+
+public:
+    alloc_holder() = default;
+    explicit alloc_holder(const Alloc& alloc) noexcept : alloc_(alloc) {}
+    explicit alloc_holder(Alloc&& alloc) noexcept : alloc_(std::move(alloc)) {}
+
+    Alloc&       get_alloc() noexcept       { return alloc_; }
+    const Alloc& get_alloc() const noexcept { return alloc_; }
+};
+
+namespace pmr
+{
+
+/**
+ * @brief 内存资源的抽象基类
+ *
+ * 派生类实现 do_allocate、do_deallocate 和 do_is_equal
+ */
+class memory_resource
+{
+    static constexpr size_t max_align = alignof(std::max_align_t);
+
+public:
+    virtual ~memory_resource() = default;
+
+    /**
+     * @brief 分配 bytes 字节、按 alignment 对齐的内存
+     * @throw 无法分配时抛出异常，通常为 std::bad_alloc
+     */
+    void* allocate(size_t bytes, size_t alignment = max_align)
+    { return do_allocate(bytes, alignment); }
+
+    /**
+     * @brief 归还由 allocate(bytes, alignment) 得到的内存
+     */
+    void deallocate(void* p, size_t bytes, size_t alignment = max_align)
+    { do_deallocate(p, bytes, alignment); }
+
+    /**
+     * @brief 判断一个资源分配的内存能否由另一个资源归还
+     */
+    bool is_equal(const memory_resource& other) const noexcept
+    { return do_is_equal(other); }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void  do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+    virtual bool  do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept
+{
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+namespace detail
+{
+
+/**
+ * @brief 将 n 向上取整到 align 的倍数，align 必须是 2 的幂
+ */
+inline size_t align_up(size_t n, size_t align) noexcept
+{
+    return (n + align - 1) & ~(align - 1);
+}
+
+/**
+ * @brief 使用全局 operator new / delete 的内存资源
+ *
+ * C++11 没有带对齐参数的 operator new，超过 max_align_t 的对齐要求通过多分配
+ * alignment 字节并在用户块之前保存原始指针来满足
+ */
+class new_delete_memory_resource : public memory_resource
+{
+    static constexpr size_t max_align = alignof(std::max_align_t);
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (alignment <= max_align)
+            return ::operator new(bytes);
+        if (bytes > std::numeric_limits<size_t>::max() - alignment - sizeof(void*))
+            throw std::bad_alloc();
+        void* raw = ::operator new(bytes + alignment + sizeof(void*));
+        const auto base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        void* p = reinterpret_cast<void*>((base + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+        static_cast<void**>(p)[-1] = raw;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t, size_t alignment) override
+    {
+        if (alignment <= max_align)
+            ::operator delete(p);
+        else
+            ::operator delete(static_cast<void**>(p)[-1]);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    { return this == &other; }
+};
+
+/**
+ * @brief 任何分配都失败的内存资源，用于确认容器不会超出预留的缓冲区
+ */
+class null_memory_resource_impl : public memory_resource
+{
+    void* do_allocate(size_t, size_t) override
+    { throw std::bad_alloc(); }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    { return this == &other; }
+};
+
+inline std::atomic<memory_resource*>& default_resource_holder() noexcept;
+
+} // namespace detail
+
+/**
+ * @brief 返回使用 operator new / delete 的全局内存资源
+ */
+inline memory_resource* new_delete_resource() noexcept
+{
+    static detail::new_delete_memory_resource instance;
+    return &instance;
+}
+
+/**
+ * @brief 返回任何分配都抛出 std::bad_alloc 的全局内存资源
+ */
+inline memory_resource* null_memory_resource() noexcept
+{
+    static detail::null_memory_resource_impl instance;
+    return &instance;
+}
+
+namespace detail
+{
+
+inline std::atomic<memory_resource*>& default_resource_holder() noexcept
+{
+    static std::atomic<memory_resource*> holder(new_delete_resource());
+    return holder;
+}
+
+} // namespace detail
+
+/**
+ * @brief 设置默认内存资源
+ * @param r 新的默认资源，为空时恢复为 new_delete_resource()
+ * @return 之前的默认资源
+ */
+inline memory_resource* set_default_resource(memory_resource* r) noexcept
+{
+    if (r == nullptr)
+        r = new_delete_resource();
+    return detail::default_resource_holder().exchange(r);
+}
+
+/**
+ * @brief 返回默认内存资源，默认构造的 polymorphic_allocator 使用它
+ */
+inline memory_resource* get_default_resource() noexcept
+{
+    return detail::default_resource_holder().load();
+}
+
+/*****************************************************************************************/
+// monotonic_buffer_resource
+
+/**
+ * @brief 单调增长的缓冲区资源
+ *
+ * 分配只移动当前 chunk 中的指针；当前 chunk 不够时向上游申请一个更大的 chunk，
+ * chunk 大小成倍增长。deallocate 为空操作，所有内存在 release() 或析构时一次性归还上游。
+ * 适合生命周期一致的一组容器，例如一次请求中创建的所有临时容器
+ */
+class monotonic_buffer_resource : public memory_resource
+{
+    static constexpr size_t max_align = alignof(std::max_align_t);
+    static constexpr size_t default_size = 1024;  // 默认的第一个 chunk 大小
+
+    // chunk 头部，放在每个 chunk 的开头，组成单链表
+    struct chunk_header
+    {
+        chunk_header* next;
+        size_t        size;
+        size_t        align;
+    };
+
+public:
+    /**
+     * @brief 使用默认资源作为上游
+     */
+    monotonic_buffer_resource()
+        : monotonic_buffer_resource(get_default_resource()) {}
+
+    /**
+     * @brief 指定上游资源，构造时不分配内存
+     */
+    explicit monotonic_buffer_resource(memory_resource* upstream)
+        : monotonic_buffer_resource(default_size, upstream) {}
+
+    /**
+     * @brief 指定第一个 chunk 的大小，构造时不分配内存
+     */
+    explicit monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), current_(nullptr), remaining_(0),
+          initial_buffer_(nullptr), initial_size_(0),
+          initial_next_size_(initial_size > sizeof(chunk_header) ? initial_size : default_size),
+          next_size_(initial_next_size_), chunks_(nullptr)
+    {
+    }
+
+    /**
+     * @brief 先使用调用方提供的缓冲区（如栈上数组），用完后再向上游申请
+     * @param buffer 初始缓冲区，由调用方管理生命周期
+     * @param buffer_size 初始缓冲区的字节数
+     */
+    monotonic_buffer_resource(void* buffer, size_t buffer_size,
+                              memory_resource* upstream = get_default_resource())
+        : upstream_(upstream), current_(static_cast<char*>(buffer)), remaining_(buffer_size),
+          initial_buffer_(static_cast<char*>(buffer)), initial_size_(buffer_size),
+          initial_next_size_(grow(buffer_size > default_size ? buffer_size : default_size)),
+          next_size_(initial_next_size_), chunks_(nullptr)
+    {
+    }
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    ~monotonic_buffer_resource() override
+    {
+        release();
+    }
+
+    /**
+     * @brief 把所有 chunk 归还上游，恢复到刚构造时的状态
+     *
+     * 之前分配出去的内存全部失效，调用方需保证没有容器还在使用它们
+     */
+    void release() noexcept
+    {
+        while (chunks_)
+        {
+            chunk_header* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->size, chunks_->align);
+            chunks_ = next;
+        }
+        current_ = initial_buffer_;
+        remaining_ = initial_size_;
+        next_size_ = initial_next_size_;
+    }
+
+    /**
+     * @brief 返回上游资源
+     */
+    memory_resource* upstream_resource() const noexcept
+    { return upstream_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (bytes == 0)
+            bytes = 1;
+        void* p = bump(bytes, alignment);
+        if (p == nullptr)
+        {
+            new_chunk(bytes, alignment);
+            p = bump(bytes, alignment);
+        }
+        return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    { return this == &other; }
+
+    /**
+     * @brief 在当前 chunk 中切出一块，空间不够时返回空指针
+     */
+    void* bump(size_t bytes, size_t alignment) noexcept
+    {
+        if (current_ == nullptr)
+            return nullptr;
+        const auto cur = reinterpret_cast<std::uintptr_t>(current_);
+        const size_t pad = static_cast<size_t>(
+            ((cur + alignment - 1) & ~(std::uintptr_t(alignment) - 1)) - cur);
+        if (pad > remaining_ || bytes > remaining_ - pad)
+            return nullptr;
+        void* p = current_ + pad;
+        current_ += pad + bytes;
+        remaining_ -= pad + bytes;
+        return p;
+    }
+
+    /**
+     * @brief 向上游申请一个至少能容纳 bytes 字节的新 chunk
+     */
+    void new_chunk(size_t bytes, size_t alignment)
+    {
+        if (bytes > std::numeric_limits<size_t>::max() - alignment - sizeof(chunk_header))
+            throw std::bad_alloc();
+        const size_t need = bytes + alignment + sizeof(chunk_header);
+        const size_t size = next_size_ < need ? need : next_size_;
+        const size_t align = alignment < max_align ? max_align : alignment;
+        void* mem = upstream_->allocate(size, align);
+
+        auto header = static_cast<chunk_header*>(mem);
+        header->next = chunks_;
+        header->size = size;
+        header->align = align;
+        chunks_ = header;
+        current_ = static_cast<char*>(mem) + sizeof(chunk_header);
+        remaining_ = size - sizeof(chunk_header);
+        next_size_ = grow(size);
+    }
+
+    static size_t grow(size_t size) noexcept
+    {
+        return size <= std::numeric_limits<size_t>::max() / 2 ? size * 2 : size;
+    }
+
+private:
+    memory_resource* upstream_;           // 上游资源
+    char*            current_;            // 当前 chunk 中下一个可用字节
+    size_t           remaining_;          // 当前 chunk 的剩余字节数
+    char*            initial_buffer_;     // 调用方提供的初始缓冲区
+    size_t           initial_size_;       // 初始缓冲区的字节数
+    size_t           initial_next_size_;  // release() 后第一个 chunk 的大小
+    size_t           next_size_;          // 下一个 chunk 的大小
+    chunk_header*    chunks_;             // 从上游申请的 chunk 链表
+};
+
+/*****************************************************************************************/
+// pool resources
+
+/**
+ * @brief 内存池资源的配置，值为 0 时使用默认值
+ */
+struct pool_options
+{
+    size_t max_blocks_per_chunk = 0;          // 每个 chunk 最多的块数，默认 8192
+    size_t largest_required_pool_block = 0;   // 由内存池负责的最大块，默认 4096 字节，最大 65536
+};
+
+/**
+ * @brief 按 2 的幂分级的内存池资源，非线程安全
+ *
+ * 不超过 largest_required_pool_block 字节的分配按大小落入 8、16、32 ... 字节的某一级，
+ * 每一级从上游申请 chunk 并切分成等大的块，归还的块挂到该级的空闲链表上供下次复用。
+ * 更大的分配或对齐要求超过 max_align_t 的分配直接交给上游，并记录下来以便 release() 统一归还
+ */
+class unsynchronized_pool_resource : public memory_resource
+{
+    static constexpr size_t max_align = alignof(std::max_align_t);
+    static constexpr size_t min_block = 8;                  // 最小的一级
+    static constexpr size_t max_pool_block = 65536;         // largest_required_pool_block 的上限
+    static constexpr size_t max_pools = 14;                 // 8 ~ 65536 共 14 级
+    static constexpr size_t default_max_blocks = 8192;
+    static constexpr size_t default_largest_block = 4096;
+    static constexpr size_t min_blocks = 16;                // 第一个 chunk 的块数
+    static constexpr size_t max_chunk_bytes = 1 << 20;      // 块数不再增长的 chunk 大小
+
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    // chunk 头部，放在每个 chunk 的末尾，块从 chunk 开头按 block_size 排列
+    struct chunk_header
+    {
+        chunk_header* next;
+        size_t        size;
+    };
+
+    // 一级内存池
+    struct pool
+    {
+        size_t        block_size;
+        size_t        next_blocks;  // 下一个 chunk 的块数
+        free_block*   free_list;
+        char*         cursor;       // 当前 chunk 中尚未切分的部分
+        char*         end;
+        chunk_header* chunks;
+    };
+
+    // 直接向上游申请的大块的头部，放在用户块之前，组成双向链表
+    struct large_header
+    {
+        large_header* prev;
+        large_header* next;
+    };
+
+public:
+    unsynchronized_pool_resource()
+        : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+    explicit unsynchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+    explicit unsynchronized_pool_resource(const pool_options& opts)
+        : unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+    /**
+     * @brief 构造函数，不会分配内存
+     */
+    unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+        : upstream_(upstream), options_(normalize(opts)), pool_count_(0), large_(nullptr)
+    {
+        for (size_t size = min_block; size <= options_.largest_required_pool_block; size *= 2)
+        {
+            pools_[pool_count_++] = pool{size, min_blocks < options_.max_blocks_per_chunk
+                                               ? min_blocks : options_.max_blocks_per_chunk,
+                                         nullptr, nullptr, nullptr, nullptr};
+        }
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override
+    {
+        release();
+    }
+
+    /**
+     * @brief 把所有 chunk 和大块归还上游，之前分配出去的内存全部失效
+     */
+    void release() noexcept
+    {
+        for (size_t i = 0; i < pool_count_; ++i)
+        {
+            pool& p = pools_[i];
+            while (p.chunks)
+            {
+                chunk_header* next = p.chunks->next;
+                upstream_->deallocate(chunk_begin(p.chunks), p.chunks->size, max_align);
+                p.chunks = next;
+            }
+            p.free_list = nullptr;
+            p.cursor = p.end = nullptr;
+            p.next_blocks = min_blocks < options_.max_blocks_per_chunk
+                            ? min_blocks : options_.max_blocks_per_chunk;
+        }
+        while (large_)
+        {
+            large_header* next = large_->next;
+            const size_t bytes = reinterpret_cast<size_t*>(large_ + 1)[0];
+            const size_t align = reinterpret_cast<size_t*>(large_ + 1)[1];
+            upstream_->deallocate(large_, large_offset(align) + bytes, align < max_align ? max_align : align);
+            large_ = next;
+        }
+    }
+
+    /**
+     * @brief 返回上游资源
+     */
+    memory_resource* upstream_resource() const noexcept
+    { return upstream_; }
+
+    /**
+     * @brief 返回补全默认值之后的配置
+     */
+    pool_options options() const noexcept
+    { return options_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        const size_t index = pool_index(bytes, alignment);
+        if (index == pool_count_)
+            return allocate_large(bytes, alignment);
+
+        pool& p = pools_[index];
+        if (p.free_list)
+        {
+            free_block* block = p.free_list;
+            p.free_list = block->next;
+            return block;
+        }
+        if (p.cursor == p.end)
+            new_chunk(p);
+        void* block = p.cursor;
+        p.cursor += p.block_size;
+        return block;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        const size_t index = pool_index(bytes, alignment);
+        if (index == pool_count_)
+        {
+            deallocate_large(ptr, bytes, alignment);
+            return;
+        }
+        pool& p = pools_[index];
+        auto block = static_cast<free_block*>(ptr);
+        block->next = p.free_list;
+        p.free_list = block;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    { return this == &other; }
+
+    /**
+     * @brief 计算分配落入哪一级，返回 pool_count_ 表示直接交给上游
+     */
+    size_t pool_index(size_t bytes, size_t alignment) const noexcept
+    {
+        if (alignment > max_align || bytes > options_.largest_required_pool_block)
+            return pool_count_;
+        size_t need = bytes < alignment ? alignment : bytes;
+        size_t index = 0;
+        for (size_t size = min_block; size < need; size *= 2)
+            ++index;
+        return index;
+    }
+
+    void new_chunk(pool& p)
+    {
+        const size_t blocks_bytes = p.block_size * p.next_blocks;
+        const size_t size = blocks_bytes + sizeof(chunk_header);
+        char* mem = static_cast<char*>(upstream_->allocate(size, max_align));
+
+        auto header = reinterpret_cast<chunk_header*>(mem + blocks_bytes);
+        header->next = p.chunks;
+        header->size = size;
+        p.chunks = header;
+        p.cursor = mem;
+        p.end = mem + blocks_bytes;
+        if (p.next_blocks < options_.max_blocks_per_chunk && blocks_bytes < max_chunk_bytes)
+            p.next_blocks *= 2;
+    }
+
+    static void* chunk_begin(chunk_header* header) noexcept
+    {
+        return reinterpret_cast<char*>(header) + sizeof(chunk_header) - header->size;
+    }
+
+    // 大块的布局：[large_header | bytes | alignment | 填充 | 用户块]
+    static size_t large_offset(size_t alignment) noexcept
+    {
+        const size_t align = alignment < max_align ? max_align : alignment;
+        return detail::align_up(sizeof(large_header) + 2 * sizeof(size_t), align);
+    }
+
+    void* allocate_large(size_t bytes, size_t alignment)
+    {
+        const size_t offset = large_offset(alignment);
+        if (bytes > std::numeric_limits<size_t>::max() - offset)
+            throw std::bad_alloc();
+        const size_t align = alignment < max_align ? max_align : alignment;
+        char* mem = static_cast<char*>(upstream_->allocate(offset + bytes, align));
+
+        auto header = reinterpret_cast<large_header*>(mem);
+        header->prev = nullptr;
+        header->next = large_;
+        if (large_)
+            large_->prev = header;
+        large_ = header;
+        reinterpret_cast<size_t*>(header + 1)[0] = bytes;
+        reinterpret_cast<size_t*>(header + 1)[1] = alignment;
+        return mem + offset;
+    }
+
+    void deallocate_large(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        const size_t offset = large_offset(alignment);
+        auto header = reinterpret_cast<large_header*>(static_cast<char*>(ptr) - offset);
+        if (header->prev)
+            header->prev->next = header->next;
+        else
+            large_ = header->next;
+        if (header->next)
+            header->next->prev = header->prev;
+        upstream_->deallocate(header, offset + bytes, alignment < max_align ? max_align : alignment);
+    }
+
+    static pool_options normalize(pool_options opts) noexcept
+    {
+        if (opts.max_blocks_per_chunk == 0 || opts.max_blocks_per_chunk > default_max_blocks)
+            opts.max_blocks_per_chunk = default_max_blocks;
+        if (opts.largest_required_pool_block == 0)
+            opts.largest_required_pool_block = default_largest_block;
+        if (opts.largest_required_pool_block > max_pool_block)
+            opts.largest_required_pool_block = max_pool_block;
+        size_t size = min_block;
+        while (size < opts.largest_required_pool_block)
+            size *= 2;
+        opts.largest_required_pool_block = size;
+        return opts;
+    }
+
+private:
+    memory_resource* upstream_;          // 上游资源
+    pool_options     options_;           // 补全默认值之后的配置
+    pool             pools_[max_pools];  // 各级内存池，只使用前 pool_count_ 个
+    size_t           pool_count_;
+    large_header*    large_;             // 直接向上游申请的大块
+};
+
+/**
+ * @brief 线程安全的内存池资源
+ *
+ * 在 unsynchronized_pool_resource 外加一把互斥锁，可以被多个线程中的容器共享
+ */
+class synchronized_pool_resource : public memory_resource
+{
+public:
+    synchronized_pool_resource()
+        : impl_() {}
+
+    explicit synchronized_pool_resource(memory_resource* upstream)
+        : impl_(upstream) {}
+
+    explicit synchronized_pool_resource(const pool_options& opts)
+        : impl_(opts) {}
+
+    synchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+        : impl_(opts, upstream) {}
+
+    synchronized_pool_resource(const synchronized_pool_resource&) = delete;
+    synchronized_pool_resource& operator=(const synchronized_pool_resource&) = delete;
+
+    /**
+     * @brief 把所有内存归还上游
+     */
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        impl_.release();
+    }
+
+    memory_resource* upstream_resource() const noexcept
+    { return impl_.upstream_resource(); }
+
+    pool_options options() const noexcept
+    { return impl_.options(); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return impl_.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        impl_.deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    { return this == &other; }
+
+private:
+    unsynchronized_pool_resource impl_;
+    std::mutex                   mutex_;
+};
+
+/*****************************************************************************************/
+// polymorphic_allocator
+
+namespace detail
+{
+
+// uses-allocator 构造的三种方式
+// 0: 类型不使用分配器，直接用参数构造
+// 1: 以 (std::allocator_arg, alloc, args...) 构造
+// 2: 以 (args..., alloc) 构造
+template <class T, class Alloc, class... Args>
+struct uses_alloc_kind
+{
+    static constexpr int value =
+        !std::uses_allocator<T, Alloc>::value ? 0 :
+        std::is_constructible<T, std::allocator_arg_t, const Alloc&, Args...>::value ? 1 :
+        std::is_constructible<T, Args..., const Alloc&>::value ? 2 : 0;
+};
+
+template <class T>
+struct is_std_pair : std::false_type {};
+
+template <class T1, class T2>
+struct is_std_pair<std::pair<T1, T2>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief 通过 memory_resource* 分配内存的分配器
+ *
+ * 同一个资源上的分配器彼此相等，rebind 之后依旧指向同一个资源。
+ * 容器拷贝构造时副本使用默认资源，容器赋值和交换时分配器不传播
+ */
+template <class T>
+class polymorphic_allocator
+{
+    template <class U> friend class polymorphic_allocator;
+
+public:
+    typedef T value_type;
+
+    /**
+     * @brief 使用 get_default_resource()
+     */
+    polymorphic_allocator() noexcept
+        : resource_(get_default_resource()) {}
+
+    /**
+     * @brief 使用指定的资源，允许从 memory_resource* 隐式转换
+     */
+    polymorphic_allocator(memory_resource* r) noexcept
+        : resource_(r) {}
+
+    polymorphic_allocator(const polymorphic_allocator& rhs) = default;
+
+    template <class U>
+    polymorphic_allocator(const polymorphic_allocator<U>& rhs) noexcept
+        : resource_(rhs.resource_) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator& rhs) = default;
+
+    /**
+     * @brief 分配 n 个 T 的空间
+     * @throw n 过大时抛出 std::bad_array_new_length
+     */
+    T* allocate(size_t n)
+    {
+        if (n > max_size())
+            throw std::bad_array_new_length();
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        resource_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    size_t max_size() const noexcept
+    { return std::numeric_limits<size_t>::max() / sizeof(T); }
+
+    /**
+     * @brief uses-allocator 构造：U 使用兼容的分配器时把本分配器传给它
+     */
+    template <class U, class... Args>
+    typename std::enable_if<!detail::is_std_pair<U>::value>::type
+    construct(U* p, Args&&... args)
+    {
+        construct_with(std::integral_constant<int,
+                           detail::uses_alloc_kind<U, polymorphic_allocator, Args...>::value>(),
+                       p, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief pair 的两个成员分别做 uses-allocator 构造
+     */
+    template <class T1, class T2, class... Args1, class... Args2>
+    void construct(std::pair<T1, T2>* p, std::piecewise_construct_t,
+                   std::tuple<Args1...> x, std::tuple<Args2...> y)
+    {
+        ::new (static_cast<void*>(p)) std::pair<T1, T2>(
+            std::piecewise_construct,
+            make_args(std::integral_constant<int,
+                          detail::uses_alloc_kind<T1, polymorphic_allocator, Args1...>::value>(),
+                      std::move(x)),
+            make_args(std::integral_constant<int,
+                          detail::uses_alloc_kind<T2, polymorphic_allocator, Args2...>::value>(),
+                      std::move(y)));
+    }
+
+    template <class T1, class T2>
+    void construct(std::pair<T1, T2>* p)
+    {
+        construct(p, std::piecewise_construct, std::tuple<>(), std::tuple<>());
+    }
+
+    template <class T1, class T2, class U, class V>
+    void construct(std::pair<T1, T2>* p, U&& x, V&& y)
+    {
+        construct(p, std::piecewise_construct,
+                  std::forward_as_tuple(std::forward<U>(x)),
+                  std::forward_as_tuple(std::forward<V>(y)));
+    }
+
+    template <class T1, class T2, class U, class V>
+    void construct(std::pair<T1, T2>* p, const std::pair<U, V>& pr)
+    {
+        construct(p, std::piecewise_construct,
+                  std::forward_as_tuple(pr.first), std::forward_as_tuple(pr.second));
+    }
+
+    template <class T1, class T2, class U, class V>
+    void construct(std::pair<T1, T2>* p, std::pair<U, V>&& pr)
+    {
+        construct(p, std::piecewise_construct,
+                  std::forward_as_tuple(std::forward<U>(pr.first)),
+                  std::forward_as_tuple(std::forward<V>(pr.second)));
+    }
+
+    template <class U>
+    void destroy(U* p)
+    {
+        p->~U();
+    }
+
+    /**
+     * @brief 容器拷贝构造时，副本使用默认资源而不是源容器的资源
+     */
+    polymorphic_allocator select_on_container_copy_construction() const
+    { return polymorphic_allocator(); }
+
+    memory_resource* resource() const noexcept
+    { return resource_; }
+
+private:
+    template <class U, class... Args>
+    void construct_with(std::integral_constant<int, 0>, U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <class U, class... Args>
+    void construct_with(std::integral_constant<int, 1>, U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::allocator_arg, *this, std::forward<Args>(args)...);
+    }
+
+    template <class U, class... Args>
+    void construct_with(std::integral_constant<int, 2>, U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)..., *this);
+    }
+
+    template <class Tuple>
+    Tuple&& make_args(std::integral_constant<int, 0>, Tuple&& t)
+    {
+        return std::forward<Tuple>(t);
+    }
+
+    template <class... Args>
+    std::tuple<std::allocator_arg_t, const polymorphic_allocator&, Args...>
+    make_args(std::integral_constant<int, 1>, std::tuple<Args...>&& t)
+    {
+        return std::tuple_cat(std::tuple<std::allocator_arg_t, const polymorphic_allocator&>(
+                                  std::allocator_arg, *this),
+                              std::move(t));
+    }
+
+    template <class... Args>
+    std::tuple<Args..., const polymorphic_allocator&>
+    make_args(std::integral_constant<int, 2>, std::tuple<Args...>&& t)
+    {
+        return std::tuple_cat(std::move(t), std::tuple<const polymorphic_allocator&>(*this));
+    }
+
+private:
+    memory_resource* resource_;
+};
+
+template <class T1, class T2>
+bool operator==(const polymorphic_allocator<T1>& lhs, const polymorphic_allocator<T2>& rhs) noexcept
+{
+    return *lhs.resource() == *rhs.resource();
+}
+
+template <class T1, class T2>
+bool operator!=(const polymorphic_allocator<T1>& lhs, const polymorphic_allocator<T2>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace pmr
+} // namespace mystl
+
+#endif // !MY_MEMORY_RESOURCE_H
@@ -0,0 +1,399 @@
+// test_memory_resource.cpp
+// 测试 mystl::pmr 中的内存资源、polymorphic_allocator 以及各容器的 pmr 别名
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "my_memory_resource.h"
+#include "../my_vector/my_vector.h"
+#include "../my_deque/my_deque.h"
+#include "../my_list/my_list.h"
+#include "../my_map/my_map.h"
+#include "../my_set/my_set.h"
+#include "../my_unordered_map/my_unordered_map.h"
+#include "../my_unordered_set/unordered_set.h"
+#include "../my_flat_hash_map/my_flat_hash_map.h"
+#include "../my_string/my_string.h"
+
+/**
+ * @brief 记录分配次数和未归还字节数的上游资源
+ */
+class counting_resource : public mystl::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        outstanding += bytes;
+        return mystl::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        outstanding -= bytes;
+        mystl::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const mystl::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+static bool equals(const mystl::pmr::string& s, const char* expected) {
+    return std::strcmp(s.c_str(), expected) == 0;
+}
+
+static bool is_aligned(void* p, size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+/**
+ * @brief 测试全局资源与默认资源
+ */
+void test_global_resources() {
+    std::cout << "===== 测试全局内存资源 =====" << std::endl;
+
+    auto nd = mystl::pmr::new_delete_resource();
+    assert(mystl::pmr::get_default_resource() == nd);
+
+    // 超过 max_align_t 的对齐要求
+    void* p = nd->allocate(100, 256);
+    assert(is_aligned(p, 256));
+    nd->deallocate(p, 100, 256);
+
+    bool thrown = false;
+    try {
+        mystl::pmr::null_memory_resource()->allocate(1);
+    } catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    counting_resource counter;
+    auto old = mystl::pmr::set_default_resource(&counter);
+    assert(old == nd);
+    {
+        mystl::pmr::vector<int> v;  // 默认构造的分配器使用默认资源
+        v.push_back(1);
+        assert(v.get_allocator().resource() == &counter);
+    }
+    assert(counter.allocations > 0 && counter.outstanding == 0);
+    assert(mystl::pmr::set_default_resource(nullptr) == &counter);
+    assert(mystl::pmr::get_default_resource() == nd);
+
+    std::cout << "全局内存资源测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 monotonic_buffer_resource
+ */
+void test_monotonic_buffer_resource() {
+    std::cout << "\n===== 测试 monotonic_buffer_resource =====" << std::endl;
+
+    counting_resource upstream;
+    {
+        mystl::pmr::monotonic_buffer_resource mono(256, &upstream);
+        assert(upstream.allocations == 0);  // 构造时不分配内存
+        assert(mono.upstream_resource() == &upstream);
+
+        // 分配满足对齐要求且互不重叠
+        std::set<char*> blocks;
+        for (int i = 0; i < 1000; ++i) {
+            size_t align = size_t(1) << (i % 7);
+            char* p = static_cast<char*>(mono.allocate(24, align));
+            assert(is_aligned(p, align));
+            blocks.insert(p);
+        }
+        assert(blocks.size() == 1000);
+        // chunk 成倍增长，1000 次分配只需要很少几次上游分配
+        assert(upstream.allocations < 10);
+
+        // deallocate 不归还内存
+        const size_t before = upstream.outstanding;
+        mono.deallocate(*blocks.begin(), 24, 1);
+        assert(upstream.outstanding == before);
+
+        // 超过当前 chunk 的大块
+        void* big = mono.allocate(1 << 20, 64);
+        assert(is_aligned(big, 64));
+
+        mono.release();
+        assert(upstream.outstanding == 0);
+
+        // release 后继续使用
+        mono.allocate(8);
+        assert(upstream.outstanding > 0);
+    }
+    assert(upstream.outstanding == 0);  // 析构时归还
+
+    // 先使用调用方提供的缓冲区
+    alignas(std::max_align_t) char buffer[1024];
+    {
+        mystl::pmr::monotonic_buffer_resource mono(buffer, sizeof(buffer), mystl::pmr::null_memory_resource());
+        mystl::pmr::vector<int> v(&mono);
+        v.reserve(100);
+        assert(reinterpret_cast<char*>(v.data()) >= buffer &&
+               reinterpret_cast<char*>(v.data()) < buffer + sizeof(buffer));
+
+        bool thrown = false;
+        try {
+            v.reserve(10000);  // 超出缓冲区，上游为 null_memory_resource
+        } catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(v.capacity() == 100);
+    }
+
+    std::cout << "monotonic_buffer_resource 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 unsynchronized_pool_resource
+ */
+void test_unsynchronized_pool_resource() {
+    std::cout << "\n===== 测试 unsynchronized_pool_resource =====" << std::endl;
+
+    counting_resource upstream;
+    {
+        mystl::pmr::pool_options opts;
+        opts.largest_required_pool_block = 1000;
+        mystl::pmr::unsynchronized_pool_resource pool(opts, &upstream);
+        assert(pool.options().largest_required_pool_block == 1024);  // 向上取整到 2 的幂
+        assert(pool.options().max_blocks_per_chunk > 0);
+        assert(upstream.allocations == 0);
+
+        // 归还的块会被优先复用
+        void* a = pool.allocate(40);
+        void* b = pool.allocate(40);
+        assert(a != b);
+        pool.deallocate(a, 40);
+        assert(pool.allocate(40) == a);
+
+        // 同一级的块数成倍增长
+        std::vector<void*> blocks;
+        for (int i = 0; i < 10000; ++i) {
+            void* p = pool.allocate(16, 16);
+            assert(is_aligned(p, 16));
+            blocks.push_back(p);
+        }
+        assert(std::set<void*>(blocks.begin(), blocks.end()).size() == blocks.size());
+        const size_t chunk_allocations = upstream.allocations;
+        assert(chunk_allocations < 20);
+        for (auto p : blocks) {
+            pool.deallocate(p, 16, 16);
+        }
+        for (int i = 0; i < 10000; ++i) {
+            pool.allocate(16, 16);
+        }
+        assert(upstream.allocations == chunk_allocations);
+
+        // 大块和超对齐的分配直接交给上游
+        void* big = pool.allocate(5000);
+        assert(upstream.allocations == chunk_allocations + 1);
+        void* aligned = pool.allocate(64, 128);
+        assert(is_aligned(aligned, 128));
+        pool.deallocate(big, 5000);
+        assert(upstream.deallocations == 1);
+
+        pool.release();
+        assert(upstream.outstanding == 0);
+        pool.allocate(8);
+    }
+    assert(upstream.outstanding == 0);
+
+    std::cout << "unsynchronized_pool_resource 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试多个线程共享 synchronized_pool_resource
+ */
+void test_synchronized_pool_resource() {
+    std::cout << "\n===== 测试 synchronized_pool_resource =====" << std::endl;
+
+    counting_resource upstream;
+    {
+        mystl::pmr::synchronized_pool_resource pool(&upstream);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&pool, t]() {
+                for (int round = 0; round < 20; ++round) {
+                    mystl::pmr::map<int, mystl::pmr::string> m(&pool);
+                    for (int i = 0; i < 500; ++i) {
+                        m.emplace(i, "thread value that does not fit in place");
+                    }
+                    assert(m.size() == 500);
+                    assert(equals(m.at(t), "thread value that does not fit in place"));
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        assert(upstream.outstanding > 0);  // 块留在内存池中等待复用
+        pool.release();
+        assert(upstream.outstanding == 0);
+    }
+
+    std::cout << "synchronized_pool_resource 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 polymorphic_allocator
+ */
+void test_polymorphic_allocator() {
+    std::cout << "\n===== 测试 polymorphic_allocator =====" << std::endl;
+
+    mystl::pmr::monotonic_buffer_resource mono1;
+    mystl::pmr::monotonic_buffer_resource mono2;
+    mystl::pmr::polymorphic_allocator<int> a(&mono1);
+    mystl::pmr::polymorphic_allocator<double> b(a);  // rebind 后指向同一资源
+    mystl::pmr::polymorphic_allocator<int> c(&mono2);
+    assert(a == b);
+    assert(a != c);
+    assert(b.resource() == &mono1);
+
+    // 容器拷贝构造时副本使用默认资源
+    typedef std::allocator_traits<mystl::pmr::polymorphic_allocator<int>> traits;
+    assert(traits::select_on_container_copy_construction(a).resource() ==
+           mystl::pmr::get_default_resource());
+    assert(!traits::propagate_on_container_copy_assignment::value);
+    assert(!traits::propagate_on_container_move_assignment::value);
+    assert(!traits::propagate_on_container_swap::value);
+
+    bool thrown = false;
+    try {
+        a.allocate(a.max_size() + 1);
+    } catch (const std::bad_array_new_length&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "polymorphic_allocator 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试嵌套的 pmr 容器：元素通过 uses-allocator 构造得到同一个资源
+ */
+void test_nested_containers() {
+    std::cout << "\n===== 测试嵌套的 pmr 容器 =====" << std::endl;
+
+    counting_resource upstream;
+    {
+        mystl::pmr::monotonic_buffer_resource mono(&upstream);
+
+        mystl::pmr::vector<mystl::pmr::string> names(&mono);
+        names.emplace_back("a string long enough to need heap storage");
+        names.push_back("another string long enough to need heap storage");
+        names.resize(10);
+        for (const auto& s : names) {
+            assert(s.get_allocator().resource() == &mono);
+        }
+        assert(equals(names[1], "another string long enough to need heap storage"));
+
+        mystl::pmr::map<int, mystl::pmr::vector<mystl::pmr::string>> index(&mono);
+        index[1].push_back("first");
+        index.emplace(2, mystl::pmr::vector<mystl::pmr::string>());
+        index.insert(std::make_pair(3, mystl::pmr::vector<mystl::pmr::string>(3, "third")));
+        for (const auto& kv : index) {
+            assert(kv.second.get_allocator().resource() == &mono);
+            for (const auto& s : kv.second) {
+                assert(s.get_allocator().resource() == &mono);
+            }
+        }
+        assert(index.at(1).size() == 1 && equals(index.at(3)[2], "third"));
+
+        mystl::pmr::unordered_map<int, mystl::pmr::string> um(&mono);
+        for (int i = 0; i < 1000; ++i) {
+            um.emplace(i, "value");
+        }
+        assert(um.at(999).get_allocator().resource() == &mono);
+
+        mystl::pmr::list<mystl::pmr::deque<int>> l(&mono);
+        l.emplace_back(5, 1);
+        assert(l.front().get_allocator().resource() == &mono);
+
+        mystl::pmr::flat_hash_map<int, mystl::pmr::string> fm(&mono);
+        fm.emplace(1, "one");
+        assert(fm.at(1).get_allocator().resource() == &mono);
+
+        mystl::pmr::set<int> s(&mono);
+        mystl::pmr::multiset<int> ms(&mono);
+        mystl::pmr::multimap<int, int> mm(&mono);
+        mystl::pmr::unordered_set<int> us(&mono);
+        mystl::pmr::unordered_multiset<int> ums(&mono);
+        mystl::pmr::unordered_multimap<int, int> umm(&mono);
+        mystl::pmr::flat_hash_set<int> fs(&mono);
+        for (int i = 0; i < 100; ++i) {
+            s.insert(i);
+            ms.insert(i % 10);
+            mm.emplace(i % 10, i);
+            us.insert(i);
+            ums.insert(i % 10);
+            umm.emplace(i % 10, i);
+            fs.insert(i);
+        }
+        assert(s.size() == 100 && ms.count(3) == 10 && mm.count(4) == 10);
+        assert(us.size() == 100 && ums.count(5) == 10 && umm.count(6) == 10 && fs.size() == 100);
+
+        // 拷贝构造的副本使用默认资源，独立于 mono
+        mystl::pmr::vector<mystl::pmr::string> copy(names);
+        assert(copy.get_allocator().resource() == mystl::pmr::get_default_resource());
+        assert(equals(copy[0], names[0].c_str()));
+
+        // 与其他资源的容器交换元素时逐个移动
+        mystl::pmr::monotonic_buffer_resource other;
+        mystl::pmr::vector<mystl::pmr::string> moved(std::move(names), &other);
+        assert(moved.get_allocator().resource() == &other);
+        assert(equals(moved[0], "a string long enough to need heap storage"));
+        assert(moved[0].get_allocator().resource() == &other);
+
+        // 容器析构时 deallocate 都是空操作，内存仍由 mono 持有
+        assert(upstream.deallocations == 0);
+    }
+    // 一次性归还
+    assert(upstream.outstanding == 0);
+    assert(upstream.deallocations == upstream.allocations);
+
+    // 哈希表的桶数组同样来自容器的资源，不经过默认资源
+    counting_resource arena, fallback;
+    mystl::pmr::set_default_resource(&fallback);
+    {
+        mystl::pmr::unordered_map<int, int> um(&arena);
+        const size_t before = arena.allocations;
+        um.rehash(4096);  // 空表重哈希只分配新的桶数组
+        assert(arena.allocations == before + 1);
+        for (int i = 0; i < 1000; ++i) {
+            um.emplace(i, i);
+        }
+        mystl::pmr::unordered_map<int, int> moved(std::move(um));
+        moved.clear();
+    }
+    mystl::pmr::set_default_resource(nullptr);
+    assert(fallback.allocations == 0);
+    assert(arena.allocations > 1000 && arena.outstanding == 0);
+
+    std::cout << "嵌套的 pmr 容器测试通过!" << std::endl;
+}
+
+int main() {
+    test_global_resources();
+    test_monotonic_buffer_resource();
+    test_unsynchronized_pool_resource();
+    test_synchronized_pool_resource();
+    test_polymorphic_allocator();
+    test_nested_containers();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <chrono>
+#include <cstddef>
+
+#include "my_memory_resource.h"
+#include "../my_vector/my_vector.h"
+#include "../my_map/my_map.h"
+#include "../my_string/my_string.h"
+
+/**
+ * 计时器类，用于测量一段代码的执行时间
+ */
+class Timer {
+private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
+
+public:
+    Timer() : start_time(std::chrono::high_resolution_clock::now()) {}
+
+    /**
+     * 返回从构造到现在经过的毫秒数
+     */
+    double elapsed_ms() const {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    }
+};
+
+/**
+ * 模拟一次请求：创建若干短生命周期的 vector、map 和 string，请求结束时全部销毁
+ */
+template <class Vector, class Map, class String>
+long long handle_request(const typename Vector::allocator_type& alloc) {
+    long long checksum = 0;
+    for (int i = 0; i < 20; ++i) {
+        Vector v(alloc);
+        for (int j = 0; j < 100; ++j) {
+            v.push_back(j);
+        }
+        Map m(alloc);
+        for (int j = 0; j < 50; ++j) {
+            m.emplace(j, String("a request-scoped value string", alloc));
+        }
+        checksum += v.size() + m.size() + m.at(7).size();
+    }
+    return checksum;
+}
+
+void test_request_scoped_containers() {
+    std::cout << "\n=== 请求内的临时容器: std::allocator 与 monotonic_buffer_resource ===" << std::endl;
+
+    typedef mystl::vector<int> std_vector;
+    typedef my::map<int, mystl::string> std_map;
+
+    const int requests = 2000;
+    long long sum1 = 0;
+    Timer t1;
+    for (int r = 0; r < requests; ++r) {
+        sum1 += handle_request<std_vector, std_map, mystl::string>(std::allocator<int>());
+    }
+    const double std_ms = t1.elapsed_ms();
+
+    long long sum2 = 0;
+    Timer t2;
+    for (int r = 0; r < requests; ++r) {
+        mystl::pmr::monotonic_buffer_resource arena(64 * 1024);
+        sum2 += handle_request<mystl::pmr::vector<int>, mystl::pmr::map<int, mystl::pmr::string>,
+                               mystl::pmr::string>(&arena);
+    }
+    const double mono_ms = t2.elapsed_ms();
+
+    long long sum3 = 0;
+    Timer t3;
+    mystl::pmr::unsynchronized_pool_resource pool;
+    for (int r = 0; r < requests; ++r) {
+        sum3 += handle_request<mystl::pmr::vector<int>, mystl::pmr::map<int, mystl::pmr::string>,
+                               mystl::pmr::string>(&pool);
+    }
+    const double pool_ms = t3.elapsed_ms();
+
+    std::cout << "  请求数: " << requests << std::endl;
+    std::cout << "  std::allocator               : " << std_ms << " ms  (校验和 " << sum1 << ")" << std::endl;
+    std::cout << "  monotonic_buffer_resource    : " << mono_ms << " ms  (校验和 " << sum2 << ")" << std::endl;
+    std::cout << "  unsynchronized_pool_resource : " << pool_ms << " ms  (校验和 " << sum3 << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "===== 内存资源性能测试 =====" << std::endl;
+
+    test_request_scoped_containers();
+
+    return 0;
+}
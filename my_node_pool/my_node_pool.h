@@ -0,0 +1,646 @@
+#ifndef MY_NODE_POOL_H
+#define MY_NODE_POOL_H
+
+// 这个头文件包含节点容器使用的内存池
+// node_pool          : 固定大小内存块的池，从连续的大块内存（chunk）中切分节点
+// node_pool_resource : 按尺寸分级的一组 node_pool
+// pool_allocator     : 基于 node_pool_resource 的标准分配器，可作为 list、map、set、
+//                      unordered_map 等节点容器的 Alloc 模板参数
+// node_handle        : 从节点容器中摘下的节点，extract / insert 在容器之间转移节点时使用
+
+// 注释：
+//
+// 1. 同一个 pool_allocator 的拷贝以及 rebind 得到的分配器共享同一个 node_pool_resource，
+//    彼此相等；默认构造的分配器各自拥有独立的内存池
+// 2. 容器拷贝构造时通过 select_on_container_copy_construction 得到新的内存池
+// 3. 容器 clear() 时，如果它是内存池唯一的使用者，会整块释放所有 chunk，而不是逐个归还节点
+// 4. 内存池不是线程安全的，与容器本身的线程安全性一致
+// 5. node_handle 持有分配器的副本，因此持有句柄期间内存池不会被容器整块释放
+// 6. 哈希表的桶数组等非节点内存通过 node_aux_allocator 选择分配器，pool_allocator 时使用 std::allocator
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+namespace mystl
+{
+
+/**
+ * @brief 固定大小内存块的池
+ *
+ * 每次从系统申请一个 chunk，再把 chunk 顺序切分成大小相同的块。
+ * 归还的块挂到空闲链表上，下次分配时优先复用。
+ * chunk 中的块数从 32 开始成倍增长，最多 8192 块，
+ * 因此 n 个节点只需要 O(log n + n / 8192) 次系统分配
+ */
+class node_pool
+{
+public:
+    static constexpr size_t alignment = alignof(std::max_align_t);  // 块的对齐要求
+
+    /**
+     * @brief 默认构造函数，块大小为 alignment
+     */
+    node_pool() noexcept : node_pool(alignment) {}
+
+    /**
+     * @brief 构造函数，不会分配内存
+     * @param block_size 每个块的字节数，会向上取整到 alignment 的倍数
+     */
+    explicit node_pool(size_t block_size) noexcept
+        : block_size_(round_up(block_size < sizeof(free_block) ? sizeof(free_block) : block_size)),
+          free_list_(nullptr), chunks_(nullptr), cursor_(nullptr), chunk_end_(nullptr),
+          next_blocks_(min_blocks), chunk_count_(0)
+    {
+    }
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    /**
+     * @brief 移动构造函数，接管 rhs 的所有 chunk
+     */
+    node_pool(node_pool&& rhs) noexcept
+        : block_size_(rhs.block_size_), free_list_(rhs.free_list_), chunks_(rhs.chunks_),
+          cursor_(rhs.cursor_), chunk_end_(rhs.chunk_end_), next_blocks_(rhs.next_blocks_),
+          chunk_count_(rhs.chunk_count_)
+    {
+        rhs.reset();
+    }
+
+    /**
+     * @brief 移动赋值运算符，先释放自身的 chunk 再接管 rhs 的 chunk
+     */
+    node_pool& operator=(node_pool&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            release();
+            node_pool tmp(std::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ~node_pool() { release(); }
+
+    /**
+     * @brief 分配一个块
+     * @return 指向块的指针，按 alignment 对齐
+     * @throw std::bad_alloc 申请新 chunk 失败
+     */
+    void* allocate()
+    {
+        if (free_list_)
+        {
+            free_block* p = free_list_;
+            free_list_ = p->next;
+            return p;
+        }
+        if (cursor_ == chunk_end_)
+            add_chunk();
+        void* p = cursor_;
+        cursor_ += block_size_;
+        return p;
+    }
+
+    /**
+     * @brief 归还一个块，块必须来自本内存池
+     * @param p 块指针
+     */
+    void deallocate(void* p) noexcept
+    {
+        free_block* b = static_cast<free_block*>(p);
+        b->next = free_list_;
+        free_list_ = b;
+    }
+
+    /**
+     * @brief 整块释放所有 chunk，之前分配的块全部失效
+     */
+    void release() noexcept
+    {
+        while (chunks_)
+        {
+            chunk_header* next = chunks_->next;
+            ::operator delete(static_cast<void*>(chunks_));
+            chunks_ = next;
+        }
+        reset();
+    }
+
+    /**
+     * @brief 交换两个内存池
+     */
+    void swap(node_pool& rhs) noexcept
+    {
+        std::swap(block_size_, rhs.block_size_);
+        std::swap(free_list_, rhs.free_list_);
+        std::swap(chunks_, rhs.chunks_);
+        std::swap(cursor_, rhs.cursor_);
+        std::swap(chunk_end_, rhs.chunk_end_);
+        std::swap(next_blocks_, rhs.next_blocks_);
+        std::swap(chunk_count_, rhs.chunk_count_);
+    }
+
+    /**
+     * @brief 每个块的字节数
+     */
+    size_t block_size() const noexcept { return block_size_; }
+
+    /**
+     * @brief 当前持有的 chunk 数量
+     */
+    size_t chunk_count() const noexcept { return chunk_count_; }
+
+private:
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    struct chunk_header
+    {
+        chunk_header* next;
+    };
+
+    static constexpr size_t min_blocks = 32;
+    static constexpr size_t max_blocks = 8192;
+
+    static size_t round_up(size_t n) noexcept
+    {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    /**
+     * @brief 申请一个新 chunk，块数成倍增长
+     */
+    void add_chunk()
+    {
+        const size_t header = round_up(sizeof(chunk_header));
+        char* mem = static_cast<char*>(::operator new(header + block_size_ * next_blocks_));
+        chunk_header* chunk = reinterpret_cast<chunk_header*>(mem);
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        cursor_ = mem + header;
+        chunk_end_ = cursor_ + block_size_ * next_blocks_;
+        ++chunk_count_;
+        if (next_blocks_ < max_blocks)
+            next_blocks_ <<= 1;
+    }
+
+    void reset() noexcept
+    {
+        free_list_ = nullptr;
+        chunks_ = nullptr;
+        cursor_ = nullptr;
+        chunk_end_ = nullptr;
+        next_blocks_ = min_blocks;
+        chunk_count_ = 0;
+    }
+
+private:
+    size_t        block_size_;   // 块大小
+    free_block*   free_list_;    // 已归还的块
+    chunk_header* chunks_;       // 所有 chunk 组成的链表
+    char*         cursor_;       // 当前 chunk 中下一个未切分的块
+    char*         chunk_end_;    // 当前 chunk 的末尾
+    size_t        next_blocks_;  // 下一个 chunk 的块数
+    size_t        chunk_count_;  // chunk 数量
+};
+
+/**
+ * @brief 按尺寸分级的内存池集合
+ *
+ * 以 node_pool::alignment 为级差，最大 max_block_size 字节，每一级一个 node_pool。
+ * 超过最大尺寸、一次分配多个对象或对齐要求更高的请求直接交给 operator new
+ */
+class node_pool_resource
+{
+public:
+    static constexpr size_t max_block_size = 256;  // 池化的最大块大小
+    static constexpr size_t class_count = max_block_size / node_pool::alignment;
+
+    node_pool_resource() noexcept
+    {
+        for (size_t i = 0; i < class_count; ++i)
+            pools_[i] = node_pool((i + 1) * node_pool::alignment);
+    }
+
+    node_pool_resource(const node_pool_resource&) = delete;
+    node_pool_resource& operator=(const node_pool_resource&) = delete;
+
+    /**
+     * @brief 判断请求能否由内存池满足
+     */
+    static bool pooled(size_t bytes, size_t align) noexcept
+    {
+        return bytes != 0 && bytes <= max_block_size && align <= node_pool::alignment;
+    }
+
+    /**
+     * @brief 分配 bytes 字节，对齐到 align
+     */
+    void* allocate(size_t bytes, size_t align)
+    {
+        if (!pooled(bytes, align))
+            return ::operator new(bytes);
+        return pools_[index(bytes)].allocate();
+    }
+
+    /**
+     * @brief 归还 allocate(bytes, align) 分配的内存
+     */
+    void deallocate(void* p, size_t bytes, size_t align) noexcept
+    {
+        if (!pooled(bytes, align))
+            ::operator delete(p);
+        else
+            pools_[index(bytes)].deallocate(p);
+    }
+
+    /**
+     * @brief 整块释放所有级别的 chunk；直接由 operator new 分配的内存不受影响
+     */
+    void release() noexcept
+    {
+        for (size_t i = 0; i < class_count; ++i)
+            pools_[i].release();
+    }
+
+    /**
+     * @brief 所有级别持有的 chunk 总数
+     */
+    size_t chunk_count() const noexcept
+    {
+        size_t n = 0;
+        for (size_t i = 0; i < class_count; ++i)
+            n += pools_[i].chunk_count();
+        return n;
+    }
+
+private:
+    static size_t index(size_t bytes) noexcept
+    {
+        return (bytes - 1) / node_pool::alignment;
+    }
+
+private:
+    node_pool pools_[class_count];
+};
+
+/**
+ * @brief 使用 node_pool_resource 的标准分配器
+ *
+ * 节点容器每次只分配一个节点，这类请求由对应尺寸级别的 node_pool 满足；
+ * 其他请求（如一次分配多个对象）直接使用 operator new
+ *
+ * @tparam T 分配的对象类型
+ */
+template <class T>
+class pool_allocator
+{
+    template <class U> friend class pool_allocator;
+
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type  propagate_on_container_move_assignment;
+    typedef std::true_type  propagate_on_container_swap;
+
+    template <class U>
+    struct rebind
+    {
+        typedef pool_allocator<U> other;
+    };
+
+    /**
+     * @brief 默认构造函数，创建一个新的内存池
+     */
+    pool_allocator() : res_(std::make_shared<node_pool_resource>()) {}
+
+    /**
+     * @brief 拷贝构造函数，与 rhs 共享内存池
+     * 没有移动构造函数：被移动的分配器仍然持有内存池，保证原容器依旧可用
+     */
+    pool_allocator(const pool_allocator& rhs) noexcept : res_(rhs.res_) {}
+
+    /**
+     * @brief rebind 构造函数，与 rhs 共享内存池
+     */
+    template <class U>
+    pool_allocator(const pool_allocator<U>& rhs) noexcept : res_(rhs.res_) {}
+
+    pool_allocator& operator=(const pool_allocator& rhs) noexcept
+    {
+        res_ = rhs.res_;
+        return *this;
+    }
+
+    /**
+     * @brief 分配 n 个对象的内存
+     */
+    T* allocate(size_t n)
+    {
+        if (n == 1)
+            return static_cast<T*>(res_->allocate(sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    /**
+     * @brief 归还 allocate(n) 分配的内存
+     */
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (n == 1)
+            res_->deallocate(p, sizeof(T), alignof(T));
+        else
+            ::operator delete(p);
+    }
+
+    /**
+     * @brief 容器拷贝构造时使用新的内存池，使副本可以独立地整块释放
+     */
+    pool_allocator select_on_container_copy_construction() const
+    {
+        return pool_allocator();
+    }
+
+    /**
+     * @brief 如果当前分配器是内存池唯一的持有者，整块释放所有 chunk
+     * @return 是否进行了释放
+     */
+    bool release_if_unique() noexcept
+    {
+        if (res_.use_count() != 1)
+            return false;
+        res_->release();
+        return true;
+    }
+
+    /**
+     * @brief 当前分配器是否是内存池唯一的持有者
+     */
+    bool unique() const noexcept { return res_.use_count() == 1; }
+
+    /**
+     * @brief 获取底层的内存池
+     */
+    node_pool_resource* resource() const noexcept { return res_.get(); }
+
+    template <class U>
+    bool operator==(const pool_allocator<U>& rhs) const noexcept { return res_ == rhs.res_; }
+
+    template <class U>
+    bool operator!=(const pool_allocator<U>& rhs) const noexcept { return res_ != rhs.res_; }
+
+private:
+    std::shared_ptr<node_pool_resource> res_;
+};
+
+/**
+ * @brief 节点容器 clear() 时调用：能否整块释放节点内存
+ *
+ * 通用分配器不支持整块释放，容器需要逐个归还节点
+ */
+template <class Alloc>
+bool node_alloc_can_release(const Alloc&) noexcept
+{
+    return false;
+}
+
+template <class T>
+bool node_alloc_can_release(const pool_allocator<T>& alloc) noexcept
+{
+    return alloc.unique();
+}
+
+/**
+ * @brief 整块释放节点内存，只有 node_alloc_can_release 返回 true 时才能调用
+ */
+template <class Alloc>
+void node_alloc_release(Alloc&) noexcept
+{
+}
+
+template <class T>
+void node_alloc_release(pool_allocator<T>& alloc) noexcept
+{
+    alloc.release_if_unique();
+}
+
+/**
+ * @brief 节点容器中节点以外的数组（如哈希表的桶数组）使用的分配器
+ *
+ * 一般由节点分配器 rebind 得到，与节点来自同一内存来源（如 pmr 缓冲区）。
+ * pool_allocator 只为单个节点服务，而且容器多持有一份副本后 clear() 就不再是内存池唯一的持有者、
+ * 无法整块释放，因此这类数组改用 std::allocator
+ * @tparam Alloc 节点分配器类型
+ * @tparam U 数组元素类型
+ */
+template <class Alloc, class U>
+struct node_aux_allocator
+{
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U> type;
+
+    static type make(const Alloc& alloc) noexcept { return type(alloc); }
+};
+
+template <class T, class U>
+struct node_aux_allocator<pool_allocator<T>, U>
+{
+    typedef std::allocator<U> type;
+
+    static type make(const pool_allocator<T>&) noexcept { return type(); }
+};
+
+/**
+ * @brief 节点句柄：从节点容器中摘下的一个节点，连同节点分配器的副本
+ *
+ * 与 C++17 的 node handle 相同：只能移动，析构时销毁元素并归还节点。
+ * 用 insert 放回分配器相等的同类容器时，不分配也不复制元素；
+ * 可以通过 key() 修改 map 节点的键，再放回容器完成改键
+ *
+ * @tparam Node 节点类型，元素保存在成员 value 中
+ * @tparam Alloc 容器的分配器类型
+ * @tparam Traits 值特性类，提供 key_type / mapped_type / value_type
+ */
+template <class Node, class Alloc, class Traits>
+class node_handle
+{
+    friend struct node_handle_access;
+
+    typedef Node*                                                            node_pointer;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> node_allocator;
+    typedef std::allocator_traits<node_allocator>                            node_alloc_traits;
+
+public:
+    typedef typename Traits::key_type    key_type;
+    typedef typename Traits::mapped_type mapped_type;
+    typedef typename Traits::value_type  value_type;
+    typedef Alloc                        allocator_type;
+
+    /**
+     * @brief 构造空的句柄，不构造分配器
+     */
+    constexpr node_handle() noexcept : ptr_(nullptr) {}
+
+    node_handle(node_handle&& rhs) noexcept : ptr_(rhs.ptr_)
+    {
+        if (ptr_)
+        {
+            ::new (static_cast<void*>(std::addressof(alloc_))) node_allocator(rhs.alloc_);
+            rhs.release();
+        }
+    }
+
+    /**
+     * @brief 移动赋值，先销毁本句柄持有的节点
+     */
+    node_handle& operator=(node_handle&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            reset();
+            if (rhs.ptr_)
+            {
+                ptr_ = rhs.ptr_;
+                ::new (static_cast<void*>(std::addressof(alloc_))) node_allocator(rhs.alloc_);
+                rhs.release();
+            }
+        }
+        return *this;
+    }
+
+    node_handle(const node_handle&) = delete;
+    node_handle& operator=(const node_handle&) = delete;
+
+    ~node_handle() { reset(); }
+
+    /**
+     * @brief 句柄是否为空
+     */
+    bool empty() const noexcept { return ptr_ == nullptr; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    /**
+     * @brief 获取分配器，句柄不能为空
+     */
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    /**
+     * @brief set 节点的元素，句柄不能为空
+     */
+    value_type& value() const noexcept { return ptr_->value; }
+
+    /**
+     * @brief map 节点的键，可以修改；句柄不能为空
+     */
+    key_type& key() const noexcept { return const_cast<key_type&>(ptr_->value.first); }
+
+    /**
+     * @brief map 节点的实值，句柄不能为空
+     */
+    mapped_type& mapped() const noexcept { return ptr_->value.second; }
+
+    void swap(node_handle& rhs) noexcept
+    {
+        node_handle tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(node_handle& lhs, node_handle& rhs) noexcept { lhs.swap(rhs); }
+
+private:
+    node_handle(node_pointer p, const node_allocator& alloc) : ptr_(p)
+    {
+        ::new (static_cast<void*>(std::addressof(alloc_))) node_allocator(alloc);
+    }
+
+    /**
+     * @brief 放弃节点的所有权，只析构分配器
+     */
+    void release() noexcept
+    {
+        alloc_.~node_allocator();
+        ptr_ = nullptr;
+    }
+
+    /**
+     * @brief 销毁元素、归还节点
+     */
+    void reset() noexcept
+    {
+        if (ptr_)
+        {
+            node_alloc_traits::destroy(alloc_, std::addressof(ptr_->value));
+            node_alloc_traits::deallocate(alloc_, ptr_, 1);
+            release();
+        }
+    }
+
+    node_pointer ptr_;
+    union { node_allocator alloc_; };  // 只在句柄非空时构造
+};
+
+/**
+ * @brief 容器创建和拆开节点句柄的入口，句柄的构造函数不对用户开放
+ */
+struct node_handle_access
+{
+    template <class Handle, class NodePtr, class NodeAlloc>
+    static Handle make(NodePtr p, const NodeAlloc& alloc)
+    {
+        return Handle(p, alloc);
+    }
+
+    /**
+     * @brief 取出节点，句柄变为空
+     */
+    template <class Handle>
+    static typename Handle::node_pointer release(Handle& nh) noexcept
+    {
+        auto p = nh.ptr_;
+        nh.release();
+        return p;
+    }
+
+    template <class Handle>
+    static typename Handle::node_pointer node(const Handle& nh) noexcept
+    {
+        return nh.ptr_;
+    }
+
+    template <class Handle>
+    static const typename Handle::node_allocator& allocator(const Handle& nh) noexcept
+    {
+        return nh.alloc_;
+    }
+};
+
+/**
+ * @brief 不允许重复键值的容器插入节点句柄的结果
+ *
+ * 插入失败时节点仍在 node 中，position 指向已有的相同键值的元素
+ */
+template <class Iterator, class NodeHandle>
+struct node_insert_return
+{
+    Iterator   position;
+    bool       inserted;
+    NodeHandle node;
+};
+
+} // namespace mystl
+
+#endif // MY_NODE_POOL_H
@@ -0,0 +1,223 @@
+// test_node_pool.cpp
+// 测试 node_pool、pool_allocator 以及使用 pool_allocator 的节点容器
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include "my_node_pool.h"
+#include "../my_list/my_list.h"
+#include "../my_map/my_map.h"
+#include "../my_set/my_set.h"
+#include "../my_unordered_map/my_unordered_map.h"
+#include "../my_unordered_set/unordered_set.h"
+
+/**
+ * @brief 测试 node_pool 的分配、复用与整块释放
+ */
+void test_node_pool_basic() {
+    std::cout << "===== 测试 node_pool 基本功能 =====" << std::endl;
+
+    mystl::node_pool pool(24);
+    assert(pool.block_size() % mystl::node_pool::alignment == 0);
+    assert(pool.block_size() >= 24);
+    assert(pool.chunk_count() == 0);  // 构造时不分配内存
+
+    // 分配的块互不重叠且满足对齐要求
+    std::vector<void*> blocks;
+    std::set<void*> unique_blocks;
+    for (int i = 0; i < 1000; ++i) {
+        void* p = pool.allocate();
+        assert(reinterpret_cast<std::uintptr_t>(p) % mystl::node_pool::alignment == 0);
+        blocks.push_back(p);
+        unique_blocks.insert(p);
+    }
+    assert(unique_blocks.size() == blocks.size());
+    // chunk 的块数成倍增长：32 + 64 + 128 + 256 + 512 < 1000 <= ... + 1024
+    assert(pool.chunk_count() == 6);
+
+    // 归还的块会被优先复用
+    pool.deallocate(blocks[10]);
+    assert(pool.allocate() == blocks[10]);
+
+    // 整块释放
+    pool.release();
+    assert(pool.chunk_count() == 0);
+    void* p = pool.allocate();
+    assert(p != nullptr);
+    assert(pool.chunk_count() == 1);
+
+    // 移动后原内存池为空
+    mystl::node_pool pool2(std::move(pool));
+    assert(pool2.chunk_count() == 1);
+    assert(pool.chunk_count() == 0);
+
+    std::cout << "node_pool 基本功能测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试 pool_allocator 的相等性、rebind 与分配
+ */
+void test_pool_allocator() {
+    std::cout << "\n===== 测试 pool_allocator =====" << std::endl;
+
+    mystl::pool_allocator<int> a;
+    mystl::pool_allocator<int> b;
+    assert(a != b);  // 默认构造的分配器各自拥有内存池
+    assert(a.unique());
+
+    mystl::pool_allocator<double> c(a);  // rebind 后共享内存池
+    assert(c == a);
+    assert(!a.unique());
+
+    int* p = a.allocate(1);
+    *p = 42;
+    assert(a.resource()->chunk_count() == 1);
+    a.deallocate(p, 1);
+
+    // 一次分配多个对象时不经过内存池
+    int* arr = a.allocate(100);
+    arr[99] = 1;
+    a.deallocate(arr, 100);
+    assert(a.resource()->chunk_count() == 1);
+
+    // 只有唯一持有者才能整块释放
+    assert(!a.release_if_unique());
+    {
+        mystl::pool_allocator<int> d;
+        d.allocate(1);
+        assert(d.release_if_unique());
+        assert(d.resource()->chunk_count() == 0);
+    }
+
+    // 拷贝构造容器时得到新的内存池
+    assert(std::allocator_traits<mystl::pool_allocator<int>>::
+           select_on_container_copy_construction(a) != a);
+
+    std::cout << "pool_allocator 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试使用 pool_allocator 的 map、set 与 list
+ */
+void test_pooled_tree_and_list() {
+    std::cout << "\n===== 测试使用内存池的 map/set/list =====" << std::endl;
+
+    typedef my::map<int, std::string, std::less<int>,
+                    mystl::pool_allocator<std::pair<const int, std::string>>> pooled_map;
+    pooled_map m;
+    for (int i = 0; i < 10000; ++i) {
+        m[i] = std::to_string(i);
+    }
+    assert(m.size() == 10000);
+    assert(m.at(1234) == "1234");
+    assert(m.get_allocator().resource()->chunk_count() > 0);
+
+    // 拷贝得到独立的内存池，clear 之后副本不受影响
+    pooled_map copy(m);
+    assert(copy.get_allocator() != m.get_allocator());
+    m.clear();
+    assert(m.empty());
+    assert(m.get_allocator().resource()->chunk_count() == 0);  // 整块释放
+    assert(copy.size() == 10000);
+    assert(copy.at(9999) == "9999");
+
+    // clear 之后继续使用
+    m[1] = "one";
+    assert(m.size() == 1 && m.at(1) == "one");
+
+    // 移动后原容器依旧可用
+    pooled_map moved(std::move(copy));
+    assert(moved.size() == 10000);
+    copy[5] = "five";
+    assert(copy.size() == 1);
+
+    mystl::multiset<int, std::less<int>, mystl::pool_allocator<int>> ms;
+    for (int i = 0; i < 1000; ++i) {
+        ms.insert(i % 10);
+    }
+    assert(ms.count(3) == 100);
+    ms.erase(3);
+    assert(ms.count(3) == 0);
+
+    // list：共享同一内存池的链表之间 splice 只重新链接节点
+    typedef mystl::list<std::string, mystl::pool_allocator<std::string>> pooled_list;
+    pooled_list l1;
+    for (int i = 0; i < 100; ++i) {
+        l1.push_back(std::to_string(i));
+    }
+    l1.sort([](const std::string& a, const std::string& b) { return std::stoi(a) > std::stoi(b); });
+    assert(l1.front() == "99" && l1.back() == "0");
+
+    // 不同内存池之间 splice 时逐个移动元素
+    pooled_list l2;
+    l2.push_back("x");
+    l2.splice(l2.end(), l1);
+    assert(l1.empty());
+    assert(l2.size() == 101);
+    assert(l2.front() == "x" && l2.back() == "0");
+
+    pooled_list l3;
+    l3.splice(l3.begin(), l2, l2.begin());
+    assert(l3.size() == 1 && l3.front() == "x");
+    assert(l2.size() == 100 && l2.front() == "99");
+
+    l2.clear();
+    assert(l2.get_allocator().resource()->chunk_count() == 0);
+
+    std::cout << "使用内存池的 map/set/list 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试使用 pool_allocator 的 unordered_map 与 unordered_set
+ */
+void test_pooled_hashtable() {
+    std::cout << "\n===== 测试使用内存池的 unordered_map/unordered_set =====" << std::endl;
+
+    typedef mystl::unordered_map<std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                                 mystl::pool_allocator<std::pair<const std::string, int>>> pooled_umap;
+    pooled_umap um;
+    for (int i = 0; i < 20000; ++i) {
+        um["key-" + std::to_string(i)] = i;
+    }
+    assert(um.size() == 20000);
+    assert(um.at("key-777") == 777);
+    assert(um.erase("key-777") == 1);
+
+    pooled_umap copy(um);
+    assert(copy.size() == 19999);
+
+    um.clear();
+    assert(um.empty());
+    assert(um.get_allocator().resource()->chunk_count() == 0);
+    assert(copy.at("key-19999") == 19999);
+
+    um.swap(copy);
+    assert(um.size() == 19999);
+    assert(copy.empty());
+
+    mystl::unordered_set<int, std::hash<int>, std::equal_to<int>, mystl::pool_allocator<int>> us;
+    for (int i = 0; i < 5000; ++i) {
+        us.insert(i);
+    }
+    assert(us.size() == 5000);
+    us.clear();
+    us.insert(7);
+    assert(us.count(7) == 1);
+
+    std::cout << "使用内存池的 unordered_map/unordered_set 测试通过!" << std::endl;
+}
+
+int main() {
+    test_node_pool_basic();
+    test_pool_allocator();
+    test_pooled_tree_and_list();
+    test_pooled_hashtable();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "my_node_pool.h"
+#include "../my_map/my_map.h"
+#include "../my_unordered_map/my_unordered_map.h"
+
+/**
+ * 计时器类，用于测量一段代码的执行时间
+ */
+class Timer {
+private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_time;
+
+public:
+    Timer() : start_time(std::chrono::high_resolution_clock::now()) {}
+
+    /**
+     * 返回从构造到现在经过的毫秒数
+     */
+    double elapsed_ms() const {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    }
+};
+
+/**
+ * 生成随机数据
+ */
+std::vector<int> generate_random_data(size_t size) {
+    std::vector<int> data(size);
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> distrib(0, 1000000000);
+    for (auto& val : data) {
+        val = distrib(gen);
+    }
+    return data;
+}
+
+/**
+ * 构建容器、查找全部元素并清空，分别输出三段耗时
+ */
+template <class Map>
+void run(const char* name, const std::vector<int>& data) {
+    Map m;
+    Timer build;
+    for (auto v : data) {
+        m.emplace(v, v);
+    }
+    const double build_ms = build.elapsed_ms();
+
+    long long sum = 0;
+    Timer lookup;
+    for (auto v : data) {
+        sum += m.find(v)->second;
+    }
+    const double lookup_ms = lookup.elapsed_ms();
+
+    Timer clear;
+    m.clear();
+    const double clear_ms = clear.elapsed_ms();
+
+    std::cout << "  " << name
+              << "  构建: " << build_ms << " ms"
+              << "  查找: " << lookup_ms << " ms"
+              << "  清空: " << clear_ms << " ms"
+              << "  (校验和 " << sum << ")" << std::endl;
+}
+
+void test_map_performance() {
+    std::cout << "\n=== map: std::allocator 与 pool_allocator ===" << std::endl;
+
+    typedef std::pair<const int, int> value_type;
+    typedef my::map<int, int> std_map;
+    typedef my::map<int, int, std::less<int>, mystl::pool_allocator<value_type>> pool_map;
+
+    const std::vector<size_t> sizes = {100000, 1000000};
+    for (auto size : sizes) {
+        auto data = generate_random_data(size);
+        std::cout << " 数据量: " << size << std::endl;
+        run<std_map>("std::allocator ", data);
+        run<pool_map>("pool_allocator ", data);
+    }
+}
+
+void test_unordered_map_performance() {
+    std::cout << "\n=== unordered_map: std::allocator 与 pool_allocator ===" << std::endl;
+
+    typedef std::pair<const int, int> value_type;
+    typedef mystl::unordered_map<int, int> std_map;
+    typedef mystl::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                                 mystl::pool_allocator<value_type>> pool_map;
+
+    const std::vector<size_t> sizes = {100000, 1000000};
+    for (auto size : sizes) {
+        auto data = generate_random_data(size);
+        std::cout << " 数据量: " << size << std::endl;
+        run<std_map>("std::allocator ", data);
+        run<pool_map>("pool_allocator ", data);
+    }
+}
+
+int main() {
+    std::cout << "===== 节点内存池性能测试 =====" << std::endl;
+
+    test_map_performance();
+    test_unordered_map_performance();
+
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include <type_traits>
 #include <utility>
 #include <initializer_list>
+#include <memory>
 
 namespace mystl
 {
@@ -122,6 +123,67 @@ public:
     {
     }
 
+    // 带分配器的构造函数，仅当底层容器使用 Alloc 类型的分配器时参与重载
+
+    /**
+     * @brief 使用指定分配器构造空队列
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    explicit queue(const Alloc& alloc)
+        : c_(alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器从底层容器构造队列
+     * @param c 底层容器
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    queue(const Container& c, const Alloc& alloc)
+        : c_(c, alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器从底层容器移动构造队列
+     * @param c 右值容器引用
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    queue(Container&& c, const Alloc& alloc)
+        : c_(std::move(c), alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器拷贝构造队列
+     * @param rhs 源队列
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    queue(const queue& rhs, const Alloc& alloc)
+        : c_(rhs.c_, alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器移动构造队列
+     * @param rhs 源队列右值引用
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    queue(queue&& rhs, const Alloc& alloc)
+        : c_(std::move(rhs.c_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源队列
@@ -572,6 +634,81 @@ public:
         my_make_heap(c_.begin(), c_.end(), comp_);
     }
 
+    // 带分配器的构造函数，仅当底层容器使用 Alloc 类型的分配器时参与重载
+
+    /**
+     * @brief 使用指定分配器构造空优先队列
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    explicit priority_queue(const Alloc& alloc)
+        : c_(alloc), comp_()
+    {
+    }
+
+    /**
+     * @brief 使用比较器和指定分配器构造空优先队列
+     * @param c 比较器
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    priority_queue(const Compare& c, const Alloc& alloc)
+        : c_(alloc), comp_(c)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器从已有容器构造优先队列
+     * @param s 容器
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    priority_queue(const Container& s, const Alloc& alloc)
+        : c_(s, alloc), comp_()
+    {
+        my_make_heap(c_.begin(), c_.end(), comp_);
+    }
+
+    /**
+     * @brief 使用指定分配器移动已有容器构造优先队列
+     * @param s 右值容器引用
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    priority_queue(Container&& s, const Alloc& alloc)
+        : c_(std::move(s), alloc), comp_()
+    {
+        my_make_heap(c_.begin(), c_.end(), comp_);
+    }
+
+    /**
+     * @brief 使用指定分配器拷贝构造优先队列，源队列已满足堆序，无需重新建堆
+     * @param rhs 源优先队列
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    priority_queue(const priority_queue& rhs, const Alloc& alloc)
+        : c_(rhs.c_, alloc), comp_(rhs.comp_)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器移动构造优先队列
+     * @param rhs 源优先队列右值引用
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    priority_queue(priority_queue&& rhs, const Alloc& alloc)
+        : c_(std::move(rhs.c_), alloc), comp_(rhs.comp_)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源优先队列
@@ -755,4 +892,28 @@ void swap(priority_queue<T, Container, Compare>& lhs,
 }
 
 } // namespace mystl
+
+namespace std
+{
+
+/**
+ * @brief 队列是否使用 Alloc 类型的分配器，由底层容器决定
+ */
+template <class T, class Container, class Alloc>
+struct uses_allocator<mystl::queue<T, Container>, Alloc>
+    : uses_allocator<Container, Alloc>::type
+{
+};
+
+/**
+ * @brief 优先队列是否使用 Alloc 类型的分配器，由底层容器决定
+ */
+template <class T, class Container, class Compare, class Alloc>
+struct uses_allocator<mystl::priority_queue<T, Container, Compare>, Alloc>
+    : uses_allocator<Container, Alloc>::type
+{
+};
+
+} // namespace std
+
 #endif // !MY_QUEUE_H_ 
\ No newline at end of file
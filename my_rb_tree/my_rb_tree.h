@@ -24,6 +24,13 @@
  * 8. 左右子树：平衡时对左右子树采用对称处理，减少代码冗余
  * 9. 边界更新：插入和删除操作中直接维护最左和最右节点，提高边界元素访问性能
  * 10. 空间优化：使用颜色位(bool)而非枚举，减少内存占用
+ * 11. 批量构建：向空树插入一段有序的元素时直接构建平衡树并着色，O(n)，不做比较查找和旋转
+ * 12. 顺序统计：OrderStatistics 为 true 时每个节点记录子树大小，按序号取元素、求键的排名、
+ *     计数和迭代器距离均为O(log n)；默认关闭，普通红黑树的节点和插入删除不受影响
+ * 13. 拼接与拆分：join / split 沿边缘按黑高挂入或沿查找路径拆开，O(log n)；合并、交集、差集在其上递归实现，
+ *     O(m log(n/m + 1))，节点在树之间直接转移。公开的 split(key, rhs) 还要得到两侧的元素个数，
+ *     普通红黑树没有子树大小，只能逐个计数，最坏O(n)；集合运算内部只拆分子树，不计数
+ * 14. 节点句柄：extract 摘下节点、insert 放回，改键或在容器之间转移元素时不分配也不复制
  * 
  * 针对g++编译器的特定优化：
  * 1. 使用内联函数减少函数调用开销
@@ -33,6 +40,7 @@
  * 5. 使用constexpr使编译器在编译期计算常量表达式
  */
 
+#include <cstddef>
 #include <initializer_list>
 #include <cassert>
 #include <memory>
@@ -42,6 +50,9 @@
 #include <type_traits>
 #include <stdexcept>
 
+#include "../my_node_pool/my_node_pool.h"
+#include "../my_functional/my_functional.h"
+
 namespace mystl {
 
 // 定义红黑树节点颜色类型
@@ -52,11 +63,11 @@ static constexpr rb_tree_color_type rb_tree_red = false;
 static constexpr rb_tree_color_type rb_tree_black = true;
 
 // 前置声明
-template <class T> struct rb_tree_node_base;
-template <class T> struct rb_tree_node;
+template <class T, bool OrderStatistics = false> struct rb_tree_node_base;
+template <class T, bool OrderStatistics = false> struct rb_tree_node;
 
-template <class T> struct rb_tree_iterator;
-template <class T> struct rb_tree_const_iterator;
+template <class T, bool OrderStatistics = false> struct rb_tree_iterator;
+template <class T, bool OrderStatistics = false> struct rb_tree_const_iterator;
 
 /**
  * @brief 红黑树值特性
@@ -133,12 +144,43 @@ struct rb_tree_value_traits {
     }
 };
 
+/**
+ * @brief 判断 pair 类型的首成员去掉 cv 限定后是否为 Key
+ */
+template <class Key, class P>
+struct rb_tree_pair_first_is : std::false_type {};
+
+template <class Key, class T1, class T2>
+struct rb_tree_pair_first_is<Key, std::pair<T1, T2>>
+    : std::is_same<Key, typename std::remove_cv<T1>::type> {};
+
+/**
+ * @brief 判断能否在不构造元素的情况下从 emplace 参数中取得键值
+ * 
+ * 可以取得时 emplace_unique 先查找插入位置，键值重复时不分配节点：
+ * - 只有一个参数，且是完整的元素（set）或首成员为键的 pair（map）
+ * - map 有两个参数，且第一个参数就是键
+ */
+template <class Traits, class ...Args>
+struct rb_tree_key_extractable : std::false_type {};
+
+template <class Traits, class A>
+struct rb_tree_key_extractable<Traits, A>
+    : std::integral_constant<bool, Traits::is_map
+        ? rb_tree_pair_first_is<typename Traits::key_type, typename std::decay<A>::type>::value
+        : std::is_same<typename Traits::key_type, typename std::decay<A>::type>::value> {};
+
+template <class Traits, class A, class B>
+struct rb_tree_key_extractable<Traits, A, B>
+    : std::integral_constant<bool, Traits::is_map &&
+        std::is_same<typename Traits::key_type, typename std::decay<A>::type>::value> {};
+
 /**
  * @brief 红黑树节点特性
  * 
  * 定义红黑树节点相关的类型
  */
-template <class T>
+template <class T, bool OrderStatistics = false>
 struct rb_tree_node_traits {
     using color_type = rb_tree_color_type;
 
@@ -147,8 +189,21 @@ struct rb_tree_node_traits {
     using mapped_type = typename value_traits::mapped_type;
     using value_type = typename value_traits::value_type;
 
-    using base_ptr = rb_tree_node_base<T>*;
-    using node_ptr = rb_tree_node<T>*;
+    using base_ptr = rb_tree_node_base<T, OrderStatistics>*;
+    using node_ptr = rb_tree_node<T, OrderStatistics>*;
+};
+
+/**
+ * @brief 节点中的子树大小
+ * 
+ * 只有顺序统计红黑树的节点带有该字段，普通红黑树继承空基类，不占空间
+ */
+template <bool OrderStatistics>
+struct rb_tree_size_field {};
+
+template <>
+struct rb_tree_size_field<true> {
+    std::size_t size;  // 以该节点为根的子树的节点数，header 中不使用
 };
 
 /**
@@ -156,11 +211,14 @@ struct rb_tree_node_traits {
  * 
  * 包含红黑树节点的基本结构和指针
  */
-template <class T>
-struct rb_tree_node_base {
+template <class T, bool OrderStatistics>
+struct rb_tree_node_base : public rb_tree_size_field<OrderStatistics> {
     using color_type = rb_tree_color_type;
-    using base_ptr = rb_tree_node_base<T>*;
-    using node_ptr = rb_tree_node<T>*;
+    using base_ptr = rb_tree_node_base<T, OrderStatistics>*;
+    using node_ptr = rb_tree_node<T, OrderStatistics>*;
+
+    // 是否维护子树大小
+    static constexpr bool order_statistics = OrderStatistics;
 
     base_ptr parent;  // 父节点
     base_ptr left;    // 左子节点
@@ -188,10 +246,10 @@ struct rb_tree_node_base {
  * 
  * 继承基础节点，并包含实际的数据值
  */
-template <class T>
-struct rb_tree_node : public rb_tree_node_base<T> {
-    using base_ptr = typename rb_tree_node_base<T>::base_ptr;
-    using node_ptr = typename rb_tree_node_base<T>::node_ptr;
+template <class T, bool OrderStatistics>
+struct rb_tree_node : public rb_tree_node_base<T, OrderStatistics> {
+    using base_ptr = typename rb_tree_node_base<T, OrderStatistics>::base_ptr;
+    using node_ptr = typename rb_tree_node_base<T, OrderStatistics>::node_ptr;
 
     T value;  // 节点值
 
@@ -211,7 +269,7 @@ struct rb_tree_node : public rb_tree_node_base<T> {
  * 
  * 定义红黑树相关的类型特性
  */
-template <class T>
+template <class T, bool OrderStatistics = false>
 struct rb_tree_traits {
     using value_traits = rb_tree_value_traits<T>;
 
@@ -224,8 +282,8 @@ struct rb_tree_traits {
     using const_pointer = const value_type*;
     using const_reference = const value_type&;
 
-    using base_type = rb_tree_node_base<T>;
-    using node_type = rb_tree_node<T>;
+    using base_type = rb_tree_node_base<T, OrderStatistics>;
+    using node_type = rb_tree_node<T, OrderStatistics>;
 
     using base_ptr = base_type*;
     using node_ptr = node_type*;
@@ -236,7 +294,7 @@ struct rb_tree_traits {
  * 
  * 实现红黑树的双向迭代器，支持正向和反向遍历
  */
-template <class T>
+template <class T, bool OrderStatistics = false>
 struct rb_tree_iterator_base {
     using iterator_category = std::bidirectional_iterator_tag;
     using value_type = T;
@@ -244,7 +302,7 @@ struct rb_tree_iterator_base {
     using pointer = T*;
     using reference = T&;
     
-    using base_ptr = typename rb_tree_traits<T>::base_ptr;
+    using base_ptr = typename rb_tree_traits<T, OrderStatistics>::base_ptr;
 
     base_ptr node;  // 指向节点本身
 
@@ -313,10 +371,10 @@ struct rb_tree_iterator_base {
  * 
  * 实现红黑树的可读写迭代器
  */
-template <class T>
-struct rb_tree_iterator : public rb_tree_iterator_base<T> {
+template <class T, bool OrderStatistics>
+struct rb_tree_iterator : public rb_tree_iterator_base<T, OrderStatistics> {
     using iterator_category = std::bidirectional_iterator_tag;
-    using tree_traits = rb_tree_traits<T>;
+    using tree_traits = rb_tree_traits<T, OrderStatistics>;
 
     using value_type = typename tree_traits::value_type;
     using pointer = typename tree_traits::pointer;
@@ -326,11 +384,11 @@ struct rb_tree_iterator : public rb_tree_iterator_base<T> {
     using base_ptr = typename tree_traits::base_ptr;
     using node_ptr = typename tree_traits::node_ptr;
 
-    using iterator = rb_tree_iterator<T>;
-    using const_iterator = rb_tree_const_iterator<T>;
+    using iterator = rb_tree_iterator<T, OrderStatistics>;
+    using const_iterator = rb_tree_const_iterator<T, OrderStatistics>;
     using self = iterator;
 
-    using rb_tree_iterator_base<T>::node;
+    using rb_tree_iterator_base<T, OrderStatistics>::node;
 
     // 构造函数
     rb_tree_iterator() noexcept = default;
@@ -376,10 +434,10 @@ struct rb_tree_iterator : public rb_tree_iterator_base<T> {
  * 
  * 实现红黑树的只读迭代器
  */
-template <class T>
-struct rb_tree_const_iterator : public rb_tree_iterator_base<T> {
+template <class T, bool OrderStatistics>
+struct rb_tree_const_iterator : public rb_tree_iterator_base<T, OrderStatistics> {
     using iterator_category = std::bidirectional_iterator_tag;
-    using tree_traits = rb_tree_traits<T>;
+    using tree_traits = rb_tree_traits<T, OrderStatistics>;
 
     using value_type = typename tree_traits::value_type;
     using pointer = typename tree_traits::const_pointer;
@@ -389,11 +447,11 @@ struct rb_tree_const_iterator : public rb_tree_iterator_base<T> {
     using base_ptr = typename tree_traits::base_ptr;
     using node_ptr = typename tree_traits::node_ptr;
 
-    using iterator = rb_tree_iterator<T>;
-    using const_iterator = rb_tree_const_iterator<T>;
+    using iterator = rb_tree_iterator<T, OrderStatistics>;
+    using const_iterator = rb_tree_const_iterator<T, OrderStatistics>;
     using self = const_iterator;
 
-    using rb_tree_iterator_base<T>::node;
+    using rb_tree_iterator_base<T, OrderStatistics>::node;
 
     // 构造函数
     rb_tree_const_iterator() noexcept = default;
@@ -513,6 +571,119 @@ NodePtr rb_tree_next(NodePtr node) noexcept {
     return node->parent;
 }
 
+/**
+ * @brief 返回子树的节点数，空子树为 0，只用于顺序统计红黑树
+ */
+template <class NodePtr>
+std::size_t rb_tree_subtree_size(NodePtr node) noexcept {
+    return node == nullptr ? 0 : node->size;
+}
+
+/**
+ * @brief 旋转、插入、删除时维护子树大小
+ * 
+ * 普通红黑树使用空实现，编译后不留下任何代码
+ */
+template <bool OrderStatistics>
+struct rb_tree_size_ops {
+    template <class NodePtr>
+    static void rotated(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void inserted(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void unlinking(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void copy(NodePtr, NodePtr) noexcept {}
+    template <class NodePtr>
+    static void assign(NodePtr, std::size_t) noexcept {}
+    template <class NodePtr>
+    static void update(NodePtr) noexcept {}
+    template <class NodePtr>
+    static void spliced(NodePtr, NodePtr, NodePtr) noexcept {}
+};
+
+template <>
+struct rb_tree_size_ops<true> {
+    /**
+     * @brief x 被旋转到 y 之下：y 接管 x 原来的整棵子树，x 按新的左右子树重新计算
+     */
+    template <class NodePtr>
+    static void rotated(NodePtr x, NodePtr y) noexcept {
+        y->size = x->size;
+        update(x);
+    }
+
+    /**
+     * @brief 新叶子 x 已连接到树中，它的所有祖先都多了一个后代
+     */
+    template <class NodePtr>
+    static void inserted(NodePtr x, NodePtr root) noexcept {
+        x->size = 1;
+        grow_ancestors(x, root, 1);
+    }
+
+    /**
+     * @brief y 所在的位置即将从树中消失，它的所有祖先都少了一个后代
+     */
+    template <class NodePtr>
+    static void unlinking(NodePtr y, NodePtr root) noexcept {
+        for (auto p = y; p != root; ) {
+            p = p->parent;
+            --p->size;
+        }
+    }
+
+    /**
+     * @brief dst 取代 src 的位置，或者是 src 的副本
+     */
+    template <class NodePtr>
+    static void copy(NodePtr dst, NodePtr src) noexcept {
+        dst->size = src->size;
+    }
+
+    /**
+     * @brief 批量构建时直接写入子树大小
+     */
+    template <class NodePtr>
+    static void assign(NodePtr x, std::size_t n) noexcept {
+        x->size = n;
+    }
+
+    /**
+     * @brief 按左右子树重新计算 x 的子树大小
+     */
+    template <class NodePtr>
+    static void update(NodePtr x) noexcept {
+        x->size = rb_tree_subtree_size(x->left) + rb_tree_subtree_size(x->right) + 1;
+    }
+
+    /**
+     * @brief 拼接时 x 取代了子树 c 的位置，c 成为 x 的子树，x 的所有祖先都多了 size(x) - size(c) 个后代
+     */
+    template <class NodePtr>
+    static void spliced(NodePtr x, NodePtr c, NodePtr root) noexcept {
+        update(x);
+        grow_ancestors(x, root, x->size - rb_tree_subtree_size(c));
+    }
+
+    /**
+     * @brief x 之下多了 n 个节点，它的所有祖先都加上 n
+     */
+    template <class NodePtr>
+    static void grow_ancestors(NodePtr x, NodePtr root, std::size_t n) noexcept {
+        for (auto p = x; p != root; ) {
+            p = p->parent;
+            p->size += n;
+        }
+    }
+};
+
+/**
+ * @brief 按节点类型选择子树大小的维护方式
+ */
+template <class NodePtr>
+using rb_tree_size_ops_of = rb_tree_size_ops<std::remove_pointer<NodePtr>::type::order_statistics>;
+
 /**
  * @brief 红黑树左旋操作
  * 
@@ -554,6 +725,8 @@ void rb_tree_rotate_left(NodePtr x, NodePtr& root) noexcept {
     // 重新构建x和y的关系
     y->left = x;
     x->parent = y;
+
+    rb_tree_size_ops_of<NodePtr>::rotated(x, y);
 }
 
 /**
@@ -597,25 +770,21 @@ void rb_tree_rotate_right(NodePtr x, NodePtr& root) noexcept {
     // 重新构建x和y的关系
     y->right = x;
     x->parent = y;
+
+    rb_tree_size_ops_of<NodePtr>::rotated(x, y);
 }
 
 /**
- * @brief 插入节点后使红黑树重新平衡
- * 
- * 优化说明:
- * 1. 使用迭代而非递归，减少栈开销
- * 2. 处理最常见的情况（case 3 和 case 5）优先，提高性能
- * 3. 左右子树对称处理，减少代码冗余
- * 4. 条件判断顺序经过优化，减少比较次数
- * 5. 将新节点默认设置为红色，降低树高度调整概率
+ * @brief 把节点x染红后消除连续的红色节点
  * 
- * 时间复杂度: O(log n)
+ * 调整结束时根节点可能是红色，由调用者处理：插入时直接染黑，
+ * 合并子树时染黑的同时黑高加一
  * 
- * @param x 新插入的节点
+ * @param x 新连接到树中的节点
  * @param root 根节点
  */
 template <class NodePtr>
-void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
+void rb_tree_insert_fixup(NodePtr x, NodePtr& root) noexcept {
     // 新节点默认为红色
     rb_tree_set_red(x);
     
@@ -671,7 +840,30 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
             }
         }
     }
-    
+}
+
+
+/**
+ * @brief 插入节点后使红黑树重新平衡
+ * 
+ * 优化说明:
+ * 1. 使用迭代而非递归，减少栈开销
+ * 2. 处理最常见的情况（case 3 和 case 5）优先，提高性能
+ * 3. 左右子树对称处理，减少代码冗余
+ * 4. 条件判断顺序经过优化，减少比较次数
+ * 5. 将新节点默认设置为红色，降低树高度调整概率
+ * 6. 顺序统计红黑树调整前先把新节点到根节点路径上的子树大小加一，旋转时再局部修正
+ * 
+ * 时间复杂度: O(log n)
+ * 
+ * @param x 新插入的节点，已经连接到父节点上
+ * @param root 根节点
+ */
+template <class NodePtr>
+void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
+    rb_tree_size_ops_of<NodePtr>::inserted(x, root);
+    rb_tree_insert_fixup(x, root);
+
     // 根节点始终为黑色
     rb_tree_set_black(root);
 }
@@ -685,6 +877,7 @@ void rb_tree_insert_rebalance(NodePtr x, NodePtr& root) noexcept {
  * 3. 针对被删节点颜色是黑色的情况专门处理，维持红黑树性质
  * 4. 通过指针直接操作，避免节点复制带来的性能损失
  * 5. 左右子树对称处理，减少代码冗余并提高可维护性
+ * 6. 顺序统计红黑树摘除前先把实际被摘除位置到根节点路径上的子树大小减一，旋转时再局部修正
  * 
  * 时间复杂度: O(log n)
  * 
@@ -703,6 +896,9 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
     // xp为x的父节点
     NodePtr xp = nullptr;
 
+    // y所在的位置将从树中消失，y != z 时z也在y的祖先之中
+    rb_tree_size_ops_of<NodePtr>::unlinking(y, root);
+
     // 处理删除节点的情况
     if (y != z) {
         // z有两个非空子节点的情况
@@ -734,6 +930,7 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
             z->parent->right = y;
         }
         y->parent = z->parent;
+        rb_tree_size_ops_of<NodePtr>::copy(y, z);
         std::swap(y->color, z->color);
         y = z; // y现在指向要删除的节点
     } else {
@@ -860,12 +1057,16 @@ NodePtr rb_tree_erase_rebalance(NodePtr z, NodePtr& root, NodePtr& leftmost, Nod
  * 
  * @tparam T 存储的数据类型
  * @tparam Compare 比较器类型，用于比较键值
+ * @tparam Alloc 分配器类型，节点通过 rebind 后的分配器分配，
+ *         可以使用 pool_allocator 从内存池中分配节点
+ * @tparam OrderStatistics 为 true 时每个节点多记录一个子树大小，
+ *         提供 O(log n) 的 nth、rank、index_of、distance 和 count_multi
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc = std::allocator<T>, bool OrderStatistics = false>
 class rb_tree {
 public:
     // 类型定义
-    using tree_traits = rb_tree_traits<T>;
+    using tree_traits = rb_tree_traits<T, OrderStatistics>;
     using value_traits = rb_tree_value_traits<T>;
 
     using base_type = typename tree_traits::base_type;
@@ -876,34 +1077,48 @@ public:
     using mapped_type = typename tree_traits::mapped_type;
     using value_type = typename tree_traits::value_type;
     using key_compare = Compare;
-
-    using allocator_type = std::allocator<T>;
-    using data_allocator = std::allocator<T>;
+    // 是否维护子树大小
+    using order_statistics = std::integral_constant<bool, OrderStatistics>;
+
+    using allocator_type = Alloc;
+    // 节点由 Alloc rebind 得到的分配器分配；header_ 只有一个，仍由 std::allocator 分配，
+    // 这样分配器整块释放节点内存时不会影响 header_
+    using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
+    using node_alloc_traits = std::allocator_traits<node_allocator>;
     using base_allocator = std::allocator<base_type>;
-    using node_allocator = std::allocator<node_type>;
 
-    using pointer = typename allocator_type::pointer;
-    using const_pointer = typename allocator_type::const_pointer;
-    using reference = typename allocator_type::reference;
-    using const_reference = typename allocator_type::const_reference;
-    using size_type = typename allocator_type::size_type;
-    using difference_type = typename allocator_type::difference_type;
+    using pointer = typename std::allocator_traits<Alloc>::pointer;
+    using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using size_type = typename std::allocator_traits<Alloc>::size_type;
+    using difference_type = typename std::allocator_traits<Alloc>::difference_type;
 
-    using iterator = rb_tree_iterator<T>;
-    using const_iterator = rb_tree_const_iterator<T>;
+    using iterator = rb_tree_iterator<T, OrderStatistics>;
+    using const_iterator = rb_tree_const_iterator<T, OrderStatistics>;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    // 节点句柄：extract 摘下的节点，insert 时放回
+    using node_handle_type = mystl::node_handle<node_type, Alloc, value_traits>;
+    using insert_return_type = node_insert_return<iterator, node_handle_type>;
+
     // 获取分配器
-    allocator_type get_allocator() const { return node_allocator(); }
+    allocator_type get_allocator() const { return allocator_type(node_alloc_); }
     // 获取比较器
     key_compare key_comp() const { return key_comp_; }
 
+    // Compare 声明了 is_transparent 时启用异构查找的重载，K 为任何能与 key_type 比较的类型，
+    // 查找时不构造 key_type 的临时对象
+    template <class C>
+    using enable_if_transparent = typename std::enable_if<mystl::is_transparent<C>::value>::type;
+
 private:
     // 红黑树的数据成员
-    base_ptr    header_;      // 特殊节点，与根节点互为对方的父节点
-    size_type   node_count_;  // 节点数量
-    key_compare key_comp_;    // 节点键值比较准则
+    base_ptr       header_;      // 特殊节点，与根节点互为对方的父节点
+    size_type      node_count_;  // 节点数量
+    key_compare    key_comp_;    // 节点键值比较准则
+    node_allocator node_alloc_;  // 节点分配器
 
 private:
     // 获取根节点、最左节点和最右节点
@@ -920,16 +1135,34 @@ public:
         rb_tree_init(); 
     }
 
+    /**
+     * @brief 使用指定分配器构造空树
+     */
+    explicit rb_tree(const allocator_type& alloc)
+        : node_alloc_(alloc) {
+        rb_tree_init();
+    }
+
     /**
      * @brief 复制构造函数
      */
     rb_tree(const rb_tree& rhs);
 
+    /**
+     * @brief 使用指定分配器的复制构造函数
+     */
+    rb_tree(const rb_tree& rhs, const allocator_type& alloc);
+
     /**
      * @brief 移动构造函数
      */
     rb_tree(rb_tree&& rhs) noexcept;
 
+    /**
+     * @brief 使用指定分配器的移动构造函数，分配器不相等时逐个移动元素
+     */
+    rb_tree(rb_tree&& rhs, const allocator_type& alloc);
+
     /**
      * @brief 复制赋值运算符
      */
@@ -938,13 +1171,15 @@ public:
     /**
      * @brief 移动赋值运算符
      */
-    rb_tree& operator=(rb_tree&& rhs);
+    rb_tree& operator=(rb_tree&& rhs)
+        noexcept(node_alloc_traits::propagate_on_container_move_assignment::value);
 
     /**
      * @brief 析构函数
      */
     ~rb_tree() { 
         clear(); 
+        base_allocator().deallocate(header_, 1);
     }
 
 public:
@@ -1077,7 +1312,37 @@ public:
      * @return pair，包含指向元素的迭代器和是否插入成功的bool值
      */
     template <class ...Args>
-    std::pair<iterator, bool> emplace_unique(Args&&... args);
+    std::pair<iterator, bool> emplace_unique(Args&&... args) {
+        return emplace_unique_aux(rb_tree_key_extractable<value_traits, Args...>(),
+                                  std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 先按键查找插入位置，键值不存在时才分配节点并原位构造元素
+     * 
+     * K 不是 key_type 时要求 Compare 为透明比较器，由调用者保证
+     * 
+     * @tparam K 用于查找的键的类型
+     * @tparam Args 参数类型包
+     * @param key 用于查找的键，必须与 args 构造出的元素的键相等
+     * @param args 构造元素的参数
+     * @return pair，包含指向元素的迭代器和是否插入成功的bool值
+     */
+    template <class K, class ...Args>
+    std::pair<iterator, bool> emplace_unique_key(const K& key, Args&&... args);
+
+    /**
+     * @brief 使用提示的 emplace_unique_key
+     * 
+     * @tparam K 用于查找的键的类型
+     * @tparam Args 参数类型包
+     * @param hint 插入位置提示
+     * @param key 用于查找的键，必须与 args 构造出的元素的键相等
+     * @param args 构造元素的参数
+     * @return 指向键为 key 的元素的迭代器
+     */
+    template <class K, class ...Args>
+    iterator emplace_unique_key_use_hint(iterator hint, const K& key, Args&&... args);
 
     /**
      * @brief 使用提示原位构造元素，允许键值重复
@@ -1099,7 +1364,10 @@ public:
      * @return 指向元素的迭代器
      */
     template <class ...Args>
-    iterator emplace_unique_use_hint(iterator hint, Args&&... args);
+    iterator emplace_unique_use_hint(iterator hint, Args&&... args) {
+        return emplace_unique_use_hint_aux(rb_tree_key_extractable<value_traits, Args...>(),
+                                           hint, std::forward<Args>(args)...);
+    }
 
     /**
      * @brief 插入元素，允许键值重复
@@ -1144,12 +1412,18 @@ public:
     /**
      * @brief 插入元素范围，允许键值重复
      * 
+     * 树为空时走批量构建：输入有序的部分O(n)构建，其余逐个插入
+     * 
      * @tparam InputIterator 输入迭代器类型
      * @param first 范围起始迭代器
      * @param last 范围结束迭代器
      */
     template <class InputIterator>
     void insert_multi(InputIterator first, InputIterator last) {
+        if (node_count_ == 0) {
+            build_sorted(first, last, false);
+            return;
+        }
         size_type n = static_cast<size_type>(std::distance(first, last));
         if (node_count_ > max_size() - n) {
             throw std::length_error("rb_tree<T, Comp>'s size too big");
@@ -1202,12 +1476,18 @@ public:
     /**
      * @brief 插入元素范围，不允许键值重复
      * 
+     * 树为空时走批量构建：输入有序的部分O(n)构建，其余逐个插入
+     * 
      * @tparam InputIterator 输入迭代器类型
      * @param first 范围起始迭代器
      * @param last 范围结束迭代器
      */
     template <class InputIterator>
     void insert_unique(InputIterator first, InputIterator last) {
+        if (node_count_ == 0) {
+            build_sorted(first, last, true);
+            return;
+        }
         size_type n = static_cast<size_type>(std::distance(first, last));
         if (node_count_ > max_size() - n) {
             throw std::length_error("rb_tree<T, Comp>'s size too big");
@@ -1217,6 +1497,40 @@ public:
         }
     }
 
+    /**
+     * @brief 用一段有序的元素替换树的内容，不允许键值重复
+     * 
+     * 优化说明:
+     * 1. 按顺序创建节点并串成链表，同时检查有序性，相邻的重复键值只保留第一个
+     * 2. 按中序直接构建平衡树：每个节点的左右子树大小至多相差一，
+     *    只有不满的最底层节点为红色，其余为黑色，不需要比较查找和旋转
+     * 3. 节点按顺序分配，使用 pool_allocator 时在内存中连续
+     * 4. 输入实际无序时，有序的前缀仍批量构建，其余元素逐个插入，结果与逐个插入相同
+     * 
+     * 时间复杂度: 输入有序时O(n)，否则最坏O(n log n)
+     * 
+     * @param first 范围起始迭代器
+     * @param last 范围结束迭代器
+     */
+    template <class InputIterator>
+    void assign_sorted_unique(InputIterator first, InputIterator last) {
+        clear();
+        build_sorted(first, last, true);
+    }
+
+    /**
+     * @brief 用一段有序的元素替换树的内容，允许键值重复
+     * 
+     * 与 assign_sorted_unique 相同，但保留所有重复键值，相等元素保持输入顺序
+     * 
+     * 时间复杂度: 输入有序时O(n)，否则最坏O(n log n)
+     */
+    template <class InputIterator>
+    void assign_sorted_multi(InputIterator first, InputIterator last) {
+        clear();
+        build_sorted(first, last, false);
+    }
+
     /**
      * @brief 删除指定位置的元素
      * 
@@ -1231,7 +1545,17 @@ public:
      * @param key 要删除的键值
      * @return 删除的元素个数
      */
-    size_type erase_multi(const key_type& key);
+    size_type erase_multi(const key_type& key) {
+        return erase_multi_aux(key);
+    }
+
+    /**
+     * @brief erase_multi 的异构版本，Compare 为透明比较器时可用
+     */
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    size_type erase_multi(const K& key) {
+        return erase_multi_aux(key);
+    }
 
     /**
      * @brief 删除键值等于key的元素（最多一个）
@@ -1239,7 +1563,17 @@ public:
      * @param key 要删除的键值
      * @return 删除的元素个数（0或1）
      */
-    size_type erase_unique(const key_type& key);
+    size_type erase_unique(const key_type& key) {
+        return erase_unique_aux(key);
+    }
+
+    /**
+     * @brief erase_unique 的异构版本，Compare 为透明比较器时可用
+     */
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    size_type erase_unique(const K& key) {
+        return erase_unique_aux(key);
+    }
 
     /**
      * @brief 删除范围内的元素
@@ -1254,6 +1588,138 @@ public:
      */
     void clear();
 
+    // 节点句柄相关操作
+
+    /**
+     * @brief 把 pos 所指的节点从树中摘下，放入节点句柄，节点不释放
+     * 
+     * 时间复杂度: O(log n)
+     * 
+     * @param pos 要摘下的元素的位置
+     * @return 持有该节点的句柄
+     */
+    node_handle_type extract(iterator pos);
+
+    /**
+     * @brief 摘下第一个键值等于key的节点，不存在时返回空句柄
+     */
+    node_handle_type extract(const key_type& key) {
+        auto it = find(key);
+        return it == end() ? node_handle_type() : extract(it);
+    }
+
+    /**
+     * @brief 插入句柄中的节点，不允许键值重复
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素；不相等时把元素移动到新节点中
+     * 
+     * @param nh 节点句柄，插入成功后变为空
+     * @return 插入位置、是否插入，键值已存在时节点留在返回值的 node 中
+     */
+    insert_return_type insert_unique(node_handle_type&& nh);
+
+    /**
+     * @brief 插入句柄中的节点，允许键值重复
+     * 
+     * @return 指向插入的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert_multi(node_handle_type&& nh);
+
+    /**
+     * @brief 使用提示插入句柄中的节点，不允许键值重复
+     * 
+     * 键恰好落在 hint 之前时直接链接，不从根节点查找；键已存在时节点留在 nh 中
+     * 
+     * @return 指向插入的元素或已存在的相等元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert_unique(iterator hint, node_handle_type&& nh);
+
+    /**
+     * @brief 使用提示插入句柄中的节点，允许键值重复
+     * 
+     * @return 指向插入的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert_multi(iterator hint, node_handle_type&& nh);
+
+    // 拼接、拆分与集合运算
+    // 分配器相等时节点在两棵树之间直接转移，不分配也不复制元素；否则逐个移动元素
+    // 比较器在这些操作中不能抛出异常
+
+    /**
+     * @brief 把 rhs 的所有元素接到本树末尾，rhs 变为空
+     * 
+     * 优化说明:
+     * 1. 取出 rhs 的最小节点作为分隔节点，沿黑高较大一侧的边缘向下找到黑高相等的位置挂入，
+     *    再按插入的方式向上调整，不需要比较键值
+     * 2. 顺序统计红黑树只更新挂入位置到根节点路径上的子树大小
+     * 
+     * 时间复杂度: O(log n)
+     * 
+     * @param rhs 所有元素都不小于本树元素的另一棵树
+     */
+    void join(rb_tree& rhs);
+
+    /**
+     * @brief 把键值不小于key的元素移到 rhs，rhs 原有的元素被清除
+     * 
+     * 从根节点向下按key分成左右两部分，沿途的节点与另一侧的子树重新拼接。
+     * 两棵树都要得到准确的 size()，普通红黑树没有子树大小，只能从两端向拆分点逐个计数
+     * 
+     * 时间复杂度: 顺序统计红黑树为O(log n)；普通红黑树拆分为O(log n)，
+     *             另需O(min(k, n - k))计数，k为移出的元素个数，最坏为O(n)。
+     *             需要频繁拆分大树时应使用顺序统计红黑树
+     * 
+     * @param key 拆分的键值
+     * @param rhs 接收键值不小于key的元素
+     */
+    void split(const key_type& key, rb_tree& rhs);
+
+    /**
+     * @brief 把 source 中键值不在本树中的元素移入本树，其余元素留在 source 中
+     * 
+     * 优化说明:
+     * 1. 以本树的根节点拆分 source，左右两部分分别与本树的左右子树递归合并，再以根节点拼接
+     * 2. 两棵树大小悬殊时，递归在较小的一侧很快结束，比逐个插入少做大量比较
+     * 3. 留下的重复元素按顺序挂到 source 的末尾
+     * 
+     * 时间复杂度: O(m log(n/m + 1))，m、n分别为较小和较大的树的元素个数
+     * 
+     * @param source 要合并的树
+     */
+    void merge_unique(rb_tree& source);
+
+    /**
+     * @brief 把 source 的所有元素移入本树，source 变为空
+     * 
+     * 与 merge_unique 相同，键值相等时 source 的元素排在本树的元素之后
+     * 
+     * 时间复杂度: O(m log(n/m + 1))
+     */
+    void merge_multi(rb_tree& source);
+
+    /**
+     * @brief 只保留键值在 rhs 中出现的元素
+     * 
+     * 沿 rhs 的结构递归，按 rhs 的节点三路拆分本树，保留键值相等的部分，其余部分释放
+     * 允许键值重复时按键值过滤：本树中与 rhs 某个键值相等的元素全部保留
+     * 
+     * 时间复杂度: O(m log(n/m + 1))，另加释放节点的开销
+     * 
+     * @param rhs 另一棵树，不会被修改
+     */
+    void intersect(const rb_tree& rhs);
+
+    /**
+     * @brief 删除键值在 rhs 中出现的元素
+     * 
+     * 与 intersect 相同，释放键值相等的部分，保留其余部分
+     * 
+     * 时间复杂度: O(m log(n/m + 1))，另加释放节点的开销
+     * 
+     * @param rhs 另一棵树，不会被修改
+     */
+    void subtract(const rb_tree& rhs);
+
     // 红黑树相关操作
 
     /**
@@ -1270,7 +1736,9 @@ public:
      * @param key 要查找的键值
      * @return 指向元素的迭代器，如果未找到则返回end()
      */
-    iterator find(const key_type& key);
+    iterator find(const key_type& key) {
+        return iterator(find_node(key));
+    }
     
     /**
      * @brief 查找键值等于key的元素（常量版本）
@@ -1284,24 +1752,44 @@ public:
      * @param key 要查找的键值
      * @return 指向元素的常量迭代器，如果未找到则返回end()
      */
-    const_iterator find(const key_type& key) const;
+    const_iterator find(const key_type& key) const {
+        return const_iterator(find_node(key));
+    }
+
+    /**
+     * @brief find 的异构版本：Compare 为透明比较器时，可以用任何能与 key_type 比较的类型查找
+     * 
+     * 例如 map<string, V, transparent_less> 用 const char* 查找时不构造临时的 string
+     */
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    iterator find(const K& key) {
+        return iterator(find_node(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    const_iterator find(const K& key) const {
+        return const_iterator(find_node(key));
+    }
 
     /**
      * @brief 统计键值等于key的元素个数（允许重复键值）
      * 
      * 优化说明:
      * 1. 直接利用已有的equal_range_multi方法实现，减少代码重复
-     * 2. 使用std::distance计算范围大小，利用STL算法提高性能
-     * 3. 针对大数据集，遍历次数与重复元素数量成正比
+     * 2. 顺序统计红黑树用不大于key与小于key的元素个数相减，不遍历重复元素
      * 
-     * 时间复杂度: O(log n + k)，其中k为重复键值的数量
+     * 时间复杂度: O(log n + k)，其中k为重复键值的数量；顺序统计红黑树为O(log n)
      * 
      * @param key 要统计的键值
      * @return 元素个数
      */
     size_type count_multi(const key_type& key) const {
-        auto p = equal_range_multi(key);
-        return static_cast<size_type>(std::distance(p.first, p.second));
+        return count_multi_aux(key, order_statistics());
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    size_type count_multi(const K& key) const {
+        return count_multi_aux(key, order_statistics());
     }
     
     /**
@@ -1318,7 +1806,12 @@ public:
      * @return 元素个数（0或1）
      */
     size_type count_unique(const key_type& key) const {
-        return find(key) != end() ? 1 : 0;
+        return find_node(key) != header_ ? 1 : 0;
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    size_type count_unique(const K& key) const {
+        return find_node(key) != header_ ? 1 : 0;
     }
 
     /**
@@ -1334,7 +1827,9 @@ public:
      * @param key 键值
      * @return 指向不小于key的第一个元素的迭代器
      */
-    iterator lower_bound(const key_type& key);
+    iterator lower_bound(const key_type& key) {
+        return iterator(lower_bound_node(key));
+    }
     
     /**
      * @brief 返回不小于key的第一个位置（常量版本）
@@ -1348,7 +1843,19 @@ public:
      * @param key 键值
      * @return 指向不小于key的第一个元素的常量迭代器
      */
-    const_iterator lower_bound(const key_type& key) const;
+    const_iterator lower_bound(const key_type& key) const {
+        return const_iterator(lower_bound_node(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    iterator lower_bound(const K& key) {
+        return iterator(lower_bound_node(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    const_iterator lower_bound(const K& key) const {
+        return const_iterator(lower_bound_node(key));
+    }
 
     /**
      * @brief 返回大于key的第一个位置
@@ -1363,7 +1870,9 @@ public:
      * @param key 键值
      * @return 指向大于key的第一个元素的迭代器
      */
-    iterator upper_bound(const key_type& key);
+    iterator upper_bound(const key_type& key) {
+        return iterator(upper_bound_node(key));
+    }
     
     /**
      * @brief 返回大于key的第一个位置（常量版本）
@@ -1377,7 +1886,19 @@ public:
      * @param key 键值
      * @return 指向大于key的第一个元素的常量迭代器
      */
-    const_iterator upper_bound(const key_type& key) const;
+    const_iterator upper_bound(const key_type& key) const {
+        return const_iterator(upper_bound_node(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    iterator upper_bound(const K& key) {
+        return iterator(upper_bound_node(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    const_iterator upper_bound(const K& key) const {
+        return const_iterator(upper_bound_node(key));
+    }
 
     /**
      * @brief 返回键值等于key的元素范围（允许重复键值）
@@ -1412,6 +1933,16 @@ public:
         return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
     }
 
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    std::pair<iterator, iterator> equal_range_multi(const K& key) {
+        return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    std::pair<const_iterator, const_iterator> equal_range_multi(const K& key) const {
+        return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
     /**
      * @brief 返回键值等于key的元素范围（不允许重复键值）
      * 
@@ -1449,6 +1980,80 @@ public:
         return it == end() ? std::make_pair(it, it) : std::make_pair(it, ++next);
     }
 
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    std::pair<iterator, iterator> equal_range_unique(const K& key) {
+        iterator it = find(key);
+        auto next = it;
+        return it == end() ? std::make_pair(it, it) : std::make_pair(it, ++next);
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    std::pair<const_iterator, const_iterator> equal_range_unique(const K& key) const {
+        const_iterator it = find(key);
+        auto next = it;
+        return it == end() ? std::make_pair(it, it) : std::make_pair(it, ++next);
+    }
+
+    // 顺序统计相关操作，除 distance 外只有 OrderStatistics 为 true 时可用
+
+    /**
+     * @brief 返回中序第k个元素（从0开始）
+     * 
+     * 从根节点向下，比较k与左子树大小决定向左、命中或向右
+     * 
+     * 时间复杂度: O(log n)
+     * 
+     * @param k 序号
+     * @return 指向第k个元素的迭代器，k >= size() 时返回end()
+     */
+    iterator nth(size_type k) noexcept {
+        return iterator(nth_node(k));
+    }
+
+    /**
+     * @brief 返回中序第k个元素（常量版本）
+     */
+    const_iterator nth(size_type k) const noexcept {
+        return const_iterator(nth_node(k));
+    }
+
+    /**
+     * @brief 返回键值小于key的元素个数，即key在树中的排名
+     * 
+     * 等于 lower_bound(key) 的序号，向右走时累加左子树大小和当前节点
+     * 
+     * 时间复杂度: O(log n)
+     * 
+     * @param key 键值
+     * @return 小于key的元素个数
+     */
+    size_type rank(const key_type& key) const {
+        return rank_aux(key);
+    }
+
+    template <class K, class C = Compare, class = enable_if_transparent<C>>
+    size_type rank(const K& key) const {
+        return rank_aux(key);
+    }
+
+    /**
+     * @brief 返回迭代器所指元素的序号，end()的序号为size()
+     * 
+     * 从节点向上走到根节点，每次从右子节点回到父节点时累加父节点及其左子树
+     * 
+     * 时间复杂度: O(log n)
+     */
+    size_type index_of(const_iterator pos) const noexcept;
+
+    /**
+     * @brief 返回[first, last)中的元素个数
+     * 
+     * 时间复杂度: 顺序统计红黑树为O(log n)，否则与std::distance相同，为O(k)
+     */
+    difference_type distance(const_iterator first, const_iterator last) const noexcept {
+        return distance_aux(first, last, order_statistics());
+    }
+
     /**
      * @brief 交换两个红黑树的内容
      * 
@@ -1457,8 +2062,112 @@ public:
     void swap(rb_tree& rhs) noexcept;
 
 private:
+    // 顺序统计的辅助操作
+
+    /**
+     * @brief 返回中序第k个节点，k >= size() 时返回header_
+     */
+    base_ptr nth_node(size_type k) const noexcept;
+
+    /**
+     * @brief 返回键值不大于key的元素个数，即 upper_bound(key) 的序号
+     */
+    template <class K>
+    size_type count_not_greater(const K& key) const;
+
+    /**
+     * @brief 返回键值小于key的元素个数
+     */
+    template <class K>
+    size_type rank_aux(const K& key) const;
+
+    /**
+     * @brief count_multi 的分派：有子树大小时用两个排名相减
+     */
+    template <class K>
+    size_type count_multi_aux(const K& key, std::true_type) const {
+        return count_not_greater(key) - rank_aux(key);
+    }
+
+    template <class K>
+    size_type count_multi_aux(const K& key, std::false_type) const {
+        const_iterator first(lower_bound_node(key));
+        const_iterator last(upper_bound_node(key));
+        return static_cast<size_type>(std::distance(first, last));
+    }
+
+    // 查找的实现，K 为 key_type 或透明比较器支持的异构类型
+
+    /**
+     * @brief 第一个不小于key的节点，不存在时返回header_
+     */
+    template <class K>
+    base_ptr lower_bound_node(const K& key) const;
+
+    /**
+     * @brief 第一个大于key的节点，不存在时返回header_
+     */
+    template <class K>
+    base_ptr upper_bound_node(const K& key) const;
+
+    /**
+     * @brief 键值等于key的第一个节点，不存在时返回header_
+     */
+    template <class K>
+    base_ptr find_node(const K& key) const;
+
+    template <class K>
+    size_type erase_multi_aux(const K& key);
+
+    template <class K>
+    size_type erase_unique_aux(const K& key);
+
+    /**
+     * @brief distance 的分派：有子树大小时用两个序号相减
+     */
+    difference_type distance_aux(const_iterator first, const_iterator last, std::true_type) const noexcept {
+        return static_cast<difference_type>(index_of(last)) -
+               static_cast<difference_type>(index_of(first));
+    }
+
+    difference_type distance_aux(const_iterator first, const_iterator last, std::false_type) const noexcept {
+        return std::distance(first, last);
+    }
+
     // 节点相关操作
 
+    /**
+     * @brief emplace_unique 的分派：能直接取得键值时先查找后分配
+     */
+    template <class A>
+    std::pair<iterator, bool> emplace_unique_aux(std::true_type, A&& a) {
+        return emplace_unique_key(value_traits::get_key(a), std::forward<A>(a));
+    }
+
+    template <class A, class B>
+    std::pair<iterator, bool> emplace_unique_aux(std::true_type, A&& a, B&& b) {
+        return emplace_unique_key(a, std::forward<A>(a), std::forward<B>(b));
+    }
+
+    template <class ...Args>
+    std::pair<iterator, bool> emplace_unique_aux(std::false_type, Args&&... args);
+
+    /**
+     * @brief emplace_unique_use_hint 的分派
+     */
+    template <class A>
+    iterator emplace_unique_use_hint_aux(std::true_type, iterator hint, A&& a) {
+        return emplace_unique_key_use_hint(hint, value_traits::get_key(a), std::forward<A>(a));
+    }
+
+    template <class A, class B>
+    iterator emplace_unique_use_hint_aux(std::true_type, iterator hint, A&& a, B&& b) {
+        return emplace_unique_key_use_hint(hint, a, std::forward<A>(a), std::forward<B>(b));
+    }
+
+    template <class ...Args>
+    iterator emplace_unique_use_hint_aux(std::false_type, iterator hint, Args&&... args);
+
     /**
      * @brief 创建一个节点
      */
@@ -1475,6 +2184,11 @@ private:
      */
     void destroy_node(node_ptr p);
 
+    /**
+     * @brief 取出句柄中的节点用于插入，分配器不相等时改为把元素移动到新节点
+     */
+    node_ptr take_node(node_handle_type& nh);
+
     // 初始化和重置操作
     
     /**
@@ -1497,7 +2211,16 @@ private:
     /**
      * @brief 获取插入位置（不允许重复键值）
      */
-    std::pair<std::pair<base_ptr, bool>, bool> get_insert_unique_pos(const key_type& key);
+    template <class K>
+    std::pair<std::pair<base_ptr, bool>, bool> get_insert_unique_pos(const K& key);
+
+    /**
+     * @brief 使用提示获取插入位置（不允许重复键值），返回值同 get_insert_unique_pos
+     * 
+     * key 等于 hint 处的键，或者落在 hint 与它的前一个元素之间时不需要从根节点查找
+     */
+    template <class K>
+    std::pair<std::pair<base_ptr, bool>, bool> get_insert_unique_hint_pos(iterator hint, const K& key);
 
     // 插入节点操作
     
@@ -1523,6 +2246,110 @@ private:
      */
     iterator insert_unique_use_hint(iterator hint, key_type key, node_ptr node);
 
+    /**
+     * @brief 使用提示链接已构造好的节点（允许重复键值），树可以为空
+     */
+    iterator insert_node_multi_use_hint(iterator hint, node_ptr np);
+
+    // 批量构建
+
+    /**
+     * @brief 向空树中批量插入元素，有序的前缀线性构建，其余逐个插入
+     */
+    template <class InputIterator>
+    void build_sorted(InputIterator first, InputIterator last, bool unique);
+
+    /**
+     * @brief 从按 right 串起的有序链表中取出前 n 个节点，构建平衡子树
+     * 
+     * @param chain 链表头，返回时指向剩余的第一个节点
+     * @param n 子树的节点数
+     * @param depth 子树根节点的深度
+     * @param red_depth 着红色的深度，等于最底层的深度；最底层为满时不着红色
+     * @return 子树的根节点
+     */
+    base_ptr build_balanced(base_ptr& chain, size_type n, size_type depth, size_type red_depth) noexcept;
+
+    // 拼接与拆分
+
+    /**
+     * @brief 从树中摘下的子树，根节点的 parent 为 nullptr，根节点可能是红色
+     */
+    struct subtree {
+        base_ptr root;
+        size_type bh;  // 黑高：根节点到空叶子的路径上黑色节点的个数
+    };
+
+    /**
+     * @brief 沿最左路径计算子树的黑高
+     */
+    static size_type black_height(base_ptr x) noexcept;
+
+    /**
+     * @brief 把 t 的根节点的子节点 x 摘下作为子树
+     */
+    static subtree child_of(const subtree& t, base_ptr x) noexcept;
+
+    /**
+     * @brief 以节点k拼接两棵子树，l 中的元素不大于k，r 中的元素不小于k
+     */
+    static subtree join_subtree(subtree l, base_ptr k, subtree r) noexcept;
+
+    /**
+     * @brief 拼接两棵子树，取出 r 的最小节点作为分隔节点
+     */
+    static subtree concat_subtree(subtree l, subtree r) noexcept;
+
+    /**
+     * @brief 摘下子树的最小节点并返回它，t 不能为空
+     */
+    static base_ptr take_min(subtree& t) noexcept;
+
+    /**
+     * @brief 按key把子树拆成两部分
+     * 
+     * @param upper 为 false 时拆成 (< key, >= key)，为 true 时拆成 (<= key, > key)
+     */
+    std::pair<subtree, subtree> split_subtree(subtree t, const key_type& key, bool upper);
+
+    /**
+     * @brief 合并两棵子树，unique 为 true 时 b 中的重复元素按顺序挂到 rest 的末尾
+     */
+    subtree union_subtree(subtree a, subtree b, bool unique, rb_tree& rest);
+
+    /**
+     * @brief 保留 a 中键值在以 b 为根的子树中出现的元素，释放的节点数累加到 removed
+     */
+    subtree intersect_subtree(subtree a, base_ptr b, size_type& removed);
+
+    /**
+     * @brief 释放 a 中键值在以 b 为根的子树中出现的元素，释放的节点数累加到 removed
+     */
+    subtree subtract_subtree(subtree a, base_ptr b, size_type& removed);
+
+    /**
+     * @brief 把整棵树摘下作为子树，本树变为空
+     */
+    subtree detach() noexcept;
+
+    /**
+     * @brief 以子树 t 作为本树的内容，本树须为空
+     */
+    void adopt(subtree t, size_type n) noexcept;
+
+    /**
+     * @brief 返回 pos 之前的元素个数，普通红黑树从两端同时计数
+     */
+    size_type count_before(const_iterator pos) const noexcept {
+        return count_before_aux(pos, order_statistics());
+    }
+
+    size_type count_before_aux(const_iterator pos, std::true_type) const noexcept {
+        return index_of(pos);
+    }
+
+    size_type count_before_aux(const_iterator pos, std::false_type) const noexcept;
+
     // 复制和删除树
     
     /**
@@ -1531,9 +2358,25 @@ private:
     base_ptr copy_from(base_ptr x, base_ptr p);
     
     /**
-     * @brief 删除一棵子树
+     * @brief 删除一棵子树，返回删除的节点数
      */
-    void erase_since(base_ptr x);
+    size_type erase_since(base_ptr x);
+
+    /**
+     * @brief 只析构子树中的元素，元素可平凡析构时什么也不做
+     */
+    void destroy_since(base_ptr, std::true_type) {}
+    void destroy_since(base_ptr x, std::false_type);
+
+    /**
+     * @brief 复制 rhs 的结构和比较器，本树须为空
+     */
+    void copy_tree(const rb_tree& rhs);
+
+    /**
+     * @brief 分配器不相等时移动的退路：按顺序逐个移动 rhs 的元素，随后清空 rhs
+     */
+    void move_elements(rb_tree& rhs);
 };
 
 // 红黑树成员函数实现
@@ -1541,45 +2384,64 @@ private:
 /**
  * @brief 复制构造函数
  */
-template <class T, class Compare>
-rb_tree<T, Compare>::rb_tree(const rb_tree& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>::rb_tree(const rb_tree& rhs)
+    : node_alloc_(node_alloc_traits::select_on_container_copy_construction(rhs.node_alloc_)) {
     rb_tree_init();
-    if (rhs.node_count_ != 0) {
-        root() = copy_from(rhs.root(), header_);
-        leftmost() = rb_tree_min(root());
-        rightmost() = rb_tree_max(root());
-    }
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
+    copy_tree(rhs);
+}
+
+/**
+ * @brief 使用指定分配器的复制构造函数
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>::rb_tree(const rb_tree& rhs, const allocator_type& alloc)
+    : node_alloc_(alloc) {
+    rb_tree_init();
+    copy_tree(rhs);
 }
 
 /**
  * @brief 移动构造函数
  */
-template <class T, class Compare>
-rb_tree<T, Compare>::rb_tree(rb_tree&& rhs) noexcept
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>::rb_tree(rb_tree&& rhs) noexcept
     : header_(std::move(rhs.header_)),
       node_count_(rhs.node_count_),
-      key_comp_(rhs.key_comp_) {
+      key_comp_(rhs.key_comp_),
+      node_alloc_(rhs.node_alloc_) {
     rhs.reset();
 }
 
+/**
+ * @brief 使用指定分配器的移动构造函数
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>::rb_tree(rb_tree&& rhs, const allocator_type& alloc)
+    : node_alloc_(alloc) {
+    rb_tree_init();
+    key_comp_ = rhs.key_comp_;
+    if (node_alloc_ == rhs.node_alloc_) {
+        std::swap(header_, rhs.header_);
+        std::swap(node_count_, rhs.node_count_);
+    }
+    else {
+        move_elements(rhs);
+    }
+}
+
 /**
  * @brief 复制赋值运算符
  */
-template <class T, class Compare>
-rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(const rb_tree& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>& rb_tree<T, Compare, Alloc, OrderStatistics>::operator=(const rb_tree& rhs) {
     if (this != &rhs) {
+        // 先用原分配器释放节点，再按 POCCA 决定是否采用 rhs 的分配器
         clear();
-
-        if (rhs.node_count_ != 0) {
-            root() = copy_from(rhs.root(), header_);
-            leftmost() = rb_tree_min(root());
-            rightmost() = rb_tree_max(root());
+        if (node_alloc_traits::propagate_on_container_copy_assignment::value) {
+            node_alloc_ = rhs.node_alloc_;
         }
-
-        node_count_ = rhs.node_count_;
-        key_comp_ = rhs.key_comp_;
+        copy_tree(rhs);
     }
     return *this;
 }
@@ -1587,23 +2449,36 @@ rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(const rb_tree& rhs) {
 /**
  * @brief 移动赋值运算符
  */
-template <class T, class Compare>
-rb_tree<T, Compare>& rb_tree<T, Compare>::operator=(rb_tree&& rhs) {
-    clear();
-    header_ = std::move(rhs.header_);
-    node_count_ = rhs.node_count_;
-    key_comp_ = rhs.key_comp_;
-    rhs.reset();
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+rb_tree<T, Compare, Alloc, OrderStatistics>& rb_tree<T, Compare, Alloc, OrderStatistics>::operator=(rb_tree&& rhs)
+    noexcept(node_alloc_traits::propagate_on_container_move_assignment::value) {
+    if (this != &rhs) {
+        clear();
+        if (node_alloc_traits::propagate_on_container_move_assignment::value ||
+            node_alloc_ == rhs.node_alloc_) {
+            // 交换 header_，rhs 得到本树清空后的 header_，不需要重新分配
+            std::swap(header_, rhs.header_);
+            node_count_ = rhs.node_count_;
+            key_comp_ = rhs.key_comp_;
+            node_alloc_ = rhs.node_alloc_;
+            rhs.node_count_ = 0;
+        }
+        else {
+            // 分配器不传播且不相等，节点不能转交，只能逐个移动元素
+            key_comp_ = rhs.key_comp_;
+            move_elements(rhs);
+        }
+    }
     return *this;
 }
 
 /**
  * @brief 原位构造元素，允许键值重复
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc, bool OrderStatistics>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator 
-rb_tree<T, Compare>::emplace_multi(Args&&... args) {
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator 
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_multi(Args&&... args) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
@@ -1613,12 +2488,12 @@ rb_tree<T, Compare>::emplace_multi(Args&&... args) {
 }
 
 /**
- * @brief 原位构造元素，不允许键值重复
+ * @brief 先构造节点再查找插入位置，不允许键值重复
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc, bool OrderStatistics>
 template <class ...Args>
-std::pair<typename rb_tree<T, Compare>::iterator, bool> 
-rb_tree<T, Compare>::emplace_unique(Args&&... args) {
+std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator, bool> 
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_unique_aux(std::false_type, Args&&... args) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
@@ -1635,14 +2510,22 @@ rb_tree<T, Compare>::emplace_unique(Args&&... args) {
 /**
  * @brief 使用提示原位构造元素，允许键值重复
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc, bool OrderStatistics>
 template <class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_multi_use_hint(iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_multi_use_hint(iterator hint, Args&&... args) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
-    node_ptr np = create_node(std::forward<Args>(args)...);
+    return insert_node_multi_use_hint(hint, create_node(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief 使用提示链接已构造好的节点，允许键值重复
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_node_multi_use_hint(iterator hint, node_ptr np) {
     if (node_count_ == 0) {
         return insert_node_at(header_, np, true);
     }
@@ -1670,12 +2553,12 @@ rb_tree<T, Compare>::emplace_multi_use_hint(iterator hint, Args&&... args) {
 }
 
 /**
- * @brief 使用提示原位构造元素，不允许键值重复
+ * @brief 先构造节点再使用提示插入，不允许键值重复
  */
-template<class T, class Compare>
+template <class T, class Compare, class Alloc, bool OrderStatistics>
 template<class ...Args>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_unique_use_hint_aux(std::false_type, iterator hint, Args&&... args) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
@@ -1714,12 +2597,51 @@ rb_tree<T, Compare>::emplace_unique_use_hint(iterator hint, Args&&... args) {
     return insert_unique_use_hint(hint, key, np);
 }
 
+/**
+ * @brief 先查找后分配的原位构造，不允许键值重复
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K, class ...Args>
+std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator, bool>
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_unique_key(const K& key, Args&&... args) {
+    if (node_count_ > max_size() - 1) {
+        throw std::length_error("rb_tree<T, Comp>'s size too big");
+    }
+    auto res = get_insert_unique_pos(key);
+    if (!res.second) {
+        return std::make_pair(iterator(res.first.first), false);
+    }
+    // args 可能引用 key，构造节点之后不能再使用 key
+    node_ptr np = create_node(std::forward<Args>(args)...);
+    return std::make_pair(insert_node_at(res.first.first, np, res.first.second), true);
+}
+
+/**
+ * @brief 使用提示的先查找后分配的原位构造，不允许键值重复
+ * 新键恰好落在 hint 之前时不需要从根节点查找
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K, class ...Args>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::emplace_unique_key_use_hint(iterator hint, const K& key, Args&&... args) {
+    if (node_count_ > max_size() - 1) {
+        throw std::length_error("rb_tree<T, Comp>'s size too big");
+    }
+    auto res = get_insert_unique_hint_pos(hint, key);
+    if (!res.second) {
+        return iterator(res.first.first);
+    }
+    // args 可能引用 key，构造节点之后不能再使用 key
+    node_ptr np = create_node(std::forward<Args>(args)...);
+    return insert_node_at(res.first.first, np, res.first.second);
+}
+
 /**
  * @brief 插入元素，允许键值重复
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_multi(const value_type& value) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_multi(const value_type& value) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
@@ -1730,9 +2652,9 @@ rb_tree<T, Compare>::insert_multi(const value_type& value) {
 /**
  * @brief 插入元素，不允许键值重复
  */
-template <class T, class Compare>
-std::pair<typename rb_tree<T, Compare>::iterator, bool>
-rb_tree<T, Compare>::insert_unique(const value_type& value) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator, bool>
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_unique(const value_type& value) {
     if (node_count_ > max_size() - 1) {
         throw std::length_error("rb_tree<T, Comp>'s size too big");
     }
@@ -1747,9 +2669,9 @@ rb_tree<T, Compare>::insert_unique(const value_type& value) {
 /**
  * @brief 删除指定位置的元素
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::erase(iterator hint) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::erase(iterator hint) {
     auto node = hint.node->get_node_ptr();
     iterator next(node);
     ++next;
@@ -1761,52 +2683,133 @@ rb_tree<T, Compare>::erase(iterator hint) {
 }
 
 /**
- * @brief 删除键值等于key的所有元素
+ * @brief 把节点从树中摘下放入句柄
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::erase_multi(const key_type& key) {
-    auto p = equal_range_multi(key);
-    size_type n = static_cast<size_type>(std::distance(p.first, p.second));
-    erase(p.first, p.second);
-    return n;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::node_handle_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::extract(iterator pos) {
+    auto node = pos.node->get_node_ptr();
+    rb_tree_erase_rebalance(pos.node, root(), leftmost(), rightmost());
+    --node_count_;
+    return node_handle_access::make<node_handle_type>(node, node_alloc_);
 }
 
 /**
- * @brief 删除键值等于key的元素（最多一个）
+ * @brief 插入句柄中的节点，不允许键值重复
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::size_type
-rb_tree<T, Compare>::erase_unique(const key_type& key) {
-    auto it = find(key);
-    if (it != end()) {
-        erase(it);
-        return 1;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::insert_return_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_unique(node_handle_type&& nh) {
+    if (nh.empty()) {
+        return insert_return_type{end(), false, node_handle_type()};
     }
-    return 0;
+    auto res = get_insert_unique_pos(value_traits::get_key(nh.value()));
+    if (!res.second) {
+        return insert_return_type{iterator(res.first.first), false, std::move(nh)};
+    }
+    node_ptr np = take_node(nh);
+    return insert_return_type{insert_node_at(res.first.first, np, res.first.second), true, node_handle_type()};
 }
 
 /**
- * @brief 删除范围内的元素
+ * @brief 插入句柄中的节点，允许键值重复
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::erase(iterator first, iterator last) {
-    if (first == begin() && last == end()) {
-        clear();
-    } else {
-        while (first != last) {
-            erase(first++);
-        }
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_multi(node_handle_type&& nh) {
+    if (nh.empty()) {
+        return end();
     }
+    auto pos = get_insert_multi_pos(value_traits::get_key(nh.value()));
+    node_ptr np = take_node(nh);
+    return insert_node_at(pos.first, np, pos.second);
 }
 
 /**
- * @brief 清空容器
+ * @brief 使用提示插入句柄中的节点，不允许键值重复
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::clear() {
-    if (node_count_ != 0) {
-        erase_since(root());
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_unique(iterator hint, node_handle_type&& nh) {
+    if (nh.empty()) {
+        return end();
+    }
+    auto res = get_insert_unique_hint_pos(hint, value_traits::get_key(nh.value()));
+    if (!res.second) {
+        return iterator(res.first.first);
+    }
+    node_ptr np = take_node(nh);
+    return insert_node_at(res.first.first, np, res.first.second);
+}
+
+/**
+ * @brief 使用提示插入句柄中的节点，允许键值重复
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_multi(iterator hint, node_handle_type&& nh) {
+    if (nh.empty()) {
+        return end();
+    }
+    return insert_node_multi_use_hint(hint, take_node(nh));
+}
+
+/**
+ * @brief 删除键值等于key的所有元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::erase_multi_aux(const K& key) {
+    iterator first(lower_bound_node(key));
+    iterator last(upper_bound_node(key));
+    size_type n = static_cast<size_type>(distance(first, last));
+    erase(first, last);
+    return n;
+}
+
+/**
+ * @brief 删除键值等于key的元素（最多一个）
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::erase_unique_aux(const K& key) {
+    base_ptr x = find_node(key);
+    if (x != header_) {
+        erase(iterator(x));
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief 删除范围内的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::erase(iterator first, iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+    } else {
+        while (first != last) {
+            erase(first++);
+        }
+    }
+}
+
+/**
+ * @brief 清空容器
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::clear() {
+    if (node_count_ != 0) {
+        if (node_alloc_can_release(node_alloc_)) {
+            // 分配器可以整块释放节点内存：只析构元素，不逐个归还节点
+            destroy_since(root(), std::is_trivially_destructible<value_type>());
+            node_alloc_release(node_alloc_);
+        } else {
+            erase_since(root());
+        }
         leftmost() = header_;
         root() = nullptr;
         rightmost() = header_;
@@ -1815,143 +2818,312 @@ void rb_tree<T, Compare>::clear() {
 }
 
 /**
- * @brief 查找键值等于key的元素
+ * @brief 键值等于key的第一个节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::find(const key_type& key) {
-    auto y = header_;  // 最后一个不小于key的节点
-    auto x = root();
-    while (x != nullptr) {
-        if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-            // key小于等于当前节点键值，向左走
-            y = x;
-            x = x->left;
-        } else {
-            // key大于当前节点键值，向右走
-            x = x->right;
-        }
-    }
-    iterator j = iterator(y);
-    return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::find_node(const K& key) const {
+    base_ptr y = lower_bound_node(key);
+    return (y == header_ || key_comp_(key, value_traits::get_key(y->get_node_ptr()->value))) ? header_ : y;
 }
 
 /**
- * @brief 查找键值等于key的元素（常量版本）
+ * @brief 第一个不小于key的节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::find(const key_type& key) const {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::lower_bound_node(const K& key) const {
     auto y = header_;  // 最后一个不小于key的节点
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-            // key小于等于当前节点键值，向左走
+            // key <= x，记录当前节点并向左走
             y = x;
             x = x->left;
         } else {
-            // key大于当前节点键值，向右走
+            // key > x，向右走
             x = x->right;
         }
     }
-    const_iterator j = const_iterator(y);
-    return (j == end() || key_comp_(key, value_traits::get_key(*j))) ? end() : j;
+    return y;
 }
 
 /**
- * @brief 返回不小于key的第一个位置
+ * @brief 第一个大于key的节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::lower_bound(const key_type& key) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::upper_bound_node(const K& key) const {
     auto y = header_;
     auto x = root();
     while (x != nullptr) {
-        if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-            // key <= x，记录当前节点并向左走
+        if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
+            // key < x，记录当前节点并向左走
             y = x;
             x = x->left;
         } else {
-            // key > x，向右走
+            // key >= x，向右走
             x = x->right;
         }
     }
-    return iterator(y);
+    return y;
 }
 
 /**
- * @brief 返回不小于key的第一个位置（常量版本）
+ * @brief 返回键值小于key的元素个数
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::lower_bound(const key_type& key) const {
-    auto y = header_;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::rank_aux(const K& key) const {
+    static_assert(OrderStatistics, "rb_tree: order statistics require OrderStatistics = true");
+    size_type r = 0;
     auto x = root();
     while (x != nullptr) {
         if (!key_comp_(value_traits::get_key(x->get_node_ptr()->value), key)) {
-            // key <= x，记录当前节点并向左走
-            y = x;
+            // key <= x，x及其右子树都不小于key
             x = x->left;
         } else {
-            // key > x，向右走
+            // key > x，x及其左子树都小于key
+            r += rb_tree_subtree_size(x->left) + 1;
             x = x->right;
         }
     }
-    return const_iterator(y);
+    return r;
 }
 
 /**
- * @brief 返回大于key的第一个位置
+ * @brief 返回键值不大于key的元素个数
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::upper_bound(const key_type& key) {
-    auto y = header_;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::count_not_greater(const K& key) const {
+    static_assert(OrderStatistics, "rb_tree: order statistics require OrderStatistics = true");
+    size_type r = 0;
     auto x = root();
     while (x != nullptr) {
         if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
-            // key < x，记录当前节点并向左走
-            y = x;
+            // key < x，x及其右子树都大于key
             x = x->left;
         } else {
-            // key >= x，向右走
+            // key >= x，x及其左子树都不大于key
+            r += rb_tree_subtree_size(x->left) + 1;
             x = x->right;
         }
     }
-    return iterator(y);
+    return r;
 }
 
 /**
- * @brief 返回大于key的第一个位置（常量版本）
+ * @brief 返回中序第k个节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::const_iterator
-rb_tree<T, Compare>::upper_bound(const key_type& key) const {
-    auto y = header_;
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::nth_node(size_type k) const noexcept {
+    static_assert(OrderStatistics, "rb_tree: order statistics require OrderStatistics = true");
+    if (k >= node_count_) {
+        return header_;
+    }
     auto x = root();
-    while (x != nullptr) {
-        if (key_comp_(key, value_traits::get_key(x->get_node_ptr()->value))) {
-            // key < x，记录当前节点并向左走
-            y = x;
+    while (true) {
+        const size_type left_size = rb_tree_subtree_size(x->left);
+        if (k < left_size) {
             x = x->left;
+        } else if (k == left_size) {
+            return x;
         } else {
-            // key >= x，向右走
+            k -= left_size + 1;
             x = x->right;
         }
     }
-    return const_iterator(y);
+}
+
+/**
+ * @brief 返回迭代器所指元素的序号
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::index_of(const_iterator pos) const noexcept {
+    static_assert(OrderStatistics, "rb_tree: order statistics require OrderStatistics = true");
+    auto x = pos.node;
+    if (x == header_) {
+        return node_count_;
+    }
+    size_type r = rb_tree_subtree_size(x->left);
+    while (x != root()) {
+        if (!rb_tree_is_lchild(x)) {
+            // 从右子节点回到父节点，父节点及其左子树都在x之前
+            r += rb_tree_subtree_size(x->parent->left) + 1;
+        }
+        x = x->parent;
+    }
+    return r;
 }
 
 /**
  * @brief 交换两个红黑树的内容
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::swap(rb_tree& rhs) noexcept {
     if (this != &rhs) {
         std::swap(header_, rhs.header_);
         std::swap(node_count_, rhs.node_count_);
         std::swap(key_comp_, rhs.key_comp_);
+        // 分配器不传播时两棵树的分配器必须相等
+        if (node_alloc_traits::propagate_on_container_swap::value) {
+            std::swap(node_alloc_, rhs.node_alloc_);
+        }
+    }
+}
+
+/**
+ * @brief 复制 rhs 的结构和比较器
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::copy_tree(const rb_tree& rhs) {
+    if (rhs.node_count_ != 0) {
+        root() = copy_from(rhs.root(), header_);
+        leftmost() = rb_tree_min(root());
+        rightmost() = rb_tree_max(root());
+    }
+    node_count_ = rhs.node_count_;
+    key_comp_ = rhs.key_comp_;
+}
+
+/**
+ * @brief 逐个移动 rhs 的元素，rhs 有序，每次都插在末尾
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::move_elements(rb_tree& rhs) {
+    for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+        emplace_multi_use_hint(end(), std::move(*it));
     }
+    rhs.clear();
+}
+
+/**
+ * @brief 把 rhs 的所有元素接到本树末尾
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::join(rb_tree& rhs) {
+    if (this == &rhs || rhs.node_count_ == 0) {
+        return;
+    }
+    if (!(node_alloc_ == rhs.node_alloc_)) {
+        move_elements(rhs);
+        return;
+    }
+    const size_type n = node_count_ + rhs.node_count_;
+    subtree l = detach();
+    adopt(concat_subtree(l, rhs.detach()), n);
+}
+
+/**
+ * @brief 把键值不小于key的元素移到 rhs
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::split(const key_type& key, rb_tree& rhs) {
+    if (this == &rhs) {
+        return;
+    }
+    rhs.clear();
+    auto first = lower_bound(key);
+    if (first == end()) {
+        return;
+    }
+    if (!(node_alloc_ == rhs.node_alloc_)) {
+        for (auto it = first; it != end(); ++it) {
+            rhs.emplace_multi_use_hint(rhs.end(), std::move(*it));
+        }
+        erase(first, end());
+        return;
+    }
+    const size_type n = node_count_;
+    const size_type k = count_before(first);
+    auto parts = split_subtree(detach(), key, false);
+    adopt(parts.first, k);
+    rhs.adopt(parts.second, n - k);
+}
+
+/**
+ * @brief 合并 source 中键值不在本树中的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::merge_unique(rb_tree& source) {
+    if (this == &source || source.node_count_ == 0) {
+        return;
+    }
+    if (!(node_alloc_ == source.node_alloc_)) {
+        for (auto it = source.begin(); it != source.end(); ) {
+            auto cur = it++;
+            if (find(value_traits::get_key(*cur)) == end()) {
+                emplace_multi(std::move(*cur));
+                source.erase(cur);
+            }
+        }
+        return;
+    }
+    const size_type n = node_count_ + source.node_count_;
+    subtree a = detach();
+    subtree t = union_subtree(a, source.detach(), true, source);
+    adopt(t, n - source.node_count_);
+}
+
+/**
+ * @brief 合并 source 的所有元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::merge_multi(rb_tree& source) {
+    if (this == &source || source.node_count_ == 0) {
+        return;
+    }
+    if (!(node_alloc_ == source.node_alloc_)) {
+        for (auto it = source.begin(); it != source.end(); ++it) {
+            emplace_multi(std::move(*it));
+        }
+        source.clear();
+        return;
+    }
+    const size_type n = node_count_ + source.node_count_;
+    subtree a = detach();
+    subtree t = union_subtree(a, source.detach(), false, source);
+    adopt(t, n);
+}
+
+/**
+ * @brief 只保留键值在 rhs 中出现的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::intersect(const rb_tree& rhs) {
+    if (this == &rhs || node_count_ == 0) {
+        return;
+    }
+    const size_type n = node_count_;
+    size_type removed = 0;
+    subtree t = intersect_subtree(detach(), rhs.root(), removed);
+    adopt(t, n - removed);
+}
+
+/**
+ * @brief 删除键值在 rhs 中出现的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::subtract(const rb_tree& rhs) {
+    if (this == &rhs) {
+        clear();
+        return;
+    }
+    if (node_count_ == 0 || rhs.node_count_ == 0) {
+        return;
+    }
+    const size_type n = node_count_;
+    size_type removed = 0;
+    subtree t = subtract_subtree(detach(), rhs.root(), removed);
+    adopt(t, n - removed);
 }
 
 // 红黑树私有辅助函数实现
@@ -1959,18 +3131,19 @@ void rb_tree<T, Compare>::swap(rb_tree& rhs) noexcept {
 /**
  * @brief 创建一个节点
  */
-template <class T, class Compare>
+template <class T, class Compare, class Alloc, bool OrderStatistics>
 template <class ...Args>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::create_node(Args&&... args) {
-    auto tmp = node_allocator().allocate(1);
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::node_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::create_node(Args&&... args) {
+    auto tmp = node_alloc_traits::allocate(node_alloc_, 1);
     try {
-        new (&tmp->value) value_type(std::forward<Args>(args)...);
+        node_alloc_traits::construct(node_alloc_, std::addressof(tmp->value),
+                                     std::forward<Args>(args)...);
         tmp->left = nullptr;
         tmp->right = nullptr;
         tmp->parent = nullptr;
     } catch (...) {
-        node_allocator().deallocate(tmp, 1);
+        node_alloc_traits::deallocate(node_alloc_, tmp, 1);
         throw;
     }
     return tmp;
@@ -1979,11 +3152,12 @@ rb_tree<T, Compare>::create_node(Args&&... args) {
 /**
  * @brief 复制一个节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::node_ptr
-rb_tree<T, Compare>::clone_node(base_ptr x) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::node_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::clone_node(base_ptr x) {
     node_ptr tmp = create_node(x->get_node_ptr()->value);
     tmp->color = x->color;
+    rb_tree_size_ops<OrderStatistics>::copy(tmp->get_base_ptr(), x);  // 复制的子树形状不变，子树大小也不变
     tmp->left = nullptr;
     tmp->right = nullptr;
     return tmp;
@@ -1992,17 +3166,36 @@ rb_tree<T, Compare>::clone_node(base_ptr x) {
 /**
  * @brief 销毁一个节点
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::destroy_node(node_ptr p) {
-    p->value.~value_type();
-    node_allocator().deallocate(p, 1);
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::destroy_node(node_ptr p) {
+    node_alloc_traits::destroy(node_alloc_, std::addressof(p->value));
+    node_alloc_traits::deallocate(node_alloc_, p, 1);
+}
+
+/**
+ * @brief 取出句柄中的节点用于插入
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::node_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::take_node(node_handle_type& nh) {
+    if (node_handle_access::allocator(nh) == node_alloc_) {
+        node_ptr np = node_handle_access::release(nh);
+        np->left = nullptr;
+        np->right = nullptr;
+        np->parent = nullptr;
+        return np;
+    }
+    // 节点不能交给本树的分配器归还，只能移动元素
+    node_ptr np = create_node(std::move(nh.value()));
+    nh = node_handle_type();
+    return np;
 }
 
 /**
  * @brief 初始化红黑树
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::rb_tree_init() {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::rb_tree_init() {
     header_ = base_allocator().allocate(1);
     header_->color = rb_tree_red;  // header_节点颜色为红，与root区分
     root() = nullptr;
@@ -2014,8 +3207,8 @@ void rb_tree<T, Compare>::rb_tree_init() {
 /**
  * @brief 重置红黑树
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::reset() {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::reset() {
     // 原来的实现会导致对象处于无效状态
     // header_ = nullptr;
     // node_count_ = 0;
@@ -2027,9 +3220,9 @@ void rb_tree<T, Compare>::reset() {
 /**
  * @brief 获取插入位置（允许重复键值）
  */
-template <class T, class Compare>
-std::pair<typename rb_tree<T, Compare>::base_ptr, bool>
-rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr, bool>
+rb_tree<T, Compare, Alloc, OrderStatistics>::get_insert_multi_pos(const key_type& key) {
     auto x = root();
     auto y = header_;
     bool add_to_left = true;
@@ -2044,9 +3237,10 @@ rb_tree<T, Compare>::get_insert_multi_pos(const key_type& key) {
 /**
  * @brief 获取插入位置（不允许重复键值）
  */
-template <class T, class Compare>
-std::pair<std::pair<typename rb_tree<T, Compare>::base_ptr, bool>, bool>
-rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+std::pair<std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc, OrderStatistics>::get_insert_unique_pos(const K& key) {
     // 返回一个pair，第一个值为一个pair，包含插入点的父节点和一个bool表示是否在左边插入，
     // 第二个值为一个bool，表示是否插入成功
     auto x = root();
@@ -2071,16 +3265,49 @@ rb_tree<T, Compare>::get_insert_unique_pos(const key_type& key) {
         // 表明新节点没有重复
         return std::make_pair(std::make_pair(y, add_to_left), true);
     }
-    // 进行至此，表示新节点与现有节点键值重复
-    return std::make_pair(std::make_pair(y, add_to_left), false);
+    // 进行至此，表示新节点与 j 处的节点键值重复，返回 j 的位置
+    return std::make_pair(std::make_pair(j.node, add_to_left), false);
+}
+
+/**
+ * @brief 使用提示获取插入位置（不允许重复键值）
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class K>
+std::pair<std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr, bool>, bool>
+rb_tree<T, Compare, Alloc, OrderStatistics>::get_insert_unique_hint_pos(iterator hint, const K& key) {
+    if (hint != end() && !key_comp_(key, value_traits::get_key(*hint))) {
+        if (!key_comp_(value_traits::get_key(*hint), key)) {
+            // hint 处的键与 key 相等
+            return std::make_pair(std::make_pair(hint.node, false), false);
+        }
+        return get_insert_unique_pos(key);
+    }
+    // 此时 key < *hint 或 hint 为 end
+    if (node_count_ == 0) {
+        return std::make_pair(std::make_pair(header_, true), true);
+    }
+    if (hint == begin()) {
+        return std::make_pair(std::make_pair(hint.node, true), true);
+    }
+    auto before = hint;
+    --before;
+    if (key_comp_(value_traits::get_key(*before), key)) {
+        // before < key < hint，两者中必有一个在对应方向上没有子节点
+        if (before.node->right == nullptr) {
+            return std::make_pair(std::make_pair(before.node, false), true);
+        }
+        return std::make_pair(std::make_pair(hint.node, true), true);
+    }
+    return get_insert_unique_pos(key);
 }
 
 /**
  * @brief 在指定位置插入值
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_value_at(base_ptr x, const value_type& value, bool add_to_left) {
     node_ptr node = create_node(value);
     node->parent = x;
     auto base_node = node->get_base_ptr();
@@ -2113,9 +3340,9 @@ rb_tree<T, Compare>::insert_value_at(base_ptr x, const value_type& value, bool a
 /**
  * @brief 在指定位置插入节点
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left) {
     node->parent = x;
     auto base_node = node->get_base_ptr();
     if (x == header_) {
@@ -2141,9 +3368,9 @@ rb_tree<T, Compare>::insert_node_at(base_ptr x, node_ptr node, bool add_to_left)
 /**
  * @brief 使用提示插入节点（允许重复键值）
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_multi_use_hint(iterator hint, key_type key, node_ptr node) {
     // 在hint附近寻找可插入的位置
     auto np = hint.node;
     auto before = hint;
@@ -2165,9 +3392,9 @@ rb_tree<T, Compare>::insert_multi_use_hint(iterator hint, key_type key, node_ptr
 /**
  * @brief 使用提示插入节点（不允许重复键值）
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::iterator
-rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::iterator
+rb_tree<T, Compare, Alloc, OrderStatistics>::insert_unique_use_hint(iterator hint, key_type key, node_ptr node) {
     // 在hint附近寻找可插入的位置
     auto np = hint.node;
     auto before = hint;
@@ -2190,12 +3417,438 @@ rb_tree<T, Compare>::insert_unique_use_hint(iterator hint, key_type key, node_pt
     return insert_node_at(pos.first.first, node, pos.first.second);
 }
 
+/**
+ * @brief 向空树中批量插入元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+template <class InputIterator>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::build_sorted(InputIterator first, InputIterator last,
+                                                                bool unique) {
+    // 第一步：按顺序创建节点，用 right 串成链表，遇到比前一个元素小的元素时停下
+    base_ptr head = nullptr;
+    base_ptr tail = nullptr;
+    node_ptr pending = nullptr;  // 破坏有序性的节点
+    size_type n = 0;
+    try {
+        for (; first != last; ++first) {
+            node_ptr np = create_node(*first);
+            pending = np;  // 比较可能抛出异常，挂入链表之前由 pending 持有
+            if (tail != nullptr) {
+                const key_type& prev = value_traits::get_key(tail->get_node_ptr()->value);
+                const key_type& cur = value_traits::get_key(np->value);
+                if (key_comp_(cur, prev)) {
+                    ++first;
+                    break;
+                }
+                if (unique && !key_comp_(prev, cur)) {
+                    pending = nullptr;
+                    destroy_node(np);
+                    continue;
+                }
+                tail->right = np;
+            } else {
+                head = np;
+            }
+            pending = nullptr;
+            tail = np;
+            ++n;
+        }
+    } catch (...) {
+        if (pending != nullptr) {
+            destroy_node(pending);
+        }
+        while (head != nullptr) {
+            auto next = head->right;
+            destroy_node(head->get_node_ptr());
+            head = next;
+        }
+        throw;
+    }
+
+    // 第二步：链表构建成平衡树，最底层不满时该层着红色
+    if (n != 0) {
+        size_type red_depth = static_cast<size_type>(-1);
+        if ((n & (n + 1)) != 0) {
+            red_depth = 0;
+            for (size_type m = n; m > 1; m >>= 1) {
+                ++red_depth;
+            }
+        }
+        root() = build_balanced(head, n, 0, red_depth);
+        root()->parent = header_;
+        leftmost() = rb_tree_min(root());
+        rightmost() = rb_tree_max(root());
+        node_count_ = n;
+    }
+
+    // 第三步：输入并非整体有序，剩余元素逐个插入
+    if (pending != nullptr) {
+        const key_type& key = value_traits::get_key(pending->value);
+        if (unique) {
+            auto res = get_insert_unique_pos(key);
+            if (res.second) {
+                insert_node_at(res.first.first, pending, res.first.second);
+            } else {
+                destroy_node(pending);
+            }
+            for (; first != last; ++first) {
+                insert_unique(end(), *first);
+            }
+        } else {
+            auto res = get_insert_multi_pos(key);
+            insert_node_at(res.first, pending, res.second);
+            for (; first != last; ++first) {
+                insert_multi(end(), *first);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 从有序链表构建平衡子树
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::build_balanced(base_ptr& chain, size_type n,
+                                                             size_type depth, size_type red_depth) noexcept {
+    if (n == 0) {
+        return nullptr;
+    }
+    // 左子树取一半，按中序先构建左子树，再取出当前节点
+    auto left = build_balanced(chain, n / 2, depth + 1, red_depth);
+    auto x = chain;
+    chain = chain->right;
+    x->left = left;
+    if (left != nullptr) {
+        left->parent = x;
+    }
+    x->right = build_balanced(chain, n - n / 2 - 1, depth + 1, red_depth);
+    if (x->right != nullptr) {
+        x->right->parent = x;
+    }
+    x->color = depth == red_depth ? rb_tree_red : rb_tree_black;
+    rb_tree_size_ops<OrderStatistics>::assign(x, n);
+    return x;
+}
+
+/**
+ * @brief 沿最左路径计算子树的黑高
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::black_height(base_ptr x) noexcept {
+    size_type bh = 0;
+    for (; x != nullptr; x = x->left) {
+        if (!rb_tree_is_red(x)) {
+            ++bh;
+        }
+    }
+    return bh;
+}
+
+/**
+ * @brief 把 t 的根节点的子节点 x 摘下作为子树
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::child_of(const subtree& t, base_ptr x) noexcept {
+    if (x != nullptr) {
+        x->parent = nullptr;
+    }
+    return subtree{x, rb_tree_is_red(t.root) ? t.bh : t.bh - 1};
+}
+
+/**
+ * @brief 以节点k拼接两棵子树
+ * 
+ * 黑高相等时k作为黑色根节点；否则沿较高一侧的边缘向下，找到与另一侧黑高相等的黑色节点c，
+ * 把k染红放在c的位置，c和另一侧分别作为k的子树，此时只可能出现连续的红色节点，
+ * 按插入的方式向上调整即可
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::join_subtree(subtree l, base_ptr k, subtree r) noexcept {
+    using size_ops = rb_tree_size_ops<OrderStatistics>;
+    // 红色的根节点直接染黑，黑高加一
+    if (rb_tree_is_red(l.root)) {
+        rb_tree_set_black(l.root);
+        ++l.bh;
+    }
+    if (rb_tree_is_red(r.root)) {
+        rb_tree_set_black(r.root);
+        ++r.bh;
+    }
+
+    if (l.bh == r.bh) {
+        k->left = l.root;
+        k->right = r.root;
+        k->parent = nullptr;
+        if (l.root != nullptr) {
+            l.root->parent = k;
+        }
+        if (r.root != nullptr) {
+            r.root->parent = k;
+        }
+        k->color = rb_tree_black;
+        size_ops::update(k);
+        return subtree{k, l.bh + 1};
+    }
+
+    if (l.bh > r.bh) {
+        // 沿 l 的右边缘向下，h 为 c 的黑高
+        base_ptr p = nullptr;
+        base_ptr c = l.root;
+        size_type h = l.bh;
+        while (h != r.bh || rb_tree_is_red(c)) {
+            if (!rb_tree_is_red(c)) {
+                --h;
+            }
+            p = c;
+            c = c->right;
+        }
+        k->left = c;
+        k->right = r.root;
+        k->parent = p;
+        if (c != nullptr) {
+            c->parent = k;
+        }
+        if (r.root != nullptr) {
+            r.root->parent = k;
+        }
+        p->right = k;
+        size_ops::spliced(k, c, l.root);
+        rb_tree_insert_fixup(k, l.root);
+        if (rb_tree_is_red(l.root)) {
+            rb_tree_set_black(l.root);
+            ++l.bh;
+        }
+        return l;
+    }
+
+    // 对称处理：沿 r 的左边缘向下
+    base_ptr p = nullptr;
+    base_ptr c = r.root;
+    size_type h = r.bh;
+    while (h != l.bh || rb_tree_is_red(c)) {
+        if (!rb_tree_is_red(c)) {
+            --h;
+        }
+        p = c;
+        c = c->left;
+    }
+    k->left = l.root;
+    k->right = c;
+    k->parent = p;
+    if (l.root != nullptr) {
+        l.root->parent = k;
+    }
+    if (c != nullptr) {
+        c->parent = k;
+    }
+    p->left = k;
+    size_ops::spliced(k, c, r.root);
+    rb_tree_insert_fixup(k, r.root);
+    if (rb_tree_is_red(r.root)) {
+        rb_tree_set_black(r.root);
+        ++r.bh;
+    }
+    return r;
+}
+
+/**
+ * @brief 拼接两棵子树
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::concat_subtree(subtree l, subtree r) noexcept {
+    if (r.root == nullptr) {
+        return l;
+    }
+    if (l.root == nullptr) {
+        return r;
+    }
+    base_ptr k = take_min(r);
+    return join_subtree(l, k, r);
+}
+
+/**
+ * @brief 摘下子树的最小节点
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::take_min(subtree& t) noexcept {
+    base_ptr x = rb_tree_min(t.root);
+    // 子树不维护最左和最右节点
+    base_ptr leftmost = nullptr;
+    base_ptr rightmost = nullptr;
+    rb_tree_erase_rebalance(x, t.root, leftmost, rightmost);
+    t.bh = black_height(t.root);
+    return x;
+}
+
+/**
+ * @brief 按key把子树拆成两部分
+ * 
+ * 根节点属于哪一侧，就递归拆分另一侧的子树，再用根节点把同侧的子树与拆出的部分拼接起来
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+std::pair<typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree,
+          typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree>
+rb_tree<T, Compare, Alloc, OrderStatistics>::split_subtree(subtree t, const key_type& key, bool upper) {
+    if (t.root == nullptr) {
+        return std::make_pair(t, t);
+    }
+    base_ptr x = t.root;
+    subtree l = child_of(t, x->left);
+    subtree r = child_of(t, x->right);
+    const key_type& xkey = value_traits::get_key(x->get_node_ptr()->value);
+    const bool to_right = upper ? key_comp_(key, xkey) : !key_comp_(xkey, key);
+    if (to_right) {
+        auto parts = split_subtree(l, key, upper);
+        return std::make_pair(parts.first, join_subtree(parts.second, x, r));
+    }
+    auto parts = split_subtree(r, key, upper);
+    return std::make_pair(join_subtree(l, x, parts.first), parts.second);
+}
+
+/**
+ * @brief 合并两棵子树
+ * 
+ * 以 a 的根节点拆分 b，键值相等的元素在不允许重复时取出放入 rest，
+ * 允许重复时归入右半部分，排在 a 的相等元素之后
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::union_subtree(subtree a, subtree b, bool unique, rb_tree& rest) {
+    if (a.root == nullptr) {
+        return b;
+    }
+    if (b.root == nullptr) {
+        return a;
+    }
+    base_ptr k = a.root;
+    subtree al = child_of(a, k->left);
+    subtree ar = child_of(a, k->right);
+    const key_type& key = value_traits::get_key(k->get_node_ptr()->value);
+    auto parts = split_subtree(b, key, false);
+    base_ptr dup = nullptr;
+    if (unique && parts.second.root != nullptr) {
+        auto eq = split_subtree(parts.second, key, true);
+        dup = eq.first.root;  // 至多一个节点
+        parts.second = eq.second;
+    }
+    subtree l = union_subtree(al, parts.first, unique, rest);
+    if (dup != nullptr) {
+        // 左侧的重复元素已经先挂入 rest，按顺序挂在末尾即可
+        rest.insert_node_at(rest.rightmost(), dup->get_node_ptr(), false);
+    }
+    subtree r = union_subtree(ar, parts.second, unique, rest);
+    return join_subtree(l, k, r);
+}
+
+/**
+ * @brief 保留 a 中键值在以 b 为根的子树中出现的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::intersect_subtree(subtree a, base_ptr b, size_type& removed) {
+    if (a.root == nullptr) {
+        return a;
+    }
+    if (b == nullptr) {
+        removed += erase_since(a.root);
+        return subtree{nullptr, 0};
+    }
+    const key_type& key = value_traits::get_key(b->get_node_ptr()->value);
+    auto lower = split_subtree(a, key, false);
+    auto upper = split_subtree(lower.second, key, true);
+    subtree l = intersect_subtree(lower.first, b->left, removed);
+    subtree r = intersect_subtree(upper.second, b->right, removed);
+    subtree eq = upper.first;
+    if (eq.root == nullptr) {
+        return concat_subtree(l, r);
+    }
+    base_ptr k = take_min(eq);
+    return join_subtree(l, k, concat_subtree(eq, r));
+}
+
+/**
+ * @brief 释放 a 中键值在以 b 为根的子树中出现的元素
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::subtract_subtree(subtree a, base_ptr b, size_type& removed) {
+    if (a.root == nullptr || b == nullptr) {
+        return a;
+    }
+    const key_type& key = value_traits::get_key(b->get_node_ptr()->value);
+    auto lower = split_subtree(a, key, false);
+    auto upper = split_subtree(lower.second, key, true);
+    removed += erase_since(upper.first.root);
+    subtree l = subtract_subtree(lower.first, b->left, removed);
+    subtree r = subtract_subtree(upper.second, b->right, removed);
+    return concat_subtree(l, r);
+}
+
+/**
+ * @brief 把整棵树摘下作为子树
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::subtree
+rb_tree<T, Compare, Alloc, OrderStatistics>::detach() noexcept {
+    subtree t{root(), 0};
+    if (t.root != nullptr) {
+        t.root->parent = nullptr;
+        t.bh = black_height(t.root);
+    }
+    root() = nullptr;
+    leftmost() = header_;
+    rightmost() = header_;
+    node_count_ = 0;
+    return t;
+}
+
+/**
+ * @brief 以子树 t 作为本树的内容
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::adopt(subtree t, size_type n) noexcept {
+    root() = t.root;
+    if (t.root != nullptr) {
+        t.root->parent = header_;
+        rb_tree_set_black(t.root);
+        leftmost() = rb_tree_min(t.root);
+        rightmost() = rb_tree_max(t.root);
+    } else {
+        leftmost() = header_;
+        rightmost() = header_;
+    }
+    node_count_ = n;
+}
+
+/**
+ * @brief 从两端同时向 pos 计数，走过较短的一侧就停止
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::count_before_aux(const_iterator pos, std::false_type) const noexcept {
+    auto front = begin();
+    auto back = end();
+    size_type k = 0;
+    while (front != pos && back != pos) {
+        ++front;
+        --back;
+        ++k;
+    }
+    return front == pos ? k : node_count_ - k;
+}
+
 /**
  * @brief 复制一棵子树
  */
-template <class T, class Compare>
-typename rb_tree<T, Compare>::base_ptr
-rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::base_ptr
+rb_tree<T, Compare, Alloc, OrderStatistics>::copy_from(base_ptr x, base_ptr p) {
     auto top = clone_node(x);
     top->parent = p;
     try {
@@ -2222,16 +3875,33 @@ rb_tree<T, Compare>::copy_from(base_ptr x, base_ptr p) {
 }
 
 /**
- * @brief 删除一棵子树
+ * @brief 只析构一棵子树中的元素，不归还节点内存
  */
-template <class T, class Compare>
-void rb_tree<T, Compare>::erase_since(base_ptr x) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void rb_tree<T, Compare, Alloc, OrderStatistics>::destroy_since(base_ptr x, std::false_type) {
     while (x != nullptr) {
-        erase_since(x->right);
+        destroy_since(x->right, std::false_type());
+        auto y = x->left;
+        node_alloc_traits::destroy(node_alloc_, std::addressof(x->get_node_ptr()->value));
+        x = y;
+    }
+}
+
+/**
+ * @brief 删除一棵子树，返回删除的节点数
+ */
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+typename rb_tree<T, Compare, Alloc, OrderStatistics>::size_type
+rb_tree<T, Compare, Alloc, OrderStatistics>::erase_since(base_ptr x) {
+    size_type n = 0;
+    while (x != nullptr) {
+        n += erase_since(x->right);
         auto y = x->left;
         destroy_node(x->get_node_ptr());
         x = y;
+        ++n;
     }
+    return n;
 }
 
 // 重载比较操作符
@@ -2239,8 +3909,8 @@ void rb_tree<T, Compare>::erase_since(base_ptr x) {
 /**
  * @brief 相等比较运算符
  */
-template <class T, class Compare>
-bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator==(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return lhs.size() == rhs.size() && 
            std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
@@ -2248,8 +3918,8 @@ bool operator==(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs)
 /**
  * @brief 小于比较运算符
  */
-template <class T, class Compare>
-bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(),
                                       rhs.begin(), rhs.end());
 }
@@ -2257,40 +3927,40 @@ bool operator<(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
 /**
  * @brief 不等比较运算符
  */
-template <class T, class Compare>
-bool operator!=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator!=(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return !(lhs == rhs);
 }
 
 /**
  * @brief 大于比较运算符
  */
-template <class T, class Compare>
-bool operator>(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return rhs < lhs;
 }
 
 /**
  * @brief 小于等于比较运算符
  */
-template <class T, class Compare>
-bool operator<=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator<=(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return !(rhs < lhs);
 }
 
 /**
  * @brief 大于等于比较运算符
  */
-template <class T, class Compare>
-bool operator>=(const rb_tree<T, Compare>& lhs, const rb_tree<T, Compare>& rhs) {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+bool operator>=(const rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, const rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) {
     return !(lhs < rhs);
 }
 
 /**
  * @brief 重载 swap
  */
-template <class T, class Compare>
-void swap(rb_tree<T, Compare>& lhs, rb_tree<T, Compare>& rhs) noexcept {
+template <class T, class Compare, class Alloc, bool OrderStatistics>
+void swap(rb_tree<T, Compare, Alloc, OrderStatistics>& lhs, rb_tree<T, Compare, Alloc, OrderStatistics>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
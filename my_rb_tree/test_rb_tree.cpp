@@ -1,6 +1,11 @@
 #include <iostream>
 #include <string>
 #include <functional>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
 #include "my_rb_tree.h"
 
 /**
@@ -185,11 +190,380 @@ void test_interface() {
     std::cout << std::endl;
 }
 
+/**
+ * @brief 测试顺序统计操作：nth、rank、index_of、distance 和 O(log n) 的 count_multi
+ * 
+ * 随机插入和删除，定期与 std::multiset 逐个对照
+ */
+void test_order_statistics() {
+    std::cout << "\n=== 测试顺序统计操作 ===" << std::endl;
+
+    typedef mystl::rb_tree<int, std::less<int>, std::allocator<int>, true> ranked_tree;
+    std::cout << "节点大小: 普通红黑树 " << sizeof(mystl::rb_tree_node<int>)
+              << " 字节, 顺序统计红黑树 " << sizeof(mystl::rb_tree_node<int, true>) << " 字节" << std::endl;
+
+    ranked_tree tree;
+    for (int v : {30, 15, 45, 10, 20, 40, 50}) {
+        tree.insert_unique(v);
+    }
+    std::cout << "第0个元素: " << *tree.nth(0) << ", 第3个元素: " << *tree.nth(3)
+              << ", 第6个元素: " << *tree.nth(6) << std::endl;
+    std::cout << "nth(7) == end(): " << (tree.nth(7) == tree.end() ? "是" : "否") << std::endl;
+    std::cout << "rank(25): " << tree.rank(25) << ", rank(10): " << tree.rank(10)
+              << ", rank(99): " << tree.rank(99) << std::endl;
+    std::cout << "distance(lower_bound(15), upper_bound(45)): "
+              << tree.distance(tree.lower_bound(15), tree.upper_bound(45)) << std::endl;
+
+    ranked_tree multi;
+    std::multiset<int> expected;
+    std::srand(42);
+    bool ok = true;
+    for (int step = 0; step < 3000 && ok; ++step) {
+        int key = std::rand() % 64;
+        if (std::rand() % 3 != 0) {
+            multi.insert_multi(key);
+            expected.insert(key);
+        } else if (multi.erase_multi(key) != expected.erase(key)) {
+            ok = false;
+        }
+        if (step % 100 != 0) {
+            continue;
+        }
+        // 复制出的树保留子树大小，同样参与对照
+        ranked_tree copy(multi);
+        size_t index = 0;
+        for (auto it = expected.begin(); it != expected.end() && ok; ++it, ++index) {
+            auto a = multi.nth(index);
+            auto b = copy.nth(index);
+            ok = a != multi.end() && b != copy.end() && *a == *it && *b == *it &&
+                 multi.index_of(a) == index;
+        }
+        for (int k = -1; k <= 64 && ok; ++k) {
+            ok = multi.rank(k) == static_cast<size_t>(std::distance(expected.begin(), expected.lower_bound(k))) &&
+                 multi.count_multi(k) == expected.count(k) &&
+                 copy.count_multi(k) == expected.count(k);
+        }
+        ok = ok && multi.index_of(multi.end()) == multi.size() &&
+             multi.distance(multi.begin(), multi.end()) == static_cast<std::ptrdiff_t>(expected.size());
+    }
+    std::cout << "随机插入删除后与 std::multiset 对照 (" << multi.size() << " 个元素): "
+              << (ok ? "通过" : "失败") << std::endl;
+}
+
+/**
+ * @brief 检查以x为根的子树满足红黑树性质，返回黑高，不满足时返回-1
+ */
+template <class BasePtr>
+int check_rb_subtree(BasePtr x) {
+    if (x == nullptr) {
+        return 1;
+    }
+    if ((x->left != nullptr && x->left->parent != x) || (x->right != nullptr && x->right->parent != x)) {
+        return -1;
+    }
+    if (x->color == mystl::rb_tree_red &&
+        (mystl::rb_tree_is_red(x->left) || mystl::rb_tree_is_red(x->right))) {
+        return -1;
+    }
+    int lh = check_rb_subtree(x->left);
+    int rh = check_rb_subtree(x->right);
+    if (lh < 0 || lh != rh) {
+        return -1;
+    }
+    return lh + (x->color == mystl::rb_tree_black ? 1 : 0);
+}
+
+/**
+ * @brief 检查整棵树满足红黑树性质，end() 指向 header，header 的 parent 为根节点
+ */
+template <class Tree>
+bool check_rb_tree(const Tree& tree) {
+    auto root = tree.end().node->parent;
+    return root == nullptr || (root->color == mystl::rb_tree_black && check_rb_subtree(root) > 0);
+}
+
+/**
+ * @brief 测试批量构建：有序输入线性构建，无序输入退回逐个插入
+ */
+void test_bulk_build() {
+    std::cout << "\n=== 测试批量构建 ===" << std::endl;
+
+    bool ok = true;
+    for (int n = 0; n <= 300 && ok; ++n) {
+        std::vector<int> data;
+        for (int i = 0; i < n; ++i) {
+            data.push_back(i / 3);  // 每个键重复三次
+        }
+        mystl::rb_tree<int, std::less<int>> unique_tree;
+        unique_tree.assign_sorted_unique(data.begin(), data.end());
+        mystl::rb_tree<int, std::less<int>> multi_tree;
+        multi_tree.assign_sorted_multi(data.begin(), data.end());
+        std::set<int> expected(data.begin(), data.end());
+
+        ok = check_rb_tree(unique_tree) && check_rb_tree(multi_tree) &&
+             unique_tree.size() == expected.size() && multi_tree.size() == data.size() &&
+             std::equal(expected.begin(), expected.end(), unique_tree.begin()) &&
+             std::equal(data.begin(), data.end(), multi_tree.begin());
+        // 构建后继续插入删除，树仍然平衡
+        unique_tree.insert_unique(n);
+        multi_tree.erase(multi_tree.begin(), multi_tree.lower_bound(n / 6));
+        ok = ok && check_rb_tree(unique_tree) && check_rb_tree(multi_tree);
+    }
+    std::cout << "0~300个有序元素批量构建后满足红黑树性质: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 无序输入：有序的前缀批量构建，其余逐个插入，结果与std::set相同
+    std::vector<int> shuffled;
+    for (int i = 0; i < 1000; ++i) {
+        shuffled.push_back(i % 700);
+    }
+    std::shuffle(shuffled.begin() + 100, shuffled.end(), std::mt19937(7));
+    mystl::rb_tree<int, std::less<int>> tree;
+    tree.insert_unique(shuffled.begin(), shuffled.end());
+    std::set<int> expected(shuffled.begin(), shuffled.end());
+    ok = check_rb_tree(tree) && tree.size() == expected.size() &&
+         std::equal(expected.begin(), expected.end(), tree.begin());
+    std::cout << "部分无序的输入: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 顺序统计红黑树批量构建后子树大小正确
+    mystl::rb_tree<int, std::less<int>, std::allocator<int>, true> ranked;
+    std::vector<int> sorted_data;
+    for (int i = 0; i < 1000; ++i) {
+        sorted_data.push_back(i * 2);
+    }
+    ranked.assign_sorted_unique(sorted_data.begin(), sorted_data.end());
+    ok = check_rb_tree(ranked);
+    for (int i = 0; i < 1000 && ok; ++i) {
+        ok = *ranked.nth(i) == i * 2 && ranked.rank(i * 2 + 1) == static_cast<size_t>(i + 1);
+    }
+    std::cout << "顺序统计红黑树批量构建: " << (ok ? "通过" : "失败") << std::endl;
+}
+
+/**
+ * @brief 比较树与std::multiset的内容，并检查红黑树性质和最右节点
+ */
+template <class Tree>
+bool same_as(const Tree& tree, const std::multiset<int>& expected) {
+    return check_rb_tree(tree) && tree.size() == expected.size() &&
+           std::equal(expected.begin(), expected.end(), tree.begin()) &&
+           (expected.empty() || *tree.rbegin() == *expected.rbegin());
+}
+
+/**
+ * @brief 测试拼接、拆分与集合运算：随机生成两棵树，与std::multiset的结果比较
+ */
+void test_set_operations() {
+    std::cout << "\n=== 测试拼接、拆分与集合运算 ===" << std::endl;
+
+    typedef mystl::rb_tree<int, std::less<int>, std::allocator<int>, true> ranked_tree;
+    std::mt19937 gen(13);
+    bool ok = true;
+    for (int round = 0; round < 500 && ok; ++round) {
+        // 一半的轮次让第二棵树很小，覆盖大小悬殊的情况
+        const int na = static_cast<int>(gen() % 200);
+        const int nb = static_cast<int>(gen() % (round % 2 == 0 ? 200 : 5));
+        ranked_tree ua, ub, ma, mb;
+        std::multiset<int> sua, sub, sma, smb;
+        for (int i = 0; i < na; ++i) {
+            int v = static_cast<int>(gen() % 300);
+            ma.insert_multi(v);
+            sma.insert(v);
+            if (ua.insert_unique(v).second) {
+                sua.insert(v);
+            }
+        }
+        for (int i = 0; i < nb; ++i) {
+            int v = static_cast<int>(gen() % 300);
+            mb.insert_multi(v);
+            smb.insert(v);
+            if (ub.insert_unique(v).second) {
+                sub.insert(v);
+            }
+        }
+
+        std::multiset<int> expected, rest;
+        switch (round % 5) {
+        case 0: {
+            // merge_unique：重复的元素留在 ub 中
+            for (int v : sub) {
+                (sua.count(v) ? rest : expected).insert(v);
+            }
+            expected.insert(sua.begin(), sua.end());
+            ua.merge_unique(ub);
+            ok = same_as(ua, expected) && same_as(ub, rest);
+            break;
+        }
+        case 1: {
+            // merge_multi：mb 的所有元素移入 ma
+            expected = sma;
+            expected.insert(smb.begin(), smb.end());
+            ma.merge_multi(mb);
+            ok = same_as(ma, expected) && same_as(mb, rest);
+            break;
+        }
+        case 2:
+            for (int v : sma) {
+                if (smb.count(v)) {
+                    expected.insert(v);
+                }
+            }
+            ma.intersect(mb);
+            ok = same_as(ma, expected);
+            break;
+        case 3:
+            for (int v : sma) {
+                if (!smb.count(v)) {
+                    expected.insert(v);
+                }
+            }
+            ma.subtract(mb);
+            ok = same_as(ma, expected);
+            break;
+        default: {
+            // 拆分后再拼接回来
+            const int key = static_cast<int>(gen() % 300);
+            ranked_tree right;
+            ma.split(key, right);
+            expected.insert(sma.begin(), sma.lower_bound(key));
+            rest.insert(sma.lower_bound(key), sma.end());
+            ok = same_as(ma, expected) && same_as(right, rest);
+            ma.join(right);
+            ok = ok && same_as(ma, sma) && right.empty();
+            expected = sma;
+            break;
+        }
+        }
+
+        // 子树大小随节点转移一起维护
+        auto target = round % 5 == 0 ? &ua : &ma;
+        for (size_t k = 0; k < target->size() && ok; ++k) {
+            ok = *target->nth(k) == *std::next(expected.begin(), static_cast<std::ptrdiff_t>(k));
+        }
+    }
+    std::cout << "500轮随机合并、交集、差集、拆分与拼接: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 普通红黑树：拆分时从两端统计元素个数
+    mystl::rb_tree<int, std::less<int>> left, right;
+    for (int i = 0; i < 100; ++i) {
+        left.insert_unique(i);
+    }
+    left.split(30, right);
+    ok = check_rb_tree(left) && check_rb_tree(right) && left.size() == 30 && right.size() == 70 &&
+         *left.rbegin() == 29 && *right.begin() == 30;
+    left.split(80, right);  // right 原有的元素被清除
+    ok = ok && left.size() == 30 && right.empty();
+    std::cout << "普通红黑树拆分: " << (ok ? "通过" : "失败") << std::endl;
+}
+
+/**
+ * @brief 统计调用次数的比较器，用来确认带提示的插入没有从根节点查找
+ */
+struct counting_less {
+    static int calls;
+    bool operator()(int lhs, int rhs) const {
+        ++calls;
+        return lhs < rhs;
+    }
+};
+
+int counting_less::calls = 0;
+
+void test_node_handle() {
+    std::cout << "\n=== 测试节点句柄 ===" << std::endl;
+
+    typedef mystl::rb_tree<std::pair<const int, std::string>, std::less<int>,
+                           std::allocator<std::pair<const int, std::string>>, true> map_tree;
+    map_tree a, b;
+    for (int i = 0; i < 50; ++i) {
+        a.insert_unique(std::make_pair(i, std::to_string(i)));
+    }
+
+    // 改键：摘下后修改键再放回，节点不重新分配
+    auto nh = a.extract(10);
+    const std::string* addr = &nh.mapped();
+    nh.key() = 100;
+    auto r = a.insert_unique(std::move(nh));
+    bool ok = r.inserted && nh.empty() && r.position->first == 100 && &r.position->second == addr &&
+              a.size() == 50 && a.count_unique(10) == 0 && a.rank(100) == 49 &&
+              check_rb_tree(a);
+    std::cout << "改键: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 键已存在时节点留在返回值中；空句柄插入失败
+    b.insert_unique(std::make_pair(3, std::string("b")));
+    r = b.insert_unique(a.extract(a.find(3)));
+    ok = !r.inserted && r.node && r.node.mapped() == "3" && r.position->second == "b";
+    ok = ok && a.extract(1000).empty() && !a.insert_unique(map_tree::node_handle_type()).inserted;
+    std::cout << "重复键与空句柄: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 转移到另一棵树，允许重复键值
+    while (!a.empty()) {
+        b.insert_multi(a.extract(a.begin()));
+    }
+    ok = a.empty() && b.size() == 50 && b.count_multi(3) == 1 && check_rb_tree(b);
+    for (size_t k = 0; k + 1 < b.size() && ok; ++k) {
+        ok = b.nth(k)->first <= b.nth(k + 1)->first;
+    }
+    std::cout << "跨树转移: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 句柄析构时归还节点
+    {
+        auto dropped = b.extract(b.begin());
+        ok = dropped && b.size() == 49;
+    }
+    std::cout << "句柄析构: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 分配器不相等时把元素移动到新节点
+    typedef mystl::rb_tree<std::string, std::less<std::string>,
+                           mystl::pool_allocator<std::string>> pool_tree;
+    pool_tree p, q;
+    p.insert_unique(std::string("moved"));
+    auto pr = q.insert_unique(p.extract(std::string("moved")));
+    ok = pr.inserted && p.empty() && q.size() == 1 && *q.begin() == "moved";
+    std::cout << "不同分配器: " << (ok ? "通过" : "失败") << std::endl;
+
+    // 带提示插入：键落在提示位置之前时直接链接，每个节点只比较两次
+    typedef mystl::rb_tree<int, counting_less> count_tree;
+    count_tree evens, odds;
+    for (int i = 0; i < 1000; ++i) {
+        (i % 2 == 0 ? evens : odds).insert_unique(i);
+    }
+    std::vector<count_tree::iterator> hints;
+    for (auto it = ++evens.begin(); it != evens.end(); ++it) {
+        hints.push_back(it);
+    }
+    hints.push_back(evens.end());
+    counting_less::calls = 0;
+    for (auto hint : hints) {
+        evens.insert_unique(hint, odds.extract(odds.begin()));
+    }
+    ok = counting_less::calls <= 2 * static_cast<int>(hints.size()) && odds.empty() &&
+         evens.size() == 1000 && check_rb_tree(evens);
+    int expect = 0;
+    for (auto it = evens.begin(); it != evens.end() && ok; ++it) {
+        ok = *it == expect++;
+    }
+
+    // 键已存在时节点留在句柄中；允许重复键值时同样使用提示
+    auto dup = odds.insert_unique(5).first;
+    auto dnh = odds.extract(dup);
+    auto pos = evens.insert_unique(evens.find(5), std::move(dnh));
+    ok = ok && dnh && dnh.value() == 5 && *pos == 5 && evens.size() == 1000;
+    auto next = evens.find(6);
+    counting_less::calls = 0;
+    auto mpos = evens.insert_multi(next, std::move(dnh));
+    ok = ok && counting_less::calls <= 2 && dnh.empty() && *mpos == 5 && ++mpos == next &&
+         evens.size() == 1001 && check_rb_tree(evens);
+    std::cout << "带提示插入: " << (ok ? "通过" : "失败") << std::endl;
+}
+
 int main() {
     test_basic();
     test_multi();
     test_complex_type();
     test_interface();
+    test_order_statistics();
+    test_bulk_build();
+    test_set_operations();
+    test_node_handle();
     
     std::cout << "\n所有测试完成！" << std::endl;
     return 0;
@@ -258,6 +258,85 @@ void test_iterator_performance() {
     }
 }
 
+/**
+ * 测试从有序数据批量构建的性能
+ */
+void test_bulk_build_performance() {
+    std::cout << "\n=== 测试有序数据批量构建性能 ===" << std::endl;
+
+    const size_t size = 1000000;
+    std::vector<int> sorted_data(size);
+    for (size_t i = 0; i < size; ++i) {
+        sorted_data[i] = static_cast<int>(i);
+    }
+
+    // 逐个插入
+    {
+        mystl::rb_tree<int, std::less<int>> tree;
+        Timer timer("逐个insert_unique (1000000个有序元素)");
+        for (const auto& val : sorted_data) {
+            tree.insert_unique(val);
+        }
+        std::cout << "  树大小: " << tree.size() << std::endl;
+    }
+
+    // 批量构建
+    {
+        mystl::rb_tree<int, std::less<int>> tree;
+        Timer timer("assign_sorted_unique (1000000个有序元素)");
+        tree.assign_sorted_unique(sorted_data.begin(), sorted_data.end());
+        std::cout << "  树大小: " << tree.size() << std::endl;
+    }
+}
+
+/**
+ * 分别用逐个insert_unique和merge_unique把b的元素并入a，输出耗时
+ */
+void compare_merge(const std::string& name, const std::vector<int>& a_data, const std::vector<int>& b_data) {
+    typedef mystl::rb_tree<int, std::less<int>> tree_type;
+    {
+        tree_type a, b;
+        a.assign_sorted_unique(a_data.begin(), a_data.end());
+        b.assign_sorted_unique(b_data.begin(), b_data.end());
+        Timer timer("逐个insert_unique (" + name + ")");
+        for (auto it = b.begin(); it != b.end(); ++it) {
+            a.insert_unique(*it);
+        }
+        b.clear();
+        std::cout << "  树大小: " << a.size() << std::endl;
+    }
+    {
+        tree_type a, b;
+        a.assign_sorted_unique(a_data.begin(), a_data.end());
+        b.assign_sorted_unique(b_data.begin(), b_data.end());
+        Timer timer("merge_unique (" + name + ")");
+        a.merge_unique(b);
+        std::cout << "  树大小: " << a.size() << std::endl;
+    }
+}
+
+void test_merge_performance() {
+    std::cout << "\n=== 测试合并性能 ===" << std::endl;
+
+    const int size = 1000000;
+    std::vector<int> even_data(size), odd_data(size), later_data(size);
+    for (int i = 0; i < size; ++i) {
+        even_data[i] = i * 2;
+        odd_data[i] = i * 2 + 1;
+        later_data[i] = size * 2 + i;
+    }
+    std::mt19937 gen(42);
+    std::vector<int> random_data(10000);
+    for (auto& val : random_data) {
+        val = static_cast<int>(gen() % (size * 2));
+    }
+    std::sort(random_data.begin(), random_data.end());
+
+    compare_merge("10000个随机元素并入1000000个", even_data, random_data);
+    compare_merge("两棵1000000个元素的交错树", even_data, odd_data);
+    compare_merge("1000000个更大的元素接在1000000个之后", even_data, later_data);
+}
+
 int main() {
     std::cout << "===== 红黑树性能测试 =====" << std::endl;
     
@@ -266,6 +345,8 @@ int main() {
     test_erase_performance();
     test_range_query_performance();
     test_iterator_performance();
+    test_bulk_build_performance();
+    test_merge_performance();
     
     std::cout << "\n性能测试完成！" << std::endl;
     return 0;
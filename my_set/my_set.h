@@ -6,6 +6,8 @@
 // multiset : 集合，键值即实值，集合内元素会自动排序，键值允许重复
 
 #include "../my_rb_tree/my_rb_tree.h"
+#include "../my_memory_resource/my_memory_resource.h"
+#include "../my_functional/my_functional.h"
 #include <initializer_list>
 #include <functional>
 
@@ -17,8 +19,11 @@ namespace mystl
  * @brief 模板类 set，基于红黑树实现的键值不允许重复的集合
  * @tparam Key 键值类型
  * @tparam Compare 键值比较方式，默认使用 std::less
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam OrderStatistics 为 true 时底层红黑树维护子树大小，提供 O(log n) 的 nth、rank 和 distance
  */
-template <class Key, class Compare = std::less<Key>>
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>,
+          bool OrderStatistics = false>
 class set
 {
 public:
@@ -30,12 +35,13 @@ public:
 
 private:
     // 使用红黑树作为底层实现机制
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc, OrderStatistics> base_type;
     base_type tree_; // 红黑树成员
 
 public:
     // 使用 rb_tree 定义的类型
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
+    typedef mystl::node_insert_return<typename base_type::const_iterator, node_type> insert_return_type;
     typedef typename base_type::const_pointer          pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::const_reference        reference;
@@ -54,22 +60,30 @@ public:
      */
     set() = default;
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * @param alloc 分配器
+     */
+    explicit set(const allocator_type& alloc)
+        :tree_(alloc)
+    { }
+
     /**
      * @brief 迭代器范围构造函数
      * @param first 起始迭代器
      * @param last 结束迭代器
      */
     template <class InputIterator>
-    set(InputIterator first, InputIterator last)
-        :tree_()
+    set(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        :tree_(alloc)
     { tree_.insert_unique(first, last); }
 
     /**
      * @brief 初始化列表构造函数
      * @param ilist 初始化列表
      */
-    set(std::initializer_list<value_type> ilist)
-        :tree_()
+    set(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        :tree_(alloc)
     { tree_.insert_unique(ilist.begin(), ilist.end()); }
 
     /**
@@ -80,6 +94,15 @@ public:
         :tree_(rhs.tree_)
     { }
 
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    set(const set& rhs, const allocator_type& alloc)
+        :tree_(rhs.tree_, alloc)
+    { }
+
     /**
      * @brief 移动构造函数
      * @param rhs 源对象
@@ -88,6 +111,15 @@ public:
         :tree_(std::move(rhs.tree_))
     { }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    set(set&& rhs, const allocator_type& alloc)
+        :tree_(std::move(rhs.tree_), alloc)
+    { }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源对象
@@ -104,7 +136,7 @@ public:
      * @param rhs 源对象
      * @return 自引用
      */
-    set& operator=(set&& rhs) noexcept
+    set& operator=(set&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         tree_ = std::move(rhs.tree_);
         return *this;
@@ -329,6 +361,21 @@ public:
         tree_.insert_unique(first, last);
     }
 
+    /**
+     * @brief 用一段有序的元素替换容器的内容
+     * 
+     * 输入有序时直接构建平衡的红黑树，O(n)，相邻的重复元素只保留第一个；
+     * 输入实际无序时退回逐个插入，结果仍然正确。从空容器插入一个范围时也会走同样的路径
+     * @tparam InputIterator 输入迭代器类型
+     * @param first 范围开始
+     * @param last 范围结束
+     */
+    template <class InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last)
+    {
+        tree_.assign_sorted_unique(first, last);
+    }
+
     /**
      * @brief 删除指定位置的元素
      * @param position 要删除的位置
@@ -366,6 +413,50 @@ public:
         tree_.clear();
     }
 
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * @param position 指定的位置
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(iterator position)
+    {
+        return tree_.extract(position);
+    }
+
+    /**
+     * @brief 摘下一个值为 key 的元素，不存在时返回空的节点句柄
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    {
+        return tree_.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄中的元素，键已存在时节点留在返回值的 node 中
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素；可以先修改 nh.value() 再放回，完成改值
+     * @param nh 节点句柄，插入成功后变为空
+     * @return insert_return_type 插入位置、是否插入以及未插入的节点
+     */
+    insert_return_type insert(node_type&& nh)
+    {
+        auto result = tree_.insert_unique(std::move(nh));
+        return insert_return_type{result.position, result.inserted, std::move(result.node)};
+    }
+
+    /**
+     * @brief 在指定位置附近插入节点句柄中的元素
+     * @param hint 指定的位置
+     * @param nh 节点句柄
+     * @return iterator 指向键相同的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(iterator hint, node_type&& nh)
+    {
+        return tree_.insert_unique(hint, std::move(nh));
+    }
+
     // 查找操作
 
     /**
@@ -458,6 +549,188 @@ public:
         return tree_.equal_range_unique(key);
     }
 
+    /**
+     * @brief 异构查找：Compare 声明了 is_transparent（如 mystl::transparent_less）时，
+     *        以下函数接受任何能与 key_type 比较的类型，不构造临时的 key_type
+     * 
+     * 例如 set<mystl::string, mystl::transparent_less> 可以直接用 const char* 查找
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator find(const K& key)
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator find(const K& key) const
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type count(const K& key) const
+    {
+        return tree_.count_unique(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator lower_bound(const K& key)
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator lower_bound(const K& key) const
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator upper_bound(const K& key)
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator upper_bound(const K& key) const
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return tree_.equal_range_unique(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return tree_.equal_range_unique(key);
+    }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    {
+        return tree_.erase_unique(key);
+    }
+
+    /**
+     * @brief 顺序统计操作，nth和rank要求OrderStatistics为true，均为O(log n)
+     */
+
+    /**
+     * @brief 获取排序后的第k个元素（从0开始）
+     * @param k 序号
+     * @return 指向第k个元素的迭代器，k >= size()时返回end()
+     */
+    iterator nth(size_type k)
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取排序后的第k个元素（常量版本）
+     * @param k 序号
+     * @return 指向第k个元素的常量迭代器，k >= size()时返回end()
+     */
+    const_iterator nth(size_type k) const
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取小于指定键的元素个数，即lower_bound(key)的序号
+     * @param key 键值
+     * @return 小于key的元素个数
+     */
+    size_type rank(const key_type& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type rank(const K& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    /**
+     * @brief 获取两个迭代器之间的元素个数，OrderStatistics为true时不逐个遍历
+     * @param first 范围起点
+     * @param last 范围终点
+     * @return [first, last)中的元素个数
+     */
+    difference_type distance(const_iterator first, const_iterator last) const
+    {
+        return tree_.distance(first, last);
+    }
+
+    /**
+     * @brief 把 source 中键不在本容器中的元素移入本容器，其余元素留在 source 中
+     * 
+     * 分配器相等时直接转移节点，不分配也不复制元素：以本容器的根节点拆分 source，
+     * 两侧递归合并后再拼接，O(m log(n/m + 1))，m、n分别为较小和较大的容器的大小
+     * @param source 要合并的set
+     */
+    void merge(set& source)
+    {
+        tree_.merge_unique(source.tree_);
+    }
+
+    void merge(set&& source)
+    {
+        tree_.merge_unique(source.tree_);
+    }
+
+    /**
+     * @brief 并集：合并 other 的元素，键已存在的元素被丢弃，other 变为空
+     * @param other 要合并的set
+     */
+    void set_union(set&& other)
+    {
+        tree_.merge_unique(other.tree_);
+        other.clear();
+    }
+
+    /**
+     * @brief 交集：只保留键在 other 中出现的元素
+     * 
+     * 沿 other 的结构三路拆分本容器，O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个set，不会被修改
+     */
+    void set_intersection(const set& other)
+    {
+        tree_.intersect(other.tree_);
+    }
+
+    /**
+     * @brief 差集：删除键在 other 中出现的元素
+     * 
+     * O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个set，不会被修改
+     */
+    void set_difference(const set& other)
+    {
+        tree_.subtract(other.tree_);
+    }
+
     /**
      * @brief 交换两个set的内容
      * @param rhs 要交换的set
@@ -485,8 +758,8 @@ public:
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator==(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs == rhs;
 }
@@ -496,8 +769,8 @@ bool operator==(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator<(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs < rhs;
 }
@@ -507,8 +780,8 @@ bool operator<(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator!=(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -518,8 +791,8 @@ bool operator!=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator>(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return rhs < lhs;
 }
@@ -529,8 +802,8 @@ bool operator>(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator<=(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(rhs < lhs);
 }
@@ -540,8 +813,8 @@ bool operator<=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator>=(const set<Key, Compare, Alloc, OrderStatistics>& lhs, const set<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs < rhs);
 }
@@ -551,8 +824,8 @@ bool operator>=(const set<Key, Compare>& lhs, const set<Key, Compare>& rhs)
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+void swap(set<Key, Compare, Alloc, OrderStatistics>& lhs, set<Key, Compare, Alloc, OrderStatistics>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -564,8 +837,11 @@ void swap(set<Key, Compare>& lhs, set<Key, Compare>& rhs) noexcept
  * @brief 模板类 multiset，基于红黑树实现的键值允许重复的集合
  * @tparam Key 键值类型
  * @tparam Compare 键值比较方式，默认使用 std::less
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam OrderStatistics 为 true 时底层红黑树维护子树大小，提供 O(log n) 的 nth、rank 和 distance
  */
-template <class Key, class Compare = std::less<Key>>
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>,
+          bool OrderStatistics = false>
 class multiset
 {
 public:
@@ -577,12 +853,12 @@ public:
 
 private:
     // 使用红黑树作为底层实现机制
-    typedef mystl::rb_tree<value_type, key_compare> base_type;
+    typedef mystl::rb_tree<value_type, key_compare, Alloc, OrderStatistics> base_type;
     base_type tree_; // 红黑树成员
 
 public:
     // 使用 rb_tree 定义的类型
-    typedef typename base_type::node_type              node_type;
+    typedef typename base_type::node_handle_type       node_type;
     typedef typename base_type::const_pointer          pointer;
     typedef typename base_type::const_pointer          const_pointer;
     typedef typename base_type::const_reference        reference;
@@ -601,22 +877,30 @@ public:
      */
     multiset() = default;
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * @param alloc 分配器
+     */
+    explicit multiset(const allocator_type& alloc)
+        :tree_(alloc)
+    { }
+
     /**
      * @brief 迭代器范围构造函数
      * @param first 起始迭代器
      * @param last 结束迭代器
      */
     template <class InputIterator>
-    multiset(InputIterator first, InputIterator last)
-        :tree_()
+    multiset(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        :tree_(alloc)
     { tree_.insert_multi(first, last); }
 
     /**
      * @brief 初始化列表构造函数
      * @param ilist 初始化列表
      */
-    multiset(std::initializer_list<value_type> ilist)
-        :tree_()
+    multiset(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        :tree_(alloc)
     { tree_.insert_multi(ilist.begin(), ilist.end()); }
 
     /**
@@ -627,6 +911,15 @@ public:
         :tree_(rhs.tree_)
     { }
 
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    multiset(const multiset& rhs, const allocator_type& alloc)
+        :tree_(rhs.tree_, alloc)
+    { }
+
     /**
      * @brief 移动构造函数
      * @param rhs 源对象
@@ -635,6 +928,15 @@ public:
         :tree_(std::move(rhs.tree_))
     { }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    multiset(multiset&& rhs, const allocator_type& alloc)
+        :tree_(std::move(rhs.tree_), alloc)
+    { }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源对象
@@ -651,7 +953,7 @@ public:
      * @param rhs 源对象
      * @return 自引用
      */
-    multiset& operator=(multiset&& rhs) noexcept
+    multiset& operator=(multiset&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         tree_ = std::move(rhs.tree_);
         return *this;
@@ -876,6 +1178,21 @@ public:
         tree_.insert_multi(first, last);
     }
 
+    /**
+     * @brief 用一段有序的元素替换容器的内容
+     * 
+     * 输入有序时直接构建平衡的红黑树，O(n)，相等的元素保持输入顺序；
+     * 输入实际无序时退回逐个插入，结果仍然正确。从空容器插入一个范围时也会走同样的路径
+     * @tparam InputIterator 输入迭代器类型
+     * @param first 范围开始
+     * @param last 范围结束
+     */
+    template <class InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last)
+    {
+        tree_.assign_sorted_multi(first, last);
+    }
+
     /**
      * @brief 删除指定位置的元素
      * @param position 要删除的位置
@@ -913,6 +1230,49 @@ public:
         tree_.clear();
     }
 
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * @param position 指定的位置
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(iterator position)
+    {
+        return tree_.extract(position);
+    }
+
+    /**
+     * @brief 摘下一个值为 key 的元素，不存在时返回空的节点句柄
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    {
+        return tree_.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄中的元素
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素
+     * @param nh 节点句柄，插入后变为空
+     * @return iterator 指向新元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(node_type&& nh)
+    {
+        return tree_.insert_multi(std::move(nh));
+    }
+
+    /**
+     * @brief 在指定位置附近插入节点句柄中的元素
+     * @param hint 指定的位置
+     * @param nh 节点句柄
+     * @return iterator 指向新元素的迭代器
+     */
+    iterator insert(iterator hint, node_type&& nh)
+    {
+        return tree_.insert_multi(hint, std::move(nh));
+    }
+
     // 查找操作
 
     /**
@@ -1005,6 +1365,190 @@ public:
         return tree_.equal_range_multi(key);
     }
 
+    /**
+     * @brief 异构查找：Compare 声明了 is_transparent（如 mystl::transparent_less）时，
+     *        以下函数接受任何能与 key_type 比较的类型，不构造临时的 key_type
+     * 
+     * 例如 set<mystl::string, mystl::transparent_less> 可以直接用 const char* 查找
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator find(const K& key)
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator find(const K& key) const
+    {
+        return tree_.find(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type count(const K& key) const
+    {
+        return tree_.count_multi(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator lower_bound(const K& key)
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator lower_bound(const K& key) const
+    {
+        return tree_.lower_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    iterator upper_bound(const K& key)
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    const_iterator upper_bound(const K& key) const
+    {
+        return tree_.upper_bound(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    {
+        return tree_.equal_range_multi(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    {
+        return tree_.equal_range_multi(key);
+    }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    {
+        return tree_.erase_multi(key);
+    }
+
+    /**
+     * @brief 顺序统计操作，nth和rank要求OrderStatistics为true，均为O(log n)
+     */
+
+    /**
+     * @brief 获取排序后的第k个元素（从0开始）
+     * @param k 序号
+     * @return 指向第k个元素的迭代器，k >= size()时返回end()
+     */
+    iterator nth(size_type k)
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取排序后的第k个元素（常量版本）
+     * @param k 序号
+     * @return 指向第k个元素的常量迭代器，k >= size()时返回end()
+     */
+    const_iterator nth(size_type k) const
+    {
+        return tree_.nth(k);
+    }
+
+    /**
+     * @brief 获取小于指定键的元素个数，即lower_bound(key)的序号
+     * @param key 键值
+     * @return 小于key的元素个数
+     */
+    size_type rank(const key_type& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    template <class K, class C = Compare,
+              class = typename std::enable_if<mystl::is_transparent<C>::value>::type>
+    size_type rank(const K& key) const
+    {
+        return tree_.rank(key);
+    }
+
+    /**
+     * @brief 获取两个迭代器之间的元素个数，OrderStatistics为true时不逐个遍历
+     * @param first 范围起点
+     * @param last 范围终点
+     * @return [first, last)中的元素个数
+     */
+    difference_type distance(const_iterator first, const_iterator last) const
+    {
+        return tree_.distance(first, last);
+    }
+
+    /**
+     * @brief 把 source 的所有元素移入本容器，source 变为空
+     * 
+     * 分配器相等时直接转移节点，不分配也不复制元素，O(m log(n/m + 1))；
+     * 键相等时 source 的元素排在本容器的元素之后
+     * @param source 要合并的multiset
+     */
+    void merge(multiset& source)
+    {
+        tree_.merge_multi(source.tree_);
+    }
+
+    void merge(multiset&& source)
+    {
+        tree_.merge_multi(source.tree_);
+    }
+
+    /**
+     * @brief 并集：合并 other 的所有元素，other 变为空
+     * @param other 要合并的multiset
+     */
+    void set_union(multiset&& other)
+    {
+        tree_.merge_multi(other.tree_);
+        other.clear();
+    }
+
+    /**
+     * @brief 交集：只保留键在 other 中出现的元素
+     * 按键过滤：与 other 中某个键相等的元素全部保留，不按重复次数配对
+     * 
+     * 沿 other 的结构三路拆分本容器，O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个multiset，不会被修改
+     */
+    void set_intersection(const multiset& other)
+    {
+        tree_.intersect(other.tree_);
+    }
+
+    /**
+     * @brief 差集：删除键在 other 中出现的元素
+     * 按键过滤：与 other 中某个键相等的元素全部删除，不按重复次数配对
+     * 
+     * O(m log(n/m + 1))，被删除的节点逐个释放
+     * @param other 另一个multiset，不会被修改
+     */
+    void set_difference(const multiset& other)
+    {
+        tree_.subtract(other.tree_);
+    }
+
     /**
      * @brief 交换两个multiset的内容
      * @param rhs 要交换的multiset
@@ -1032,8 +1576,8 @@ public:
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator==(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs == rhs;
 }
@@ -1043,8 +1587,8 @@ bool operator==(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator<(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return lhs < rhs;
 }
@@ -1054,8 +1598,8 @@ bool operator<(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator!=(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs == rhs);
 }
@@ -1065,8 +1609,8 @@ bool operator!=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator>(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return rhs < lhs;
 }
@@ -1076,8 +1620,8 @@ bool operator>(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator<=(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(rhs < lhs);
 }
@@ -1087,8 +1631,8 @@ bool operator<=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>& rhs)
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+bool operator>=(const multiset<Key, Compare, Alloc, OrderStatistics>& lhs, const multiset<Key, Compare, Alloc, OrderStatistics>& rhs)
 {
     return !(lhs < rhs);
 }
@@ -1098,11 +1642,34 @@ bool operator>=(const multiset<Key, Compare>& lhs, const multiset<Key, Compare>&
  * @tparam Key 键类型
  * @tparam Compare 比较函数类型
  */
-template <class Key, class Compare>
-void swap(multiset<Key, Compare>& lhs, multiset<Key, Compare>& rhs) noexcept
+template <class Key, class Compare, class Alloc, bool OrderStatistics>
+void swap(multiset<Key, Compare, Alloc, OrderStatistics>& lhs, multiset<Key, Compare, Alloc, OrderStatistics>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 维护子树大小的 set / multiset，支持按名次取元素和求排名
+ */
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>>
+using ranked_set = set<Key, Compare, Alloc, true>;
+
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>>
+using ranked_multiset = multiset<Key, Compare, Alloc, true>;
+
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 set / multiset
+ */
+template <class Key, class Compare = std::less<Key>>
+using set = mystl::set<Key, Compare, polymorphic_allocator<Key>>;
+
+template <class Key, class Compare = std::less<Key>>
+using multiset = mystl::multiset<Key, Compare, polymorphic_allocator<Key>>;
+
+} // namespace pmr
+
 } // namespace mystl
 #endif // MY_SET_H_ 
\ No newline at end of file
@@ -195,6 +195,62 @@ int main() {
     std::cout << "从ms2中删除元素5，共删除: " << erased << " 个元素" << std::endl;
     print_multiset(ms2, "ms2 (删除元素5后)");
     
+    // 测试顺序统计操作
+    std::cout << "\n===== 测试顺序统计操作 =====" << std::endl;
+    mystl::ranked_set<int> s9 = {50, 10, 40, 20, 30};
+    std::cout << "s9中第0个元素: " << *s9.nth(0) << ", 第2个元素: " << *s9.nth(2) << std::endl;
+    std::cout << "s9中小于35的元素个数: " << s9.rank(35) << std::endl;
+    std::cout << "s9中[20, 40]内的元素个数: " << s9.distance(s9.lower_bound(20), s9.upper_bound(40)) << std::endl;
+
+    mystl::ranked_multiset<int> ms5;
+    for (int i = 0; i < 100; ++i) {
+        ms5.insert(i % 4);
+    }
+    std::cout << "ms5中元素2的数量: " << ms5.count(2) << ", 排名: " << ms5.rank(2)
+              << ", 第50个元素: " << *ms5.nth(50) << std::endl;
+    std::cout << "ms5的中位数: " << *ms5.nth(ms5.size() / 2) << std::endl;
+
+    // 测试assign_sorted
+    std::vector<int> sorted_data = {1, 2, 2, 3, 5, 8, 8, 8, 13};
+    mystl::set<int> s10 = {100, 200};
+    s10.assign_sorted(sorted_data.begin(), sorted_data.end());
+    print_set(s10, "s10 (assign_sorted后)");
+    mystl::multiset<int> ms6;
+    ms6.assign_sorted(sorted_data.begin(), sorted_data.end());
+    print_multiset(ms6, "ms6 (assign_sorted后)");
+
+    // 测试合并与集合运算
+    mystl::set<int> s11 = {1, 3, 5, 7, 9};
+    mystl::set<int> s12 = {2, 3, 4, 5};
+    s11.merge(s12);
+    print_set(s11, "s11 (merge s12后)");
+    print_set(s12, "s12 (留下重复的元素)");
+    mystl::set<int> s13 = {3, 4, 10};
+    s11.set_intersection(s13);
+    print_set(s11, "s11 (与{3, 4, 10}的交集)");
+    mystl::set<int> s14 = {1, 2, 3, 4, 5, 6};
+    s14.set_difference(s12);
+    print_set(s14, "s14 (与s12的差集)");
+    mystl::multiset<int> ms7 = {1, 2, 2, 3};
+    ms7.set_union(mystl::multiset<int>{2, 3, 3, 4});
+    print_multiset(ms7, "ms7 (并集)");
+
+
+    // 测试节点句柄
+    auto nh = s11.extract(4);
+    nh.value() = 40;  // 改值后放回，节点不重新分配
+    auto nh_result = s11.insert(std::move(nh));
+    std::cout << "改值 4 -> 40: " << (nh_result.inserted ? "成功" : "失败") << std::endl;
+    print_set(s11, "s11 (改值后)");
+    mystl::set<int> s15 = {3};
+    nh_result = s15.insert(s11.extract(3));
+    std::cout << "把3移入s15: " << (nh_result.inserted ? "成功" : "已存在, 节点留在返回值中")
+              << ", 句柄中的值: " << nh_result.node.value() << std::endl;
+    mystl::multiset<int> ms8;
+    ms8.insert(std::move(nh_result.node));
+    ms8.insert(s15.extract(s15.begin()));
+    print_multiset(ms8, "ms8 (转移节点后)");
+    print_set(s11, "s11 (摘下3后)");    
     std::cout << "测试完成!" << std::endl;
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,375 @@
+#ifndef MY_SMALL_VECTOR_H
+#define MY_SMALL_VECTOR_H
+
+// 这个头文件包含在对象内部预留 N 个元素空间的 small_vector
+//
+// 大量只有 0 ~ 8 个元素的短列表（邻接表、每个条目的标签、语法树节点的子节点）用 vector 存放时，
+// 每个非空的列表都要一次堆分配，第一次分配就是 16 个元素，遍历时还要多跳一次指针。
+// small_vector<T, N> 在对象内部放一块能容纳 N 个元素的缓冲区：
+//   * 元素不超过 N 个时全部存放在对象内部，不分配堆内存
+//   * 超过 N 个时按 vector 的增长策略（1.5 倍）换到堆上，与 vector 完全相同
+//   * 插入、删除、扩容、可平凡重定位元素的整块搬动都直接复用 mystl::vector 的实现：
+//     内部缓冲区通过分配器 small_vector_allocator 交给 vector，vector 把它当作一块普通的空间
+// 元素存放在对象内部时，移动和交换需要逐个移动元素，复杂度为 O(N)；元素在堆上时与 vector 一样只交换指针
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../my_vector/my_vector.h"
+
+namespace mystl {
+
+/**
+ * @brief small_vector 对象内部的缓冲区，能容纳 N 个 T
+ *
+ * 作为 small_vector 的第一个基类，保证在 vector 基类构造（可能已经要分配空间）之前初始化
+ */
+template <class T, size_t N>
+struct small_vector_buffer {
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage;
+    bool in_use;  // 缓冲区是否已经分配给 vector
+
+    small_vector_buffer() noexcept : in_use(false) {}
+
+    T* data() noexcept {
+        return reinterpret_cast<T*>(&storage);
+    }
+
+    const T* data() const noexcept {
+        return reinterpret_cast<const T*>(&storage);
+    }
+};
+
+/**
+ * @brief 优先从所属 small_vector 的内部缓冲区分配的分配器
+ *
+ * 请求不超过 N 个元素且缓冲区空闲时返回内部缓冲区，否则从堆上分配。
+ * 分配器只保存缓冲区的地址，只有指向同一块缓冲区的分配器才相等；
+ * 不随容器的拷贝、移动、交换传播，small_vector 自己处理这些操作
+ */
+template <class T, size_t N>
+class small_vector_allocator {
+public:
+    typedef T                              value_type;
+    typedef std::false_type                propagate_on_container_copy_assignment;
+    typedef std::false_type                propagate_on_container_move_assignment;
+    typedef std::false_type                propagate_on_container_swap;
+
+    template <class U>
+    struct rebind { typedef small_vector_allocator<U, N> other; };
+
+    explicit small_vector_allocator(small_vector_buffer<T, N>* buffer) noexcept
+        : buffer_(buffer) {
+    }
+
+    T* allocate(size_t n) {
+        if (n <= N && !buffer_->in_use) {
+            buffer_->in_use = true;
+            return buffer_->data();
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (p == buffer_->data()) {
+            buffer_->in_use = false;
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    bool operator==(const small_vector_allocator& rhs) const noexcept {
+        return buffer_ == rhs.buffer_;
+    }
+
+    bool operator!=(const small_vector_allocator& rhs) const noexcept {
+        return buffer_ != rhs.buffer_;
+    }
+
+private:
+    small_vector_buffer<T, N>* buffer_;
+};
+
+// construct / destroy 使用默认实现，vector 可以整块搬动元素
+template <class T, size_t N>
+struct is_plain_allocator<small_vector_allocator<T, N>> : std::true_type {};
+
+/**
+ * @brief 元素不超过 N 个时存放在对象内部的 vector
+ *
+ * 接口与 mystl::vector 相同。容量始终不小于 N；被移动之后的对象仍然可以直接使用
+ *
+ * @tparam T 元素类型
+ * @tparam N 对象内部可以存放的元素个数
+ */
+template <class T, size_t N>
+class small_vector
+    : private small_vector_buffer<T, N>,
+      private vector<T, small_vector_allocator<T, N>, vector_growth_factor<3, 2, N>> {
+    static_assert(N > 0, "small_vector 的内部容量必须大于 0");
+
+    typedef small_vector_buffer<T, N>    buffer_type;
+    typedef small_vector_allocator<T, N> allocator_type;
+    // 空容器第一次分配 N 个元素，正好是内部缓冲区；之后与 vector 相同按 1.5 倍增长
+    typedef vector<T, small_vector_allocator<T, N>, vector_growth_factor<3, 2, N>> base;
+
+public:
+    typedef typename base::value_type             value_type;
+    typedef typename base::pointer                pointer;
+    typedef typename base::const_pointer          const_pointer;
+    typedef typename base::reference              reference;
+    typedef typename base::const_reference        const_reference;
+    typedef typename base::iterator               iterator;
+    typedef typename base::const_iterator         const_iterator;
+    typedef typename base::reverse_iterator       reverse_iterator;
+    typedef typename base::const_reverse_iterator const_reverse_iterator;
+    typedef typename base::size_type              size_type;
+    typedef typename base::difference_type        difference_type;
+
+    static constexpr size_type inline_capacity = N;
+
+    // 以下操作与 vector 完全相同
+    using base::begin;
+    using base::end;
+    using base::rbegin;
+    using base::rend;
+    using base::cbegin;
+    using base::cend;
+    using base::crbegin;
+    using base::crend;
+    using base::empty;
+    using base::size;
+    using base::max_size;
+    using base::capacity;
+    using base::reserve;
+    using base::operator[];
+    using base::at;
+    using base::front;
+    using base::back;
+    using base::data;
+    using base::assign;
+    using base::emplace;
+    using base::emplace_back;
+    using base::push_back;
+    using base::pop_back;
+    using base::insert;
+    using base::erase;
+    using base::clear;
+    using base::resize;
+    using base::resize_default_init;
+    using base::resize_and_overwrite;
+    using base::reverse;
+
+    // 构造函数、析构函数和赋值运算符
+
+    /**
+     * @brief 默认构造函数，使用内部缓冲区，不分配内存
+     */
+    small_vector()
+        : buffer_type(), base(allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 构造 n 个值初始化的元素
+     */
+    explicit small_vector(size_type n)
+        : buffer_type(), base(n, allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 构造 n 个 value
+     */
+    small_vector(size_type n, const value_type& value)
+        : buffer_type(), base(n, value, allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 迭代器范围构造函数
+     */
+    template <class Iter, typename std::enable_if<
+        std::is_convertible<typename std::iterator_traits<Iter>::iterator_category,
+        std::input_iterator_tag>::value, int>::type = 0>
+    small_vector(Iter first, Iter last)
+        : buffer_type(), base(first, last, allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 初始化列表构造函数
+     */
+    small_vector(std::initializer_list<value_type> ilist)
+        : buffer_type(), base(ilist, allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 拷贝构造函数，元素不超过 N 个时复制到内部缓冲区
+     */
+    small_vector(const small_vector& rhs)
+        : buffer_type(), base(rhs, allocator_type(this)) {
+        use_inline_buffer();
+    }
+
+    /**
+     * @brief 移动构造函数
+     *
+     * rhs 的元素在堆上时直接接管，在内部缓冲区时逐个移动；之后 rhs 为空
+     */
+    small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : buffer_type(), base(allocator_type(this)) {
+        use_inline_buffer();
+        move_from(rhs);
+    }
+
+    /**
+     * @brief 拷贝赋值运算符
+     */
+    small_vector& operator=(const small_vector& rhs) {
+        base::operator=(rhs);
+        return *this;
+    }
+
+    /**
+     * @brief 移动赋值运算符，规则同移动构造函数
+     */
+    small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value &&
+                                                        std::is_nothrow_move_assignable<T>::value) {
+        if (this != &rhs) {
+            move_from(rhs);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 初始化列表赋值运算符
+     */
+    small_vector& operator=(std::initializer_list<value_type> ilist) {
+        base::assign(ilist);
+        return *this;
+    }
+
+    // 容量相关操作
+
+    /**
+     * @brief 元素是否存放在对象内部的缓冲区中
+     */
+    bool is_inline() const noexcept {
+        return base::data() == buffer_type::data();
+    }
+
+    /**
+     * @brief 收缩容量
+     *
+     * 元素在内部缓冲区时什么也不做；在堆上且不超过 N 个时搬回内部缓冲区并释放堆空间
+     */
+    void shrink_to_fit() {
+        if (is_inline()) {
+            return;
+        }
+        if (size() <= N) {
+            // 内部缓冲区空闲，临时 vector 的第一次分配正好得到它
+            base tmp(std::make_move_iterator(base::begin()), std::make_move_iterator(base::end()),
+                     allocator_type(this));
+            base::swap(tmp);
+            use_inline_buffer();
+        } else {
+            base::shrink_to_fit();
+        }
+    }
+
+    /**
+     * @brief 与另一个 small_vector 交换内容
+     *
+     * 双方的元素都在堆上时只交换指针，否则逐个移动元素
+     */
+    void swap(small_vector& rhs) {
+        if (this == &rhs) {
+            return;
+        }
+        if (!is_inline() && !rhs.is_inline()) {
+            base::swap(rhs);
+            return;
+        }
+        small_vector tmp(std::move(rhs));
+        rhs.move_from(*this);
+        move_from(tmp);
+    }
+
+private:
+    /**
+     * @brief 还没有分配空间时换用内部缓冲区，使容量不小于 N
+     */
+    void use_inline_buffer() {
+        if (base::capacity() == 0) {
+            base::reserve(N);
+        }
+    }
+
+    /**
+     * @brief 用 rhs 的元素替换自身的元素，之后 rhs 为空
+     */
+    void move_from(small_vector& rhs) {
+        if (rhs.is_inline()) {
+            base::assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+            rhs.clear();
+        } else {
+            // rhs 的堆空间来自 std::allocator，本对象的分配器同样可以释放
+            base::take_storage(rhs);
+            rhs.use_inline_buffer();
+        }
+    }
+};
+
+template <class T, size_t N>
+constexpr typename small_vector<T, N>::size_type small_vector<T, N>::inline_capacity;
+
+// 比较运算符
+
+template <class T, size_t N>
+bool operator==(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+bool operator!=(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+bool operator<(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N>
+bool operator>(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <class T, size_t N>
+bool operator<=(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class T, size_t N>
+bool operator>=(const small_vector<T, N>& lhs, const small_vector<T, N>& rhs) {
+    return !(lhs < rhs);
+}
+
+/**
+ * @brief 交换两个 small_vector
+ */
+template <class T, size_t N>
+void swap(small_vector<T, N>& lhs, small_vector<T, N>& rhs) {
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
+
+#endif // MY_SMALL_VECTOR_H
@@ -0,0 +1,220 @@
+// test_small_vector.cpp
+// 测试 small_vector：元素不超过 N 个时不分配堆内存，超过后换到堆上，拷贝、移动、交换在两种状态下都正确
+
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <stdexcept>
+
+#include "my_small_vector.h"
+
+// 统计全局 operator new 的调用次数，用于确认内部缓冲区没有分配堆内存
+static size_t g_allocations = 0;
+
+void* operator new(std::size_t n) {
+    ++g_allocations;
+    if (void* p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+/**
+ * @brief 不超过 N 个元素时存放在对象内部，超过后按 vector 的增长策略换到堆上
+ */
+void test_inline_and_spill() {
+    std::cout << "===== 测试内部缓冲区与换到堆上 =====" << std::endl;
+
+    const size_t before = g_allocations;
+    mystl::small_vector<int, 4> v;
+    assert(v.empty() && v.is_inline() && v.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    assert(v.is_inline() && v.capacity() == 4 && g_allocations == before);
+
+    // 第 5 个元素：按 1.5 倍增长换到堆上
+    v.push_back(4);
+    assert(!v.is_inline() && v.capacity() == 6 && g_allocations == before + 1);
+    for (int i = 5; i < 10; ++i) {
+        v.push_back(i);
+    }
+    assert(v.capacity() == 13 && v.size() == 10);
+    for (int i = 0; i < 10; ++i) {
+        assert(v[i] == i);
+    }
+
+    // 中间插入、删除复用 vector 的实现
+    v.insert(v.begin() + 2, 3, -1);
+    v.erase(v.begin(), v.begin() + 2);
+    v.emplace(v.begin() + 1, 100);
+    assert(v.size() == 12 && v[0] == -1 && v[1] == 100 && v[3] == -1 && v[4] == 2 && v.back() == 9);
+
+    // 收缩：不超过 N 个元素时搬回内部缓冲区
+    v.erase(v.begin() + 3, v.end());
+    v.shrink_to_fit();
+    assert(v.is_inline() && v.capacity() == 4 && v.size() == 3 && v[1] == 100);
+    v.shrink_to_fit();
+    assert(v.is_inline());
+    v.clear();
+    v.shrink_to_fit();
+    assert(v.is_inline() && v.capacity() == 4);
+
+    // 构造函数：不超过 N 个元素时都不分配堆内存
+    const size_t start = g_allocations;
+    mystl::small_vector<int, 8> a(5, 7);
+    mystl::small_vector<int, 8> b{1, 2, 3};
+    mystl::small_vector<int, 8> c(b.begin(), b.end());
+    mystl::small_vector<int, 8> d(8);
+    mystl::small_vector<int, 8> e(0);
+    assert(a.is_inline() && b.is_inline() && c.is_inline() && d.is_inline() && e.is_inline());
+    assert(g_allocations == start);
+    assert(a.size() == 5 && a[4] == 7 && c == b && d[7] == 0 && e.capacity() == 8);
+
+    mystl::small_vector<int, 8> big(20, 1);
+    assert(!big.is_inline() && big.size() == 20);
+
+    // reserve、resize 与 vector 相同
+    mystl::small_vector<int, 8> r;
+    r.reserve(3);
+    assert(r.is_inline() && r.capacity() == 8);
+    r.resize(8, 5);
+    assert(r.is_inline());
+    r.resize(9);
+    assert(!r.is_inline() && r[7] == 5 && r[8] == 0);
+    r.resize_default_init(2);
+    assert(r.size() == 2 && r[1] == 5);
+
+    std::cout << "内部缓冲区与换到堆上测试通过!" << std::endl;
+}
+
+/**
+ * @brief 拷贝、移动、交换：元素在内部缓冲区时逐个处理，在堆上时接管指针
+ */
+void test_copy_move_swap() {
+    std::cout << "===== 测试拷贝、移动与交换 =====" << std::endl;
+
+    typedef mystl::small_vector<std::string, 2> vec;
+    const vec small{"a", "b"};
+    const vec large{"x", "y", "z"};
+    assert(small.is_inline() && !large.is_inline());
+
+    // 拷贝：不超过 N 个元素时复制到内部缓冲区
+    vec c1(small), c2(large);
+    assert(c1 == small && c1.is_inline() && c2 == large && !c2.is_inline());
+    assert(c2.data() != large.data());
+
+    // 拷贝赋值的四种组合
+    vec t1(small), t2(small), t3(large), t4(large);
+    t1 = large;
+    t2 = small;
+    t3 = small;
+    t4 = large;
+    assert(t1 == large && t2 == small && t3 == small && t4 == large);
+    t1 = {"p"};
+    assert(t1.size() == 1 && t1[0] == "p");
+
+    // 移动构造：堆上的空间直接接管，内部缓冲区中的元素逐个移动
+    vec heap(large);
+    const std::string* heap_data = heap.data();
+    vec m1(std::move(heap));
+    assert(m1 == large && m1.data() == heap_data);
+    assert(heap.empty() && heap.is_inline() && heap.capacity() == 2);
+    heap.push_back("reused");
+    assert(heap.size() == 1 && heap.is_inline());
+
+    vec inl(small);
+    vec m2(std::move(inl));
+    assert(m2 == small && m2.is_inline() && inl.empty() && inl.is_inline());
+
+    // 移动赋值
+    vec target(small);
+    vec src(large);
+    heap_data = src.data();
+    target = std::move(src);
+    assert(target == large && target.data() == heap_data && src.empty() && src.is_inline());
+    vec src2(small);
+    target = std::move(src2);
+    assert(target == small && src2.empty());   // 保留已有的堆空间，与 vector 的赋值相同
+    target = std::move(target);
+    assert(target == small);
+
+    // 交换：双方都在堆上时只交换指针
+    vec h1(large), h2{"1", "2", "3", "4"};
+    const std::string* d1 = h1.data();
+    const std::string* d2 = h2.data();
+    h1.swap(h2);
+    assert(h1.data() == d2 && h2.data() == d1 && h1.size() == 4 && h2 == large);
+
+    vec i1(small), i2{"q"};
+    swap(i1, h1);
+    assert(i1.size() == 4 && !i1.is_inline() && h1 == small && h1.is_inline());
+    swap(i1, i2);
+    assert(i1.size() == 1 && i1[0] == "q" && i2.size() == 4 && i2[3] == "4");
+    i1.swap(i1);
+    assert(i1.size() == 1);
+
+    // 比较
+    assert(small < large && large > small && small <= small && large >= small && small != large);
+
+    std::cout << "拷贝、移动与交换测试通过!" << std::endl;
+}
+
+/**
+ * @brief 只能移动的元素，以及插入的值引用容器内元素的情况
+ */
+void test_elements() {
+    std::cout << "===== 测试元素类型 =====" << std::endl;
+
+    mystl::small_vector<std::unique_ptr<int>, 3> v;
+    for (int i = 0; i < 3; ++i) {
+        v.emplace_back(new int(i));
+    }
+    assert(v.is_inline());
+    v.emplace(v.begin(), new int(-1));
+    assert(!v.is_inline() && v.size() == 4 && *v[0] == -1 && *v[3] == 2);
+    v.erase(v.begin() + 1);
+    mystl::small_vector<std::unique_ptr<int>, 3> w(std::move(v));
+    assert(w.size() == 3 && *w[1] == 1 && v.empty());
+    w.pop_back();
+    w.shrink_to_fit();
+    assert(w.is_inline() && *w[0] == -1 && *w[1] == 1);
+
+    // 换到堆上的同时插入的值引用内部缓冲区中的元素
+    mystl::small_vector<std::string, 2> s{"first", "second"};
+    s.push_back(s[0]);
+    s.insert(s.begin(), s[2]);
+    assert(s.size() == 4 && s[0] == "first" && s[3] == "first");
+
+    // resize_and_overwrite 的 op 抛出异常时大小恢复，元素仍在内部缓冲区
+    mystl::small_vector<int, 4> e{1, 2, 3};
+    bool thrown = false;
+    try {
+        e.resize_and_overwrite(4, [](int*, size_t) -> size_t { throw std::runtime_error("io"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && e.is_inline() && e.size() == 3);
+
+    std::cout << "元素类型测试通过!" << std::endl;
+}
+
+int main() {
+    test_inline_and_spill();
+    test_copy_move_swap();
+    test_elements();
+
+    std::cout << "\n所有测试通过!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+// test_small_vector_perf.cpp
+// 大量只有几个元素的短列表：std::vector、mystl::vector 与 mystl::small_vector<int, 8> 的构建、遍历、销毁耗时
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+#include "my_small_vector.h"
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+/**
+ * @brief 构建 count 个各有 k 个元素的列表，遍历求和，再全部销毁，返回三步的毫秒数
+ */
+template <class List>
+void run(int count, int k, double& build_ms, double& scan_ms, double& destroy_ms) {
+    typedef std::chrono::high_resolution_clock clock;
+    auto t0 = clock::now();
+    std::vector<List>* lists = new std::vector<List>(count);
+    for (int i = 0; i < count; ++i) {
+        List& list = (*lists)[i];
+        for (int j = 0; j < k; ++j) {
+            list.push_back(i + j);
+        }
+    }
+    auto t1 = clock::now();
+    long long sum = 0;
+    for (int round = 0; round < 5; ++round) {
+        for (const List& list : *lists) {
+            for (int x : list) {
+                sum += x;
+            }
+        }
+    }
+    g_sink += sum;
+    auto t2 = clock::now();
+    delete lists;
+    auto t3 = clock::now();
+    build_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    scan_ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    destroy_ms = std::chrono::duration<double, std::milli>(t3 - t2).count();
+}
+
+template <class List>
+void report(const char* name, int count, int k) {
+    double build = 0, scan = 0, destroy = 0;
+    run<List>(count, k, build, scan, destroy);
+    std::cout << "  " << name << std::fixed << std::setprecision(1)
+              << std::setw(10) << build << std::setw(10) << scan << std::setw(10) << destroy << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::cout << "===== " << count << " 个短列表（构建 / 遍历 5 次 / 销毁，单位: 毫秒）=====" << std::endl;
+    std::cout << "sizeof: std::vector<int> = " << sizeof(std::vector<int>)
+              << "，mystl::vector<int> = " << sizeof(mystl::vector<int>)
+              << "，mystl::small_vector<int, 8> = " << sizeof(mystl::small_vector<int, 8>) << std::endl;
+
+    const int sizes[] = {0, 1, 2, 4, 8, 16};
+    for (int k : sizes) {
+        std::cout << "\n每个列表 " << k << " 个元素                构建      遍历      销毁" << std::endl;
+        report<std::vector<int>>("std::vector<int>          ", count, k);
+        report<mystl::vector<int>>("mystl::vector<int>        ", count, k);
+        report<mystl::small_vector<int, 8>>("mystl::small_vector<int,8>", count, k);
+    }
+    return 0;
+}
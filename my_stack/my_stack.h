@@ -16,6 +16,7 @@
 #include "../my_deque/my_deque.h"    
 #include <type_traits>  // 用于静态断言
 #include <algorithm>    // 用于std::swap
+#include <memory>       // 用于std::uses_allocator
 
 namespace mystl
 {
@@ -128,6 +129,67 @@ public:
     {
     }
 
+    // 带分配器的构造函数，仅当底层容器使用 Alloc 类型的分配器时参与重载
+
+    /**
+     * @brief 使用指定分配器构造空栈
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    explicit stack(const Alloc& alloc)
+        :c_(alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器从底层容器构造栈
+     * @param c 底层容器
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    stack(const Container& c, const Alloc& alloc)
+        :c_(c, alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器从底层容器移动构造栈
+     * @param c 底层容器(右值引用)
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    stack(Container&& c, const Alloc& alloc)
+        :c_(std::move(c), alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器拷贝构造栈
+     * @param rhs 源栈对象
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    stack(const stack& rhs, const Alloc& alloc)
+        :c_(rhs.c_, alloc)
+    {
+    }
+
+    /**
+     * @brief 使用指定分配器移动构造栈
+     * @param rhs 源栈对象(右值引用)
+     * @param alloc 传给底层容器的分配器
+     */
+    template <class Alloc, class = typename std::enable_if<
+        std::uses_allocator<Container, Alloc>::value>::type>
+    stack(stack&& rhs, const Alloc& alloc)
+        :c_(std::move(rhs.c_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * @param rhs 源栈对象
@@ -348,4 +410,18 @@ void swap(stack<T, Container>& lhs, stack<T, Container>& rhs) noexcept(noexcept(
 
 } // namespace mystl
 
+namespace std
+{
+
+/**
+ * @brief 栈是否使用 Alloc 类型的分配器，由底层容器决定
+ */
+template <class T, class Container, class Alloc>
+struct uses_allocator<mystl::stack<T, Container>, Alloc>
+    : uses_allocator<Container, Alloc>::type
+{
+};
+
+} // namespace std
+
 #endif // MY_STACK_H 
\ No newline at end of file
@@ -3,10 +3,13 @@
  * @brief 测试my_stack实现的正确性
  */
 #include "my_stack.h"
+#include "../my_test_support/tagged_allocator.h"
 #include <iostream>
 #include <string>
 #include <cassert>
 #include <vector>
+#include <memory>
+#include <type_traits>
 
 /**
  * @brief 测试基本功能
@@ -255,6 +258,39 @@ void test_different_container() {
     std::cout << "不同底层容器测试通过！" << std::endl;
 }
 
+/**
+ * @brief 测试带分配器的构造函数把分配器传给底层容器
+ */
+void test_allocator_constructors() {
+    std::cout << "测试带分配器的构造函数..." << std::endl;
+    {
+        typedef tagged_allocator<int, false> alloc;
+        typedef mystl::deque<int, alloc> container;
+        typedef mystl::stack<int, container> stack_type;
+        static_assert(std::uses_allocator<stack_type, alloc>::value, "stack 应当使用底层容器的分配器");
+        static_assert(!std::uses_allocator<stack_type, std::allocator<int>>::value, "分配器类型不匹配");
+
+        stack_type s1(alloc(1));
+        s1.push(1);
+        s1.push(2);
+        assert((tagged_allocator<char, false>::live[1] > 0));
+
+        stack_type s2(s1, alloc(2));  // 使用指定分配器拷贝
+        assert(s2 == s1);
+        assert((tagged_allocator<char, false>::live[2] > 0));
+
+        stack_type s3(std::move(s2), alloc(3));  // 分配器不相等：逐个移动元素
+        assert(s3.top() == 2 && s3.size() == 2);
+
+        container c(alloc(4));
+        c.push_back(7);
+        stack_type s4(c, alloc(5));
+        assert(s4.top() == 7);
+    }
+    assert(all_released<false>());
+    std::cout << "带分配器的构造函数测试通过！" << std::endl;
+}
+
 int main() {
     std::cout << "开始测试my_stack..." << std::endl;
     
@@ -267,6 +303,7 @@ int main() {
     test_swap();
     test_global_swap();
     test_different_container();
+    test_allocator_constructors();
     
     std::cout << "所有测试通过！my_stack实现正确。" << std::endl;
     
@@ -17,6 +17,8 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <limits>
+#include <cstdint>
+#include "../my_memory_resource/my_memory_resource.h"
 
 namespace mystl {
 
@@ -235,22 +237,23 @@ struct char_traits<wchar_t> {
     }
 };
 
-// 字符串默认初始大小（可调整）
-constexpr size_t STRING_INIT_SIZE = 16;
-
 // ------------------------------------------------------------------------------------------
 // basic_string类模板
 // ------------------------------------------------------------------------------------------
 
 /**
  * @brief 字符串类模板
- * 
+ *
+ * 采用短字符串优化（SSO）：不超过 local_capacity 个字符的字符串直接存放在对象内部的缓冲区中，
+ * 构造、拷贝和赋值都不分配内存；更长的字符串存放在分配器分配的堆空间中，
+ * 两种存储之间的切换对使用者透明
+ *
  * @tparam CharT 字符类型
  * @tparam Traits 字符特性类
  * @tparam Alloc 分配器类型
  */
 template <class CharT, class Traits = char_traits<CharT>, class Alloc = std::allocator<CharT>>
-class basic_string {
+class basic_string : private mystl::alloc_holder<Alloc> {
 public:
     // 类型定义
     using traits_type = Traits;
@@ -266,197 +269,144 @@ public:
     using const_iterator = const value_type*;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    
+
     // 特殊值，表示"未找到"或"全部"
     static constexpr size_type npos = static_cast<size_type>(-1);
 
+    // 对象内部缓冲区可容纳的字符数（不含结尾的空字符），char 为 15
+    static constexpr size_type local_capacity = 15 / sizeof(CharT);
+
 private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+    using alloc_base = mystl::alloc_holder<Alloc>;    // 分配器
+    using alloc_base::get_alloc;
+
     // 实现细节
-    struct Rep {
-        size_type capacity;  // 容量
-        size_type size;      // 大小
-        
-        // 获取字符数组起始位置
-        CharT* data() noexcept {
-            return reinterpret_cast<CharT*>(this + 1);
-        }
-        
-        const CharT* data() const noexcept {
-            return reinterpret_cast<const CharT*>(this + 1);
-        }
-        
-        // 创建新的Rep
-        static Rep* create(const Alloc& alloc, size_type capacity) {
-            typename std::allocator_traits<Alloc>::template rebind_alloc<Rep> rep_alloc(alloc);
-            
-            // 计算需要分配的内存大小（Rep结构体 + 字符数组）
-            size_type bytes = sizeof(Rep) + sizeof(CharT) * (capacity + 1);
-            
-            // 分配内存
-            void* mem = std::allocator_traits<decltype(rep_alloc)>::allocate(rep_alloc, bytes);
-            
-            // 构造Rep对象
-            Rep* rep = new (mem) Rep;
-            rep->capacity = capacity;
-            rep->size = 0;
-            
-            // 末尾添加空字符
-            rep->data()[0] = CharT();
-            
-            return rep;
-        }
-        
-        // 释放Rep
-        static void destroy(const Alloc& alloc, Rep* rep) {
-            if (rep) {
-                typename std::allocator_traits<Alloc>::template rebind_alloc<Rep> rep_alloc(alloc);
-                
-                // 计算分配的内存大小
-                size_type bytes = sizeof(Rep) + sizeof(CharT) * (rep->capacity + 1);
-                
-                // 调用析构函数
-                rep->~Rep();
-                
-                // 释放内存
-                std::allocator_traits<decltype(rep_alloc)>::deallocate(rep_alloc, rep, bytes);
-            }
-        }
+    // data_ 指向 local_buf_ 时为短字符串，否则指向堆上容量为 capacity_ + 1 的字符数组。
+    // 两种存储互斥，因此 capacity_ 与 local_buf_ 共用同一块空间
+    pointer   data_;                                  // 字符数组，始终以空字符结尾
+    size_type size_;                                  // 字符数
+    union {
+        size_type capacity_;                          // 堆上字符数组的容量（不含结尾的空字符）
+        CharT     local_buf_[local_capacity + 1];     // 短字符串的内部缓冲区
     };
-    
-    Rep* rep_;          // 指向字符串数据的表示
-    Alloc alloc_;       // 分配器
 
 public:
     /**
-     * @brief 默认构造函数
+     * @brief 默认构造函数，不分配内存
      */
     basic_string() noexcept(noexcept(Alloc()))
-        : rep_(nullptr), alloc_(Alloc()) {
-        rep_ = Rep::create(alloc_, STRING_INIT_SIZE);
+        : alloc_base(Alloc()), data_(local_buf_), size_(0) {
+        local_buf_[0] = CharT();
     }
-    
+
     /**
-     * @brief 带分配器的构造函数
+     * @brief 带分配器的构造函数，不分配内存
      */
     explicit basic_string(const Alloc& alloc) noexcept
-        : rep_(nullptr), alloc_(alloc) {
-        rep_ = Rep::create(alloc_, STRING_INIT_SIZE);
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        local_buf_[0] = CharT();
     }
-    
+
     /**
      * @brief 从C风格字符串构造
      */
     basic_string(const CharT* s, const Alloc& alloc = Alloc())
-        : rep_(nullptr), alloc_(alloc) {
-        const size_type len = traits_type::length(s);
-        rep_ = Rep::create(alloc_, len);
-        traits_type::copy(rep_->data(), s, len);
-        rep_->size = len;
-        rep_->data()[len] = CharT();
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        init(s, traits_type::length(s));
     }
-    
+
     /**
      * @brief 从C风格字符串构造指定长度
      */
     basic_string(const CharT* s, size_type n, const Alloc& alloc = Alloc())
-        : rep_(nullptr), alloc_(alloc) {
-        rep_ = Rep::create(alloc_, n);
-        traits_type::copy(rep_->data(), s, n);
-        rep_->size = n;
-        rep_->data()[n] = CharT();
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        init(s, n);
     }
-    
+
     /**
      * @brief 填充构造函数
      */
     basic_string(size_type n, CharT c, const Alloc& alloc = Alloc())
-        : rep_(nullptr), alloc_(alloc) {
-        rep_ = Rep::create(alloc_, n);
-        traits_type::fill(rep_->data(), c, n);
-        rep_->size = n;
-        rep_->data()[n] = CharT();
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        if (n > local_capacity) {
+            data_ = allocate_chars(n);
+            capacity_ = n;
+        }
+        traits_type::fill(data_, c, n);
+        set_length(n);
     }
-    
+
     /**
      * @brief 范围构造函数
      */
     template <class InputIt, typename = typename std::enable_if<
-        std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category, 
+        std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category,
                            std::input_iterator_tag>::value>::type>
     basic_string(InputIt first, InputIt last, const Alloc& alloc = Alloc())
-        : rep_(nullptr), alloc_(alloc) {
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
         const size_type len = std::distance(first, last);
-        rep_ = Rep::create(alloc_, len);
-        
-        size_type i = 0;
-        for (auto it = first; it != last; ++it, ++i) {
-            rep_->data()[i] = *it;
+        if (len > local_capacity) {
+            data_ = allocate_chars(len);
+            capacity_ = len;
         }
-        
-        rep_->size = len;
-        rep_->data()[len] = CharT();
+        std::copy(first, last, data_);
+        set_length(len);
     }
-    
+
     /**
      * @brief 复制构造函数
      */
     basic_string(const basic_string& other)
-        : rep_(nullptr), alloc_(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc_)) {
-        rep_ = Rep::create(alloc_, other.size());
-        traits_type::copy(rep_->data(), other.data(), other.size());
-        rep_->size = other.size();
-        rep_->data()[rep_->size] = CharT();
+        : alloc_base(alloc_traits::select_on_container_copy_construction(other.get_alloc())),
+          data_(local_buf_), size_(0) {
+        init(other.data_, other.size_);
     }
-    
+
     /**
      * @brief 带分配器的复制构造函数
      */
     basic_string(const basic_string& other, const Alloc& alloc)
-        : rep_(nullptr), alloc_(alloc) {
-        rep_ = Rep::create(alloc_, other.size());
-        traits_type::copy(rep_->data(), other.data(), other.size());
-        rep_->size = other.size();
-        rep_->data()[rep_->size] = CharT();
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        init(other.data_, other.size_);
     }
-    
+
     /**
      * @brief 移动构造函数
+     *
+     * 堆上的字符数组直接转移；短字符串只需拷贝内部缓冲区。移动后 other 为空字符串
      */
     basic_string(basic_string&& other) noexcept
-        : rep_(other.rep_), alloc_(std::move(other.alloc_)) {
-        other.rep_ = nullptr;
+        : alloc_base(std::move(other.get_alloc())), data_(local_buf_), size_(0) {
+        steal(other);
     }
-    
+
     /**
      * @brief 带分配器的移动构造函数
+     *
+     * 分配器不相等时 other 的堆空间不能由本字符串释放，需要重新分配并拷贝
      */
-    basic_string(basic_string&& other, const Alloc& alloc) noexcept
-        : rep_(nullptr), alloc_(alloc) {
-        if (alloc_ == other.alloc_) {
-            // 分配器相同，直接移动
-            rep_ = other.rep_;
-            other.rep_ = nullptr;
+    basic_string(basic_string&& other, const Alloc& alloc)
+        : alloc_base(alloc), data_(local_buf_), size_(0) {
+        if (other.is_local() || get_alloc() == other.get_alloc()) {
+            steal(other);
         } else {
-            // 分配器不同，需要重新分配
-            rep_ = Rep::create(alloc_, other.size());
-            traits_type::copy(rep_->data(), other.data(), other.size());
-            rep_->size = other.size();
-            rep_->data()[rep_->size] = CharT();
+            init(other.data_, other.size_);
         }
     }
-    
+
     /**
      * @brief 从初始化列表构造
      */
     basic_string(std::initializer_list<CharT> ilist, const Alloc& alloc = Alloc())
         : basic_string(ilist.begin(), ilist.end(), alloc) {
     }
-    
+
     /**
      * @brief 析构函数
      */
     ~basic_string() {
-        Rep::destroy(alloc_, rep_);
+        release_heap();
     }
 
     /**
@@ -465,31 +415,20 @@ public:
     basic_string& operator=(const basic_string& other) {
         if (this != &other) {
             // 判断是否需要更新分配器
-            if (std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value) {
-                if (alloc_ != other.alloc_) {
-                    // 分配器不同，释放旧内存，使用新分配器
-                    Rep::destroy(alloc_, rep_);
-                    alloc_ = other.alloc_;
-                    rep_ = Rep::create(alloc_, other.size());
-                } else if (rep_->capacity < other.size()) {
-                    // 容量不足，重新分配
-                    Rep::destroy(alloc_, rep_);
-                    rep_ = Rep::create(alloc_, other.size());
+            if (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (get_alloc() != other.get_alloc()) {
+                    // 分配器不同，先用旧分配器释放堆空间
+                    release_heap();
+                    data_ = local_buf_;
+                    set_length(0);
                 }
-            } else if (rep_->capacity < other.size()) {
-                // 容量不足，重新分配
-                Rep::destroy(alloc_, rep_);
-                rep_ = Rep::create(alloc_, other.size());
+                get_alloc() = other.get_alloc();
             }
-            
-            // 复制数据
-            traits_type::copy(rep_->data(), other.data(), other.size());
-            rep_->size = other.size();
-            rep_->data()[rep_->size] = CharT();
+            assign_chars(other.data_, other.size_);
         }
         return *this;
     }
-    
+
     /**
      * @brief 移动赋值操作符
      */
@@ -498,80 +437,65 @@ public:
         std::allocator_traits<Alloc>::is_always_equal::value) {
         if (this != &other) {
             // 判断是否可以直接移动
-            if (alloc_ == other.alloc_ || 
-                std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
+            if (alloc_traits::propagate_on_container_move_assignment::value || get_alloc() == other.get_alloc()) {
                 // 可以直接移动
-                Rep::destroy(alloc_, rep_);
-                
-                if (std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value) {
-                    alloc_ = std::move(other.alloc_);
+                if (!other.is_local() ||
+                    (alloc_traits::propagate_on_container_move_assignment::value && get_alloc() != other.get_alloc())) {
+                    // 释放自身的堆空间，必须使用原来的分配器
+                    release_heap();
+                    data_ = local_buf_;
+                    set_length(0);
+                }
+                if (alloc_traits::propagate_on_container_move_assignment::value) {
+                    get_alloc() = std::move(other.get_alloc());
+                }
+                if (other.is_local()) {
+                    // 短字符串放得进本字符串当前的任何存储
+                    traits_type::copy(data_, other.data_, other.size_ + 1);
+                    size_ = other.size_;
+                    other.set_length(0);
+                } else {
+                    steal(other);
                 }
-                
-                rep_ = other.rep_;
-                other.rep_ = nullptr;
             } else {
                 // 需要复制
-                if (rep_->capacity < other.size()) {
-                    Rep::destroy(alloc_, rep_);
-                    rep_ = Rep::create(alloc_, other.size());
-                }
-                
-                traits_type::copy(rep_->data(), other.data(), other.size());
-                rep_->size = other.size();
-                rep_->data()[rep_->size] = CharT();
+                assign_chars(other.data_, other.size_);
             }
         }
         return *this;
     }
-    
+
     /**
      * @brief 从C风格字符串赋值
      */
     basic_string& operator=(const CharT* s) {
-        const size_type len = traits_type::length(s);
-        
-        if (rep_->capacity < len) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, len);
-        }
-        
-        traits_type::copy(rep_->data(), s, len);
-        rep_->size = len;
-        rep_->data()[len] = CharT();
-        
-        return *this;
+        return assign_chars(s, traits_type::length(s));
     }
-    
+
     /**
      * @brief 从字符赋值
      */
     basic_string& operator=(CharT c) {
-        if (rep_->capacity < 1) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, 1);
-        }
-        
-        rep_->data()[0] = c;
-        rep_->size = 1;
-        rep_->data()[1] = CharT();
-        
+        // 任何存储都至少能容纳一个字符
+        data_[0] = c;
+        set_length(1);
         return *this;
     }
-    
+
     /**
      * @brief 从初始化列表赋值
      */
     basic_string& operator=(std::initializer_list<CharT> ilist) {
         return assign(ilist.begin(), ilist.end());
     }
-    
+
     /**
      * @brief 从字符串赋值
      */
     basic_string& assign(const basic_string& str) {
         return *this = str;
     }
-    
+
     /**
      * @brief 从子字符串赋值
      */
@@ -579,416 +503,774 @@ public:
         if (pos > str.size()) {
             throw std::out_of_range("basic_string::assign: pos out of range");
         }
-        
-        size_type len = std::min(count, str.size() - pos);
-        
-        if (rep_->capacity < len) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, len);
-        }
-        
-        traits_type::copy(rep_->data(), str.data() + pos, len);
-        rep_->size = len;
-        rep_->data()[len] = CharT();
-        
-        return *this;
+
+        return assign_chars(str.data() + pos, std::min(count, str.size() - pos));
     }
-    
+
     /**
      * @brief 从C风格字符串赋值
      */
     basic_string& assign(const CharT* s, size_type count) {
-        if (rep_->capacity < count) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, count);
-        }
-        
-        traits_type::copy(rep_->data(), s, count);
-        rep_->size = count;
-        rep_->data()[count] = CharT();
-        
-        return *this;
+        return assign_chars(s, count);
     }
-    
+
     /**
      * @brief 从C风格字符串赋值
      */
     basic_string& assign(const CharT* s) {
         return *this = s;
     }
-    
+
     /**
      * @brief 填充赋值
      */
     basic_string& assign(size_type count, CharT ch) {
-        if (rep_->capacity < count) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, count);
-        }
-        
-        traits_type::fill(rep_->data(), ch, count);
-        rep_->size = count;
-        rep_->data()[count] = CharT();
-        
+        if (count > capacity()) {
+            replace_storage(count);
+        }
+
+        traits_type::fill(data_, ch, count);
+        set_length(count);
+
         return *this;
     }
-    
+
     /**
      * @brief 范围赋值
      */
     template <class InputIt, typename = typename std::enable_if<
-        std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category, 
+        std::is_convertible<typename std::iterator_traits<InputIt>::iterator_category,
                            std::input_iterator_tag>::value>::type>
     basic_string& assign(InputIt first, InputIt last) {
-        const size_type len = std::distance(first, last);
-        
-        if (rep_->capacity < len) {
-            Rep::destroy(alloc_, rep_);
-            rep_ = Rep::create(alloc_, len);
-        }
-        
-        size_type i = 0;
-        for (auto it = first; it != last; ++it, ++i) {
-            rep_->data()[i] = *it;
-        }
-        
-        rep_->size = len;
-        rep_->data()[len] = CharT();
-        
+        // 范围可能来自本字符串，先构造临时对象再交换存储
+        basic_string tmp(first, last, get_alloc());
+        if (tmp.size_ > capacity()) {
+            swap_storage(tmp);
+        } else {
+            traits_type::copy(data_, tmp.data_, tmp.size_);
+            set_length(tmp.size_);
+        }
+
         return *this;
     }
-    
+
     /**
      * @brief 从初始化列表赋值
      */
     basic_string& assign(std::initializer_list<CharT> ilist) {
         return assign(ilist.begin(), ilist.end());
     }
-    
+
     // 迭代器函数
-    
+
     /**
      * @brief 返回开始位置迭代器
      */
     iterator begin() noexcept {
-        return rep_->data();
+        return data_;
     }
-    
+
     /**
      * @brief 返回开始位置常量迭代器
      */
     const_iterator begin() const noexcept {
-        return rep_->data();
+        return data_;
     }
-    
+
     /**
      * @brief 返回结束位置迭代器
      */
     iterator end() noexcept {
-        return rep_->data() + rep_->size;
+        return data_ + size_;
     }
-    
+
     /**
      * @brief 返回结束位置常量迭代器
      */
     const_iterator end() const noexcept {
-        return rep_->data() + rep_->size;
+        return data_ + size_;
     }
-    
+
     /**
      * @brief 返回反向开始位置迭代器
      */
     reverse_iterator rbegin() noexcept {
         return reverse_iterator(end());
     }
-    
+
     /**
      * @brief 返回反向开始位置常量迭代器
      */
     const_reverse_iterator rbegin() const noexcept {
         return const_reverse_iterator(end());
     }
-    
+
     /**
      * @brief 返回反向结束位置迭代器
      */
     reverse_iterator rend() noexcept {
         return reverse_iterator(begin());
     }
-    
+
     /**
      * @brief 返回反向结束位置常量迭代器
      */
     const_reverse_iterator rend() const noexcept {
         return const_reverse_iterator(begin());
     }
-    
+
     /**
      * @brief 返回常量开始位置迭代器
      */
     const_iterator cbegin() const noexcept {
         return begin();
     }
-    
+
     /**
      * @brief 返回常量结束位置迭代器
      */
     const_iterator cend() const noexcept {
         return end();
     }
-    
+
     /**
      * @brief 返回常量反向开始位置迭代器
      */
     const_reverse_iterator crbegin() const noexcept {
         return rbegin();
     }
-    
+
     /**
      * @brief 返回常量反向结束位置迭代器
      */
     const_reverse_iterator crend() const noexcept {
         return rend();
     }
-    
+
     // 容量相关方法
-    
+
     /**
      * @brief 返回字符串大小
      */
     size_type size() const noexcept {
-        return rep_->size;
+        return size_;
     }
-    
+
     /**
      * @brief 返回字符串长度（与size相同）
      */
     size_type length() const noexcept {
-        return rep_->size;
+        return size_;
     }
-    
+
     /**
      * @brief 返回最大可能大小
      */
     size_type max_size() const noexcept {
         return std::numeric_limits<size_type>::max() / sizeof(CharT) - 1;
     }
-    
+
     /**
      * @brief 调整字符串大小
      */
     void resize(size_type n, CharT c = CharT()) {
-        if (n > rep_->capacity) {
-            // 需要重新分配空间
-            size_type new_capacity = std::max(n, rep_->capacity * 2);
-            Rep* new_rep = Rep::create(alloc_, new_capacity);
-            
-            // 复制原有数据
-            traits_type::copy(new_rep->data(), rep_->data(), rep_->size);
-            
-            // 填充新部分
-            if (n > rep_->size) {
-                traits_type::fill(new_rep->data() + rep_->size, c, n - rep_->size);
-            }
-            
-            new_rep->size = n;
-            new_rep->data()[n] = CharT();
-            
-            // 释放旧内存
-            Rep::destroy(alloc_, rep_);
-            rep_ = new_rep;
-        } else {
-            // 不需要重新分配
-            if (n > rep_->size) {
-                // 需要填充新部分
-                traits_type::fill(rep_->data() + rep_->size, c, n - rep_->size);
-            }
-            
-            rep_->size = n;
-            rep_->data()[n] = CharT();
+        if (n > capacity()) {
+            // 需要重新分配空间，容量至少翻倍
+            reallocate(std::max(n, grow_capacity()));
         }
+        if (n > size_) {
+            // 需要填充新部分
+            traits_type::fill(data_ + size_, c, n - size_);
+        }
+        set_length(n);
     }
-    
+
     /**
-     * @brief 返回当前容量
+     * @brief 调整字符串大小，新增的字符不初始化
+     *
+     * 适合随后立即被 read、memcpy 覆盖的缓冲区，省去 resize 逐个填充字符的开销
+     */
+    void resize_default_init(size_type n) {
+        if (n > capacity()) {
+            reallocate(std::max(n, grow_capacity()));
+        }
+        set_length(n);
+    }
+
+    /**
+     * @brief 把大小调整为 n，由 op 写入字符后再确定最终长度（C++23 的同名接口）
+     *
+     * 调用 op(data(), n)，原有的前 min(size(), n) 个字符保留，之后的字符未初始化；
+     * op 返回实际写入的长度 r（r <= n），字符串长度设为 r 并写入结尾的空字符。
+     * op 抛出异常时长度恢复为 min(size(), n)
+     *
+     * @throw std::length_error 如果 op 的返回值大于 n
+     */
+    template <class Operation>
+    void resize_and_overwrite(size_type n, Operation op) {
+        const size_type kept = std::min(size_, n);
+        if (n > capacity()) {
+            reallocate(std::max(n, grow_capacity()));
+        }
+        size_type r = 0;
+        try {
+            r = static_cast<size_type>(op(data_, n));
+        } catch (...) {
+            set_length(kept);
+            throw;
+        }
+        if (r > n) {
+            set_length(kept);
+            throw std::length_error("basic_string::resize_and_overwrite: result exceeds n");
+        }
+        set_length(r);
+    }
+
+    /**
+     * @brief 返回当前容量，短字符串为 local_capacity
      */
     size_type capacity() const noexcept {
-        return rep_->capacity;
+        return is_local() ? size_type(local_capacity) : capacity_;
     }
-    
+
     /**
      * @brief 保留预留空间
      */
     void reserve(size_type n = 0) {
-        if (n > rep_->capacity) {
-            // 需要重新分配
-            Rep* new_rep = Rep::create(alloc_, n);
-            
-            // 复制原有数据
-            traits_type::copy(new_rep->data(), rep_->data(), rep_->size);
-            new_rep->size = rep_->size;
-            new_rep->data()[new_rep->size] = CharT();
-            
-            // 释放旧内存
-            Rep::destroy(alloc_, rep_);
-            rep_ = new_rep;
+        if (n > capacity()) {
+            reallocate(n);
         }
     }
-    
+
     /**
      * @brief 减小容量以适应当前大小
+     *
+     * 字符数不超过 local_capacity 时搬回内部缓冲区并释放堆空间
      */
     void shrink_to_fit() {
-        if (rep_->size < rep_->capacity) {
-            // 创建合适大小的新内存
-            Rep* new_rep = Rep::create(alloc_, rep_->size);
-            
-            // 复制数据
-            traits_type::copy(new_rep->data(), rep_->data(), rep_->size);
-            new_rep->size = rep_->size;
-            new_rep->data()[new_rep->size] = CharT();
-            
-            // 释放旧内存
-            Rep::destroy(alloc_, rep_);
-            rep_ = new_rep;
+        if (is_local() || size_ == capacity_) {
+            return;
+        }
+        if (size_ <= local_capacity) {
+            pointer old = data_;
+            const size_type old_capacity = capacity_;
+            traits_type::copy(local_buf_, old, size_ + 1);
+            data_ = local_buf_;
+            alloc_traits::deallocate(get_alloc(), old, old_capacity + 1);
+        } else {
+            reallocate(size_);
         }
     }
-    
+
     /**
      * @brief 检查字符串是否为空
      */
     bool empty() const noexcept {
-        return rep_->size == 0;
+        return size_ == 0;
     }
-    
+
     /**
-     * @brief 清空字符串
+     * @brief 清空字符串，保留已分配的空间
      */
     void clear() noexcept {
-        rep_->size = 0;
-        rep_->data()[0] = CharT();
+        set_length(0);
     }
-    
+
     // 元素访问
-    
+
     /**
      * @brief 访问指定位置的字符（无边界检查）
-     * 
+     *
      * @param pos 字符位置
      * @return reference 字符引用
      */
     reference operator[](size_type pos) {
-        return rep_->data()[pos];
+        return data_[pos];
     }
-    
+
     /**
      * @brief 访问指定位置的字符（无边界检查，常量版本）
-     * 
+     *
      * @param pos 字符位置
      * @return const_reference 字符常量引用
      */
     const_reference operator[](size_type pos) const {
-        return rep_->data()[pos];
+        return data_[pos];
     }
-    
+
     /**
      * @brief 访问指定位置的字符（有边界检查）
-     * 
+     *
      * @param pos 字符位置
      * @return reference 字符引用
      * @throw std::out_of_range 如果pos >= size()
      */
     reference at(size_type pos) {
-        if (pos >= rep_->size) {
+        if (pos >= size_) {
             throw std::out_of_range("basic_string::at: pos out of range");
         }
-        return rep_->data()[pos];
+        return data_[pos];
     }
-    
+
     /**
      * @brief 访问指定位置的字符（有边界检查，常量版本）
-     * 
+     *
      * @param pos 字符位置
      * @return const_reference 字符常量引用
      * @throw std::out_of_range 如果pos >= size()
      */
     const_reference at(size_type pos) const {
-        if (pos >= rep_->size) {
+        if (pos >= size_) {
             throw std::out_of_range("basic_string::at: pos out of range");
         }
-        return rep_->data()[pos];
+        return data_[pos];
     }
-    
+
     /**
      * @brief 访问第一个字符
-     * 
+     *
      * @return reference 第一个字符的引用
      */
     reference front() {
-        return rep_->data()[0];
+        return data_[0];
     }
-    
+
     /**
      * @brief 访问第一个字符（常量版本）
-     * 
+     *
      * @return const_reference 第一个字符的常量引用
      */
     const_reference front() const {
-        return rep_->data()[0];
+        return data_[0];
     }
-    
+
     /**
      * @brief 访问最后一个字符
-     * 
+     *
      * @return reference 最后一个字符的引用
      */
     reference back() {
-        return rep_->data()[rep_->size - 1];
+        return data_[size_ - 1];
     }
-    
+
     /**
      * @brief 访问最后一个字符（常量版本）
-     * 
+     *
      * @return const_reference 最后一个字符的常量引用
      */
     const_reference back() const {
-        return rep_->data()[rep_->size - 1];
+        return data_[size_ - 1];
     }
-    
+
     /**
      * @brief 获取C风格字符数组
-     * 
+     *
      * @return const_pointer C风格字符数组指针
      */
     const_pointer c_str() const noexcept {
-        return rep_->data();
+        return data_;
     }
-    
+
     /**
      * @brief 获取字符数组
-     * 
+     *
      * @return const_pointer 字符数组指针
      */
     const_pointer data() const noexcept {
-        return rep_->data();
+        return data_;
     }
-    
+
     /**
      * @brief 获取字符数组（C++17，非常量版本）
-     * 
+     *
      * @return pointer 字符数组指针
      */
     pointer data() noexcept {
-        return rep_->data();
+        return data_;
+    }
+
+    /**
+     * @brief 获取分配器
+     *
+     * @return allocator_type 分配器
+     */
+    allocator_type get_allocator() const noexcept {
+        return get_alloc();
+    }
+
+    /**
+     * @brief 与另一个字符串交换内容
+     *
+     * 分配器只在 propagate_on_container_swap 为真时交换，
+     * 否则两个字符串的分配器必须相等
+     */
+    void swap(basic_string& other) noexcept {
+        if (this == &other) {
+            return;
+        }
+        if (alloc_traits::propagate_on_container_swap::value) {
+            std::swap(get_alloc(), other.get_alloc());
+        }
+        swap_storage(other);
+    }
+
+    /**
+     * @brief 按字典序与另一个字符串比较
+     *
+     * @return int 小于、等于、大于 str 时分别返回负数、0、正数
+     */
+    int compare(const basic_string& str) const noexcept {
+        return compare_chars(data_, size_, str.data_, str.size_);
+    }
+
+    /**
+     * @brief 按字典序与 C 风格字符串比较，不构造临时字符串
+     */
+    int compare(const CharT* s) const {
+        return compare_chars(data_, size_, s, Traits::length(s));
+    }
+
+    /**
+     * @brief 比较两段字符，先比较公共前缀，前缀相同时较短的字符串较小
+     */
+    static int compare_chars(const CharT* s1, size_type n1, const CharT* s2, size_type n2) noexcept {
+        const int r = Traits::compare(s1, s2, std::min(n1, n2));
+        if (r != 0) {
+            return r;
+        }
+        return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+    }
+
+private:
+    /**
+     * @brief 是否为存放在内部缓冲区中的短字符串
+     */
+    bool is_local() const noexcept {
+        return data_ == local_buf_;
+    }
+
+    /**
+     * @brief 设置长度并写入结尾的空字符
+     */
+    void set_length(size_type n) noexcept {
+        size_ = n;
+        data_[n] = CharT();
+    }
+
+    /**
+     * @brief 分配能容纳 n 个字符及结尾空字符的堆空间
+     * @throw std::length_error 如果 n 超过 max_size()
+     */
+    pointer allocate_chars(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("basic_string: length exceeds max_size");
+        }
+        return alloc_traits::allocate(get_alloc(), n + 1);
+    }
+
+    /**
+     * @brief 释放堆空间（如果有），不修改 data_
+     */
+    void release_heap() noexcept {
+        if (!is_local()) {
+            alloc_traits::deallocate(get_alloc(), data_, capacity_ + 1);
+        }
+    }
+
+    /**
+     * @brief 扩容时的建议容量：当前容量的两倍
+     */
+    size_type grow_capacity() const noexcept {
+        const size_type cap = capacity();
+        return cap < max_size() / 2 ? cap * 2 : max_size();
+    }
+
+    /**
+     * @brief 用 s 的前 n 个字符初始化，仅供构造函数使用（此时为空的短字符串）
+     */
+    void init(const CharT* s, size_type n) {
+        if (n > local_capacity) {
+            data_ = allocate_chars(n);
+            capacity_ = n;
+        }
+        traits_type::copy(data_, s, n);
+        set_length(n);
+    }
+
+    /**
+     * @brief 把容量调整为 new_capacity（不小于 size()），保留原有字符
+     */
+    void reallocate(size_type new_capacity) {
+        pointer p = allocate_chars(new_capacity);
+        traits_type::copy(p, data_, size_ + 1);
+        release_heap();
+        data_ = p;
+        capacity_ = new_capacity;
+    }
+
+    /**
+     * @brief 换用容量至少为 n 的新堆空间，不保留原有字符
+     */
+    void replace_storage(size_type n) {
+        const size_type new_capacity = std::max(n, grow_capacity());
+        pointer p = allocate_chars(new_capacity);
+        release_heap();
+        data_ = p;
+        capacity_ = new_capacity;
+        set_length(0);
+    }
+
+    /**
+     * @brief 以 s 的前 n 个字符替换内容，s 可以指向本字符串内部
+     */
+    basic_string& assign_chars(const CharT* s, size_type n) {
+        if (n > capacity()) {
+            // 先拷贝到新空间再释放旧空间
+            const size_type new_capacity = std::max(n, grow_capacity());
+            pointer p = allocate_chars(new_capacity);
+            traits_type::copy(p, s, n);
+            release_heap();
+            data_ = p;
+            capacity_ = new_capacity;
+        } else {
+            traits_type::move(data_, s, n);
+        }
+        set_length(n);
+        return *this;
+    }
+
+    /**
+     * @brief 接管 other 的内容，本字符串必须是不持有堆空间的短字符串。之后 other 为空字符串
+     */
+    void steal(basic_string& other) noexcept {
+        if (other.is_local()) {
+            traits_type::copy(local_buf_, other.local_buf_, other.size_ + 1);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.local_buf_;
+        }
+        size_ = other.size_;
+        other.set_length(0);
+    }
+
+    /**
+     * @brief 交换两个字符串的存储，不交换分配器
+     */
+    void swap_storage(basic_string& other) noexcept {
+        if (is_local() && other.is_local()) {
+            CharT tmp[local_capacity + 1];
+            traits_type::copy(tmp, other.local_buf_, other.size_ + 1);
+            traits_type::copy(other.local_buf_, local_buf_, size_ + 1);
+            traits_type::copy(local_buf_, tmp, other.size_ + 1);
+        } else if (is_local()) {
+            pointer heap = other.data_;
+            const size_type cap = other.capacity_;
+            traits_type::copy(other.local_buf_, local_buf_, size_ + 1);
+            other.data_ = other.local_buf_;
+            data_ = heap;
+            capacity_ = cap;
+        } else if (other.is_local()) {
+            pointer heap = data_;
+            const size_type cap = capacity_;
+            traits_type::copy(local_buf_, other.local_buf_, other.size_ + 1);
+            data_ = local_buf_;
+            other.data_ = heap;
+            other.capacity_ = cap;
+        } else {
+            std::swap(data_, other.data_);
+            std::swap(capacity_, other.capacity_);
+        }
+        std::swap(size_, other.size_);
     }
 };
 
+template <class CharT, class Traits, class Alloc>
+constexpr typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::npos;
+
+template <class CharT, class Traits, class Alloc>
+constexpr typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::local_capacity;
+
+/**
+ * @brief 交换两个字符串
+ */
+template <class CharT, class Traits, class Alloc>
+void swap(basic_string<CharT, Traits, Alloc>& lhs, basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// ------------------------------------------------------------------------------------------
+// 比较运算符，与 C 风格字符串比较时不构造临时字符串
+// ------------------------------------------------------------------------------------------
+
+template <class CharT, class Traits, class Alloc>
+bool operator==(const basic_string<CharT, Traits, Alloc>& lhs,
+                const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return lhs.size() == rhs.size() && Traits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator==(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator==(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator!=(const basic_string<CharT, Traits, Alloc>& lhs,
+                const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator!=(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return !(lhs == rhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator!=(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<(const basic_string<CharT, Traits, Alloc>& lhs,
+               const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return rhs.compare(lhs) > 0;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>(const basic_string<CharT, Traits, Alloc>& lhs,
+               const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return rhs < lhs;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return rhs < lhs;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<=(const basic_string<CharT, Traits, Alloc>& lhs,
+                const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return !(rhs < lhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<=(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return !(rhs < lhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator<=(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>=(const basic_string<CharT, Traits, Alloc>& lhs,
+                const basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    return !(lhs < rhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>=(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return !(lhs < rhs);
+}
+
+template <class CharT, class Traits, class Alloc>
+bool operator>=(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// ------------------------------------------------------------------------------------------
+// 哈希函数
+// ------------------------------------------------------------------------------------------
+
+/**
+ * @brief 透明的字符串哈希函数
+ *
+ * 对字符序列做 FNV-1a 哈希，basic_string（任意分配器）与内容相同的 C 风格字符串得到相同的哈希值。
+ * 声明了 is_transparent，与 transparent_equal_to 一起用于无序容器时，可以直接用 const char* 查找
+ */
+template <class CharT, class Traits = char_traits<CharT>>
+struct basic_string_hash {
+    typedef void is_transparent;
+
+    template <class Alloc>
+    size_t operator()(const basic_string<CharT, Traits, Alloc>& str) const noexcept {
+        return hash_chars(str.data(), str.size());
+    }
+
+    size_t operator()(const CharT* s) const noexcept {
+        return hash_chars(s, Traits::length(s));
+    }
+
+    static size_t hash_chars(const CharT* s, size_t n) noexcept {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+        const size_t bytes = n * sizeof(CharT);
+        uint64_t h = 14695981039346656037ULL;
+        for (size_t i = 0; i < bytes; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ULL;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+using string_hash = basic_string_hash<char>;
+
 // 字符串类型别名
 using string = basic_string<char>;
 using wstring = basic_string<wchar_t>;
 using u16string = basic_string<char16_t>;
 using u32string = basic_string<char32_t>;
 
+namespace pmr {
+
+/**
+ * @brief 使用 polymorphic_allocator 的字符串
+ */
+template <class CharT, class Traits = char_traits<CharT>>
+using basic_string = mystl::basic_string<CharT, Traits, polymorphic_allocator<CharT>>;
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+
+} // namespace pmr
+
 } // namespace mystl
 
+namespace std {
+
+/**
+ * @brief 让 mystl::basic_string 可以直接作为 std::hash 的默认键类型
+ */
+template <class CharT, class Traits, class Alloc>
+struct hash<mystl::basic_string<CharT, Traits, Alloc>> {
+    size_t operator()(const mystl::basic_string<CharT, Traits, Alloc>& str) const noexcept {
+        return mystl::basic_string_hash<CharT, Traits>::hash_chars(str.data(), str.size());
+    }
+};
+
+} // namespace std
+
 #endif // MYSTL_STRING_H_ 
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include "my_string.h"
 
 /**
@@ -226,6 +229,208 @@ void test_capacity() {
     test_equal("clear方法 - 空字符串", s6.empty(), true);
 }
 
+/**
+ * @brief 测试交换和分配器
+ */
+void test_swap() {
+    std::cout << "\n=== 测试交换 ===" << std::endl;
+    
+    mystl::string s1("hello");
+    mystl::string s2("a much longer string than hello");
+    s1.swap(s2);
+    test_equal("swap成员函数 - s1", std::string(s1.c_str()), std::string("a much longer string than hello"));
+    test_equal("swap成员函数 - s2", std::string(s2.c_str()), std::string("hello"));
+    
+    swap(s1, s2);
+    test_equal("swap非成员函数", std::string(s1.c_str()), std::string("hello"));
+    test_equal("get_allocator", s1.get_allocator() == std::allocator<char>(), true);
+}
+
+/**
+ * @brief 记录分配次数的分配器
+ */
+template <class T>
+struct counting_allocator : std::allocator<T> {
+    static int allocations;
+
+    template <class U> struct rebind { typedef counting_allocator<U> other; };
+
+    counting_allocator() = default;
+    template <class U> counting_allocator(const counting_allocator<U>&) {}
+
+    T* allocate(size_t n) {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+template <class T>
+int counting_allocator<T>::allocations = 0;
+
+/**
+ * @brief 判断字符串内容是否存放在对象内部
+ */
+template <class String>
+bool is_inline(const String& s) {
+    const char* p = reinterpret_cast<const char*>(s.data());
+    const char* obj = reinterpret_cast<const char*>(&s);
+    return p >= obj && p < obj + sizeof(String);
+}
+
+/**
+ * @brief 测试短字符串优化
+ */
+void test_small_string() {
+    std::cout << "\n=== 测试短字符串优化 ===" << std::endl;
+
+    typedef mystl::basic_string<char, mystl::char_traits<char>, counting_allocator<char>> counted_string;
+    counting_allocator<char>::allocations = 0;
+
+    // 空字符串和短字符串不分配内存
+    counted_string empty;
+    counted_string tag("log.tag.short");
+    counted_string full(mystl::string::local_capacity, 'x');
+    counted_string copy(tag);
+    counted_string moved(std::move(copy));
+    moved = full;
+    test_equal("短字符串不分配内存", counting_allocator<char>::allocations, 0);
+    test_equal("短字符串存放在对象内部", is_inline(empty) && is_inline(tag) && is_inline(full), true);
+    test_equal("默认容量", empty.capacity(), size_t(mystl::string::local_capacity));
+    test_equal("空分配器不占空间", sizeof(mystl::string), sizeof(char*) + sizeof(size_t) + 16);
+    test_equal("移动后原字符串为空", copy.empty() && copy.c_str()[0] == '\0', true);
+    test_equal("移动短字符串内容", std::string(moved.c_str()), std::string(full.c_str()));
+
+    // 超过内部缓冲区后透明地切换到堆
+    counted_string s("0123456789");
+    const char* before = s.data();
+    s.resize(12, 'a');
+    test_equal("容量足够时数据指针不变", s.data() == before, true);
+    s.resize(40, 'b');
+    test_equal("长字符串分配一次内存", counting_allocator<char>::allocations, 1);
+    test_equal("长字符串存放在堆上", is_inline(s), false);
+    test_equal("切换到堆后内容不变", std::string(s.c_str()),
+               std::string("0123456789aa") + std::string(28, 'b'));
+
+    // 长字符串移动时转移堆空间
+    const char* heap = s.data();
+    counted_string stolen(std::move(s));
+    test_equal("移动长字符串转移堆空间", stolen.data() == heap, true);
+    test_equal("移动后原字符串回到内部缓冲区", is_inline(s) && s.empty(), true);
+
+    // shrink_to_fit 把短内容搬回内部缓冲区
+    stolen.resize(5);
+    stolen.shrink_to_fit();
+    test_equal("shrink_to_fit 搬回内部缓冲区", is_inline(stolen), true);
+    test_equal("shrink_to_fit 后内容", std::string(stolen.c_str()), std::string("01234"));
+
+    // 短字符串与长字符串交换
+    counted_string a("short");
+    counted_string b(32, 'L');
+    a.swap(b);
+    test_equal("交换后短字符串", std::string(b.c_str()), std::string("short"));
+    test_equal("交换后长字符串", std::string(a.c_str()), std::string(32, 'L'));
+    test_equal("交换后存储位置", is_inline(b) && !is_inline(a), true);
+
+    // 用自身的子串赋值
+    counted_string self("abcdefghijklmnopqrstuvwxyz");
+    self.assign(self, 20, 3);
+    test_equal("用自身子串赋值", std::string(self.c_str()), std::string("uvw"));
+    self.assign(self.data() + 1, 2);
+    test_equal("用自身字符数组赋值", std::string(self.c_str()), std::string("vw"));
+
+    // 宽字符的内部缓冲区按字符大小缩小
+    mystl::u32string wide(U"abc");
+    test_equal("u32string 内部缓冲区", is_inline(wide) && wide.size() == 3, true);
+}
+
+/**
+ * @brief 测试比较运算与哈希
+ */
+void test_compare_and_hash() {
+    std::cout << "\n===== 测试比较与哈希 =====" << std::endl;
+
+    mystl::string a("apple");
+    mystl::string b("apricot");
+    mystl::string ab("ap");
+    test_equal("compare 小于", a.compare(b) < 0, true);
+    test_equal("compare 前缀较小", ab.compare(a) < 0, true);
+    test_equal("compare 相等", a.compare("apple"), 0);
+    test_equal("compare C 字符串较短", a.compare("app") > 0, true);
+    test_equal("operator== / !=", a == mystl::string("apple") && a != b, true);
+    test_equal("与 C 字符串比较", a == "apple" && "apple" == a && a != "apples", true);
+    test_equal("operator< / >", a < b && b > a && ab < a && "b" > a, true);
+    test_equal("operator<= / >=", a <= a && a >= "apple" && !(b <= a) && "a" <= a, true);
+
+    // 长度不同、公共前缀相同
+    mystl::string with_nul("ab\0", 3);
+    test_equal("含空字符的字符串较长", with_nul > mystl::string("ab") && with_nul != "ab", true);
+
+    // 内容相同的字符串与 C 字符串哈希值相同
+    mystl::string_hash h;
+    mystl::string long_str(40, 'x');
+    test_equal("string_hash 短字符串", h(a) == h("apple"), true);
+    test_equal("string_hash 长字符串", h(long_str) == h(long_str.c_str()), true);
+    test_equal("std::hash 与 string_hash 一致", std::hash<mystl::string>()(a) == h(a), true);
+    test_equal("不同内容哈希不同", h(a) != h(b), true);
+}
+
+/**
+ * @brief 测试不初始化新增字符的 resize_default_init 与 resize_and_overwrite
+ */
+void test_resize_and_overwrite() {
+    std::cout << "\n测试 resize_default_init / resize_and_overwrite:" << std::endl;
+
+    // 扩大时保留原有字符，新增部分由调用者写入
+    mystl::string s("head");
+    s.resize_default_init(40);
+    test_equal("resize_default_init 大小", s.size(), size_t(40));
+    test_equal("resize_default_init 保留原有字符", std::string(s.data(), 4), std::string("head"));
+    test_equal("resize_default_init 结尾空字符", s.c_str()[40], '\0');
+    std::fill(s.begin() + 4, s.end(), '.');
+    s.resize_default_init(6);
+    test_equal("resize_default_init 缩小", std::string(s.c_str()), std::string("head.."));
+
+    // 模拟从文件读入：只写入 op 实际读到的字符数
+    const std::string payload = "0123456789abcdef0123456789abcdef";
+    mystl::string buf;
+    buf.resize_and_overwrite(64, [&payload](char* p, size_t n) {
+        const size_t len = std::min(n, payload.size());
+        std::copy(payload.begin(), payload.begin() + len, p);
+        return len;
+    });
+    test_equal("resize_and_overwrite 内容", std::string(buf.c_str()), payload);
+    test_equal("resize_and_overwrite 容量", buf.capacity() >= 64, true);
+
+    // 追加：n 为原长度加上新增的长度
+    buf.resize_and_overwrite(buf.size() + 3, [](char* p, size_t n) {
+        std::copy(std::begin("XYZ"), std::begin("XYZ") + 3, p + n - 3);
+        return n;
+    });
+    test_equal("resize_and_overwrite 追加", std::string(buf.c_str()), payload + "XYZ");
+
+    // 缩小，并写入短字符串
+    mystl::string small("abcdef");
+    small.resize_and_overwrite(3, [](char* p, size_t) { p[0] = 'A'; return size_t(2); });
+    test_equal("resize_and_overwrite 缩小", std::string(small.c_str()), std::string("Ab"));
+
+    // op 抛出异常或返回值超过 n 时长度恢复为 min(size(), n)
+    mystl::string guarded("keep me");
+    bool thrown = false;
+    try {
+        guarded.resize_and_overwrite(100, [](char*, size_t) -> size_t { throw std::runtime_error("io"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    test_equal("op 抛出异常", thrown && std::string(guarded.c_str()) == "keep me", true);
+    thrown = false;
+    try {
+        guarded.resize_and_overwrite(4, [](char*, size_t n) { return n + 1; });
+    } catch (const std::length_error&) {
+        thrown = true;
+    }
+    test_equal("op 返回值超过 n", thrown && std::string(guarded.c_str()) == "keep", true);
+}
+
 /**
  * @brief 主函数
  */
@@ -237,6 +442,10 @@ int main() {
     test_element_access();
     test_iterators();
     test_capacity();
+    test_swap();
+    test_small_string();
+    test_compare_and_hash();
+    test_resize_and_overwrite();
     
     std::cout << "\n所有测试完成！" << std::endl;
     
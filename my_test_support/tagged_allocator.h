@@ -0,0 +1,69 @@
+#ifndef MY_TEST_SUPPORT_TAGGED_ALLOCATOR_H
+#define MY_TEST_SUPPORT_TAGGED_ALLOCATOR_H
+
+// 这个头文件包含各模块测试共用的有状态分配器
+// tagged_allocator : 带编号的分配器，按编号统计尚未归还的分配次数
+// all_released     : 检查所有编号的分配器都已归还全部内存
+
+// 注释：
+//
+// 1. 只供 my_*/ 下的测试程序使用，容器头文件不依赖它
+// 2. live 是按 Propagate 区分的静态计数，同一测试程序中的所有容器共用
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief 带编号的有状态分配器，编号相同的分配器相等
+ *
+ * live[id] 记录每个编号尚未归还的分配次数，用来检查内存是否由分配它的分配器归还
+ * Propagate 决定拷贝赋值、移动赋值和交换时是否传播分配器
+ */
+template <class T, bool Propagate>
+struct tagged_allocator {
+    typedef T value_type;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+
+    template <class U>
+    struct rebind { typedef tagged_allocator<U, Propagate> other; };
+
+    static int live[8];
+    int id;
+
+    explicit tagged_allocator(int i = 0) : id(i) {}
+    template <class U>
+    tagged_allocator(const tagged_allocator<U, Propagate>& other) : id(other.id) {}
+
+    T* allocate(std::size_t n) {
+        ++tagged_allocator<char, Propagate>::live[id];
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) {
+        --tagged_allocator<char, Propagate>::live[id];
+        ::operator delete(p);
+    }
+
+    template <class U>
+    bool operator==(const tagged_allocator<U, Propagate>& rhs) const { return id == rhs.id; }
+    template <class U>
+    bool operator!=(const tagged_allocator<U, Propagate>& rhs) const { return id != rhs.id; }
+};
+
+template <class T, bool Propagate>
+int tagged_allocator<T, Propagate>::live[8];
+
+/**
+ * @brief 检查所有编号的分配器都已归还全部内存
+ */
+template <bool Propagate>
+bool all_released() {
+    for (int n : tagged_allocator<char, Propagate>::live) {
+        if (n != 0) return false;
+    }
+    return true;
+}
+
+#endif // MY_TEST_SUPPORT_TAGGED_ALLOCATOR_H
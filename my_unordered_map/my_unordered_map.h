@@ -9,49 +9,56 @@
 //   * emplace
 //   * emplace_hint
 //   * insert
+//   * try_emplace
+//   * insert_or_assign
 
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
+#include <tuple>
 #include <utility>
 #include <stdexcept>
 #include "../my_hashtable/my_hashtable.h"
+#include "../my_memory_resource/my_memory_resource.h"
+#include "../my_functional/my_functional.h"
 
 namespace mystl
 {
 
 // 前置声明
-template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, class BucketPolicy = ht_prime_policy>
 class unordered_map;
 
-template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>, class BucketPolicy = ht_prime_policy>
 class unordered_multimap;
 
 // 声明比较操作符
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs);
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs);
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs);
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs);
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs);
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs);
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs);
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs);
 
 // 声明 swap 函数
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-          unordered_map<Key, T, Hash, KeyEqual>& rhs) noexcept;
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept;
 
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-          unordered_multimap<Key, T, Hash, KeyEqual>& rhs) noexcept;
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept;
 
 /**
  * @class unordered_map
@@ -61,13 +68,15 @@ void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型，默认使用 std::hash
  * @tparam KeyEqual 键比较函数类型，默认使用 std::equal_to
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam BucketPolicy 桶策略，默认使用素数个桶（ht_prime_policy）
  */
-template <class Key, class T, class Hash, class KeyEqual>
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
 class unordered_map
 {
 private:
     // 使用 hashtable 作为底层实现
-    typedef hashtable<std::pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<std::pair<const Key, T>, Hash, KeyEqual, BucketPolicy, Alloc> base_type;
     base_type ht_;
 
 public:
@@ -90,6 +99,8 @@ public:
     typedef typename base_type::const_iterator       const_iterator;
     typedef typename base_type::local_iterator       local_iterator;
     typedef typename base_type::const_local_iterator const_local_iterator;
+    typedef typename base_type::node_handle_type     node_type;
+    typedef typename base_type::insert_return_type   insert_return_type;
 
     /**
      * @brief 获取分配器
@@ -108,17 +119,29 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * 
+     * @param alloc 分配器
+     */
+    explicit unordered_map(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc)
+    {
+    }
+
     /**
      * @brief 构造函数，指定桶数和哈希函数
      * 
      * @param bucket_count 指定的桶数
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     explicit unordered_map(size_type bucket_count,
                            const Hash& hash = Hash(),
-                           const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal)
+                           const KeyEqual& equal = KeyEqual(),
+                           const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
     {
     }
 
@@ -131,13 +154,15 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     template <class InputIterator>
     unordered_map(InputIterator first, InputIterator last,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal)
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal, alloc)
     {
         for (; first != last; ++first)
             ht_.insert_unique_noresize(*first);
@@ -150,12 +175,14 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     unordered_map(std::initializer_list<value_type> ilist,
                   const size_type bucket_count = 100,
                   const Hash& hash = Hash(),
-                  const KeyEqual& equal = KeyEqual())
-        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                  const KeyEqual& equal = KeyEqual(),
+                  const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
     {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_unique_noresize(*first);
@@ -171,6 +198,17 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * 
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    unordered_map(const unordered_map& rhs, const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc)
+    {
+    }
+
     /**
      * @brief 移动构造函数
      * 
@@ -181,6 +219,17 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * 
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    unordered_map(unordered_map&& rhs, const allocator_type& alloc)
+        : ht_(std::move(rhs.ht_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * 
@@ -199,7 +248,7 @@ public:
      * @param rhs 源对象
      * @return unordered_map& 返回自身引用
      */
-    unordered_map& operator=(unordered_map&& rhs) noexcept
+    unordered_map& operator=(unordered_map&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         ht_ = std::move(rhs.ht_);
         return *this;
@@ -367,6 +416,192 @@ public:
     void insert(InputIterator first, InputIterator last)
     { ht_.insert_unique(first, last); }
 
+    // try_emplace / insert_or_assign
+
+    /**
+     * @brief 键值不存在时才用 args 原位构造实值
+     * 
+     * 先按键查找，键值已存在时既不分配节点也不移动 key 和 args
+     * 
+     * @tparam Args 参数类型包
+     * @param key 键
+     * @param args 实值的构造参数
+     * @return std::pair<iterator, bool> 插入结果，包含指向元素的迭代器和是否成功插入的标志
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key(key, std::piecewise_construct,
+                                      std::forward_as_tuple(key),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键值不存在时才用 args 原位构造实值(移动键版本)
+     * 
+     * @tparam Args 参数类型包
+     * @param key 键，只有插入成功时才会被移动
+     * @param args 实值的构造参数
+     * @return std::pair<iterator, bool> 插入结果，包含指向元素的迭代器和是否成功插入的标志
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key(key, std::piecewise_construct,
+                                      std::forward_as_tuple(std::move(key)),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 使用提示位置的 try_emplace
+     * 
+     * 提示位置的键等于 key 时直接返回提示位置，不计算哈希值
+     * @param hint 提示位置
+     * @param key 键
+     * @param args 实值的构造参数
+     * @return iterator 指向键为 key 的元素的迭代器
+     */
+    template <class... Args>
+    iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                               std::forward_as_tuple(key),
+                                               std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                               std::forward_as_tuple(std::move(key)),
+                                               std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 异构 try_emplace：Hash 与 KeyEqual 都声明了 is_transparent 时用 key 直接查找，
+     *        只有插入时才用 key 构造 key_type
+     * 
+     * 能转换为迭代器的参数仍调用带提示的版本
+     */
+    template <class K, class... Args, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value &&
+                                              !std::is_convertible<K&&, iterator>::value &&
+                                              !std::is_convertible<K&&, const_iterator>::value>::type>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key(key, std::piecewise_construct,
+                                      std::forward_as_tuple(std::forward<K>(key)),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class K, class... Args, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    iterator try_emplace(const_iterator hint, K&& key, Args&&... args)
+    {
+        return ht_.emplace_unique_key_use_hint(hint, key, std::piecewise_construct,
+                                               std::forward_as_tuple(std::forward<K>(key)),
+                                               std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键值不存在时插入，存在时把 obj 赋值给已有的实值
+     * 
+     * @tparam M 实值类型
+     * @param key 键
+     * @param obj 实值
+     * @return std::pair<iterator, bool> 插入结果，second 为 false 表示进行了赋值
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+    {
+        auto result = try_emplace(key, std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj)
+    {
+        auto result = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    /**
+     * @brief 异构 insert_or_assign，条件与异构 try_emplace 相同
+     */
+    template <class K, class M, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value &&
+                                              !std::is_convertible<K&&, iterator>::value &&
+                                              !std::is_convertible<K&&, const_iterator>::value>::type>
+    std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj)
+    {
+        auto result = try_emplace(std::forward<K>(key), std::forward<M>(obj));
+        if (!result.second)
+            result.first->second = std::forward<M>(obj);
+        return result;
+    }
+
+    /**
+     * @brief 使用提示位置的 insert_or_assign
+     * 
+     * 与 try_emplace 使用相同的提示路径，元素个数没有增加说明键已存在，改为赋值
+     * @param hint 提示位置
+     * @param key 键
+     * @param obj 实值
+     * @return iterator 指向键为 key 的元素的迭代器
+     */
+    template <class M>
+    iterator insert_or_assign(const_iterator hint, const key_type& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, key, std::forward<M>(obj));
+        if (size() == n)
+            it->second = std::forward<M>(obj);
+        return it;
+    }
+
+    template <class M>
+    iterator insert_or_assign(const_iterator hint, key_type&& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, std::move(key), std::forward<M>(obj));
+        if (size() == n)
+            it->second = std::forward<M>(obj);
+        return it;
+    }
+
+    template <class K, class M, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    iterator insert_or_assign(const_iterator hint, K&& key, M&& obj)
+    {
+        const size_type n = size();
+        iterator it = try_emplace(hint, std::forward<K>(key), std::forward<M>(obj));
+        if (size() == n)
+            it->second = std::forward<M>(obj);
+        return it;
+    }
+
+    /**
+     * @brief 使用预先计算的哈希值，键值不存在时才用 args 原位构造元素
+     * 
+     * 调用者已经算过哈希值时（如 concurrent_unordered_map 按哈希值选择分片）不再重复计算；
+     * 与 try_emplace 相同，键值已存在时既不分配节点也不移动 args
+     * @param hash key 的哈希值，必须等于 hash_function()(key)
+     * @param key 元素的键，必须与 args 构造出的元素的键相等
+     * @param args 元素（value_type）的构造参数
+     * @return std::pair<iterator, bool> 插入结果，包含指向元素的迭代器和是否成功插入的标志
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace_hashed(size_type hash, const key_type& key, Args&&... args)
+    { return ht_.emplace_unique_hashed(hash, key, std::forward<Args>(args)...); }
+
     // erase / clear
 
     /**
@@ -395,12 +630,62 @@ public:
     size_type erase(const key_type& key)
     { return ht_.erase_unique(key); }
 
+    /**
+     * @brief 使用预先计算的哈希值删除指定键的元素
+     * 
+     * @param key 要删除的键
+     * @param hash key 的哈希值，必须等于 hash_function()(key)
+     * @return size_type 删除的元素数量
+     */
+    size_type erase(const key_type& key, size_type hash)
+    { return ht_.erase_unique(key, hash); }
+
     /**
      * @brief 清空容器
      */
     void clear()
     { ht_.clear(); }
 
+    // extract / 插入节点句柄
+
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * 
+     * @param it 指向要摘下元素的迭代器
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const_iterator it)
+    { return ht_.extract(it); }
+
+    /**
+     * @brief 摘下一个键为 key 的元素，不存在时返回空的节点句柄
+     * 
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    { return ht_.extract(key); }
+
+    /**
+     * @brief 插入节点句柄中的元素，键已存在时节点留在返回值的 node 中
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素；可以先修改 nh.key() 再放回，完成改键
+     * @param nh 节点句柄，插入成功后变为空
+     * @return insert_return_type 插入位置、是否插入以及未插入的节点
+     */
+    insert_return_type insert(node_type&& nh)
+    { return ht_.insert_unique(std::move(nh)); }
+
+    /**
+     * @brief 使用提示位置插入节点句柄中的元素，键已存在时节点留在 nh 中
+     * 
+     * @param hint 提示位置
+     * @param nh 节点句柄
+     * @return iterator 指向键相同的元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(const_iterator hint, node_type&& nh)
+    { return ht_.insert_unique_use_hint(hint, std::move(nh)); }
+
     /**
      * @brief 交换两个容器的内容
      * 
@@ -448,12 +733,7 @@ public:
      * @return mapped_type& 对应值的引用
      */
     mapped_type& operator[](const key_type& key)
-    {
-        iterator it = ht_.find(key);
-        if (it == end())
-            it = ht_.emplace_unique(key, T{}).first;
-        return it->second;
-    }
+    { return try_emplace(key).first->second; }
 
     /**
      * @brief 访问或插入元素(移动版本)
@@ -462,12 +742,7 @@ public:
      * @return mapped_type& 对应值的引用
      */
     mapped_type& operator[](key_type&& key)
-    {
-        iterator it = ht_.find(key);
-        if (it == end())
-            it = ht_.emplace_unique(std::move(key), T{}).first;
-        return it->second;
-    }
+    { return try_emplace(std::move(key)).first->second; }
 
     /**
      * @brief 统计指定键的元素数量
@@ -496,6 +771,44 @@ public:
     const_iterator find(const key_type& key) const
     { return ht_.find(key); }
 
+    /**
+     * @brief 使用预先计算的哈希值查找指定键的元素
+     * 
+     * @param key 要查找的键
+     * @param hash key 的哈希值，必须等于 hash_function()(key)
+     * @return iterator 指向找到元素的迭代器，若未找到则返回end()
+     */
+    iterator find(const key_type& key, size_type hash)
+    { return ht_.find(key, hash); }
+
+    const_iterator find(const key_type& key, size_type hash) const
+    { return ht_.find(key, hash); }
+
+    /**
+     * @brief 批量查找，依次向 out 写入每个键的 find 结果
+     * 
+     * 整组计算哈希值并预取桶和节点后再比较，多个查找的缓存缺失相互重叠，
+     * 适合用大量键探测一张大表（如哈希连接）
+     * @param first 键序列的起始位置（前向迭代器）
+     * @param last 键序列的结束位置
+     * @param out 接收 iterator 的输出迭代器，未找到时写入 end()
+     * @return 写入结果之后的输出迭代器
+     */
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+    { return ht_.find_batch(first, last, out); }
+
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    { return ht_.find_batch(first, last, out); }
+
+    /**
+     * @brief 批量判断键是否存在，依次向 out 写入 bool
+     */
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    { return ht_.contains_batch(first, last, out); }
+
     /**
      * @brief 查找指定键的元素范围
      * 
@@ -514,6 +827,54 @@ public:
     std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
     { return ht_.equal_range_unique(key); }
 
+    /**
+     * @brief 异构查找：Hash 与 KeyEqual 都声明了 is_transparent 时，以下函数接受任何
+     *        能与 key_type 比较相等的类型，不构造临时的 key_type
+     * 
+     * 例如 unordered_map<mystl::string, V, mystl::string_hash, mystl::transparent_equal_to>
+     * 可以直接用 const char* 查找；Hash 必须对相等的两种键给出相同的哈希值
+     */
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    size_type count(const K& key) const
+    { return ht_.count(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    iterator find(const K& key)
+    { return ht_.find(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    const_iterator find(const K& key) const
+    { return ht_.find(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    { return ht_.equal_range_unique(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    { return ht_.equal_range_unique(key); }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    { return ht_.erase_unique(key); }
+
     // 桶接口
 
     /**
@@ -652,24 +1013,24 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
     return lhs.ht_.equal_range_unique(rhs.ht_);
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_map<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_map<Key, T, Hash, KeyEqual>& rhs)
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
     return !lhs.ht_.equal_range_unique(rhs.ht_);
 }
 
 // 重载 swap
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
-          unordered_map<Key, T, Hash, KeyEqual>& rhs) noexcept
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_map<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
@@ -682,13 +1043,15 @@ void swap(unordered_map<Key, T, Hash, KeyEqual>& lhs,
  * @tparam T 值类型
  * @tparam Hash 哈希函数类型，默认使用 std::hash
  * @tparam KeyEqual 键比较函数类型，默认使用 std::equal_to
+ * @tparam Alloc 分配器类型，默认使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam BucketPolicy 桶策略，默认使用素数个桶（ht_prime_policy）
  */
-template <class Key, class T, class Hash, class KeyEqual>
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
 class unordered_multimap
 {
 private:
     // 使用 hashtable 作为底层实现
-    typedef hashtable<std::pair<const Key, T>, Hash, KeyEqual> base_type;
+    typedef hashtable<std::pair<const Key, T>, Hash, KeyEqual, BucketPolicy, Alloc> base_type;
     base_type ht_;
 
 public:
@@ -711,6 +1074,7 @@ public:
     typedef typename base_type::const_iterator       const_iterator;
     typedef typename base_type::local_iterator       local_iterator;
     typedef typename base_type::const_local_iterator const_local_iterator;
+    typedef typename base_type::node_handle_type     node_type;
 
     /**
      * @brief 获取分配器
@@ -729,17 +1093,29 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器构造空容器
+     * 
+     * @param alloc 分配器
+     */
+    explicit unordered_multimap(const allocator_type& alloc)
+        : ht_(100, Hash(), KeyEqual(), alloc)
+    {
+    }
+
     /**
      * @brief 构造函数，指定桶数和哈希函数
      * 
      * @param bucket_count 指定的桶数
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     explicit unordered_multimap(size_type bucket_count,
                              const Hash& hash = Hash(),
-                             const KeyEqual& equal = KeyEqual())
-        : ht_(bucket_count, hash, equal)
+                             const KeyEqual& equal = KeyEqual(),
+                             const allocator_type& alloc = allocator_type())
+        : ht_(bucket_count, hash, equal, alloc)
     {
     }
 
@@ -752,13 +1128,15 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     template <class InputIterator>
     unordered_multimap(InputIterator first, InputIterator last,
                     const size_type bucket_count = 100,
                     const Hash& hash = Hash(),
-                    const KeyEqual& equal = KeyEqual())
-        : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal)
+                    const KeyEqual& equal = KeyEqual(),
+                    const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal, alloc)
     {
         for (; first != last; ++first)
             ht_.insert_multi_noresize(*first);
@@ -771,12 +1149,14 @@ public:
      * @param bucket_count 桶数量
      * @param hash 哈希函数
      * @param equal 键比较函数
+     * @param alloc 分配器
      */
     unordered_multimap(std::initializer_list<value_type> ilist,
                     const size_type bucket_count = 100,
                     const Hash& hash = Hash(),
-                    const KeyEqual& equal = KeyEqual())
-        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                    const KeyEqual& equal = KeyEqual(),
+                    const allocator_type& alloc = allocator_type())
+        : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
     {
         for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
             ht_.insert_multi_noresize(*first);
@@ -792,6 +1172,17 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的拷贝构造函数
+     * 
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    unordered_multimap(const unordered_multimap& rhs, const allocator_type& alloc)
+        : ht_(rhs.ht_, alloc)
+    {
+    }
+
     /**
      * @brief 移动构造函数
      * 
@@ -802,6 +1193,17 @@ public:
     {
     }
 
+    /**
+     * @brief 使用指定分配器的移动构造函数
+     * 
+     * @param rhs 源对象
+     * @param alloc 分配器
+     */
+    unordered_multimap(unordered_multimap&& rhs, const allocator_type& alloc)
+        : ht_(std::move(rhs.ht_), alloc)
+    {
+    }
+
     /**
      * @brief 拷贝赋值运算符
      * 
@@ -820,7 +1222,7 @@ public:
      * @param rhs 源对象
      * @return unordered_multimap& 返回自身引用
      */
-    unordered_multimap& operator=(unordered_multimap&& rhs) noexcept
+    unordered_multimap& operator=(unordered_multimap&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
     {
         ht_ = std::move(rhs.ht_);
         return *this;
@@ -1022,6 +1424,46 @@ public:
     void clear()
     { ht_.clear(); }
 
+    // extract / 插入节点句柄
+
+    /**
+     * @brief 摘下指定位置的元素，节点不释放
+     * 
+     * @param it 指向要摘下元素的迭代器
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const_iterator it)
+    { return ht_.extract(it); }
+
+    /**
+     * @brief 摘下一个键为 key 的元素，不存在时返回空的节点句柄
+     * 
+     * @param key 要摘下的键
+     * @return node_type 持有该节点的节点句柄
+     */
+    node_type extract(const key_type& key)
+    { return ht_.extract(key); }
+
+    /**
+     * @brief 插入节点句柄中的元素
+     * 
+     * 分配器相等时直接链接节点，不分配也不复制元素
+     * @param nh 节点句柄，插入后变为空
+     * @return iterator 指向新元素的迭代器，句柄为空时返回end()
+     */
+    iterator insert(node_type&& nh)
+    { return ht_.insert_multi(std::move(nh)); }
+
+    /**
+     * @brief 使用提示位置插入节点句柄中的元素
+     * 
+     * @param hint 提示位置
+     * @param nh 节点句柄
+     * @return iterator 指向新元素的迭代器
+     */
+    iterator insert(const_iterator hint, node_type&& nh)
+    { return ht_.insert_multi_use_hint(hint, std::move(nh)); }
+
     /**
      * @brief 交换两个容器的内容
      * 
@@ -1117,6 +1559,31 @@ public:
     const_iterator find(const key_type& key) const
     { return ht_.find(key); }
 
+    /**
+     * @brief 批量查找，依次向 out 写入每个键的 find 结果
+     * 
+     * 整组计算哈希值并预取桶和节点后再比较，多个查找的缓存缺失相互重叠，
+     * 适合用大量键探测一张大表（如哈希连接）
+     * @param first 键序列的起始位置（前向迭代器）
+     * @param last 键序列的结束位置
+     * @param out 接收 iterator 的输出迭代器，未找到时写入 end()
+     * @return 写入结果之后的输出迭代器
+     */
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out)
+    { return ht_.find_batch(first, last, out); }
+
+    template <class ForwardIter, class OutputIter>
+    OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    { return ht_.find_batch(first, last, out); }
+
+    /**
+     * @brief 批量判断键是否存在，依次向 out 写入 bool
+     */
+    template <class ForwardIter, class OutputIter>
+    OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+    { return ht_.contains_batch(first, last, out); }
+
     /**
      * @brief 查找指定键的元素范围
      * 
@@ -1135,6 +1602,54 @@ public:
     std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const
     { return ht_.equal_range_multi(key); }
 
+    /**
+     * @brief 异构查找：Hash 与 KeyEqual 都声明了 is_transparent 时，以下函数接受任何
+     *        能与 key_type 比较相等的类型，不构造临时的 key_type
+     * 
+     * 例如 unordered_map<mystl::string, V, mystl::string_hash, mystl::transparent_equal_to>
+     * 可以直接用 const char* 查找；Hash 必须对相等的两种键给出相同的哈希值
+     */
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    size_type count(const K& key) const
+    { return ht_.count(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    iterator find(const K& key)
+    { return ht_.find(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    const_iterator find(const K& key) const
+    { return ht_.find(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    std::pair<iterator, iterator> equal_range(const K& key)
+    { return ht_.equal_range_multi(key); }
+
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value>::type>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+    { return ht_.equal_range_multi(key); }
+
+    /**
+     * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+     */
+    template <class K, class H = Hash,
+              class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                              mystl::is_transparent<KeyEqual>::value &&
+                                              !std::is_convertible<const K&, iterator>::value &&
+                                              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const K& key)
+    { return ht_.erase_multi(key); }
+
     // 桶接口
 
     /**
@@ -1273,28 +1788,44 @@ public:
 };
 
 // 重载比较操作符
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
     return lhs.ht_.equal_range_multi(rhs.ht_);
 }
 
-template <class Key, class T, class Hash, class KeyEqual>
-bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-                const unordered_multimap<Key, T, Hash, KeyEqual>& rhs)
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
     return !lhs.ht_.equal_range_multi(rhs.ht_);
 }
 
 // 重载 swap
-template <class Key, class T, class Hash, class KeyEqual>
-void swap(unordered_multimap<Key, T, Hash, KeyEqual>& lhs,
-          unordered_multimap<Key, T, Hash, KeyEqual>& rhs) noexcept
+template <class Key, class T, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_multimap<Key, T, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 unordered_map / unordered_multimap
+ */
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using unordered_map =
+    mystl::unordered_map<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using unordered_multimap =
+    mystl::unordered_multimap<Key, T, Hash, KeyEqual, polymorphic_allocator<std::pair<const Key, T>>>;
+
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MY_UNORDERED_MAP_H 
\ No newline at end of file
@@ -7,9 +7,12 @@
 #include <cassert>
 #include <utility>
 #include <ctime>
+#include <type_traits>
+#include <iterator>
 
 // 包含我们自己实现的 unordered_map 头文件
 #include "my_unordered_map.h"
+#include "../my_test_support/tagged_allocator.h"
 
 /**
  * @brief 测试 unordered_map 的基本功能
@@ -204,7 +207,288 @@ void test_unordered_multimap() {
     std::cout << "unordered_multimap 功能测试通过!" << std::endl;
 }
 
+/**
+ * @brief 统计构造次数的实值类型
+ */
+struct counted_value {
+    static int constructed;
+    int v;
+    counted_value(int x = 0) : v(x) { ++constructed; }
+    counted_value(const counted_value& rhs) : v(rhs.v) { ++constructed; }
+};
+int counted_value::constructed = 0;
+
+/**
+ * @brief 测试 try_emplace / insert_or_assign 以及重复键值不分配节点
+ */
+void test_unordered_map_try_emplace() {
+    std::cout << "===== 测试 try_emplace 和 insert_or_assign =====" << std::endl;
+
+    mystl::unordered_map<int, counted_value> map;
+    assert(map.try_emplace(1, 10).second);
+    assert(map.try_emplace(2).second);
+    assert(map.at(2).v == 0);
+
+    // 键值已存在：不构造任何对象
+    counted_value::constructed = 0;
+    auto r1 = map.try_emplace(1, 100);
+    assert(!r1.second && r1.first->second.v == 10);
+    auto r2 = map.emplace(1, counted_value(5));
+    assert(!r2.second);
+    assert(counted_value::constructed == 1);  // 只有实参临时对象
+    counted_value::constructed = 0;
+    auto r3 = map.emplace(std::make_pair(2, 7));
+    assert(!r3.second && r3.first->second.v == 0);
+    map[1].v += 1;
+    assert(counted_value::constructed == 0);
+    assert(map.at(1).v == 11);
+
+    // 移动键只有在插入成功时才会被移走
+    mystl::unordered_map<std::string, int> smap;
+    std::string key = "apple";
+    smap.try_emplace(std::move(key), 1);
+    std::string dup = "apple";
+    assert(!smap.try_emplace(std::move(dup), 2).second);
+    assert(dup == "apple");
+    assert(smap["apple"] == 1);
+
+    // insert_or_assign
+    auto r4 = smap.insert_or_assign("apple", 3);
+    assert(!r4.second && r4.first->second == 3);
+    auto r5 = smap.insert_or_assign(std::string("pear"), 4);
+    assert(r5.second && smap.at("pear") == 4);
+    auto it = smap.insert_or_assign(smap.begin(), "pear", 5);
+    assert(it->second == 5);
+    assert(smap.try_emplace(smap.begin(), "plum", 6)->second == 6);
+    assert(smap.size() == 3);
+
+    // 被移动后的容器没有桶，仍然可以继续插入
+    mystl::unordered_map<std::string, int> moved(std::move(smap));
+    assert(moved.size() == 3 && smap.empty());
+    assert(smap.try_emplace("fig", 7).second);
+    assert(smap.emplace("kiwi", 8).second);
+    assert(smap.insert(std::make_pair(std::string("lime"), 9)).second);
+    assert(!smap.try_emplace("fig", 0).second);
+    assert(smap.size() == 3 && smap.at("fig") == 7 && smap.at("lime") == 9);
+    mystl::unordered_map<std::string, int> assigned;
+    assigned = std::move(moved);
+    assert(assigned.size() == 3 && moved.empty());
+    // 被移动后的容器查找和删除都按"未找到"处理，不能对 0 个桶取模
+    assert(moved.find("apple") == moved.end() && moved.count("apple") == 0);
+    assert(moved.equal_range("apple").first == moved.end());
+    assert(moved.erase("apple") == 0 && moved.extract("apple").empty());
+    std::vector<std::string> missing = {"apple", "pear"};
+    std::vector<mystl::unordered_map<std::string, int>::iterator> none;
+    moved.find_batch(missing.begin(), missing.end(), std::back_inserter(none));
+    assert(none.size() == 2 && none[0] == moved.end() && none[1] == moved.end());
+    assert(moved.insert_or_assign("plum", 1).second && moved.size() == 1);
+
+    mystl::unordered_multimap<std::string, int> mm;
+    mm.emplace("a", 1);
+    mm.emplace("a", 2);
+    mystl::unordered_multimap<std::string, int> mm2(std::move(mm));
+    assert(mm.find("a") == mm.end() && mm.count("a") == 0 && mm.erase("a") == 0);
+    assert(mm.equal_range("a").first == mm.end());
+
+    std::cout << "try_emplace 和 insert_or_assign 测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试节点句柄
+ */
+void test_unordered_map_node_handle() {
+    std::cout << "===== 测试节点句柄 =====" << std::endl;
+
+    mystl::unordered_map<std::string, int> map;
+    for (int i = 0; i < 20; ++i) {
+        map.emplace("k" + std::to_string(i), i);
+    }
+
+    // 改键：节点不重新分配
+    auto nh = map.extract("k5");
+    assert(nh && map.size() == 19 && map.count("k5") == 0);
+    const int* addr = &nh.mapped();
+    nh.key() = "renamed";
+    auto r = map.insert(std::move(nh));
+    assert(r.inserted && r.node.empty() && &r.position->second == addr);
+    assert(map.at("renamed") == 5);
+
+    // 键已存在：节点留在返回值中
+    mystl::unordered_map<std::string, int> other;
+    other.emplace("k1", -1);
+    r = other.insert(map.extract(map.find("k1")));
+    assert(!r.inserted && r.node.mapped() == 1 && r.position->second == -1);
+    assert(map.extract("missing").empty());
+
+    // unordered_map 与 unordered_multimap 之间转移
+    mystl::unordered_multimap<std::string, int> mm;
+    mm.insert(std::move(r.node));
+    mm.insert(mm.begin(), other.extract(other.begin()));
+    while (!map.empty()) {
+        mm.insert(map.extract(map.begin()));
+    }
+    assert(mm.size() == 21 && mm.count("k1") == 2 && other.empty());
+    map.insert(map.end(), mm.extract("renamed"));
+    assert(map.size() == 1 && map.at("renamed") == 5);
+
+    // 被移动后的容器：extract 返回空句柄，节点句柄可以插回
+    mystl::unordered_map<std::string, int> taken(std::move(map));
+    assert(map.extract("renamed").empty());
+    r = map.insert(taken.extract("renamed"));
+    assert(r.inserted && map.size() == 1 && map.at("renamed") == 5 && taken.empty());
+    mystl::unordered_multimap<std::string, int> mm2(std::move(mm));
+    assert(mm.extract("k1").empty());
+    mm.insert(mm2.extract("k1"));
+    assert(mm.size() == 1 && mm.count("k1") == 1);
+
+    std::cout << "节点句柄测试通过!" << std::endl;
+}
+
+/**
+ * @brief 统计调用次数的哈希函数，用来确认提示匹配时不计算哈希值
+ */
+struct counting_hash {
+    static int calls;
+    size_t operator()(int key) const {
+        ++calls;
+        return std::hash<int>()(key);
+    }
+};
+int counting_hash::calls = 0;
+
+/**
+ * @brief 测试带提示的插入：提示的键相等时新元素紧跟在提示位置之后
+ */
+void test_unordered_map_hint() {
+    std::cout << "===== 测试带提示的插入 =====" << std::endl;
+
+    // 从空表开始，插入过程中多次重哈希，提示位置始终有效
+    mystl::unordered_multimap<std::string, int> mm;
+    for (int k = 0; k < 50; ++k) {
+        auto hint = mm.end();
+        for (int j = 0; j < 20; ++j) {
+            auto it = mm.insert(hint, std::make_pair("key-" + std::to_string(k), j));
+            if (j > 0) {
+                auto next = hint;
+                assert(++next == it);  // 链接在提示节点之后
+            }
+            hint = it;
+        }
+    }
+    assert(mm.size() == 1000);
+    for (int k = 0; k < 50; ++k) {
+        auto r = mm.equal_range("key-" + std::to_string(k));
+        int expect = 0;
+        for (auto it = r.first; it != r.second; ++it) {
+            assert(it->second == expect++);  // 相等的键相邻，且保持插入顺序
+        }
+        assert(expect == 20);
+    }
+
+    // 提示的键不同时与不带提示的插入相同
+    auto it = mm.emplace_hint(mm.find("key-1"), "key-2", 99);
+    assert(it->first == "key-2" && mm.count("key-2") == 21 && mm.count("key-1") == 20);
+
+    // 节点句柄
+    auto nh = mm.extract(mm.find("key-3"));
+    auto pos = mm.insert(mm.find("key-3"), std::move(nh));
+    assert(nh.empty() && pos->first == "key-3" && mm.count("key-3") == 20);
+
+    // 区间插入：输入中连续的相等键值沿用上一个节点
+    std::vector<std::pair<std::string, int>> items;
+    for (int i = 0; i < 300; ++i) {
+        items.push_back(std::make_pair("group-" + std::to_string(i / 30 % 5), i));
+    }
+    mystl::unordered_multimap<std::string, int> grouped(items.begin(), items.end());
+    grouped.insert(items.begin(), items.end());
+    for (int g = 0; g < 5; ++g) {
+        auto r = grouped.equal_range("group-" + std::to_string(g));
+        assert(std::distance(r.first, r.second) == 120);
+    }
+
+    // 不允许重复键值：提示的键相等时直接返回提示位置
+    mystl::unordered_map<std::string, int> map;
+    auto first = map.insert(std::make_pair(std::string("a"), 1)).first;
+    assert(map.insert(first, std::make_pair(std::string("a"), 2)) == first);
+    assert(map.emplace_hint(first, "a", 3) == first && map.at("a") == 1);
+    auto b = map.emplace_hint(first, "b", 2);
+    assert(b->second == 2 && map.size() == 2);
+    auto nh2 = mystl::unordered_map<std::string, int>({{"a", 5}}).extract("a");
+    assert(map.insert(first, std::move(nh2)) == first && !nh2.empty() && nh2.mapped() == 5);
+
+    // try_emplace / insert_or_assign 同样使用提示：键相等时不计算哈希值
+    mystl::unordered_map<int, int, counting_hash> hm;
+    auto h = hm.try_emplace(hm.end(), 7, 1);
+    counting_hash::calls = 0;
+    assert(hm.try_emplace(h, 7, 2) == h && h->second == 1);
+    assert(hm.insert_or_assign(h, 7, 3) == h && h->second == 3);
+    assert(counting_hash::calls == 0 && hm.size() == 1);
+    auto h2 = hm.insert_or_assign(h, 8, 4);
+    assert(h2->first == 8 && h2->second == 4 && hm.size() == 2 && counting_hash::calls > 0);
+
+    std::cout << "带提示的插入测试通过!" << std::endl;
+}
+
+/**
+ * @brief 测试批量查找：结果与逐个 find 一致
+ */
+void test_unordered_map_find_batch() {
+    std::cout << "===== 测试批量查找 =====" << std::endl;
+
+    mystl::unordered_map<int, int> map;
+    for (int i = 0; i < 5000; i += 2) {
+        map.emplace(i, i * 10);
+    }
+    // 命中与未命中交错，长度不是分组大小的整数倍
+    std::vector<int> keys;
+    for (int i = 0; i < 1003; ++i) {
+        keys.push_back((i * 7919) % 6000);
+    }
+    std::vector<mystl::unordered_map<int, int>::iterator> found;
+    map.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+    assert(found.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        assert(found[i] == map.find(keys[i]));
+    }
+    // 非常量版本返回可修改元素的迭代器
+    assert(keys[0] == 0);
+    found[0]->second = -1;
+    assert(map.at(0) == -1);
+
+    const mystl::unordered_map<int, int>& cmap = map;
+    std::vector<mystl::unordered_map<int, int>::const_iterator> cfound(keys.size());
+    auto end = cmap.find_batch(keys.begin(), keys.end(), cfound.begin());
+    assert(end == cfound.end());
+
+    std::vector<bool> hits;
+    map.contains_batch(keys.begin(), keys.end(), std::back_inserter(hits));
+    for (size_t i = 0; i < keys.size(); ++i) {
+        assert(hits[i] == (keys[i] % 2 == 0 && keys[i] < 5000));
+    }
+
+    // 空区间与空表
+    mystl::unordered_map<int, int> empty;
+    assert(empty.find_batch(keys.begin(), keys.begin(), found.begin()) == found.begin());
+    empty.contains_batch(keys.begin(), keys.begin() + 3, hits.begin());
+    assert(!hits[0] && !hits[1] && !hits[2]);
+
+    // unordered_multimap 返回第一个相等的元素，字符串键使用缓存的哈希值比较
+    mystl::unordered_multimap<std::string, int> mm;
+    for (int i = 0; i < 100; ++i) {
+        mm.emplace("k" + std::to_string(i % 10), i);
+    }
+    std::vector<std::string> names = {"k3", "missing", "k9", "k0"};
+    std::vector<mystl::unordered_multimap<std::string, int>::iterator> mfound;
+    mm.find_batch(names.begin(), names.end(), std::back_inserter(mfound));
+    assert(mfound[0] == mm.find("k3") && mfound[1] == mm.end());
+    assert(mfound[2]->first == "k9" && mfound[3]->first == "k0");
+
+    std::cout << "批量查找测试通过!" << std::endl;
+}
+
 /**
+ * @brief 测试异常安全性
+ *//**
  * @brief 测试异常安全性
  */
 void test_exception_safety() {
@@ -223,6 +507,57 @@ void test_exception_safety() {
     std::cout << "异常安全性测试通过!" << std::endl;
 }
 
+/**
+ * @brief 测试有状态分配器在拷贝、移动和交换时的传播
+ */
+void test_allocator_propagation() {
+    std::cout << "===== 测试有状态分配器的传播 =====" << std::endl;
+    {
+        typedef tagged_allocator<std::pair<const int, std::string>, false> alloc;  // 不传播
+        typedef mystl::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, alloc> map_type;
+        map_type a(alloc(1));
+        for (int i = 0; i < 100; ++i) a.emplace(i, std::to_string(i));
+        map_type b(alloc(2));
+        b.emplace(-1, "x");
+
+        map_type c(a);
+        assert(c.get_allocator().id == 1 && c.size() == 100);
+        map_type d(a, alloc(3));
+        assert(d.get_allocator().id == 3 && d.at(42) == "42");
+
+        b = a;  // 不传播：保留自己的分配器
+        assert(b.get_allocator().id == 2 && b.size() == 100 && b.count(-1) == 0);
+        b = std::move(c);  // 分配器不相等：逐个移动元素
+        assert(b.get_allocator().id == 2 && b.size() == 100 && b.at(7) == "7");
+        map_type e(std::move(d), alloc(4));
+        assert(e.get_allocator().id == 4 && e.size() == 100 && d.empty());
+    }
+    assert(all_released<false>());
+    {
+        typedef tagged_allocator<std::pair<const int, std::string>, true> alloc;  // 传播
+        typedef mystl::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, alloc> map_type;
+        map_type a(alloc(1));
+        a.emplace(1, "one");
+        map_type b(alloc(2));
+        b.emplace(2, "two");
+        b = a;
+        assert(b.get_allocator().id == 1 && b.at(1) == "one");
+        map_type c(alloc(3));
+        c = std::move(b);
+        assert(c.get_allocator().id == 1 && c.size() == 1);
+        map_type d(alloc(4));
+        d.emplace(4, "four");
+        d.swap(a);
+        assert(d.get_allocator().id == 1 && a.get_allocator().id == 4 && a.at(4) == "four");
+    }
+    assert(all_released<true>());
+
+    // 空分配器保存在基类中，不占空间：桶数组、桶数、元素数，加上最大负载因子和空的函数对象
+    static_assert(sizeof(mystl::unordered_map<int, int>) == sizeof(mystl::vector<void*>) + 3 * sizeof(size_t),
+                  "std::allocator 不应增大 unordered_map");
+    std::cout << "有状态分配器测试通过!" << std::endl;
+}
+
 /**
  * @brief 性能测试
  */
@@ -260,7 +595,12 @@ int main() {
     test_unordered_map_basic();
     test_unordered_map_advanced();
     test_unordered_multimap();
+    test_unordered_map_try_emplace();
+    test_unordered_map_node_handle();
+    test_unordered_map_hint();
+    test_unordered_map_find_batch();
     test_exception_safety();
+    test_allocator_propagation();
     test_performance();
     
     std::cout << "所有测试完成，功能正常!" << std::endl;
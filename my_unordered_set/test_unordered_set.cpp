@@ -96,6 +96,10 @@ void test_unordered_set_construction() {
     assert(set8.size() == 5);
     assert(set7.empty()); // 移动后原容器应为空
     printSet(set8, "移动赋值的set8");
+
+    // 被移动后的容器可以继续插入
+    assert(set5.insert(1).second && set5.emplace(2).second && !set5.insert(1).second);
+    assert(set7.emplace(3).second && set7.size() == 1 && set7.count(3) == 1);
     
     // 初始化列表赋值
     set8 = {10, 20, 30, 40};
@@ -211,6 +215,18 @@ void test_unordered_set_lookup() {
     assert(std::distance(first, last) == 1); // unordered_set中一个键只有一个值
     std::cout << "equal_range(20)得到范围内的元素: " << *first << "\n";
     
+    // 批量查找
+    std::vector<int> keys = {10, 15, 50, 60, 30};
+    std::vector<mystl::unordered_set<int>::iterator> found(keys.size());
+    set.find_batch(keys.begin(), keys.end(), found.begin());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        assert(found[i] == set.find(keys[i]));
+    }
+    bool hits[5];
+    set.contains_batch(keys.begin(), keys.end(), hits);
+    assert(hits[0] && !hits[1] && hits[2] && !hits[3] && hits[4]);
+    std::cout << "find_batch / contains_batch 与逐个查找结果一致\n";
+    
     std::cout << "查找操作测试全部通过！\n";
 }
 
@@ -437,6 +453,31 @@ void test_unordered_multiset() {
     std::cout << "unordered_multiset测试通过！\n";
 }
 
+void test_unordered_set_node_handle() {
+    std::cout << "\n===== 测试节点句柄 =====\n";
+
+    mystl::unordered_set<int> set = {1, 2, 3, 4, 5};
+    auto nh = set.extract(3);
+    assert(nh && set.size() == 4 && set.count(3) == 0);
+    nh.value() = 30;  // 改值后放回，节点不重新分配
+    auto r = set.insert(std::move(nh));
+    assert(r.inserted && *r.position == 30 && set.count(30) == 1);
+
+    // 值已存在：节点留在返回值中
+    mystl::unordered_set<int> other = {1};
+    r = other.insert(set.extract(1));
+    assert(!r.inserted && r.node.value() == 1 && other.size() == 1);
+
+    mystl::unordered_multiset<int> mset;
+    mset.insert(std::move(r.node));
+    mset.insert(other.extract(other.begin()));
+    mset.insert(mset.end(), set.extract(set.find(2)));
+    assert(mset.size() == 3 && mset.count(1) == 2 && set.size() == 3);
+    std::cout << "转移后 mset.size() = " << mset.size() << "\n";
+
+    std::cout << "节点句柄测试通过！\n";
+}
+
 int main() {
     std::cout << "开始测试unordered_set和unordered_multiset容器...\n";
     
@@ -447,6 +488,7 @@ int main() {
     test_unordered_set_comparison();
     test_unordered_set_custom_type();
     test_unordered_multiset();
+    test_unordered_set_node_handle();
     
     std::cout << "\n所有测试全部通过！unordered_set和unordered_multiset容器实现正确。\n";
     
@@ -18,6 +18,8 @@
  */
 
 #include "../my_hashtable/my_hashtable.h"
+#include "../my_memory_resource/my_memory_resource.h"
+#include "../my_functional/my_functional.h"
 #include <functional>  // 使用std::hash和std::equal_to作为默认参数
 #include <initializer_list>
 #include <utility>    // 使用std::pair
@@ -33,10 +35,12 @@ using std::forward;
 using std::move;
 
 // 前置声明
-template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>> 
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<Key>, class BucketPolicy = ht_prime_policy>
 class unordered_set;
 
-template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>> 
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<Key>, class BucketPolicy = ht_prime_policy>
 class unordered_multiset;
 
 /**
@@ -45,13 +49,15 @@ class unordered_multiset;
  * @tparam Key 键值类型
  * @tparam Hash 哈希函数，缺省使用 std::hash
  * @tparam KeyEqual 键值比较方式，缺省使用 std::equal_to
+ * @tparam Alloc 分配器类型，缺省使用 std::allocator，可以使用 mystl::pool_allocator
+ * @tparam BucketPolicy 桶策略，缺省使用素数个桶（ht_prime_policy）
  */
-template <class Key, class Hash, class KeyEqual>
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
 class unordered_set
 {
 private:
   // 使用 hashtable 作为底层机制
-  typedef hashtable<Key, Hash, KeyEqual> base_type;
+  typedef hashtable<Key, Hash, KeyEqual, BucketPolicy, Alloc> base_type;
   base_type ht_;
 
 public:
@@ -73,6 +79,8 @@ public:
   typedef typename base_type::const_iterator       const_iterator;
   typedef typename base_type::const_local_iterator local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
+  typedef typename base_type::node_handle_type     node_type;
+  typedef node_insert_return<iterator, node_type>  insert_return_type;
 
   /**
    * @brief 获取分配器实例
@@ -90,17 +98,29 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器构造空容器
+   * 
+   * @param alloc 分配器
+   */
+  explicit unordered_set(const allocator_type& alloc)
+    : ht_(100, Hash(), KeyEqual(), alloc)
+  {
+  }
+
   /**
    * @brief 指定桶数量的构造函数
    * 
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   explicit unordered_set(size_type bucket_count,
                          const Hash& hash = Hash(),
-                         const KeyEqual& equal = KeyEqual()) noexcept
-    : ht_(bucket_count, hash, equal)
+                         const KeyEqual& equal = KeyEqual(),
+                         const allocator_type& alloc = allocator_type()) noexcept
+    : ht_(bucket_count, hash, equal, alloc)
   {
   }
 
@@ -113,13 +133,15 @@ public:
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   template <class InputIterator>
   unordered_set(InputIterator first, InputIterator last,
                 const size_type bucket_count = 100,
                 const Hash& hash = Hash(),
-                const KeyEqual& equal = KeyEqual())
-    : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal)
+                const KeyEqual& equal = KeyEqual(),
+                const allocator_type& alloc = allocator_type())
+    : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal, alloc)
   {
     for (; first != last; ++first)
       ht_.insert_unique_noresize(*first);
@@ -132,12 +154,14 @@ public:
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   unordered_set(std::initializer_list<value_type> ilist,
                 const size_type bucket_count = 100,
                 const Hash& hash = Hash(),
-                const KeyEqual& equal = KeyEqual())
-    : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                const KeyEqual& equal = KeyEqual(),
+                const allocator_type& alloc = allocator_type())
+    : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
   {
     for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
       ht_.insert_unique_noresize(*first);
@@ -153,6 +177,17 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器的拷贝构造函数
+   * 
+   * @param rhs 源对象
+   * @param alloc 分配器
+   */
+  unordered_set(const unordered_set& rhs, const allocator_type& alloc)
+    : ht_(rhs.ht_, alloc)
+  {
+  }
+
   /**
    * @brief 移动构造函数
    * 
@@ -163,6 +198,17 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器的移动构造函数
+   * 
+   * @param rhs 源对象
+   * @param alloc 分配器
+   */
+  unordered_set(unordered_set&& rhs, const allocator_type& alloc)
+    : ht_(std::move(rhs.ht_), alloc)
+  {
+  }
+
   /**
    * @brief 拷贝赋值操作符
    * 
@@ -181,7 +227,7 @@ public:
    * @param rhs 被移动的unordered_set
    * @return 自身引用
    */
-  unordered_set& operator=(unordered_set&& rhs) noexcept
+  unordered_set& operator=(unordered_set&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
   {
     ht_ = std::move(rhs.ht_);
     return *this;
@@ -399,6 +445,49 @@ public:
     ht_.clear(); 
   }
 
+  // extract / 插入节点句柄
+
+  /**
+   * @brief 摘下指定位置的元素，节点不释放
+   * 
+   * @param it 指向要摘下元素的迭代器
+   * @return node_type 持有该节点的节点句柄
+   */
+  node_type extract(const_iterator it)
+  { return ht_.extract(it); }
+
+  /**
+   * @brief 摘下一个值为 key 的元素，不存在时返回空的节点句柄
+   * 
+   * @param key 要摘下的键
+   * @return node_type 持有该节点的节点句柄
+   */
+  node_type extract(const key_type& key)
+  { return ht_.extract(key); }
+
+  /**
+   * @brief 插入节点句柄中的元素，键已存在时节点留在返回值的 node 中
+   * 
+   * 分配器相等时直接链接节点，不分配也不复制元素；可以先修改 nh.value() 再放回，完成改值
+   * @param nh 节点句柄，插入成功后变为空
+   * @return insert_return_type 插入位置、是否插入以及未插入的节点
+   */
+  insert_return_type insert(node_type&& nh)
+  {
+    auto result = ht_.insert_unique(std::move(nh));
+    return insert_return_type{result.position, result.inserted, std::move(result.node)};
+  }
+
+  /**
+   * @brief 使用提示位置插入节点句柄中的元素，键已存在时节点留在 nh 中
+   * 
+   * @param hint 提示位置
+   * @param nh 节点句柄
+   * @return iterator 指向键相同的元素的迭代器，句柄为空时返回end()
+   */
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return ht_.insert_unique_use_hint(hint, std::move(nh)); }
+
   /**
    * @brief 与另一个unordered_set交换内容
    * 
@@ -444,6 +533,30 @@ public:
     return ht_.find(key); 
   }
 
+  /**
+   * @brief 批量查找，依次向 out 写入每个键的 find 结果
+   * 
+   * 整组计算哈希值并预取桶和节点后再比较，多个查找的缓存缺失相互重叠
+   * @param first 键序列的起始位置（前向迭代器）
+   * @param last 键序列的结束位置
+   * @param out 接收迭代器的输出迭代器，未找到时写入 end()
+   * @return 写入结果之后的输出迭代器
+   */
+  template <class ForwardIter, class OutputIter>
+  OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+  {
+    return ht_.find_batch(first, last, out);
+  }
+
+  /**
+   * @brief 批量判断键是否存在，依次向 out 写入 bool
+   */
+  template <class ForwardIter, class OutputIter>
+  OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+  {
+    return ht_.contains_batch(first, last, out);
+  }
+
   /**
    * @brief 返回指定键的元素范围
    * 
@@ -466,6 +579,66 @@ public:
     return ht_.equal_range_unique(key); 
   }
 
+  /**
+   * @brief 异构查找：Hash 与 KeyEqual 都声明了 is_transparent 时，以下函数接受任何
+   *        能与 key_type 比较相等的类型，不构造临时的 key_type
+   * 
+   * 例如 unordered_set<mystl::string, mystl::string_hash, mystl::transparent_equal_to>
+   * 可以直接用 const char* 查找；Hash 必须对相等的两种键给出相同的哈希值
+   */
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  size_type count(const K& key) const
+  { 
+    return ht_.count(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  iterator find(const K& key)
+  { 
+    return ht_.find(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  const_iterator find(const K& key) const
+  { 
+    return ht_.find(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  pair<iterator, iterator> equal_range(const K& key)
+  { 
+    return ht_.equal_range_unique(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { 
+    return ht_.equal_range_unique(key); 
+  }
+
+  /**
+   * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+   */
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value &&
+                                            !std::is_convertible<const K&, iterator>::value &&
+                                            !std::is_convertible<const K&, const_iterator>::value>::type>
+  size_type erase(const K& key)
+  { 
+    return ht_.erase_unique(key); 
+  }
+
   // bucket 接口
 
   /**
@@ -701,9 +874,9 @@ public:
  * @param rhs 右侧操作数
  * @return 如果两个unordered_set相等，返回true，否则返回false
  */
-template <class Key, class Hash, class KeyEqual>
-bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs)
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
   if (lhs.size() != rhs.size())
     return false;
@@ -727,9 +900,9 @@ bool operator==(const unordered_set<Key, Hash, KeyEqual>& lhs,
  * @param rhs 右侧操作数
  * @return 如果两个unordered_set不相等，返回true，否则返回false
  */
-template <class Key, class Hash, class KeyEqual>
-bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
-                const unordered_set<Key, Hash, KeyEqual>& rhs)
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
   return !(lhs == rhs);
 }
@@ -743,9 +916,9 @@ bool operator!=(const unordered_set<Key, Hash, KeyEqual>& lhs,
  * @param lhs 左侧操作数
  * @param rhs 右侧操作数
  */
-template <class Key, class Hash, class KeyEqual>
-void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
-          unordered_set<Key, Hash, KeyEqual>& rhs) noexcept
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_set<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
@@ -759,12 +932,12 @@ void swap(unordered_set<Key, Hash, KeyEqual>& lhs,
  * @tparam Hash 哈希函数，缺省使用 std::hash
  * @tparam KeyEqual 键值比较方式，缺省使用 std::equal_to
  */
-template <class Key, class Hash, class KeyEqual>
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
 class unordered_multiset
 {
 private:
   // 使用 hashtable 作为底层机制
-  typedef hashtable<Key, Hash, KeyEqual> base_type;
+  typedef hashtable<Key, Hash, KeyEqual, BucketPolicy, Alloc> base_type;
   base_type ht_;
 
 public:
@@ -786,6 +959,7 @@ public:
   typedef typename base_type::const_iterator       const_iterator;
   typedef typename base_type::const_local_iterator local_iterator;
   typedef typename base_type::const_local_iterator const_local_iterator;
+  typedef typename base_type::node_handle_type     node_type;
 
   /**
    * @brief 获取分配器实例
@@ -804,17 +978,29 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器构造空容器
+   * 
+   * @param alloc 分配器
+   */
+  explicit unordered_multiset(const allocator_type& alloc)
+    : ht_(100, Hash(), KeyEqual(), alloc)
+  {
+  }
+
   /**
    * @brief 指定桶数量的构造函数
    * 
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   explicit unordered_multiset(size_type bucket_count,
                               const Hash& hash = Hash(),
-                              const KeyEqual& equal = KeyEqual()) noexcept
-    : ht_(bucket_count, hash, equal)
+                              const KeyEqual& equal = KeyEqual(),
+                              const allocator_type& alloc = allocator_type()) noexcept
+    : ht_(bucket_count, hash, equal, alloc)
   {
   }
 
@@ -827,13 +1013,15 @@ public:
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   template <class InputIterator>
   unordered_multiset(InputIterator first, InputIterator last,
                      const size_type bucket_count = 100,
                      const Hash& hash = Hash(),
-                     const KeyEqual& equal = KeyEqual())
-    : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal)
+                     const KeyEqual& equal = KeyEqual(),
+                     const allocator_type& alloc = allocator_type())
+    : ht_(std::max(bucket_count, static_cast<size_type>(std::distance(first, last))), hash, equal, alloc)
   {
     for (; first != last; ++first)
       ht_.insert_multi_noresize(*first);
@@ -846,12 +1034,14 @@ public:
    * @param bucket_count 桶数量
    * @param hash 哈希函数
    * @param equal 键值比较函数
+   * @param alloc 分配器
    */
   unordered_multiset(std::initializer_list<value_type> ilist,
                      const size_type bucket_count = 100,
                      const Hash& hash = Hash(),
-                     const KeyEqual& equal = KeyEqual())
-    : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal)
+                     const KeyEqual& equal = KeyEqual(),
+                     const allocator_type& alloc = allocator_type())
+    : ht_(std::max(bucket_count, static_cast<size_type>(ilist.size())), hash, equal, alloc)
   {
     for (auto first = ilist.begin(), last = ilist.end(); first != last; ++first)
       ht_.insert_multi_noresize(*first);
@@ -867,6 +1057,17 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器的拷贝构造函数
+   * 
+   * @param rhs 源对象
+   * @param alloc 分配器
+   */
+  unordered_multiset(const unordered_multiset& rhs, const allocator_type& alloc)
+    : ht_(rhs.ht_, alloc)
+  {
+  }
+
   /**
    * @brief 移动构造函数
    * 
@@ -877,6 +1078,17 @@ public:
   {
   }
 
+  /**
+   * @brief 使用指定分配器的移动构造函数
+   * 
+   * @param rhs 源对象
+   * @param alloc 分配器
+   */
+  unordered_multiset(unordered_multiset&& rhs, const allocator_type& alloc)
+    : ht_(std::move(rhs.ht_), alloc)
+  {
+  }
+
   /**
    * @brief 拷贝赋值操作符
    * 
@@ -895,7 +1107,7 @@ public:
    * @param rhs 被移动的unordered_multiset
    * @return 自身引用
    */
-  unordered_multiset& operator=(unordered_multiset&& rhs) noexcept
+  unordered_multiset& operator=(unordered_multiset&& rhs) noexcept(std::is_nothrow_move_assignable<base_type>::value)
   {
     ht_ = std::move(rhs.ht_);
     return *this;
@@ -1113,6 +1325,46 @@ public:
     ht_.clear(); 
   }
 
+  // extract / 插入节点句柄
+
+  /**
+   * @brief 摘下指定位置的元素，节点不释放
+   * 
+   * @param it 指向要摘下元素的迭代器
+   * @return node_type 持有该节点的节点句柄
+   */
+  node_type extract(const_iterator it)
+  { return ht_.extract(it); }
+
+  /**
+   * @brief 摘下一个值为 key 的元素，不存在时返回空的节点句柄
+   * 
+   * @param key 要摘下的键
+   * @return node_type 持有该节点的节点句柄
+   */
+  node_type extract(const key_type& key)
+  { return ht_.extract(key); }
+
+  /**
+   * @brief 插入节点句柄中的元素
+   * 
+   * 分配器相等时直接链接节点，不分配也不复制元素
+   * @param nh 节点句柄，插入后变为空
+   * @return iterator 指向新元素的迭代器，句柄为空时返回end()
+   */
+  iterator insert(node_type&& nh)
+  { return ht_.insert_multi(std::move(nh)); }
+
+  /**
+   * @brief 使用提示位置插入节点句柄中的元素
+   * 
+   * @param hint 提示位置
+   * @param nh 节点句柄
+   * @return iterator 指向新元素的迭代器
+   */
+  iterator insert(const_iterator hint, node_type&& nh)
+  { return ht_.insert_multi_use_hint(hint, std::move(nh)); }
+
   /**
    * @brief 与另一个unordered_multiset交换内容
    * 
@@ -1158,6 +1410,30 @@ public:
     return ht_.find(key); 
   }
 
+  /**
+   * @brief 批量查找，依次向 out 写入每个键的 find 结果
+   * 
+   * 整组计算哈希值并预取桶和节点后再比较，多个查找的缓存缺失相互重叠
+   * @param first 键序列的起始位置（前向迭代器）
+   * @param last 键序列的结束位置
+   * @param out 接收迭代器的输出迭代器，未找到时写入 end()
+   * @return 写入结果之后的输出迭代器
+   */
+  template <class ForwardIter, class OutputIter>
+  OutputIter find_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+  {
+    return ht_.find_batch(first, last, out);
+  }
+
+  /**
+   * @brief 批量判断键是否存在，依次向 out 写入 bool
+   */
+  template <class ForwardIter, class OutputIter>
+  OutputIter contains_batch(ForwardIter first, ForwardIter last, OutputIter out) const
+  {
+    return ht_.contains_batch(first, last, out);
+  }
+
   /**
    * @brief 返回指定键的元素范围
    * 
@@ -1180,6 +1456,66 @@ public:
     return ht_.equal_range_multi(key); 
   }
 
+  /**
+   * @brief 异构查找：Hash 与 KeyEqual 都声明了 is_transparent 时，以下函数接受任何
+   *        能与 key_type 比较相等的类型，不构造临时的 key_type
+   * 
+   * 例如 unordered_set<mystl::string, mystl::string_hash, mystl::transparent_equal_to>
+   * 可以直接用 const char* 查找；Hash 必须对相等的两种键给出相同的哈希值
+   */
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  size_type count(const K& key) const
+  { 
+    return ht_.count(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  iterator find(const K& key)
+  { 
+    return ht_.find(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  const_iterator find(const K& key) const
+  { 
+    return ht_.find(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  pair<iterator, iterator> equal_range(const K& key)
+  { 
+    return ht_.equal_range_multi(key); 
+  }
+
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value>::type>
+  pair<const_iterator, const_iterator> equal_range(const K& key) const
+  { 
+    return ht_.equal_range_multi(key); 
+  }
+
+  /**
+   * @brief 删除与 key 相等的元素，能转换为迭代器的参数仍调用按位置删除的版本
+   */
+  template <class K, class H = Hash,
+            class = typename std::enable_if<mystl::is_transparent<H>::value &&
+                                            mystl::is_transparent<KeyEqual>::value &&
+                                            !std::is_convertible<const K&, iterator>::value &&
+                                            !std::is_convertible<const K&, const_iterator>::value>::type>
+  size_type erase(const K& key)
+  { 
+    return ht_.erase_multi(key); 
+  }
+
   // bucket 接口
 
   /**
@@ -1417,9 +1753,9 @@ public:
  * @param rhs 右侧操作数
  * @return 如果两个unordered_multiset相等，返回true，否则返回false
  */
-template <class Key, class Hash, class KeyEqual>
-bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
   if (lhs.size() != rhs.size())
     return false;
@@ -1445,9 +1781,9 @@ bool operator==(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
  * @param rhs 右侧操作数
  * @return 如果两个unordered_multiset不相等，返回true，否则返回false
  */
-template <class Key, class Hash, class KeyEqual>
-bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
-                const unordered_multiset<Key, Hash, KeyEqual>& rhs)
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+                const unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs)
 {
   return !(lhs == rhs);
 }
@@ -1461,12 +1797,26 @@ bool operator!=(const unordered_multiset<Key, Hash, KeyEqual>& lhs,
  * @param lhs 左侧操作数
  * @param rhs 右侧操作数
  */
-template <class Key, class Hash, class KeyEqual>
-void swap(unordered_multiset<Key, Hash, KeyEqual>& lhs,
-          unordered_multiset<Key, Hash, KeyEqual>& rhs) noexcept
+template <class Key, class Hash, class KeyEqual, class Alloc, class BucketPolicy>
+void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& lhs,
+          unordered_multiset<Key, Hash, KeyEqual, Alloc, BucketPolicy>& rhs) noexcept
 {
   lhs.swap(rhs);
 }
+namespace pmr
+{
+
+/**
+ * @brief 使用 polymorphic_allocator 的 unordered_set / unordered_multiset
+ */
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using unordered_set = mystl::unordered_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+using unordered_multiset = mystl::unordered_multiset<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MY_UNORDERED_SET_H_ 
\ No newline at end of file
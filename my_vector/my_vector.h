@@ -9,6 +9,9 @@
  */
 
 #include <initializer_list>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <algorithm>
@@ -16,6 +19,14 @@
 #include <utility>
 #include <limits>
 #include <iterator>
+#include "../my_memory_resource/my_memory_resource.h"
+
+// 禁止内联，不支持的编译器上什么也不做
+#if defined(__GNUC__) || defined(__clang__)
+#define MYSTL_NOINLINE __attribute__((noinline))
+#else
+#define MYSTL_NOINLINE
+#endif
 
 namespace mystl {
 
@@ -29,13 +40,212 @@ ForwardIterator uninitialized_move(InputIterator first, InputIterator last, Forw
     return result;
 }
 
+/**
+ * @brief 类型是否可以平凡重定位（trivially relocatable）
+ *
+ * 把对象的字节复制到新地址、不再析构原对象，效果与"移动构造到新地址后析构原对象"相同。
+ * 可平凡复制的类型都满足；只通过指针持有外部资源、不保存指向自身的指针的类型
+ * （unique_ptr、shared_ptr、本项目的 vector 等）虽然不可平凡复制，也满足。
+ * 自定义类型满足条件时可以特化为 std::true_type，vector 扩容、插入和删除时就会整块搬动它们。
+ *
+ * mystl::basic_string 的短字符串优化让 data_ 指向对象内部的缓冲区，按字节搬动后指针仍指向旧对象，
+ * 因此不满足，不能特化
+ */
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <class T, class D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template <class T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+template <class T1, class T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::integral_constant<bool, is_trivially_relocatable<T1>::value &&
+                                   is_trivially_relocatable<T2>::value> {};
+
+// 标准分配器没有数据成员，polymorphic_allocator 只保存内存资源的指针
+template <class T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<pmr::polymorphic_allocator<T>> : std::true_type {};
+
+// my_smart_pointer.h 中的智能指针，同样只持有指针
+template <typename T, typename Deleter> class unique_ptr;
+template <typename T> class shared_ptr;
+template <typename T> class weak_ptr;
+
+template <class T, class D>
+struct is_trivially_relocatable<mystl::unique_ptr<T, D>> : is_trivially_relocatable<D> {};
+
+template <class T>
+struct is_trivially_relocatable<mystl::shared_ptr<T>> : std::true_type {};
+
+template <class T>
+struct is_trivially_relocatable<mystl::weak_ptr<T>> : std::true_type {};
+
+/**
+ * @brief 分配器的 construct / destroy 是否只是就地构造和析构
+ *
+ * 只有这样，容器才能用 memcpy / memmove 代替逐个元素的 construct 和 destroy。
+ * polymorphic_allocator 的 construct 会传入自身的内存资源，对可平凡重定位的元素，
+ * 按字节搬动与传入同一资源的移动构造结果相同，因此也算在内
+ */
+template <class Alloc>
+struct is_plain_allocator : std::false_type {};
+
+template <class T>
+struct is_plain_allocator<std::allocator<T>> : std::true_type {};
+
+template <class T>
+struct is_plain_allocator<pmr::polymorphic_allocator<T>> : std::true_type {};
+
+/**
+ * @brief 按倍数增长的策略（默认）
+ *
+ * 容量不足时新容量为 max(旧容量 * Num / Den, 所需容量)，空容器至少分配 Min 个元素
+ *
+ * 增长策略是一个提供静态函数 next_capacity 的类型：
+ *   size_t next_capacity(size_t old_cap, size_t required, size_t elem_size);
+ * old_cap 为当前容量，required 为至少需要的容量，elem_size 为元素的字节数，
+ * 返回值小于 required 时按 required 处理，超过 max_size() 时截断为 max_size()
+ *
+ * @tparam Num 增长倍数的分子
+ * @tparam Den 增长倍数的分母
+ * @tparam Min 第一次分配的最少元素个数
+ */
+template <size_t Num = 3, size_t Den = 2, size_t Min = 16>
+struct vector_growth_factor {
+    static_assert(Num > Den && Den > 0, "增长倍数必须大于 1");
+
+    static size_t next_capacity(size_t old_cap, size_t required, size_t /*elem_size*/) {
+        if (old_cap == 0) {
+            return std::max(required, Min);
+        }
+        // 乘法溢出时直接取最大值，由 vector 截断为 max_size()
+        const size_t grown = old_cap > std::numeric_limits<size_t>::max() / Num
+                             ? std::numeric_limits<size_t>::max()
+                             : old_cap * Num / Den;
+        return std::max(grown, required);
+    }
+};
+
+/**
+ * @brief 按页取整的增长策略，适合很大的缓冲区
+ *
+ * 先按 Base 计算新容量，字节数不小于一页时向上取整为 PageSize 的整数倍。
+ * 大块内存由操作系统按页提供，取整后多出的部分本来就会被分配，不如直接用作容量
+ *
+ * @tparam Base 计算新容量的基础策略
+ * @tparam PageSize 页的字节数
+ */
+template <class Base = vector_growth_factor<>, size_t PageSize = 4096>
+struct vector_page_growth {
+    static size_t next_capacity(size_t old_cap, size_t required, size_t elem_size) {
+        const size_t cap = Base::next_capacity(old_cap, required, elem_size);
+        if (cap > (std::numeric_limits<size_t>::max() - PageSize) / elem_size) {
+            return cap;
+        }
+        const size_t bytes = cap * elem_size;
+        if (bytes < PageSize) {
+            return cap;
+        }
+        return (bytes + PageSize - 1) / PageSize * PageSize / elem_size;
+    }
+};
+
+/**
+ * @brief 用 malloc / realloc / free 管理内存的分配器
+ *
+ * 除了标准分配器的接口，还提供 reallocate：vector 的元素可平凡重定位时，扩容和 shrink_to_fit
+ * 改用 realloc 原地伸缩，不再"分配新空间、搬动全部元素、释放旧空间"。
+ * glibc 中大块内存（默认 128 KB 以上）由 mmap 直接分配，realloc 通过 mremap 修改页表来扩展，
+ * 不复制数据，扩容过程中也不需要同时持有新旧两块空间
+ */
+template <class T>
+struct realloc_allocator {
+    typedef T value_type;
+
+    realloc_allocator() noexcept {}
+    template <class U>
+    realloc_allocator(const realloc_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void* p = std::malloc(n * sizeof(T));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        std::free(p);
+    }
+
+    /**
+     * @brief 把 p 指向的 old_n 个元素的空间伸缩为 new_n 个元素，内容按字节保留
+     *
+     * 失败时抛出 std::bad_alloc，原空间不变。不内联：realloc 本身的开销远大于一次函数调用，
+     * 内联后 GCC 12 会把循环中下一次扩容对新指针的使用误报为 -Wuse-after-free
+     */
+    MYSTL_NOINLINE T* reallocate(T* p, size_t /*old_n*/, size_t new_n) {
+        if (new_n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void* q = std::realloc(static_cast<void*>(p), new_n * sizeof(T));
+        if (q == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(q);
+    }
+
+    template <class U>
+    struct rebind { typedef realloc_allocator<U> other; };
+};
+
+template <class T, class U>
+bool operator==(const realloc_allocator<T>&, const realloc_allocator<U>&) noexcept { return true; }
+
+template <class T, class U>
+bool operator!=(const realloc_allocator<T>&, const realloc_allocator<U>&) noexcept { return false; }
+
+template <class T>
+struct is_plain_allocator<realloc_allocator<T>> : std::true_type {};
+
+/**
+ * @brief 分配器是否提供 reallocate(p, old_n, new_n)
+ */
+template <class Alloc>
+class has_reallocate {
+    template <class A>
+    static auto test(int) -> decltype(std::declval<A&>().reallocate(
+        std::declval<typename A::value_type*>(), size_t(), size_t()), std::true_type());
+    template <class A>
+    static std::false_type test(...);
+
+public:
+    static constexpr bool value = decltype(test<Alloc>(0))::value;
+};
+
 /**
  * @brief vector容器类的实现
  * 
  * @tparam T 存储元素的类型
+ * @tparam Alloc 分配器类型，默认为 std::allocator<T>，支持有状态的分配器；
+ *               使用 realloc_allocator 且元素可平凡重定位时，扩容原地伸缩
+ * @tparam Growth 增长策略，默认为 1.5 倍增长、最少 16 个元素（vector_growth_factor<>）
  */
-template <class T>
-class vector {
+template <class T, class Alloc = std::allocator<T>, class Growth = vector_growth_factor<>>
+class vector
+    : private mystl::alloc_holder<typename std::allocator_traits<Alloc>::template rebind_alloc<T>> {
     // 禁用vector<bool>的特殊实现
     static_assert(!std::is_same<bool, T>::value, "vector<bool>在本实现中不被支持");
 
@@ -52,13 +262,18 @@ public:
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
     typedef size_t                              size_type;
     typedef ptrdiff_t                           difference_type;
-    typedef std::allocator<T>                   allocator_type;
-    typedef std::allocator<T>                   data_allocator;
+    typedef Alloc                               allocator_type;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T> data_allocator;
+    typedef std::allocator_traits<data_allocator> data_alloc_traits;
+    typedef Growth                              growth_policy;
 
 private:
-    iterator begin_;  // 使用空间的起始位置
-    iterator end_;    // 使用空间的结束位置（最后一个元素之后的位置）
-    iterator cap_;    // 存储空间的结束位置
+    typedef mystl::alloc_holder<data_allocator> alloc_base;  // 分配器，所有内存分配和元素构造都经过它
+    using alloc_base::get_alloc;
+
+    iterator       begin_;  // 使用空间的起始位置
+    iterator       end_;    // 使用空间的结束位置（最后一个元素之后的位置）
+    iterator       cap_;    // 存储空间的结束位置
 
 public:
     /**
@@ -66,7 +281,7 @@ public:
      * @return 返回分配器
      */
     allocator_type get_allocator() const noexcept { 
-        return data_allocator(); 
+        return allocator_type(get_alloc()); 
     }
 
     // 构造函数、析构函数和赋值运算符
@@ -74,18 +289,29 @@ public:
     /**
      * @brief 默认构造函数
      * 
-     * 创建一个空的vector
+     * 创建一个空的vector，不分配内存
+     */
+    vector() noexcept
+        : begin_(nullptr), end_(nullptr), cap_(nullptr) {
+    }
+
+    /**
+     * @brief 使用指定分配器构造空的vector
+     * 
+     * @param alloc 分配器
      */
-    vector() noexcept {
-        try_init();
+    explicit vector(const allocator_type& alloc) noexcept
+        : alloc_base(alloc), begin_(nullptr), end_(nullptr), cap_(nullptr) {
     }
 
     /**
      * @brief 指定大小的构造函数
      * 
      * @param n 元素个数
+     * @param alloc 分配器
      */
-    explicit vector(size_type n) {
+    explicit vector(size_type n, const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc) {
         fill_init(n, value_type());
     }
 
@@ -94,8 +320,10 @@ public:
      * 
      * @param n 元素个数
      * @param value 初始值
+     * @param alloc 分配器
      */
-    vector(size_type n, const value_type& value) {
+    vector(size_type n, const value_type& value, const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc) {
         fill_init(n, value);
     }
 
@@ -105,20 +333,36 @@ public:
      * @tparam Iter 迭代器类型
      * @param first 起始迭代器
      * @param last 终止迭代器
+     * @param alloc 分配器
      */
     template <class Iter, typename std::enable_if<
         std::is_convertible<typename std::iterator_traits<Iter>::iterator_category, 
         std::input_iterator_tag>::value, int>::type = 0>
-    vector(Iter first, Iter last) {
-        range_init(first, last);
+    vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc) {
+        range_init(first, last, typename std::iterator_traits<Iter>::iterator_category());
     }
 
     /**
      * @brief 拷贝构造函数
      * 
+     * 分配器由 select_on_container_copy_construction 决定
+     * 
+     * @param rhs 源vector
+     */
+    vector(const vector& rhs)
+        : alloc_base(data_alloc_traits::select_on_container_copy_construction(rhs.get_alloc())) {
+        range_init(rhs.begin_, rhs.end_);
+    }
+
+    /**
+     * @brief 带分配器的拷贝构造函数
+     * 
      * @param rhs 源vector
+     * @param alloc 分配器
      */
-    vector(const vector& rhs) {
+    vector(const vector& rhs, const allocator_type& alloc)
+        : alloc_base(alloc) {
         range_init(rhs.begin_, rhs.end_);
     }
 
@@ -128,18 +372,42 @@ public:
      * @param rhs 源vector
      */
     vector(vector&& rhs) noexcept
-        :begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
+        : alloc_base(std::move(rhs.get_alloc())), begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_) {
         rhs.begin_ = nullptr;
         rhs.end_ = nullptr;
         rhs.cap_ = nullptr;
     }
 
+    /**
+     * @brief 带分配器的移动构造函数
+     * 
+     * 分配器与 rhs 相等时直接接管 rhs 的空间，否则逐个移动元素
+     * 
+     * @param rhs 源vector
+     * @param alloc 分配器
+     */
+    vector(vector&& rhs, const allocator_type& alloc)
+        : alloc_base(alloc) {
+        if (get_alloc() == rhs.get_alloc()) {
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            cap_ = rhs.cap_;
+            rhs.begin_ = nullptr;
+            rhs.end_ = nullptr;
+            rhs.cap_ = nullptr;
+        } else {
+            range_init(std::make_move_iterator(rhs.begin_), std::make_move_iterator(rhs.end_));
+        }
+    }
+
     /**
      * @brief 初始化列表构造函数
      * 
      * @param ilist 初始化列表
+     * @param alloc 分配器
      */
-    vector(std::initializer_list<value_type> ilist) {
+    vector(std::initializer_list<value_type> ilist, const allocator_type& alloc = allocator_type())
+        : alloc_base(alloc) {
         range_init(ilist.begin(), ilist.end());
     }
 
@@ -165,7 +433,8 @@ public:
      * @param rhs 源vector
      * @return 返回自身引用
      */
-    vector& operator=(vector&& rhs) noexcept;
+    vector& operator=(vector&& rhs)
+        noexcept(data_alloc_traits::propagate_on_container_move_assignment::value);
 
     /**
      * @brief 初始化列表赋值运算符
@@ -174,7 +443,7 @@ public:
      * @return 返回自身引用
      */
     vector& operator=(std::initializer_list<value_type> ilist) {
-        vector tmp(ilist.begin(), ilist.end());
+        vector tmp(ilist.begin(), ilist.end(), get_alloc());
         swap(tmp);
         return *this;
     }
@@ -300,7 +569,7 @@ public:
      * @return 最大元素数量
      */
     size_type max_size() const noexcept { 
-        return static_cast<size_type>(-1) / sizeof(T); 
+        return data_alloc_traits::max_size(get_alloc()); 
     }
 
     /**
@@ -318,7 +587,7 @@ public:
     void reserve(size_type n);
 
     /**
-     * @brief 收缩容器存储空间以适应实际元素数量
+     * @brief 收缩容器存储空间以适应实际元素数量，没有元素时释放全部内存
      */
     void shrink_to_fit();
 
@@ -539,11 +808,15 @@ public:
      * @param pos 指定位置
      * @param first 起始迭代器
      * @param last 终止迭代器
+     * @return 指向第一个新元素的迭代器，范围为空时返回pos
      */
     template <class Iter, typename std::enable_if<
         std::is_convertible<typename std::iterator_traits<Iter>::iterator_category, 
         std::input_iterator_tag>::value, int>::type = 0>
-    void insert(const_iterator pos, Iter first, Iter last);
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        return copy_insert(const_cast<iterator>(pos), first, last,
+                           typename std::iterator_traits<Iter>::iterator_category());
+    }
 
     /**
      * @brief 在指定位置插入初始化列表中的元素
@@ -597,6 +870,29 @@ public:
      */
     void resize(size_type new_size, const value_type& value);
 
+    /**
+     * @brief 调整容器大小，新增的元素默认初始化
+     * 
+     * 元素可平凡默认构造（int、char、POD 结构体）且分配器不自定义 construct 时，新增的元素不初始化，
+     * 适合随后立即被 read、memcpy 覆盖的缓冲区；其他情况与 resize(new_size) 相同
+     * 
+     * @param new_size 新的大小
+     */
+    void resize_default_init(size_type new_size);
+
+    /**
+     * @brief 把大小调整为 n，由 op 写入内容后再确定最终大小
+     * 
+     * 调用 op(data(), n)，原有的前 min(size(), n) 个元素保留，之后的元素未初始化；
+     * op 返回实际写入后的大小 r（r <= n），容器大小设为 r。op 抛出异常时大小恢复为 min(size(), n)
+     * 
+     * @param n 调用 op 时的大小
+     * @param op 写入元素的函数，只能用于平凡类型
+     * @throw std::length_error 如果 op 的返回值大于 n
+     */
+    template <class Operation>
+    void resize_and_overwrite(size_type n, Operation op);
+
     /**
      * @brief 反转容器中的元素顺序
      */
@@ -611,13 +907,42 @@ public:
      */
     void swap(vector& rhs) noexcept;
 
-private:
-    // 辅助函数
-
+protected:
     /**
-     * @brief 尝试初始化vector
+     * @brief 销毁当前元素并释放空间，再接管 rhs 的空间，不交换分配器
+     * 
+     * 只能在 rhs 的空间可以由本容器的分配器释放时调用。small_vector 用它接管堆上的空间
+     * 
+     * @param rhs 源vector，之后为空且不持有内存
      */
-    void try_init() noexcept;
+    void take_storage(vector& rhs) noexcept {
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        begin_ = rhs.begin_;
+        end_ = rhs.end_;
+        cap_ = rhs.cap_;
+        rhs.begin_ = nullptr;
+        rhs.end_ = nullptr;
+        rhs.cap_ = nullptr;
+    }
+
+private:
+    // 元素可以按字节整块搬动：扩容、插入时挪动元素、删除后补位都用 memcpy / memmove，原位置不再析构
+    typedef std::integral_constant<bool, is_trivially_relocatable<T>::value &&
+                                         is_plain_allocator<data_allocator>::value> relocatable;
+
+    // 元素可以按字节复制：从同类型的连续区间复制构造时用 memcpy
+    typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                         is_plain_allocator<data_allocator>::value> bitwise_copyable;
+
+    // 扩容可以原地伸缩：元素可平凡重定位，且分配器提供 reallocate
+    typedef std::integral_constant<bool, relocatable::value &&
+                                         has_reallocate<data_allocator>::value> reallocatable;
+
+    // 新增的元素可以不初始化：元素可平凡默认构造，且分配器的 construct 不做额外的事
+    typedef std::integral_constant<bool, std::is_trivially_default_constructible<T>::value &&
+                                         is_plain_allocator<data_allocator>::value> default_init_skippable;
+
+    // 辅助函数
 
     /**
      * @brief 初始化指定大小的空间
@@ -645,6 +970,22 @@ private:
     template <class Iter>
     void range_init(Iter first, Iter last);
 
+    /**
+     * @brief 使用迭代器范围初始化（输入迭代器版本）
+     * 
+     * 元素个数事先未知，逐个追加
+     */
+    template <class IIter>
+    void range_init(IIter first, IIter last, std::input_iterator_tag);
+
+    /**
+     * @brief 使用迭代器范围初始化（前向迭代器版本）
+     */
+    template <class FIter>
+    void range_init(FIter first, FIter last, std::forward_iterator_tag) {
+        range_init(first, last);
+    }
+
     /**
      * @brief 销毁元素并回收内存
      * 
@@ -655,13 +996,114 @@ private:
     void destroy_and_recover(iterator first, iterator last, size_type n);
 
     /**
-     * @brief 计算新的容量
+     * @brief 通过分配器把 [first, last) 复制构造到 result 开始的未初始化空间
+     * 
+     * 构造过程中抛出异常时，已构造的元素会被析构
+     * 
+     * @return 最后一个构造的元素之后的位置
+     */
+    template <class Iter>
+    iterator uninitialized_copy_a(Iter first, Iter last, iterator result) {
+        return uninitialized_copy_aux(first, last, result,
+            std::integral_constant<bool, bitwise_copyable::value &&
+                                         (std::is_same<Iter, pointer>::value ||
+                                          std::is_same<Iter, const_pointer>::value)>());
+    }
+
+    /**
+     * @brief 逐个元素复制构造
+     */
+    template <class Iter>
+    iterator uninitialized_copy_aux(Iter first, Iter last, iterator result, std::false_type);
+
+    /**
+     * @brief 从同类型的连续区间按字节复制，元素可平凡复制时使用
+     */
+    iterator uninitialized_copy_aux(const_iterator first, const_iterator last, iterator result, std::true_type) {
+        copy_bytes(result, first, last - first);
+        return result + (last - first);
+    }
+
+    /**
+     * @brief 通过分配器把 [first, last) 移动构造到 result 开始的未初始化空间
+     */
+    iterator uninitialized_move_a(iterator first, iterator last, iterator result) {
+        return bitwise_copyable::value
+               ? uninitialized_copy_aux(first, last, result, std::true_type())
+               : uninitialized_copy_a(std::make_move_iterator(first), std::make_move_iterator(last), result);
+    }
+
+    /**
+     * @brief 按字节把 n 个元素从 src 复制到 dst，两段内存不能重叠
+     */
+    static void copy_bytes(iterator dst, const_iterator src, size_type n) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief 按字节把 n 个元素从 src 搬到 dst，两段内存可以重叠
+     */
+    static void move_bytes(iterator dst, const_iterator src, size_type n) {
+        if (n != 0) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        }
+    }
+
+    /**
+     * @brief 重新分配容量为 new_cap 的空间，在与 pos 对应的位置留出 n 个元素的空位
+     * 
+     * 先由 fill(空位起点) 构造新元素，再把原有元素搬到空位两侧：新元素的构造参数引用容器内的元素时仍然有效。
+     * 元素可平凡重定位时整块 memcpy，旧空间直接释放，不再逐个析构。
+     * fill 抛出异常时需自行析构已构造的部分，此时容器保持不变
+     * 
+     * @param new_cap 新容量
+     * @param pos 空位在原容器中的位置
+     * @param n 空位的元素个数
+     * @param fill 在空位中构造 n 个新元素的函数
+     */
+    template <class Fill>
+    void reallocate_with_gap(size_type new_cap, iterator pos, size_type n, Fill fill);
+
+    /**
+     * @brief 容量足够时在 pos 处留出 n 个元素的空位并由 fill 构造新元素，只用于可平凡重定位的元素
+     * 
+     * 先用 memmove 把 [pos, end) 整体后移 n 个位置，fill 抛出异常时再移回原处
+     */
+    template <class Fill>
+    void fill_gap_relocate(iterator pos, size_type n, Fill fill);
+
+    /**
+     * @brief 容量足够时在 xpos 处（不在尾部）构造一个新元素，其后的元素后移一位
+     */
+    template <class... Args>
+    void emplace_shift(iterator xpos, Args&&... args);
+
+    /**
+     * @brief 通过分配器在 first 开始的未初始化空间构造 n 个 value
+     */
+    iterator uninitialized_fill_n_a(iterator first, size_type n, const value_type& value);
+
+    /**
+     * @brief 按增长策略计算新的容量
      * 
      * @param add_size 要添加的元素数量
-     * @return 新的容量
+     * @return 新的容量，不小于 capacity() + add_size，不超过 max_size()
      */
     size_type get_new_cap(size_type add_size);
 
+    /**
+     * @brief 分配器的 reallocate，只在 reallocatable 为 true 时调用
+     */
+    pointer reallocate_storage(size_type new_cap, std::true_type) {
+        return get_alloc().reallocate(begin_, cap_ - begin_, new_cap);
+    }
+
+    pointer reallocate_storage(size_type, std::false_type) {
+        return nullptr;
+    }
+
     /**
      * @brief 填充赋值
      * 
@@ -719,15 +1161,32 @@ private:
     iterator fill_insert(iterator pos, size_type n, const value_type& value);
 
     /**
-     * @brief 在指定位置复制插入元素
+     * @brief 在指定位置复制插入元素（输入迭代器版本）
+     * 
+     * 元素个数事先未知：逐个追加到末尾，再整体旋转到pos处
      * 
      * @tparam IIter 输入迭代器类型
      * @param pos 指定位置
      * @param first 起始迭代器
      * @param last 终止迭代器
+     * @return 指向第一个新元素的迭代器
      */
     template <class IIter>
-    void copy_insert(iterator pos, IIter first, IIter last);
+    iterator copy_insert(iterator pos, IIter first, IIter last, std::input_iterator_tag);
+
+    /**
+     * @brief 在指定位置复制插入元素（前向迭代器版本）
+     * 
+     * 只计算一次元素个数，最多重新分配一次，pos之后的元素只整体后移一次
+     * 
+     * @tparam FIter 前向迭代器类型
+     * @param pos 指定位置
+     * @param first 起始迭代器
+     * @param last 终止迭代器
+     * @return 指向第一个新元素的迭代器
+     */
+    template <class FIter>
+    iterator copy_insert(iterator pos, FIter first, FIter last, std::forward_iterator_tag);
 
     /**
      * @brief 重新插入元素（用于shrink_to_fit）
@@ -738,54 +1197,62 @@ private:
 };
 
 // 重载比较操作符
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs);
 
 // 重载swap
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs);
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs);
 
 /******************************************************************************************
  * vector 成员函数实现
  ******************************************************************************************/
 
 // 拷贝赋值运算符
-template <class T>
-vector<T>& vector<T>::operator=(const vector& rhs) {
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(const vector& rhs) {
     if (this != &rhs) {
+        if (data_alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (get_alloc() != rhs.get_alloc()) {
+                // 旧空间必须由旧分配器释放
+                destroy_and_recover(begin_, end_, cap_ - begin_);
+                begin_ = end_ = cap_ = nullptr;
+            }
+            get_alloc() = rhs.get_alloc();
+        }
         const auto len = rhs.size();
         if (len > capacity()) {
             // 如果容量不足，创建新的vector并交换
-            vector tmp(rhs.begin(), rhs.end());
+            vector tmp(rhs.begin(), rhs.end(), get_alloc());
             swap(tmp);
         } else if (size() >= len) {
             // 如果当前元素数量够用，只需拷贝并析构多余元素
             auto i = std::copy(rhs.begin(), rhs.end(), begin());
             // 析构多余的元素
             for (auto p = i; p != end_; ++p) {
-                p->~T();
+                data_alloc_traits::destroy(get_alloc(), p);
             }
             end_ = begin_ + len;
         } else {
             // 先拷贝已有空间内的元素
             std::copy(rhs.begin(), rhs.begin() + size(), begin_);
             // 再构造剩余元素
-            std::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
+            uninitialized_copy_a(rhs.begin() + size(), rhs.end(), end_);
             end_ = begin_ + len;
         }
     }
@@ -793,57 +1260,46 @@ vector<T>& vector<T>::operator=(const vector& rhs) {
 }
 
 // 移动赋值运算符
-template <class T>
-vector<T>& vector<T>::operator=(vector&& rhs) noexcept {
-    // 销毁当前元素并释放内存
+template <class T, class Alloc, class Growth>
+vector<T, Alloc, Growth>& vector<T, Alloc, Growth>::operator=(vector&& rhs)
+    noexcept(data_alloc_traits::propagate_on_container_move_assignment::value) {
+    if (this == &rhs) {
+        return *this;
+    }
+    if (!data_alloc_traits::propagate_on_container_move_assignment::value && get_alloc() != rhs.get_alloc()) {
+        // 分配器不传播且不相等，不能接管rhs的空间，只能逐个移动元素
+        assign(std::make_move_iterator(rhs.begin_), std::make_move_iterator(rhs.end_));
+        rhs.clear();
+        return *this;
+    }
+    // 旧空间必须在替换分配器之前由旧分配器释放
     destroy_and_recover(begin_, end_, cap_ - begin_);
-    // 窃取rhs资源
-    begin_ = rhs.begin_;
-    end_ = rhs.end_;
-    cap_ = rhs.cap_;
-    // 将rhs置于可析构状态
-    rhs.begin_ = nullptr;
-    rhs.end_ = nullptr;
-    rhs.cap_ = nullptr;
+    begin_ = end_ = cap_ = nullptr;
+    if (data_alloc_traits::propagate_on_container_move_assignment::value) {
+        get_alloc() = std::move(rhs.get_alloc());
+    }
+    // 窃取rhs资源，rhs之后不持有内存
+    take_storage(rhs);
     return *this;
 }
 
 // 预留存储空间
-template <class T>
-void vector<T>::reserve(size_type n) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reserve(size_type n) {
     // 只有当要求的容量大于当前容量时才重新分配
     if (capacity() < n) {
         // 检查是否超出最大容量
         if (n > max_size()) {
             throw std::length_error("vector::reserve - n超出了最大容量");
         }
-        // 保存旧大小，用于之后的元素拷贝
-        const auto old_size = size();
-        // 分配新内存
-        auto tmp = data_allocator().allocate(n);
-        
-        // 移动现有元素到新内存
-        try {
-            mystl::uninitialized_move(begin_, end_, tmp);
-        } catch (...) {
-            // 分配失败时释放新分配的内存
-            data_allocator().deallocate(tmp, n);
-            throw;
-        }
-        
-        // 销毁旧元素并释放旧内存
-        destroy_and_recover(begin_, end_, cap_ - begin_);
-        
-        // 更新指针
-        begin_ = tmp;
-        end_ = tmp + old_size;
-        cap_ = begin_ + n;
+        // 把现有元素搬到新内存，不留空位
+        reallocate_with_gap(n, end_, 0, [](iterator) {});
     }
 }
 
 // 收缩容器存储空间
-template <class T>
-void vector<T>::shrink_to_fit() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::shrink_to_fit() {
     // 只有当有多余空间时才进行收缩
     if (end_ < cap_) {
         reinsert(size());
@@ -852,27 +1308,11 @@ void vector<T>::shrink_to_fit() {
 
 // helper functions
 
-// try_init函数：尝试初始化一个默认大小的vector
-template <class T>
-void vector<T>::try_init() noexcept {
-    try {
-        // 默认分配16个元素的空间
-        begin_ = data_allocator().allocate(16);
-        end_ = begin_;
-        cap_ = begin_ + 16;
-    } catch (...) {
-        // 如果分配失败，将指针设为nullptr
-        begin_ = nullptr;
-        end_ = nullptr;
-        cap_ = nullptr;
-    }
-}
-
 // init_space函数：初始化指定大小的空间
-template <class T>
-void vector<T>::init_space(size_type size, size_type cap) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::init_space(size_type size, size_type cap) {
     try {
-        begin_ = data_allocator().allocate(cap);
+        begin_ = data_alloc_traits::allocate(get_alloc(), cap);
         end_ = begin_ + size;
         cap_ = begin_ + cap;
     } catch (...) {
@@ -884,44 +1324,122 @@ void vector<T>::init_space(size_type size, size_type cap) {
 }
 
 // fill_init函数：用指定值填充初始化
-template <class T>
-void vector<T>::fill_init(size_type n, const value_type& value) {
-    // 选择初始容量，至少为16或n的较大者
-    const size_type init_size = std::max(static_cast<size_type>(16), n);
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_init(size_type n, const value_type& value) {
+    // 空容器不分配内存
+    if (n == 0) {
+        begin_ = end_ = cap_ = nullptr;
+        return;
+    }
+    // 初始容量由增长策略决定，默认至少为16或n的较大者
+    const size_type init_size = std::max(n, Growth::next_capacity(0, n, sizeof(T)));
     init_space(n, init_size);
     // 使用value填充n个元素
-    std::uninitialized_fill_n(begin_, n, value);
+    try {
+        uninitialized_fill_n_a(begin_, n, value);
+    } catch (...) {
+        // 元素构造失败时析构函数不会执行，需要在这里释放空间
+        data_alloc_traits::deallocate(get_alloc(), begin_, init_size);
+        begin_ = end_ = cap_ = nullptr;
+        throw;
+    }
+}
+
+// range_init函数（输入迭代器版本）：逐个追加，按增长策略扩容
+template <class T, class Alloc, class Growth>
+template <class IIter>
+void vector<T, Alloc, Growth>::range_init(IIter first, IIter last, std::input_iterator_tag) {
+    begin_ = end_ = cap_ = nullptr;
+    try {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } catch (...) {
+        // 元素构造失败时析构函数不会执行，需要在这里释放空间
+        destroy_and_recover(begin_, end_, capacity());
+        begin_ = end_ = cap_ = nullptr;
+        throw;
+    }
 }
 
 // range_init函数：使用迭代器范围初始化
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class Iter>
-void vector<T>::range_init(Iter first, Iter last) {
+void vector<T, Alloc, Growth>::range_init(Iter first, Iter last) {
     // 计算元素数量
     const size_type len = std::distance(first, last);
-    // 选择初始容量，至少为16或len的较大者
-    const size_type init_size = std::max(len, static_cast<size_type>(16));
+    // 空容器不分配内存
+    if (len == 0) {
+        begin_ = end_ = cap_ = nullptr;
+        return;
+    }
+    // 初始容量由增长策略决定，默认至少为16或len的较大者
+    const size_type init_size = std::max(len, Growth::next_capacity(0, len, sizeof(T)));
     init_space(len, init_size);
     // 复制元素
-    std::uninitialized_copy(first, last, begin_);
+    try {
+        uninitialized_copy_a(first, last, begin_);
+    } catch (...) {
+        // 元素构造失败时析构函数不会执行，需要在这里释放空间
+        data_alloc_traits::deallocate(get_alloc(), begin_, init_size);
+        begin_ = end_ = cap_ = nullptr;
+        throw;
+    }
 }
 
 // destroy_and_recover函数：销毁元素并回收内存
-template <class T>
-void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::destroy_and_recover(iterator first, iterator last, size_type n) {
     // 析构元素
     for (auto p = first; p != last; ++p) {
-        p->~T();
+        data_alloc_traits::destroy(get_alloc(), p);
     }
     // 释放内存
     if (first) {
-        data_allocator().deallocate(first, n);
+        data_alloc_traits::deallocate(get_alloc(), first, n);
+    }
+}
+
+// uninitialized_copy_aux函数：通过分配器逐个复制构造一段元素
+template <class T, class Alloc, class Growth>
+template <class Iter>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::uninitialized_copy_aux(Iter first, Iter last, iterator result, std::false_type) {
+    auto cur = result;
+    try {
+        for (; first != last; ++first, ++cur) {
+            data_alloc_traits::construct(get_alloc(), cur, *first);
+        }
+    } catch (...) {
+        for (; result != cur; ++result) {
+            data_alloc_traits::destroy(get_alloc(), result);
+        }
+        throw;
+    }
+    return cur;
+}
+
+// uninitialized_fill_n_a函数：通过分配器构造n个相同的元素
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::uninitialized_fill_n_a(iterator first, size_type n, const value_type& value) {
+    auto cur = first;
+    try {
+        for (; n > 0; --n, ++cur) {
+            data_alloc_traits::construct(get_alloc(), cur, value);
+        }
+    } catch (...) {
+        for (; first != cur; ++first) {
+            data_alloc_traits::destroy(get_alloc(), first);
+        }
+        throw;
     }
+    return cur;
 }
 
 // get_new_cap函数：计算新的容量
-template <class T>
-typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::size_type vector<T, Alloc, Growth>::get_new_cap(size_type add_size) {
     const auto old_size = capacity();
     
     // 检查是否超出最大容量
@@ -929,34 +1447,24 @@ typename vector<T>::size_type vector<T>::get_new_cap(size_type add_size) {
         throw std::length_error("vector::get_new_cap - 新容量超出了最大容量");
     }
     
-    // 如果当前容量过大，增长较小以避免溢出
-    if (old_size > max_size() - old_size / 2) {
-        return old_size + add_size > max_size() - 16
-               ? old_size + add_size 
-               : old_size + add_size + 16;
-    }
-    
-    // 正常情况下，新容量为旧容量的1.5倍或者旧容量+add_size的较大者
-    // 如果是空容器，则最小分配16个元素的空间
-    const size_type new_size = old_size == 0
-                               ? std::max(add_size, static_cast<size_type>(16))
-                               : std::max(old_size + old_size / 2, old_size + add_size);
-    
-    return new_size;
+    // 由增长策略给出新容量，再限制在 [所需容量, max_size()] 之内
+    const size_type required = old_size + add_size;
+    const size_type new_size = Growth::next_capacity(old_size, required, sizeof(T));
+    return std::min(std::max(new_size, required), max_size());
 }
 
 // fill_assign函数：填充赋值
-template <class T>
-void vector<T>::fill_assign(size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::fill_assign(size_type n, const value_type& value) {
     if (n > capacity()) {
         // 如果需要更大的容量，创建一个新的vector并交换
-        vector tmp(n, value);
+        vector tmp(n, value, get_alloc());
         swap(tmp);
     } else if (n > size()) {
         // 如果需要更多元素，先填充已有元素
         std::fill(begin(), end(), value);
         // 再在末尾添加新元素
-        end_ = std::uninitialized_fill_n(end_, n - size(), value);
+        end_ = uninitialized_fill_n_a(end_, n - size(), value);
     } else {
         // 如果需要更少元素，填充n个元素后删除多余的
         erase(std::fill_n(begin_, n, value), end_);
@@ -964,9 +1472,9 @@ void vector<T>::fill_assign(size_type n, const value_type& value) {
 }
 
 // copy_assign函数（输入迭代器版本）
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class IIter>
-void vector<T>::copy_assign(IIter first, IIter last, std::input_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(IIter first, IIter last, std::input_iterator_tag) {
     auto cur = begin_;
     // 先复制到现有空间
     for (; first != last && cur != end_; ++first, ++cur) {
@@ -983,20 +1491,20 @@ void vector<T>::copy_assign(IIter first, IIter last, std::input_iterator_tag) {
 }
 
 // copy_assign函数（前向迭代器版本）
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class FIter>
-void vector<T>::copy_assign(FIter first, FIter last, std::forward_iterator_tag) {
+void vector<T, Alloc, Growth>::copy_assign(FIter first, FIter last, std::forward_iterator_tag) {
     const size_type len = std::distance(first, last);
     
     if (len > capacity()) {
         // 如果需要更大的容量，创建一个新的vector并交换
-        vector tmp(first, last);
+        vector tmp(first, last, get_alloc());
         swap(tmp);
     } else if (size() >= len) {
         // 如果当前大小足够，直接复制并销毁多余元素
         auto new_end = std::copy(first, last, begin_);
         for (auto p = new_end; p != end_; ++p) {
-            p->~T();
+            data_alloc_traits::destroy(get_alloc(), p);
         }
         end_ = new_end;
     } else {
@@ -1005,107 +1513,166 @@ void vector<T>::copy_assign(FIter first, FIter last, std::forward_iterator_tag)
         std::advance(mid, size());
         std::copy(first, mid, begin_);
         // 再构造剩余元素
-        end_ = std::uninitialized_copy(mid, last, end_);
+        end_ = uninitialized_copy_a(mid, last, end_);
     }
 }
 
 // reallocate_emplace函数：重新分配空间并在指定位置就地构造元素
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::reallocate_emplace(iterator pos, Args&&... args) {
-    // 获取新的容量
-    const auto new_size = get_new_cap(1);
-    // 分配新内存
-    auto new_begin = data_allocator().allocate(new_size);
-    auto new_end = new_begin;
-    
+void vector<T, Alloc, Growth>::reallocate_emplace(iterator pos, Args&&... args) {
+    const size_type new_cap = get_new_cap(1);
+    if (reallocatable::value && begin_) {
+        // 原地伸缩会让 args 引用的元素失效：先在栈上的缓冲区构造新元素，伸缩后再按字节放进空位
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type tmp;
+        pointer value = reinterpret_cast<pointer>(&tmp);
+        data_alloc_traits::construct(get_alloc(), value, std::forward<Args>(args)...);
+        try {
+            reallocate_with_gap(new_cap, pos, 1, [value](iterator p) {
+                std::memcpy(static_cast<void*>(p), static_cast<const void*>(value), sizeof(T));
+            });
+        } catch (...) {
+            data_alloc_traits::destroy(get_alloc(), value);
+            throw;
+        }
+        return;
+    }
+    // 新元素先于原有元素构造，args 引用容器内的元素时仍然有效
+    reallocate_with_gap(new_cap, pos, 1, [&](iterator p) {
+        data_alloc_traits::construct(get_alloc(), p, std::forward<Args>(args)...);
+    });
+}
+
+// reallocate_insert函数：重新分配空间并在指定位置插入元素
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reallocate_insert(iterator pos, const value_type& value) {
+    reallocate_emplace(pos, value);
+}
+
+// reallocate_with_gap函数：重新分配空间，在pos对应的位置留出n个空位并构造新元素
+template <class T, class Alloc, class Growth>
+template <class Fill>
+void vector<T, Alloc, Growth>::reallocate_with_gap(size_type new_cap, iterator pos, size_type n, Fill fill) {
+    const size_type before = pos - begin_;
+    const size_type after = end_ - pos;
+
+    if (reallocatable::value && begin_) {
+        // 原地伸缩：分配器按字节保留原有元素，失败时抛出异常且原空间不变
+        const pointer new_begin = reallocate_storage(new_cap, reallocatable());
+        begin_ = new_begin;
+        end_ = new_begin + before + after;
+        cap_ = new_begin + new_cap;
+        if (n != 0) {
+            fill_gap_relocate(new_begin + before, n, fill);
+        }
+        return;
+    }
+
+    auto new_begin = data_alloc_traits::allocate(get_alloc(), new_cap);
+    auto gap = new_begin + before;
+
+    // 先构造空位中的新元素
     try {
-        // 将pos之前的元素移动到新内存
-        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-        // 在pos位置构造新元素
-        data_allocator().construct(new_end, std::forward<Args>(args)...);
-        ++new_end;
-        // 将pos之后的元素移动到新内存
-        new_end = mystl::uninitialized_move(pos, end_, new_end);
+        fill(gap);
     } catch (...) {
-        // 如果发生异常，销毁已构造的新元素并释放新内存
-        for (auto p = new_begin; p != new_end; ++p) {
-            p->~T();
-        }
-        data_allocator().deallocate(new_begin, new_size);
+        data_alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
         throw;
     }
-    
-    // 销毁旧元素并释放旧内存
-    destroy_and_recover(begin_, end_, cap_ - begin_);
-    
+
+    if (relocatable::value) {
+        // 整块搬动，旧空间中的元素视为已经移走，只释放内存
+        copy_bytes(new_begin, begin_, before);
+        copy_bytes(gap + n, pos, after);
+        if (begin_) {
+            data_alloc_traits::deallocate(get_alloc(), begin_, cap_ - begin_);
+        }
+    } else {
+        // 逐个移动构造到空位两侧
+        bool front_moved = false;
+        try {
+            uninitialized_move_a(begin_, pos, new_begin);
+            front_moved = true;
+            uninitialized_move_a(pos, end_, gap + n);
+        } catch (...) {
+            // 如果发生异常，销毁已构造的新元素并释放新内存
+            if (front_moved) {
+                for (auto p = new_begin; p != gap; ++p) {
+                    data_alloc_traits::destroy(get_alloc(), p);
+                }
+            }
+            for (auto p = gap; p != gap + n; ++p) {
+                data_alloc_traits::destroy(get_alloc(), p);
+            }
+            data_alloc_traits::deallocate(get_alloc(), new_begin, new_cap);
+            throw;
+        }
+        // 销毁旧元素并释放旧内存
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+    }
+
     // 更新指针
     begin_ = new_begin;
-    end_ = new_end;
-    cap_ = new_begin + new_size;
+    end_ = gap + n + after;
+    cap_ = new_begin + new_cap;
 }
 
-// reallocate_insert函数：重新分配空间并在指定位置插入元素
-template <class T>
-void vector<T>::reallocate_insert(iterator pos, const value_type& value) {
-    // 获取新的容量
-    const auto new_size = get_new_cap(1);
-    // 分配新内存
-    auto new_begin = data_allocator().allocate(new_size);
-    auto new_end = new_begin;
-    
-    // 创建value的拷贝，避免原值因为移动操作而被修改
-    const value_type value_copy = value;
-    
+// fill_gap_relocate函数：容量足够时整块后移[pos, end_)，在空出的位置构造新元素
+template <class T, class Alloc, class Growth>
+template <class Fill>
+void vector<T, Alloc, Growth>::fill_gap_relocate(iterator pos, size_type n, Fill fill) {
+    const size_type after = end_ - pos;
+    move_bytes(pos + n, pos, after);
     try {
-        // 将pos之前的元素移动到新内存
-        new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-        // 在pos位置构造新元素
-        data_allocator().construct(new_end, value_copy);
-        ++new_end;
-        // 将pos之后的元素移动到新内存
-        new_end = mystl::uninitialized_move(pos, end_, new_end);
+        fill(pos);
     } catch (...) {
-        // 如果发生异常，销毁已构造的新元素并释放新内存
-        for (auto p = new_begin; p != new_end; ++p) {
-            p->~T();
-        }
-        data_allocator().deallocate(new_begin, new_size);
+        // 新元素构造失败，把后移的元素挪回原处
+        move_bytes(pos, pos + n, after);
         throw;
     }
-    
-    // 销毁旧元素并释放旧内存
-    destroy_and_recover(begin_, end_, cap_ - begin_);
-    
-    // 更新指针
-    begin_ = new_begin;
-    end_ = new_end;
-    cap_ = new_begin + new_size;
+    end_ += n;
+}
+
+// emplace_shift函数：容量足够时在xpos处构造新元素，其后的元素后移一位
+template <class T, class Alloc, class Growth>
+template <class... Args>
+void vector<T, Alloc, Growth>::emplace_shift(iterator xpos, Args&&... args) {
+    if (relocatable::value) {
+        // 先在尾部的空位构造新元素（args 可能引用容器内的元素），再整块后移[xpos, end_)，
+        // 最后把新元素的字节放进空出的位置；构造之后的步骤都不会抛出异常
+        data_alloc_traits::construct(get_alloc(), end_, std::forward<Args>(args)...);
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type tmp;
+        std::memcpy(&tmp, static_cast<const void*>(end_), sizeof(T));
+        move_bytes(xpos + 1, xpos, end_ - xpos);
+        std::memcpy(static_cast<void*>(xpos), &tmp, sizeof(T));
+        ++end_;
+    } else {
+        // 先构造出新元素，args 可能引用即将被移动的元素
+        value_type tmp(std::forward<Args>(args)...);
+        // 将最后一个元素移动到未初始化内存
+        data_alloc_traits::construct(get_alloc(), end_, std::move(*(end_ - 1)));
+        ++end_;
+        // 将[xpos, end_-2)范围内的元素向后移动一个位置
+        std::move_backward(xpos, end_ - 2, end_ - 1);
+        // 在空出的位置赋值
+        *xpos = std::move(tmp);
+    }
 }
 
 // emplace函数：在指定位置就地构造元素
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-typename vector<T>::iterator vector<T>::emplace(const_iterator pos, Args&&... args) {
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::emplace(const_iterator pos, Args&&... args) {
     // 计算pos位置相对于begin_的偏移量
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = xpos - begin_;
     
     if (end_ != cap_ && xpos == end_) {
         // 如果是在尾部插入且有足够空间，直接构造
-        data_allocator().construct(end_, std::forward<Args>(args)...);
+        data_alloc_traits::construct(get_alloc(), end_, std::forward<Args>(args)...);
         ++end_;
     } else if (end_ != cap_) {
-        // 如果有足够空间但不是在尾部插入
-        // 先保存end_的值
-        auto old_end = end_;
-        // 将最后一个元素复制到未初始化内存
-        data_allocator().construct(end_, *(end_ - 1));
-        ++end_;
-        // 将[xpos, old_end-1)范围内的元素向后移动一个位置
-        std::move_backward(xpos, old_end - 1, old_end);
-        // 在空出的位置构造新元素
-        *xpos = value_type(std::forward<Args>(args)...);
+        // 如果有足够空间但不是在尾部插入，其后的元素后移一位
+        emplace_shift(xpos, std::forward<Args>(args)...);
     } else {
         // 空间不足，需要重新分配
         reallocate_emplace(xpos, std::forward<Args>(args)...);
@@ -1115,12 +1682,12 @@ typename vector<T>::iterator vector<T>::emplace(const_iterator pos, Args&&... ar
 }
 
 // emplace_back函数：在容器尾部就地构造元素
-template <class T>
+template <class T, class Alloc, class Growth>
 template <class... Args>
-void vector<T>::emplace_back(Args&&... args) {
+void vector<T, Alloc, Growth>::emplace_back(Args&&... args) {
     if (end_ != cap_) {
         // 如果有足够空间，直接在尾部构造
-        data_allocator().construct(end_, std::forward<Args>(args)...);
+        data_alloc_traits::construct(get_alloc(), end_, std::forward<Args>(args)...);
         ++end_;
     } else {
         // 空间不足，需要重新分配
@@ -1129,11 +1696,11 @@ void vector<T>::emplace_back(Args&&... args) {
 }
 
 // push_back函数：在容器尾部添加元素
-template <class T>
-void vector<T>::push_back(const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::push_back(const value_type& value) {
     if (end_ != cap_) {
         // 如果有足够空间，直接在尾部构造
-        data_allocator().construct(end_, value);
+        data_alloc_traits::construct(get_alloc(), end_, value);
         ++end_;
     } else {
         // 空间不足，需要重新分配
@@ -1142,40 +1709,29 @@ void vector<T>::push_back(const value_type& value) {
 }
 
 // pop_back函数：移除容器尾部元素
-template <class T>
-void vector<T>::pop_back() {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::pop_back() {
     if (empty()) {
         return;
     }
     // 析构最后一个元素
-    (--end_)->~T();
+    data_alloc_traits::destroy(get_alloc(), --end_);
 }
 
 // insert函数：在指定位置插入元素
-template <class T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, const value_type& value) {
     // 计算pos位置相对于begin_的偏移量
     iterator xpos = const_cast<iterator>(pos);
     const size_type n = pos - begin();
     
     if (end_ != cap_ && xpos == end_) {
         // 如果是在尾部插入且有足够空间，直接构造
-        data_allocator().construct(end_, value);
+        data_alloc_traits::construct(get_alloc(), end_, value);
         ++end_;
     } else if (end_ != cap_) {
-        // 如果有足够空间但不是在尾部插入
-        // 先保存end_的值
-        auto new_end = end_;
-        // 将最后一个元素复制到未初始化内存
-        data_allocator().construct(end_, *(end_ - 1));
-        ++new_end;
-        // 创建value的副本，避免因为移动操作修改原值
-        auto value_copy = value;
-        // 将[xpos, end_-1)范围内的元素向后移动一个位置
-        std::move_backward(xpos, end_ - 1, end_);
-        // 在空出的位置赋值
-        *xpos = std::move(value_copy);
-        end_ = new_end;
+        // 如果有足够空间但不是在尾部插入，其后的元素后移一位
+        emplace_shift(xpos, value);
     } else {
         // 空间不足，需要重新分配
         reallocate_insert(xpos, value);
@@ -1185,8 +1741,8 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos, const value_t
 }
 
 // insert函数：在指定位置插入多个相同的元素
-template <class T>
-typename vector<T>::iterator vector<T>::insert(const_iterator pos, size_type n, const value_type& value) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::insert(const_iterator pos, size_type n, const value_type& value) {
     // 如果插入0个元素，直接返回
     if (n == 0) {
         return const_cast<iterator>(pos);
@@ -1198,7 +1754,10 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos, size_type n,
     // 保存value的副本，避免因为移动操作修改原值
     const value_type value_copy = value;
     
-    if (static_cast<size_type>(cap_ - end_) >= n) {
+    if (static_cast<size_type>(cap_ - end_) >= n && relocatable::value) {
+        // 空间足够且元素可平凡重定位：整块后移，在空位中构造
+        fill_gap_relocate(xpos, n, [&](iterator p) { uninitialized_fill_n_a(p, n, value_copy); });
+    } else if (static_cast<size_type>(cap_ - end_) >= n) {
         // 如果有足够空间
         const size_type after_elems = end_ - xpos;
         auto old_end = end_;
@@ -1206,7 +1765,7 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos, size_type n,
         if (after_elems > n) {
             // 如果待插入位置后的元素数量大于n
             // 将末尾n个元素移动到未初始化空间
-            std::uninitialized_copy(end_ - n, end_, end_);
+            uninitialized_move_a(end_ - n, end_, end_);
             end_ += n;
             // 将[xpos, old_end-n)范围内的元素向后移动n个位置
             std::move_backward(xpos, old_end - n, old_end);
@@ -1215,60 +1774,56 @@ typename vector<T>::iterator vector<T>::insert(const_iterator pos, size_type n,
         } else {
             // 如果待插入位置后的元素数量不大于n
             // 在末尾填充value_copy，数量为n-after_elems
-            end_ = std::uninitialized_fill_n(end_, n - after_elems, value_copy);
+            end_ = uninitialized_fill_n_a(end_, n - after_elems, value_copy);
             // 将[xpos, old_end)范围内的元素移动到新位置
-            end_ = mystl::uninitialized_move(xpos, old_end, end_);
+            end_ = uninitialized_move_a(xpos, old_end, end_);
             // 在[xpos, xpos+after_elems)范围内填充value_copy
             std::fill(xpos, xpos + after_elems, value_copy);
         }
     } else {
-        // 空间不足，需要重新分配
-        const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator().allocate(new_size);
-        auto new_end = new_begin;
-        
-        try {
-            // 将xpos之前的元素移动到新内存
-            new_end = mystl::uninitialized_move(begin_, xpos, new_begin);
-            // 在新位置填充n个value_copy
-            new_end = std::uninitialized_fill_n(new_end, n, value_copy);
-            // 将xpos之后的元素移动到新内存
-            new_end = mystl::uninitialized_move(xpos, end_, new_end);
-        } catch (...) {
-            // 如果发生异常，销毁已构造的新元素并释放新内存
-            destroy_and_recover(new_begin, new_end, new_size);
-            throw;
-        }
-        
-        // 销毁旧元素并释放旧内存
-        destroy_and_recover(begin_, end_, cap_ - begin_);
-        
-        // 更新指针
-        begin_ = new_begin;
-        end_ = new_end;
-        cap_ = new_begin + new_size;
+        // 空间不足，需要重新分配，在空位中填充n个value_copy
+        reallocate_with_gap(get_new_cap(n), xpos, n,
+                            [&](iterator p) { uninitialized_fill_n_a(p, n, value_copy); });
     }
     
     return begin_ + pos_n;
 }
 
-// 在指定位置插入一个范围内的元素
-template <class T>
-template <class Iter, typename std::enable_if<
-    std::is_convertible<typename std::iterator_traits<Iter>::iterator_category, 
-    std::input_iterator_tag>::value, int>::type>
-void vector<T>::insert(const_iterator pos, Iter first, Iter last) {
+// copy_insert函数（输入迭代器版本）：逐个追加到末尾，再旋转到pos处
+template <class T, class Alloc, class Growth>
+template <class IIter>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::copy_insert(iterator pos, IIter first, IIter last, std::input_iterator_tag) {
+    // 追加可能重新分配，记录位置的偏移
+    const size_type pos_n = pos - begin_;
+    const size_type old_size = size();
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+    // 新元素位于[old_size, size())，与[pos_n, old_size)交换位置
+    std::rotate(begin_ + pos_n, begin_ + old_size, end_);
+    return begin_ + pos_n;
+}
+
+// copy_insert函数（前向迭代器版本）：一次计算个数，最多一次重新分配，尾部整体后移一次
+template <class T, class Alloc, class Growth>
+template <class FIter>
+typename vector<T, Alloc, Growth>::iterator
+vector<T, Alloc, Growth>::copy_insert(iterator xpos, FIter first, FIter last, std::forward_iterator_tag) {
     // 如果要插入的范围为空，直接返回
     if (first == last) {
-        return;
+        return xpos;
     }
     
-    iterator xpos = const_cast<iterator>(pos);
+    const size_type pos_n = xpos - begin_;
     
     // 计算要插入的元素个数
     const size_type n = std::distance(first, last);
     
-    if (static_cast<size_type>(cap_ - end_) >= n) {
+    if (static_cast<size_type>(cap_ - end_) >= n && relocatable::value) {
+        // 空间足够且元素可平凡重定位：整块后移，在空位中复制构造
+        fill_gap_relocate(xpos, n, [&](iterator p) { uninitialized_copy_a(first, last, p); });
+    } else if (static_cast<size_type>(cap_ - end_) >= n) {
         // 如果有足够空间
         const size_type after_elems = end_ - xpos;
         auto old_end = end_;
@@ -1276,7 +1831,7 @@ void vector<T>::insert(const_iterator pos, Iter first, Iter last) {
         if (after_elems > n) {
             // 如果待插入位置后的元素数量大于n
             // 将末尾n个元素移动到未初始化空间
-            std::uninitialized_copy(end_ - n, end_, end_);
+            uninitialized_move_a(end_ - n, end_, end_);
             end_ += n;
             // 将[xpos, old_end-n)范围内的元素向后移动n个位置
             std::move_backward(xpos, old_end - n, old_end);
@@ -1288,71 +1843,68 @@ void vector<T>::insert(const_iterator pos, Iter first, Iter last) {
             auto mid = first;
             std::advance(mid, after_elems);
             // 将[mid, last)范围内的元素复制到end_
-            end_ = std::uninitialized_copy(mid, last, end_);
+            end_ = uninitialized_copy_a(mid, last, end_);
             // 将[xpos, old_end)范围内的元素移动到新位置
-            end_ = mystl::uninitialized_move(xpos, old_end, end_);
+            end_ = uninitialized_move_a(xpos, old_end, end_);
             // 复制[first, mid)范围内的元素到xpos位置
             std::copy(first, mid, xpos);
         }
     } else {
-        // 空间不足，需要重新分配
-        const auto new_size = get_new_cap(n);
-        auto new_begin = data_allocator().allocate(new_size);
-        auto new_end = new_begin;
-        
-        try {
-            // 将xpos之前的元素移动到新内存
-            new_end = mystl::uninitialized_move(begin_, xpos, new_begin);
-            // 复制[first, last)范围内的元素到新位置
-            new_end = std::uninitialized_copy(first, last, new_end);
-            // 将xpos之后的元素移动到新内存
-            new_end = mystl::uninitialized_move(xpos, end_, new_end);
-        } catch (...) {
-            // 如果发生异常，销毁已构造的新元素并释放新内存
-            destroy_and_recover(new_begin, new_end, new_size);
-            throw;
-        }
-        
-        // 销毁旧元素并释放旧内存
-        destroy_and_recover(begin_, end_, cap_ - begin_);
-        
-        // 更新指针
-        begin_ = new_begin;
-        end_ = new_end;
-        cap_ = new_begin + new_size;
+        // 空间不足，需要重新分配，在空位中复制[first, last)
+        reallocate_with_gap(get_new_cap(n), xpos, n,
+                            [&](iterator p) { uninitialized_copy_a(first, last, p); });
     }
+    
+    return begin_ + pos_n;
 }
 
 // erase函数：移除指定位置的元素
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator pos) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(const_iterator pos) {
     if (pos == end()) {
         return const_cast<iterator>(pos);
     }
     
     iterator xpos = const_cast<iterator>(pos);
+    if (relocatable::value) {
+        // 析构被删除的元素，其后的元素整块前移补位
+        data_alloc_traits::destroy(get_alloc(), xpos);
+        move_bytes(xpos, xpos + 1, end_ - xpos - 1);
+        --end_;
+        return xpos;
+    }
     // 将pos后面的元素向前移动一个位置
     std::move(xpos + 1, end_, xpos);
     // 析构最后一个元素
-    (--end_)->~T();
+    data_alloc_traits::destroy(get_alloc(), --end_);
     
     return xpos;
 }
 
 // erase函数：移除指定范围的元素
-template <class T>
-typename vector<T>::iterator vector<T>::erase(const_iterator first, const_iterator last) {
+template <class T, class Alloc, class Growth>
+typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last) {
     if (first == last) {
         return const_cast<iterator>(first);
     }
     
     const auto n = first - begin();
     iterator r = begin_ + (first - begin());
+    if (relocatable::value) {
+        // 析构被删除的元素，其后的元素整块前移补位
+        iterator xlast = const_cast<iterator>(last);
+        for (iterator p = r; p != xlast; ++p) {
+            data_alloc_traits::destroy(get_alloc(), p);
+        }
+        move_bytes(r, xlast, end_ - xlast);
+        end_ -= xlast - r;
+        return r;
+    }
     // 将last后的元素移动到first位置
     iterator new_end = std::move(const_cast<iterator>(last), end_, r);
     // 析构多余的元素
     for (iterator p = new_end; p != end_; ++p) {
-        p->~T();
+        data_alloc_traits::destroy(get_alloc(), p);
     }
     end_ = new_end;
     
@@ -1360,8 +1912,8 @@ typename vector<T>::iterator vector<T>::erase(const_iterator first, const_iterat
 }
 
 // resize函数：调整容器大小
-template <class T>
-void vector<T>::resize(size_type new_size, const value_type& value) {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize(size_type new_size, const value_type& value) {
     if (new_size < size()) {
         // 如果新大小小于当前大小，删除多余元素
         erase(begin() + new_size, end());
@@ -1371,80 +1923,130 @@ void vector<T>::resize(size_type new_size, const value_type& value) {
     }
 }
 
+// resize_default_init函数：调整容器大小，新增的平凡元素不初始化
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::resize_default_init(size_type new_size) {
+    if (!default_init_skippable::value) {
+        resize(new_size);
+        return;
+    }
+    if (new_size <= size()) {
+        // 平凡元素不需要析构
+        end_ = begin_ + new_size;
+        return;
+    }
+    const size_type add = new_size - size();
+    if (static_cast<size_type>(cap_ - end_) < add) {
+        // 与 insert 相同按增长策略扩容，反复追加时均摊为常数
+        reallocate_with_gap(get_new_cap(add), end_, 0, [](iterator) {});
+    }
+    end_ = begin_ + new_size;
+}
+
+// resize_and_overwrite函数：调整大小后由op写入内容，以op的返回值作为最终大小
+template <class T, class Alloc, class Growth>
+template <class Operation>
+void vector<T, Alloc, Growth>::resize_and_overwrite(size_type n, Operation op) {
+    static_assert(std::is_trivial<T>::value, "vector::resize_and_overwrite 只能用于平凡类型");
+    const size_type kept = std::min(size(), n);
+    resize_default_init(n);
+    size_type r = 0;
+    try {
+        r = static_cast<size_type>(op(begin_, n));
+    } catch (...) {
+        end_ = begin_ + kept;
+        throw;
+    }
+    if (r > n) {
+        end_ = begin_ + kept;
+        throw std::length_error("vector::resize_and_overwrite - op的返回值超出了n");
+    }
+    end_ = begin_ + r;
+}
+
 // swap函数：与另一个vector交换内容
-template <class T>
-void vector<T>::swap(vector& rhs) noexcept {
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::swap(vector& rhs) noexcept {
     if (this != &rhs) {
         std::swap(begin_, rhs.begin_);
         std::swap(end_, rhs.end_);
         std::swap(cap_, rhs.cap_);
+        if (data_alloc_traits::propagate_on_container_swap::value) {
+            std::swap(get_alloc(), rhs.get_alloc());
+        }
     }
 }
 
 // reinsert函数：重新插入元素（用于shrink_to_fit）
-template <class T>
-void vector<T>::reinsert(size_type size) {
-    // 分配新内存
-    auto new_begin = data_allocator().allocate(size);
-    
-    try {
-        // 移动元素到新内存
-        mystl::uninitialized_move(begin_, end_, new_begin);
-    } catch (...) {
-        // 如果发生异常，释放新内存
-        data_allocator().deallocate(new_begin, size);
-        throw;
+template <class T, class Alloc, class Growth>
+void vector<T, Alloc, Growth>::reinsert(size_type size) {
+    // 没有元素时直接释放内存，回到不持有内存的状态
+    if (size == 0) {
+        destroy_and_recover(begin_, end_, cap_ - begin_);
+        begin_ = end_ = cap_ = nullptr;
+        return;
     }
-    
-    // 销毁旧元素并释放旧内存
-    destroy_and_recover(begin_, end_, cap_ - begin_);
-    
-    // 更新指针
-    begin_ = new_begin;
-    end_ = begin_ + size;
-    cap_ = begin_ + size;
+
+    // 把元素搬到大小正好的新内存
+    reallocate_with_gap(size, end_, 0, [](iterator) {});
 }
 
 // 重载比较操作符
-template <class T>
-bool operator==(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     if (lhs.size() != rhs.size()) {
         return false;
     }
     return std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class T>
-bool operator!=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator<(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T>
-bool operator>(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return rhs < lhs;
 }
 
-template <class T>
-bool operator<=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(rhs < lhs);
 }
 
-template <class T>
-bool operator>=(const vector<T>& lhs, const vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
     return !(lhs < rhs);
 }
 
 // 重载swap
-template <class T>
-void swap(vector<T>& lhs, vector<T>& rhs) {
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& lhs, vector<T, Alloc, Growth>& rhs) {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief vector 只持有指向堆内存的指针，分配器可平凡重定位时 vector 本身也可以
+ */
+template <class T, class Alloc, class Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
+namespace pmr {
+
+/**
+ * @brief 使用 polymorphic_allocator 的 vector
+ */
+template <class T>
+using vector = mystl::vector<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace mystl
 
 #endif // MY_VECTOR_H 
\ No newline at end of file
@@ -0,0 +1,73 @@
+// test_vector_growth.cpp
+// 逐个 push_back 把 vector 增长到指定大小，比较 std::allocator 与 realloc_allocator 的耗时和峰值内存
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "my_vector.h"
+
+/**
+ * 在子进程中执行 f，返回子进程的峰值常驻内存（MB），每种情况互不影响
+ */
+template <class F>
+double peak_in_child(F f) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        f();
+        _exit(0);
+    }
+    int status = 0;
+    struct rusage usage;
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::cerr << "子进程执行失败" << std::endl;
+        std::exit(1);
+    }
+    return usage.ru_maxrss / 1024.0;  // Linux 上 ru_maxrss 的单位为 KB
+}
+
+/**
+ * 增长到 n 个 uint64_t，输出耗时、最终容量与峰值内存
+ */
+template <class Vector>
+void measure(const char* name, size_t n) {
+    const double peak = peak_in_child([n, name]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        Vector v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(i);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        if (v[n / 2] != n / 2) {
+            _exit(1);
+        }
+        std::cout << "  " << name
+                  << "  耗时: " << std::setw(6) << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                  << " ms  容量: " << std::setw(5) << v.capacity() * sizeof(uint64_t) / (1024 * 1024) << " MB";
+        std::cout.flush();
+    });
+    std::cout << "  峰值内存: " << std::fixed << std::setprecision(0) << peak << " MB" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t mb = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 512;
+    const size_t n = mb * 1024 * 1024 / sizeof(uint64_t);
+    std::cout << "===== push_back 增长到 " << mb << " MB 的 vector<uint64_t> =====" << std::endl;
+
+    typedef mystl::realloc_allocator<uint64_t> realloc_alloc;
+    typedef mystl::vector_page_growth<> page_growth;
+    measure<mystl::vector<uint64_t>>("std::allocator                     ", n);
+    measure<mystl::vector<uint64_t, realloc_alloc>>("realloc_allocator                  ", n);
+    measure<mystl::vector<uint64_t, realloc_alloc, page_growth>>("realloc_allocator + 按页取整       ", n);
+    measure<mystl::vector<uint64_t, std::allocator<uint64_t>,
+                          mystl::vector_growth_factor<2, 1, 16>>>("std::allocator + 2 倍增长          ", n);
+    measure<mystl::vector<uint64_t, realloc_alloc, mystl::vector_growth_factor<2, 1, 16>>>(
+        "realloc_allocator + 2 倍增长       ", n);
+
+    return 0;
+}
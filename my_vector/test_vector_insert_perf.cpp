@@ -0,0 +1,103 @@
+// test_vector_insert_perf.cpp
+// 在 100 万个元素的 vector<int> 中间一次插入 1K ~ 1M 个元素：
+// 比较 std::vector、mystl::vector 的范围插入（随机访问、前向、输入迭代器）与逐个插入的耗时
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+
+#include "my_vector.h"
+
+// 防止编译器优化掉结果
+static volatile long long g_sink = 0;
+
+/**
+ * @brief 只能遍历一次的输入迭代器，包装一个 int 指针
+ */
+struct input_iter {
+    typedef std::input_iterator_tag iterator_category;
+    typedef int                     value_type;
+    typedef std::ptrdiff_t          difference_type;
+    typedef const int*              pointer;
+    typedef const int&              reference;
+
+    const int* p;
+
+    explicit input_iter(const int* ptr) : p(ptr) {}
+    reference operator*() const { return *p; }
+    input_iter& operator++() { ++p; return *this; }
+    input_iter operator++(int) { input_iter tmp = *this; ++p; return tmp; }
+    bool operator==(const input_iter& rhs) const { return p == rhs.p; }
+    bool operator!=(const input_iter& rhs) const { return p != rhs.p; }
+};
+
+/**
+ * @brief 对 base 个元素的新容器执行 rounds 次 splice，只统计 splice 的平均毫秒数
+ */
+template <class Vector, class Splice>
+double measure(size_t base, int rounds, Splice splice) {
+    double total = 0;
+    for (int r = 0; r < rounds; ++r) {
+        Vector v;
+        for (size_t i = 0; i < base; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        splice(v);
+        auto end = std::chrono::high_resolution_clock::now();
+        total += std::chrono::duration<double, std::milli>(end - start).count();
+        g_sink += v[v.size() / 2] + static_cast<long long>(v.size());
+    }
+    return total / rounds;
+}
+
+void print(const char* name, double ms) {
+    std::cout << "  " << name << std::fixed << std::setprecision(2) << std::setw(10) << ms << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t base = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const int rounds = 5;
+    std::cout << "===== 在 " << base << " 个元素的 vector<int> 中间插入一段元素（" << rounds
+              << " 次平均）=====" << std::endl;
+
+    const size_t counts[] = {1000, 10000, 100000, 1000000};
+    for (size_t k : counts) {
+        std::vector<int> src(k);
+        for (size_t i = 0; i < k; ++i) {
+            src[i] = -static_cast<int>(i);
+        }
+        const std::list<int> list_src(src.begin(), src.end());
+        const int* first = src.data();
+        const int* last = src.data() + k;
+
+        std::cout << "\n插入 " << k << " 个元素" << std::endl;
+        print("std::vector   随机访问迭代器  ", measure<std::vector<int>>(base, rounds, [&](std::vector<int>& v) {
+            v.insert(v.begin() + v.size() / 2, first, last);
+        }));
+        print("mystl::vector 随机访问迭代器  ", measure<mystl::vector<int>>(base, rounds, [&](mystl::vector<int>& v) {
+            v.insert(v.begin() + v.size() / 2, first, last);
+        }));
+        print("mystl::vector 前向迭代器(list)", measure<mystl::vector<int>>(base, rounds, [&](mystl::vector<int>& v) {
+            v.insert(v.begin() + v.size() / 2, list_src.begin(), list_src.end());
+        }));
+        print("mystl::vector 输入迭代器      ", measure<mystl::vector<int>>(base, rounds, [&](mystl::vector<int>& v) {
+            v.insert(v.begin() + v.size() / 2, input_iter(first), input_iter(last));
+        }));
+        // 逐个插入每次都要后移整个尾部，元素多时耗时过长，只测较小的规模
+        if (k <= 10000) {
+            print("mystl::vector 逐个插入        ", measure<mystl::vector<int>>(base, rounds, [&](mystl::vector<int>& v) {
+                auto pos = v.begin() + v.size() / 2;
+                for (const int* p = first; p != last; ++p) {
+                    pos = v.insert(pos, *p) + 1;
+                }
+            }));
+        }
+    }
+    return 0;
+}
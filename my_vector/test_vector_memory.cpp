@@ -0,0 +1,59 @@
+// test_vector_memory.cpp
+// 测量大量空容器的常驻内存：空的 vector 与 string 不分配内存，只占对象本身的大小
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "my_vector.h"
+#include "../my_string/my_string.h"
+
+/**
+ * 返回当前进程的常驻内存（字节），读取 /proc/self/statm，不支持时返回 0
+ */
+static size_t resident_bytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0, resident = 0;
+    if (!(statm >> total >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * 构造 n 个默认构造的容器，输出常驻内存的增量
+ */
+template <class Container>
+void measure(const char* name, size_t n) {
+    const size_t before = resident_bytes();
+    Container* items = new Container[n];
+    const size_t after = resident_bytes();
+
+    const double mb = static_cast<double>(after - before) / (1024 * 1024);
+    std::cout << "  " << name << "  sizeof = " << sizeof(Container)
+              << "  常驻内存增量: " << mb << " MB"
+              << "  (每个 " << static_cast<double>(after - before) / n << " 字节)" << std::endl;
+
+    delete[] items;
+#ifdef __GLIBC__
+    malloc_trim(0);  // 把释放的小块内存还给系统，避免影响下一次测量
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    const size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    std::cout << "===== " << n << " 个空容器的常驻内存 =====" << std::endl;
+
+    measure<mystl::vector<int>>("mystl::vector<int>", n);
+    measure<std::vector<int>>("std::vector<int>  ", n);
+    measure<mystl::string>("mystl::string     ", n);
+    measure<std::string>("std::string       ", n);
+
+    return 0;
+}
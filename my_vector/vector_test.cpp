@@ -5,7 +5,15 @@
 #include <chrono>   // 添加计时相关头文件
 #include <iomanip>  // 添加格式化输出头文件
 #include <functional> // 添加functional头文件
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <sstream>
 #include "my_vector.h"
+#include "../my_test_support/tagged_allocator.h"
 
 /**
  * @brief 测试vector的构造函数
@@ -320,6 +328,513 @@ void test_exception_safety() {
     }
 }
 
+/**
+ * @brief 测试有状态分配器在拷贝、移动和交换时的传播
+ */
+void test_allocator_propagation() {
+    std::cout << "\n===== 测试有状态分配器的传播 =====" << std::endl;
+    {
+        typedef tagged_allocator<int, false> alloc;  // 不传播
+        typedef mystl::vector<int, alloc> container;
+        container a(alloc(1));
+        for (int i = 0; i < 100; ++i) a.push_back(i);
+        container b(alloc(2));
+        b.push_back(-1);
+
+        container c(a);  // 拷贝构造沿用 select_on_container_copy_construction 的结果
+        assert(c.get_allocator().id == 1 && c.size() == 100);
+        container d(a, alloc(3));
+        assert(d.get_allocator().id == 3 && d == a);
+
+        b = a;  // 不传播：保留自己的分配器
+        assert(b.get_allocator().id == 2 && b.size() == 100 && b.back() == 99);
+        b = std::move(c);  // 分配器不相等：逐个移动元素
+        assert(b.get_allocator().id == 2 && b.size() == 100);
+        container e(std::move(d), alloc(4));  // 分配器不相等：逐个移动元素
+        assert(e.get_allocator().id == 4 && e.size() == 100 && e.front() == 0);
+        container f(std::move(a), alloc(1));  // 分配器相等：直接接管
+        assert(f.get_allocator().id == 1 && f.size() == 100);
+    }
+    assert(all_released<false>());
+    {
+        typedef tagged_allocator<int, true> alloc;  // 传播
+        typedef mystl::vector<int, alloc> container;
+        container a(alloc(1));
+        a.push_back(1);
+        container b(alloc(2));
+        b.push_back(2);
+        b.push_back(3);
+        b = a;
+        assert(b.get_allocator().id == 1 && b.size() == 1 && b.front() == 1);
+        container c(alloc(3));
+        c.push_back(4);
+        c = std::move(b);
+        assert(c.get_allocator().id == 1 && c.size() == 1);
+        container d(alloc(4));
+        d.push_back(5);
+        d.swap(a);
+        assert(d.get_allocator().id == 1 && a.get_allocator().id == 4 && a.front() == 5);
+    }
+    assert(all_released<true>());
+
+    // 空分配器保存在基类中，不占空间
+    static_assert(sizeof(mystl::vector<int>) == 3 * sizeof(int*), "std::allocator 不应增大 vector");
+    std::cout << "有状态分配器测试通过" << std::endl;
+}
+
+/**
+ * @brief 测试空容器不分配内存
+ */
+void test_lazy_allocation() {
+    std::cout << "\n===== 测试空容器不分配内存 =====" << std::endl;
+    typedef tagged_allocator<int, false> alloc;
+    typedef mystl::vector<int, alloc> container;
+    const int& live = tagged_allocator<char, false>::live[5];
+
+    container a(alloc(5));
+    container b((alloc(5)));
+    container c(0, 7, alloc(5));
+    std::vector<int> empty_src;
+    container d(empty_src.begin(), empty_src.end(), alloc(5));
+    container e({}, alloc(5));
+    assert(live == 0);
+    assert(a.capacity() == 0 && a.data() == nullptr && a.begin() == a.end());
+    assert(c.empty() && d.empty() && e.empty());
+
+    // 拷贝、移动空容器同样不分配
+    container f(a);
+    container g(std::move(b));
+    f = a;
+    g = std::move(f);
+    f.swap(g);
+    assert(live == 0);
+
+    // 第一次插入时才分配
+    a.push_back(1);
+    assert(live == 1 && a.capacity() > 0);
+
+    // 移动后原容器不持有内存
+    container h(std::move(a));
+    assert(a.capacity() == 0 && a.data() == nullptr);
+    assert(live == 1);
+
+    // clear 保留容量，clear + shrink_to_fit 释放全部内存
+    h.clear();
+    assert(h.capacity() > 0 && live == 1);
+    h.shrink_to_fit();
+    assert(h.capacity() == 0 && h.data() == nullptr && live == 0);
+
+    // 释放后可以继续使用
+    h.push_back(2);
+    assert(h.size() == 1 && h.front() == 2 && live == 1);
+    std::cout << "空容器不分配内存测试通过" << std::endl;
+}
+
+/**
+ * @brief 统计移动构造、移动赋值次数的元素，Relocatable 为 true 时声明可平凡重定位
+ */
+template <bool Relocatable>
+struct counted {
+    static int moves;
+    int value;
+
+    counted(int v = 0) : value(v) {}
+    counted(const counted& rhs) : value(rhs.value) {}
+    counted(counted&& rhs) : value(rhs.value) { ++moves; }
+    counted& operator=(const counted& rhs) { value = rhs.value; return *this; }
+    counted& operator=(counted&& rhs) { value = rhs.value; ++moves; return *this; }
+    ~counted() {}
+};
+
+template <bool Relocatable>
+int counted<Relocatable>::moves = 0;
+
+/**
+ * @brief 第 throw_at 次复制构造时抛出异常的元素，可平凡重定位
+ */
+struct throw_on_copy {
+    static int copies;
+    static int throw_at;
+    int value;
+
+    throw_on_copy(int v = 0) : value(v) {}
+    throw_on_copy(const throw_on_copy& rhs) : value(rhs.value) {
+        if (++copies == throw_at) {
+            throw std::runtime_error("复制构造函数抛出异常");
+        }
+    }
+    throw_on_copy& operator=(const throw_on_copy& rhs) = default;
+};
+
+int throw_on_copy::copies = 0;
+int throw_on_copy::throw_at = 0;
+
+namespace mystl {
+template <>
+struct is_trivially_relocatable<counted<true>> : std::true_type {};
+
+template <>
+struct is_trivially_relocatable<throw_on_copy> : std::true_type {};
+} // namespace mystl
+
+/**
+ * @brief 测试可平凡重定位元素的整块搬动
+ */
+void test_relocation() {
+    std::cout << "\n===== 测试可平凡重定位元素的整块搬动 =====" << std::endl;
+
+    static_assert(mystl::is_trivially_relocatable<int>::value, "int");
+    static_assert(mystl::is_trivially_relocatable<std::unique_ptr<int>>::value, "unique_ptr");
+    static_assert(mystl::is_trivially_relocatable<std::shared_ptr<int>>::value, "shared_ptr");
+    static_assert(mystl::is_trivially_relocatable<std::pair<int, std::unique_ptr<int>>>::value, "pair");
+    static_assert(mystl::is_trivially_relocatable<mystl::vector<int>>::value, "vector");
+    static_assert(!mystl::is_trivially_relocatable<counted<false>>::value, "未声明的类型");
+    static_assert(!mystl::is_trivially_relocatable<std::pair<int, counted<false>>>::value, "pair");
+
+    // 声明了可平凡重定位的元素：扩容、中间插入和删除都不调用移动构造和移动赋值
+    {
+        mystl::vector<counted<true>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(i);
+        }
+        const counted<true> a(-2), b(-3);
+        v.emplace(v.begin() + 10, -1);
+        v.insert(v.begin(), a);
+        v.insert(v.begin() + 500, 3, b);
+        v.erase(v.begin() + 1);
+        v.erase(v.begin() + 100, v.begin() + 200);
+        v.shrink_to_fit();
+        v.reserve(5000);
+        assert(counted<true>::moves == 0);
+        assert(v.size() == 904 && v[0].value == -2 && v[10].value == -1 && v[11].value == 10);
+        assert(v[399].value == -3 && v[401].value == -3 && v[402].value == 498 && v.back().value == 999);
+    }
+
+    // 未声明的元素逐个移动，结果相同
+    {
+        mystl::vector<counted<false>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(i);
+        }
+        v.emplace(v.begin() + 10, -1);
+        v.erase(v.begin() + 100, v.begin() + 200);
+        assert(counted<false>::moves > 0);
+        assert(v.size() == 901 && v[10].value == -1 && v[100].value == 199);
+    }
+
+    // 只能移动的元素：扩容、中间插入、删除
+    {
+        mystl::vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(new int(i));
+        }
+        v.emplace(v.begin() + 50, new int(-1));
+        v.insert(v.begin(), std::unique_ptr<int>(new int(-2)));
+        v.erase(v.begin() + 1, v.begin() + 11);
+        assert(v.size() == 92 && *v[0] == -2 && *v[1] == 10 && *v[41] == -1 && *v.back() == 99);
+    }
+
+    // 插入的值引用容器内的元素
+    {
+        mystl::vector<int> v = {0, 1, 2, 3, 4};
+        v.reserve(10);
+        v.insert(v.begin(), v[2]);
+        v.emplace(v.begin() + 1, v.back());
+        assert((v == mystl::vector<int>{2, 4, 0, 1, 2, 3, 4}));
+        v.shrink_to_fit();
+        v.emplace(v.begin(), v[6]);
+        v.shrink_to_fit();
+        v.insert(v.begin() + 1, v[0]);
+        assert((v == mystl::vector<int>{4, 4, 2, 4, 0, 1, 2, 3, 4}));
+    }
+
+    // 构造新元素时抛出异常，容器保持不变
+    {
+        mystl::vector<throw_on_copy> v;
+        v.reserve(20);
+        for (int i = 0; i < 10; ++i) {
+            v.emplace_back(i);
+        }
+        const throw_on_copy value(-1);
+
+        // 容量足够：后移的元素被挪回原处
+        throw_on_copy::copies = 0;
+        throw_on_copy::throw_at = 3;
+        bool thrown = false;
+        try {
+            v.insert(v.begin() + 4, 5, value);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && v.size() == 10 && v.capacity() == 20);
+
+        // 需要扩容：新空间被释放，原空间不变
+        throw_on_copy::copies = 0;
+        thrown = false;
+        try {
+            v.insert(v.begin() + 4, 15, value);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && v.size() == 10 && v.capacity() == 20);
+        for (int i = 0; i < 10; ++i) {
+            assert(v[i].value == i);
+        }
+
+        throw_on_copy::throw_at = 0;
+        v.insert(v.begin() + 4, 15, value);
+        assert(v.size() == 25 && v[3].value == 3 && v[4].value == -1 && v[19].value == 4 && v[24].value == 9);
+    }
+
+    std::cout << "可平凡重定位元素测试通过" << std::endl;
+}
+
+/**
+ * @brief 测试可配置的增长策略与原地伸缩的 realloc_allocator
+ */
+void test_growth_policy() {
+    std::cout << "\n===== 测试增长策略 =====" << std::endl;
+
+    // 默认策略：首次至少 16 个元素，之后按 1.5 倍增长
+    {
+        mystl::vector<int> v;
+        v.push_back(1);
+        assert(v.capacity() == 16);
+        for (int i = 0; i < 16; ++i) {
+            v.push_back(i);
+        }
+        assert(v.capacity() == 24);
+        v.insert(v.end(), 100, 0);
+        assert(v.capacity() == 124);   // 1.5 倍不够时按所需容量分配
+    }
+
+    // 2 倍增长，最少 4 个元素
+    {
+        typedef mystl::vector<int, std::allocator<int>, mystl::vector_growth_factor<2, 1, 4>> vec;
+        vec v;
+        mystl::vector<size_t> caps;
+        for (int i = 0; i < 100; ++i) {
+            if (v.size() == v.capacity()) {
+                caps.push_back(v.capacity());
+            }
+            v.push_back(i);
+        }
+        assert((caps == mystl::vector<size_t>{0, 4, 8, 16, 32, 64}));
+        assert(v.capacity() == 128 && v[99] == 99);
+    }
+
+    // 按页取整：小于一页时按倍数增长，达到一页后字节数取整为 4096 的倍数
+    {
+        typedef mystl::vector_page_growth<mystl::vector_growth_factor<2, 1, 4>> policy;
+        assert(policy::next_capacity(0, 1, sizeof(int)) == 4);
+        assert(policy::next_capacity(4, 5, sizeof(int)) == 8);
+        assert(policy::next_capacity(512, 513, sizeof(int)) == 1024);
+        assert(policy::next_capacity(1000, 1001, sizeof(int)) == 2048);
+        assert(policy::next_capacity(1000, 1001, 12) == 2048);
+        mystl::vector<double, std::allocator<double>, policy> v(1000);
+        v.push_back(1.0);
+        assert(v.capacity() * sizeof(double) % 4096 == 0 && v.capacity() >= 1001);
+    }
+
+    // 增长策略给出的容量溢出时仍满足所需容量
+    {
+        typedef mystl::vector_growth_factor<3, 2, 16> policy;
+        const size_t huge = static_cast<size_t>(-1) / 2;
+        assert(policy::next_capacity(huge, huge + 1, 1) >= huge + 1);
+    }
+
+    // realloc_allocator：可平凡重定位的元素扩容、收缩时原地伸缩
+    {
+        static_assert(mystl::has_reallocate<mystl::realloc_allocator<int>>::value, "realloc_allocator");
+        static_assert(!mystl::has_reallocate<std::allocator<int>>::value, "std::allocator");
+
+        mystl::vector<long, mystl::realloc_allocator<long>> v;
+        for (long i = 0; i < 100000; ++i) {
+            v.push_back(i);
+        }
+        for (long i = 0; i < 100000; ++i) {
+            assert(v[i] == i);
+        }
+        v.insert(v.begin() + 5, 3, -1);
+        v.emplace(v.begin(), -2);
+        v.erase(v.begin() + 50000, v.end());
+        v.shrink_to_fit();
+        assert(v.size() == 50000 && v.capacity() == 50000);
+        assert(v[0] == -2 && v[5] == 4 && v[6] == -1 && v[8] == -1 && v[9] == 5 && v.back() == 49995);
+
+        // 扩容时插入的值引用容器内的元素
+        v.push_back(v[0]);
+        assert(v.size() == 50001 && v.back() == -2);
+        v.shrink_to_fit();
+        v.emplace(v.begin() + 1, v.back());
+        v.shrink_to_fit();
+        v.insert(v.begin(), v[6]);
+        assert(v[0] == 4 && v[1] == -2 && v[2] == -2 && v.back() == -2);
+
+        v.clear();
+        v.shrink_to_fit();
+        assert(v.capacity() == 0);
+        v.reserve(10);
+        assert(v.capacity() == 10);
+    }
+
+    // 只能移动的元素同样可以原地伸缩
+    {
+        mystl::vector<std::unique_ptr<int>, mystl::realloc_allocator<std::unique_ptr<int>>> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.emplace_back(new int(i));
+        }
+        v.emplace(v.begin(), new int(-1));
+        assert(v.size() == 1001 && *v[0] == -1 && *v[1] == 0 && *v.back() == 999);
+    }
+
+    std::cout << "增长策略测试通过" << std::endl;
+}
+
+/**
+ * @brief 测试不初始化新增元素的 resize_default_init 与 resize_and_overwrite
+ */
+void test_default_init() {
+    std::cout << "\n===== 测试 resize_default_init / resize_and_overwrite =====" << std::endl;
+
+    // 平凡元素：保留原有元素，新增元素由调用者写入
+    {
+        mystl::vector<int> v = {1, 2, 3};
+        v.resize_default_init(1000);
+        assert(v.size() == 1000 && v.capacity() >= 1000);
+        assert(v[0] == 1 && v[1] == 2 && v[2] == 3);
+        for (int i = 3; i < 1000; ++i) {
+            v[i] = i;
+        }
+        v.resize_default_init(10);
+        assert(v.size() == 10 && v.back() == 9);
+
+        // 反复追加时按增长策略扩容
+        mystl::vector<char> buf;
+        size_t reallocations = 0;
+        for (int i = 0; i < 1000; ++i) {
+            const size_t cap = buf.capacity();
+            buf.resize_default_init(buf.size() + 100);
+            std::memset(buf.data() + buf.size() - 100, 'a' + i % 26, 100);
+            reallocations += buf.capacity() != cap;
+        }
+        assert(buf.size() == 100000 && buf[99999] == 'a' + 999 % 26 && reallocations < 30);
+    }
+
+    // 非平凡元素与 resize 相同，新增元素默认构造
+    {
+        mystl::vector<std::string> v(2, "x");
+        v.resize_default_init(5);
+        assert(v.size() == 5 && v[1] == "x" && v[4].empty());
+        v.resize_default_init(1);
+        assert(v.size() == 1 && v[0] == "x");
+    }
+
+    // 模拟从文件读入：只保留 op 实际写入的元素
+    {
+        mystl::vector<unsigned char> buf = {0xAA};
+        buf.resize_and_overwrite(4096, [](unsigned char* p, size_t n) {
+            assert(p[0] == 0xAA);
+            for (size_t i = 1; i < 100; ++i) {
+                p[i] = static_cast<unsigned char>(i);
+            }
+            return n < 100 ? n : size_t(100);
+        });
+        assert(buf.size() == 100 && buf.capacity() >= 4096 && buf[0] == 0xAA && buf[99] == 99);
+
+        // op 抛出异常或返回值超过 n 时大小恢复为 min(size(), n)
+        bool thrown = false;
+        try {
+            buf.resize_and_overwrite(200, [](unsigned char*, size_t) -> size_t { throw std::runtime_error("io"); });
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown && buf.size() == 100 && buf[99] == 99);
+        thrown = false;
+        try {
+            buf.resize_and_overwrite(50, [](unsigned char*, size_t n) { return n + 1; });
+        } catch (const std::length_error&) {
+            thrown = true;
+        }
+        assert(thrown && buf.size() == 50 && buf[49] == 49);
+    }
+
+    std::cout << "resize_default_init / resize_and_overwrite 测试通过" << std::endl;
+}
+
+/**
+ * @brief 测试范围插入与范围赋值：输入迭代器逐个读取，前向迭代器最多重新分配一次、尾部只后移一次
+ */
+void test_range_insert() {
+    std::cout << "\n===== 测试范围插入与范围赋值 =====" << std::endl;
+
+    // 输入迭代器只能遍历一次：中间插入、末尾插入、构造与赋值
+    {
+        mystl::vector<int> v = {1, 2, 3};
+        std::istringstream in("7 8 9");
+        auto it = v.insert(v.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+        assert(it == v.begin() + 1 && v.size() == 6);
+        const int expected[] = {1, 7, 8, 9, 2, 3};
+        assert(std::equal(v.begin(), v.end(), expected));
+
+        std::istringstream tail("4 5");
+        it = v.insert(v.end(), std::istream_iterator<int>(tail), std::istream_iterator<int>());
+        assert(it == v.begin() + 6 && v.size() == 8 && v.back() == 5);
+
+        std::istringstream none("");
+        it = v.insert(v.begin() + 2, std::istream_iterator<int>(none), std::istream_iterator<int>());
+        assert(it == v.begin() + 2 && v.size() == 8);
+
+        std::istringstream src("1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20");
+        mystl::vector<int> w(std::istream_iterator<int>(src), (std::istream_iterator<int>()));
+        assert(w.size() == 20 && w[0] == 1 && w[19] == 20);
+
+        std::istringstream more("5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25");
+        v.assign(std::istream_iterator<int>(more), std::istream_iterator<int>());
+        assert(v.size() == 21 && v.front() == 5 && v.back() == 25);
+        std::istringstream fewer("1 2");
+        v.assign(std::istream_iterator<int>(fewer), std::istream_iterator<int>());
+        assert(v.size() == 2 && v[1] == 2);
+    }
+
+    // 前向迭代器：容量足够时 pos 之后的每个元素只移动一次
+    {
+        typedef counted<false> elem;
+        mystl::vector<elem> v;
+        v.reserve(100);
+        for (int i = 0; i < 10; ++i) {
+            v.emplace_back(i);
+        }
+        const std::list<elem> src = {elem(-1), elem(-2), elem(-3), elem(-4)};
+        elem::moves = 0;
+        auto it = v.insert(v.begin() + 3, src.begin(), src.end());
+        assert(elem::moves == 7 && it == v.begin() + 3);
+        assert(v.size() == 14 && v[2].value == 2 && v[3].value == -1 && v[6].value == -4 && v[7].value == 3);
+
+        // 容量不足时只重新分配一次，每个原有元素移动一次
+        const std::list<elem> big(200, elem(7));
+        elem::moves = 0;
+        it = v.insert(v.begin() + 1, big.begin(), big.end());
+        assert(elem::moves == 14 && it == v.begin() + 1 && v.size() == 214);
+        assert(v.capacity() >= 214 && v[0].value == 0 && v[200].value == 7 && v[201].value == 1);
+    }
+
+    // 初始化列表插入返回第一个新元素；赋值超过容量时只分配一次
+    {
+        typedef tagged_allocator<int, false> alloc;
+        const int& live = tagged_allocator<char, false>::live[6];
+        mystl::vector<int, alloc> v({1, 2, 3}, alloc(6));
+        auto it = v.insert(v.begin() + 1, {10, 11});
+        assert(*it == 10 && v.size() == 5 && v[3] == 2);
+
+        const std::list<int> src(1000, 3);
+        v.assign(src.begin(), src.end());
+        assert(v.size() == 1000 && v.capacity() == 1000 && live == 1);
+    }
+
+    std::cout << "范围插入与范围赋值测试通过" << std::endl;
+}
+
 /**
  * @brief 测试mystl::vector与std::vector的性能比较
  */
@@ -567,6 +1082,62 @@ void test_performance() {
         
         show_results("拷贝构造", std_time, mystl_time);
     }
+    
+    // 测试：在头部插入、删除可平凡重定位但不可平凡复制的元素（整块 memmove）
+    {
+        std::vector<std::shared_ptr<int>> std_vec(MEDIUM_TEST_SIZE);
+        mystl::vector<std::shared_ptr<int>> mystl_vec(MEDIUM_TEST_SIZE);
+        const int ops = SMALL_TEST_SIZE;
+        
+        double std_time = time_operation([&]() {
+            for (int i = 0; i < ops; ++i) {
+                std_vec.emplace(std_vec.begin(), nullptr);
+            }
+        });
+        double mystl_time = time_operation([&]() {
+            for (int i = 0; i < ops; ++i) {
+                mystl_vec.emplace(mystl_vec.begin(), nullptr);
+            }
+        });
+        show_results("头部插入shared_ptr", std_time, mystl_time);
+        
+        std_time = time_operation([&]() {
+            for (int i = 0; i < ops; ++i) {
+                std_vec.erase(std_vec.begin());
+            }
+        });
+        mystl_time = time_operation([&]() {
+            for (int i = 0; i < ops; ++i) {
+                mystl_vec.erase(mystl_vec.begin());
+            }
+        });
+        show_results("头部删除shared_ptr", std_time, mystl_time);
+    }
+    
+    // 测试：反复把缓冲区调整为 16 MB 后整块写入，std::vector::resize 每次都先清零
+    {
+        const size_t bytes = 16 * 1024 * 1024;
+        const int rounds = 20;
+        std::vector<char> src(bytes, 'x');
+        std::vector<char> std_buf;
+        mystl::vector<char> mystl_buf;
+        
+        double std_time = time_operation([&]() {
+            for (int i = 0; i < rounds; ++i) {
+                std_buf.clear();
+                std_buf.resize(bytes);
+                std::memcpy(std_buf.data(), src.data(), bytes);
+            }
+        });
+        double mystl_time = time_operation([&]() {
+            for (int i = 0; i < rounds; ++i) {
+                mystl_buf.clear();
+                mystl_buf.resize_default_init(bytes);
+                std::memcpy(mystl_buf.data(), src.data(), bytes);
+            }
+        });
+        show_results("resize后覆盖16MB缓冲区", std_time, mystl_time);
+    }
 }
 
 int main() {
@@ -577,6 +1148,12 @@ int main() {
     test_modifiers();
     test_comparison();
     test_exception_safety();
+    test_allocator_propagation();
+    test_lazy_allocation();
+    test_relocation();
+    test_growth_policy();
+    test_default_init();
+    test_range_insert();
     test_performance();  // 添加性能测试
     
     return 0;